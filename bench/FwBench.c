@@ -0,0 +1,204 @@
+/**
+ * @file
+ * @ingroup bsGroup
+ * Benchmark suite for the FW Profile.
+ * This program runs the benchmark cases declared in <code>FwBench.h</code> and
+ * reports their results.
+ * The program accepts the following options:
+ * - <code>--format=text|csv|json</code>: the format of the report (default: text).
+ *   The CSV and JSON formats are intended to be stored and compared across releases.
+ * - <code>--filter=STRING</code>: only run the cases whose name contains STRING.
+ * - <code>--scale=N</code>: multiply the number of operations of each case by N.
+ * .
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the FW Profile.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#define _POSIX_C_SOURCE 200112L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "FwBench.h"
+
+/** The number of benchmark cases in the benchmark suite. */
+#define N_OF_BENCH_CASES 31
+
+/** Enumerated type for the format of the benchmark report. */
+typedef enum {
+	/** Human-readable table */
+	benchText = 0,
+	/** Comma-separated values with one header line */
+	benchCsv = 1,
+	/** JSON array with one object per benchmark case */
+	benchJson = 2
+} FwBenchFormat_t;
+
+/** Structure describing a benchmark case. */
+struct FwBenchCase {
+	/** The name of the benchmark case. */
+	const char* name;
+	/** The function implementing the benchmark case. */
+	FwBenchCase_t run;
+	/** The default number of operations executed by the benchmark case. */
+	long nOfOps;
+};
+
+/**
+ * Print one line of the benchmark report.
+ * @param format the format of the report
+ * @param name the name of the benchmark case
+ * @param result the result of the benchmark case
+ * @param isFirst 1 if this is the first line of the report
+ */
+static void PrintResult(FwBenchFormat_t format, const char* name, struct FwBenchResult* result, int isFirst);
+
+/*------------------------------------------------------------------------------------*/
+int main(int argc, char* argv[]) {
+	struct FwBenchCase benchCases[N_OF_BENCH_CASES] = {
+		{"sm_make_trans_16", &FwBenchSmMakeTrans1, 1000000},
+		{"sm_make_trans_max", &FwBenchSmMakeTrans2, 1000000},
+		{"sm_make_trans_16_compiled", &FwBenchSmMakeTrans3, 1000000},
+		{"sm_make_trans_wide", &FwBenchSmMakeTransWide1, 1000000},
+		{"sm_make_trans_wide_comp", &FwBenchSmMakeTransWide2, 1000000},
+		{"sm_make_trans_out8", &FwBenchSmMakeTransWide3, 1000000},
+		{"sm_make_trans_out8_comp", &FwBenchSmMakeTransWide4, 1000000},
+		{"sm_make_trans_out16", &FwBenchSmMakeTransWide5, 1000000},
+		{"sm_make_trans_out16_comp", &FwBenchSmMakeTransWide6, 1000000},
+		{"sm_make_trans_deep", &FwBenchSmMakeTransDeep1, 200000},
+		{"sm_execute_16", &FwBenchSmExecute1, 1000000},
+		{"sm_execute_16_inert", &FwBenchSmExecute2, 1000000},
+		{"sm_execute_deep", &FwBenchSmExecuteDeep1, 200000},
+		{"sm_execute_group_loop", &FwBenchSmExecuteGroup1, 1000000},
+		{"sm_execute_group", &FwBenchSmExecuteGroup2, 1000000},
+		{"sm_make_trans_deep_flat", &FwBenchSmMakeTransFlat1, 200000},
+		{"sm_execute_deep_flat", &FwBenchSmExecuteFlat1, 200000},
+		{"sm_create_release", &FwBenchSmCreate1, 50000},
+		{"sm_create_release_arena", &FwBenchSmCreateArena1, 50000},
+		{"sm_create_release_der", &FwBenchSmCreateDer1, 50000},
+		{"sm_load_image_release", &FwBenchSmLoadImage1, 50000},
+		{"sm_pool_get_put", &FwBenchSmPool1, 1000000},
+		{"sm_pool_get_put_mt", &FwBenchSmPool2, 1000000},
+		{"sm_queue_post_dispatch", &FwBenchSmQueue1, 1000000},
+		{"pr_execute_16", &FwBenchPrExecute1, 500000},
+		{"pr_execute_16_compiled", &FwBenchPrExecute2, 500000},
+		{"pr_create_release", &FwBenchPrCreate1, 50000},
+		{"pr_create_release_arena", &FwBenchPrCreateArena1, 50000},
+		{"rt_notify_latency", &FwBenchRtLatency1, 2000},
+		{"rt_notify_busy", &FwBenchRtNotify1, 20000},
+		{"rt_notify_busy_lockfree", &FwBenchRtNotify2, 20000}
+	};
+	struct FwBenchResult result;
+	FwBenchFormat_t format = benchText;
+	const char* filter = NULL;
+	long scale = 1;
+	int isFirst = 1;
+	int i;
+
+	/* Parse the command line options */
+	for (i=1; i<argc; i++) {
+		if (strcmp(argv[i], "--format=csv") == 0)
+			format = benchCsv;
+		else if (strcmp(argv[i], "--format=json") == 0)
+			format = benchJson;
+		else if (strcmp(argv[i], "--format=text") == 0)
+			format = benchText;
+		else if (strncmp(argv[i], "--filter=", 9) == 0)
+			filter = argv[i]+9;
+		else if ((strncmp(argv[i], "--scale=", 8) == 0) && (atol(argv[i]+8) > 0))
+			scale = atol(argv[i]+8);
+		else {
+			fprintf(stderr, "Usage: %s [--format=text|csv|json] [--filter=STRING] [--scale=N]\n", argv[0]);
+			return EXIT_FAILURE;
+		}
+	}
+
+	/* Run the benchmark cases */
+	for (i=0; i<N_OF_BENCH_CASES; i++) {
+		if ((filter != NULL) && (strstr(benchCases[i].name, filter) == NULL))
+			continue;
+		memset(&result, 0, sizeof(result));
+		if (benchCases[i].run(&result, benchCases[i].nOfOps*scale) == 0) {
+			fprintf(stderr, "Benchmark case %s could not be executed\n", benchCases[i].name);
+			return EXIT_FAILURE;
+		}
+		PrintResult(format, benchCases[i].name, &result, isFirst);
+		isFirst = 0;
+	}
+	if (format == benchJson)
+		printf(isFirst ? "[]\n" : "\n]\n");
+
+	return EXIT_SUCCESS;
+}
+
+/*------------------------------------------------------------------------------------*/
+static void PrintResult(FwBenchFormat_t format, const char* name, struct FwBenchResult* result, int isFirst) {
+	double nOfOps = (double)result->nOfOps;
+
+	switch (format) {
+	case benchCsv:
+		if (isFirst)
+			printf("name,ops,ns_per_op,cycles_per_op,allocs_per_op\n");
+		printf("%s,%ld,%.2f,%.2f,%.3f\n", name, result->nOfOps, result->elapsedNs/nOfOps,
+		       result->elapsedCycles/nOfOps, (double)result->nOfAllocs/nOfOps);
+		break;
+	case benchJson:
+		printf(isFirst ? "[\n" : ",\n");
+		printf("  {\"name\": \"%s\", \"ops\": %ld, \"ns_per_op\": %.2f, \"cycles_per_op\": %.2f, \"allocs_per_op\": %.3f}",
+		       name, result->nOfOps, result->elapsedNs/nOfOps, result->elapsedCycles/nOfOps,
+		       (double)result->nOfAllocs/nOfOps);
+		break;
+	default:
+		if (isFirst)
+			printf("%-26s %10s %12s %14s %14s\n", "Benchmark", "Ops", "ns/op", "cycles/op", "allocs/op");
+		printf("%-26s %10ld %12.2f %14.2f %14.3f\n", name, result->nOfOps, result->elapsedNs/nOfOps,
+		       result->elapsedCycles/nOfOps, (double)result->nOfAllocs/nOfOps);
+		break;
+	}
+}
+
+/*------------------------------------------------------------------------------------*/
+void FwBenchBegin(struct FwBenchResult* result) {
+	result->startAllocs = FwBenchGetNOfAllocs();
+	result->startNs = FwBenchGetTimeNs();
+	result->startCycles = FwBenchGetCycles();
+}
+
+/*------------------------------------------------------------------------------------*/
+void FwBenchEnd(struct FwBenchResult* result, long nOfOps) {
+	double endCycles = FwBenchGetCycles();
+	double endNs = FwBenchGetTimeNs();
+
+	result->nOfOps = nOfOps;
+	result->elapsedNs = endNs - result->startNs;
+	result->elapsedCycles = endCycles - result->startCycles;
+	result->nOfAllocs = FwBenchGetNOfAllocs() - result->startAllocs;
+}
+
+/*------------------------------------------------------------------------------------*/
+double FwBenchGetTimeNs() {
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (double)now.tv_sec*1.0e9 + (double)now.tv_nsec;
+}
+
+/*------------------------------------------------------------------------------------*/
+double FwBenchGetCycles() {
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+	unsigned int lo, hi;
+	__asm__ __volatile__ ("rdtsc" : "=a" (lo), "=d" (hi));
+	return (double)hi*4294967296.0 + (double)lo;
+#else
+	return 0;
+#endif
+}
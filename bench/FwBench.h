@@ -0,0 +1,179 @@
+/**
+ * @file
+ * @ingroup bsGroup
+ * Declaration of the benchmark harness for the FW Profile.
+ * The <i>benchmark suite</i> measures the per-operation cost of the core
+ * functions of the State Machine, Procedure and RT Container modules.
+ * Each benchmark case is a function which:
+ * -# creates and configures the state machines, procedures or RT containers
+ *    it needs (these are taken from the test suite or are synthesized by the
+ *    benchmark case itself);
+ * -# calls <code>::FwBenchBegin</code>;
+ * -# executes the operation under measurement a given number of times;
+ * -# calls <code>::FwBenchEnd</code>;
+ * -# releases its state machines, procedures or RT containers.
+ * .
+ * For each case, the harness reports the elapsed time per operation (in ns),
+ * the number of processor cycles per operation (where a cycle counter is
+ * available), and the number of memory allocations per operation.
+ *
+ * Memory allocations are counted by building the FW Profile sources with
+ * <code>malloc</code> and <code>free</code> redefined as <code>::FwBenchMalloc</code>
+ * and <code>::FwBenchFree</code> (see the <code>bench</code> target of the Makefile).
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the FW Profile.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#ifndef FWBENCH_H_
+#define FWBENCH_H_
+
+#include <stdlib.h>
+
+/** Structure holding the result of a benchmark case. */
+struct FwBenchResult {
+	/** The number of operations executed by the benchmark case. */
+	long nOfOps;
+	/** The elapsed time in ns between the calls to FwBenchBegin and FwBenchEnd. */
+	double elapsedNs;
+	/** The number of processor cycles between the calls to FwBenchBegin and FwBenchEnd (0 if not available). */
+	double elapsedCycles;
+	/** The number of memory allocations between the calls to FwBenchBegin and FwBenchEnd. */
+	long nOfAllocs;
+	/** The time stamp in ns taken by FwBenchBegin. */
+	double startNs;
+	/** The cycle counter value taken by FwBenchBegin. */
+	double startCycles;
+	/** The allocation counter value taken by FwBenchBegin. */
+	long startAllocs;
+};
+
+/**
+ * Type for a benchmark case.
+ * A benchmark case executes the operation under measurement <code>nOfOps</code>
+ * times between a call to <code>::FwBenchBegin</code> and a call to
+ * <code>::FwBenchEnd</code>.
+ * @param result the result of the benchmark case
+ * @param nOfOps the number of operations to be executed
+ * @return 1 if the benchmark case was executed successfully, 0 otherwise
+ */
+typedef int (*FwBenchCase_t)(struct FwBenchResult* result, long nOfOps);
+
+/**
+ * Start the measurement of a benchmark case.
+ * @param result the result of the benchmark case
+ */
+void FwBenchBegin(struct FwBenchResult* result);
+
+/**
+ * End the measurement of a benchmark case.
+ * @param result the result of the benchmark case
+ * @param nOfOps the number of operations executed since the call to
+ * <code>::FwBenchBegin</code>
+ */
+void FwBenchEnd(struct FwBenchResult* result, long nOfOps);
+
+/**
+ * Return the value of a monotonic clock in ns.
+ * @return the value of a monotonic clock in ns
+ */
+double FwBenchGetTimeNs();
+
+/**
+ * Return the value of the processor cycle counter.
+ * @return the value of the processor cycle counter or 0 if no cycle counter is available
+ */
+double FwBenchGetCycles();
+
+/**
+ * Replacement for <code>malloc</code> used by the FW Profile sources in the benchmark
+ * build which counts the number of allocations.
+ * @param size the number of bytes to allocate
+ * @return the pointer to the allocated memory or NULL if the allocation failed
+ */
+void* FwBenchMalloc(size_t size);
+
+/**
+ * Replacement for <code>free</code> used by the FW Profile sources in the benchmark build.
+ * @param ptr the pointer to the memory to be released
+ */
+void FwBenchFree(void* ptr);
+
+/**
+ * Return the number of allocations made through <code>::FwBenchMalloc</code>.
+ * @return the number of allocations
+ */
+long FwBenchGetNOfAllocs();
+
+/** Benchmark for FwSmMakeTrans on a state machine with 16 states. */
+int FwBenchSmMakeTrans1(struct FwBenchResult* result, long nOfOps);
+/** Benchmark for FwSmMakeTrans on a state machine with the maximum number of states. */
+int FwBenchSmMakeTrans2(struct FwBenchResult* result, long nOfOps);
+/** Benchmark for FwSmMakeTrans on a compiled state machine with 16 states. */
+int FwBenchSmMakeTrans3(struct FwBenchResult* result, long nOfOps);
+/** Benchmark for FwSmMakeTrans on a state with many out-going transitions. */
+int FwBenchSmMakeTransWide1(struct FwBenchResult* result, long nOfOps);
+/** Benchmark for FwSmMakeTrans on a compiled state with many out-going transitions. */
+int FwBenchSmMakeTransWide2(struct FwBenchResult* result, long nOfOps);
+/** Benchmark for FwSmMakeTrans on a state with 8 out-going transitions. */
+int FwBenchSmMakeTransWide3(struct FwBenchResult* result, long nOfOps);
+/** Benchmark for FwSmMakeTrans on a compiled state with 8 out-going transitions. */
+int FwBenchSmMakeTransWide4(struct FwBenchResult* result, long nOfOps);
+/** Benchmark for FwSmMakeTrans on a state with 16 out-going transitions. */
+int FwBenchSmMakeTransWide5(struct FwBenchResult* result, long nOfOps);
+/** Benchmark for FwSmMakeTrans on a compiled state with 16 out-going transitions. */
+int FwBenchSmMakeTransWide6(struct FwBenchResult* result, long nOfOps);
+/** Benchmark for FwSmMakeTrans on a chain of nested state machines. */
+int FwBenchSmMakeTransDeep1(struct FwBenchResult* result, long nOfOps);
+/** Benchmark for FwSmExecute on a state machine with 16 states. */
+int FwBenchSmExecute1(struct FwBenchResult* result, long nOfOps);
+/** Benchmark for FwSmExecute on a state machine with 16 execute-inert states. */
+int FwBenchSmExecute2(struct FwBenchResult* result, long nOfOps);
+/** Benchmark for FwSmExecute on a chain of nested state machines. */
+int FwBenchSmExecuteDeep1(struct FwBenchResult* result, long nOfOps);
+/** Benchmark for FwSmExecute on state machines derived from the same state machine. */
+int FwBenchSmExecuteGroup1(struct FwBenchResult* result, long nOfOps);
+/** Benchmark for FwSmGroupExecute on state machines derived from the same state machine. */
+int FwBenchSmExecuteGroup2(struct FwBenchResult* result, long nOfOps);
+/** Benchmark for FwSmFlatMakeTrans on a flattened chain of nested state machines. */
+int FwBenchSmMakeTransFlat1(struct FwBenchResult* result, long nOfOps);
+/** Benchmark for FwSmFlatExecute on a flattened chain of nested state machines. */
+int FwBenchSmExecuteFlat1(struct FwBenchResult* result, long nOfOps);
+/** Benchmark for FwSmCreate and FwSmRelease. */
+int FwBenchSmCreate1(struct FwBenchResult* result, long nOfOps);
+/** Benchmark for FwSmCreateArena and FwSmReleaseArena. */
+int FwBenchSmCreateArena1(struct FwBenchResult* result, long nOfOps);
+/** Benchmark for FwSmCreateDer and FwSmReleaseDer. */
+int FwBenchSmCreateDer1(struct FwBenchResult* result, long nOfOps);
+/** Benchmark for FwSmLoadImage and FwSmReleaseArena. */
+int FwBenchSmLoadImage1(struct FwBenchResult* result, long nOfOps);
+/** Benchmark for FwSmPoolGet and FwSmPoolPut. */
+int FwBenchSmPool1(struct FwBenchResult* result, long nOfOps);
+/** Benchmark for FwSmPoolGet and FwSmPoolPut on a thread-safe pool. */
+int FwBenchSmPool2(struct FwBenchResult* result, long nOfOps);
+/** Benchmark for FwSmQueuePost and FwSmQueueDispatch on a state machine with 16 states. */
+int FwBenchSmQueue1(struct FwBenchResult* result, long nOfOps);
+/** Benchmark for FwPrStart and FwPrExecute on a procedure with 16 action nodes. */
+int FwBenchPrExecute1(struct FwBenchResult* result, long nOfOps);
+/** Benchmark for FwPrStart and FwPrExecute on a compiled procedure with 16 action nodes. */
+int FwBenchPrExecute2(struct FwBenchResult* result, long nOfOps);
+/** Benchmark for FwPrCreate and FwPrRelease. */
+int FwBenchPrCreate1(struct FwBenchResult* result, long nOfOps);
+/** Benchmark for FwPrCreateArena and FwPrReleaseArena. */
+int FwBenchPrCreateArena1(struct FwBenchResult* result, long nOfOps);
+/** Benchmark for the latency from FwRtNotify to the execution of the functional behaviour. */
+int FwBenchRtLatency1(struct FwBenchResult* result, long nOfOps);
+/** Benchmark for FwRtNotify while the Activation Thread is busy. */
+int FwBenchRtNotify1(struct FwBenchResult* result, long nOfOps);
+/** Benchmark for FwRtNotify in the lock-free notification mode while the Activation Thread is busy. */
+int FwBenchRtNotify2(struct FwBenchResult* result, long nOfOps);
+
+#endif /* FWBENCH_H_ */
@@ -0,0 +1,44 @@
+/**
+ * @file
+ * @ingroup bsGroup
+ * Implementation of the allocation counters of the benchmark harness.
+ * This file is compiled with the same flags as the FW Profile sources in the
+ * benchmark build (where <code>malloc</code> and <code>free</code> are redefined
+ * as <code>::FwBenchMalloc</code> and <code>::FwBenchFree</code>) and must
+ * therefore undo the redefinition before calling the C library.
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the FW Profile.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#undef malloc
+#undef free
+
+#include <stdlib.h>
+
+/** The number of allocations made through FwBenchMalloc. */
+static long nOfAllocs = 0;
+
+/*------------------------------------------------------------------------------------*/
+void* FwBenchMalloc(size_t size) {
+	nOfAllocs++;
+	return malloc(size);
+}
+
+/*------------------------------------------------------------------------------------*/
+void FwBenchFree(void* ptr) {
+	free(ptr);
+}
+
+/*------------------------------------------------------------------------------------*/
+long FwBenchGetNOfAllocs() {
+	return nOfAllocs;
+}
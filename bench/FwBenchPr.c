@@ -0,0 +1,112 @@
+/**
+ * @file
+ * @ingroup bsGroup
+ * Benchmark cases for the Procedure Module.
+ * The benchmark cases use the test procedures of <code>FwPrMakeTest.h</code>.
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the FW Profile.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "FwBench.h"
+#include "FwPrConstants.h"
+#include "FwPrConfig.h"
+#include "FwPrCore.h"
+#include "FwPrDCreate.h"
+#include "FwPrMakeTest.h"
+
+/** The data of the benchmark procedures */
+static struct TestPrData prData;
+
+/** Location in the log array of the test procedures where the next entry is written. */
+extern int fwPrLogIndex;
+
+/*------------------------------------------------------------------------------------*/
+int FwBenchPrExecute1(struct FwBenchResult* result, long nOfOps) {
+	FwPrDesc_t prDesc;
+	long i;
+
+	memset(&prData, 0, sizeof(prData));
+	if ((prDesc = FwPrMakeTestPRLarge(16, &prData)) == NULL)
+		return 0;
+
+	/* Each operation runs the procedure from its initial node to its final node */
+	FwBenchBegin(result);
+	for (i=0; i<nOfOps; i++) {
+		fwPrLogIndex = 0;
+		FwPrStart(prDesc);
+		FwPrExecute(prDesc);
+	}
+	FwBenchEnd(result, nOfOps);
+
+	FwPrRelease(prDesc);
+	return 1;
+}
+
+/*------------------------------------------------------------------------------------*/
+int FwBenchPrExecute2(struct FwBenchResult* result, long nOfOps) {
+	FwPrDesc_t prDesc;
+	long i;
+
+	memset(&prData, 0, sizeof(prData));
+	if ((prDesc = FwPrMakeTestPRLarge(16, &prData)) == NULL)
+		return 0;
+	if (FwPrCompile(prDesc) != prSuccess) {
+		FwPrRelease(prDesc);
+		return 0;
+	}
+
+	/* Same operation as in FwBenchPrExecute1 on the compiled procedure */
+	FwBenchBegin(result);
+	for (i=0; i<nOfOps; i++) {
+		fwPrLogIndex = 0;
+		FwPrStart(prDesc);
+		FwPrExecute(prDesc);
+	}
+	FwBenchEnd(result, nOfOps);
+
+	FwPrRelease(prDesc);
+	return 1;
+}
+
+/*------------------------------------------------------------------------------------*/
+int FwBenchPrCreate1(struct FwBenchResult* result, long nOfOps) {
+	FwPrDesc_t prDesc;
+	long i;
+
+	memset(&prData, 0, sizeof(prData));
+	FwBenchBegin(result);
+	for (i=0; i<nOfOps; i++) {
+		if ((prDesc = FwPrMakeTestPRLarge(16, &prData)) == NULL)
+			return 0;
+		FwPrRelease(prDesc);
+	}
+	FwBenchEnd(result, nOfOps);
+	return 1;
+}
+
+/*------------------------------------------------------------------------------------*/
+int FwBenchPrCreateArena1(struct FwBenchResult* result, long nOfOps) {
+	FwPrDesc_t prDesc;
+	long i;
+
+	memset(&prData, 0, sizeof(prData));
+	FwBenchBegin(result);
+	for (i=0; i<nOfOps; i++) {
+		if ((prDesc = FwPrMakeTestPRLargeArena(16, NULL, 0, &prData)) == NULL)
+			return 0;
+		FwPrReleaseArena(prDesc);
+	}
+	FwBenchEnd(result, nOfOps);
+	return 1;
+}
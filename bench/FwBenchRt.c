@@ -0,0 +1,138 @@
+/**
+ * @file
+ * @ingroup bsGroup
+ * Benchmark cases for the RT Container Module.
+ * The benchmark cases use the test RT Container RT1 of <code>FwRtMakeTest.h</code>.
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the FW Profile.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#define _POSIX_C_SOURCE 200112L
+
+#include <sched.h>
+#include <stdlib.h>
+#include "FwBench.h"
+#include "FwRtConstants.h"
+#include "FwRtConfig.h"
+#include "FwRtCore.h"
+#include "FwRtMakeTest.h"
+
+/**
+ * Create and start a test RT Container RT1 whose functional behaviour is executed
+ * at every notification and never terminates.
+ * @param i the index of the RT1 instance
+ * @param lockFreeNotif 1 if the lock-free notification mode is to be enabled
+ * @return the descriptor of the RT Container
+ */
+static FwRtDesc_t MakeBenchRt(unsigned int i, FwRtBool_t lockFreeNotif);
+
+/**
+ * Stop a RT Container created by <code>MakeBenchRt</code> and shut it down.
+ * @param rtDesc the descriptor of the RT Container
+ * @return 1 if the RT Container was shut down without errors, 0 otherwise
+ */
+static int ReleaseBenchRt(FwRtDesc_t rtDesc);
+
+/**
+ * Wait until the functional behaviour of a RT Container has been executed a given
+ * number of times.
+ * @param rtData the data of the RT Container
+ * @param n the number of executions
+ */
+static void WaitForExec(struct TestRtData* rtData, int n);
+
+/*------------------------------------------------------------------------------------*/
+int FwBenchRtLatency1(struct FwBenchResult* result, long nOfOps) {
+	FwRtDesc_t rtDesc = MakeBenchRt(1, 0);
+	struct TestRtData* rtData = (struct TestRtData*)FwRtGetData(rtDesc);
+	long i;
+
+	/* Each operation is a notification followed by the wait for its activation */
+	FwBenchBegin(result);
+	for (i=0; i<nOfOps; i++) {
+		FwRtNotify(rtDesc);
+		WaitForExec(rtData, (int)(i+1));
+	}
+	FwBenchEnd(result, nOfOps);
+
+	return ReleaseBenchRt(rtDesc);
+}
+
+/*------------------------------------------------------------------------------------*/
+int FwBenchRtNotify1(struct FwBenchResult* result, long nOfOps) {
+	FwRtDesc_t rtDesc = MakeBenchRt(2, 0);
+	struct TestRtData* rtData = (struct TestRtData*)FwRtGetData(rtDesc);
+	long i;
+
+	if (nOfOps > FW_RT_COUNTER_U2_MAX)
+		nOfOps = FW_RT_COUNTER_U2_MAX;
+
+	/* Only the cost of the notifications is measured */
+	FwBenchBegin(result);
+	for (i=0; i<nOfOps; i++)
+		FwRtNotify(rtDesc);
+	FwBenchEnd(result, nOfOps);
+
+	WaitForExec(rtData, (int)nOfOps);
+	return ReleaseBenchRt(rtDesc);
+}
+
+/*------------------------------------------------------------------------------------*/
+int FwBenchRtNotify2(struct FwBenchResult* result, long nOfOps) {
+	FwRtDesc_t rtDesc = MakeBenchRt(3, 1);
+	struct TestRtData* rtData = (struct TestRtData*)FwRtGetData(rtDesc);
+	long i;
+
+	if (nOfOps > FW_RT_COUNTER_U2_MAX)
+		nOfOps = FW_RT_COUNTER_U2_MAX;
+
+	FwBenchBegin(result);
+	for (i=0; i<nOfOps; i++)
+		FwRtNotify(rtDesc);
+	FwBenchEnd(result, nOfOps);
+
+	WaitForExec(rtData, (int)nOfOps);
+	return ReleaseBenchRt(rtDesc);
+}
+
+/*------------------------------------------------------------------------------------*/
+static FwRtDesc_t MakeBenchRt(unsigned int i, FwRtBool_t lockFreeNotif) {
+	FwRtDesc_t rtDesc = FwRtMakeTestRT1(i);
+	struct TestRtData* rtData;
+
+	if (lockFreeNotif == 1) {
+		FwRtShutdown(rtDesc);
+		FwRtSetLockFreeNotif(rtDesc, 1);
+		FwRtInit(rtDesc);
+	}
+
+	rtData = (struct TestRtData*)FwRtGetData(rtDesc);
+	rtData->npImplNotifLogicFlag = 1;	/* do not skip notification */
+	rtData->apExecFuncBehaviourFlag = 0; /* do not terminate functional behaviour */
+	rtData->apImplActivLogicFlag = 1; /* execute functional behaviour */
+	FwRtStart(rtDesc);
+	return rtDesc;
+}
+
+/*------------------------------------------------------------------------------------*/
+static int ReleaseBenchRt(FwRtDesc_t rtDesc) {
+	FwRtStop(rtDesc);
+	FwRtWaitForTermination(rtDesc);
+	FwRtShutdown(rtDesc);
+	return (FwRtGetErrCode(rtDesc) == 0);
+}
+
+/*------------------------------------------------------------------------------------*/
+static void WaitForExec(struct TestRtData* rtData, int n) {
+	while (*(volatile int*)&(rtData->apExecFuncBehaviourCounter) < n)
+		sched_yield();
+}
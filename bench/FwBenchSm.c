@@ -0,0 +1,626 @@
+/**
+ * @file
+ * @ingroup bsGroup
+ * Benchmark cases for the State Machine Module.
+ * The benchmark cases use the test state machines of <code>FwSmMakeTest.h</code>
+ * and synthesize chains of nested state machines from them.
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the FW Profile.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "FwBench.h"
+#include "FwSmConstants.h"
+#include "FwSmCore.h"
+#include "FwSmConfig.h"
+#include "FwSmDCreate.h"
+#include "FwSmFlat.h"
+#include "FwSmGroup.h"
+#include "FwSmPool.h"
+#include "FwSmQueue.h"
+#include "FwSmPrivate.h"
+#include "FwSmMakeTest.h"
+
+/** The number of states of the "large" state machine (bounded to keep the benchmark short). */
+#define BENCH_SM_LARGE_N (((FW_SM_COUNTER_S1_MAX-2) < 1000) ? (FW_SM_COUNTER_S1_MAX-2) : 1000)
+
+/** The number of out-going transitions of the state of the "wide" state machine. */
+#define BENCH_SM_WIDE_N (((FW_SM_COUNTER_S1_MAX-2) < 250) ? (FW_SM_COUNTER_S1_MAX-2) : 250)
+
+/** The number of nesting levels of the "deep" chain of state machines. */
+#define BENCH_SM_DEPTH 8
+
+/** The number of derived state machines which are executed together in the group benchmarks. */
+#define BENCH_SM_GROUP_N 64
+
+/** The data of the benchmark state machines */
+static struct TestSmData smData;
+
+/** Location in the log array of the test state machines where the next entry is written. */
+extern int fwSm_logIndex;
+
+/**
+ * Create a chain of nested state machines.
+ * The i-th state machine in the chain is a derived state machine of
+ * <code>::FwSmMakeTestSMLarge</code> with two states which is embedded in state S1
+ * of the (i-1)-th state machine.
+ * @param smBaseDesc the array where the base state machines are stored
+ * @param smDesc the array where the derived state machines are stored
+ * @return 1 if the chain was created successfully, 0 otherwise
+ */
+static int MakeDeepChain(FwSmDesc_t* smBaseDesc, FwSmDesc_t* smDesc);
+
+/**
+ * Release a chain of nested state machines created with <code>MakeDeepChain</code>.
+ * @param smBaseDesc the array holding the base state machines
+ * @param smDesc the array holding the derived state machines
+ */
+static void ReleaseDeepChain(FwSmDesc_t* smBaseDesc, FwSmDesc_t* smDesc);
+
+/**
+ * Run the benchmark for FwSmPoolGet and FwSmPoolPut on a pool of four state machines
+ * derived from a state machine with 16 states.
+ * @param result the result of the benchmark
+ * @param nOfOps the number of get/put pairs
+ * @param threadSafe 1 if the pool is thread-safe, 0 otherwise
+ * @return 1 if the benchmark was successful, 0 otherwise
+ */
+static int RunPool(struct FwBenchResult* result, long nOfOps, int threadSafe);
+
+/**
+ * Run the benchmark of <code>::FwSmMakeTrans</code> on a state machine with one state
+ * which has N self-transitions with the distinct identifiers 1 to N.
+ * The transitions are triggered in an order which visits all the identifiers and which
+ * is not sequential (N must not be a multiple of 37).
+ * @param result the result of the benchmark case
+ * @param nOfOps the number of operations to be performed
+ * @param nOfTrans the number N of self-transitions
+ * @param isCompiled 1 if the state machine is compiled with <code>::FwSmCompile</code>
+ * @return 1 if the benchmark ran successfully, 0 otherwise
+ */
+static int RunWide(struct FwBenchResult* result, long nOfOps, FwSmCounterS1_t nOfTrans, int isCompiled);
+
+/**
+ * Run the benchmark of the execution of <code>#BENCH_SM_GROUP_N</code> state machines
+ * derived from the same state machine.
+ * The base state machine has four states which have a do-action and no "Execute"
+ * transition.
+ * Each operation is the execution of one state machine.
+ * @param result the result of the benchmark case
+ * @param nOfOps the number of operations to be performed
+ * @param isGroup 1 if the state machines are executed with <code>::FwSmGroupExecute</code>,
+ * 0 if they are executed one by one with <code>::FwSmExecute</code>
+ * @return 1 if the benchmark ran successfully, 0 otherwise
+ */
+static int RunGroup(struct FwBenchResult* result, long nOfOps, int isGroup);
+
+/**
+ * Do-action of the state machines of <code>RunGroup</code>.
+ * @param smDesc the state machine descriptor
+ */
+static void GroupDoAction(FwSmDesc_t smDesc);
+
+/*------------------------------------------------------------------------------------*/
+int FwBenchSmMakeTrans1(struct FwBenchResult* result, long nOfOps) {
+	FwSmDesc_t smDesc;
+	long i;
+
+	memset(&smData, 0, sizeof(smData));
+	if ((smDesc = FwSmMakeTestSMLarge(16, &smData)) == NULL)
+		return 0;
+	FwSmStart(smDesc);
+	fwSm_logIndex = 0;
+
+	FwBenchBegin(result);
+	for (i=0; i<nOfOps; i++) {
+		fwSm_logIndex = 0;
+		FwSmMakeTrans(smDesc, TR1);
+	}
+	FwBenchEnd(result, nOfOps);
+
+	FwSmRelease(smDesc);
+	return 1;
+}
+
+/*------------------------------------------------------------------------------------*/
+int FwBenchSmMakeTrans2(struct FwBenchResult* result, long nOfOps) {
+	FwSmDesc_t smDesc;
+	long i;
+
+	memset(&smData, 0, sizeof(smData));
+	if ((smDesc = FwSmMakeTestSMLarge((FwSmCounterS1_t)BENCH_SM_LARGE_N, &smData)) == NULL)
+		return 0;
+	FwSmStart(smDesc);
+	fwSm_logIndex = 0;
+
+	FwBenchBegin(result);
+	for (i=0; i<nOfOps; i++) {
+		fwSm_logIndex = 0;
+		FwSmMakeTrans(smDesc, TR1);
+	}
+	FwBenchEnd(result, nOfOps);
+
+	FwSmRelease(smDesc);
+	return 1;
+}
+
+/*------------------------------------------------------------------------------------*/
+int FwBenchSmMakeTrans3(struct FwBenchResult* result, long nOfOps) {
+	FwSmDesc_t smDesc;
+	long i;
+
+	memset(&smData, 0, sizeof(smData));
+	if ((smDesc = FwSmMakeTestSMLarge(16, &smData)) == NULL)
+		return 0;
+	if (FwSmCompile(smDesc) != smSuccess) {
+		FwSmRelease(smDesc);
+		return 0;
+	}
+	FwSmStart(smDesc);
+	fwSm_logIndex = 0;
+
+	/* The states have fewer out-going transitions than FW_SM_DISP_MIN_OUT_TRANS */
+	FwBenchBegin(result);
+	for (i=0; i<nOfOps; i++) {
+		fwSm_logIndex = 0;
+		FwSmMakeTrans(smDesc, TR1);
+	}
+	FwBenchEnd(result, nOfOps);
+
+	FwSmRelease(smDesc);
+	return 1;
+}
+
+/*------------------------------------------------------------------------------------*/
+int FwBenchSmMakeTransWide1(struct FwBenchResult* result, long nOfOps) {
+	return RunWide(result, nOfOps, (FwSmCounterS1_t)BENCH_SM_WIDE_N, 0);
+}
+
+/*------------------------------------------------------------------------------------*/
+int FwBenchSmMakeTransWide2(struct FwBenchResult* result, long nOfOps) {
+	return RunWide(result, nOfOps, (FwSmCounterS1_t)BENCH_SM_WIDE_N, 1);
+}
+
+/*------------------------------------------------------------------------------------*/
+int FwBenchSmMakeTransWide3(struct FwBenchResult* result, long nOfOps) {
+	return RunWide(result, nOfOps, 8, 0);
+}
+
+/*------------------------------------------------------------------------------------*/
+int FwBenchSmMakeTransWide4(struct FwBenchResult* result, long nOfOps) {
+	return RunWide(result, nOfOps, 8, 1);
+}
+
+/*------------------------------------------------------------------------------------*/
+int FwBenchSmMakeTransWide5(struct FwBenchResult* result, long nOfOps) {
+	return RunWide(result, nOfOps, 16, 0);
+}
+
+/*------------------------------------------------------------------------------------*/
+int FwBenchSmMakeTransWide6(struct FwBenchResult* result, long nOfOps) {
+	return RunWide(result, nOfOps, 16, 1);
+}
+
+/*------------------------------------------------------------------------------------*/
+int FwBenchSmMakeTransDeep1(struct FwBenchResult* result, long nOfOps) {
+	FwSmDesc_t smBaseDesc[BENCH_SM_DEPTH];
+	FwSmDesc_t smDesc[BENCH_SM_DEPTH];
+	long i;
+
+	if (!MakeDeepChain(smBaseDesc, smDesc))
+		return 0;
+	FwSmStart(smDesc[0]);
+	fwSm_logIndex = 0;
+
+	/* Each transition alternately stops and restarts the whole chain */
+	FwBenchBegin(result);
+	for (i=0; i<nOfOps; i++) {
+		fwSm_logIndex = 0;
+		FwSmMakeTrans(smDesc[0], TR1);
+	}
+	FwBenchEnd(result, nOfOps);
+
+	ReleaseDeepChain(smBaseDesc, smDesc);
+	return 1;
+}
+
+/*------------------------------------------------------------------------------------*/
+int FwBenchSmExecute1(struct FwBenchResult* result, long nOfOps) {
+	FwSmDesc_t smDesc;
+	long i;
+
+	memset(&smData, 0, sizeof(smData));
+	if ((smDesc = FwSmMakeTestSMLarge(16, &smData)) == NULL)
+		return 0;
+	FwSmStart(smDesc);
+	fwSm_logIndex = 0;
+
+	FwBenchBegin(result);
+	for (i=0; i<nOfOps; i++)
+		FwSmExecute(smDesc);
+	FwBenchEnd(result, nOfOps);
+
+	FwSmRelease(smDesc);
+	return 1;
+}
+
+/*------------------------------------------------------------------------------------*/
+int FwBenchSmExecute2(struct FwBenchResult* result, long nOfOps) {
+	FwSmDesc_t smDesc;
+	long i;
+
+	/* The states have no do-action and no "Execute" transition: the check marks them execute-inert */
+	memset(&smData, 0, sizeof(smData));
+	if ((smDesc = FwSmMakeTestSMLarge(16, &smData)) == NULL)
+		return 0;
+	if (FwSmCheck(smDesc) != smSuccess) {
+		FwSmRelease(smDesc);
+		return 0;
+	}
+	FwSmStart(smDesc);
+	fwSm_logIndex = 0;
+
+	FwBenchBegin(result);
+	for (i=0; i<nOfOps; i++)
+		FwSmExecute(smDesc);
+	FwBenchEnd(result, nOfOps);
+
+	FwSmRelease(smDesc);
+	return 1;
+}
+
+/*------------------------------------------------------------------------------------*/
+int FwBenchSmExecuteDeep1(struct FwBenchResult* result, long nOfOps) {
+	FwSmDesc_t smBaseDesc[BENCH_SM_DEPTH];
+	FwSmDesc_t smDesc[BENCH_SM_DEPTH];
+	long i;
+
+	if (!MakeDeepChain(smBaseDesc, smDesc))
+		return 0;
+	FwSmStart(smDesc[0]);
+	fwSm_logIndex = 0;
+
+	FwBenchBegin(result);
+	for (i=0; i<nOfOps; i++)
+		FwSmExecute(smDesc[0]);
+	FwBenchEnd(result, nOfOps);
+
+	ReleaseDeepChain(smBaseDesc, smDesc);
+	return 1;
+}
+
+/*------------------------------------------------------------------------------------*/
+int FwBenchSmExecuteGroup1(struct FwBenchResult* result, long nOfOps) {
+	return RunGroup(result, nOfOps, 0);
+}
+
+/*------------------------------------------------------------------------------------*/
+int FwBenchSmExecuteGroup2(struct FwBenchResult* result, long nOfOps) {
+	return RunGroup(result, nOfOps, 1);
+}
+
+/*------------------------------------------------------------------------------------*/
+int FwBenchSmMakeTransFlat1(struct FwBenchResult* result, long nOfOps) {
+	FwSmDesc_t smBaseDesc[BENCH_SM_DEPTH];
+	FwSmDesc_t smDesc[BENCH_SM_DEPTH];
+	FwSmFlatDesc_t flat;
+	long i;
+
+	if (!MakeDeepChain(smBaseDesc, smDesc))
+		return 0;
+	if ((flat = FwSmFlatCreate(smDesc[0])) == NULL)
+		return 0;
+	FwSmFlatStart(flat);
+	fwSm_logIndex = 0;
+
+	/* Each transition alternately stops and restarts the whole chain */
+	FwBenchBegin(result);
+	for (i=0; i<nOfOps; i++) {
+		fwSm_logIndex = 0;
+		FwSmFlatMakeTrans(flat, TR1);
+	}
+	FwBenchEnd(result, nOfOps);
+
+	FwSmFlatRelease(flat);
+	ReleaseDeepChain(smBaseDesc, smDesc);
+	return 1;
+}
+
+/*------------------------------------------------------------------------------------*/
+int FwBenchSmExecuteFlat1(struct FwBenchResult* result, long nOfOps) {
+	FwSmDesc_t smBaseDesc[BENCH_SM_DEPTH];
+	FwSmDesc_t smDesc[BENCH_SM_DEPTH];
+	FwSmFlatDesc_t flat;
+	long i;
+
+	if (!MakeDeepChain(smBaseDesc, smDesc))
+		return 0;
+	if ((flat = FwSmFlatCreate(smDesc[0])) == NULL)
+		return 0;
+	FwSmFlatStart(flat);
+	fwSm_logIndex = 0;
+
+	FwBenchBegin(result);
+	for (i=0; i<nOfOps; i++)
+		FwSmFlatExecute(flat);
+	FwBenchEnd(result, nOfOps);
+
+	FwSmFlatRelease(flat);
+	ReleaseDeepChain(smBaseDesc, smDesc);
+	return 1;
+}
+
+/*------------------------------------------------------------------------------------*/
+int FwBenchSmCreate1(struct FwBenchResult* result, long nOfOps) {
+	FwSmDesc_t smDesc;
+	long i;
+
+	memset(&smData, 0, sizeof(smData));
+	FwBenchBegin(result);
+	for (i=0; i<nOfOps; i++) {
+		if ((smDesc = FwSmMakeTestSMLarge(16, &smData)) == NULL)
+			return 0;
+		FwSmRelease(smDesc);
+	}
+	FwBenchEnd(result, nOfOps);
+	return 1;
+}
+
+/*------------------------------------------------------------------------------------*/
+int FwBenchSmCreateArena1(struct FwBenchResult* result, long nOfOps) {
+	FwSmDesc_t smDesc;
+	long i;
+
+	memset(&smData, 0, sizeof(smData));
+	FwBenchBegin(result);
+	for (i=0; i<nOfOps; i++) {
+		if ((smDesc = FwSmMakeTestSMLargeArena(16, NULL, 0, &smData)) == NULL)
+			return 0;
+		FwSmReleaseArena(smDesc);
+	}
+	FwBenchEnd(result, nOfOps);
+	return 1;
+}
+
+/*------------------------------------------------------------------------------------*/
+int FwBenchSmCreateDer1(struct FwBenchResult* result, long nOfOps) {
+	FwSmDesc_t smBaseDesc;
+	FwSmDesc_t smDesc;
+	long i;
+
+	memset(&smData, 0, sizeof(smData));
+	if ((smBaseDesc = FwSmMakeTestSMLarge(16, &smData)) == NULL)
+		return 0;
+
+	FwBenchBegin(result);
+	for (i=0; i<nOfOps; i++) {
+		if ((smDesc = FwSmCreateDer(smBaseDesc)) == NULL)
+			return 0;
+		FwSmReleaseDer(smDesc);
+	}
+	FwBenchEnd(result, nOfOps);
+
+	FwSmRelease(smBaseDesc);
+	return 1;
+}
+
+/*------------------------------------------------------------------------------------*/
+int FwBenchSmLoadImage1(struct FwBenchResult* result, long nOfOps) {
+	FwSmDesc_t smBaseDesc;
+	FwSmDesc_t smDesc;
+	FwSmCounterU4_t size;
+	void* image;
+	long i;
+
+	memset(&smData, 0, sizeof(smData));
+	if ((smBaseDesc = FwSmMakeTestSMLarge(16, &smData)) == NULL)
+		return 0;
+	size = FwSmGetImageSize(smBaseDesc);
+	if (((image = malloc(size)) == NULL) || (FwSmExportImage(smBaseDesc, image, size) != size))
+		return 0;
+
+	FwBenchBegin(result);
+	for (i=0; i<nOfOps; i++) {
+		smDesc = FwSmLoadImage(image, size, smBaseDesc->smActions+1, (FwSmCounterS1_t)(smBaseDesc->nOfActions-1),
+		                       smBaseDesc->smGuards+1, (FwSmCounterS1_t)(smBaseDesc->nOfGuards-1));
+		if (smDesc == NULL)
+			return 0;
+		FwSmReleaseArena(smDesc);
+	}
+	FwBenchEnd(result, nOfOps);
+
+	free(image);
+	FwSmRelease(smBaseDesc);
+	return 1;
+}
+
+/*------------------------------------------------------------------------------------*/
+int FwBenchSmPool1(struct FwBenchResult* result, long nOfOps) {
+	return RunPool(result, nOfOps, 0);
+}
+
+/*------------------------------------------------------------------------------------*/
+int FwBenchSmPool2(struct FwBenchResult* result, long nOfOps) {
+	return RunPool(result, nOfOps, 1);
+}
+
+/*------------------------------------------------------------------------------------*/
+int FwBenchSmQueue1(struct FwBenchResult* result, long nOfOps) {
+	FwSmDesc_t smDesc;
+	FwSmQueueDesc_t queue;
+	long i;
+
+	memset(&smData, 0, sizeof(smData));
+	if ((smDesc = FwSmMakeTestSMLarge(16, &smData)) == NULL)
+		return 0;
+	if ((queue = FwSmQueueCreate(smDesc, 16, 16)) == NULL) {
+		FwSmRelease(smDesc);
+		return 0;
+	}
+	FwSmStart(smDesc);
+	fwSm_logIndex = 0;
+
+	FwBenchBegin(result);
+	for (i=0; i<nOfOps; i++) {
+		fwSm_logIndex = 0;
+		if ((FwSmQueuePost(queue, TR1) != smSuccess) || (FwSmQueueDispatch(queue, 1) != 1))
+			return 0;
+	}
+	FwBenchEnd(result, nOfOps);
+
+	FwSmQueueRelease(queue);
+	FwSmRelease(smDesc);
+	return 1;
+}
+
+/*------------------------------------------------------------------------------------*/
+static int RunPool(struct FwBenchResult* result, long nOfOps, int threadSafe) {
+	FwSmDesc_t smBaseDesc;
+	FwSmDesc_t smDesc;
+	FwSmPoolDesc_t pool;
+	long i;
+
+	memset(&smData, 0, sizeof(smData));
+	if ((smBaseDesc = FwSmMakeTestSMLarge(16, &smData)) == NULL)
+		return 0;
+	if ((pool = FwSmPoolCreate(smBaseDesc, 4, threadSafe)) == NULL)
+		return 0;
+
+	FwBenchBegin(result);
+	for (i=0; i<nOfOps; i++) {
+		if ((smDesc = FwSmPoolGet(pool)) == NULL)
+			return 0;
+		FwSmPoolPut(pool, smDesc);
+	}
+	FwBenchEnd(result, nOfOps);
+
+	FwSmPoolRelease(pool);
+	FwSmRelease(smBaseDesc);
+	return 1;
+}
+
+/*------------------------------------------------------------------------------------*/
+static int RunWide(struct FwBenchResult* result, long nOfOps, FwSmCounterS1_t nOfTrans, int isCompiled) {
+	FwSmDesc_t smDesc;
+	FwSmCounterS1_t j;
+	long i;
+
+	if ((smDesc = FwSmCreate(1, 0, (FwSmCounterS1_t)(nOfTrans + 1), 0, 0)) == NULL)
+		return 0;
+	FwSmAddState(smDesc, 1, nOfTrans, NULL, NULL, NULL, NULL);
+	FwSmAddTransIpsToSta(smDesc, 1, NULL);
+	for (j=1; j<=nOfTrans; j++)
+		FwSmAddTransStaToSta(smDesc, (FwSmCounterU2_t)j, 1, 1, NULL, NULL);
+	if (((isCompiled == 0) && (FwSmCheck(smDesc) != smSuccess)) ||
+	        ((isCompiled != 0) && (FwSmCompile(smDesc) != smSuccess))) {
+		FwSmRelease(smDesc);
+		return 0;
+	}
+	FwSmStart(smDesc);
+
+	FwBenchBegin(result);
+	for (i=0; i<nOfOps; i++)
+		FwSmMakeTrans(smDesc, (FwSmCounterU2_t)(((i*37) % nOfTrans) + 1));
+	FwBenchEnd(result, nOfOps);
+
+	FwSmRelease(smDesc);
+	return 1;
+}
+
+/*------------------------------------------------------------------------------------*/
+static int MakeDeepChain(FwSmDesc_t* smBaseDesc, FwSmDesc_t* smDesc) {
+	int i;
+
+	memset(&smData, 0, sizeof(smData));
+	for (i=0; i<BENCH_SM_DEPTH; i++) {
+		if ((smBaseDesc[i] = FwSmMakeTestSMLarge(2, &smData)) == NULL)
+			return 0;
+		if ((smDesc[i] = FwSmCreateDer(smBaseDesc[i])) == NULL)
+			return 0;
+		FwSmSetData(smDesc[i], &smData);
+		if (i > 0)
+			FwSmEmbed(smDesc[i-1], STATE_S1, smDesc[i]);
+	}
+	return 1;
+}
+
+/*------------------------------------------------------------------------------------*/
+static void ReleaseDeepChain(FwSmDesc_t* smBaseDesc, FwSmDesc_t* smDesc) {
+	int i;
+
+	fwSm_logIndex = 0;
+	FwSmStop(smDesc[0]);
+	for (i=0; i<BENCH_SM_DEPTH; i++) {
+		FwSmReleaseDer(smDesc[i]);
+		FwSmRelease(smBaseDesc[i]);
+	}
+}
+
+/*------------------------------------------------------------------------------------*/
+static int RunGroup(struct FwBenchResult* result, long nOfOps, int isGroup) {
+	FwSmDesc_t smBaseDesc;
+	FwSmDesc_t smDesc[BENCH_SM_GROUP_N];
+	FwSmGroupDesc_t group;
+	FwSmCounterS1_t i;
+	long j, k, nOfRounds;
+	int isOk = 1;
+
+	memset(&smData, 0, sizeof(smData));
+	if ((smBaseDesc = FwSmCreate(4, 0, 5, 1, 0)) == NULL)
+		return 0;
+	FwSmSetData(smBaseDesc, &smData);
+	for (i=1; i<=4; i++)
+		FwSmAddState(smBaseDesc, i, 1, NULL, NULL, &GroupDoAction, NULL);
+	FwSmAddTransIpsToSta(smBaseDesc, 1, NULL);
+	for (i=1; i<=4; i++)
+		FwSmAddTransStaToSta(smBaseDesc, TR1, i, (FwSmCounterS1_t)((i % 4) + 1), NULL, NULL);
+	if ((FwSmCheck(smBaseDesc) != smSuccess) || ((group = FwSmGroupCreate(smBaseDesc, BENCH_SM_GROUP_N)) == NULL)) {
+		FwSmRelease(smBaseDesc);
+		return 0;
+	}
+
+	/* The state machines are spread over the four states */
+	for (j=0; j<BENCH_SM_GROUP_N; j++) {
+		if ((smDesc[j] = FwSmCreateDer(smBaseDesc)) == NULL)
+			return 0;
+		FwSmSetData(smDesc[j], &smData);
+		(void)FwSmGroupAdd(group, smDesc[j]);
+		FwSmStart(smDesc[j]);
+		for (k=0; k<(j % 4); k++)
+			FwSmMakeTrans(smDesc[j], TR1);
+	}
+
+	nOfRounds = nOfOps / BENCH_SM_GROUP_N;
+	FwBenchBegin(result);
+	for (j=0; j<nOfRounds; j++) {
+		if (isGroup == 1)
+			FwSmGroupExecute(group);
+		else
+			for (k=0; k<BENCH_SM_GROUP_N; k++)
+				FwSmExecute(smDesc[k]);
+	}
+	FwBenchEnd(result, nOfRounds * BENCH_SM_GROUP_N);
+
+	if (smData.counter_2 != (int)(nOfRounds * BENCH_SM_GROUP_N))
+		isOk = 0;
+	FwSmGroupRelease(group);
+	for (j=0; j<BENCH_SM_GROUP_N; j++)
+		FwSmReleaseDer(smDesc[j]);
+	FwSmRelease(smBaseDesc);
+	return isOk;
+}
+
+/*------------------------------------------------------------------------------------*/
+static void GroupDoAction(FwSmDesc_t smDesc) {
+	((struct TestSmData*)FwSmGetData(smDesc))->counter_2++;
+}
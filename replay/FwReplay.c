@@ -0,0 +1,664 @@
+/**
+ * @file
+ * @ingroup rpGroup
+ * Replay driver of the record/replay harness for the FW Profile.
+ * This program replays a command stream file (see <code>FwReplay.h</code>) against
+ * the test state machines and procedures of <code>FwSmMakeTest.h</code> and
+ * <code>FwPrMakeTest.h</code> and reports the throughput and the latency percentiles
+ * of each kind of command.
+ * The program is invoked as follows:
+ * - <code>replay [--format=text|csv|json] [--repeat=N] FILE</code>: replay the command
+ *   stream in FILE.
+ *   The stream is replayed N times at full speed to measure the throughput and then once
+ *   more, with each command timed individually, to measure the latency percentiles.
+ *   The CSV and JSON formats are intended to be stored and compared across releases.
+ * - <code>replay --record=FILE [--ops=N]</code>: record in FILE a synthetic stream of N
+ *   commands sent to a mix of test state machines and procedures (two of the state
+ *   machines are executed as a state machine group, see <code>FwSmGroup.h</code>).
+ *   This mode requires the tracing hooks to be compiled in (<code>TRACE=1</code>) and
+ *   doubles as an example of how an application records its own command stream.
+ * .
+ * The state machines and procedures are rebuilt from the test factories whose names
+ * are stored in the header of the command stream file.
+ * A state machine or procedure which is not started when it receives a command (either
+ * because it has not been started yet or because it has reached a final state) is
+ * started without timing the start.
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the FW Profile.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#define _POSIX_C_SOURCE 200112L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "FwReplay.h"
+#include "FwSmCore.h"
+#include "FwSmConfig.h"
+#include "FwSmDCreate.h"
+#include "FwSmGroup.h"
+#include "FwPrCore.h"
+#include "FwPrDCreate.h"
+#include "FwSmMakeTest.h"
+#include "FwPrMakeTest.h"
+
+/** The number of test factories known to the replay driver. */
+#define N_OF_REPLAY_FACTORIES 28
+
+/** The number of kinds of commands. */
+#define N_OF_REPLAY_CMDS 3
+
+/** The default number of commands of a synthetic command stream. */
+#define REPLAY_DEF_OPS 100000
+
+/** The size of the trace ring buffer used to record a synthetic command stream. */
+#define REPLAY_RING_SIZE 1024
+
+/** The log index of the test state machines (see <code>FwSmMakeTest.c</code>). */
+extern int fwSm_logIndex;
+
+/** The log index of the test procedures (see <code>FwPrMakeTest.c</code>). */
+extern int fwPrLogIndex;
+
+/** Enumerated type for the format of the replay report. */
+typedef enum {
+	/** Human-readable table */
+	replayText = 0,
+	/** Comma-separated values with one header line */
+	replayCsv = 1,
+	/** JSON object with the throughput and one latency object per kind of command */
+	replayJson = 2
+} FwReplayFormat_t;
+
+/** Structure describing a test factory. */
+struct FwReplayFactory {
+	/** The name of the test factory. */
+	const char* name;
+	/** The factory of a state machine without embedded state machine data (or NULL). */
+	FwSmDesc_t (*makeSm)(struct TestSmData*);
+	/** The factory of a state machine with embedded state machine data (or NULL). */
+	FwSmDesc_t (*makeEsm)(struct TestSmData*, struct TestSmData*);
+	/** The factory of a procedure (or NULL). */
+	FwPrDesc_t (*makePr)(struct TestPrData*);
+};
+
+/** Structure representing a state machine or procedure rebuilt by the replay driver. */
+struct FwReplayDesc {
+	/** The state machine (or NULL if this is a procedure). */
+	FwSmDesc_t smDesc;
+	/** The procedure (or NULL if this is a state machine). */
+	FwPrDesc_t prDesc;
+	/** The data of the state machine. */
+	struct TestSmData smData;
+	/** The data of the embedded state machine. */
+	struct TestSmData esmData;
+	/** The data of the procedure. */
+	struct TestPrData prData;
+};
+
+/** Structure representing a command stream loaded in memory. */
+struct FwReplayStream {
+	/** The number of descriptors. */
+	int nOfDescs;
+	/** The kinds of the descriptors. */
+	unsigned char kinds[FW_REPLAY_MAX_DESCS];
+	/** The factory names of the descriptors. */
+	char names[FW_REPLAY_MAX_DESCS][FW_REPLAY_MAX_NAME+1];
+	/** The number of commands. */
+	long nOfCmds;
+	/** The kinds of the commands (as offsets from <code>::traceSmMakeTransCmd</code>). */
+	unsigned char* cmds;
+	/** The descriptor indices of the commands. */
+	unsigned short* descIdx;
+	/** The transition commands of the commands. */
+	unsigned short* trigs;
+	/** The time span of the recording in the unit of the trace clock. */
+	double span;
+};
+
+/** The names of the kinds of commands (in the order of their command events). */
+static const char* cmdNames[N_OF_REPLAY_CMDS] = {"sm_make_trans", "sm_execute", "pr_execute"};
+
+/** The test factories known to the replay driver. */
+static const struct FwReplayFactory factories[N_OF_REPLAY_FACTORIES] = {
+	{"SM1", &FwSmMakeTestSM1, NULL, NULL},
+	{"SM2", &FwSmMakeTestSM2, NULL, NULL},
+	{"SM3", NULL, &FwSmMakeTestSM3, NULL},
+	{"SM4", &FwSmMakeTestSM4, NULL, NULL},
+	{"SM5", &FwSmMakeTestSM5, NULL, NULL},
+	{"SM5Dir", &FwSmMakeTestSM5Dir, NULL, NULL},
+	{"SM6", NULL, &FwSmMakeTestSM6, NULL},
+	{"SM7", &FwSmMakeTestSM7, NULL, NULL},
+	{"SM8", &FwSmMakeTestSM8, NULL, NULL},
+	{"SM9", &FwSmMakeTestSM9, NULL, NULL},
+	{"SM10", NULL, &FwSmMakeTestSM10, NULL},
+	{"SM11", &FwSmMakeTestSM11, NULL, NULL},
+	{"SM12", &FwSmMakeTestSM12, NULL, NULL},
+	{"SM13", &FwSmMakeTestSM13, NULL, NULL},
+	{"SM14", &FwSmMakeTestSM14, NULL, NULL},
+	{"SM15", &FwSmMakeTestSM15, NULL, NULL},
+	{"SM16_1", &FwSmMakeTestSM16_1, NULL, NULL},
+	{"SM16_2", &FwSmMakeTestSM16_2, NULL, NULL},
+	{"SM16_3", &FwSmMakeTestSM16_3, NULL, NULL},
+	{"PR1", NULL, NULL, &FwPrMakeTestPR1},
+	{"PR2", NULL, NULL, &FwPrMakeTestPR2},
+	{"PR2Dir", NULL, NULL, &FwPrMakeTestPR2Dir},
+	{"PR3", NULL, NULL, &FwPrMakeTestPR3},
+	{"PR4", NULL, NULL, &FwPrMakeTestPR4},
+	{"PR5", NULL, NULL, &FwPrMakeTestPR5},
+	{"PR6_1", NULL, NULL, &FwPrMakeTestPR6_1},
+	{"PR6_2", NULL, NULL, &FwPrMakeTestPR6_2},
+	{"PR6_3", NULL, NULL, &FwPrMakeTestPR6_3}
+};
+
+/**
+ * Load a command stream file in memory.
+ * @param path the path of the command stream file
+ * @param stream the loaded command stream
+ * @return 1 if the file was loaded, 0 otherwise
+ */
+static int LoadStream(const char* path, struct FwReplayStream* stream);
+
+/**
+ * Rebuild the state machines and procedures of a command stream from their test factories.
+ * @param stream the command stream
+ * @return the rebuilt state machines and procedures (or NULL if one of them could not be rebuilt)
+ */
+static struct FwReplayDesc* MakeDescs(const struct FwReplayStream* stream);
+
+/**
+ * Release the state machines and procedures rebuilt by <code>::MakeDescs</code>.
+ * @param descs the state machines and procedures
+ * @param nOfDescs the number of state machines and procedures
+ */
+static void ReleaseDescs(struct FwReplayDesc* descs, int nOfDescs);
+
+/**
+ * Send one command of a command stream to its state machine or procedure.
+ * The state machine or procedure is started first if it is not started.
+ * If the latency argument is not NULL, the command is timed individually.
+ * @param stream the command stream
+ * @param descs the state machines and procedures
+ * @param i the index of the command
+ * @param latency where the latency of the command in nanoseconds is stored (or NULL)
+ */
+static void SendCmd(const struct FwReplayStream* stream, struct FwReplayDesc* descs, long i, double* latency);
+
+/**
+ * Compare two latencies (comparison function for <code>qsort</code>).
+ * @param a the first latency
+ * @param b the second latency
+ * @return a negative, zero or positive value as the first latency is smaller, equal or larger
+ */
+static int CompareLatency(const void* a, const void* b);
+
+/**
+ * Print one line of the latency report.
+ * @param format the format of the report
+ * @param name the name of the kind of command
+ * @param lat the sorted latencies of the commands of that kind
+ * @param n the number of latencies
+ * @param isFirst 1 if this is the first line of the report
+ */
+static void PrintLatency(FwReplayFormat_t format, const char* name, double* lat, long n, int isFirst);
+
+/**
+ * Record a synthetic command stream.
+ * @param path the path of the command stream file
+ * @param nOfOps the number of commands
+ * @return 1 if the command stream was recorded, 0 otherwise
+ */
+static int RecordStream(const char* path, long nOfOps);
+
+/**
+ * Return the current time in nanoseconds.
+ * @return the current time in nanoseconds
+ */
+static double GetTimeNs(void);
+
+#ifdef FW_TRACE
+/**
+ * Clock of the trace events of a synthetic command stream.
+ * @return the current time in nanoseconds
+ */
+static FwTraceTime_t GetTraceTime(void);
+#endif
+
+/*------------------------------------------------------------------------------------*/
+int main(int argc, char* argv[]) {
+	struct FwReplayStream stream;
+	struct FwReplayDesc* descs;
+	FwReplayFormat_t format = replayText;
+	const char* path = NULL;
+	const char* recordPath = NULL;
+	long repeat = 1;
+	long nOfOps = REPLAY_DEF_OPS;
+	double* lat;
+	double* kindLat;
+	double startNs, elapsedNs;
+	long i, r, n;
+	int k, isFirst;
+	int isUsage = 0;
+
+	/* Parse the command line options */
+	for (i=1; i<argc; i++) {
+		if (strcmp(argv[i], "--format=csv") == 0)
+			format = replayCsv;
+		else if (strcmp(argv[i], "--format=json") == 0)
+			format = replayJson;
+		else if (strcmp(argv[i], "--format=text") == 0)
+			format = replayText;
+		else if ((strncmp(argv[i], "--repeat=", 9) == 0) && (atol(argv[i]+9) > 0))
+			repeat = atol(argv[i]+9);
+		else if ((strncmp(argv[i], "--ops=", 6) == 0) && (atol(argv[i]+6) > 0))
+			nOfOps = atol(argv[i]+6);
+		else if (strncmp(argv[i], "--record=", 9) == 0)
+			recordPath = argv[i]+9;
+		else if ((argv[i][0] != '-') && (path == NULL))
+			path = argv[i];
+		else
+			isUsage = 1;
+	}
+	if (isUsage || ((path == NULL) == (recordPath == NULL))) {
+		fprintf(stderr, "Usage: %s [--format=text|csv|json] [--repeat=N] FILE\n", argv[0]);
+		fprintf(stderr, "       %s --record=FILE [--ops=N]\n", argv[0]);
+		return EXIT_FAILURE;
+	}
+
+	if (recordPath != NULL)
+		return (RecordStream(recordPath, nOfOps) ? EXIT_SUCCESS : EXIT_FAILURE);
+
+	if (LoadStream(path, &stream) == 0)
+		return EXIT_FAILURE;
+	lat = (double*)malloc((size_t)(2*stream.nOfCmds+1)*sizeof(double));
+	if (lat == NULL) {
+		fprintf(stderr, "Not enough memory to replay %s\n", path);
+		return EXIT_FAILURE;
+	}
+	kindLat = lat + stream.nOfCmds;
+
+	/* First pass: throughput */
+	descs = MakeDescs(&stream);
+	if (descs == NULL)
+		return EXIT_FAILURE;
+	startNs = GetTimeNs();
+	for (r=0; r<repeat; r++)
+		for (i=0; i<stream.nOfCmds; i++)
+			SendCmd(&stream, descs, i, NULL);
+	elapsedNs = GetTimeNs() - startNs;
+	ReleaseDescs(descs, stream.nOfDescs);
+
+	/* Second pass: latency of each command on fresh state machines and procedures */
+	descs = MakeDescs(&stream);
+	if (descs == NULL)
+		return EXIT_FAILURE;
+	for (i=0; i<stream.nOfCmds; i++)
+		SendCmd(&stream, descs, i, &lat[i]);
+	ReleaseDescs(descs, stream.nOfDescs);
+
+	/* Report */
+	n = stream.nOfCmds*repeat;
+	switch (format) {
+	case replayCsv:
+		printf("# commands=%ld,repeat=%ld,elapsed_ns=%.0f,cmds_per_s=%.0f,span=%.0f\n",
+		       stream.nOfCmds, repeat, elapsedNs, (elapsedNs > 0) ? (double)n*1.0e9/elapsedNs : 0.0, stream.span);
+		break;
+	case replayJson:
+		printf("{\"commands\": %ld, \"repeat\": %ld, \"elapsed_ns\": %.0f, \"cmds_per_s\": %.0f, \"span\": %.0f,\n",
+		       stream.nOfCmds, repeat, elapsedNs, (elapsedNs > 0) ? (double)n*1.0e9/elapsedNs : 0.0, stream.span);
+		printf(" \"latency\": ");
+		break;
+	default:
+		printf("Replayed %ld commands %ld time(s) in %.3f ms: %.0f commands/s (recorded span: %.0f)\n",
+		       stream.nOfCmds, repeat, elapsedNs/1.0e6, (elapsedNs > 0) ? (double)n*1.0e9/elapsedNs : 0.0,
+		       stream.span);
+		break;
+	}
+	isFirst = 1;
+	for (k=0; k<N_OF_REPLAY_CMDS; k++) {
+		n = 0;
+		for (i=0; i<stream.nOfCmds; i++)
+			if (stream.cmds[i] == k)
+				kindLat[n++] = lat[i];
+		if (n == 0)
+			continue;
+		qsort(kindLat, (size_t)n, sizeof(double), &CompareLatency);
+		PrintLatency(format, cmdNames[k], kindLat, n, isFirst);
+		isFirst = 0;
+	}
+	qsort(lat, (size_t)stream.nOfCmds, sizeof(double), &CompareLatency);
+	PrintLatency(format, "all", lat, stream.nOfCmds, isFirst);
+	if (format == replayJson)
+		printf("\n ]}\n");
+
+	free(lat);
+	free(stream.cmds);
+	free(stream.descIdx);
+	free(stream.trigs);
+	return EXIT_SUCCESS;
+}
+
+/*------------------------------------------------------------------------------------*/
+static int LoadStream(const char* path, struct FwReplayStream* stream) {
+	unsigned char buf[FW_REPLAY_MAX_NAME+2];
+	FILE* file;
+	long size, i;
+	int d;
+
+	memset(stream, 0, sizeof(struct FwReplayStream));
+	file = fopen(path, "rb");
+	if (file == NULL) {
+		fprintf(stderr, "Command stream %s could not be opened\n", path);
+		return 0;
+	}
+
+	/* Header */
+	if ((fread(buf, 1, 7, file) != 7) || (memcmp(buf, "FWRP", 4) != 0) || (buf[4] != FW_REPLAY_VERSION)) {
+		fprintf(stderr, "%s is not a command stream of version %d\n", path, FW_REPLAY_VERSION);
+		fclose(file);
+		return 0;
+	}
+	stream->nOfDescs = buf[5] + 256*buf[6];
+	if (stream->nOfDescs > FW_REPLAY_MAX_DESCS) {
+		fprintf(stderr, "%s has too many descriptors\n", path);
+		fclose(file);
+		return 0;
+	}
+	for (d=0; d<stream->nOfDescs; d++) {
+		if ((fread(buf, 1, 2, file) != 2) || (buf[1] > FW_REPLAY_MAX_NAME) ||
+		        (fread(stream->names[d], 1, buf[1], file) != buf[1])) {
+			fprintf(stderr, "%s has a corrupted header\n", path);
+			fclose(file);
+			return 0;
+		}
+		stream->kinds[d] = buf[0];
+		stream->names[d][buf[1]] = '\0';
+	}
+
+	/* Records */
+	size = ftell(file);
+	fseek(file, 0, SEEK_END);
+	size = (ftell(file) - size) / FW_REPLAY_REC_SIZE;
+	fseek(file, -size*FW_REPLAY_REC_SIZE, SEEK_END);
+	stream->cmds = (unsigned char*)malloc((size_t)size+1);
+	stream->descIdx = (unsigned short*)malloc(((size_t)size+1)*sizeof(unsigned short));
+	stream->trigs = (unsigned short*)malloc(((size_t)size+1)*sizeof(unsigned short));
+	if ((stream->cmds == NULL) || (stream->descIdx == NULL) || (stream->trigs == NULL)) {
+		fprintf(stderr, "Not enough memory to load %s\n", path);
+		fclose(file);
+		return 0;
+	}
+	for (i=0; i<size; i++) {
+		if (fread(buf, 1, FW_REPLAY_REC_SIZE, file) != FW_REPLAY_REC_SIZE)
+			break;
+		d = buf[2] + 256*buf[3];
+		if ((buf[0] < traceSmMakeTransCmd) || (buf[0] >= traceSmMakeTransCmd+N_OF_REPLAY_CMDS) ||
+		        (d >= stream->nOfDescs) ||
+		        ((stream->kinds[d] == FW_REPLAY_SM) != (buf[0] != tracePrExecuteCmd))) {
+			fprintf(stderr, "%s has a corrupted record at index %ld\n", path, i);
+			fclose(file);
+			return 0;
+		}
+		stream->cmds[i] = (unsigned char)(buf[0] - traceSmMakeTransCmd);
+		stream->descIdx[i] = (unsigned short)d;
+		stream->trigs[i] = (unsigned short)(buf[4] + 256*buf[5]);
+		stream->span += (double)buf[6] + 256.0*buf[7] + 65536.0*buf[8] + 16777216.0*buf[9];
+	}
+	stream->nOfCmds = i;
+	fclose(file);
+	return 1;
+}
+
+/*------------------------------------------------------------------------------------*/
+static struct FwReplayDesc* MakeDescs(const struct FwReplayStream* stream) {
+	struct FwReplayDesc* descs;
+	int d, f;
+
+	descs = (struct FwReplayDesc*)calloc((size_t)stream->nOfDescs+1, sizeof(struct FwReplayDesc));
+	if (descs == NULL) {
+		fprintf(stderr, "Not enough memory to rebuild the state machines and procedures\n");
+		return NULL;
+	}
+	for (d=0; d<stream->nOfDescs; d++) {
+		for (f=0; f<N_OF_REPLAY_FACTORIES; f++)
+			if (strcmp(factories[f].name, stream->names[d]) == 0)
+				break;
+		if ((f == N_OF_REPLAY_FACTORIES) || ((stream->kinds[d] == FW_REPLAY_PR) != (factories[f].makePr != NULL))) {
+			fprintf(stderr, "No test factory %s for descriptor %d\n", stream->names[d], d);
+			ReleaseDescs(descs, d);
+			return NULL;
+		}
+		descs[d].smData.flag_1 = 1;
+		descs[d].esmData.flag_1 = 1;
+		descs[d].prData.flag_1 = 1;
+		if (factories[f].makeSm != NULL)
+			descs[d].smDesc = factories[f].makeSm(&descs[d].smData);
+		else if (factories[f].makeEsm != NULL)
+			descs[d].smDesc = factories[f].makeEsm(&descs[d].smData, &descs[d].esmData);
+		else
+			descs[d].prDesc = factories[f].makePr(&descs[d].prData);
+		if ((descs[d].smDesc == NULL) && (descs[d].prDesc == NULL)) {
+			fprintf(stderr, "Test factory %s failed for descriptor %d\n", stream->names[d], d);
+			ReleaseDescs(descs, d);
+			return NULL;
+		}
+	}
+	return descs;
+}
+
+/*------------------------------------------------------------------------------------*/
+static void ReleaseDescs(struct FwReplayDesc* descs, int nOfDescs) {
+	int d;
+
+	for (d=0; d<nOfDescs; d++)
+		if (descs[d].smDesc != NULL)
+			FwSmReleaseRec(descs[d].smDesc);
+		else
+			FwPrRelease(descs[d].prDesc);
+	free(descs);
+}
+
+/*------------------------------------------------------------------------------------*/
+static void SendCmd(const struct FwReplayStream* stream, struct FwReplayDesc* descs, long i, double* latency) {
+	struct FwReplayDesc* desc = &descs[stream->descIdx[i]];
+	double startNs = 0;
+
+	/* The test state machines and procedures log their actions in arrays of bounded size */
+	fwSm_logIndex = 0;
+	fwPrLogIndex = 0;
+
+	if (desc->smDesc != NULL) {
+		if (FwSmIsStarted(desc->smDesc) == 0)
+			FwSmStart(desc->smDesc);
+		if (latency != NULL)
+			startNs = GetTimeNs();
+		if (stream->cmds[i] == 0)
+			FwSmMakeTrans(desc->smDesc, (FwSmCounterU2_t)stream->trigs[i]);
+		else
+			FwSmExecute(desc->smDesc);
+	} else {
+		if (FwPrIsStarted(desc->prDesc) == 0)
+			FwPrStart(desc->prDesc);
+		if (latency != NULL)
+			startNs = GetTimeNs();
+		FwPrExecute(desc->prDesc);
+	}
+	if (latency != NULL)
+		*latency = GetTimeNs() - startNs;
+}
+
+/*------------------------------------------------------------------------------------*/
+static int CompareLatency(const void* a, const void* b) {
+	double da = *(const double*)a;
+	double db = *(const double*)b;
+	return (da > db) - (da < db);
+}
+
+/*------------------------------------------------------------------------------------*/
+static void PrintLatency(FwReplayFormat_t format, const char* name, double* lat, long n, int isFirst) {
+	double p50 = lat[(n-1)/2];
+	double p90 = lat[(long)((double)(n-1)*0.9)];
+	double p99 = lat[(long)((double)(n-1)*0.99)];
+	double p999 = lat[(long)((double)(n-1)*0.999)];
+	double max = lat[n-1];
+
+	switch (format) {
+	case replayCsv:
+		if (isFirst)
+			printf("command,ops,p50_ns,p90_ns,p99_ns,p999_ns,max_ns\n");
+		printf("%s,%ld,%.0f,%.0f,%.0f,%.0f,%.0f\n", name, n, p50, p90, p99, p999, max);
+		break;
+	case replayJson:
+		printf(isFirst ? "[\n" : ",\n");
+		printf("  {\"command\": \"%s\", \"ops\": %ld, \"p50_ns\": %.0f, \"p90_ns\": %.0f, \"p99_ns\": %.0f, "
+		       "\"p999_ns\": %.0f, \"max_ns\": %.0f}", name, n, p50, p90, p99, p999, max);
+		break;
+	default:
+		if (isFirst)
+			printf("%-16s %10s %10s %10s %10s %10s %10s\n", "Command", "Ops", "p50 ns", "p90 ns", "p99 ns",
+			       "p99.9 ns", "max ns");
+		printf("%-16s %10ld %10.0f %10.0f %10.0f %10.0f %10.0f\n", name, n, p50, p90, p99, p999, max);
+		break;
+	}
+}
+
+/*------------------------------------------------------------------------------------*/
+static int RecordStream(const char* path, long nOfOps) {
+#ifdef FW_TRACE
+	static FwTraceEvent_t ringEvents[REPLAY_RING_SIZE];
+	static FwTraceEvent_t drained[REPLAY_RING_SIZE];
+	static struct FwReplayRec rec;
+	const char* names[6] = {"SM1", "SM5", "SM5", "SM14", "PR1", "PR2"};
+	FwSmCounterU2_t trigs[7] = {TR1, TR2, TR3, TR4, TR5, TR6, TR_S1_FPS};
+	struct TestSmData smData[4];
+	struct TestPrData prData[2];
+	FwSmDesc_t smDesc[4];
+	FwPrDesc_t prDesc[2];
+	FwSmGroupDesc_t group;
+	struct FwTraceRing ring;
+	unsigned long seed = 12345;
+	FwTraceCounterU4_t n;
+	long i, nOfRecords = 0;
+	int d, isOk = 1;
+
+	memset(smData, 0, sizeof(smData));
+	memset(prData, 0, sizeof(prData));
+	for (d=0; d<4; d++)
+		smData[d].flag_1 = 1;
+	smDesc[0] = FwSmMakeTestSM1(&smData[0]);
+	smDesc[1] = FwSmMakeTestSM5(&smData[1]);
+	smDesc[2] = FwSmCreateDer(smDesc[1]);
+	FwSmSetData(smDesc[2], &smData[2]);
+	smDesc[3] = FwSmMakeTestSM14(&smData[3]);
+
+	/* The two instances of SM5 are executed as a group: the group records one command per instance */
+	group = FwSmGroupCreate(smDesc[1], 2);
+	if (group == NULL) {
+		fprintf(stderr, "Command stream %s could not be created\n", path);
+		return 0;
+	}
+	FwSmGroupAdd(group, smDesc[1]);
+	FwSmGroupAdd(group, smDesc[2]);
+	for (d=0; d<2; d++) {
+		prData[d].flag_1 = 1;
+		prDesc[d] = (d == 0) ? FwPrMakeTestPR1(&prData[d]) : FwPrMakeTestPR2(&prData[d]);
+	}
+
+	if (FwReplayRecOpen(&rec, path) == 0) {
+		fprintf(stderr, "Command stream %s could not be created\n", path);
+		return 0;
+	}
+	for (d=0; d<4; d++)
+		FwReplayRecAddSm(&rec, smDesc[d], names[d]);
+	for (d=0; d<2; d++)
+		FwReplayRecAddPr(&rec, prDesc[d], names[4+d]);
+
+	FwTraceRingInit(&ring, ringEvents, REPLAY_RING_SIZE);
+	FwTraceSetMask(&ring, FW_TRACE_MASK_CMDS);
+	FwTraceSetClock(&GetTraceTime);
+	FwTraceSetRing(&ring);
+
+	for (i=0; (i<nOfOps) && isOk; i++) {
+		fwSm_logIndex = 0;
+		fwPrLogIndex = 0;
+		seed = (seed*1103515245UL + 12345UL) & 0x7FFFFFFFUL;
+		d = (int)((seed >> 16) % 6);
+		if ((d == 1) || (d == 2)) {
+			if (FwSmIsStarted(smDesc[1]) == 0)
+				FwSmStart(smDesc[1]);
+			if (FwSmIsStarted(smDesc[2]) == 0)
+				FwSmStart(smDesc[2]);
+			if (((seed >> 8) & 3) == 0)
+				FwSmGroupExecute(group);
+			else
+				FwSmMakeTrans(smDesc[d], trigs[(seed >> 4) % 7]);
+		} else if (d < 4) {
+			if (FwSmIsStarted(smDesc[d]) == 0)
+				FwSmStart(smDesc[d]);
+			if (((seed >> 8) & 3) == 0)
+				FwSmExecute(smDesc[d]);
+			else
+				FwSmMakeTrans(smDesc[d], trigs[(seed >> 4) % 7]);
+		} else {
+			if (FwPrIsStarted(prDesc[d-4]) == 0)
+				FwPrStart(prDesc[d-4]);
+			FwPrExecute(prDesc[d-4]);
+		}
+		/* A command generates at most one event per group member and batches are not used: drain well before
+		 * overflow */
+		if (((i+1) % (REPLAY_RING_SIZE/4) == 0) || (i+1 == nOfOps)) {
+			n = FwTraceDrain(&ring, drained, REPLAY_RING_SIZE);
+			if (FwReplayRecWrite(&rec, drained, n) < 0)
+				isOk = 0;
+		}
+	}
+	FwTraceSetRing(NULL);
+	FwTraceSetClock(NULL);
+	nOfRecords = rec.nOfRecords;
+	if (FwReplayRecClose(&rec) == 0)
+		isOk = 0;
+
+	FwSmGroupRelease(group);
+	FwSmReleaseDer(smDesc[2]);
+	FwSmRelease(smDesc[0]);
+	FwSmRelease(smDesc[1]);
+	FwSmRelease(smDesc[3]);
+	for (d=0; d<2; d++)
+		FwPrRelease(prDesc[d]);
+
+	if ((isOk == 0) || (FwTraceGetNOfDropped(&ring) != 0)) {
+		fprintf(stderr, "Command stream %s could not be recorded\n", path);
+		return 0;
+	}
+	printf("Recorded %ld commands in %s\n", nOfRecords, path);
+	return 1;
+#else
+	(void)nOfOps;
+	fprintf(stderr, "Recording %s requires the tracing hooks (build with TRACE=1)\n", path);
+	return 0;
+#endif
+}
+
+/*------------------------------------------------------------------------------------*/
+static double GetTimeNs(void) {
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (double)now.tv_sec*1.0e9 + (double)now.tv_nsec;
+}
+
+#ifdef FW_TRACE
+/*------------------------------------------------------------------------------------*/
+static FwTraceTime_t GetTraceTime(void) {
+	return (FwTraceTime_t)GetTimeNs();
+}
+#endif
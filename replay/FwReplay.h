@@ -0,0 +1,160 @@
+/**
+ * @file
+ * @ingroup rpGroup
+ * Declaration of the record/replay harness for the FW Profile.
+ * The record/replay harness captures the stream of commands received by the state
+ * machines and procedures of an application (the calls to <code>::FwSmMakeTrans</code>,
+ * <code>::FwSmExecute</code> and <code>::FwPrExecute</code>) and replays it offline
+ * against the test state machines and procedures of <code>FwSmMakeTest.h</code> and
+ * <code>FwPrMakeTest.h</code> in order to compare the timing of successive releases of
+ * the FW Profile under a realistic load.
+ *
+ * The commands are captured through the command events of the tracing interface
+ * (see <code>FwTrace.h</code>).
+ * An application records a command stream as follows:
+ * -# The FW Profile is built with the tracing hooks compiled in (<code>TRACE=1</code>).
+ * -# A ring buffer whose mask selects the command events (<code>#FW_TRACE_MASK_CMDS</code>)
+ *    is attached to the thread which executes the state machines and procedures.
+ * -# A recorder is opened with <code>::FwReplayRecOpen</code> and the state machines and
+ *    procedures to be recorded are registered with <code>::FwReplayRecAddSm</code> and
+ *    <code>::FwReplayRecAddPr</code> under the name of the test factory which builds
+ *    their replay counterparts (e.g. "SM5" for <code>::FwSmMakeTestSM5</code>).
+ * -# The ring buffer is periodically drained and the drained events are passed to
+ *    <code>::FwReplayRecWrite</code>.
+ * -# The recorder is closed with <code>::FwReplayRecClose</code>.
+ * .
+ * The replay driver (<code>bin/replay</code>, see the <code>replay</code> target of
+ * the Makefile) rebuilds the recorded state machines and procedures from their test
+ * factories, replays the command stream at full speed and reports the throughput and
+ * the latency percentiles of each kind of command.
+ *
+ * A command stream file consists of a header followed by one record for each command.
+ * All multi-byte fields are stored in little-endian order.
+ * The header holds:
+ * - the four characters "FWRP" and the version of the format (one byte);
+ * - the number of recorded descriptors (two bytes);
+ * - for each descriptor: its kind (one byte: #FW_REPLAY_SM or #FW_REPLAY_PR), the
+ *   length of its factory name (one byte) and the characters of the name.
+ * .
+ * Each record is #FW_REPLAY_REC_SIZE bytes long and holds:
+ * - the kind of the command (one byte: the <code>::FwTraceEventType_t</code> of its
+ *   command event);
+ * - one reserved byte;
+ * - the index of the descriptor in the header (two bytes);
+ * - the transition command (two bytes, zero for the execution commands);
+ * - the time elapsed since the previous command (four bytes, in the unit of the trace
+ *   clock, saturated at 2^32-1).
+ * .
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the FW Profile.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#ifndef FWREPLAY_H_
+#define FWREPLAY_H_
+
+#include <stdio.h>
+#include "FwSmConstants.h"
+#include "FwPrConstants.h"
+#include "FwTrace.h"
+
+/** The version of the command stream format. */
+#define FW_REPLAY_VERSION 1
+
+/** The size in bytes of a record of a command stream file. */
+#define FW_REPLAY_REC_SIZE 10
+
+/** The maximum number of descriptors in a command stream. */
+#define FW_REPLAY_MAX_DESCS 256
+
+/** The maximum length of the factory name of a descriptor. */
+#define FW_REPLAY_MAX_NAME 31
+
+/** Kind of a recorded descriptor which is a state machine. */
+#define FW_REPLAY_SM 1
+
+/** Kind of a recorded descriptor which is a procedure. */
+#define FW_REPLAY_PR 2
+
+/** Structure representing a recorder which writes a command stream file. */
+struct FwReplayRec {
+	/** The command stream file. */
+	FILE* file;
+	/** The registered descriptors. */
+	const void* descs[FW_REPLAY_MAX_DESCS];
+	/** The kinds of the registered descriptors. */
+	unsigned char kinds[FW_REPLAY_MAX_DESCS];
+	/** The factory names of the registered descriptors. */
+	char names[FW_REPLAY_MAX_DESCS][FW_REPLAY_MAX_NAME+1];
+	/** The number of registered descriptors. */
+	int nOfDescs;
+	/** Flag indicating whether the header has been written. */
+	int isHeaderWritten;
+	/** The time stamp of the last recorded command. */
+	FwTraceTime_t lastTime;
+	/** The number of recorded commands. */
+	long nOfRecords;
+	/** The number of command events which were skipped because their descriptor was not registered. */
+	long nOfSkipped;
+};
+
+/**
+ * Open a recorder which writes a command stream file.
+ * @param rec the recorder
+ * @param path the path of the command stream file (an existing file is overwritten)
+ * @return 1 if the file was opened, 0 otherwise
+ */
+int FwReplayRecOpen(struct FwReplayRec* rec, const char* path);
+
+/**
+ * Register a state machine whose commands are recorded.
+ * The descriptors must be registered before the first call to <code>::FwReplayRecWrite</code>.
+ * @param rec the recorder
+ * @param smDesc the state machine
+ * @param name the name of the test factory which builds its replay counterpart
+ * @return 1 if the state machine was registered, 0 if too many descriptors are registered,
+ * if the name is too long or if the header has already been written
+ */
+int FwReplayRecAddSm(struct FwReplayRec* rec, FwSmDesc_t smDesc, const char* name);
+
+/**
+ * Register a procedure whose commands are recorded.
+ * The descriptors must be registered before the first call to <code>::FwReplayRecWrite</code>.
+ * @param rec the recorder
+ * @param prDesc the procedure
+ * @param name the name of the test factory which builds its replay counterpart
+ * @return 1 if the procedure was registered, 0 if too many descriptors are registered,
+ * if the name is too long or if the header has already been written
+ */
+int FwReplayRecAddPr(struct FwReplayRec* rec, FwPrDesc_t prDesc, const char* name);
+
+/**
+ * Write the command events among a set of trace events to the command stream file.
+ * The events are normally those drained from a ring buffer with <code>::FwTraceDrain</code>.
+ * The events which are not command events are ignored and the command events of
+ * descriptors which have not been registered are skipped.
+ * The header of the file is written by the first call to this function.
+ * @param rec the recorder
+ * @param events the trace events
+ * @param nOfEvents the number of trace events
+ * @return the number of commands which were written (or -1 if the file could not be written)
+ */
+long FwReplayRecWrite(struct FwReplayRec* rec, const FwTraceEvent_t* events, FwTraceCounterU4_t nOfEvents);
+
+/**
+ * Close a recorder.
+ * The header of the file is written if no command has been written.
+ * @param rec the recorder
+ * @return 1 if the file was written and closed successfully, 0 otherwise
+ */
+int FwReplayRecClose(struct FwReplayRec* rec);
+
+#endif /* FWREPLAY_H_ */
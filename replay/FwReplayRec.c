@@ -0,0 +1,162 @@
+/**
+ * @file
+ * @ingroup rpGroup
+ * Implements the recorder of the record/replay harness.
+ * An application which records its command stream compiles this file together with
+ * the FW Profile sources (see <code>FwReplay.h</code>).
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the FW Profile.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "FwReplay.h"
+
+/**
+ * Register a descriptor whose commands are recorded.
+ * @param rec the recorder
+ * @param desc the descriptor
+ * @param kind the kind of the descriptor
+ * @param name the name of the test factory which builds its replay counterpart
+ * @return 1 if the descriptor was registered, 0 otherwise
+ */
+static int RecAdd(struct FwReplayRec* rec, const void* desc, unsigned char kind, const char* name);
+
+/**
+ * Write the header of the command stream file.
+ * @param rec the recorder
+ * @return 1 if the header was written, 0 otherwise
+ */
+static int RecWriteHeader(struct FwReplayRec* rec);
+
+/**
+ * Store an unsigned value in little-endian order.
+ * @param buf the buffer where the value is stored
+ * @param value the value
+ * @param nOfBytes the number of bytes of the value
+ */
+static void RecPut(unsigned char* buf, unsigned long value, int nOfBytes);
+
+/*------------------------------------------------------------------------------------*/
+int FwReplayRecOpen(struct FwReplayRec* rec, const char* path) {
+	memset(rec, 0, sizeof(struct FwReplayRec));
+	rec->file = fopen(path, "wb");
+	return (rec->file != NULL);
+}
+
+/*------------------------------------------------------------------------------------*/
+int FwReplayRecAddSm(struct FwReplayRec* rec, FwSmDesc_t smDesc, const char* name) {
+	return RecAdd(rec, smDesc, FW_REPLAY_SM, name);
+}
+
+/*------------------------------------------------------------------------------------*/
+int FwReplayRecAddPr(struct FwReplayRec* rec, FwPrDesc_t prDesc, const char* name) {
+	return RecAdd(rec, prDesc, FW_REPLAY_PR, name);
+}
+
+/*------------------------------------------------------------------------------------*/
+long FwReplayRecWrite(struct FwReplayRec* rec, const FwTraceEvent_t* events, FwTraceCounterU4_t nOfEvents) {
+	unsigned char buf[FW_REPLAY_REC_SIZE];
+	FwTraceTime_t delta;
+	FwTraceCounterU4_t i;
+	long nOfWritten = 0;
+	int iDesc;
+
+	if ((rec->isHeaderWritten == 0) && (RecWriteHeader(rec) == 0))
+		return -1;
+
+	for (i=0; i<nOfEvents; i++) {
+		if ((events[i].type != traceSmMakeTransCmd) && (events[i].type != traceSmExecuteCmd) &&
+		        (events[i].type != tracePrExecuteCmd))
+			continue;
+
+		/* The descriptors are few and are looked up linearly */
+		for (iDesc=0; iDesc<rec->nOfDescs; iDesc++)
+			if (rec->descs[iDesc] == events[i].desc)
+				break;
+		if (iDesc == rec->nOfDescs) {
+			rec->nOfSkipped++;
+			continue;
+		}
+
+		delta = (rec->nOfRecords == 0) ? 0 : (events[i].time - rec->lastTime);
+		if (delta > 0xFFFFFFFFUL)
+			delta = 0xFFFFFFFFUL;
+		rec->lastTime = events[i].time;
+
+		buf[0] = (unsigned char)events[i].type;
+		buf[1] = 0;
+		RecPut(buf+2, (unsigned long)iDesc, 2);
+		RecPut(buf+4, (unsigned long)events[i].id, 2);
+		RecPut(buf+6, delta, 4);
+		if (fwrite(buf, 1, FW_REPLAY_REC_SIZE, rec->file) != FW_REPLAY_REC_SIZE)
+			return -1;
+		rec->nOfRecords++;
+		nOfWritten++;
+	}
+	return nOfWritten;
+}
+
+/*------------------------------------------------------------------------------------*/
+int FwReplayRecClose(struct FwReplayRec* rec) {
+	int isOk = 1;
+
+	if (rec->isHeaderWritten == 0)
+		isOk = RecWriteHeader(rec);
+	if (fclose(rec->file) != 0)
+		isOk = 0;
+	rec->file = NULL;
+	return isOk;
+}
+
+/*------------------------------------------------------------------------------------*/
+static int RecAdd(struct FwReplayRec* rec, const void* desc, unsigned char kind, const char* name) {
+	if ((rec->isHeaderWritten != 0) || (rec->nOfDescs == FW_REPLAY_MAX_DESCS) ||
+	        (strlen(name) > FW_REPLAY_MAX_NAME))
+		return 0;
+	rec->descs[rec->nOfDescs] = desc;
+	rec->kinds[rec->nOfDescs] = kind;
+	strcpy(rec->names[rec->nOfDescs], name);
+	rec->nOfDescs++;
+	return 1;
+}
+
+/*------------------------------------------------------------------------------------*/
+static int RecWriteHeader(struct FwReplayRec* rec) {
+	unsigned char buf[FW_REPLAY_MAX_NAME+2];
+	size_t len;
+	int i;
+
+	memcpy(buf, "FWRP", 4);
+	buf[4] = FW_REPLAY_VERSION;
+	RecPut(buf+5, (unsigned long)rec->nOfDescs, 2);
+	if (fwrite(buf, 1, 7, rec->file) != 7)
+		return 0;
+	for (i=0; i<rec->nOfDescs; i++) {
+		len = strlen(rec->names[i]);
+		buf[0] = rec->kinds[i];
+		buf[1] = (unsigned char)len;
+		memcpy(buf+2, rec->names[i], len);
+		if (fwrite(buf, 1, len+2, rec->file) != len+2)
+			return 0;
+	}
+	rec->isHeaderWritten = 1;
+	return 1;
+}
+
+/*------------------------------------------------------------------------------------*/
+static void RecPut(unsigned char* buf, unsigned long value, int nOfBytes) {
+	int i;
+
+	for (i=0; i<nOfBytes; i++)
+		buf[i] = (unsigned char)((value >> (8*i)) & 0xFF);
+}
@@ -0,0 +1,614 @@
+/**
+ * @file
+ * @ingroup rsGroup
+ * Scaling benchmark for the RT Container Module.
+ * This program measures how the RT Containers behave when many containers are
+ * notified by many threads.
+ * It sweeps the number of containers, the number of notifier threads and the
+ * notification rate and, for each point of the sweep and for each activation
+ * backend, it reports:
+ * - the notification throughput (notifications per second);
+ * - the percentiles of the notify-to-activation latency (the time from the call
+ *   to <code>::FwRtNotify</code> to the start of the execution of the functional
+ *   behaviour which consumes the notification);
+ * - the CPU use of the process (in percent of one processor) and its number of
+ *   context switches.
+ * .
+ * The activation backends are:
+ * - <code>thread</code>: each container has its own Activation Thread;
+ * - <code>lockfree</code>: as <code>thread</code> but with the lock-free
+ *   notification mode (see <code>::FwRtSetLockFreeNotif</code>);
+ * - <code>pool</code>: the containers are attached to a RT Pool (see
+ *   <code>FwRtPool.h</code>).
+ * .
+ * During a run, each notifier thread notifies the containers in round-robin
+ * order for a fixed duration.
+ * If the rate is zero the notifiers notify as fast as they can, otherwise the
+ * rate is the total number of notifications per second of all notifiers.
+ * A notifier skips a container whose backlog of pending notifications is
+ * #SCALE_MAX_BACKLOG (these skips are reported as throttled notifications).
+ * The run ends when all notifications have been consumed.
+ *
+ * The program accepts the following options:
+ * - <code>--format=text|csv|json</code>: the format of the report (default: text).
+ * - <code>--backends=LIST</code>: the backends (default: thread,lockfree,pool).
+ * - <code>--containers=LIST</code>: the numbers of containers (default: 1,10,100,1000).
+ * - <code>--notifiers=LIST</code>: the numbers of notifier threads (default: 1,4).
+ * - <code>--rates=LIST</code>: the notification rates (default: 0).
+ * - <code>--duration=MS</code>: the duration of the notification phase of each run
+ *   (default: 200).
+ * - <code>--workers=N</code>: the number of worker threads of the RT Pool (default: 4).
+ * .
+ * The lists are comma-separated (e.g. <code>--containers=1,10,100</code>).
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the FW Profile.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#define _POSIX_C_SOURCE 200112L
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <sys/resource.h>
+#include "FwRtConstants.h"
+#include "FwRtConfig.h"
+#include "FwRtCore.h"
+#include "FwRtPool.h"
+
+/** The maximum number of values in a list option. */
+#define SCALE_MAX_LIST 16
+
+/** The maximum number of containers. */
+#define SCALE_MAX_CONTAINERS 10000
+
+/** The maximum number of notifier threads and of worker threads of the RT Pool. */
+#define SCALE_MAX_THREADS 64
+
+/** The maximum number of pending notifications of a container. */
+#define SCALE_MAX_BACKLOG 256
+
+/** The number of time stamp slots of a container (larger than the backlog plus the notifiers). */
+#define SCALE_N_OF_SLOTS 512
+
+/** The maximum number of latency samples of a run. */
+#define SCALE_MAX_SAMPLES 2000000
+
+/** The stack size of the Activation Threads. */
+#define SCALE_STACK_SIZE 262144
+
+/** The time in ns after which a run is abandoned if its notifications are not consumed. */
+#define SCALE_DRAIN_TIMEOUT 5.0e9
+
+/** Enumerated type for the activation backend of the RT Containers. */
+typedef enum {
+	/** One Activation Thread per container */
+	scaleThread = 0,
+	/** One Activation Thread per container and lock-free notifications */
+	scaleLockFree = 1,
+	/** Containers attached to a RT Pool */
+	scalePool = 2
+} FwRtScaleBackend_t;
+
+/** Enumerated type for the format of the benchmark report. */
+typedef enum {
+	/** Human-readable table */
+	scaleText = 0,
+	/** Comma-separated values with one header line */
+	scaleCsv = 1,
+	/** JSON array with one object per run */
+	scaleJson = 2
+} FwRtScaleFormat_t;
+
+/** Structure holding the time stamp of a notification. */
+struct FwRtScaleSlot {
+	/** The time in ns at which the notification was sent. */
+	double notifNs;
+	/** The sequence number of the notification plus one (the slot is valid when this matches). */
+	volatile unsigned long seq;
+};
+
+/** Structure representing a container of the benchmark. */
+struct FwRtScaleCont {
+	/** The RT Container. */
+	struct FwRtDesc rtDesc;
+	/** The number of notifications sent to the container. */
+	volatile unsigned long nOfSent;
+	/** The number of notifications consumed by the container. */
+	volatile unsigned long nOfExec;
+	/** The time stamps of the pending notifications. */
+	struct FwRtScaleSlot slots[SCALE_N_OF_SLOTS];
+};
+
+/** Structure describing a notifier thread. */
+struct FwRtScaleNotifier {
+	/** The notifier thread. */
+	pthread_t thread;
+	/** The index of the notifier. */
+	int index;
+	/** The number of notifications sent by the notifier. */
+	long nOfNotifs;
+	/** The number of notifications skipped because the backlog of a container was full. */
+	long nOfThrottled;
+};
+
+/** Structure holding the parameters and the shared state of a run. */
+struct FwRtScaleRun {
+	/** The containers. */
+	struct FwRtScaleCont* conts;
+	/** The number of containers. */
+	int nOfConts;
+	/** The number of notifier threads. */
+	int nOfNotifiers;
+	/** The total notification rate (0 for the maximum rate). */
+	double rate;
+	/** The duration of the notification phase in ns. */
+	double durationNs;
+	/** The latency samples. */
+	double* samples;
+	/** The number of latency samples (it may exceed #SCALE_MAX_SAMPLES). */
+	volatile long nOfSamples;
+};
+
+/** Structure holding the result of a run. */
+struct FwRtScaleResult {
+	/** The number of notifications. */
+	long nOfNotifs;
+	/** The number of throttled notifications. */
+	long nOfThrottled;
+	/** The duration in ns of the notification phase. */
+	double notifyNs;
+	/** The duration in ns of the run (notification phase and draining). */
+	double elapsedNs;
+	/** The CPU time in ns used by the process during the run. */
+	double cpuNs;
+	/** The number of context switches of the process during the run. */
+	long nOfCtxSw;
+	/** The latency percentiles in ns (50%, 90%, 99%, 99.9% and maximum). */
+	double lat[5];
+};
+
+/** The shared state of the current run. */
+static struct FwRtScaleRun scaleRun;
+
+/** The names of the backends (in the order of <code>::FwRtScaleBackend_t</code>). */
+static const char* backendNames[3] = {"thread", "lockfree", "pool"};
+
+/**
+ * Execute one run of the benchmark.
+ * @param backend the activation backend
+ * @param nOfWorkers the number of worker threads of the RT Pool
+ * @param result the result of the run
+ * @return 1 if the run was executed successfully, 0 otherwise
+ */
+static int Run(FwRtScaleBackend_t backend, int nOfWorkers, struct FwRtScaleResult* result);
+
+/**
+ * Body of a notifier thread.
+ * @param ptr the descriptor of the notifier (a <code>::FwRtScaleNotifier</code>)
+ * @return always NULL
+ */
+static void* Notifier(void* ptr);
+
+/**
+ * Implement Notification Logic and Implement Activation Logic Action of the containers.
+ * @param rtDesc the RT Container descriptor
+ * @return always 1
+ */
+static FwRtOutcome_t ScaleAccept(FwRtDesc_t rtDesc);
+
+/**
+ * Execute Functional Behaviour Action of the containers.
+ * This action takes a latency sample for the consumed notification.
+ * @param rtDesc the RT Container descriptor
+ * @return always 0 (the functional behaviour never terminates)
+ */
+static FwRtOutcome_t ScaleExecFuncBehaviour(FwRtDesc_t rtDesc);
+
+/**
+ * Parse a comma-separated list of non-negative integers.
+ * @param str the list
+ * @param values the array where the values are stored
+ * @param max the maximum accepted value
+ * @return the number of values or 0 if the list is not valid
+ */
+static int ParseList(const char* str, long* values, long max);
+
+/**
+ * Compare two latencies (comparison function for <code>qsort</code>).
+ * @param a the first latency
+ * @param b the second latency
+ * @return a negative, zero or positive value as the first latency is smaller, equal or larger
+ */
+static int CompareLatency(const void* a, const void* b);
+
+/**
+ * Print one line of the benchmark report.
+ * @param format the format of the report
+ * @param backend the activation backend
+ * @param result the result of the run
+ * @param isFirst 1 if this is the first line of the report
+ */
+static void PrintResult(FwRtScaleFormat_t format, FwRtScaleBackend_t backend, struct FwRtScaleResult* result,
+                        int isFirst);
+
+/**
+ * Return the CPU time used by the process and its number of context switches.
+ * @param nOfCtxSw where the number of context switches is stored
+ * @return the CPU time in ns
+ */
+static double GetCpuNs(long* nOfCtxSw);
+
+/**
+ * Return the current time in nanoseconds.
+ * @return the current time in nanoseconds
+ */
+static double GetTimeNs(void);
+
+/*------------------------------------------------------------------------------------*/
+int main(int argc, char* argv[]) {
+	long backends[SCALE_MAX_LIST] = {scaleThread, scaleLockFree, scalePool};
+	long containers[SCALE_MAX_LIST] = {1, 10, 100, 1000};
+	long notifiers[SCALE_MAX_LIST] = {1, 4};
+	long rates[SCALE_MAX_LIST] = {0};
+	int nOfBackends = 3, nOfContainers = 4, nOfNotifiers = 2, nOfRates = 1;
+	struct FwRtScaleResult result;
+	FwRtScaleFormat_t format = scaleText;
+	long durationMs = 200;
+	long nOfWorkers = 4;
+	const char* p;
+	int isFirst = 1;
+	int isUsage = 0;
+	int i, b, c, n, r;
+
+	/* Parse the command line options */
+	for (i=1; i<argc; i++) {
+		if (strcmp(argv[i], "--format=csv") == 0)
+			format = scaleCsv;
+		else if (strcmp(argv[i], "--format=json") == 0)
+			format = scaleJson;
+		else if (strcmp(argv[i], "--format=text") == 0)
+			format = scaleText;
+		else if (strncmp(argv[i], "--backends=", 11) == 0) {
+			nOfBackends = 0;
+			for (p=argv[i]+11; (*p != '\0') && (nOfBackends < SCALE_MAX_LIST); p+=strcspn(p, ",")) {
+				p += (*p == ',');
+				for (b=0; b<3; b++)
+					if ((strncmp(p, backendNames[b], strlen(backendNames[b])) == 0) &&
+					        ((p[strlen(backendNames[b])] == ',') || (p[strlen(backendNames[b])] == '\0')))
+						break;
+				if (b == 3) {
+					nOfBackends = 0;
+					break;
+				}
+				backends[nOfBackends++] = b;
+			}
+			isUsage = isUsage || (nOfBackends == 0);
+		} else if (strncmp(argv[i], "--containers=", 13) == 0)
+			isUsage = isUsage || ((nOfContainers = ParseList(argv[i]+13, containers, SCALE_MAX_CONTAINERS)) == 0);
+		else if (strncmp(argv[i], "--notifiers=", 12) == 0)
+			isUsage = isUsage || ((nOfNotifiers = ParseList(argv[i]+12, notifiers, SCALE_MAX_THREADS)) == 0);
+		else if (strncmp(argv[i], "--rates=", 8) == 0)
+			isUsage = isUsage || ((nOfRates = ParseList(argv[i]+8, rates, 1000000000L)) == 0);
+		else if ((strncmp(argv[i], "--duration=", 11) == 0) && (atol(argv[i]+11) > 0))
+			durationMs = atol(argv[i]+11);
+		else if ((strncmp(argv[i], "--workers=", 10) == 0) && (atol(argv[i]+10) > 0) &&
+		         (atol(argv[i]+10) <= SCALE_MAX_THREADS))
+			nOfWorkers = atol(argv[i]+10);
+		else
+			isUsage = 1;
+	}
+	for (i=0; i<nOfContainers; i++)
+		isUsage = isUsage || (containers[i] == 0);
+	for (i=0; i<nOfNotifiers; i++)
+		isUsage = isUsage || (notifiers[i] == 0);
+	if (isUsage) {
+		fprintf(stderr, "Usage: %s [--format=text|csv|json] [--backends=thread,lockfree,pool] [--containers=LIST]\n"
+		        "       [--notifiers=LIST] [--rates=LIST] [--duration=MS] [--workers=N]\n", argv[0]);
+		return EXIT_FAILURE;
+	}
+
+	scaleRun.samples = (double*)malloc(SCALE_MAX_SAMPLES*sizeof(double));
+	if (scaleRun.samples == NULL) {
+		fprintf(stderr, "Not enough memory for the latency samples\n");
+		return EXIT_FAILURE;
+	}
+	scaleRun.durationNs = (double)durationMs*1.0e6;
+
+	/* Run the sweep */
+	for (b=0; b<nOfBackends; b++)
+		for (c=0; c<nOfContainers; c++)
+			for (n=0; n<nOfNotifiers; n++)
+				for (r=0; r<nOfRates; r++) {
+					scaleRun.nOfConts = (int)containers[c];
+					scaleRun.nOfNotifiers = (int)notifiers[n];
+					scaleRun.rate = (double)rates[r];
+					if (Run((FwRtScaleBackend_t)backends[b], (int)nOfWorkers, &result) == 0) {
+						fprintf(stderr, "Run %s/%ld/%ld/%ld could not be executed\n", backendNames[backends[b]],
+						        containers[c], notifiers[n], rates[r]);
+						return EXIT_FAILURE;
+					}
+					PrintResult(format, (FwRtScaleBackend_t)backends[b], &result, isFirst);
+					isFirst = 0;
+				}
+	if (format == scaleJson)
+		printf(isFirst ? "[]\n" : "\n]\n");
+
+	free(scaleRun.samples);
+	return EXIT_SUCCESS;
+}
+
+/*------------------------------------------------------------------------------------*/
+static int Run(FwRtScaleBackend_t backend, int nOfWorkers, struct FwRtScaleResult* result) {
+	struct FwRtScaleNotifier notifs[SCALE_MAX_THREADS];
+	pthread_t workers[SCALE_MAX_THREADS];
+	struct FwRtPool pool;
+	pthread_attr_t threadAttr;
+	struct FwRtScaleCont* cont;
+	double startNs, startCpuNs, drainNs;
+	long startCtxSw, nOfSamples;
+	int i, isDrained, nOfStarted = 0, isOk = 1;
+
+	memset(result, 0, sizeof(struct FwRtScaleResult));
+	scaleRun.nOfSamples = 0;
+	scaleRun.conts = (struct FwRtScaleCont*)calloc((size_t)scaleRun.nOfConts, sizeof(struct FwRtScaleCont));
+	if (scaleRun.conts == NULL)
+		return 0;
+
+	/* The Activation Threads get a small stack so that thousands of them can be created */
+	pthread_attr_init(&threadAttr);
+	pthread_attr_setstacksize(&threadAttr, SCALE_STACK_SIZE);
+	if (backend == scalePool) {
+		FwRtPoolInit(&pool, workers, nOfWorkers, NULL);
+		if (FwRtPoolGetState(&pool) != rtContStarted)
+			isOk = 0;
+	}
+
+	/* Configure, initialize and start the containers */
+	for (i=0; (i<scaleRun.nOfConts) && isOk; i++) {
+		cont = &scaleRun.conts[i];
+		FwRtReset(&cont->rtDesc);
+		FwRtSetData(&cont->rtDesc, cont);
+		FwRtSetImplementNotifLogic(&cont->rtDesc, &ScaleAccept);
+		FwRtSetImplementActivLogic(&cont->rtDesc, &ScaleAccept);
+		FwRtSetExecFuncBehaviour(&cont->rtDesc, &ScaleExecFuncBehaviour);
+		if (backend == scalePool) {
+			FwRtSetPosixAttr(&cont->rtDesc, NULL, NULL, NULL);
+			FwRtSetPool(&cont->rtDesc, &pool);
+		} else
+			FwRtSetPosixAttr(&cont->rtDesc, &threadAttr, NULL, NULL);
+		if (backend == scaleLockFree)
+			FwRtSetLockFreeNotif(&cont->rtDesc, 1);
+		FwRtInit(&cont->rtDesc);
+		FwRtStart(&cont->rtDesc);
+		if (FwRtGetContState(&cont->rtDesc) != rtContStarted) {
+			FwRtShutdown(&cont->rtDesc);
+			scaleRun.nOfConts = i;
+			isOk = 0;
+		}
+	}
+
+	/* Notification phase */
+	startCpuNs = GetCpuNs(&startCtxSw);
+	startNs = GetTimeNs();
+	for (i=0; (i<scaleRun.nOfNotifiers) && isOk; i++) {
+		notifs[i].index = i;
+		notifs[i].nOfNotifs = 0;
+		notifs[i].nOfThrottled = 0;
+		if (pthread_create(&notifs[i].thread, NULL, &Notifier, &notifs[i]) != 0)
+			isOk = 0;
+		else
+			nOfStarted++;
+	}
+	for (i=0; i<nOfStarted; i++) {
+		pthread_join(notifs[i].thread, NULL);
+		result->nOfNotifs += notifs[i].nOfNotifs;
+		result->nOfThrottled += notifs[i].nOfThrottled;
+	}
+	result->notifyNs = GetTimeNs() - startNs;
+
+	/* Wait until all notifications have been consumed */
+	drainNs = GetTimeNs();
+	do {
+		isDrained = 1;
+		for (i=0; (i<scaleRun.nOfConts) && isDrained; i++)
+			if (scaleRun.conts[i].nOfExec != scaleRun.conts[i].nOfSent)
+				isDrained = 0;
+		if (!isDrained)
+			sched_yield();
+	} while (!isDrained && (GetTimeNs() - drainNs < SCALE_DRAIN_TIMEOUT));
+	result->elapsedNs = GetTimeNs() - startNs;
+	result->cpuNs = GetCpuNs(&result->nOfCtxSw) - startCpuNs;
+	result->nOfCtxSw -= startCtxSw;
+	if (!isDrained)
+		isOk = 0;
+
+	/* Stop and shut down the containers and the pool */
+	for (i=0; i<scaleRun.nOfConts; i++)
+		FwRtStop(&scaleRun.conts[i].rtDesc);
+	for (i=0; i<scaleRun.nOfConts; i++) {
+		FwRtWaitForTermination(&scaleRun.conts[i].rtDesc);
+		FwRtShutdown(&scaleRun.conts[i].rtDesc);
+		if (FwRtGetErrCode(&scaleRun.conts[i].rtDesc) != 0)
+			isOk = 0;
+	}
+	if (backend == scalePool) {
+		FwRtPoolShutdown(&pool);
+		if (FwRtPoolGetErrCode(&pool) != 0)
+			isOk = 0;
+	}
+	pthread_attr_destroy(&threadAttr);
+	free(scaleRun.conts);
+
+	/* Latency percentiles */
+	nOfSamples = (scaleRun.nOfSamples < SCALE_MAX_SAMPLES) ? scaleRun.nOfSamples : SCALE_MAX_SAMPLES;
+	if (nOfSamples > 0) {
+		qsort(scaleRun.samples, (size_t)nOfSamples, sizeof(double), &CompareLatency);
+		result->lat[0] = scaleRun.samples[(nOfSamples-1)/2];
+		result->lat[1] = scaleRun.samples[(long)((double)(nOfSamples-1)*0.9)];
+		result->lat[2] = scaleRun.samples[(long)((double)(nOfSamples-1)*0.99)];
+		result->lat[3] = scaleRun.samples[(long)((double)(nOfSamples-1)*0.999)];
+		result->lat[4] = scaleRun.samples[nOfSamples-1];
+	}
+	return isOk;
+}
+
+/*------------------------------------------------------------------------------------*/
+static void* Notifier(void* ptr) {
+	struct FwRtScaleNotifier* notif = (struct FwRtScaleNotifier*)ptr;
+	double period = 0;
+	double startNs, endNs, nowNs, nextNs;
+	struct FwRtScaleCont* cont;
+	struct timespec delay;
+	unsigned long seq;
+	long k;
+
+	if (scaleRun.rate > 0)
+		period = (double)scaleRun.nOfNotifiers*1.0e9/scaleRun.rate;
+	startNs = GetTimeNs();
+	endNs = startNs + scaleRun.durationNs;
+
+	for (k=notif->index; ; k+=scaleRun.nOfNotifiers) {
+		nowNs = GetTimeNs();
+		if (nowNs >= endNs)
+			break;
+
+		/* Pace the notifications (short delays are busy-waited) */
+		nextNs = startNs + (double)notif->nOfNotifs*period;
+		if (nextNs > nowNs + 50000.0) {
+			delay.tv_sec = (time_t)((nextNs-nowNs)/1.0e9);
+			delay.tv_nsec = (long)(nextNs - nowNs - (double)delay.tv_sec*1.0e9);
+			nanosleep(&delay, NULL);
+		}
+		while ((period > 0) && (GetTimeNs() < nextNs))
+			;
+
+		cont = &scaleRun.conts[k % scaleRun.nOfConts];
+		if (cont->nOfSent - cont->nOfExec >= SCALE_MAX_BACKLOG) {
+			notif->nOfThrottled++;
+			sched_yield();
+			continue;
+		}
+		seq = __sync_fetch_and_add(&cont->nOfSent, 1);
+		cont->slots[seq % SCALE_N_OF_SLOTS].notifNs = GetTimeNs();
+		__sync_synchronize();
+		cont->slots[seq % SCALE_N_OF_SLOTS].seq = seq+1;
+		FwRtNotify(&cont->rtDesc);
+		notif->nOfNotifs++;
+	}
+	return NULL;
+}
+
+/*------------------------------------------------------------------------------------*/
+static FwRtOutcome_t ScaleAccept(FwRtDesc_t rtDesc) {
+	(void)rtDesc;
+	return 1;
+}
+
+/*------------------------------------------------------------------------------------*/
+static FwRtOutcome_t ScaleExecFuncBehaviour(FwRtDesc_t rtDesc) {
+	struct FwRtScaleCont* cont = (struct FwRtScaleCont*)FwRtGetData(rtDesc);
+	struct FwRtScaleSlot* slot = &cont->slots[cont->nOfExec % SCALE_N_OF_SLOTS];
+	double nowNs = GetTimeNs();
+	long i;
+
+	/* A slot whose time stamp is not yet published is not sampled */
+	if (slot->seq == cont->nOfExec+1) {
+		__sync_synchronize();
+		i = __sync_fetch_and_add(&scaleRun.nOfSamples, 1);
+		if (i < SCALE_MAX_SAMPLES)
+			scaleRun.samples[i] = nowNs - slot->notifNs;
+	}
+	(void)__sync_add_and_fetch(&cont->nOfExec, 1);
+	return 0;
+}
+
+/*------------------------------------------------------------------------------------*/
+static int ParseList(const char* str, long* values, long max) {
+	char* end;
+	int n = 0;
+
+	while (n < SCALE_MAX_LIST) {
+		values[n] = strtol(str, &end, 10);
+		if ((end == str) || (values[n] < 0) || (values[n] > max))
+			return 0;
+		n++;
+		if (*end == '\0')
+			return n;
+		if (*end != ',')
+			return 0;
+		str = end+1;
+	}
+	return 0;
+}
+
+/*------------------------------------------------------------------------------------*/
+static int CompareLatency(const void* a, const void* b) {
+	double da = *(const double*)a;
+	double db = *(const double*)b;
+	return (da > db) - (da < db);
+}
+
+/*------------------------------------------------------------------------------------*/
+static void PrintResult(FwRtScaleFormat_t format, FwRtScaleBackend_t backend, struct FwRtScaleResult* result,
+                        int isFirst) {
+	double throughput = (result->notifyNs > 0) ? (double)result->nOfNotifs*1.0e9/result->notifyNs : 0;
+	double cpuPct = (result->elapsedNs > 0) ? 100.0*result->cpuNs/result->elapsedNs : 0;
+
+	switch (format) {
+	case scaleCsv:
+		if (isFirst)
+			printf("backend,containers,notifiers,rate,notifs,throttled,notifs_per_s,p50_ns,p90_ns,p99_ns,p999_ns,"
+			       "max_ns,cpu_pct,ctx_switches\n");
+		printf("%s,%d,%d,%.0f,%ld,%ld,%.0f,%.0f,%.0f,%.0f,%.0f,%.0f,%.1f,%ld\n", backendNames[backend],
+		       scaleRun.nOfConts, scaleRun.nOfNotifiers, scaleRun.rate, result->nOfNotifs, result->nOfThrottled,
+		       throughput, result->lat[0], result->lat[1], result->lat[2], result->lat[3], result->lat[4], cpuPct,
+		       result->nOfCtxSw);
+		break;
+	case scaleJson:
+		printf(isFirst ? "[\n" : ",\n");
+		printf("  {\"backend\": \"%s\", \"containers\": %d, \"notifiers\": %d, \"rate\": %.0f, \"notifs\": %ld, "
+		       "\"throttled\": %ld, \"notifs_per_s\": %.0f, \"p50_ns\": %.0f, \"p90_ns\": %.0f, \"p99_ns\": %.0f, "
+		       "\"p999_ns\": %.0f, \"max_ns\": %.0f, \"cpu_pct\": %.1f, \"ctx_switches\": %ld}", backendNames[backend],
+		       scaleRun.nOfConts, scaleRun.nOfNotifiers, scaleRun.rate, result->nOfNotifs, result->nOfThrottled,
+		       throughput, result->lat[0], result->lat[1], result->lat[2], result->lat[3], result->lat[4], cpuPct,
+		       result->nOfCtxSw);
+		break;
+	default:
+		if (isFirst)
+			printf("%-9s %6s %5s %9s %12s %10s %10s %10s %10s %10s %7s %10s\n", "Backend", "Conts", "Ntfs", "Rate",
+			       "Notifs/s", "p50 ns", "p90 ns", "p99 ns", "p99.9 ns", "max ns", "CPU %", "Ctx sw");
+		printf("%-9s %6d %5d %9.0f %12.0f %10.0f %10.0f %10.0f %10.0f %10.0f %7.1f %10ld\n", backendNames[backend],
+		       scaleRun.nOfConts, scaleRun.nOfNotifiers, scaleRun.rate, throughput, result->lat[0], result->lat[1],
+		       result->lat[2], result->lat[3], result->lat[4], cpuPct, result->nOfCtxSw);
+		break;
+	}
+}
+
+/*------------------------------------------------------------------------------------*/
+static double GetCpuNs(long* nOfCtxSw) {
+	struct rusage usage;
+
+	getrusage(RUSAGE_SELF, &usage);
+	*nOfCtxSw = usage.ru_nvcsw + usage.ru_nivcsw;
+	return ((double)usage.ru_utime.tv_sec + (double)usage.ru_stime.tv_sec)*1.0e9 +
+	       ((double)usage.ru_utime.tv_usec + (double)usage.ru_stime.tv_usec)*1.0e3;
+}
+
+/*------------------------------------------------------------------------------------*/
+static double GetTimeNs(void) {
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (double)now.tv_sec*1.0e9 + (double)now.tv_nsec;
+}
@@ -0,0 +1,319 @@
+/**
+ * @file
+ * @ingroup prGroup
+ * Implements the auxiliary functions of the FW Procedure Module.
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2011, All Rights Reserved
+ *
+ * This file is part of the FW Profile.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#include "FwPrAux.h"
+#include "FwPrConfig.h"
+#include "FwPrPrivate.h"
+#include <stdlib.h>
+
+/**
+ * Print the destination of a control flow to an output stream.
+ * @param stream the output stream
+ * @param dest the destination of the control flow (see <code>::PrFlow_t</code>)
+ */
+static void PrPrintDest(FILE* stream, FwPrCounterS1_t dest);
+
+/**
+ * Print the profiling data of a control flow to an output stream.
+ * @param stream the output stream
+ * @param prDesc the descriptor of the procedure
+ * @param iFlow the location of the control flow in the control flow array
+ */
+static void PrPrintFlowProfile(FILE* stream, FwPrDesc_t prDesc, FwPrCounterS1_t iFlow);
+
+/* ------------------------------------------------------------------------------- */
+void FwPrEnableProfile(FwPrDesc_t prDesc, FwPrProfileClock_t clock) {
+  PrProfile_t*     profile   = prDesc->profile;
+  FwPrCounterU4_t  nOfANodes = (FwPrCounterU4_t)(prDesc->prBase->nOfANodes);
+  FwPrCounterU4_t  nOfFlows  = (FwPrCounterU4_t)(prDesc->prBase->nOfFlows);
+  FwPrCounterU4_t* counters;
+
+  if (profile == NULL) {
+    /* The profiling arrays are located in the same block of memory as the profiling structure */
+    profile = (PrProfile_t*)malloc(sizeof(PrProfile_t) + (2 * nOfANodes + 3 * nOfFlows) * sizeof(FwPrCounterU4_t));
+    if (profile == NULL) {
+      prDesc->errCode = prOutOfMemory;
+      return;
+    }
+    counters               = (FwPrCounterU4_t*)(void*)(profile + 1);
+    profile->nodeExecCnt   = counters;
+    profile->nodeDwell     = counters + nOfANodes;
+    profile->flowTakenCnt  = counters + 2 * nOfANodes;
+    profile->guardTrueCnt  = profile->flowTakenCnt + nOfFlows;
+    profile->guardFalseCnt = profile->guardTrueCnt + nOfFlows;
+    prDesc->profile        = profile;
+  }
+
+  profile->clock = clock;
+  FwPrResetProfile(prDesc);
+}
+
+/* ------------------------------------------------------------------------------- */
+void FwPrDisableProfile(FwPrDesc_t prDesc) {
+  free(prDesc->profile);
+  prDesc->profile = NULL;
+}
+
+/* ------------------------------------------------------------------------------- */
+void FwPrResetProfile(FwPrDesc_t prDesc) {
+  PrProfile_t*    profile = prDesc->profile;
+  FwPrCounterS1_t i;
+
+  if (profile == NULL) {
+    return;
+  }
+
+  for (i = 0; i < prDesc->prBase->nOfANodes; i++) {
+    profile->nodeExecCnt[i] = 0;
+    profile->nodeDwell[i]   = 0;
+  }
+  for (i = 0; i < prDesc->prBase->nOfFlows; i++) {
+    profile->flowTakenCnt[i]  = 0;
+    profile->guardTrueCnt[i]  = 0;
+    profile->guardFalseCnt[i] = 0;
+  }
+
+  /* If the procedure is already in an action node, its time in the node is measured from now */
+  profile->entryTime = (profile->clock != NULL) ? profile->clock() : 0;
+}
+
+/* ------------------------------------------------------------------------------- */
+void FwPrPrintProfile(FwPrDesc_t prDesc, FILE* stream) {
+  PrBaseDesc_t*   prBase;
+  PrProfile_t*    profile;
+  PrFlow_t*       flows;
+  FwPrCounterS1_t i, j, k, baseLoc;
+  FwPrCounterS1_t hotNode  = 0;
+  FwPrCounterU4_t hotValue = 0;
+  FwPrCounterU4_t totDwell = 0;
+  FwPrCounterU4_t value;
+  int             nOfHotSpots = 0;
+
+  if (prDesc == NULL) {
+    fprintf(stream, "The argument procedure descriptor is NULL\n");
+    return;
+  }
+  if (prDesc->profile == NULL) {
+    fprintf(stream, "Profiling is not enabled on the argument procedure\n");
+    return;
+  }
+  prBase  = prDesc->prBase;
+  profile = prDesc->profile;
+  flows   = prBase->flows;
+
+  for (i = 0; i < prBase->nOfANodes; i++) {
+    totDwell += profile->nodeDwell[i];
+  }
+
+  fprintf(stream, "\n");
+  fprintf(stream, "PROCEDURE PROFILE\n");
+  fprintf(stream, "-----------------\n");
+  fprintf(stream, "The Procedure Execution Counter is       : %u\n", prDesc->prExecCnt);
+  if (profile->clock == NULL) {
+    fprintf(stream, "The time spent in the action nodes is    : not measured\n");
+  }
+  else {
+    fprintf(stream, "The time spent in the action nodes is    : %lu\n", totDwell);
+  }
+  fprintf(stream, "Control flow from the initial node:\n");
+  PrPrintFlowProfile(stream, prDesc, 0);
+  fprintf(stream, "\n");
+
+  fprintf(stream, "PROFILE OF ACTION NODES\n");
+  fprintf(stream, "-----------------------\n");
+  for (i = 0; i < prBase->nOfANodes; i++) {
+    if (prBase->aNodes[i].iFlow == -1) {
+      continue;
+    }
+    if (profile->clock == NULL) {
+      fprintf(stream, "Action Node %d: executed %lu times\n", i + 1, profile->nodeExecCnt[i]);
+    }
+    else {
+      fprintf(stream, "Action Node %d: executed %lu times, time spent %lu (%.1f%%)\n", i + 1, profile->nodeExecCnt[i],
+              profile->nodeDwell[i], (totDwell > 0) ? (100.0 * (double)profile->nodeDwell[i]) / (double)totDwell : 0.0);
+    }
+    value = (profile->clock == NULL) ? profile->nodeExecCnt[i] : profile->nodeDwell[i];
+    if ((hotNode == 0) || (value > hotValue)) {
+      hotNode  = (FwPrCounterS1_t)(i + 1);
+      hotValue = value;
+    }
+    PrPrintFlowProfile(stream, prDesc, prBase->aNodes[i].iFlow);
+  }
+  fprintf(stream, "\n");
+
+  if (prBase->nOfDNodes > 0) {
+    fprintf(stream, "PROFILE OF DECISION NODES\n");
+    fprintf(stream, "-------------------------\n");
+  }
+  for (i = 0; i < prBase->nOfDNodes; i++) {
+    if (prBase->dNodes[i].outFlowIndex == -1) {
+      continue;
+    }
+    fprintf(stream, "Decision Node %d:\n", i + 1);
+    baseLoc = prBase->dNodes[i].outFlowIndex;
+    for (j = baseLoc; j < (baseLoc + prBase->dNodes[i].nOfOutTrans); j++) {
+      PrPrintFlowProfile(stream, prDesc, j);
+    }
+  }
+  if (prBase->nOfDNodes > 0) {
+    fprintf(stream, "\n");
+  }
+
+  fprintf(stream, "HOT SPOTS\n");
+  fprintf(stream, "---------\n");
+  if (hotNode != 0) {
+    fprintf(stream, "The hottest action node is action node %d\n", hotNode);
+  }
+  for (i = 0; i < prBase->nOfANodes; i++) {
+    j = prBase->aNodes[i].iFlow;
+    if ((j != -1) && (flows[j].iGuard != 0) && (profile->guardFalseCnt[j] > profile->guardTrueCnt[j])) {
+      fprintf(stream, "Action Node %d: the guard of the control flow to ", i + 1);
+      PrPrintDest(stream, flows[j].dest);
+      fprintf(stream, " is false more often (%lu times) than true (%lu times)\n", profile->guardFalseCnt[j],
+              profile->guardTrueCnt[j]);
+      nOfHotSpots++;
+    }
+  }
+  for (i = 0; i < prBase->nOfDNodes; i++) {
+    baseLoc = prBase->dNodes[i].outFlowIndex;
+    if (baseLoc == -1) {
+      continue;
+    }
+    for (j = baseLoc; j < (baseLoc + prBase->dNodes[i].nOfOutTrans); j++) {
+      /* Look for the first preceding control flow which is taken less often */
+      for (k = baseLoc; k < j; k++) {
+        if (profile->flowTakenCnt[k] < profile->flowTakenCnt[j]) {
+          fprintf(stream, "Decision Node %d: the control flow to ", i + 1);
+          PrPrintDest(stream, flows[j].dest);
+          fprintf(stream, " is taken more often (%lu times) than the preceding control flow to ",
+                  profile->flowTakenCnt[j]);
+          PrPrintDest(stream, flows[k].dest);
+          fprintf(stream, " (%lu times)\n", profile->flowTakenCnt[k]);
+          nOfHotSpots++;
+          break;
+        }
+      }
+    }
+  }
+  if (nOfHotSpots == 0) {
+    fprintf(stream, "No control flows or guards need to be reordered\n");
+  }
+}
+
+/* ------------------------------------------------------------------------------- */
+FwPrErrCode_t FwPrGenerateConstBase(FwPrDesc_t prDesc, const char* name, FILE* stream) {
+  PrBaseDesc_t*   prBase = prDesc->prBase;
+  FwPrErrCode_t   outcome;
+  FwPrCounterS1_t i;
+
+  outcome = FwPrCompile(prDesc);
+  if (outcome != prSuccess) {
+    return outcome;
+  }
+
+  fprintf(stream, "/*\n");
+  fprintf(stream, " * Code generated by FwPrGenerateConstBase.\n");
+  fprintf(stream, " * Constant base descriptor %s of a procedure with the following size:\n", name);
+  fprintf(stream, " * - number of action nodes: %d\n", prBase->nOfANodes);
+  fprintf(stream, " * - number of decision nodes: %d\n", prBase->nOfDNodes);
+  fprintf(stream, " * - number of control flows: %d\n", prBase->nOfFlows);
+  fprintf(stream, " * - number of actions: %d\n", prDesc->nOfActions);
+  fprintf(stream, " * - number of guards: %d\n", prDesc->nOfGuards - 1);
+  fprintf(stream, " * .\n");
+  fprintf(stream, " * The procedure is instantiated with FW_PR_INST_CONST(PR_DESC, %s, %d, %d).\n", name,
+          prDesc->nOfActions, prDesc->nOfGuards - 1);
+  fprintf(stream, " */\n\n");
+  fprintf(stream, "#include \"FwPrPrivate.h\"\n\n");
+
+  fprintf(stream, "static const PrANode_t %s_aNodes[%d] = {\n", name, prBase->nOfANodes);
+  for (i = 0; i < prBase->nOfANodes; i++) {
+    fprintf(stream, "  {%d, %d}%s\n", prBase->aNodes[i].iFlow, prBase->aNodes[i].iAction,
+            (i < prBase->nOfANodes - 1) ? "," : "");
+  }
+  fprintf(stream, "};\n\n");
+
+  if (prBase->nOfDNodes > 0) {
+    fprintf(stream, "static const PrDNode_t %s_dNodes[%d] = {\n", name, prBase->nOfDNodes);
+    for (i = 0; i < prBase->nOfDNodes; i++) {
+      fprintf(stream, "  {%d, %d}%s\n", prBase->dNodes[i].outFlowIndex, prBase->dNodes[i].nOfOutTrans,
+              (i < prBase->nOfDNodes - 1) ? "," : "");
+    }
+    fprintf(stream, "};\n\n");
+  }
+
+  fprintf(stream, "static const PrFlow_t %s_flows[%d] = {\n", name, prBase->nOfFlows);
+  for (i = 0; i < prBase->nOfFlows; i++) {
+    fprintf(stream, "  {%d, %d}%s\n", prBase->flows[i].dest, prBase->flows[i].iGuard,
+            (i < prBase->nOfFlows - 1) ? "," : "");
+  }
+  fprintf(stream, "};\n\n");
+
+  fprintf(stream, "static const PrExecFlow_t %s_exec[%d] = {\n", name, prBase->nOfFlows);
+  for (i = 0; i < prBase->nOfFlows; i++) {
+    fprintf(stream, "  {%d, %d, %d, %d, %d}%s\n", prBase->execFlows[i].dest, prBase->execFlows[i].iGuard,
+            prBase->execFlows[i].iAction, prBase->execFlows[i].iNext, prBase->execFlows[i].nOfNext,
+            (i < prBase->nOfFlows - 1) ? "," : "");
+  }
+  fprintf(stream, "};\n\n");
+
+  /* The arrays are constant: the casts only remove the qualifier required by the type of the fields */
+  fprintf(stream, "const PrBaseDesc_t %s = {\n", name);
+  fprintf(stream, "  (PrANode_t*)%s_aNodes,\n", name);
+  if (prBase->nOfDNodes > 0) {
+    fprintf(stream, "  (PrDNode_t*)%s_dNodes,\n", name);
+  }
+  else {
+    fprintf(stream, "  NULL,\n");
+  }
+  fprintf(stream, "  (PrFlow_t*)%s_flows,\n", name);
+  fprintf(stream, "  %d,\n", prBase->nOfANodes);
+  fprintf(stream, "  %d,\n", prBase->nOfDNodes);
+  fprintf(stream, "  %d,\n", prBase->nOfFlows);
+  fprintf(stream, "  (PrExecFlow_t*)%s_exec,\n", name);
+  fprintf(stream, "  1\n");
+  fprintf(stream, "};\n");
+
+  return prSuccess;
+}
+
+/* ------------------------------------------------------------------------------- */
+static void PrPrintDest(FILE* stream, FwPrCounterS1_t dest) {
+  if (dest > 0) {
+    fprintf(stream, "action node %d", dest);
+  }
+  else if (dest < 0) {
+    fprintf(stream, "decision node %d", -dest);
+  }
+  else {
+    fprintf(stream, "final node");
+  }
+}
+
+/* ------------------------------------------------------------------------------- */
+static void PrPrintFlowProfile(FILE* stream, FwPrDesc_t prDesc, FwPrCounterS1_t iFlow) {
+  PrFlow_t*    flow    = &(prDesc->prBase->flows[iFlow]);
+  PrProfile_t* profile = prDesc->profile;
+
+  fprintf(stream, "\tControl flow to ");
+  PrPrintDest(stream, flow->dest);
+  fprintf(stream, ": taken %lu times", profile->flowTakenCnt[iFlow]);
+  if (flow->iGuard != 0) {
+    fprintf(stream, ", guard true %lu times and false %lu times", profile->guardTrueCnt[iFlow],
+            profile->guardFalseCnt[iFlow]);
+  }
+  fprintf(stream, "\n");
+}
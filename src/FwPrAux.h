@@ -0,0 +1,130 @@
+/**
+ * @file
+ * @ingroup prGroup
+ * Declaration of the auxiliary interface for a FW Procedure.
+ * The auxiliary interface offers functions which support the
+ * development of an application which uses the FW Procedure
+ * but which are not expected to be used during normal operation.
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2011, All Rights Reserved
+ *
+ * This file is part of the FW Profile.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#ifndef FWPR_AUX_H_
+#define FWPR_AUX_H_
+
+#include "FwPrCore.h"
+#include <stdio.h>
+
+/**
+ * Enable the profiling mode of a procedure.
+ * In profiling mode, the procedure keeps the following profiling data:
+ * - the number of times the action of each action node has been executed and the
+ *   total time spent in each action node;
+ * - the number of times each control flow has been taken;
+ * - the number of times the guard of each control flow has returned true and false.
+ * .
+ * The profiling data belong to the argument procedure and are not shared with
+ * the procedures which are derived from it.
+ *
+ * The times spent in the action nodes are measured with the argument clock function.
+ * If the clock function is NULL, the times spent in the action nodes are not measured.
+ * The time spent in an action node is accumulated when the node is left.
+ *
+ * The profiling data are allocated with <code>malloc</code>.
+ * If the allocation fails, the error code of the procedure is set to
+ * #prOutOfMemory and profiling remains disabled.
+ * If profiling is already enabled, the profiling data are reset and the clock
+ * function is replaced.
+ * The profiling data are released by <code>::FwPrDisableProfile</code> and by the
+ * functions which release a procedure created with the <code>DCreate</code>
+ * interface.
+ * Procedures created with the <code>SCreate</code> interface must be released
+ * with <code>::FwPrDisableProfile</code>.
+ * @param prDesc the descriptor of the procedure
+ * @param clock the function providing the time stamps (or NULL)
+ */
+void FwPrEnableProfile(FwPrDesc_t prDesc, FwPrProfileClock_t clock);
+
+/**
+ * Disable the profiling mode of a procedure and release its profiling data.
+ * This function has no effect if profiling is not enabled.
+ * @param prDesc the descriptor of the procedure
+ */
+void FwPrDisableProfile(FwPrDesc_t prDesc);
+
+/**
+ * Reset the profiling data of a procedure.
+ * This function has no effect if profiling is not enabled.
+ * @param prDesc the descriptor of the procedure
+ */
+void FwPrResetProfile(FwPrDesc_t prDesc);
+
+/**
+ * Print the profiling data of a procedure to an output stream.
+ * The report lists, for each action node and decision node, the profiling data of
+ * the node and of its out-going control flows and it then lists the hot spots of the
+ * procedure.
+ * The hot spots are:
+ * - the action node where the procedure spent most of its time (or whose action
+ *   has been executed most often if the times are not measured);
+ * - the control flows out of a decision node which have been taken more often than
+ *   a control flow which precedes them in the evaluation order: moving such a
+ *   control flow ahead saves guard evaluations;
+ * - the guards which have returned false more often than true.
+ * .
+ * This function assumes the argument output stream to be open and
+ * to have enough space to receive the output generated by the function.
+ * The function neither closes nor flushes the output stream.
+ * @param prDesc the descriptor of the procedure
+ * @param stream the output stream to which the profiling data are printed
+ */
+void FwPrPrintProfile(FwPrDesc_t prDesc, FILE* stream);
+
+/**
+ * Generate C code which defines a constant base descriptor for a procedure.
+ * The generated code defines a variable of type <code>const PrBaseDesc_t</code> with
+ * the argument name whose arrays of action nodes, decision nodes and control flows and
+ * whose execution table are constant arrays which are fully initialized with the
+ * content of the base descriptor of the argument procedure.
+ * Since neither the variable nor its arrays are modified at run-time, a compiler
+ * normally places them in a read-only section (e.g. <code>.rodata</code>) which,
+ * on targets with flash memory, does not use any RAM.
+ *
+ * Procedures which use the constant base descriptor are instantiated with macro
+ * <code>#FW_PR_INST_CONST</code> and they are initialized with function
+ * <code>::FwPrInitConst</code> (the arguments of the macro are given in the comment at
+ * the start of the generated code).
+ * The actions and guards are not part of the constant base descriptor: they are
+ * referred to by their positions in the action and guard arrays of the argument
+ * procedure and they are bound to functions by <code>::FwPrInitConst</code>.
+ *
+ * The procedure is compiled with <code>::FwPrCompile</code> before the code is
+ * generated and no code is generated if this fails.
+ * Procedures which use the constant base descriptor are therefore already
+ * compiled.
+ *
+ * The generated code only depends on the header file <code>FwPrPrivate.h</code> and
+ * it complies with the ANSI C standard.
+ * It must be compiled with the same index width (see <code>#FW_PR_INDEX_WIDTH</code>)
+ * as the application which generated it.
+ * This function assumes the argument output stream to be open and
+ * to have enough space to receive the output generated by the function.
+ * The function neither closes nor flushes the output stream.
+ * @param prDesc the descriptor of the procedure
+ * @param name the name of the generated constant base descriptor
+ * @param stream the output stream to which the code is written
+ * @return <code>#prSuccess</code> if the code was generated or the error code returned
+ * by <code>::FwPrCompile</code> otherwise
+ */
+FwPrErrCode_t FwPrGenerateConstBase(FwPrDesc_t prDesc, const char* name, FILE* stream);
+
+#endif /* FWPR_AUX_H_ */
@@ -18,6 +18,14 @@
 #include "FwPrConfig.h"
 #include "FwPrPrivate.h"
 #include <stdlib.h>
+#include <string.h>
+
+/**
+ * Number of action and decision nodes up to which <code>::FwPrCheck</code> performs
+ * its reachability analysis in local buffers (for larger procedures, the buffers are
+ * allocated with <code>malloc</code>).
+ */
+#define PR_CHECK_LOCAL_NODES 64
 
 /**
  * Create a control flow (other than the control flow from the initial node) with the
@@ -52,6 +60,8 @@ static void AddFlow(FwPrDesc_t prDesc, FwPrCounterS1_t srcId, NodeType_t srcType
  * Note that the argument action is guaranteed to be different from NULL
  * (because function <code>::FwPrAddAction</code> handles the case of action
  * being equal to NULL and, in that case, it does not call <code>AddAction</code>.
+ * If the procedure has a configuration index (see #FW_PR_CFG_INDEX_MIN), the
+ * look-up is done through the index and does not scan the array of actions.
  * @param prDesc descriptor of the procedure where the action is added
  * @param action action to be added
  * @return the location where the action is stored in the array or -1 if the
@@ -71,6 +81,8 @@ static FwPrCounterS1_t AddAction(FwPrDesc_t prDesc, FwPrAction_t action);
  *   location;
  * - if the argument guard is not present but the array of guards is already full, the
  *   function returns 0.
+ * If the procedure has a configuration index (see #FW_PR_CFG_INDEX_MIN), the
+ * look-up is done through the index and does not scan the array of guards.
  * @param prDesc descriptor of the procedure where the guard is added
  * @param guard guard to be added
  * @return the location where the guard is stored in the array or -1 if the
@@ -78,6 +90,139 @@ static FwPrCounterS1_t AddAction(FwPrDesc_t prDesc, FwPrAction_t action);
  */
 static FwPrCounterS1_t AddGuard(FwPrDesc_t prDesc, FwPrGuard_t guard);
 
+/**
+ * Give a derived procedure its own copy of arrays which it shares with its base
+ * procedure (see <code>::FwPrCreateDerShared</code>).
+ * Arrays which are not shared are not affected.
+ * If the copy of an array cannot be allocated, the error code of the procedure is
+ * set to #prOutOfMemory.
+ * @param prDesc the descriptor of the derived procedure
+ * @param arrays the arrays to be copied (a combination of #PR_SHARED_ACTIONS and
+ * #PR_SHARED_GUARDS)
+ * @return 1 if the procedure owns the arrays or 0 if the copy of an array could
+ * not be allocated
+ */
+static FwPrBool_t UnshareArrays(FwPrDesc_t prDesc, FwPrCounterU1_t arrays);
+
+/**
+ * Set or clear the bit of a guard in the bitmask of the pure guards of a procedure.
+ * The bit of the guard in the bitmask of the cached outcomes is cleared.
+ * This function does nothing if the procedure has no guard memo.
+ * @param prDesc the descriptor of the procedure
+ * @param iGuard the index of the guard in the guard array of the procedure
+ * @param isPure 1 if the bit is to be set, 0 if it is to be cleared
+ */
+static void MarkGuardPure(FwPrDesc_t prDesc, FwPrCounterS1_t iGuard, FwPrBool_t isPure);
+
+/**
+ * Return the guard memo of a procedure (the guard memo is allocated if it does not exist).
+ * A new guard memo has no pure guards and no declarative guards.
+ * @param prDesc the descriptor of the procedure
+ * @return the guard memo (or NULL if its allocation failed)
+ */
+static PrGuardMemo_t* GetGuardMemo(FwPrDesc_t prDesc);
+
+/**
+ * Remove the pure mark and the declaration of a guard of a procedure.
+ * This function does nothing if the procedure has no guard memo.
+ * @param prDesc the descriptor of the procedure
+ * @param iGuard the index of the guard in the guard array of the procedure
+ */
+static void ForgetGuard(FwPrDesc_t prDesc, FwPrCounterS1_t iGuard);
+
+/**
+ * Check that all action nodes and decision nodes of a procedure are reachable.
+ * The action and decision nodes are numbered consecutively: action nodes first and
+ * then decision nodes.
+ * The function first makes one pass over the control flows to mark, in a bitmap, all
+ * nodes which are the destination of a control flow.
+ * It then performs a depth-first search from the destination of the control flow out
+ * of the initial node to mark all nodes which can be reached from the initial node.
+ * This function assumes that the destinations of all control flows are legal.
+ * @param prDesc the descriptor of the procedure
+ * @return #prSuccess if all nodes are reachable, #prUnreachableANode or
+ * #prUnreachableDNode if a node is not the destination of any control flow,
+ * #prDisconnectedANode or #prDisconnectedDNode if a node cannot be reached from
+ * the initial node, or #prOutOfMemory if the buffers cannot be allocated
+ */
+static FwPrErrCode_t CheckReachability(FwPrDesc_t prDesc);
+
+/**
+ * Mark the destination of a control flow in the bitmap of reached nodes.
+ * @param prBase the base descriptor of the procedure
+ * @param map the bitmap of reached nodes
+ * @param dest the destination of the control flow
+ * @param node the node number of the destination (only set if the destination is
+ * an action node or a decision node)
+ * @return 1 if the destination is an action or decision node which was not yet
+ * marked, 0 otherwise
+ */
+static FwPrBool_t MarkDest(PrBaseDesc_t* prBase, unsigned char* map, FwPrCounterS1_t dest, FwPrCounterU4_t* node);
+
+/**
+ * Return the configuration index of a procedure and build it if it does not yet exist.
+ * The configuration index is only built if the sum of the sizes of the action and guard
+ * arrays is at least equal to #FW_PR_CFG_INDEX_MIN.
+ * @param prDesc the descriptor of the state machine
+ * @return the configuration index or NULL if the configuration index is not used or
+ * cannot be allocated (in which case the action and guard arrays must be scanned)
+ */
+static PrCfgIndex_t* GetCfgIndex(FwPrDesc_t prDesc);
+
+/**
+ * Compute the hash of a function pointer from the bytes of its representation.
+ * @param key the address of the function pointer
+ * @param size the size of the function pointer
+ * @return the hash of the function pointer
+ */
+static FwPrCounterU4_t HashFunc(const void* key, size_t size);
+
+/**
+ * Fill the hash table of an action or guard array with the non-NULL function pointers
+ * which precede the first NULL location at or after location <code>next</code>.
+ * @param index the hash table
+ * @param array the action or guard array
+ * @param elemSize the size of the elements of the array
+ * @param n the number of elements of the array
+ * @param nullKey the address of a NULL function pointer of the type of the array elements
+ */
+static void AdvanceIndex(PrFuncIndex_t* index, const void* array, size_t elemSize, FwPrCounterS1_t n,
+                         const void* nullKey);
+
+/**
+ * Look for a function pointer in the hash table of an action or guard array.
+ * @param index the hash table
+ * @param array the action or guard array
+ * @param elemSize the size of the elements of the array
+ * @param key the address of the function pointer
+ * @return the entry of the hash table which holds the function pointer or, if the function
+ * pointer is not in the hash table, the empty entry where it can be inserted
+ */
+static FwPrCounterU4_t ProbeIndex(PrFuncIndex_t* index, const void* array, size_t elemSize, const void* key);
+
+/**
+ * Insert a location of an action or guard array in its hash table.
+ * If the function pointer at the location is already in the hash table, the hash table
+ * keeps the smaller of the two locations.
+ * @param index the hash table
+ * @param array the action or guard array
+ * @param elemSize the size of the elements of the array
+ * @param loc the location of the array
+ */
+static void InsertInIndex(PrFuncIndex_t* index, const void* array, size_t elemSize, FwPrCounterS1_t loc);
+
+/**
+ * Update the hash table of an action or guard array after the function pointer held in
+ * one of its entries has been overwritten with a non-NULL function pointer.
+ * @param index the hash table
+ * @param array the action or guard array (the location has already been overwritten)
+ * @param elemSize the size of the elements of the array
+ * @param pos the entry of the hash table which holds the overwritten location
+ * @param oldKey the address of the overwritten function pointer
+ */
+static void ReplaceInIndex(PrFuncIndex_t* index, const void* array, size_t elemSize, FwPrCounterU4_t pos,
+                           const void* oldKey);
+
 /* ----------------------------------------------------------------------------------------------------------------- */
 void FwPrSetData(FwPrDesc_t prDesc, void* prData) {
   prDesc->prData = prData;
@@ -127,6 +272,9 @@ void FwPrAddActionNode(FwPrDesc_t prDesc, FwPrCounterS1_t nodeId, FwPrAction_t a
 
   aNode->iAction = AddAction(prDesc, action);
 
+  /* The execution table (if any) is no longer up-to-date */
+  prBase->isCompiled = 0;
+
   return;
 }
 
@@ -168,6 +316,9 @@ void FwPrAddDecisionNode(FwPrDesc_t prDesc, FwPrCounterS1_t nodeId, FwPrCounterS
 
   dNode->nOfOutTrans = nOfOutFlows;
 
+  /* The execution table (if any) is no longer up-to-date */
+  prBase->isCompiled = 0;
+
   return;
 }
 
@@ -286,12 +437,36 @@ static void AddFlow(FwPrDesc_t prDesc, FwPrCounterS1_t srcId, NodeType_t srcType
   /* add guard to control flow descriptor */
   flow->iGuard = AddGuard(prDesc, cfGuard);
 
+  /* The execution table (if any) is no longer up-to-date */
+  prBase->isCompiled = 0;
+
   return;
 }
 
 /* ----------------------------------------------------------------------------------------------------------------- */
 static FwPrCounterS1_t AddAction(FwPrDesc_t prDesc, FwPrAction_t action) {
   FwPrCounterS1_t i;
+  PrCfgIndex_t*   cfgIndex;
+  FwPrCounterU4_t pos;
+  FwPrAction_t    nullAction = NULL;
+
+  cfgIndex = GetCfgIndex(prDesc);
+  if (cfgIndex != NULL) {
+    pos = ProbeIndex(&(cfgIndex->actions), prDesc->prActions, sizeof(FwPrAction_t), &action);
+    if (cfgIndex->actions.table[pos] != -1) {
+      return cfgIndex->actions.table[pos];
+    }
+    i = cfgIndex->actions.next;
+    if (i < prDesc->nOfActions) {
+      prDesc->prActions[i]         = action;
+      cfgIndex->actions.table[pos] = i;
+      cfgIndex->actions.next       = (FwPrCounterS1_t)(i + 1);
+      AdvanceIndex(&(cfgIndex->actions), prDesc->prActions, sizeof(FwPrAction_t), prDesc->nOfActions, &nullAction);
+      return i;
+    }
+    prDesc->errCode = prTooManyActions;
+    return 0;
+  }
 
   for (i = 0; i < prDesc->nOfActions; i++) {
     if (prDesc->prActions[i] == NULL) {
@@ -314,11 +489,32 @@ static FwPrCounterS1_t AddAction(FwPrDesc_t prDesc, FwPrAction_t action) {
 /* ----------------------------------------------------------------------------------------------------------------- */
 static FwPrCounterS1_t AddGuard(FwPrDesc_t prDesc, FwPrGuard_t guard) {
   FwPrCounterS1_t i;
+  PrCfgIndex_t*   cfgIndex;
+  FwPrCounterU4_t pos;
+  FwPrGuard_t     nullGuard = NULL;
 
   if (guard == NULL) {
     return 0;
   }
 
+  cfgIndex = GetCfgIndex(prDesc);
+  if (cfgIndex != NULL) {
+    pos = ProbeIndex(&(cfgIndex->guards), prDesc->prGuards, sizeof(FwPrGuard_t), &guard);
+    if (cfgIndex->guards.table[pos] != -1) {
+      return cfgIndex->guards.table[pos];
+    }
+    i = cfgIndex->guards.next;
+    if (i < prDesc->nOfGuards) {
+      prDesc->prGuards[i]         = guard;
+      cfgIndex->guards.table[pos] = i;
+      cfgIndex->guards.next       = (FwPrCounterS1_t)(i + 1);
+      AdvanceIndex(&(cfgIndex->guards), prDesc->prGuards, sizeof(FwPrGuard_t), prDesc->nOfGuards, &nullGuard);
+      return i;
+    }
+    prDesc->errCode = prTooManyGuards;
+    return 0;
+  }
+
   for (i = 1; i < prDesc->nOfGuards; i++) {
     if (prDesc->prGuards[i] == NULL) {
       break;
@@ -340,9 +536,9 @@ static FwPrCounterS1_t AddGuard(FwPrDesc_t prDesc, FwPrGuard_t guard) {
 /* ----------------------------------------------------------------------------------------------------------------- */
 FwPrErrCode_t FwPrCheck(FwPrDesc_t prDesc) {
 
-  FwPrCounterS1_t i, j;
+  FwPrCounterS1_t i;
   PrBaseDesc_t*   prBase = prDesc->prBase;
-  FwPrBool_t      found;
+  FwPrErrCode_t   outcome;
 
   /* Check that no error occurred during the configuration process */
   if (prDesc->errCode != prSuccess) {
@@ -394,47 +590,228 @@ FwPrErrCode_t FwPrCheck(FwPrDesc_t prDesc) {
     }
   }
 
-  /* Check that all action nodes are reachable */
-  for (i = 1; i <= prBase->nOfANodes; i++) {
-    found = 0;
-    for (j = 0; j < prBase->nOfFlows; j++) {
-      if (prBase->flows[j].dest == i) {
-        found = 1;
-        break;
-      }
+  /* Check that all action nodes and decision nodes are reachable */
+  outcome = CheckReachability(prDesc);
+  if (outcome != prSuccess) {
+    return outcome;
+  }
+
+  /* The configuration index is no longer needed once the configuration is complete */
+  free(prDesc->cfgIndex);
+  prDesc->cfgIndex = NULL;
+
+  return prSuccess;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+FwPrErrCode_t FwPrCompile(FwPrDesc_t prDesc) {
+  FwPrErrCode_t   outcome;
+  FwPrCounterS1_t i, dest;
+  PrBaseDesc_t*   prBase = prDesc->prBase;
+  PrExecFlow_t*   execFlow;
+
+  outcome = FwPrCheck(prDesc);
+  if (outcome != prSuccess) {
+    return outcome;
+  }
+
+  /* The execution table is still valid (it may be in a read-only image, see FwPrLoadImage) */
+  if (prBase->isCompiled) {
+    return prSuccess;
+  }
+
+  if (prBase->execFlows == NULL) {
+    prBase->execFlows = (PrExecFlow_t*)malloc(((FwPrCounterU4_t)(prBase->nOfFlows)) * sizeof(PrExecFlow_t));
+    if (prBase->execFlows == NULL) {
+      return prOutOfMemory;
+    }
+  }
+
+  for (i = 0; i < prBase->nOfFlows; i++) {
+    execFlow         = &(prBase->execFlows[i]);
+    dest             = prBase->flows[i].dest;
+    execFlow->dest   = dest;
+    execFlow->iGuard = prBase->flows[i].iGuard;
+    if (dest > 0) { /* destination is an action node */
+      execFlow->iAction = prBase->aNodes[dest - 1].iAction;
+      execFlow->iNext   = prBase->aNodes[dest - 1].iFlow;
+      execFlow->nOfNext = 1;
+    }
+    else if (dest < 0) { /* destination is a decision node */
+      execFlow->iAction = 0;
+      execFlow->iNext   = prBase->dNodes[(-dest) - 1].outFlowIndex;
+      execFlow->nOfNext = prBase->dNodes[(-dest) - 1].nOfOutTrans;
     }
-    if (found == 0) {
-      return prUnreachableANode;
+    else { /* destination is the final node */
+      execFlow->iAction = 0;
+      execFlow->iNext   = 0;
+      execFlow->nOfNext = 0;
     }
   }
 
-  /* Check that all decision nodes are reachable */
-  for (i = 1; i <= prBase->nOfDNodes; i++) {
-    found = 0;
-    for (j = 0; j < prBase->nOfFlows; j++) {
-      if (prBase->flows[j].dest == -i) {
-        found = 1;
-        break;
+  prBase->isCompiled = 1;
+  return prSuccess;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+static FwPrBool_t UnshareArrays(FwPrDesc_t prDesc, FwPrCounterU1_t arrays) {
+  FwPrAction_t* prActions;
+  FwPrGuard_t*  prGuards;
+
+  arrays = (FwPrCounterU1_t)(arrays & prDesc->shared);
+
+  if ((arrays & PR_SHARED_ACTIONS) != 0) {
+    prActions = (FwPrAction_t*)malloc(((FwPrCounterU4_t)(prDesc->nOfActions)) * sizeof(FwPrAction_t));
+    if (prActions == NULL) {
+      prDesc->errCode = prOutOfMemory;
+      return 0;
+    }
+    memcpy(prActions, prDesc->prActions, ((FwPrCounterU4_t)(prDesc->nOfActions)) * sizeof(FwPrAction_t));
+    prDesc->prActions = prActions;
+    prDesc->shared    = (FwPrCounterU1_t)(prDesc->shared & ~PR_SHARED_ACTIONS);
+  }
+
+  if ((arrays & PR_SHARED_GUARDS) != 0) {
+    prGuards = (FwPrGuard_t*)malloc(((FwPrCounterU4_t)(prDesc->nOfGuards)) * sizeof(FwPrGuard_t));
+    if (prGuards == NULL) {
+      prDesc->errCode = prOutOfMemory;
+      return 0;
+    }
+    memcpy(prGuards, prDesc->prGuards, ((FwPrCounterU4_t)(prDesc->nOfGuards)) * sizeof(FwPrGuard_t));
+    prDesc->prGuards = prGuards;
+    prDesc->shared   = (FwPrCounterU1_t)(prDesc->shared & ~PR_SHARED_GUARDS);
+  }
+
+  return 1;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+static FwPrErrCode_t CheckReachability(FwPrDesc_t prDesc) {
+  PrBaseDesc_t*    prBase   = prDesc->prBase;
+  FwPrCounterU4_t  nOfNodes = (FwPrCounterU4_t)prBase->nOfANodes + (FwPrCounterU4_t)prBase->nOfDNodes;
+  FwPrCounterU4_t  mapSize  = (nOfNodes + 7) / 8;
+  FwPrCounterU4_t  localStack[PR_CHECK_LOCAL_NODES];
+  unsigned char    localMap[PR_CHECK_LOCAL_NODES / 8];
+  FwPrCounterU4_t* stack      = localStack;
+  unsigned char*   map        = localMap;
+  FwPrCounterU4_t  nOfStacked = 0;
+  FwPrCounterU4_t  node;
+  FwPrCounterS1_t  i, first, last;
+  FwPrErrCode_t    outcome = prSuccess;
+
+  if (nOfNodes > PR_CHECK_LOCAL_NODES) {
+    stack = (FwPrCounterU4_t*)malloc(nOfNodes * sizeof(FwPrCounterU4_t) + mapSize);
+    if (stack == NULL) {
+      return prOutOfMemory;
+    }
+    map = (unsigned char*)(stack + nOfNodes);
+  }
+
+  /* Mark all nodes which are the destination of at least one control flow */
+  memset(map, 0, mapSize);
+  for (i = 0; i < prBase->nOfFlows; i++) {
+    (void)MarkDest(prBase, map, prBase->flows[i].dest, &node);
+  }
+  for (node = 0; node < nOfNodes; node++) {
+    if ((map[node / 8] & (1U << (node % 8))) == 0) {
+      outcome = (node < (FwPrCounterU4_t)prBase->nOfANodes) ? prUnreachableANode : prUnreachableDNode;
+      break;
+    }
+  }
+
+  /* Mark all nodes which can be reached from the initial node (i.e. from the destination
+   * of the control flow out of the initial node which is stored at location 0) */
+  if (outcome == prSuccess) {
+    memset(map, 0, mapSize);
+    if (MarkDest(prBase, map, prBase->flows[0].dest, &node) == 1) {
+      stack[nOfStacked++] = node;
+    }
+    while (nOfStacked > 0) {
+      node = stack[--nOfStacked];
+      if (node < (FwPrCounterU4_t)prBase->nOfANodes) {
+        first = prBase->aNodes[node].iFlow;
+        last  = (FwPrCounterS1_t)(first + 1);
+      }
+      else {
+        first = prBase->dNodes[node - (FwPrCounterU4_t)prBase->nOfANodes].outFlowIndex;
+        last  = (FwPrCounterS1_t)(first + prBase->dNodes[node - (FwPrCounterU4_t)prBase->nOfANodes].nOfOutTrans);
+      }
+      for (i = first; i < last; i++) {
+        if (MarkDest(prBase, map, prBase->flows[i].dest, &node) == 1) {
+          stack[nOfStacked++] = node;
+        }
       }
     }
-    if (found == 0) {
-      return prUnreachableDNode;
+    for (node = 0; node < nOfNodes; node++) {
+      if ((map[node / 8] & (1U << (node % 8))) == 0) {
+        outcome = (node < (FwPrCounterU4_t)prBase->nOfANodes) ? prDisconnectedANode : prDisconnectedDNode;
+        break;
+      }
     }
   }
 
-  return prSuccess;
+  if (stack != localStack) {
+    free(stack);
+  }
+  return outcome;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+static FwPrBool_t MarkDest(PrBaseDesc_t* prBase, unsigned char* map, FwPrCounterS1_t dest, FwPrCounterU4_t* node) {
+  unsigned char bit;
+
+  if (dest == 0) { /* the final node is not a node of the bitmap */
+    return 0;
+  }
+  if (dest > 0) {
+    *node = (FwPrCounterU4_t)(dest - 1);
+  }
+  else {
+    *node = (FwPrCounterU4_t)prBase->nOfANodes + (FwPrCounterU4_t)(-dest - 1);
+  }
+
+  bit = (unsigned char)(1U << (*node % 8));
+  if ((map[*node / 8] & bit) != 0) {
+    return 0;
+  }
+  map[*node / 8] = (unsigned char)(map[*node / 8] | bit);
+  return 1;
 }
 
 /* ----------------------------------------------------------------------------------------------------------------- */
 void FwPrOverrideAction(FwPrDesc_t prDesc, FwPrAction_t oldAction, FwPrAction_t newAction) {
-  FwPrCounterS1_t i;
+  FwPrCounterS1_t i = 0;
+  PrCfgIndex_t*   cfgIndex;
+  FwPrCounterU4_t pos;
 
   if (prDesc->flowCnt != 0) {
     prDesc->errCode = prNotDerivedPr;
     return;
   }
 
-  for (i = 0; i < prDesc->nOfActions; i++) {
+  if (UnshareArrays(prDesc, PR_SHARED_ACTIONS) == 0) {
+    return;
+  }
+
+  cfgIndex = GetCfgIndex(prDesc);
+  if ((cfgIndex != NULL) && (oldAction != NULL)) {
+    pos = ProbeIndex(&(cfgIndex->actions), prDesc->prActions, sizeof(FwPrAction_t), &oldAction);
+    if (cfgIndex->actions.table[pos] != -1) {
+      prDesc->prActions[cfgIndex->actions.table[pos]] = newAction;
+      if (newAction == NULL) { /* the array now has a hole: the index is rebuilt when it is next needed */
+        free(prDesc->cfgIndex);
+        prDesc->cfgIndex = NULL;
+      }
+      else {
+        ReplaceInIndex(&(cfgIndex->actions), prDesc->prActions, sizeof(FwPrAction_t), pos, &oldAction);
+      }
+      return;
+    }
+    /* Only the locations after the first NULL location are not in the index */
+    i = cfgIndex->actions.next;
+  }
+
+  for (; i < prDesc->nOfActions; i++) {
     if (prDesc->prActions[i] == oldAction) {
       prDesc->prActions[i] = newAction;
       return;
@@ -446,19 +823,307 @@ void FwPrOverrideAction(FwPrDesc_t prDesc, FwPrAction_t oldAction, FwPrAction_t
 
 /* ----------------------------------------------------------------------------------------------------------------- */
 void FwPrOverrideGuard(FwPrDesc_t prDesc, FwPrGuard_t oldGuard, FwPrGuard_t newGuard) {
-  FwPrCounterS1_t i;
+  FwPrCounterS1_t i = 1;
+  PrCfgIndex_t*   cfgIndex;
+  FwPrCounterU4_t pos;
 
   if (prDesc->flowCnt != 0) {
     prDesc->errCode = prNotDerivedPr;
     return;
   }
 
-  for (i = 1; i < prDesc->nOfGuards; i++) {
+  if (UnshareArrays(prDesc, PR_SHARED_GUARDS) == 0) {
+    return;
+  }
+
+  cfgIndex = GetCfgIndex(prDesc);
+  if ((cfgIndex != NULL) && (oldGuard != NULL)) {
+    pos = ProbeIndex(&(cfgIndex->guards), prDesc->prGuards, sizeof(FwPrGuard_t), &oldGuard);
+    if (cfgIndex->guards.table[pos] != -1) {
+      prDesc->prGuards[cfgIndex->guards.table[pos]] = newGuard;
+      ForgetGuard(prDesc, cfgIndex->guards.table[pos]);
+      if (newGuard == NULL) { /* the array now has a hole: the index is rebuilt when it is next needed */
+        free(prDesc->cfgIndex);
+        prDesc->cfgIndex = NULL;
+      }
+      else {
+        ReplaceInIndex(&(cfgIndex->guards), prDesc->prGuards, sizeof(FwPrGuard_t), pos, &oldGuard);
+      }
+      return;
+    }
+    /* Only the locations after the first NULL location are not in the index */
+    i = cfgIndex->guards.next;
+  }
+
+  for (; i < prDesc->nOfGuards; i++) {
     if (prDesc->prGuards[i] == oldGuard) {
       prDesc->prGuards[i] = newGuard;
+      ForgetGuard(prDesc, i);
       return;
     }
   }
 
   prDesc->errCode = prUndefGuard;
 }
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+FwPrErrCode_t FwPrSetGuardPure(FwPrDesc_t prDesc, FwPrGuard_t guard, FwPrBool_t isPure) {
+  FwPrCounterS1_t i;
+  FwPrBool_t      isFound = 0;
+
+  /* Location 0 holds the dummy guard which is never marked */
+  for (i = 1; i < prDesc->nOfGuards; i++) {
+    if ((prDesc->prGuards[i] == guard) && (guard != NULL)) {
+      isFound = 1;
+    }
+  }
+  if (isFound == 0) {
+    return prUndefGuard;
+  }
+
+  /* The guard memo is only allocated when a guard is first marked as pure */
+  if ((isPure != 0) && (GetGuardMemo(prDesc) == NULL)) {
+    return prOutOfMemory;
+  }
+
+  /* The same guard may be held in more than one location of a derived procedure */
+  for (i = 1; i < prDesc->nOfGuards; i++) {
+    if (prDesc->prGuards[i] == guard) {
+      MarkGuardPure(prDesc, i, isPure);
+    }
+  }
+  return prSuccess;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+static void MarkGuardPure(FwPrDesc_t prDesc, FwPrCounterS1_t iGuard, FwPrBool_t isPure) {
+  PrGuardMemo_t*  memo  = prDesc->memo;
+  FwPrCounterU4_t iByte = ((FwPrCounterU4_t)iGuard) / 8;
+  FwPrCounterU1_t bit   = (FwPrCounterU1_t)(1U << (((FwPrCounterU4_t)iGuard) % 8));
+
+  if (memo == NULL) {
+    return;
+  }
+  if (isPure != 0) {
+    memo->pure[iByte] = (FwPrCounterU1_t)(memo->pure[iByte] | bit);
+  }
+  else {
+    memo->pure[iByte] = (FwPrCounterU1_t)(memo->pure[iByte] & ~bit);
+  }
+  memo->cached[iByte] = (FwPrCounterU1_t)(memo->cached[iByte] & ~bit);
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+FwPrErrCode_t FwPrSetGuardDecl(FwPrDesc_t prDesc, FwPrGuard_t guard, FwPrGuardOpnd_t opnd, FwPrCounterU4_t offset,
+                               FwPrGuardOp_t op, long value) {
+  FwPrCounterS1_t i;
+  PrGuardMemo_t*  memo    = prDesc->memo;
+  FwPrBool_t      isFound = 0;
+
+  /* Location 0 holds the dummy guard which is never declared */
+  for (i = 1; i < prDesc->nOfGuards; i++) {
+    if ((prDesc->prGuards[i] == guard) && (guard != NULL)) {
+      isFound = 1;
+    }
+  }
+  if (isFound == 0) {
+    return prUndefGuard;
+  }
+
+  /* The guard memo is only allocated when a guard is first declared */
+  if (opnd != prGuardOpndNone) {
+    memo = GetGuardMemo(prDesc);
+    if (memo == NULL) {
+      return prOutOfMemory;
+    }
+  }
+  if (memo == NULL) {
+    return prSuccess;
+  }
+
+  /* The same guard may be held in more than one location of a derived procedure */
+  for (i = 1; i < prDesc->nOfGuards; i++) {
+    if (prDesc->prGuards[i] == guard) {
+      memo->decl[i].opnd   = opnd;
+      memo->decl[i].op     = op;
+      memo->decl[i].offset = offset;
+      memo->decl[i].value  = value;
+    }
+  }
+  return prSuccess;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+static PrGuardMemo_t* GetGuardMemo(FwPrDesc_t prDesc) {
+  PrGuardMemo_t*  memo;
+  FwPrCounterU4_t nOfGuards = (FwPrCounterU4_t)(prDesc->nOfGuards);
+  FwPrCounterU4_t nOfBytes  = (nOfGuards + 7) / 8;
+  FwPrCounterU4_t i;
+
+  if (prDesc->memo != NULL) {
+    return prDesc->memo;
+  }
+
+  /* The declarations follow the memo structure and the bitmasks follow the declarations */
+  memo = (PrGuardMemo_t*)malloc(sizeof(PrGuardMemo_t) + nOfGuards * sizeof(PrGuardDecl_t) + 3 * nOfBytes);
+  if (memo == NULL) {
+    return NULL;
+  }
+  memo->decl     = (PrGuardDecl_t*)(void*)(memo + 1);
+  memo->pure     = (FwPrCounterU1_t*)(void*)(memo->decl + nOfGuards);
+  memo->cached   = memo->pure + nOfBytes;
+  memo->value    = memo->cached + nOfBytes;
+  memo->nOfBytes = nOfBytes;
+  memo->isCached = 0;
+  memset(memo->pure, 0, 3 * nOfBytes);
+  for (i = 0; i < nOfGuards; i++) {
+    memo->decl[i].opnd   = prGuardOpndNone;
+    memo->decl[i].op     = prGuardEq;
+    memo->decl[i].offset = 0;
+    memo->decl[i].value  = 0;
+  }
+  prDesc->memo = memo;
+  return memo;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+static void ForgetGuard(FwPrDesc_t prDesc, FwPrCounterS1_t iGuard) {
+  MarkGuardPure(prDesc, iGuard, 0);
+  if (prDesc->memo != NULL) {
+    prDesc->memo->decl[iGuard].opnd = prGuardOpndNone;
+  }
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+static PrCfgIndex_t* GetCfgIndex(FwPrDesc_t prDesc) {
+  PrCfgIndex_t*   cfgIndex;
+  FwPrCounterU4_t actSize = 1;
+  FwPrCounterU4_t grdSize = 1;
+  FwPrCounterU4_t i;
+  FwPrAction_t    nullAction = NULL;
+  FwPrGuard_t     nullGuard  = NULL;
+
+  if (prDesc->cfgIndex != NULL) {
+    return prDesc->cfgIndex;
+  }
+  if ((prDesc->nOfActions + prDesc->nOfGuards) < FW_PR_CFG_INDEX_MIN) {
+    return NULL;
+  }
+
+  /* The hash tables are at most half full */
+  while (actSize < 2 * (FwPrCounterU4_t)(prDesc->nOfActions)) {
+    actSize = 2 * actSize;
+  }
+  while (grdSize < 2 * (FwPrCounterU4_t)(prDesc->nOfGuards)) {
+    grdSize = 2 * grdSize;
+  }
+  cfgIndex = (PrCfgIndex_t*)malloc(sizeof(PrCfgIndex_t) + (actSize + grdSize) * sizeof(FwPrCounterS1_t));
+  if (cfgIndex == NULL) {
+    return NULL;
+  }
+
+  cfgIndex->actions.table = (FwPrCounterS1_t*)(void*)(cfgIndex + 1);
+  cfgIndex->guards.table  = cfgIndex->actions.table + actSize;
+  for (i = 0; i < actSize + grdSize; i++) {
+    cfgIndex->actions.table[i] = -1;
+  }
+  cfgIndex->actions.size   = actSize;
+  cfgIndex->actions.first  = 0;
+  cfgIndex->actions.next   = 0;
+  cfgIndex->actions.hasDup = 0;
+  cfgIndex->guards.size    = grdSize;
+  cfgIndex->guards.first   = 1;
+  cfgIndex->guards.next    = 1;
+  cfgIndex->guards.hasDup  = 0;
+  AdvanceIndex(&(cfgIndex->actions), prDesc->prActions, sizeof(FwPrAction_t), prDesc->nOfActions, &nullAction);
+  AdvanceIndex(&(cfgIndex->guards), prDesc->prGuards, sizeof(FwPrGuard_t), prDesc->nOfGuards, &nullGuard);
+
+  prDesc->cfgIndex = cfgIndex;
+  return cfgIndex;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+static FwPrCounterU4_t HashFunc(const void* key, size_t size) {
+  const unsigned char* bytes = (const unsigned char*)key;
+  FwPrCounterU4_t      hash  = 2166136261UL; /* FNV-1a hash of the bytes of the function pointer */
+  size_t               i;
+
+  for (i = 0; i < size; i++) {
+    hash = (hash ^ bytes[i]) * 16777619UL;
+  }
+  return hash;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+static void AdvanceIndex(PrFuncIndex_t* index, const void* array, size_t elemSize, FwPrCounterS1_t n,
+                         const void* nullKey) {
+  const unsigned char* base = (const unsigned char*)array;
+
+  while ((index->next < n) && (memcmp(base + ((size_t)index->next) * elemSize, nullKey, elemSize) != 0)) {
+    InsertInIndex(index, array, elemSize, index->next);
+    index->next++;
+  }
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+static FwPrCounterU4_t ProbeIndex(PrFuncIndex_t* index, const void* array, size_t elemSize, const void* key) {
+  const unsigned char* base = (const unsigned char*)array;
+  FwPrCounterU4_t      mask = index->size - 1;
+  FwPrCounterU4_t      pos  = HashFunc(key, elemSize) & mask;
+
+  while ((index->table[pos] != -1) && (memcmp(base + ((size_t)index->table[pos]) * elemSize, key, elemSize) != 0)) {
+    pos = (pos + 1) & mask;
+  }
+  return pos;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+static void InsertInIndex(PrFuncIndex_t* index, const void* array, size_t elemSize, FwPrCounterS1_t loc) {
+  const unsigned char* base = (const unsigned char*)array;
+  FwPrCounterU4_t      pos  = ProbeIndex(index, array, elemSize, base + ((size_t)loc) * elemSize);
+
+  if (index->table[pos] == -1) {
+    index->table[pos] = loc;
+  }
+  else {
+    index->hasDup = 1;
+    if (loc < index->table[pos]) {
+      index->table[pos] = loc;
+    }
+  }
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+static void ReplaceInIndex(PrFuncIndex_t* index, const void* array, size_t elemSize, FwPrCounterU4_t pos,
+                           const void* oldKey) {
+  const unsigned char* base = (const unsigned char*)array;
+  FwPrCounterU4_t      mask = index->size - 1;
+  FwPrCounterU4_t      next = (pos + 1) & mask;
+  FwPrCounterU4_t      home;
+  FwPrCounterS1_t      loc = index->table[pos];
+  FwPrCounterS1_t      i;
+
+  /* Remove the entry and move back the entries after it which would no longer be found */
+  index->table[pos] = -1;
+  while (index->table[next] != -1) {
+    home = HashFunc(base + ((size_t)index->table[next]) * elemSize, elemSize) & mask;
+    if (((pos - home) & mask) < ((next - home) & mask)) {
+      index->table[pos]  = index->table[next];
+      index->table[next] = -1;
+      pos                = next;
+    }
+    next = (next + 1) & mask;
+  }
+
+  /* If the old function pointer may be stored in a later location, that location is now its first one */
+  if (index->hasDup != 0) {
+    for (i = (FwPrCounterS1_t)(loc + 1); i < index->next; i++) {
+      if (memcmp(base + ((size_t)i) * elemSize, oldKey, elemSize) == 0) {
+        InsertInIndex(index, array, elemSize, i);
+        break;
+      }
+    }
+  }
+
+  InsertInIndex(index, array, elemSize, loc);
+}
@@ -27,6 +27,10 @@
  *    functions, one for each type of control flow source and destination).
  * -# The pointer to the procedure data in the procedure descriptor
  *    is set with the <code>::FwPrSetData</code> function.
+ * -# The guards of the procedure may be marked as pure with the
+ *    <code>::FwPrSetGuardPure</code> function. Use of this function is optional.
+ * -# The guards of the procedure may be declared as comparisons with the
+ *    <code>::FwPrSetGuardDecl</code> function. Use of this function is optional.
  * -# The consistency and completeness of the procedure configuration may
  *    optionally be verified with function <code>::FwPrCheck</code>.
  * .
@@ -39,6 +43,8 @@
  * -# An action can be overridden
  *    with the <code>::FwPrOverrideAction</code> function.
  * -# A guard can be overridden with the <code>::FwPrOverrideGuard</code> function.
+ * -# A guard can be marked as pure with the <code>::FwPrSetGuardPure</code> function.
+ * -# A guard can be declared as a comparison with the <code>::FwPrSetGuardDecl</code> function.
  * -# The consistency and completeness of the configuration of the derived
  *    procedure may optionally be verified with function <code>::FwPrCheck</code>.
  * .
@@ -356,6 +362,8 @@ void FwPrAddFlowDecToFin(FwPrDesc_t prDesc, FwPrCounterS1_t srcId, FwPrGuard_t c
  *    control flow).
  * -# Check that all decision nodes are reachable (i.e. they are a destination for a
  *    control flow).
+ * -# Check that all action nodes can be reached from the initial node.
+ * -# Check that all decision nodes can be reached from the initial node.
  * .
  * Note that there are configuration errors which are not covered by this function because
  * they cannot occur if the procedure is configured using the functions declared in
@@ -373,12 +381,57 @@ void FwPrAddFlowDecToFin(FwPrDesc_t prDesc, FwPrCounterS1_t srcId, FwPrGuard_t c
  * - #prTooFewGuards: check 8 has failed
  * - #prUnreachableANode: check 9 has failed
  * - #prUnreachableDNode: check 10 has failed
+ * - #prDisconnectedANode: check 11 has failed
+ * - #prDisconnectedDNode: check 12 has failed
+ * - #prOutOfMemory: the procedure has more than 64 action and decision nodes and the
+ *   memory for checks 9 to 12 could not be allocated
  * .
  * This function returns when it encounters the first error. Hence, the function return value
  * is determined by the first error encountered by the function.
  */
 FwPrErrCode_t FwPrCheck(FwPrDesc_t prDesc);
 
+/**
+ * Check the configuration of a procedure and build its execution table.
+ * This function first checks the procedure configuration with function
+ * <code>::FwPrCheck</code>.
+ * If the check is successful, the function builds the execution table of the
+ * procedure (see <code>::PrExecFlow_t</code>) and marks the procedure as "compiled".
+ * The execution table holds the control flows of the procedure in a form which
+ * allows <code>::FwPrExecute</code> and <code>::FwPrExecuteBudget</code> to:
+ * - take a control flow which has no guard without calling the dummy guard;
+ * - go from a control flow to the control flows out of its destination without
+ *   accessing the action node or decision node arrays (in particular, chains of
+ *   decision nodes are traversed from table entry to table entry).
+ * .
+ * The order in which the guards of the control flows out of a decision node are
+ * evaluated is not affected.
+ * Hence, a compiled procedure has the same behaviour as a non-compiled one.
+ * The execution table is not used while profiling is enabled on a procedure (see
+ * <code>::FwPrEnableProfile</code>).
+ *
+ * The execution table is part of the base descriptor of the procedure.
+ * Calling this function on a derived procedure therefore compiles the base
+ * procedure and all the other procedures derived from it.
+ * If the procedure descriptor was created dynamically, the execution table is
+ * allocated by this function (if it was not already allocated) and it is released
+ * by <code>::FwPrRelease</code>.
+ * If the procedure descriptor was instantiated statically, the execution table
+ * is allocated by the instantiation macro.
+ *
+ * Use of this function is optional.
+ * It should be called after the configuration of the procedure has been completed.
+ * If, after the procedure has been compiled, a node or control flow is added to it,
+ * the procedure reverts to the non-compiled mode and must be compiled again.
+ * @param prDesc the descriptor of the procedure to be compiled.
+ * @return the outcome of the compilation. This is either the outcome of
+ * <code>::FwPrCheck</code> (if the check failed) or:
+ * - #prSuccess: the procedure has been compiled.
+ * - #prOutOfMemory: the memory for the execution table could not be allocated.
+ * .
+ */
+FwPrErrCode_t FwPrCompile(FwPrDesc_t prDesc);
+
 /**
  * Override an action in a derived procedure.
  * By default a derived procedure has the same actions as the base procedure
@@ -445,4 +498,98 @@ void FwPrOverrideAction(FwPrDesc_t prDesc, FwPrAction_t oldAction, FwPrAction_t
  */
 void FwPrOverrideGuard(FwPrDesc_t prDesc, FwPrGuard_t oldGuard, FwPrGuard_t newGuard);
 
+/**
+ * Mark a guard of a procedure as pure (or remove the mark).
+ * A guard is pure if its outcome only depends on data which are not modified
+ * while the procedure is executed, except by the actions of the procedure itself.
+ * The outcome of a pure guard is cached when the guard is first evaluated
+ * during an execution of the procedure (see <code>::FwPrExecute</code>) and the
+ * cached outcome is used if the same guard is evaluated again before the next
+ * action node is executed, for instance because it is attached both to the
+ * control flow into a decision node and to one of the control flows out of the
+ * decision node or because it is attached to control flows out of successive
+ * decision nodes.
+ * The cached outcomes are discarded when an action node is executed and when
+ * a new execution of the procedure is started.
+ * Hence, a pure guard is called at most once between two executions of an
+ * action of the procedure.
+ *
+ * The guard outcomes are cached in a <i>guard memo</i> which is attached to the
+ * procedure descriptor.
+ * The guard memo holds three bitmasks with one bit for each guard of the procedure.
+ * It is allocated by this function when a guard is first marked as pure (or by
+ * <code>::FwPrSetGuardDecl</code> when a guard is first declared) and it
+ * is released when the procedure is released.
+ * A procedure where no guard has been marked as pure or declared has no guard memo
+ * and its guards are always called.
+ *
+ * The mark applies to all control flows of the procedure which have the argument
+ * guard.
+ * It only applies to the argument procedure: it is not inherited by the
+ * procedures derived from it.
+ * The mark of a guard is removed when the guard is overridden with
+ * <code>::FwPrOverrideGuard</code>.
+ * Since the procedure must already hold the guard, this function should be
+ * called after the control flows of the procedure have been added.
+ * @param prDesc the descriptor of the procedure.
+ * @param guard the guard to be marked.
+ * @param isPure 1 if the guard is to be marked as pure, 0 if its mark is to be removed.
+ * @return the outcome of the operation:
+ * - #prSuccess: the guard has been marked (or its mark has been removed).
+ * - #prUndefGuard: the guard does not exist in the procedure.
+ * - #prOutOfMemory: the memory for the guard memo could not be allocated.
+ * .
+ */
+FwPrErrCode_t FwPrSetGuardPure(FwPrDesc_t prDesc, FwPrGuard_t guard, FwPrBool_t isPure);
+
+/**
+ * Declare a guard of a procedure as a comparison of an operand with a constant.
+ * Most guards are simple comparisons such as "the field x of the procedure data is
+ * greater than 10" or "the current node has been executed at least N times".
+ * Once such a guard has been declared, the procedure evaluates the comparison
+ * directly instead of calling the guard function.
+ * The declarative guard is true if "operand operator constant" holds where the
+ * operand is one of the following (see <code>::FwPrGuardOpnd_t</code>):
+ * - an <code>int</code> or a <code>long</code> field of the procedure data which is
+ *   located <code>offset</code> bytes after the start of the data (the offset is normally
+ *   obtained with the <code>offsetof</code> macro);
+ * - the node execution counter (see <code>::FwPrGetNodeExecCnt</code>);
+ * - the execution counter of the procedure (see <code>::FwPrGetExecCnt</code>).
+ * .
+ * The guard function remains registered in the procedure and it must implement
+ * the same comparison as the declaration: the declaration is only an optimization and
+ * the functions which do not execute the procedure (e.g. the functions of
+ * <code>FwPrAux.h</code>) continue to use the guard function.
+ * The offset is not checked: the procedure data must hold a field of the declared
+ * type at the declared offset whenever the guard is evaluated.
+ *
+ * The declarations are held in the guard memo of the procedure (see
+ * <code>::FwPrSetGuardPure</code>) which is allocated by this function if it does not
+ * exist.
+ * A declarative guard is evaluated every time it is needed: whether it is also marked
+ * as pure has no effect.
+ * The declaration applies to all control flows of the procedure which have the
+ * argument guard.
+ * It only applies to the argument procedure: it is not inherited by the
+ * procedures derived from it.
+ * The declaration of a guard is removed when the guard is overridden with
+ * <code>::FwPrOverrideGuard</code>.
+ * Since the procedure must already hold the guard, this function should be
+ * called after the control flows of the procedure have been added.
+ * @param prDesc the descriptor of the procedure.
+ * @param guard the guard to be declared.
+ * @param opnd the operand of the guard (#prGuardOpndNone removes the declaration of the guard).
+ * @param offset the offset in bytes of the operand in the procedure data (this is
+ * only used if the operand is a field of the procedure data).
+ * @param op the comparison operator.
+ * @param value the constant against which the operand is compared.
+ * @return the outcome of the operation:
+ * - #prSuccess: the guard has been declared (or its declaration has been removed).
+ * - #prUndefGuard: the guard does not exist in the procedure.
+ * - #prOutOfMemory: the memory for the guard memo could not be allocated.
+ * .
+ */
+FwPrErrCode_t FwPrSetGuardDecl(FwPrDesc_t prDesc, FwPrGuard_t guard, FwPrGuardOpnd_t opnd, FwPrCounterU4_t offset,
+                               FwPrGuardOp_t op, long value);
+
 #endif /* FWPR_CONFIG_H_ */
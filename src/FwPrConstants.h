@@ -31,6 +31,15 @@
  */
 typedef struct FwPrDesc* FwPrDesc_t;
 
+/**
+ * Forward declaration for the pointer to a procedure pool descriptor.
+ * A procedure pool holds a set of pre-allocated procedures derived from
+ * the same procedure (see <code>FwPrPool.h</code>).
+ * The internal definition of the procedure pool descriptor (see
+ * <code>FwPrPrivate.h</code>) is kept hidden from users.
+ */
+typedef struct FwPrPool* FwPrPoolDesc_t;
+
 /**
  * Type for a pointer to a procedure action.
  * A procedure action is a function which encapsulates an action of a
@@ -74,8 +83,76 @@ typedef unsigned int FwPrCounterU3_t;
 /** Type used for unsigned counters with a "long int" range. */
 typedef long unsigned int FwPrCounterU4_t;
 
+/**
+ * Type for a pointer to the function which provides the time stamps used by the
+ * profiling mode of a procedure (see <code>::FwPrEnableProfile</code>).
+ * The unit of the time stamps is defined by the user (e.g. processor cycles).
+ */
+typedef FwPrCounterU4_t (*FwPrProfileClock_t)(void);
+
+/**
+ * Width in bits of the signed counters with a "short" range.
+ * The signed counters with a "short" range (type <code>::FwPrCounterS1_t</code>) are
+ * used to hold the number of action nodes, decision nodes, control flows, actions and guards in a procedure and to index them.
+ * Their width therefore determines the maximum size of a procedure.
+ * The width can be selected at build time by defining this symbol as either 8, 16 or 32
+ * (for instance, through the <code>-D</code> option of the compiler).
+ * The default value of 8 bits gives the most compact memory layout and is intended for
+ * small targets.
+ * The library and the applications which use it must be built with the same value.
+ */
+#ifndef FW_PR_INDEX_WIDTH
+#define FW_PR_INDEX_WIDTH 8
+#endif
+
+#if (FW_PR_INDEX_WIDTH == 8)
 /** Type used for signed counters with a "short" range. */
 typedef signed char FwPrCounterS1_t;
+/** Maximum value of a signed counter with a "short" range. */
+#define FW_PR_COUNTER_S1_MAX 127
+#elif (FW_PR_INDEX_WIDTH == 16)
+/** Type used for signed counters with a "short" range. */
+typedef short int FwPrCounterS1_t;
+/** Maximum value of a signed counter with a "short" range. */
+#define FW_PR_COUNTER_S1_MAX 32767
+#elif (FW_PR_INDEX_WIDTH == 32)
+/** Type used for signed counters with a "short" range. */
+typedef int FwPrCounterS1_t;
+/** Maximum value of a signed counter with a "short" range. */
+#define FW_PR_COUNTER_S1_MAX 2147483647
+#else
+#error "FW_PR_INDEX_WIDTH must be either 8, 16 or 32"
+#endif
+
+/**
+ * Minimum size of the action and guard arrays of a procedure for which a
+ * configuration index is used.
+ * The configuration functions which register or override actions and guards
+ * (e.g. <code>::FwPrAddActionNode</code> or <code>::FwPrOverrideAction</code>) must
+ * check whether an action or guard is already present in the procedure.
+ * If the sum of the number of actions and of the number of guards of a procedure
+ * is at least equal to this value, these functions use a hash table which is
+ * allocated with <code>malloc</code> on first use and released when the
+ * configuration of the procedure passes <code>::FwPrCheck</code>.
+ * Otherwise (or if the allocation of the hash table fails), they scan the action
+ * and guard arrays.
+ * The value can be overridden at build time (a very large value disables the hash
+ * table).
+ */
+#ifndef FW_PR_CFG_INDEX_MIN
+#define FW_PR_CFG_INDEX_MIN 32
+#endif
+
+/**
+ * Capacity of the per-thread caches of a thread-safe procedure pool.
+ * A thread which obtains procedures from a thread-safe pool (see
+ * <code>::FwPrPoolCreate</code>) holds up to this number of free procedures
+ * in a cache which it can access without locking the pool.
+ * The value can be overridden at build time.
+ */
+#ifndef FW_PR_POOL_CACHE_SIZE
+#define FW_PR_POOL_CACHE_SIZE 16
+#endif
 
 /** Error codes and function return codes for the procedure functions. */
 typedef enum {
@@ -210,7 +287,98 @@ typedef enum {
   /**
    * The procedure has a decision node which is not a destination of any control flow
    */
-  prUnreachableDNode = 30
+  prUnreachableDNode = 30,
+  /**
+   * The procedure has an action node which is the destination of a control flow but
+   * which cannot be reached from the initial node
+   */
+  prDisconnectedANode = 31,
+  /**
+   * The procedure has a decision node which is the destination of a control flow but
+   * which cannot be reached from the initial node
+   */
+  prDisconnectedDNode = 32,
+  /**
+   * A procedure is returned to a procedure pool but it does not have the same base
+   * descriptor as the procedures in the pool (see <code>::FwPrPoolPut</code>).
+   */
+  prWrongBase = 33,
+  /**
+   * The worst-case cost of a procedure execution is requested without a node budget but
+   * the procedure has a cycle of control flows, or it has a cycle of control flows which
+   * only goes through decision nodes (see <code>::FwPrCostExecute</code>).
+   */
+  prCostUnbounded = 34
 } FwPrErrCode_t;
 
+/**
+ * Type for the cost annotation of a procedure action or guard which is used by the
+ * step cost analysis of the procedure module (see <code>FwPrCost.h</code>).
+ * Each instance associates a cost to a pointer to an action or to a guard (the other
+ * pointer is NULL).
+ * The unit of the cost is defined by the user (e.g. processor cycles or microseconds).
+ */
+typedef struct {
+  /** the pointer to the action (or NULL if the annotation is for a guard) */
+  FwPrAction_t action;
+  /** the pointer to the guard (or NULL if the annotation is for an action) */
+  FwPrGuard_t guard;
+  /** the cost of one execution of the action or guard */
+  FwPrCounterU4_t cost;
+} FwPrCostAnnot_t;
+
+/**
+ * Type for the worst-case cost of an execution of a procedure which is computed by the
+ * step cost analysis of the procedure module (see <code>FwPrCost.h</code>).
+ * Each field is an upper bound of its own: the bounds of different fields may be
+ * reached along different execution paths.
+ */
+typedef struct {
+  /** the maximum number of actions which are executed */
+  FwPrCounterU4_t nOfActions;
+  /** the maximum number of guards which are evaluated (including the dummy guard) */
+  FwPrCounterU4_t nOfGuards;
+  /** the maximum number of action nodes which are entered */
+  FwPrCounterU4_t nOfNodes;
+  /** the maximum sum of the costs of the actions and guards which are executed */
+  FwPrCounterU4_t cost;
+} FwPrCost_t;
+
+/**
+ * Type for the operand of a declarative guard of a procedure (see
+ * <code>::FwPrSetGuardDecl</code>).
+ */
+typedef enum {
+  /** the guard has no declaration (the guard function is called) */
+  prGuardOpndNone = 0,
+  /** an <code>int</code> field of the procedure data */
+  prGuardOpndInt = 1,
+  /** a <code>long</code> field of the procedure data */
+  prGuardOpndLong = 2,
+  /** the node execution counter of the procedure */
+  prGuardOpndNodeExecCnt = 3,
+  /** the execution counter of the procedure */
+  prGuardOpndPrExecCnt = 4
+} FwPrGuardOpnd_t;
+
+/**
+ * Type for the comparison operator of a declarative guard of a procedure (see
+ * <code>::FwPrSetGuardDecl</code>).
+ * The guard is true if "operand operator constant" holds.
+ */
+typedef enum {
+  /** the operand is smaller than the constant */
+  prGuardLt = 0,
+  /** the operand is smaller than or equal to the constant */
+  prGuardLe = 1,
+  /** the operand is equal to the constant */
+  prGuardEq = 2,
+  /** the operand is not equal to the constant */
+  prGuardNe = 3,
+  /** the operand is greater than or equal to the constant */
+  prGuardGe = 4,
+  /** the operand is greater than the constant */
+  prGuardGt = 5
+} FwPrGuardOp_t;
+
 #endif /* FWPR_CONSTANTS_H_ */
@@ -17,7 +17,87 @@
 
 #include "FwPrCore.h"
 #include "FwPrPrivate.h"
+#include "FwTrace.h"
 #include <stdlib.h>
+#include <string.h>
+
+/**
+ *  Private helper function which updates the profiling data of a procedure when
+ *  the procedure leaves its current action node.
+ *  The time elapsed since the entry into the current action node is added to the time
+ *  spent in the node.
+ *  This function should only be called if profiling is enabled on the procedure and
+ *  if the procedure is at an action node.
+ *  @param prDesc the descriptor of the procedure
+ */
+static void PrProfileExit(FwPrDesc_t prDesc);
+
+/**
+ *  Private helper function which updates the profiling data of a procedure after
+ *  the guard of a control flow has been evaluated.
+ *  This function should only be called if profiling is enabled on the procedure.
+ *  @param prDesc the descriptor of the procedure
+ *  @param flow the control flow whose guard has been evaluated
+ *  @param guard the outcome of the guard evaluation
+ */
+static void PrProfileGuard(FwPrDesc_t prDesc, PrFlow_t* flow, FwPrCounterS1_t guard);
+
+/**
+ *  Private helper function which implements the execution of a procedure for
+ *  <code>::FwPrExecute</code> and <code>::FwPrExecuteBudget</code>.
+ *  The execution stops after <code>maxNodes</code> action nodes have been executed
+ *  (or it is not limited if <code>maxNodes</code> is zero).
+ *  @param prDesc the descriptor of the procedure
+ *  @param maxNodes the maximum number of action nodes to be executed (or zero)
+ *  @return 1 if the execution was stopped because the budget was exhausted, 0 otherwise
+ */
+static FwPrBool_t PrExecute(FwPrDesc_t prDesc, FwPrCounterU4_t maxNodes);
+
+/**
+ *  Private helper function which implements the execution of a procedure which has
+ *  been compiled (see <code>::FwPrCompile</code>).
+ *  This function has the same behaviour as <code>::PrExecute</code> but it uses the
+ *  execution table of the procedure.
+ *  It should only be called if the procedure is started and if profiling is disabled.
+ *  @param prDesc the descriptor of the procedure
+ *  @param maxNodes the maximum number of action nodes to be executed (or zero)
+ *  @return 1 if the execution was stopped because the budget was exhausted, 0 otherwise
+ */
+static FwPrBool_t PrExecuteCompiled(FwPrDesc_t prDesc, FwPrCounterU4_t maxNodes);
+
+/**
+ *  Private helper function which evaluates a guard of a procedure which has a
+ *  guard memo (see <code>::FwPrSetGuardPure</code>).
+ *  If the guard has a declaration (see <code>::FwPrSetGuardDecl</code>), the declaration
+ *  is evaluated without calling the guard.
+ *  If the guard is pure and its outcome is cached, the cached outcome is returned
+ *  without calling the guard.
+ *  If the guard is pure and its outcome is not cached, the guard is called and its
+ *  outcome is cached.
+ *  Otherwise, the guard is called.
+ *  This function should only be called if the guard memo of the procedure exists.
+ *  @param prDesc the descriptor of the procedure
+ *  @param iGuard the index of the guard in the guard array of the procedure
+ *  @return the outcome of the guard
+ */
+static FwPrBool_t PrMemoGuard(FwPrDesc_t prDesc, FwPrCounterS1_t iGuard);
+
+/**
+ *  Private helper function which evaluates the declaration of a declarative guard of a
+ *  procedure (see <code>::FwPrSetGuardDecl</code>).
+ *  @param prDesc the descriptor of the procedure
+ *  @param decl the declaration of the guard
+ *  @return the outcome of the guard
+ */
+static FwPrBool_t PrDeclGuard(FwPrDesc_t prDesc, PrGuardDecl_t* decl);
+
+/**
+ *  Private helper function which discards the guard outcomes cached in the guard
+ *  memo of a procedure.
+ *  This function does nothing if the procedure has no guard memo.
+ *  @param prDesc the descriptor of the procedure
+ */
+static void PrMemoClear(FwPrDesc_t prDesc);
 
 /* ----------------------------------------------------------------------------------------------------------------- */
 FwPrBool_t PrDummyGuard(FwPrDesc_t prDesc) {
@@ -31,30 +111,59 @@ void FwPrStart(FwPrDesc_t prDesc) {
     prDesc->curNode     = -1;
     prDesc->prExecCnt   = 0;
     prDesc->nodeExecCnt = 0;
+    prDesc->isSuspended = 0;
   }
 }
 
 /* ----------------------------------------------------------------------------------------------------------------- */
 void FwPrStop(FwPrDesc_t prDesc) {
+  if ((prDesc->profile != NULL) && (prDesc->curNode > 0)) {
+    PrProfileExit(prDesc);
+  }
   prDesc->curNode = 0;
 }
 
 /* ----------------------------------------------------------------------------------------------------------------- */
 void FwPrExecute(FwPrDesc_t prDesc) {
+  FW_TRACE_EVENT(tracePrExecuteCmd, prDesc, 0, 0);
+  (void)PrExecute(prDesc, 0);
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+FwPrBool_t FwPrExecuteBudget(FwPrDesc_t prDesc, FwPrCounterU4_t maxNodes) {
+  return PrExecute(prDesc, maxNodes);
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+static FwPrBool_t PrExecute(FwPrDesc_t prDesc, FwPrCounterU4_t maxNodes) {
   PrANode_t*      curNode;
   PrDNode_t*      decNode;
   PrFlow_t*       flow;
   FwPrCounterS1_t i;
   PrBaseDesc_t*   prBase = prDesc->prBase;
   FwPrCounterS1_t trueGuardFound;
+  FwPrCounterU4_t nOfNodes = 0;
 
   /* check if procedure is started */
   if (prDesc->curNode == 0) { /* procedure is stopped */
-    return;
+    return 0;
   }
 
-  prDesc->prExecCnt++;   /* Increment procedure execution counter */
-  prDesc->nodeExecCnt++; /* Increment node execution counter */
+  /* The guard outcomes cached in earlier executions are discarded */
+  PrMemoClear(prDesc);
+
+  if ((prBase->isCompiled != 0) && (prDesc->profile == NULL)) {
+    return PrExecuteCompiled(prDesc, maxNodes);
+  }
+
+  prDesc->prExecCnt++; /* Increment procedure execution counter */
+
+  /* Increment node execution counter (unless the execution resumes at the node where the budget was exhausted:
+   * the guard out of that node then sees the same counter value as in an execution without budget) */
+  if (prDesc->isSuspended == 0) {
+    prDesc->nodeExecCnt++;
+  }
+  prDesc->isSuspended = 0;
 
   /* Get the Control Flow issuing from the current node */
   if (prDesc->curNode == -1) { /* procedure is at initial node */
@@ -66,14 +175,27 @@ void FwPrExecute(FwPrDesc_t prDesc) {
   }
 
   /* Evaluate guard of control flow issuing from current node */
-  trueGuardFound = (FwPrCounterS1_t)prDesc->prGuards[flow->iGuard](prDesc);
+  trueGuardFound = (FwPrCounterS1_t)((prDesc->memo == NULL) ? prDesc->prGuards[flow->iGuard](prDesc)
+                                                             : PrMemoGuard(prDesc, flow->iGuard));
+  FW_TRACE_EVENT(tracePrGuard, prDesc, flow->dest, trueGuardFound);
+  if (prDesc->profile != NULL) {
+    PrProfileGuard(prDesc, flow, trueGuardFound);
+    if ((trueGuardFound != 0) && (prDesc->curNode > 0)) {
+      PrProfileExit(prDesc);
+    }
+  }
 
   /* Execute loop as long as guard of control flow issuing from current node is true */
   while (trueGuardFound) {
+    if (prDesc->profile != NULL) {
+      prDesc->profile->flowTakenCnt[flow - prBase->flows]++;
+    }
+
     /* Target of flow is a final node */
     if (flow->dest == 0) {
       prDesc->curNode = 0; /* Stop procedure */
-      return;
+      FW_TRACE_EVENT(tracePrFinal, prDesc, 0, 0);
+      return 0;
     }
 
     if (flow->dest > 0) { /* Target of control flow is an action node */
@@ -81,28 +203,234 @@ void FwPrExecute(FwPrDesc_t prDesc) {
       prDesc->nodeExecCnt = 0;
       curNode             = &(prBase->aNodes[(prDesc->curNode) - 1]);
       prDesc->prActions[curNode->iAction](prDesc);
+      PrMemoClear(prDesc);
+      FW_TRACE_EVENT(tracePrNode, prDesc, prDesc->curNode, 0);
+      if (prDesc->profile != NULL) {
+        prDesc->profile->nodeExecCnt[(prDesc->curNode) - 1]++;
+        if (prDesc->profile->clock != NULL) {
+          prDesc->profile->entryTime = prDesc->profile->clock();
+        }
+      }
+      /* Suspend the procedure at the current node if the budget is exhausted */
+      nOfNodes++;
+      if (nOfNodes == maxNodes) {
+        prDesc->isSuspended = 1;
+        return 1;
+      }
       flow           = &(prBase->flows[curNode->iFlow]);
-      trueGuardFound = (FwPrCounterS1_t)prDesc->prGuards[flow->iGuard](prDesc);
+      trueGuardFound = (FwPrCounterS1_t)((prDesc->memo == NULL) ? prDesc->prGuards[flow->iGuard](prDesc)
+                                                                 : PrMemoGuard(prDesc, flow->iGuard));
+      FW_TRACE_EVENT(tracePrGuard, prDesc, flow->dest, trueGuardFound);
+      if (prDesc->profile != NULL) {
+        PrProfileGuard(prDesc, flow, trueGuardFound);
+        if (trueGuardFound != 0) {
+          PrProfileExit(prDesc);
+        }
+      }
     }
     else { /* Target of flow is a decision node */
       trueGuardFound = 0;
       decNode        = &(prBase->dNodes[(-flow->dest) - 1]);
       /* Evaluate guards of control flows issuing from decision node */
       for (i = 0; i < decNode->nOfOutTrans; i++) {
-        flow = &(prBase->flows[decNode->outFlowIndex + i]);
-        if (prDesc->prGuards[flow->iGuard](prDesc) != 0) {
-          trueGuardFound = 1;
+        flow           = &(prBase->flows[decNode->outFlowIndex + i]);
+        trueGuardFound = (FwPrCounterS1_t)((prDesc->memo == NULL) ? prDesc->prGuards[flow->iGuard](prDesc)
+                                                                   : PrMemoGuard(prDesc, flow->iGuard));
+        FW_TRACE_EVENT(tracePrGuard, prDesc, flow->dest, trueGuardFound);
+        if (prDesc->profile != NULL) {
+          PrProfileGuard(prDesc, flow, trueGuardFound);
+        }
+        if (trueGuardFound != 0) {
           break; /* First control flow out of dec. node with true guard */
         }
       }
+      FW_TRACE_EVENT(tracePrDecision, prDesc, (decNode - prBase->dNodes) + 1, (trueGuardFound != 0) ? i : -1);
       /* All control flows out of decision node have false guards */
       if (trueGuardFound == 0) {
         prDesc->errCode = prFlowErr;
-        return;
+        return 0;
       }
     }
   }
-  return;
+  return 0;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+static FwPrBool_t PrExecuteCompiled(FwPrDesc_t prDesc, FwPrCounterU4_t maxNodes) {
+  PrExecFlow_t*   execFlows = prDesc->prBase->execFlows;
+  PrExecFlow_t*   flow;
+  PrExecFlow_t*   decFlow;
+  FwPrCounterS1_t i;
+  FwPrCounterS1_t trueGuardFound;
+  FwPrCounterU4_t nOfNodes = 0;
+
+  prDesc->prExecCnt++; /* Increment procedure execution counter */
+
+  /* Increment node execution counter (unless the execution resumes at the node where the budget was exhausted:
+   * the guard out of that node then sees the same counter value as in an execution without budget) */
+  if (prDesc->isSuspended == 0) {
+    prDesc->nodeExecCnt++;
+  }
+  prDesc->isSuspended = 0;
+
+  /* Get the Control Flow issuing from the current node */
+  if (prDesc->curNode == -1) { /* procedure is at initial node */
+    flow = &(execFlows[0]);
+  }
+  else {
+    flow = &(execFlows[prDesc->prBase->aNodes[prDesc->curNode - 1].iFlow]);
+  }
+
+  /* Evaluate guard of control flow issuing from current node (the dummy guard is not called) */
+  trueGuardFound = (FwPrCounterS1_t)((flow->iGuard == 0)         ? 1
+                                     : (prDesc->memo == NULL) ? prDesc->prGuards[flow->iGuard](prDesc)
+                                                              : PrMemoGuard(prDesc, flow->iGuard));
+  FW_TRACE_EVENT(tracePrGuard, prDesc, flow->dest, trueGuardFound);
+
+  /* Execute loop as long as guard of control flow issuing from current node is true */
+  while (trueGuardFound) {
+    /* Target of flow is a final node */
+    if (flow->dest == 0) {
+      prDesc->curNode = 0; /* Stop procedure */
+      FW_TRACE_EVENT(tracePrFinal, prDesc, 0, 0);
+      return 0;
+    }
+
+    if (flow->dest > 0) { /* Target of control flow is an action node */
+      prDesc->curNode     = flow->dest;
+      prDesc->nodeExecCnt = 0;
+      prDesc->prActions[flow->iAction](prDesc);
+      PrMemoClear(prDesc);
+      FW_TRACE_EVENT(tracePrNode, prDesc, prDesc->curNode, 0);
+      /* Suspend the procedure at the current node if the budget is exhausted */
+      nOfNodes++;
+      if (nOfNodes == maxNodes) {
+        prDesc->isSuspended = 1;
+        return 1;
+      }
+      flow           = &(execFlows[flow->iNext]);
+      trueGuardFound = (FwPrCounterS1_t)((flow->iGuard == 0)         ? 1
+                                         : (prDesc->memo == NULL) ? prDesc->prGuards[flow->iGuard](prDesc)
+                                                                  : PrMemoGuard(prDesc, flow->iGuard));
+      FW_TRACE_EVENT(tracePrGuard, prDesc, flow->dest, trueGuardFound);
+    }
+    else { /* Target of flow is a decision node */
+      decFlow        = flow;
+      trueGuardFound = 0;
+      /* Evaluate guards of control flows issuing from decision node (they are in adjacent entries) */
+      for (i = 0; i < decFlow->nOfNext; i++) {
+        flow           = &(execFlows[decFlow->iNext + i]);
+        trueGuardFound = (FwPrCounterS1_t)((flow->iGuard == 0)         ? 1
+                                           : (prDesc->memo == NULL) ? prDesc->prGuards[flow->iGuard](prDesc)
+                                                                    : PrMemoGuard(prDesc, flow->iGuard));
+        FW_TRACE_EVENT(tracePrGuard, prDesc, flow->dest, trueGuardFound);
+        if (trueGuardFound != 0) {
+          break; /* First control flow out of dec. node with true guard */
+        }
+      }
+      FW_TRACE_EVENT(tracePrDecision, prDesc, -decFlow->dest, (trueGuardFound != 0) ? i : -1);
+      /* All control flows out of decision node have false guards */
+      if (trueGuardFound == 0) {
+        prDesc->errCode = prFlowErr;
+        return 0;
+      }
+    }
+  }
+  return 0;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+static FwPrBool_t PrMemoGuard(FwPrDesc_t prDesc, FwPrCounterS1_t iGuard) {
+  PrGuardMemo_t*  memo  = prDesc->memo;
+  FwPrCounterU4_t iByte = ((FwPrCounterU4_t)iGuard) / 8;
+  FwPrCounterU1_t bit   = (FwPrCounterU1_t)(1U << (((FwPrCounterU4_t)iGuard) % 8));
+  FwPrBool_t      guard;
+
+  if (memo->decl[iGuard].opnd != prGuardOpndNone) {
+    return PrDeclGuard(prDesc, &(memo->decl[iGuard]));
+  }
+  if ((memo->pure[iByte] & bit) == 0) {
+    return prDesc->prGuards[iGuard](prDesc);
+  }
+  if ((memo->cached[iByte] & bit) != 0) {
+    return ((memo->value[iByte] & bit) != 0);
+  }
+
+  guard               = prDesc->prGuards[iGuard](prDesc);
+  memo->cached[iByte] = (FwPrCounterU1_t)(memo->cached[iByte] | bit);
+  if (guard != 0) {
+    memo->value[iByte] = (FwPrCounterU1_t)(memo->value[iByte] | bit);
+  }
+  else {
+    memo->value[iByte] = (FwPrCounterU1_t)(memo->value[iByte] & ~bit);
+  }
+  memo->isCached = 1;
+  return guard;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+static FwPrBool_t PrDeclGuard(FwPrDesc_t prDesc, PrGuardDecl_t* decl) {
+  const char* data = (const char*)(prDesc->prData);
+  long        opnd;
+
+  switch (decl->opnd) {
+  case prGuardOpndInt:
+    opnd = (long)(*(const int*)(const void*)(data + decl->offset));
+    break;
+  case prGuardOpndLong:
+    opnd = *(const long*)(const void*)(data + decl->offset);
+    break;
+  case prGuardOpndNodeExecCnt:
+    opnd = (long)(prDesc->nodeExecCnt);
+    break;
+  default:
+    opnd = (long)(prDesc->prExecCnt);
+    break;
+  }
+
+  switch (decl->op) {
+  case prGuardLt:
+    return (opnd < decl->value);
+  case prGuardLe:
+    return (opnd <= decl->value);
+  case prGuardEq:
+    return (opnd == decl->value);
+  case prGuardNe:
+    return (opnd != decl->value);
+  case prGuardGe:
+    return (opnd >= decl->value);
+  default:
+    return (opnd > decl->value);
+  }
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+static void PrMemoClear(FwPrDesc_t prDesc) {
+  PrGuardMemo_t* memo = prDesc->memo;
+
+  if ((memo != NULL) && (memo->isCached != 0)) {
+    memset(memo->cached, 0, memo->nOfBytes);
+    memo->isCached = 0;
+  }
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+static void PrProfileExit(FwPrDesc_t prDesc) {
+  PrProfile_t* profile = prDesc->profile;
+
+  if (profile->clock != NULL) {
+    profile->nodeDwell[(prDesc->curNode) - 1] += profile->clock() - profile->entryTime;
+  }
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+static void PrProfileGuard(FwPrDesc_t prDesc, PrFlow_t* flow, FwPrCounterS1_t guard) {
+  if (guard != 0) {
+    prDesc->profile->guardTrueCnt[flow - prDesc->prBase->flows]++;
+  }
+  else {
+    prDesc->profile->guardFalseCnt[flow - prDesc->prBase->flows]++;
+  }
 }
 
 /* ----------------------------------------------------------------------------------------------------------------- */
@@ -80,6 +80,32 @@ void FwPrStop(FwPrDesc_t prDesc);
  */
 void FwPrExecute(FwPrDesc_t prDesc);
 
+/**
+ * Execute a procedure with a budget on the number of action nodes which may be executed.
+ * This function behaves like <code>::FwPrExecute</code> except that the execution of
+ * the procedure stops as soon as <code>maxNodes</code> action nodes have been executed.
+ * The procedure is then left at the last action node it has executed, as if the guard
+ * of the control flow out of that node were false.
+ * The next execution of the procedure (through <code>::FwPrExecute</code> or through this
+ * function) resumes from that node by evaluating the guard of its out-going control flow.
+ * The Node Execution Counter (see <code>::FwPrGetNodeExecCnt</code>) is not incremented by
+ * the resumed execution: the guard is therefore evaluated with the same counter value
+ * (zero) as in an execution without budget.
+ * The Procedure Execution Counter is incremented by each execution as usual.
+ *
+ * Decision nodes and the final node do not count against the budget.
+ * A budget of zero is interpreted as an unlimited budget.
+ *
+ * This function makes the execution time of a procedure bounded and it therefore allows
+ * a long chain of action nodes to be spread over several execution cycles.
+ * @param prDesc the descriptor of the procedure.
+ * @param maxNodes the maximum number of action nodes to be executed (zero for no limit).
+ * @return 1 if the execution was stopped because the budget was exhausted, 0 otherwise
+ * (i.e. if the procedure is stopped or if it stopped at an action node because the guard of
+ * the control flow out of that node was false).
+ */
+FwPrBool_t FwPrExecuteBudget(FwPrDesc_t prDesc, FwPrCounterU4_t maxNodes);
+
 /**
  * Run a procedure.
  * When a procedure is run, the procedure is first started, then it is executed
@@ -0,0 +1,334 @@
+/**
+ * @file
+ * @ingroup prGroup
+ * Implements the step cost analysis functions for the FW Procedure Module.
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2011, All Rights Reserved
+ *
+ * This file is part of the FW Profile.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#include "FwPrCost.h"
+#include "FwPrConfig.h"
+#include "FwPrPrivate.h"
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * The cost annotations which are used by an analysis.
+ */
+typedef struct {
+  /** the cost annotations (or NULL) */
+  const FwPrCostAnnot_t* annots;
+  /** the number of cost annotations */
+  FwPrCounterU4_t nOfAnnots;
+} PrCostAnnots_t;
+
+/**
+ * Initialize the cost of an execution which does not execute any action or guard.
+ * @param cost the cost.
+ */
+static void CostInit(FwPrCost_t* cost);
+
+/**
+ * Add the cost of a part of an execution to the cost of the execution.
+ * @param cost the cost of the execution.
+ * @param part the cost of the part of the execution.
+ */
+static void CostAdd(FwPrCost_t* cost, const FwPrCost_t* part);
+
+/**
+ * Replace the cost of an execution with the field-by-field maximum of its cost and
+ * of the cost of an alternative execution path.
+ * @param cost the cost of the execution.
+ * @param alt the cost of the alternative execution path.
+ */
+static void CostMax(FwPrCost_t* cost, const FwPrCost_t* alt);
+
+/**
+ * Return the cost of an action or guard from the cost annotations.
+ * @param annots the cost annotations.
+ * @param action the action (or NULL if the cost of a guard is requested).
+ * @param guard the guard (or NULL if the cost of an action is requested).
+ * @return the annotated cost or 1 if the action or guard is not annotated.
+ */
+static FwPrCounterU4_t CostOf(const PrCostAnnots_t* annots, FwPrAction_t action, FwPrGuard_t guard);
+
+/**
+ * Check whether the control flows of a procedure which issue from a node lead to a cycle.
+ * The nodes are visited depth-first and they are coloured in the colour map: 0 for the
+ * nodes which have not yet been visited, 1 for the nodes which are being visited and 2
+ * for the nodes from which no cycle can be reached.
+ * @param prBase the base descriptor of the procedure.
+ * @param color the colour map (the action nodes followed by the decision nodes).
+ * @param node the node (a positive action node identifier or a negative decision
+ * node identifier).
+ * @param isDecOnly 1 if only the cycles which go through decision nodes are searched
+ * or 0 if all cycles are searched.
+ * @return 1 if a cycle is found or 0 otherwise.
+ */
+static FwPrBool_t HasCycle(PrBaseDesc_t* prBase, FwPrCounterU1_t* color, FwPrCounterS1_t node, FwPrBool_t isDecOnly);
+
+/**
+ * Compute the worst-case cost of moving to the destination of a control flow whose
+ * guard is true.
+ * @param annots the cost annotations.
+ * @param prDesc the procedure.
+ * @param dest the destination of the control flow.
+ * @param next the worst-case costs of continuing the execution from each action node
+ * after it has been entered (with one node less in the budget).
+ * @param cost the worst-case cost.
+ */
+static void CostFollow(const PrCostAnnots_t* annots, FwPrDesc_t prDesc, FwPrCounterS1_t dest, const FwPrCost_t* next,
+                       FwPrCost_t* cost);
+
+/**
+ * Compute the worst-case cost of continuing an execution through a control flow (the
+ * guard of the control flow is evaluated and, if it is true, its destination is entered).
+ * @param annots the cost annotations.
+ * @param prDesc the procedure.
+ * @param iFlow the location of the control flow in the control flow array.
+ * @param next the worst-case costs of continuing the execution from each action node
+ * after it has been entered (with one node less in the budget).
+ * @param cost the worst-case cost.
+ */
+static void CostFlow(const PrCostAnnots_t* annots, FwPrDesc_t prDesc, FwPrCounterS1_t iFlow, const FwPrCost_t* next,
+                     FwPrCost_t* cost);
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+FwPrErrCode_t FwPrCostExecute(FwPrDesc_t prDesc, FwPrCounterS1_t nodeId, FwPrCounterU4_t maxNodes,
+                              const FwPrCostAnnot_t* annots, FwPrCounterU4_t nOfAnnots, FwPrCost_t* cost) {
+  PrBaseDesc_t*    prBase = prDesc->prBase;
+  PrCostAnnots_t   costAnnots;
+  FwPrErrCode_t    outcome;
+  FwPrCounterU1_t* color;
+  FwPrCost_t*      next;
+  FwPrCost_t*      cur;
+  FwPrCost_t*      tmp;
+  FwPrCost_t       alt;
+  FwPrCounterU4_t  b, nOfRounds;
+  FwPrCounterS1_t  i;
+  FwPrBool_t       hasCycle = 0;
+  size_t           nOfNodes = (size_t)(prBase->nOfANodes + prBase->nOfDNodes);
+
+  if ((nodeId < -1) || (nodeId > prBase->nOfANodes)) {
+    return prIllActNodeId;
+  }
+
+  outcome = FwPrCheck(prDesc);
+  if (outcome != prSuccess) {
+    return outcome;
+  }
+
+  /* Without a node budget, the number of nodes entered in an execution is only bounded if
+   * the procedure has no cycles (in which case each action node is entered at most once) */
+  if (nOfNodes > 0) {
+    color = (FwPrCounterU1_t*)malloc(nOfNodes * sizeof(FwPrCounterU1_t));
+    if (color == NULL) {
+      return prOutOfMemory;
+    }
+    memset(color, 0, nOfNodes * sizeof(FwPrCounterU1_t));
+    for (i = 1; (i <= prBase->nOfDNodes) && (hasCycle == 0); i++) {
+      hasCycle = HasCycle(prBase, color, (FwPrCounterS1_t)(-i), 1);
+    }
+    if ((hasCycle == 0) && (maxNodes == 0)) {
+      memset(color, 0, nOfNodes * sizeof(FwPrCounterU1_t));
+      for (i = 1; (i <= prBase->nOfANodes) && (hasCycle == 0); i++) {
+        hasCycle = HasCycle(prBase, color, i, 0);
+      }
+    }
+    free(color);
+    if (hasCycle != 0) {
+      return prCostUnbounded;
+    }
+  }
+  /* In a procedure without cycles, a budget of one more node than the number of action nodes
+   * is never exhausted and it does not limit the execution */
+  nOfRounds = (maxNodes == 0) ? (FwPrCounterU4_t)(prBase->nOfANodes + 1) : maxNodes;
+
+  /* The worst-case costs of continuing the execution from each action node are computed for
+   * increasing budgets: next[i] holds the cost with b nodes in the budget and cur[i] the cost
+   * with b+1 nodes in the budget (the execution stops when the budget is exhausted) */
+  next = NULL;
+  cur  = NULL;
+  if (prBase->nOfANodes > 0) {
+    next = (FwPrCost_t*)malloc(((size_t)prBase->nOfANodes) * sizeof(FwPrCost_t));
+    cur  = (FwPrCost_t*)malloc(((size_t)prBase->nOfANodes) * sizeof(FwPrCost_t));
+    if ((next == NULL) || (cur == NULL)) {
+      free(next);
+      free(cur);
+      return prOutOfMemory;
+    }
+    for (i = 0; i < prBase->nOfANodes; i++) {
+      CostInit(&(next[i]));
+    }
+  }
+
+  costAnnots.annots    = annots;
+  costAnnots.nOfAnnots = nOfAnnots;
+  for (b = 1; b < nOfRounds; b++) {
+    for (i = 0; i < prBase->nOfANodes; i++) {
+      CostFlow(&costAnnots, prDesc, prBase->aNodes[i].iFlow, next, &(cur[i]));
+    }
+    tmp  = next;
+    next = cur;
+    cur  = tmp;
+  }
+
+  /* The execution starts with the evaluation of the guard out of the current node */
+  CostInit(cost);
+  if (nodeId <= 0) {
+    CostFlow(&costAnnots, prDesc, 0, next, &alt);
+    CostMax(cost, &alt);
+  }
+  for (i = 1; i <= prBase->nOfANodes; i++) {
+    if ((nodeId == 0) || (nodeId == i)) {
+      CostFlow(&costAnnots, prDesc, prBase->aNodes[i - 1].iFlow, next, &alt);
+      CostMax(cost, &alt);
+    }
+  }
+
+  free(next);
+  free(cur);
+  return prSuccess;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+static void CostInit(FwPrCost_t* cost) {
+  cost->nOfActions = 0;
+  cost->nOfGuards  = 0;
+  cost->nOfNodes   = 0;
+  cost->cost       = 0;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+static void CostAdd(FwPrCost_t* cost, const FwPrCost_t* part) {
+  cost->nOfActions += part->nOfActions;
+  cost->nOfGuards += part->nOfGuards;
+  cost->nOfNodes += part->nOfNodes;
+  cost->cost += part->cost;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+static void CostMax(FwPrCost_t* cost, const FwPrCost_t* alt) {
+  if (cost->nOfActions < alt->nOfActions) {
+    cost->nOfActions = alt->nOfActions;
+  }
+  if (cost->nOfGuards < alt->nOfGuards) {
+    cost->nOfGuards = alt->nOfGuards;
+  }
+  if (cost->nOfNodes < alt->nOfNodes) {
+    cost->nOfNodes = alt->nOfNodes;
+  }
+  if (cost->cost < alt->cost) {
+    cost->cost = alt->cost;
+  }
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+static FwPrCounterU4_t CostOf(const PrCostAnnots_t* annots, FwPrAction_t action, FwPrGuard_t guard) {
+  FwPrCounterU4_t i;
+
+  for (i = 0; i < annots->nOfAnnots; i++) {
+    if ((action != NULL) && (annots->annots[i].action == action)) {
+      return annots->annots[i].cost;
+    }
+    if ((guard != NULL) && (annots->annots[i].guard == guard)) {
+      return annots->annots[i].cost;
+    }
+  }
+  return 1;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+static FwPrBool_t HasCycle(PrBaseDesc_t* prBase, FwPrCounterU1_t* color, FwPrCounterS1_t node, FwPrBool_t isDecOnly) {
+  FwPrCounterS1_t i, first, n, dest;
+  size_t          iNode;
+
+  if (node > 0) {
+    iNode = (size_t)(node - 1);
+    first = prBase->aNodes[node - 1].iFlow;
+    n     = 1;
+  }
+  else {
+    iNode = (size_t)(prBase->nOfANodes - node - 1);
+    first = prBase->dNodes[-node - 1].outFlowIndex;
+    n     = prBase->dNodes[-node - 1].nOfOutTrans;
+  }
+
+  if (color[iNode] != 0) {
+    return (color[iNode] == 1);
+  }
+  color[iNode] = 1;
+  for (i = 0; i < n; i++) {
+    dest = prBase->flows[first + i].dest;
+    if ((dest != 0) && ((isDecOnly == 0) || (dest < 0)) && (HasCycle(prBase, color, dest, isDecOnly) != 0)) {
+      return 1;
+    }
+  }
+  color[iNode] = 2;
+  return 0;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+static void CostFollow(const PrCostAnnots_t* annots, FwPrDesc_t prDesc, FwPrCounterS1_t dest, const FwPrCost_t* next,
+                       FwPrCost_t* cost) {
+  PrBaseDesc_t*   prBase = prDesc->prBase;
+  PrDNode_t*      decNode;
+  FwPrCost_t      guards, alt, worst;
+  FwPrCounterS1_t i, iAction, iGuard;
+
+  CostInit(cost);
+  if (dest == 0) { /* final node */
+    return;
+  }
+
+  if (dest > 0) { /* the action of the action node is executed and the execution continues */
+    iAction = prBase->aNodes[dest - 1].iAction;
+    cost->nOfActions++;
+    cost->nOfNodes++;
+    cost->cost += CostOf(annots, prDesc->prActions[iAction], NULL);
+    CostAdd(cost, &(next[dest - 1]));
+    return;
+  }
+
+  /* The guards out of the decision node are evaluated until one is true: the worst case is
+   * taken over the control flow which is taken and the case where no guard is true */
+  decNode = &(prBase->dNodes[-dest - 1]);
+  CostInit(&guards);
+  CostInit(&worst);
+  for (i = 0; i < decNode->nOfOutTrans; i++) {
+    iGuard = prBase->flows[decNode->outFlowIndex + i].iGuard;
+    guards.nOfGuards++;
+    if (iGuard != 0) { /* the dummy guard has no cost */
+      guards.cost += CostOf(annots, NULL, prDesc->prGuards[iGuard]);
+    }
+    CostFollow(annots, prDesc, prBase->flows[decNode->outFlowIndex + i].dest, next, &alt);
+    CostAdd(&alt, &guards);
+    CostMax(&worst, &alt);
+  }
+  CostMax(&worst, &guards);
+  CostAdd(cost, &worst);
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+static void CostFlow(const PrCostAnnots_t* annots, FwPrDesc_t prDesc, FwPrCounterS1_t iFlow, const FwPrCost_t* next,
+                     FwPrCost_t* cost) {
+  PrFlow_t*  flow = &(prDesc->prBase->flows[iFlow]);
+  FwPrCost_t dest;
+
+  CostInit(cost);
+  cost->nOfGuards++;
+  if (flow->iGuard != 0) { /* the dummy guard has no cost */
+    cost->cost += CostOf(annots, NULL, prDesc->prGuards[flow->iGuard]);
+  }
+  CostFollow(annots, prDesc, flow->dest, next, &dest);
+  CostAdd(cost, &dest);
+}
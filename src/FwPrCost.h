@@ -0,0 +1,83 @@
+/**
+ * @file
+ * @ingroup prGroup
+ * Declaration of the step cost analysis interface for a FW Procedure.
+ * The function declared in this file computes, from the configuration of a procedure,
+ * an upper bound on the work done by one call to <code>::FwPrExecute</code> or to
+ * <code>::FwPrExecuteBudget</code>.
+ * The bound is expressed as a <code>::FwPrCost_t</code> which holds the maximum number
+ * of actions which are executed, the maximum number of guards which are evaluated,
+ * the maximum number of action nodes which are entered and the maximum cost of the
+ * execution.
+ *
+ * The analysis follows the execution paths of the <code>Core</code> module: the guard
+ * of the control flow out of the current node is evaluated and, as long as the guard
+ * is true, the procedure moves to the next node.
+ * When an action node is entered, its action is executed and the guard of its out-going
+ * control flow is evaluated.
+ * When a decision node is reached, the guards of its out-going control flows may all be
+ * evaluated before one of them is taken (or none of them is taken).
+ * If the control flows of a procedure form a cycle, the number of nodes which can be
+ * entered in one execution is only bounded if a node budget is given (as for
+ * <code>::FwPrExecuteBudget</code>).
+ * A cycle which only goes through decision nodes is never bounded.
+ * Guard memoization (see <code>::FwPrSetGuardPure</code>) and the compiled execution
+ * tables (see <code>::FwPrCompile</code>) can only reduce the work done in an execution
+ * and they are ignored by the analysis.
+ *
+ * The cost of each action and guard is taken from an optional array of cost
+ * annotations (see <code>::FwPrCostAnnot_t</code>) which associates a cost to the
+ * function pointers of the actions and guards.
+ * The dummy guard (the one which is used when a control flow has no guard) has a cost
+ * of zero and the actions and guards which are not annotated have a cost of one.
+ * Hence, without annotations, the cost of an execution is the number of calls to
+ * actions and guards defined by the user.
+ *
+ * The analysis only reads the configuration of the procedure: it does not matter
+ * whether it is started or stopped.
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2011, All Rights Reserved
+ *
+ * This file is part of the FW Profile.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#ifndef FWPR_COST_H_
+#define FWPR_COST_H_
+
+#include "FwPrCore.h"
+
+/**
+ * Compute the worst-case cost of executing a procedure.
+ * The procedure is checked with <code>::FwPrCheck</code>.
+ * The current node of the procedure is given as an argument.
+ * If the given current node is zero, the worst case is taken over the initial node and
+ * all the action nodes of the procedure.
+ * @param prDesc the descriptor of the procedure.
+ * @param nodeId the identifier of the current action node, -1 for the initial node (i.e.
+ * the first execution after the procedure is started), or zero for the worst case over
+ * all nodes.
+ * @param maxNodes the maximum number of action nodes which are entered in the execution
+ * (as for <code>::FwPrExecuteBudget</code>) or zero if the number of action nodes is not
+ * limited (as for <code>::FwPrExecute</code>).
+ * @param annots the cost annotations of the actions and guards (or NULL if there are
+ * no annotations).
+ * @param nOfAnnots the number of cost annotations.
+ * @param cost the worst-case cost of the execution (only set if the function returns
+ * <code>#prSuccess</code>).
+ * @return <code>#prSuccess</code>, <code>#prIllActNodeId</code> if the node identifier is
+ * smaller than -1 or greater than the number of action nodes, <code>#prCostUnbounded</code>
+ * if the cost has no upper bound, <code>#prOutOfMemory</code> if the memory for the
+ * analysis could not be allocated, or the outcome of <code>::FwPrCheck</code> if the
+ * procedure did not pass its configuration check.
+ */
+FwPrErrCode_t FwPrCostExecute(FwPrDesc_t prDesc, FwPrCounterS1_t nodeId, FwPrCounterU4_t maxNodes,
+                              const FwPrCostAnnot_t* annots, FwPrCounterU4_t nOfAnnots, FwPrCost_t* cost);
+
+#endif /* FWPR_COST_H_ */
@@ -16,97 +16,534 @@
  */
 
 #include "FwPrDCreate.h"
+#include "FwPrConfig.h"
 #include "FwPrPrivate.h"
 #include <stdlib.h>
+#include <string.h>
+
+/**
+ * Union of the types held in the sections of a procedure arena.
+ * The size of this union is used as the alignment of the sections within the arena.
+ */
+typedef union {
+  /** A data pointer. */
+  void* p;
+  /** A function pointer. */
+  FwPrAction_t a;
+  /** An integer. */
+  FwPrCounterU4_t n;
+} PrArenaAlign_t;
+
+/** The value of the first word of a procedure image ("FWPR" in ASCII). */
+#define PR_IMAGE_MAGIC 0x46575052UL
+
+/**
+ * Header of a procedure image (see <code>::FwPrExportImage</code>).
+ * The header is located at the start of the image and it is followed by the
+ * sections which hold the arrays of the base descriptor of the exported procedure.
+ * The sections are located through their offsets from the start of the image
+ * and each section is aligned to the size of <code>::PrArenaAlign_t</code>.
+ * Field <code>layout</code> holds the sizes of the types of the array elements
+ * and of <code>::PrArenaAlign_t</code> (one byte each) and is used to detect
+ * images which were created with a different memory layout.
+ * Field <code>checksum</code> holds the 32-bit FNV-1a hash of the image bytes
+ * which follow the header.
+ */
+typedef struct {
+  /** the magic number (<code>#PR_IMAGE_MAGIC</code>) */
+  FwPrCounterU4_t magic;
+  /** the version of the image format (<code>#FW_PR_IMAGE_VERSION</code>) */
+  FwPrCounterU4_t version;
+  /** the memory layout of the image */
+  FwPrCounterU4_t layout;
+  /** the size of the image in bytes */
+  FwPrCounterU4_t size;
+  /** the checksum of the image */
+  FwPrCounterU4_t checksum;
+  /** the number of action nodes */
+  FwPrCounterU4_t nOfANodes;
+  /** the number of decision nodes */
+  FwPrCounterU4_t nOfDNodes;
+  /** the number of control flows */
+  FwPrCounterU4_t nOfFlows;
+  /** the number of actions */
+  FwPrCounterU4_t nOfActions;
+  /** the number of guards (excluding the dummy guard) */
+  FwPrCounterU4_t nOfGuards;
+  /** the offset of the array of action nodes */
+  FwPrCounterU4_t aNodesOffset;
+  /** the offset of the array of decision nodes */
+  FwPrCounterU4_t dNodesOffset;
+  /** the offset of the array of control flows */
+  FwPrCounterU4_t flowsOffset;
+  /** the offset of the execution table */
+  FwPrCounterU4_t execFlowsOffset;
+} PrImageHeader_t;
+
+/**
+ * Round a size in bytes up to the alignment of the sections of a procedure arena.
+ * @param n the size to be rounded up
+ * @return the rounded-up size
+ */
+static FwPrCounterU4_t PrArenaRound(FwPrCounterU4_t n);
+
+/**
+ * Check the legality of the size parameters of a new procedure.
+ * The constraints on the parameters are those of function <code>::FwPrCreate</code>.
+ * @param nOfANodes the number of action nodes
+ * @param nOfDNodes the number of decision nodes
+ * @param nOfFlows the number of control flows
+ * @param nOfActions the number of actions
+ * @param nOfGuards the number of guards
+ * @return 1 if the parameters are legal or 0 otherwise
+ */
+static FwPrBool_t PrIsLegalSize(FwPrCounterS1_t nOfANodes, FwPrCounterS1_t nOfDNodes, FwPrCounterS1_t nOfFlows,
+                                FwPrCounterS1_t nOfActions, FwPrCounterS1_t nOfGuards);
+
+/**
+ * Initialize a newly created procedure descriptor.
+ * The arrays of the procedure descriptor must already have been allocated
+ * and linked to the descriptor.
+ * This function initializes their content and the scalar attributes of the
+ * descriptor.
+ * @param prDesc the procedure descriptor
+ * @param nOfANodes the number of action nodes
+ * @param nOfDNodes the number of decision nodes
+ * @param nOfFlows the number of control flows
+ * @param nOfActions the number of actions
+ * @param nOfGuards the number of guards (excluding the dummy guard)
+ */
+static void PrInitDesc(FwPrDesc_t prDesc, FwPrCounterS1_t nOfANodes, FwPrCounterS1_t nOfDNodes,
+                       FwPrCounterS1_t nOfFlows, FwPrCounterS1_t nOfActions, FwPrCounterS1_t nOfGuards);
+
+/**
+ * Lay out the descriptor of a new procedure in a memory block.
+ * The memory block must be at least as large as the value returned by
+ * <code>::FwPrGetArenaSize</code> for the same procedure parameters.
+ * The descriptor is placed at the first address in the block which is aligned to
+ * <code>#FW_PR_ARENA_ALIGN</code>.
+ * The distance between this address and the start of the block is stored in the
+ * byte immediately preceding it.
+ * @param block the memory block
+ * @param nOfANodes the number of action nodes
+ * @param nOfDNodes the number of decision nodes
+ * @param nOfFlows the number of control flows
+ * @param nOfActions the number of actions
+ * @param nOfGuards the number of guards
+ * @return the descriptor of the new procedure
+ */
+static FwPrDesc_t PrLayOutArena(unsigned char* block, FwPrCounterS1_t nOfANodes, FwPrCounterS1_t nOfDNodes,
+                                FwPrCounterS1_t nOfFlows, FwPrCounterS1_t nOfActions, FwPrCounterS1_t nOfGuards);
+
+/**
+ * Compute the layout of a procedure image.
+ * The magic number, the version, the memory layout, the offsets of the sections and the size
+ * of the image are set in the argument header from the numbers of action nodes, decision nodes
+ * and control flows which it holds.
+ * The checksum is set to zero.
+ * @param header the header of the image
+ * @return the size of the image in bytes
+ */
+static FwPrCounterU4_t PrImageLayOut(PrImageHeader_t* header);
+
+/**
+ * Compute the checksum of a sequence of bytes in a procedure image.
+ * @param bytes the sequence of bytes
+ * @param n the number of bytes
+ * @return the 32-bit FNV-1a hash of the bytes
+ */
+static FwPrCounterU4_t PrImageChecksum(const unsigned char* bytes, FwPrCounterU4_t n);
+
+/**
+ * Check whether a memory block holds a valid procedure image.
+ * The image is valid if its start is aligned to the size of <code>::PrArenaAlign_t</code>,
+ * if its header is consistent with the layout computed by <code>::PrImageLayOut</code>,
+ * if it fits in the memory block, if its checksum is correct and if its content is valid
+ * (see <code>::PrIsValidContent</code>).
+ * @param image the memory block
+ * @param imageSize the size of the memory block in bytes
+ * @return 1 if the image is valid or 0 otherwise
+ */
+static FwPrBool_t PrIsValidImage(const void* image, FwPrCounterU4_t imageSize);
+
+/**
+ * Check whether the arrays of a procedure image only hold indices which are within the
+ * bounds of the arrays which they index.
+ * The content is valid if:
+ * - the out-going control flow and the action of each action node are within the control
+ *   flow and action arrays;
+ * - the out-going control flows of each decision node are within the control flow array;
+ * - the destination of each control flow (and of each entry of the execution table) is an
+ *   action node, a decision node or the final node and its guard is within the guard array;
+ * - the action and the out-going control flows of the destination of each entry of the
+ *   execution table are within the action and control flow arrays.
+ * .
+ * This check protects the procedure functions against images which have a correct
+ * checksum but which were not produced by <code>::FwPrExportImage</code>.
+ * The header of the image must have been checked by <code>::PrIsValidImage</code>.
+ * @param header the header of the image
+ * @return 1 if the content of the image is valid or 0 otherwise
+ */
+static FwPrBool_t PrIsValidContent(const PrImageHeader_t* header);
 
 /* ----------------------------------------------------------------------------------------------------------------- */
 FwPrDesc_t FwPrCreate(FwPrCounterS1_t nOfANodes, FwPrCounterS1_t nOfDNodes, FwPrCounterS1_t nOfFlows,
                       FwPrCounterS1_t nOfActions, FwPrCounterS1_t nOfGuards) {
 
-  FwPrCounterS1_t i;
-  PrBaseDesc_t*   prBase;
-  FwPrDesc_t      prDesc;
+  PrBaseDesc_t* prBase;
+  FwPrDesc_t    prDesc;
 
-  if (nOfFlows < 2) {
+  if (PrIsLegalSize(nOfANodes, nOfDNodes, nOfFlows, nOfActions, nOfGuards) == 0) {
     return NULL;
   }
 
-  if (nOfANodes < 1) {
+  prDesc = (FwPrDesc_t)malloc(sizeof(struct FwPrDesc));
+  if (prDesc == NULL) {
     return NULL;
   }
 
-  if (nOfDNodes < 0) {
+  prBase = (PrBaseDesc_t*)malloc(sizeof(PrBaseDesc_t));
+  if (prBase == NULL) {
+    free(prDesc);
     return NULL;
   }
 
-  if (nOfActions < 1) {
-    return NULL;
+  /* Set all array pointers to NULL so that a partially created descriptor can be released */
+  prDesc->prBase    = prBase;
+  prDesc->prActions = NULL;
+  prDesc->prGuards  = NULL;
+  prDesc->profile   = NULL;
+  prDesc->cfgIndex  = NULL;
+  prDesc->memo      = NULL;
+  prDesc->shared    = 0;
+  prBase->aNodes    = NULL;
+  prBase->dNodes    = NULL;
+  prBase->flows     = NULL;
+  prBase->execFlows = NULL;
+
+  if (nOfDNodes > 0) {
+    prBase->dNodes = (PrDNode_t*)malloc(((FwPrCounterU4_t)(nOfDNodes)) * sizeof(PrDNode_t));
+    if (prBase->dNodes == NULL) {
+      FwPrRelease(prDesc);
+      return NULL;
+    }
   }
 
-  if (nOfActions > nOfANodes) {
+  prBase->aNodes    = (PrANode_t*)malloc(((FwPrCounterU4_t)(nOfANodes)) * sizeof(PrANode_t));
+  prBase->flows     = (PrFlow_t*)malloc(((FwPrCounterU4_t)(nOfFlows)) * sizeof(PrFlow_t));
+  prDesc->prActions = (FwPrAction_t*)malloc(((FwPrCounterU4_t)(nOfActions)) * sizeof(FwPrAction_t));
+  prDesc->prGuards  = (FwPrGuard_t*)malloc(((FwPrCounterU4_t)(nOfGuards + 1)) * sizeof(FwPrGuard_t));
+  if ((prBase->aNodes == NULL) || (prBase->flows == NULL) || (prDesc->prActions == NULL) ||
+      (prDesc->prGuards == NULL)) {
+    FwPrRelease(prDesc);
     return NULL;
   }
 
-  if (nOfGuards < 0) {
-    return NULL;
+  PrInitDesc(prDesc, nOfANodes, nOfDNodes, nOfFlows, nOfActions, nOfGuards);
+
+  return prDesc;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+FwPrCounterU4_t FwPrGetArenaSize(FwPrCounterS1_t nOfANodes, FwPrCounterS1_t nOfDNodes, FwPrCounterS1_t nOfFlows,
+                                 FwPrCounterS1_t nOfActions, FwPrCounterS1_t nOfGuards) {
+  FwPrCounterU4_t size;
+
+  if (PrIsLegalSize(nOfANodes, nOfDNodes, nOfFlows, nOfActions, nOfGuards) == 0) {
+    return 0;
   }
 
-  if (nOfGuards > nOfFlows) {
+  /* The first FW_PR_ARENA_ALIGN bytes are reserved for the alignment of the descriptor */
+  size = FW_PR_ARENA_ALIGN;
+  size += PrArenaRound(sizeof(struct FwPrDesc));
+  size += PrArenaRound(sizeof(PrBaseDesc_t));
+  size += PrArenaRound(((FwPrCounterU4_t)(nOfFlows)) * sizeof(PrFlow_t));
+  size += PrArenaRound(((FwPrCounterU4_t)(nOfANodes)) * sizeof(PrANode_t));
+  size += PrArenaRound(((FwPrCounterU4_t)(nOfActions)) * sizeof(FwPrAction_t));
+  size += PrArenaRound(((FwPrCounterU4_t)(nOfGuards + 1)) * sizeof(FwPrGuard_t));
+  size += PrArenaRound(((FwPrCounterU4_t)(nOfDNodes)) * sizeof(PrDNode_t));
+  size += PrArenaRound(((FwPrCounterU4_t)(nOfFlows)) * sizeof(PrExecFlow_t));
+
+  return size;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+FwPrDesc_t FwPrCreateArena(FwPrCounterS1_t nOfANodes, FwPrCounterS1_t nOfDNodes, FwPrCounterS1_t nOfFlows,
+                           FwPrCounterS1_t nOfActions, FwPrCounterS1_t nOfGuards) {
+  FwPrCounterU4_t size;
+  unsigned char*  block;
+
+  size = FwPrGetArenaSize(nOfANodes, nOfDNodes, nOfFlows, nOfActions, nOfGuards);
+  if (size == 0) {
     return NULL;
   }
 
-  prDesc = (FwPrDesc_t)malloc(sizeof(struct FwPrDesc));
-  if (prDesc == NULL) {
+  block = (unsigned char*)malloc(size);
+  if (block == NULL) {
     return NULL;
   }
 
-  prBase = (PrBaseDesc_t*)malloc(sizeof(PrBaseDesc_t));
-  if (prBase == NULL) {
+  return PrLayOutArena(block, nOfANodes, nOfDNodes, nOfFlows, nOfActions, nOfGuards);
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+FwPrDesc_t FwPrCreateInBuffer(void* buffer, FwPrCounterU4_t bufSize, FwPrCounterS1_t nOfANodes,
+                              FwPrCounterS1_t nOfDNodes, FwPrCounterS1_t nOfFlows, FwPrCounterS1_t nOfActions,
+                              FwPrCounterS1_t nOfGuards) {
+  FwPrCounterU4_t size;
+
+  if (buffer == NULL) {
     return NULL;
   }
 
-  prBase->aNodes = (PrANode_t*)malloc(((FwPrCounterU4_t)(nOfANodes)) * sizeof(PrANode_t));
-  if (prBase->aNodes == NULL) {
+  size = FwPrGetArenaSize(nOfANodes, nOfDNodes, nOfFlows, nOfActions, nOfGuards);
+  if ((size == 0) || (bufSize < size)) {
     return NULL;
   }
-  for (i = 0; i < nOfANodes; i++) {
-    prBase->aNodes[i].iFlow = -1;
+
+  return PrLayOutArena((unsigned char*)buffer, nOfANodes, nOfDNodes, nOfFlows, nOfActions, nOfGuards);
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+void FwPrReleaseArena(FwPrDesc_t prDesc) {
+  unsigned char* desc = (unsigned char*)prDesc;
+
+  /* The profiling data, the configuration index and the guard memo are not in the arena */
+  free(prDesc->profile);
+  free(prDesc->cfgIndex);
+  free(prDesc->memo);
+
+  /* The byte before the descriptor holds its offset from the start of the allocated block */
+  free(desc - desc[-1]);
+
+  return;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+FwPrCounterU4_t FwPrGetImageSize(FwPrDesc_t prDesc) {
+  PrImageHeader_t header;
+
+  header.nOfANodes = (FwPrCounterU4_t)prDesc->prBase->nOfANodes;
+  header.nOfDNodes = (FwPrCounterU4_t)prDesc->prBase->nOfDNodes;
+  header.nOfFlows  = (FwPrCounterU4_t)prDesc->prBase->nOfFlows;
+
+  return PrImageLayOut(&header);
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+FwPrCounterU4_t FwPrExportImage(FwPrDesc_t prDesc, void* buffer, FwPrCounterU4_t bufSize) {
+  FwPrCounterS1_t  i;
+  PrBaseDesc_t*    prBase = prDesc->prBase;
+  unsigned char*   image  = (unsigned char*)buffer;
+  PrImageHeader_t* header = (PrImageHeader_t*)buffer;
+  PrANode_t*       aNodes;
+  PrDNode_t*       dNodes;
+  PrFlow_t*        flows;
+  PrExecFlow_t*    execFlows;
+  FwPrCounterU4_t  size;
+
+  if ((buffer == NULL) || ((((size_t)buffer) % sizeof(PrArenaAlign_t)) != 0)) {
+    return 0;
   }
 
-  if (nOfDNodes > 0) {
-    prBase->dNodes = (PrDNode_t*)malloc(((FwPrCounterU4_t)(nOfDNodes)) * sizeof(PrDNode_t));
-    if (prBase->dNodes == NULL) {
+  size = FwPrGetImageSize(prDesc);
+  if (bufSize < size) {
+    return 0;
+  }
+
+  /* The execution table is part of the image: the procedure must be compiled */
+  if (FwPrCompile(prDesc) != prSuccess) {
+    return 0;
+  }
+
+  /* The image is cleared so that its padding bytes do not depend on the content of the buffer */
+  memset(buffer, 0, (size_t)size);
+  header->nOfANodes  = (FwPrCounterU4_t)prBase->nOfANodes;
+  header->nOfDNodes  = (FwPrCounterU4_t)prBase->nOfDNodes;
+  header->nOfFlows   = (FwPrCounterU4_t)prBase->nOfFlows;
+  header->nOfActions = (FwPrCounterU4_t)prDesc->nOfActions;
+  header->nOfGuards  = (FwPrCounterU4_t)(prDesc->nOfGuards - 1);
+  PrImageLayOut(header);
+
+  aNodes    = (PrANode_t*)(void*)(image + header->aNodesOffset);
+  dNodes    = (PrDNode_t*)(void*)(image + header->dNodesOffset);
+  flows     = (PrFlow_t*)(void*)(image + header->flowsOffset);
+  execFlows = (PrExecFlow_t*)(void*)(image + header->execFlowsOffset);
+  for (i = 0; i < prBase->nOfANodes; i++) {
+    aNodes[i] = prBase->aNodes[i];
+  }
+  for (i = 0; i < prBase->nOfDNodes; i++) {
+    dNodes[i] = prBase->dNodes[i];
+  }
+  for (i = 0; i < prBase->nOfFlows; i++) {
+    flows[i]     = prBase->flows[i];
+    execFlows[i] = prBase->execFlows[i];
+  }
+
+  header->checksum = PrImageChecksum(image + header->aNodesOffset, size - header->aNodesOffset);
+
+  return size;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+FwPrDesc_t FwPrLoadImage(const void* image, FwPrCounterU4_t imageSize, const FwPrAction_t* actions,
+                         FwPrCounterS1_t nOfActions, const FwPrGuard_t* guards, FwPrCounterS1_t nOfGuards) {
+  FwPrCounterS1_t        i;
+  const unsigned char*   bytes  = (const unsigned char*)image;
+  const PrImageHeader_t* header = (const PrImageHeader_t*)image;
+  FwPrCounterU4_t        size;
+  FwPrCounterU4_t        offset;
+  unsigned char*         block;
+  unsigned char*         next;
+  PrBaseDesc_t*          prBase;
+  FwPrDesc_t             prDesc;
+
+  if (PrIsValidImage(image, imageSize) == 0) {
+    return NULL;
+  }
+
+  if ((nOfActions < 0) || (nOfGuards < 0) || (header->nOfActions != (FwPrCounterU4_t)nOfActions) ||
+      (header->nOfGuards != (FwPrCounterU4_t)nOfGuards)) {
+    return NULL;
+  }
+  for (i = 0; i < nOfActions; i++) {
+    if (actions[i] == NULL) {
       return NULL;
     }
-    for (i = 0; i < nOfDNodes; i++) {
-      prBase->dNodes[i].outFlowIndex = -1;
-    }
   }
-  else {
-    prBase->dNodes = NULL;
+  for (i = 0; i < nOfGuards; i++) {
+    if (guards[i] == NULL) {
+      return NULL;
+    }
   }
 
-  prBase->flows = (PrFlow_t*)malloc(((FwPrCounterU4_t)(nOfFlows)) * sizeof(PrFlow_t));
-  if (prBase->flows == NULL) {
+  /* Only the descriptor, the base descriptor and the action and guard arrays are allocated:
+   * the other arrays of the base descriptor are those of the image */
+  size = FW_PR_ARENA_ALIGN;
+  size += PrArenaRound(sizeof(struct FwPrDesc));
+  size += PrArenaRound(sizeof(PrBaseDesc_t));
+  size += PrArenaRound(((FwPrCounterU4_t)(nOfActions)) * sizeof(FwPrAction_t));
+  size += PrArenaRound(((FwPrCounterU4_t)(nOfGuards + 1)) * sizeof(FwPrGuard_t));
+  block = (unsigned char*)malloc(size);
+  if (block == NULL) {
     return NULL;
   }
+
+  /* The memory block is laid out like an arena so that it is released by FwPrReleaseArena */
+  offset   = FW_PR_ARENA_ALIGN - (((FwPrCounterU4_t)block) % FW_PR_ARENA_ALIGN);
+  next     = block + offset;
+  next[-1] = (unsigned char)offset;
+  prDesc   = (FwPrDesc_t)(void*)next;
+  next += PrArenaRound(sizeof(struct FwPrDesc));
+  prBase = (PrBaseDesc_t*)(void*)next;
+  next += PrArenaRound(sizeof(PrBaseDesc_t));
+  prDesc->prActions = (FwPrAction_t*)(void*)next;
+  next += PrArenaRound(((FwPrCounterU4_t)(nOfActions)) * sizeof(FwPrAction_t));
+  prDesc->prGuards = (FwPrGuard_t*)(void*)next;
+
+  prBase->aNodes     = (PrANode_t*)(void*)(bytes + header->aNodesOffset);
+  prBase->dNodes     = (header->nOfDNodes > 0) ? (PrDNode_t*)(void*)(bytes + header->dNodesOffset) : NULL;
+  prBase->flows      = (PrFlow_t*)(void*)(bytes + header->flowsOffset);
+  prBase->execFlows  = (PrExecFlow_t*)(void*)(bytes + header->execFlowsOffset);
+  prBase->nOfANodes  = (FwPrCounterS1_t)header->nOfANodes;
+  prBase->nOfDNodes  = (FwPrCounterS1_t)header->nOfDNodes;
+  prBase->nOfFlows   = (FwPrCounterS1_t)header->nOfFlows;
+  prBase->isCompiled = 1;
+
+  for (i = 0; i < nOfActions; i++) {
+    prDesc->prActions[i] = actions[i];
+  }
+  prDesc->prGuards[0] = &PrDummyGuard;
+  for (i = 0; i < nOfGuards; i++) {
+    prDesc->prGuards[i + 1] = guards[i];
+  }
+
+  /* The procedure is configured as a derived procedure whose base is the image */
+  prDesc->prBase      = prBase;
+  prDesc->curNode     = 0;
+  prDesc->prData      = NULL;
+  prDesc->flowCnt     = 0;
+  prDesc->nOfActions  = nOfActions;
+  prDesc->nOfGuards   = (FwPrCounterS1_t)(nOfGuards + 1);
+  prDesc->errCode     = prSuccess;
+  prDesc->nodeExecCnt = 0;
+  prDesc->isSuspended = 0;
+  prDesc->prExecCnt   = 0;
+  prDesc->profile     = NULL;
+  prDesc->cfgIndex    = NULL;
+  prDesc->memo        = NULL;
+  prDesc->shared      = 0;
+
+  return prDesc;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+static FwPrCounterU4_t PrArenaRound(FwPrCounterU4_t n) {
+  FwPrCounterU4_t align = (FwPrCounterU4_t)sizeof(PrArenaAlign_t);
+  return ((n + align - 1) / align) * align;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+static FwPrBool_t PrIsLegalSize(FwPrCounterS1_t nOfANodes, FwPrCounterS1_t nOfDNodes, FwPrCounterS1_t nOfFlows,
+                                FwPrCounterS1_t nOfActions, FwPrCounterS1_t nOfGuards) {
+  if (nOfFlows < 2) {
+    return 0;
+  }
+
+  if (nOfANodes < 1) {
+    return 0;
+  }
+
+  if (nOfDNodes < 0) {
+    return 0;
+  }
+
+  if (nOfActions < 1) {
+    return 0;
+  }
+
+  if (nOfActions > nOfANodes) {
+    return 0;
+  }
+
+  if (nOfGuards < 0) {
+    return 0;
+  }
+
+  /* The dummy guard must fit in the guard array */
+  if (nOfGuards == FW_PR_COUNTER_S1_MAX) {
+    return 0;
+  }
+
+  if (nOfGuards > nOfFlows) {
+    return 0;
+  }
+
+  return 1;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+static void PrInitDesc(FwPrDesc_t prDesc, FwPrCounterS1_t nOfANodes, FwPrCounterS1_t nOfDNodes,
+                       FwPrCounterS1_t nOfFlows, FwPrCounterS1_t nOfActions, FwPrCounterS1_t nOfGuards) {
+  FwPrCounterS1_t i;
+  PrBaseDesc_t*   prBase = prDesc->prBase;
+
+  for (i = 0; i < nOfANodes; i++) {
+    prBase->aNodes[i].iFlow = -1;
+  }
+
+  for (i = 0; i < nOfDNodes; i++) {
+    prBase->dNodes[i].outFlowIndex = -1;
+  }
+
   for (i = 0; i < nOfFlows; i++) {
     prBase->flows[i].iGuard = -1;
   }
 
-  prDesc->prActions = (FwPrAction_t*)malloc(((FwPrCounterU4_t)(nOfActions)) * sizeof(FwPrAction_t));
-  if (prDesc->prActions == NULL) {
-    return NULL;
-  }
   for (i = 0; i < nOfActions; i++) {
     prDesc->prActions[i] = NULL;
   }
 
-  prDesc->prGuards = (FwPrGuard_t*)malloc(((FwPrCounterU4_t)(nOfGuards + 1)) * sizeof(FwPrGuard_t));
-  if (prDesc->prGuards == NULL) {
-    return NULL;
-  }
-
   for (i = 1; i <= nOfGuards; i++) {
     prDesc->prGuards[i] = NULL;
   }
@@ -115,7 +552,7 @@ FwPrDesc_t FwPrCreate(FwPrCounterS1_t nOfANodes, FwPrCounterS1_t nOfDNodes, FwPr
   prBase->nOfANodes   = nOfANodes;
   prBase->nOfDNodes   = nOfDNodes;
   prBase->nOfFlows    = nOfFlows;
-  prDesc->prBase      = prBase;
+  prBase->isCompiled  = 0;
   prDesc->curNode     = 0;
   prDesc->prData      = NULL;
   prDesc->flowCnt     = 1;
@@ -123,7 +560,48 @@ FwPrDesc_t FwPrCreate(FwPrCounterS1_t nOfANodes, FwPrCounterS1_t nOfDNodes, FwPr
   prDesc->nOfGuards   = (FwPrCounterS1_t)(nOfGuards + 1);
   prDesc->errCode     = prSuccess;
   prDesc->nodeExecCnt = 0;
+  prDesc->isSuspended = 0;
   prDesc->prExecCnt   = 0;
+  prDesc->profile     = NULL;
+  prDesc->cfgIndex    = NULL;
+  prDesc->memo        = NULL;
+  prDesc->shared      = 0;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+static FwPrDesc_t PrLayOutArena(unsigned char* block, FwPrCounterS1_t nOfANodes, FwPrCounterS1_t nOfDNodes,
+                                FwPrCounterS1_t nOfFlows, FwPrCounterS1_t nOfActions, FwPrCounterS1_t nOfGuards) {
+  FwPrCounterU4_t offset;
+  unsigned char*  next;
+  PrBaseDesc_t*   prBase;
+  FwPrDesc_t      prDesc;
+
+  /* Align the descriptor and record its offset (which is in [1,FW_PR_ARENA_ALIGN]) just before it */
+  offset   = FW_PR_ARENA_ALIGN - (((FwPrCounterU4_t)block) % FW_PR_ARENA_ALIGN);
+  next     = block + offset;
+  next[-1] = (unsigned char)offset;
+
+  /* Carve the sections of the arena in the order in which they are laid out by FwPrGetArenaSize */
+  prDesc = (FwPrDesc_t)(void*)next;
+  next += PrArenaRound(sizeof(struct FwPrDesc));
+  prBase = (PrBaseDesc_t*)(void*)next;
+  next += PrArenaRound(sizeof(PrBaseDesc_t));
+  prBase->flows = (PrFlow_t*)(void*)next;
+  next += PrArenaRound(((FwPrCounterU4_t)(nOfFlows)) * sizeof(PrFlow_t));
+  prBase->aNodes = (PrANode_t*)(void*)next;
+  next += PrArenaRound(((FwPrCounterU4_t)(nOfANodes)) * sizeof(PrANode_t));
+  prDesc->prActions = (FwPrAction_t*)(void*)next;
+  next += PrArenaRound(((FwPrCounterU4_t)(nOfActions)) * sizeof(FwPrAction_t));
+  prDesc->prGuards = (FwPrGuard_t*)(void*)next;
+  next += PrArenaRound(((FwPrCounterU4_t)(nOfGuards + 1)) * sizeof(FwPrGuard_t));
+  prBase->dNodes = (nOfDNodes > 0) ? (PrDNode_t*)(void*)next : NULL;
+  next += PrArenaRound(((FwPrCounterU4_t)(nOfDNodes)) * sizeof(PrDNode_t));
+
+  prDesc->prBase = prBase;
+  PrInitDesc(prDesc, nOfANodes, nOfDNodes, nOfFlows, nOfActions, nOfGuards);
+
+  /* The execution table is reserved in the arena so that FwPrCompile does not allocate it */
+  prBase->execFlows = (PrExecFlow_t*)(void*)next;
 
   return prDesc;
 }
@@ -140,20 +618,21 @@ FwPrDesc_t FwPrCreateDer(FwPrDesc_t prDesc) {
     return NULL;
   }
 
-  /* Create array of actions in the derived SM */
+  extPrDesc->profile  = NULL;
+  extPrDesc->cfgIndex = NULL;
+  extPrDesc->memo     = NULL;
+  extPrDesc->shared   = 0;
+
+  /* Create arrays of actions and guards in the derived SM (NB: number of guards is guaranteed to be greater than 0 */
   extPrDesc->prActions = (FwPrAction_t*)malloc(((FwPrCounterU4_t)(prDesc->nOfActions)) * sizeof(FwPrAction_t));
-  if (extPrDesc->prActions == NULL) {
+  extPrDesc->prGuards  = (FwPrGuard_t*)malloc(((FwPrCounterU4_t)(prDesc->nOfGuards)) * sizeof(FwPrGuard_t));
+  if ((extPrDesc->prActions == NULL) || (extPrDesc->prGuards == NULL)) {
+    FwPrReleaseDer(extPrDesc);
     return NULL;
   }
   for (i = 0; i < prDesc->nOfActions; i++) {
     extPrDesc->prActions[i] = prDesc->prActions[i];
   }
-
-  /* Create array of guards in the derived SM (NB: number of guards is guaranteed to be greater than 0 */
-  extPrDesc->prGuards = (FwPrGuard_t*)malloc(((FwPrCounterU4_t)(prDesc->nOfGuards)) * sizeof(FwPrGuard_t));
-  if (extPrDesc->prGuards == NULL) {
-    return NULL;
-  }
   for (i = 0; i < prDesc->nOfGuards; i++) {
     extPrDesc->prGuards[i] = prDesc->prGuards[i];
   }
@@ -166,6 +645,38 @@ FwPrDesc_t FwPrCreateDer(FwPrDesc_t prDesc) {
   extPrDesc->nOfGuards   = prDesc->nOfGuards;
   extPrDesc->errCode     = prDesc->errCode;
   extPrDesc->nodeExecCnt = 0;
+  extPrDesc->isSuspended = 0;
+  extPrDesc->prExecCnt   = 0;
+
+  return extPrDesc;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+FwPrDesc_t FwPrCreateDerShared(FwPrDesc_t prDesc) {
+  FwPrDesc_t extPrDesc;
+
+  /* Create descriptor for derived procedure */
+  extPrDesc = (FwPrDesc_t)malloc(sizeof(struct FwPrDesc));
+  if (extPrDesc == NULL) {
+    return NULL;
+  }
+
+  /* Share the arrays of actions and guards of the base procedure */
+  extPrDesc->prActions   = prDesc->prActions;
+  extPrDesc->prGuards    = prDesc->prGuards;
+  extPrDesc->shared      = PR_SHARED_ACTIONS | PR_SHARED_GUARDS;
+  extPrDesc->profile     = NULL;
+  extPrDesc->cfgIndex    = NULL;
+  extPrDesc->memo        = NULL;
+  extPrDesc->prBase      = prDesc->prBase;
+  extPrDesc->curNode     = 0;
+  extPrDesc->prData      = NULL;
+  extPrDesc->flowCnt     = 0;
+  extPrDesc->nOfActions  = prDesc->nOfActions;
+  extPrDesc->nOfGuards   = prDesc->nOfGuards;
+  extPrDesc->errCode     = prDesc->errCode;
+  extPrDesc->nodeExecCnt = 0;
+  extPrDesc->isSuspended = 0;
   extPrDesc->prExecCnt   = 0;
 
   return extPrDesc;
@@ -192,6 +703,9 @@ void FwPrRelease(FwPrDesc_t prDesc) {
    * have at least one element, see operation FwPrCreate) */
   free(prBase->flows);
 
+  /* Release the execution table (this is only allocated if the procedure was compiled) */
+  free(prBase->execFlows);
+
   /* Release memory allocated to base descriptor */
   free(prDesc->prBase);
 
@@ -205,9 +719,22 @@ void FwPrRelease(FwPrDesc_t prDesc) {
 void FwPrReleaseDer(FwPrDesc_t prDesc) {
 
   /* Release pointer to the action and guard arrays (note that both arrays are guaranteed to
-   * have non-zero length) */
-  free(prDesc->prActions);
-  free(prDesc->prGuards);
+   * have non-zero length) unless they are shared with the base procedure */
+  if ((prDesc->shared & PR_SHARED_ACTIONS) == 0) {
+    free(prDesc->prActions);
+  }
+  if ((prDesc->shared & PR_SHARED_GUARDS) == 0) {
+    free(prDesc->prGuards);
+  }
+
+  /* Release the profiling data (this is only allocated if profiling was enabled) */
+  free(prDesc->profile);
+
+  /* Release the configuration index (this is only allocated until the configuration passes FwPrCheck) */
+  free(prDesc->cfgIndex);
+
+  /* Release the guard memo (this is only allocated if a guard was marked as pure) */
+  free(prDesc->memo);
 
   /* Release pointer to state machine descriptor */
   free(prDesc);
@@ -215,3 +742,123 @@ void FwPrReleaseDer(FwPrDesc_t prDesc) {
 
   return;
 }
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+static FwPrCounterU4_t PrImageLayOut(PrImageHeader_t* header) {
+  header->magic   = PR_IMAGE_MAGIC;
+  header->version = FW_PR_IMAGE_VERSION;
+  header->layout  = (FwPrCounterU4_t)((sizeof(PrANode_t) << 24) | (sizeof(PrDNode_t) << 16) |
+                                     (sizeof(PrFlow_t) << 8) | sizeof(PrArenaAlign_t));
+  header->checksum = 0;
+
+  header->aNodesOffset = PrArenaRound(sizeof(PrImageHeader_t));
+  header->dNodesOffset = header->aNodesOffset + PrArenaRound(header->nOfANodes * sizeof(PrANode_t));
+  header->flowsOffset     = header->dNodesOffset + PrArenaRound(header->nOfDNodes * sizeof(PrDNode_t));
+  header->execFlowsOffset = header->flowsOffset + PrArenaRound(header->nOfFlows * sizeof(PrFlow_t));
+  header->size            = header->execFlowsOffset + PrArenaRound(header->nOfFlows * sizeof(PrExecFlow_t));
+
+  return header->size;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+static FwPrCounterU4_t PrImageChecksum(const unsigned char* bytes, FwPrCounterU4_t n) {
+  FwPrCounterU4_t i;
+  FwPrCounterU4_t hash = 2166136261UL;
+
+  for (i = 0; i < n; i++) {
+    hash = ((hash ^ bytes[i]) * 16777619UL) & 0xFFFFFFFFUL;
+  }
+
+  return hash;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+static FwPrBool_t PrIsValidImage(const void* image, FwPrCounterU4_t imageSize) {
+  const PrImageHeader_t* header = (const PrImageHeader_t*)image;
+  PrImageHeader_t        layout;
+
+  if ((image == NULL) || ((((size_t)image) % sizeof(PrArenaAlign_t)) != 0) || (imageSize < sizeof(PrImageHeader_t))) {
+    return 0;
+  }
+
+  /* The counts are bounded by the image size before the layout is computed to avoid overflows */
+  if ((header->nOfANodes > imageSize / sizeof(PrANode_t)) || (header->nOfDNodes > imageSize / sizeof(PrDNode_t)) ||
+      (header->nOfFlows > imageSize / sizeof(PrFlow_t)) || (header->nOfANodes < 1) || (header->nOfFlows < 2)) {
+    return 0;
+  }
+  if ((header->nOfANodes > FW_PR_COUNTER_S1_MAX) || (header->nOfDNodes > FW_PR_COUNTER_S1_MAX) ||
+      (header->nOfFlows > FW_PR_COUNTER_S1_MAX) || (header->nOfActions > header->nOfANodes) ||
+      (header->nOfGuards >= FW_PR_COUNTER_S1_MAX)) {
+    return 0;
+  }
+
+  layout.nOfANodes = header->nOfANodes;
+  layout.nOfDNodes = header->nOfDNodes;
+  layout.nOfFlows  = header->nOfFlows;
+  PrImageLayOut(&layout);
+  if ((header->magic != layout.magic) || (header->version != layout.version) || (header->layout != layout.layout) ||
+      (header->size != layout.size) || (header->aNodesOffset != layout.aNodesOffset) ||
+      (header->dNodesOffset != layout.dNodesOffset) || (header->flowsOffset != layout.flowsOffset) ||
+      (header->execFlowsOffset != layout.execFlowsOffset) || (header->size > imageSize)) {
+    return 0;
+  }
+
+  if (header->checksum != PrImageChecksum((const unsigned char*)image + header->aNodesOffset,
+                                          header->size - header->aNodesOffset)) {
+    return 0;
+  }
+
+  return PrIsValidContent(header);
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+static FwPrBool_t PrIsValidContent(const PrImageHeader_t* header) {
+  const unsigned char* bytes      = (const unsigned char*)header;
+  const PrANode_t*     aNodes     = (const PrANode_t*)(const void*)(bytes + header->aNodesOffset);
+  const PrDNode_t*     dNodes     = (const PrDNode_t*)(const void*)(bytes + header->dNodesOffset);
+  const PrFlow_t*      flows      = (const PrFlow_t*)(const void*)(bytes + header->flowsOffset);
+  const PrExecFlow_t*  execFlows  = (const PrExecFlow_t*)(const void*)(bytes + header->execFlowsOffset);
+  FwPrCounterS1_t      nOfANodes  = (FwPrCounterS1_t)header->nOfANodes;
+  FwPrCounterS1_t      nOfDNodes  = (FwPrCounterS1_t)header->nOfDNodes;
+  FwPrCounterS1_t      nOfFlows   = (FwPrCounterS1_t)header->nOfFlows;
+  FwPrCounterS1_t      nOfActions = (FwPrCounterS1_t)header->nOfActions;
+  FwPrCounterS1_t      nOfGuards  = (FwPrCounterS1_t)header->nOfGuards;
+  const PrExecFlow_t*  execFlow;
+  FwPrCounterS1_t      i;
+
+  for (i = 0; i < nOfANodes; i++) {
+    if ((aNodes[i].iFlow < 0) || (aNodes[i].iFlow >= nOfFlows) || (aNodes[i].iAction < 0) ||
+        (aNodes[i].iAction >= nOfActions)) {
+      return 0;
+    }
+  }
+
+  for (i = 0; i < nOfDNodes; i++) {
+    if ((dNodes[i].outFlowIndex < 0) || (dNodes[i].nOfOutTrans < 0) ||
+        (dNodes[i].outFlowIndex > nOfFlows - dNodes[i].nOfOutTrans)) {
+      return 0;
+    }
+  }
+
+  for (i = 0; i < nOfFlows; i++) {
+    if ((flows[i].dest < -nOfDNodes) || (flows[i].dest > nOfANodes) || (flows[i].iGuard < 0) ||
+        (flows[i].iGuard > nOfGuards)) {
+      return 0;
+    }
+    execFlow = &(execFlows[i]);
+    if ((execFlow->dest < -nOfDNodes) || (execFlow->dest > nOfANodes) || (execFlow->iGuard < 0) ||
+        (execFlow->iGuard > nOfGuards)) {
+      return 0;
+    }
+    if ((execFlow->dest > 0) && ((execFlow->iAction < 0) || (execFlow->iAction >= nOfActions) ||
+                                 (execFlow->iNext < 0) || (execFlow->iNext >= nOfFlows))) {
+      return 0;
+    }
+    if ((execFlow->dest < 0) &&
+        ((execFlow->iNext < 0) || (execFlow->nOfNext < 0) || (execFlow->iNext > nOfFlows - execFlow->nOfNext))) {
+      return 0;
+    }
+  }
+
+  return 1;
+}
@@ -29,7 +29,23 @@
  * success of calls to <code>malloc</code>.
  * In case of failure, the function aborts and returns a NULL pointer.
  * Memory which had already been allocated at the time the function aborts,
- * is not released.
+ * is released.
+ *
+ * Function <code>::FwPrCreate</code> allocates each array of the procedure
+ * descriptor separately.
+ * Applications which create and release many procedures can instead use the
+ * arena creation functions (<code>::FwPrCreateArena</code> and
+ * <code>::FwPrCreateInBuffer</code>).
+ * These functions place the procedure descriptor and all its arrays in a single
+ * contiguous memory block (the arena) whose start is aligned to
+ * <code>#FW_PR_ARENA_ALIGN</code>.
+ * The arena is either allocated with one call to <code>malloc</code> or it is
+ * provided by the caller.
+ *
+ * The topology of a configured procedure (its action nodes, decision nodes and
+ * control flows) can be exported to a binary image with <code>::FwPrExportImage</code>.
+ * The image can be stored (e.g. in a file or in ROM) and procedures can later be
+ * loaded from it with <code>::FwPrLoadImage</code> without any configuration calls.
  *
  * Applications which do not wish to use dynamic memory allocation can
  * create a procedure descriptor statically using the services offered
@@ -52,13 +68,30 @@
 
 #include "FwPrConstants.h"
 
+/**
+ * The alignment in bytes of the procedure descriptors created by the arena
+ * creation functions.
+ * The default value is the size of a cache line on most current processors.
+ * The value must be a power of two in the range [8,128].
+ */
+#ifndef FW_PR_ARENA_ALIGN
+#define FW_PR_ARENA_ALIGN 64
+#endif
+
+/**
+ * The version of the format of the procedure images created by
+ * <code>::FwPrExportImage</code>.
+ * The version is stored in the image and <code>::FwPrLoadImage</code> rejects images
+ * which have a different version.
+ */
+#define FW_PR_IMAGE_VERSION 2
+
 /**
  * Create a new procedure descriptor.
  * This function creates the procedure descriptor and its internal data structures
  * dynamically through calls to <code>malloc</code>.
- * If any of these calls fails, the function aborts and returns NULL.
- * In this case, there may be a memory leak if part of the procedure descriptor memory
- * had been allocated before the function was aborted.
+ * If any of these calls fails, the function releases the memory it had already
+ * allocated and returns NULL.
  *
  * It is legal to create a procedure descriptor with no decision
  * nodes but it is not legal to create a procedure descriptor with no
@@ -76,7 +109,7 @@
  * @param nOfGuards the total number of control flow guards which the
  * user wishes to define for the procedure.
  * The total number of guards must be a non-negative integer not greater than the number
- * control flows.
+ * control flows and smaller than <code>#FW_PR_COUNTER_S1_MAX</code>.
  * If the same guard appears more than once in a procedure, it is counted only once.
  * @return the descriptor of the new procedure (or NULL if creation of the
  * data structures to hold the procedure descriptor failed or one of the
@@ -145,6 +178,182 @@ FwPrDesc_t FwPrCreate(FwPrCounterS1_t nOfANodes, FwPrCounterS1_t nOfDNodes, FwPr
  */
 FwPrDesc_t FwPrCreateDer(FwPrDesc_t prDesc);
 
+/**
+ * Create the descriptor of a derived procedure which shares the arrays of its base
+ * procedure.
+ * This function is functionally equivalent to <code>::FwPrCreateDer</code> but, instead
+ * of copying the action and guard arrays of the base procedure, the derived procedure
+ * points at them.
+ * A derived procedure only gets its own copy of its action array or guard array when it
+ * first modifies it (i.e. on the first call to <code>::FwPrOverrideAction</code> or
+ * <code>::FwPrOverrideGuard</code> respectively).
+ * A derived procedure which is never reconfigured therefore only allocates its
+ * descriptor.
+ *
+ * Since the arrays are shared, the base procedure must not be reconfigured or released
+ * as long as procedures derived from it with this function exist.
+ * If the copy of an array cannot be allocated, the reconfiguration function sets the
+ * error code of the derived procedure to <code>#prOutOfMemory</code>.
+ * The derived procedure is released with <code>::FwPrReleaseDer</code>.
+ * @param prDesc the descriptor of the base procedure. The base procedure
+ * should be a fully and correctly configured procedure (i.e. it should pass
+ * the <code>::FwPrCheck</code> configuration check).
+ * @return the descriptor of the derived procedure (or NULL if creation of the
+ * descriptor failed).
+ */
+FwPrDesc_t FwPrCreateDerShared(FwPrDesc_t prDesc);
+
+/**
+ * Return the size of the arena required to hold a procedure descriptor.
+ * The arena holds the procedure descriptor, its base descriptor and all their
+ * arrays.
+ * The returned size includes the space required to align the procedure
+ * descriptor to <code>#FW_PR_ARENA_ALIGN</code>.
+ * The parameters of this function are subject to the same constraints as the parameters
+ * of <code>::FwPrCreate</code>.
+ * @param nOfANodes the number of action nodes in the new procedure.
+ * @param nOfDNodes the number of decision nodes in the new procedure.
+ * @param nOfFlows the number of control flows in the new procedure.
+ * @param nOfActions the total number of actions in the new procedure.
+ * @param nOfGuards the total number of control flow guards in the new procedure.
+ * @return the size of the arena in bytes or zero if one of the function parameters
+ * had an illegal value.
+ */
+FwPrCounterU4_t FwPrGetArenaSize(FwPrCounterS1_t nOfANodes, FwPrCounterS1_t nOfDNodes, FwPrCounterS1_t nOfFlows,
+                                 FwPrCounterS1_t nOfActions, FwPrCounterS1_t nOfGuards);
+
+/**
+ * Create a new procedure descriptor in a single memory block.
+ * This function is functionally equivalent to <code>::FwPrCreate</code> but it allocates
+ * the procedure descriptor and all its internal data structures through one single
+ * call to <code>malloc</code>.
+ * The size of the allocated memory block is given by <code>::FwPrGetArenaSize</code>.
+ * The procedure descriptor is aligned to <code>#FW_PR_ARENA_ALIGN</code>.
+ *
+ * A procedure descriptor created by this function must be released with
+ * <code>::FwPrReleaseArena</code>.
+ * It must not be released with <code>::FwPrRelease</code>.
+ * Procedures derived from it with <code>::FwPrCreateDer</code> share its base
+ * descriptor and are therefore no longer usable after it has been released.
+ * @param nOfANodes the number of action nodes in the new procedure (a positive integer).
+ * @param nOfDNodes the number of decision nodes in the new procedure
+ * (a non-negative integer).
+ * @param nOfFlows the number of control flows in the new procedure (an
+ * integer greater than 1).
+ * @param nOfActions the total number of actions which the user wishes to define for the
+ * procedure (a positive integer not greater than the number of action nodes).
+ * @param nOfGuards the total number of control flow guards which the user wishes to define
+ * for the procedure (a non-negative integer not greater than the number control flows and
+ * smaller than <code>#FW_PR_COUNTER_S1_MAX</code>).
+ * @return the descriptor of the new procedure (or NULL if the allocation of the
+ * memory block failed or one of the function parameters had an illegal value).
+ */
+FwPrDesc_t FwPrCreateArena(FwPrCounterS1_t nOfANodes, FwPrCounterS1_t nOfDNodes, FwPrCounterS1_t nOfFlows,
+                           FwPrCounterS1_t nOfActions, FwPrCounterS1_t nOfGuards);
+
+/**
+ * Create a new procedure descriptor in a memory block provided by the caller.
+ * This function is functionally equivalent to <code>::FwPrCreateArena</code> but it does
+ * not allocate any memory: the procedure descriptor and all its internal data structures
+ * are placed in the argument buffer.
+ * The buffer must be at least as large as the value returned by
+ * <code>::FwPrGetArenaSize</code> for the same procedure parameters.
+ * No alignment constraints apply to the buffer.
+ *
+ * The buffer remains owned by the caller.
+ * The procedure descriptor must not be released: it becomes unusable when the
+ * buffer is released or re-used.
+ * @param buffer the memory block where the procedure descriptor is created.
+ * @param bufSize the size of the memory block in bytes.
+ * @param nOfANodes the number of action nodes in the new procedure (a positive integer).
+ * @param nOfDNodes the number of decision nodes in the new procedure
+ * (a non-negative integer).
+ * @param nOfFlows the number of control flows in the new procedure (an
+ * integer greater than 1).
+ * @param nOfActions the total number of actions which the user wishes to define for the
+ * procedure (a positive integer not greater than the number of action nodes).
+ * @param nOfGuards the total number of control flow guards which the user wishes to define
+ * for the procedure (a non-negative integer not greater than the number control flows and
+ * smaller than <code>#FW_PR_COUNTER_S1_MAX</code>).
+ * @return the descriptor of the new procedure (or NULL if the buffer is NULL or
+ * too small or if one of the function parameters had an illegal value).
+ */
+FwPrDesc_t FwPrCreateInBuffer(void* buffer, FwPrCounterU4_t bufSize, FwPrCounterS1_t nOfANodes,
+                              FwPrCounterS1_t nOfDNodes, FwPrCounterS1_t nOfFlows, FwPrCounterS1_t nOfActions,
+                              FwPrCounterS1_t nOfGuards);
+
+/**
+ * Return the size of the binary image of a procedure.
+ * The image is created by <code>::FwPrExportImage</code>.
+ * @param prDesc the descriptor of the procedure.
+ * @return the size of the image in bytes.
+ */
+FwPrCounterU4_t FwPrGetImageSize(FwPrDesc_t prDesc);
+
+/**
+ * Export the topology of a procedure to a binary image.
+ * The image holds the action nodes, the decision nodes, the control flows and the
+ * execution table of the procedure (i.e. the content of its base descriptor).
+ * It does not hold the actions, the guards or the data of the procedure.
+ * The actions and guards are referred to by their positions in the action and guard
+ * arrays of the procedure, which are the positions in which they were first added
+ * to the procedure during its configuration.
+ *
+ * The procedure is compiled with <code>::FwPrCompile</code> before the image is
+ * created and no image is created if this fails.
+ * Hence, the image always holds a checked topology and procedures loaded from it
+ * are already compiled.
+ *
+ * The image is position-independent: its sections are located through offsets from its
+ * start.
+ * It carries a version number (see <code>#FW_PR_IMAGE_VERSION</code>), a checksum and a
+ * description of the memory layout of the base descriptor arrays.
+ * It can only be loaded by an application which uses the same version of the FW
+ * Profile, the same index width (see <code>#FW_PR_INDEX_WIDTH</code>) and a processor
+ * with the same byte order and alignment rules.
+ * @param prDesc the descriptor of the procedure.
+ * @param buffer the buffer where the image is written (its start must be aligned like a
+ * pointer).
+ * @param bufSize the size of the buffer in bytes.
+ * @return the size of the image in bytes or zero if the buffer is NULL, misaligned or
+ * too small or if the procedure could not be compiled.
+ */
+FwPrCounterU4_t FwPrExportImage(FwPrDesc_t prDesc, void* buffer, FwPrCounterU4_t bufSize);
+
+/**
+ * Create a new procedure from a binary image created by <code>::FwPrExportImage</code>.
+ * The base descriptor of the new procedure uses the arrays of the image in place:
+ * they are neither copied nor modified.
+ * The image can therefore be located in read-only memory or in a memory-mapped file
+ * but it must remain valid and unchanged for as long as the procedure (or any procedure
+ * derived from it) is in use.
+ *
+ * The actions and guards of the new procedure are taken from the argument arrays.
+ * The i-th element of <code>actions</code> (<code>guards</code>) is bound to the
+ * action (guard) which was added in the i-th position to the exported procedure.
+ * The new procedure is allocated through one single call to <code>malloc</code>
+ * and it must be released with <code>::FwPrReleaseArena</code>.
+ *
+ * The new procedure behaves like a procedure derived from the exported procedure:
+ * it is already configured and its actions and guards can be overridden with
+ * <code>::FwPrOverrideAction</code> and <code>::FwPrOverrideGuard</code>.
+ * Its topology cannot be changed: the configuration functions which add nodes or
+ * control flows must not be called on it.
+ * @param image the image (its start must be aligned like a pointer).
+ * @param imageSize the size of the image in bytes.
+ * @param actions the actions of the procedure.
+ * @param nOfActions the number of elements of <code>actions</code>.
+ * @param guards the guards of the procedure (excluding the dummy guard).
+ * @param nOfGuards the number of elements of <code>guards</code>.
+ * @return the descriptor of the new procedure (or NULL if the image is misaligned,
+ * truncated or corrupted, if it was created with a different version or memory layout,
+ * if it holds an index which is out of the bounds of the array which it indexes,
+ * if the number of actions or guards does not match the image, if an action or guard
+ * is NULL or if the allocation of the memory block failed).
+ */
+FwPrDesc_t FwPrLoadImage(const void* image, FwPrCounterU4_t imageSize, const FwPrAction_t* actions,
+                         FwPrCounterS1_t nOfActions, const FwPrGuard_t* guards, FwPrCounterS1_t nOfGuards);
+
 /**
  * Release the memory which was allocated when the procedure descriptor was created.
  * After this operation is called, the procedure descriptor can no longer be used.
@@ -175,7 +384,8 @@ void FwPrRelease(FwPrDesc_t prDesc);
  *
  * Use of this function is subject to the following constraints:
  * - It should only be called on a procedure descriptor which was created using
- *   function <code>FwPrCreateDer</code>.
+ *   function <code>FwPrCreateDer</code> or <code>FwPrCreateDerShared</code> (in the latter
+ *   case, the arrays which are still shared with the base procedure are not released).
  * - It should only be called once on the same procedure descriptor.
  * - It should only be called on a procedure descriptor which is correctly configured.
  * .
@@ -184,4 +394,19 @@ void FwPrRelease(FwPrDesc_t prDesc);
  */
 void FwPrReleaseDer(FwPrDesc_t prDesc);
 
+/**
+ * Release the memory block which was allocated when a procedure descriptor was
+ * created with <code>::FwPrCreateArena</code> or <code>::FwPrLoadImage</code>.
+ * After this operation is called, the procedure descriptor can no longer be used.
+ * The memory is released with one single call to <code>free</code>.
+ * Derived procedures which share the base descriptor of the argument procedure
+ * are no longer usable after the function has been called.
+ *
+ * This function should only be called once on a procedure descriptor which was
+ * created using function <code>::FwPrCreateArena</code> or <code>::FwPrLoadImage</code>.
+ * Violation of this constraint may result in memory corruption.
+ * @param prDesc the descriptor of the procedure.
+ */
+void FwPrReleaseArena(FwPrDesc_t prDesc);
+
 #endif /* FWSM_DCREATE_H_ */
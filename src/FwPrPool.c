@@ -0,0 +1,382 @@
+/**
+ * @file
+ * @ingroup prGroup
+ * Implements the pool functions for the FW State Machine Module.
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2011, All Rights Reserved
+ *
+ * This file is part of the FW Profile.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#include "FwPrPool.h"
+#include "FwPrAux.h"
+#include "FwPrDCreate.h"
+#include "FwPrPrivate.h"
+#include <pthread.h>
+#include <stdlib.h>
+
+/** Number of procedures moved between a per-thread cache and the pool when the cache is empty or full. */
+#define PR_POOL_BATCH ((FW_PR_POOL_CACHE_SIZE + 1) / 2)
+
+/** Atomically add a value to a counter of a thread-safe pool and return the new value. */
+#define PR_POOL_ATOMIC_ADD(var, val) __sync_add_and_fetch(&(var), (val))
+/** Atomically subtract a value from a counter of a thread-safe pool and return the new value. */
+#define PR_POOL_ATOMIC_SUB(var, val) __sync_sub_and_fetch(&(var), (val))
+/** Atomically set a counter of a thread-safe pool to a new value if it holds an old value and return its old value. */
+#define PR_POOL_ATOMIC_CAS(var, oldVal, newVal) __sync_val_compare_and_swap(&(var), (oldVal), (newVal))
+
+/**
+ * Reset a procedure obtained from a pool to the state of a newly derived procedure.
+ * The actions and guards of the procedure are copied from the pool procedure.
+ * @param prDesc the procedure to be reset.
+ * @param poolPrDesc the procedure from which <code>prDesc</code> was derived.
+ */
+static void ResetPr(FwPrDesc_t prDesc, FwPrDesc_t poolPrDesc);
+
+/**
+ * Update the in-use counter and the high-water mark of a pool after a procedure has
+ * been obtained from it.
+ * @param pool the descriptor of the pool.
+ */
+static void AddInUse(FwPrPoolDesc_t pool);
+
+/**
+ * Return the per-thread cache of the calling thread for a thread-safe pool.
+ * If the calling thread does not yet own a cache, a cache which is not owned by any
+ * thread is assigned to it or, if there is no such cache, a new cache is created.
+ * @param pool the descriptor of the pool.
+ * @return the cache of the calling thread (or NULL if no cache could be assigned to it).
+ */
+static PrPoolCache_t* GetCache(FwPrPoolDesc_t pool);
+
+/**
+ * Return the procedures in a per-thread cache to its pool and make the cache
+ * available to other threads.
+ * This function is called when the thread which owns the cache terminates.
+ * Procedures which do not fit in the pool are released.
+ * @param cache the cache.
+ */
+static void ReleaseCache(void* cache);
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+FwPrPoolDesc_t FwPrPoolCreate(FwPrDesc_t prDesc, FwPrCounterU4_t nOfPrs, FwPrBool_t threadSafe) {
+  FwPrPoolDesc_t pool;
+  FwPrDesc_t     derPrDesc;
+
+  if (nOfPrs == 0) {
+    return NULL;
+  }
+
+  pool = (FwPrPoolDesc_t)malloc(sizeof(struct FwPrPool));
+  if (pool == NULL) {
+    return NULL;
+  }
+
+  pool->freePrs = (FwPrDesc_t*)malloc(nOfPrs * sizeof(FwPrDesc_t));
+  if (pool->freePrs == NULL) {
+    free(pool);
+    return NULL;
+  }
+
+  pool->prDesc     = prDesc;
+  pool->nOfFree    = 0;
+  pool->maxNOfFree = nOfPrs;
+  pool->nOfInUse   = 0;
+  pool->highWater  = 0;
+  pool->nOfMisses  = 0;
+  pool->threadSafe = threadSafe;
+  pool->caches     = NULL;
+
+  if (threadSafe) {
+    if (pthread_mutex_init(&(pool->mutex), NULL) != 0) {
+      free(pool->freePrs);
+      free(pool);
+      return NULL;
+    }
+    if (pthread_key_create(&(pool->cacheKey), ReleaseCache) != 0) {
+      (void)pthread_mutex_destroy(&(pool->mutex));
+      free(pool->freePrs);
+      free(pool);
+      return NULL;
+    }
+  }
+
+  while (pool->nOfFree < nOfPrs) {
+    derPrDesc = FwPrCreateDer(prDesc);
+    if (derPrDesc == NULL) {
+      FwPrPoolRelease(pool);
+      return NULL;
+    }
+    pool->freePrs[pool->nOfFree] = derPrDesc;
+    pool->nOfFree++;
+  }
+
+  return pool;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+FwPrDesc_t FwPrPoolGet(FwPrPoolDesc_t pool) {
+  FwPrDesc_t     prDesc = NULL;
+  PrPoolCache_t* cache  = NULL;
+
+  if (!pool->threadSafe) {
+    if (pool->nOfFree > 0) {
+      pool->nOfFree--;
+      prDesc = pool->freePrs[pool->nOfFree];
+    }
+  }
+  else {
+    cache = GetCache(pool);
+    if ((cache == NULL) || (cache->nOfPrs == 0)) {
+      /* Refill the cache from the pool (or take a procedure directly from the pool if there is no cache) */
+      (void)pthread_mutex_lock(&(pool->mutex));
+      if (cache != NULL) {
+        while ((pool->nOfFree > 0) && (cache->nOfPrs < PR_POOL_BATCH)) {
+          pool->nOfFree--;
+          cache->prDesc[cache->nOfPrs] = pool->freePrs[pool->nOfFree];
+          cache->nOfPrs++;
+        }
+      }
+      else if (pool->nOfFree > 0) {
+        pool->nOfFree--;
+        prDesc = pool->freePrs[pool->nOfFree];
+      }
+      (void)pthread_mutex_unlock(&(pool->mutex));
+    }
+    if ((cache != NULL) && (cache->nOfPrs > 0)) {
+      cache->nOfPrs--;
+      prDesc = cache->prDesc[cache->nOfPrs];
+    }
+  }
+
+  if (prDesc == NULL) {
+    prDesc = FwPrCreateDer(pool->prDesc);
+    if (prDesc == NULL) {
+      return NULL;
+    }
+    if (pool->threadSafe) {
+      (void)PR_POOL_ATOMIC_ADD(pool->nOfMisses, 1);
+    }
+    else {
+      pool->nOfMisses++;
+    }
+  }
+
+  AddInUse(pool);
+  return prDesc;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+FwPrErrCode_t FwPrPoolPut(FwPrPoolDesc_t pool, FwPrDesc_t prDesc) {
+  PrPoolCache_t* cache;
+  FwPrBool_t     release = 0;
+
+  if (prDesc->prBase != pool->prDesc->prBase) {
+    return prWrongBase;
+  }
+
+  ResetPr(prDesc, pool->prDesc);
+
+  if (!pool->threadSafe) {
+    if (pool->nOfFree < pool->maxNOfFree) {
+      pool->freePrs[pool->nOfFree] = prDesc;
+      pool->nOfFree++;
+    }
+    else {
+      FwPrReleaseDer(prDesc);
+    }
+    pool->nOfInUse--;
+    return prSuccess;
+  }
+
+  cache = GetCache(pool);
+  if ((cache != NULL) && (cache->nOfPrs < FW_PR_POOL_CACHE_SIZE)) {
+    cache->prDesc[cache->nOfPrs] = prDesc;
+    cache->nOfPrs++;
+  }
+  else {
+    /* Spill part of the cache to the pool (or return the procedure directly to the pool if there is no cache) */
+    (void)pthread_mutex_lock(&(pool->mutex));
+    if (cache != NULL) {
+      while ((cache->nOfPrs > FW_PR_POOL_CACHE_SIZE - PR_POOL_BATCH) && (pool->nOfFree < pool->maxNOfFree)) {
+        cache->nOfPrs--;
+        pool->freePrs[pool->nOfFree] = cache->prDesc[cache->nOfPrs];
+        pool->nOfFree++;
+      }
+    }
+    if ((cache != NULL) && (cache->nOfPrs < FW_PR_POOL_CACHE_SIZE)) {
+      cache->prDesc[cache->nOfPrs] = prDesc;
+      cache->nOfPrs++;
+    }
+    else if (pool->nOfFree < pool->maxNOfFree) {
+      pool->freePrs[pool->nOfFree] = prDesc;
+      pool->nOfFree++;
+    }
+    else {
+      release = 1;
+    }
+    (void)pthread_mutex_unlock(&(pool->mutex));
+    if (release) {
+      FwPrReleaseDer(prDesc);
+    }
+  }
+  (void)PR_POOL_ATOMIC_SUB(pool->nOfInUse, 1);
+  return prSuccess;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+FwPrCounterU4_t FwPrPoolGetNOfInUse(FwPrPoolDesc_t pool) {
+  return pool->nOfInUse;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+FwPrCounterU4_t FwPrPoolGetHighWater(FwPrPoolDesc_t pool) {
+  return pool->highWater;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+FwPrCounterU4_t FwPrPoolGetNOfMisses(FwPrPoolDesc_t pool) {
+  return pool->nOfMisses;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+void FwPrPoolRelease(FwPrPoolDesc_t pool) {
+  PrPoolCache_t* cache;
+
+  if (pool->threadSafe) {
+    (void)pthread_key_delete(pool->cacheKey);
+    while (pool->caches != NULL) {
+      cache = pool->caches;
+      while (cache->nOfPrs > 0) {
+        cache->nOfPrs--;
+        FwPrReleaseDer(cache->prDesc[cache->nOfPrs]);
+      }
+      pool->caches = cache->next;
+      free(cache);
+    }
+    (void)pthread_mutex_destroy(&(pool->mutex));
+  }
+
+  while (pool->nOfFree > 0) {
+    pool->nOfFree--;
+    FwPrReleaseDer(pool->freePrs[pool->nOfFree]);
+  }
+  free(pool->freePrs);
+  free(pool);
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+static void ResetPr(FwPrDesc_t prDesc, FwPrDesc_t poolPrDesc) {
+  FwPrCounterS1_t i;
+
+  for (i = 0; i < prDesc->nOfActions; i++) {
+    prDesc->prActions[i] = poolPrDesc->prActions[i];
+  }
+  for (i = 0; i < prDesc->nOfGuards; i++) {
+    prDesc->prGuards[i] = poolPrDesc->prGuards[i];
+  }
+
+  if (prDesc->profile != NULL) {
+    FwPrDisableProfile(prDesc);
+  }
+  free(prDesc->cfgIndex);
+  free(prDesc->memo);
+  prDesc->cfgIndex = NULL;
+  prDesc->memo     = NULL;
+
+  prDesc->curNode     = 0;
+  prDesc->prData      = NULL;
+  prDesc->flowCnt     = 0;
+  prDesc->errCode     = poolPrDesc->errCode;
+  prDesc->prExecCnt   = 0;
+  prDesc->nodeExecCnt = 0;
+  prDesc->isSuspended = 0;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+static void AddInUse(FwPrPoolDesc_t pool) {
+  FwPrCounterU4_t nOfInUse;
+  FwPrCounterU4_t highWater;
+  FwPrCounterU4_t oldHighWater;
+
+  if (!pool->threadSafe) {
+    pool->nOfInUse++;
+    if (pool->nOfInUse > pool->highWater) {
+      pool->highWater = pool->nOfInUse;
+    }
+    return;
+  }
+
+  nOfInUse  = PR_POOL_ATOMIC_ADD(pool->nOfInUse, 1);
+  highWater = PR_POOL_ATOMIC_ADD(pool->highWater, 0);
+  while (nOfInUse > highWater) {
+    oldHighWater = PR_POOL_ATOMIC_CAS(pool->highWater, highWater, nOfInUse);
+    if (oldHighWater == highWater) {
+      break;
+    }
+    highWater = oldHighWater;
+  }
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+static PrPoolCache_t* GetCache(FwPrPoolDesc_t pool) {
+  PrPoolCache_t* cache;
+
+  cache = (PrPoolCache_t*)pthread_getspecific(pool->cacheKey);
+  if (cache != NULL) {
+    return cache;
+  }
+
+  (void)pthread_mutex_lock(&(pool->mutex));
+  for (cache = pool->caches; cache != NULL; cache = cache->next) {
+    if (!cache->isOwned) {
+      break;
+    }
+  }
+  if (cache == NULL) {
+    cache = (PrPoolCache_t*)malloc(sizeof(PrPoolCache_t));
+    if (cache != NULL) {
+      cache->pool   = pool;
+      cache->nOfPrs = 0;
+      cache->next   = pool->caches;
+      pool->caches  = cache;
+    }
+  }
+  if (cache != NULL) {
+    cache->isOwned = 1;
+    if (pthread_setspecific(pool->cacheKey, cache) != 0) {
+      cache->isOwned = 0;
+      cache          = NULL;
+    }
+  }
+  (void)pthread_mutex_unlock(&(pool->mutex));
+
+  return cache;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+static void ReleaseCache(void* cache) {
+  PrPoolCache_t* prCache = (PrPoolCache_t*)cache;
+  FwPrPoolDesc_t pool    = prCache->pool;
+
+  (void)pthread_mutex_lock(&(pool->mutex));
+  while (prCache->nOfPrs > 0) {
+    prCache->nOfPrs--;
+    if (pool->nOfFree < pool->maxNOfFree) {
+      pool->freePrs[pool->nOfFree] = prCache->prDesc[prCache->nOfPrs];
+      pool->nOfFree++;
+    }
+    else {
+      FwPrReleaseDer(prCache->prDesc[prCache->nOfPrs]);
+    }
+  }
+  prCache->isOwned = 0;
+  (void)pthread_mutex_unlock(&(pool->mutex));
+}
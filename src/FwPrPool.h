@@ -0,0 +1,141 @@
+/**
+ * @file
+ * @ingroup prGroup
+ * Declaration of the pool interface for a FW State Machine.
+ * A procedure pool holds a set of procedures which are derived from the
+ * same procedure (the <i>pool procedure</i>) and which are handed out to
+ * and returned by applications which need procedures of the same type for a
+ * limited time.
+ *
+ * The basic mode of use of the functions declared in this file is as follows:
+ * -# The pool is created with function <code>::FwPrPoolCreate</code>.
+ * -# A procedure is obtained from the pool with function <code>::FwPrPoolGet</code>.
+ * -# The procedure is used like any other derived procedure.
+ * -# The procedure is returned to the pool with function <code>::FwPrPoolPut</code>.
+ * -# The pool is released with function <code>::FwPrPoolRelease</code>.
+ * .
+ * The procedures in the pool are created with <code>::FwPrCreateDer</code> when
+ * the pool is created.
+ * A procedure obtained from the pool is in the same state as a procedure
+ * newly created with <code>::FwPrCreateDer</code>.
+ * Obtaining a procedure from the pool and returning it to the pool do not
+ * normally allocate or release memory.
+ * If a procedure is requested when the pool is empty, a new procedure is
+ * created with <code>::FwPrCreateDer</code> (this is counted as a <i>miss</i>).
+ * If a procedure is returned when the pool is full, it is released with
+ * <code>::FwPrReleaseDer</code>.
+ *
+ * A pool can be created as a thread-safe pool.
+ * In that case, each thread which uses the pool holds up to
+ * #FW_PR_POOL_CACHE_SIZE free procedures in a private cache which it accesses
+ * without locking the pool.
+ * The pool is only locked when a cache is empty or full.
+ *
+ * The memory for the pool descriptor is allocated dynamically through calls
+ * to <code>malloc</code> and released through calls to <code>free</code>.
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2011, All Rights Reserved
+ *
+ * This file is part of the FW Profile.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#ifndef FWPR_POOL_H_
+#define FWPR_POOL_H_
+
+#include "FwPrCore.h"
+
+/**
+ * Create a new procedure pool.
+ * The pool is created for procedures derived from the argument procedure
+ * and it initially holds <code>nOfPrs</code> such procedures.
+ *
+ * The argument procedure should be fully and correctly configured (i.e. it should
+ * pass the configuration check implemented by <code>::FwPrCheck</code>) and it should
+ * not be modified or released as long as the pool exists.
+ * Compliance with these constraints is not checked by this function.
+ * @param prDesc the procedure from which the procedures in the pool are derived.
+ * @param nOfPrs the number of procedures held by the pool (a positive integer).
+ * @param threadSafe 1 if the pool is to be used by more than one thread, 0 otherwise.
+ * @return the descriptor of the new pool (or NULL if the creation of the data structures
+ * to hold the pool descriptor or of the procedures in the pool failed or if the
+ * number of procedures is zero).
+ */
+FwPrPoolDesc_t FwPrPoolCreate(FwPrDesc_t prDesc, FwPrCounterU4_t nOfPrs, FwPrBool_t threadSafe);
+
+/**
+ * Obtain a procedure from a procedure pool.
+ * The procedure is derived from the pool procedure and it is in the
+ * same state as a procedure newly created with <code>::FwPrCreateDer</code>:
+ * it is stopped, its execution counters are zero, its data are NULL and its actions
+ * and guards are those of the pool procedure.
+ * @param pool the descriptor of the pool.
+ * @return the descriptor of the procedure (or NULL if the pool is empty and the
+ * creation of a new procedure failed).
+ */
+FwPrDesc_t FwPrPoolGet(FwPrPoolDesc_t pool);
+
+/**
+ * Return a procedure to a procedure pool.
+ * The procedure should have been obtained from the same pool with
+ * <code>::FwPrPoolGet</code> and it should no longer be used after it has been
+ * returned.
+ * The procedure is reset to the state in which <code>::FwPrPoolGet</code> hands
+ * it out.
+ * This is done without executing any procedure action: a procedure which is
+ * still started is simply put back in the stopped state.
+ * Actions and guards overridden with <code>::FwPrOverrideAction</code> and
+ * <code>::FwPrOverrideGuard</code> are restored.
+ * @param pool the descriptor of the pool.
+ * @param prDesc the descriptor of the procedure to be returned to the pool.
+ * @return <code>#prSuccess</code> if the procedure was returned to the pool or
+ * <code>#prWrongBase</code> if the procedure does not share the base descriptor
+ * of the pool procedure (in this case, the procedure is not affected).
+ */
+FwPrErrCode_t FwPrPoolPut(FwPrPoolDesc_t pool, FwPrDesc_t prDesc);
+
+/**
+ * Return the number of procedures which have been obtained from a procedure
+ * pool and which have not yet been returned to it.
+ * @param pool the descriptor of the pool.
+ * @return the number of procedures in use.
+ */
+FwPrCounterU4_t FwPrPoolGetNOfInUse(FwPrPoolDesc_t pool);
+
+/**
+ * Return the high-water mark of a procedure pool.
+ * The high-water mark is the largest number of procedures which have been in use
+ * at the same time since the pool was created.
+ * @param pool the descriptor of the pool.
+ * @return the high-water mark of the pool.
+ */
+FwPrCounterU4_t FwPrPoolGetHighWater(FwPrPoolDesc_t pool);
+
+/**
+ * Return the number of misses of a procedure pool.
+ * A miss is a call to <code>::FwPrPoolGet</code> which cannot be served with a free
+ * procedure and which therefore creates a new procedure.
+ * @param pool the descriptor of the pool.
+ * @return the number of misses of the pool.
+ */
+FwPrCounterU4_t FwPrPoolGetNOfMisses(FwPrPoolDesc_t pool);
+
+/**
+ * Release the memory which was allocated when the procedure pool was created.
+ * The free procedures of the pool (including those held in the per-thread
+ * caches of a thread-safe pool) are released with <code>::FwPrReleaseDer</code>.
+ * Procedures which are in use are not affected and should be released by the
+ * application with <code>::FwPrReleaseDer</code>.
+ * This function should only be called when no other thread uses the pool.
+ * After this operation is called, the pool descriptor can no longer be used.
+ * @param pool the descriptor of the pool.
+ */
+void FwPrPoolRelease(FwPrPoolDesc_t pool);
+
+#endif /* FWPR_POOL_H_ */
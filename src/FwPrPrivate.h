@@ -46,6 +46,7 @@
 #define FWPR_PRIVATE_H_
 
 #include "FwPrConstants.h"
+#include <pthread.h>
 
 /**
  * Enumerated type for the type of a node in a procedure.
@@ -156,6 +157,40 @@ typedef struct {
   FwPrCounterS1_t iGuard;
 } PrFlow_t;
 
+/**
+ * Structure representing an entry in the execution table of a procedure.
+ * The execution table is built by <code>::FwPrCompile</code> and it has one entry
+ * for each control flow in the procedure (the i-th entry describes the i-th control
+ * flow in the control flow array of the base descriptor).
+ * An entry holds the destination and the guard of its control flow together with the
+ * information which <code>::FwPrExecute</code> needs to proceed from the destination
+ * of the control flow:
+ * - if the destination is an action node, <code>iAction</code> is the index of the
+ *   action of the node and <code>iNext</code> is the index of the control flow out of
+ *   the node (<code>nOfNext</code> is 1);
+ * - if the destination is a decision node, <code>iNext</code> is the index of the
+ *   first control flow out of the decision node and <code>nOfNext</code> is the number
+ *   of control flows out of the decision node;
+ * - if the destination is the final node, <code>iAction</code>, <code>iNext</code> and
+ *   <code>nOfNext</code> are zero.
+ * .
+ * The control flows out of a node are held in adjacent entries and an execution which
+ * passes through a chain of decision nodes therefore goes from entry to entry without
+ * accessing the arrays of action nodes and of decision nodes.
+ */
+typedef struct {
+  /** the index of the destination of the control flow (as in <code>::PrFlow_t</code>) */
+  FwPrCounterS1_t dest;
+  /** the index of the guard of the control flow (zero for the dummy guard) */
+  FwPrCounterS1_t iGuard;
+  /** the index of the action of the destination action node */
+  FwPrCounterS1_t iAction;
+  /** the index of the first control flow out of the destination node */
+  FwPrCounterS1_t iNext;
+  /** the number of control flows out of the destination node */
+  FwPrCounterS1_t nOfNext;
+} PrExecFlow_t;
+
 /**
  * Structure representing the base descriptor of a procedure.
  * The base descriptor holds the information which is not changed when the procedure
@@ -182,6 +217,13 @@ typedef struct {
  * holds the control flows out of the same node (see also
  * <code>::PrANode_t</code> and <code>::PrDNode_t</code>).
  * The number of control flows is stored in field <code>nOfFlows</code>.
+ *
+ * Array <code>execFlows</code> holds the execution table which is built by
+ * <code>::FwPrCompile</code> (see <code>::PrExecFlow_t</code>).
+ * The execution table has the same size as array <code>flows</code> and it is only
+ * used if field <code>isCompiled</code> is true.
+ * Since the execution table is part of the base descriptor, it is shared by all
+ * the procedures which are derived from the same base procedure.
  */
 typedef struct {
   /** array holding the action nodes in the procedure */
@@ -196,6 +238,10 @@ typedef struct {
   FwPrCounterS1_t nOfDNodes;
   /** the number of control flows in the procedure (excluding control flow from initial node) */
   FwPrCounterS1_t nOfFlows;
+  /** the execution table (or NULL if no execution table has yet been allocated) */
+  PrExecFlow_t* execFlows;
+  /** flag indicating whether the execution table is valid */
+  FwPrBool_t isCompiled;
 } PrBaseDesc_t;
 
 /**
@@ -251,6 +297,136 @@ typedef struct {
  * the procedure was started and the Node Execution Counter holds the number of cycle
  * since the current node was entered.
  */
+/**
+ * Structure holding the profiling data of a procedure.
+ * The profiling data are only collected if profiling has been enabled on the procedure
+ * with <code>::FwPrEnableProfile</code>.
+ * The profiling data belong to a procedure instance (they are not shared by the
+ * procedures which are derived from the same base procedure).
+ * The arrays of the profiling data are located immediately after the structure in
+ * the same block of memory and are indexed in the same way as the arrays of the
+ * base descriptor (see <code>::PrBaseDesc_t</code>):
+ * - Arrays <code>nodeExecCnt</code> and <code>nodeDwell</code> have one element
+ *   for each action node (the i-th action node is in the (i-1)-th location).
+ * - Arrays <code>flowTakenCnt</code>, <code>guardTrueCnt</code> and
+ *   <code>guardFalseCnt</code> have one element for each control flow (the element
+ *   in location i refers to the control flow in location i of the control flow array).
+ * .
+ * The time spent in an action node is only measured if a clock function has been
+ * provided.
+ * It is accumulated in the action node when the node is left.
+ */
+typedef struct {
+  /** the function which provides the time stamps (or NULL if times are not measured) */
+  FwPrProfileClock_t clock;
+  /** the time stamp of the entry into the current node */
+  FwPrCounterU4_t entryTime;
+  /** the number of times the action of each action node has been executed */
+  FwPrCounterU4_t* nodeExecCnt;
+  /** the total time spent in each action node */
+  FwPrCounterU4_t* nodeDwell;
+  /** the number of times each control flow has been taken */
+  FwPrCounterU4_t* flowTakenCnt;
+  /** the number of times the guard of each control flow has returned true */
+  FwPrCounterU4_t* guardTrueCnt;
+  /** the number of times the guard of each control flow has returned false */
+  FwPrCounterU4_t* guardFalseCnt;
+} PrProfile_t;
+
+/**
+ * Structure representing a hash table which maps the function pointers in an action
+ * or guard array to their locations in the array.
+ * The hash table uses open addressing with linear probing.
+ * Each entry holds the location in the array of one function pointer or -1 if the
+ * entry is empty.
+ * If the same function pointer is stored in more than one location, the hash table
+ * holds its first location.
+ * The locations of the array from <code>first</code> to <code>next-1</code> are
+ * non-NULL and are held in the hash table.
+ */
+typedef struct {
+  /** the entries of the hash table */
+  FwPrCounterS1_t* table;
+  /** the number of entries (a power of two which is at least twice the size of the array) */
+  FwPrCounterU4_t size;
+  /** the first location which is held in the hash table */
+  FwPrCounterS1_t first;
+  /** the first free location of the array */
+  FwPrCounterS1_t next;
+  /** flag indicating whether the same function pointer may be stored in more than one location */
+  FwPrBool_t hasDup;
+} PrFuncIndex_t;
+
+/**
+ * Structure representing the configuration index of a procedure.
+ * The configuration index allows actions and guards to be registered and overridden
+ * in constant time.
+ * It is built on demand by the configuration functions (see #FW_PR_CFG_INDEX_MIN) and
+ * it is released when the configuration of the procedure passes
+ * <code>::FwPrCheck</code>.
+ * The configuration index and its hash tables are allocated in one block of memory.
+ */
+typedef struct {
+  /** the hash table for the action array */
+  PrFuncIndex_t actions;
+  /** the hash table for the guard array */
+  PrFuncIndex_t guards;
+} PrCfgIndex_t;
+
+/**
+ * Structure representing the declaration of a declarative guard of a procedure
+ * (see <code>::FwPrSetGuardDecl</code>).
+ */
+typedef struct {
+  /** the operand of the guard (#prGuardOpndNone if the guard has no declaration) */
+  FwPrGuardOpnd_t opnd;
+  /** the comparison operator of the guard */
+  FwPrGuardOp_t op;
+  /** the offset in bytes of the operand in the procedure data */
+  FwPrCounterU4_t offset;
+  /** the constant against which the operand is compared */
+  long value;
+} PrGuardDecl_t;
+
+/**
+ * Structure representing the guard memo of a procedure.
+ * The guard memo caches the outcome of the guards which have been marked as pure
+ * (see <code>::FwPrSetGuardPure</code>) so that a pure guard is evaluated at most
+ * once between two executions of an action of the procedure.
+ * Each bitmask field has one bit for each location of the guard array: the
+ * i-th guard is represented by bit (i%8) of byte (i/8).
+ * A cached outcome is only used within the execution in which it was computed.
+ * The guard memo also holds the declarations of the declarative guards (see
+ * <code>::FwPrSetGuardDecl</code>) which are evaluated without calling the guards.
+ * The guard memo, its declarations and its bitmasks are allocated in one block of memory.
+ */
+typedef struct {
+  /** the declarations of the guards (one for each location of the guard array) */
+  PrGuardDecl_t* decl;
+  /** the bitmask of the guards which have been marked as pure */
+  FwPrCounterU1_t* pure;
+  /** the bitmask of the pure guards whose outcome is cached */
+  FwPrCounterU1_t* cached;
+  /** the bitmask of the cached outcomes (the bit is set if the guard was true) */
+  FwPrCounterU1_t* value;
+  /** the number of bytes in each bitmask */
+  FwPrCounterU4_t nOfBytes;
+  /** flag indicating whether at least one outcome is cached */
+  FwPrBool_t isCached;
+} PrGuardMemo_t;
+
+/**
+ * Flag of field <code>shared</code> of <code>::FwPrDesc</code> which is set if the action
+ * array is shared with the base procedure (see <code>::FwPrCreateDerShared</code>).
+ */
+#define PR_SHARED_ACTIONS 1
+
+/**
+ * Flag of field <code>shared</code> of <code>::FwPrDesc</code> which is set if the guard
+ * array is shared with the base procedure (see <code>::FwPrCreateDerShared</code>).
+ */
+#define PR_SHARED_GUARDS 2
+
 struct FwPrDesc {
   /** pointer to the base descriptor */
   PrBaseDesc_t* prBase;
@@ -274,6 +450,77 @@ struct FwPrDesc {
   FwPrCounterU3_t nodeExecCnt;
   /** the pointer to the data manipulated by the procedure actions and guards */
   void* prData;
+  /** the profiling data of the procedure (or NULL if profiling is disabled) */
+  PrProfile_t* profile;
+  /** the configuration index of the procedure (or NULL if it has not been built) */
+  PrCfgIndex_t* cfgIndex;
+  /** the guard memo of the procedure (or NULL if no guard has been marked as pure or declared) */
+  PrGuardMemo_t* memo;
+  /** the arrays which are shared with the base procedure (see #PR_SHARED_ACTIONS) */
+  FwPrCounterU1_t shared;
+  /** flag indicating whether the execution was suspended at the current node because its budget was exhausted */
+  FwPrBool_t isSuspended;
+};
+
+/**
+ * Structure representing the per-thread cache of a thread-safe procedure pool.
+ * A thread which uses a thread-safe pool owns one cache where it stores up to
+ * #FW_PR_POOL_CACHE_SIZE free procedures.
+ * The cache is accessed by its owner thread without locking the pool.
+ * The caches of a pool are linked in a list and they are released together with
+ * the pool.
+ * When its owner thread terminates, a cache returns its procedures to the pool
+ * and becomes available to other threads.
+ */
+typedef struct PrPoolCache {
+  /** the pool to which the cache belongs */
+  struct FwPrPool* pool;
+  /** the free procedures held in the cache */
+  FwPrDesc_t prDesc[FW_PR_POOL_CACHE_SIZE];
+  /** the number of free procedures held in the cache */
+  FwPrCounterU4_t nOfPrs;
+  /** flag indicating whether the cache is owned by a thread */
+  FwPrBool_t isOwned;
+  /** the next cache of the pool */
+  struct PrPoolCache* next;
+} PrPoolCache_t;
+
+/**
+ * Structure representing a procedure pool descriptor.
+ * A procedure pool holds procedures which are derived from the state
+ * machine stored in field <code>prDesc</code>.
+ * The free procedures of the pool are stored in the array <code>freePrs</code>
+ * which is used as a stack.
+ *
+ * If the pool is thread-safe, the array of free procedures and the list of
+ * caches are protected by <code>mutex</code> and each thread using the pool holds
+ * a pointer to its cache in the thread-specific data identified by
+ * <code>cacheKey</code>.
+ * The usage statistics are then updated with atomic operations.
+ */
+struct FwPrPool {
+  /** the procedure from which the procedures in the pool are derived */
+  FwPrDesc_t prDesc;
+  /** the free procedures of the pool */
+  FwPrDesc_t* freePrs;
+  /** the number of free procedures in <code>freePrs</code> */
+  FwPrCounterU4_t nOfFree;
+  /** the maximum number of free procedures in <code>freePrs</code> */
+  FwPrCounterU4_t maxNOfFree;
+  /** the number of procedures which have been obtained from the pool and not returned */
+  FwPrCounterU4_t nOfInUse;
+  /** the maximum value reached by <code>nOfInUse</code> */
+  FwPrCounterU4_t highWater;
+  /** the number of requests which were served by creating a new procedure */
+  FwPrCounterU4_t nOfMisses;
+  /** flag indicating whether the pool is thread-safe */
+  FwPrBool_t threadSafe;
+  /** the mutex protecting the pool (only used if the pool is thread-safe) */
+  pthread_mutex_t mutex;
+  /** the key of the per-thread caches (only used if the pool is thread-safe) */
+  pthread_key_t cacheKey;
+  /** the first per-thread cache of the pool */
+  PrPoolCache_t* caches;
 };
 
 #endif /* FWPR_PRIVATE_H_ */
@@ -25,6 +25,12 @@ void FwPrInit(FwPrDesc_t prDesc) {
   FwPrCounterS1_t i;
   PrBaseDesc_t*   prBase = prDesc->prBase;
 
+  /* The configuration index and the guard memo (if any) no longer match the action and guard arrays */
+  free(prDesc->cfgIndex);
+  free(prDesc->memo);
+  prDesc->cfgIndex = NULL;
+  prDesc->memo     = NULL;
+
   for (i = 0; i < prBase->nOfANodes; i++) {
     prBase->aNodes[i].iFlow = -1;
   }
@@ -36,6 +42,7 @@ void FwPrInit(FwPrDesc_t prDesc) {
   for (i = 0; i < prBase->nOfFlows; i++) {
     prBase->flows[i].iGuard = -1;
   }
+  prBase->isCompiled = 0;
 
   for (i = 0; i < prDesc->nOfActions; i++) {
     prDesc->prActions[i] = NULL;
@@ -85,7 +92,60 @@ void FwPrInitDer(FwPrDesc_t prDesc, FwPrDesc_t prDescBase) {
   prDesc->flowCnt     = 0;
   prDesc->curNode     = 0;
   prDesc->nodeExecCnt = 0;
+  prDesc->isSuspended = 0;
   prDesc->prExecCnt   = 0;
+  prDesc->profile     = NULL;
+
+  /* The configuration index and the guard memo (if any) no longer match the action and guard arrays */
+  free(prDesc->cfgIndex);
+  free(prDesc->memo);
+  prDesc->cfgIndex = NULL;
+  prDesc->memo     = NULL;
+
+  return;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+void FwPrInitConst(FwPrDesc_t prDesc, const FwPrAction_t* actions, const FwPrGuard_t* guards) {
+  FwPrCounterS1_t i;
+  PrBaseDesc_t*   prBase = prDesc->prBase;
+
+  /* The action and guard indices of the constant base descriptor must fit in the arrays */
+  for (i = 0; i < prBase->nOfANodes; i++) {
+    if (prBase->aNodes[i].iAction >= prDesc->nOfActions) {
+      prDesc->errCode = prWrongNOfActions;
+      return;
+    }
+  }
+  for (i = 0; i < prBase->nOfFlows; i++) {
+    if (prBase->flows[i].iGuard >= prDesc->nOfGuards) {
+      prDesc->errCode = prWrongNOfGuards;
+      return;
+    }
+  }
+
+  for (i = 0; i < prDesc->nOfActions; i++) {
+    prDesc->prActions[i] = actions[i];
+  }
+
+  prDesc->prGuards[0] = &PrDummyGuard;
+  for (i = 1; i < prDesc->nOfGuards; i++) {
+    prDesc->prGuards[i] = guards[i - 1];
+  }
+
+  prDesc->errCode     = prSuccess;
+  prDesc->flowCnt     = 0;
+  prDesc->curNode     = 0;
+  prDesc->nodeExecCnt = 0;
+  prDesc->isSuspended = 0;
+  prDesc->prExecCnt   = 0;
+  prDesc->profile     = NULL;
+
+  /* The configuration index and the guard memo (if any) no longer match the action and guard arrays */
+  free(prDesc->cfgIndex);
+  free(prDesc->memo);
+  prDesc->cfgIndex = NULL;
+  prDesc->memo     = NULL;
 
   return;
 }
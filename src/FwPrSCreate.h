@@ -40,6 +40,13 @@
  * initialized, it will normally need to be configured.
  * Configuration of a procedure descriptor can be done using the
  * functions described in the <code>FwPrConfig.h</code> file.
+ *
+ * The sizes passed to the instantiation macros (number of action nodes, decision nodes,
+ * control flows, actions and guards) must fit in the type <code>::FwPrCounterS1_t</code>.
+ * The number of guards must be smaller than <code>#FW_PR_COUNTER_S1_MAX</code> (because
+ * the macros reserve an additional location for the dummy guard).
+ * The width of <code>::FwPrCounterS1_t</code> is selected at build time through
+ * <code>#FW_PR_INDEX_WIDTH</code>.
  * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
  * @author Alessandro Pasetti <pasetti@pnp-software.com>
  * @copyright P&P Software GmbH, 2011, All Rights Reserved
@@ -72,6 +79,8 @@
  *   represent the array holding the procedure decision nodes.
  * - It defines an array of NFLOWS elements of type <code>PrFlow_t</code> to
  *   represent the array holding the procedure control flows.
+ * - It defines an array of NFLOWS elements of type <code>PrExecFlow_t</code> to
+ *   represent the execution table of the procedure (see <code>::FwPrCompile</code>).
  * - It defines an array of NA elements of type <code>PrAction_t</code> to
  *   represent the array holding the procedure actions.
  * - It defines an array of (NG+1) elements of type <code>PrGuard_t</code> to
@@ -99,15 +108,18 @@
  * @param NG a non-negative integer representing the number of guards (i.e. the
  * number of transition actions which are defined on the procedure)
  */
-#define FW_PR_INST(PR_DESC, N, NDEC, NFLOWS, NA, NG)                                                                 \
-  static PrANode_t    PR_DESC##_aNodes[(N)];                                                                         \
-  static PrDNode_t    PR_DESC##_dNodes[(NDEC)];                                                                      \
-  static PrFlow_t     PR_DESC##_flows[(NFLOWS)];                                                                     \
-  static FwPrAction_t PR_DESC##_actions[(NA)];                                                                       \
-  static FwPrGuard_t  PR_DESC##_guards[(NG) + 1];                                                                    \
-  static PrBaseDesc_t PR_DESC##_base = {(PR_DESC##_aNodes), (PR_DESC##_dNodes), (PR_DESC##_flows), N, NDEC, NFLOWS}; \
-  static struct FwPrDesc(PR_DESC)    = {                                                                             \
-      &(PR_DESC##_base), (PR_DESC##_actions), (PR_DESC##_guards), NA, (NG) + 1, 1, 0, prSuccess, 0, 0, NULL};
+#define FW_PR_INST(PR_DESC, N, NDEC, NFLOWS, NA, NG)                                                       \
+  static PrANode_t    PR_DESC##_aNodes[(N)];                                                               \
+  static PrDNode_t    PR_DESC##_dNodes[(NDEC)];                                                            \
+  static PrFlow_t     PR_DESC##_flows[(NFLOWS)];                                                           \
+  static PrExecFlow_t PR_DESC##_exec[(NFLOWS)];                                                            \
+  static FwPrAction_t PR_DESC##_actions[(NA)];                                                             \
+  static FwPrGuard_t  PR_DESC##_guards[(NG) + 1];                                                          \
+  static PrBaseDesc_t PR_DESC##_base = {(PR_DESC##_aNodes), (PR_DESC##_dNodes), (PR_DESC##_flows), N,      \
+                                        NDEC, NFLOWS, (PR_DESC##_exec), 0};                                \
+  static struct FwPrDesc(PR_DESC)    = {                                                                   \
+      &(PR_DESC##_base), (PR_DESC##_actions), (PR_DESC##_guards), NA, (NG) + 1, 1, 0, prSuccess, 0, 0,     \
+      NULL, NULL, NULL, NULL, 0, 0};
 
 /**
  * Instantiate a procedure descriptor and its internal data structure.
@@ -123,6 +135,8 @@
  *   represent the array holding the procedure action nodes.
  * - It defines an array of NFLOWS elements of type <code>PrFlow_t</code> to
  *   represent the array holding the procedure control flows.
+ * - It defines an array of NFLOWS elements of type <code>PrExecFlow_t</code> to
+ *   represent the execution table of the procedure (see <code>::FwPrCompile</code>).
  * - It defines an array of NA elements of type <code>PrAction_t</code> to
  *   represent the array holding the procedure actions.
  * - It defines an array of (NG+1) elements of type <code>PrGuard_t</code> to
@@ -150,14 +164,17 @@
  * @param NG a non-negative integer representing the number of guards (i.e. the
  * number of transition actions which are defined on the procedure)
  */
-#define FW_PR_INST_NODEC(PR_DESC, N, NFLOWS, NA, NG)                                                \
-  static PrANode_t    PR_DESC##_aNodes[(N)];                                                        \
-  static PrFlow_t     PR_DESC##_flows[(NFLOWS)];                                                    \
-  static FwPrAction_t PR_DESC##_actions[(NA)];                                                      \
-  static FwPrGuard_t  PR_DESC##_guards[(NG) + 1];                                                   \
-  static PrBaseDesc_t PR_DESC##_base = {(PR_DESC##_aNodes), NULL, (PR_DESC##_flows), N, 0, NFLOWS}; \
-  static struct FwPrDesc(PR_DESC)    = {                                                            \
-      &(PR_DESC##_base), (PR_DESC##_actions), (PR_DESC##_guards), NA, (NG) + 1, 1, 0, prSuccess, 0, 0, NULL};
+#define FW_PR_INST_NODEC(PR_DESC, N, NFLOWS, NA, NG)                                                                  \
+  static PrANode_t    PR_DESC##_aNodes[(N)];                                                                          \
+  static PrFlow_t     PR_DESC##_flows[(NFLOWS)];                                                                      \
+  static PrExecFlow_t PR_DESC##_exec[(NFLOWS)];                                                                       \
+  static FwPrAction_t PR_DESC##_actions[(NA)];                                                                        \
+  static FwPrGuard_t  PR_DESC##_guards[(NG) + 1];                                                                     \
+  static PrBaseDesc_t PR_DESC##_base = {(PR_DESC##_aNodes), NULL, (PR_DESC##_flows), N,                              \
+                                        0, NFLOWS, (PR_DESC##_exec), 0};                                             \
+  static struct FwPrDesc(PR_DESC)    = {                                                                              \
+      &(PR_DESC##_base), (PR_DESC##_actions), (PR_DESC##_guards), NA, (NG) + 1, 1, 0, prSuccess, 0, 0,                \
+      NULL, NULL, NULL, NULL, 0, 0};
 
 /**
  * Instantiate a descriptor for a derived procedure.
@@ -194,11 +211,55 @@
  * @param NA a non-negative integer representing the number of actions
  * @param NG a non-negative integer representing the number of guards
  */
-#define FW_PR_INST_DER(PR_DESC, NA, NG)           \
-  static FwPrAction_t PR_DESC##_actions[(NA)];    \
-  static FwPrGuard_t  PR_DESC##_guards[(NG) + 1]; \
-  static struct FwPrDesc(PR_DESC) = {             \
-      NULL, (PR_DESC##_actions), (PR_DESC##_guards), NA, (NG) + 1, 1, 0, prSuccess, 0, 0, NULL};
+#define FW_PR_INST_DER(PR_DESC, NA, NG)                                                   \
+  static FwPrAction_t PR_DESC##_actions[(NA)];                                            \
+  static FwPrGuard_t  PR_DESC##_guards[(NG) + 1];                                         \
+  static struct FwPrDesc(PR_DESC) = {                                                     \
+      NULL, (PR_DESC##_actions), (PR_DESC##_guards), NA, (NG) + 1, 1, 0, prSuccess, 0, 0, \
+      NULL, NULL, NULL, NULL, 0, 0};
+
+/**
+ * Instantiate a descriptor for a procedure whose base descriptor is a constant.
+ * The constant base descriptor PR_BASE is a variable of type <code>const PrBaseDesc_t</code>
+ * whose arrays are also constant.
+ * It is normally generated by <code>::FwPrGenerateConstBase</code> from a configured procedure
+ * and it can then be placed in read-only memory.
+ * The procedure instantiated by this macro uses the constant base descriptor in the
+ * same way as a derived procedure uses the base descriptor of its base procedure
+ * (see <code>#FW_PR_INST_DER</code>).
+ * Only the parts of the procedure descriptor which may change at run-time (its actions,
+ * guards, current node, execution counters, error code and data) are allocated in
+ * writable memory.
+ *
+ * More precisely, this macro generates code that does the following:
+ * - It declares the constant base descriptor PR_BASE as an <code>extern</code> variable.
+ * - It defines an array of NA elements of type <code>PrAction_t</code> to
+ *   represent the array holding the procedure actions.
+ * - It defines an array of (NG+1) elements of type <code>PrGuard_t</code> to
+ *   represent the array holding the procedure guards.
+ * - It defines and initializes a variable with the name PR_DESC of type
+ *   <code>struct FwPrDesc</code> to represent the procedure descriptor.
+ * .
+ * All variables defined by this macro are <code>static</code>.
+ *
+ * The procedure descriptor instantiated by the macro is only partially
+ * initialized.
+ * Full initialization is performed using function <code>::FwPrInitConst</code>.
+ *
+ * Since the macro includes the declaration of several variables, it should be located
+ * in the section of a c-file where variable declaration is legal.
+ *
+ * @param PR_DESC the variable holding the procedure descriptor
+ * @param PR_BASE the constant base descriptor
+ * @param NA a positive integer representing the number of actions
+ * @param NG a non-negative integer representing the number of guards
+ */
+#define FW_PR_INST_CONST(PR_DESC, PR_BASE, NA, NG)                                                                  \
+  extern const PrBaseDesc_t(PR_BASE);                                                                              \
+  static FwPrAction_t PR_DESC##_actions[(NA)];                                                                     \
+  static FwPrGuard_t  PR_DESC##_guards[(NG) + 1];                                                                  \
+  static struct FwPrDesc(PR_DESC) = {(PrBaseDesc_t*)&(PR_BASE), (PR_DESC##_actions), (PR_DESC##_guards), NA,       \
+                                     (NG) + 1, 0, 0, prSuccess, 0, 0, NULL, NULL, NULL, NULL, 0, 0};
 
 /**
  * Initialize a procedure descriptor to represent an unconfigured procedure
@@ -264,4 +325,31 @@ void FwPrInit(FwPrDesc_t prDesc);
  */
 void FwPrInitDer(FwPrDesc_t prDesc, FwPrDesc_t prDescBase);
 
+/**
+ * Initialize a procedure descriptor which has been instantiated with macro
+ * <code>#FW_PR_INST_CONST</code>.
+ * The actions and guards of the procedure are taken from the argument arrays.
+ * The i-th element of <code>actions</code> (<code>guards</code>) is bound to the
+ * action (guard) which was added in the i-th position to the procedure from which
+ * the constant base descriptor was generated.
+ * The argument arrays must therefore hold NA actions and NG guards (where NA and NG are
+ * the arguments of <code>#FW_PR_INST_CONST</code>).
+ *
+ * This function checks that the constant base descriptor does not refer to more actions
+ * or guards than the procedure descriptor holds.
+ * If this is not the case, the function sets the error code of the procedure
+ * descriptor to <code>#prWrongNOfActions</code> or <code>#prWrongNOfGuards</code> and
+ * returns.
+ * Otherwise, the function sets the state of the procedure to STOPPED.
+ *
+ * The procedure is then fully configured.
+ * Its actions and guards can be overridden with <code>::FwPrOverrideAction</code> and
+ * <code>::FwPrOverrideGuard</code>.
+ * The configuration functions which add nodes or control flows must not be called on it.
+ * @param prDesc the procedure descriptor to be initialized.
+ * @param actions the actions of the procedure.
+ * @param guards the guards of the procedure (excluding the dummy guard).
+ */
+void FwPrInitConst(FwPrDesc_t prDesc, const FwPrAction_t* actions, const FwPrGuard_t* guards);
+
 #endif /* FWPR_SCREATE_H_ */
@@ -0,0 +1,204 @@
+/**
+ * @file
+ * @ingroup prGroup
+ * Implements the snapshot functions for the FW Procedure Module.
+ * A snapshot consists of a header (see <code>::PrSnapHeader_t</code>) followed by
+ * an array of records (see <code>::PrSnapRecord_t</code>).
+ * The header and the records are copied to and from the snapshot with
+ * <code>memcpy</code> so that the snapshot buffers need not be aligned.
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2011, All Rights Reserved
+ *
+ * This file is part of the FW Profile.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#include "FwPrSnap.h"
+#include "FwPrPrivate.h"
+#include <string.h>
+
+/** The identifier of a full snapshot (stored in the <code>kind</code> field of its header). */
+#define PR_SNAP_FULL 0x50525346UL
+/** The identifier of a delta snapshot (stored in the <code>kind</code> field of its header). */
+#define PR_SNAP_DELTA 0x50525344UL
+
+/**
+ * The header of a snapshot.
+ */
+typedef struct {
+  /** the kind of snapshot (either <code>#PR_SNAP_FULL</code> or <code>#PR_SNAP_DELTA</code>) */
+  FwPrCounterU4_t kind;
+  /** the number of procedures from which the snapshot was taken */
+  FwPrCounterU4_t nOfPrs;
+  /** the number of records in the snapshot */
+  FwPrCounterU4_t nOfRecords;
+} PrSnapHeader_t;
+
+/**
+ * The record of the dynamic state of one procedure in a snapshot.
+ * In a full snapshot, the i-th record belongs to the i-th procedure.
+ * In a delta snapshot, the records are sorted by increasing position of their
+ * procedure.
+ */
+typedef struct {
+  /** the position of the procedure in the array of procedures */
+  FwPrCounterU4_t iPr;
+  /** the procedure execution counter */
+  FwPrCounterU3_t prExecCnt;
+  /** the node execution counter */
+  FwPrCounterU3_t nodeExecCnt;
+  /** the current node of the procedure */
+  FwPrCounterS1_t curNode;
+  /** the error code of the procedure */
+  FwPrErrCode_t errCode;
+  /** flag indicating whether the execution of the procedure is suspended by its budget */
+  FwPrBool_t isSuspended;
+} PrSnapRecord_t;
+
+/**
+ * Fill a record with the dynamic state of a procedure.
+ * @param prDesc the procedure.
+ * @param iPr the position of the procedure in the array of procedures.
+ * @param rec the record.
+ */
+static void FillRecord(FwPrDesc_t prDesc, FwPrCounterU4_t iPr, PrSnapRecord_t* rec);
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+FwPrCounterU4_t FwPrSnapGetSize(FwPrCounterU4_t nOfPrs) {
+  return (FwPrCounterU4_t)(sizeof(PrSnapHeader_t) + nOfPrs * sizeof(PrSnapRecord_t));
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+FwPrCounterU4_t FwPrSnapTake(const FwPrDesc_t* prDescs, FwPrCounterU4_t nOfPrs, void* buffer, FwPrCounterU4_t bufSize) {
+  PrSnapHeader_t  header;
+  PrSnapRecord_t  rec;
+  FwPrCounterU4_t i;
+  unsigned char*  records;
+
+  if ((buffer == NULL) || (bufSize < FwPrSnapGetSize(nOfPrs))) {
+    return 0;
+  }
+
+  records = (unsigned char*)buffer + sizeof(PrSnapHeader_t);
+  for (i = 0; i < nOfPrs; i++) {
+    FillRecord(prDescs[i], i, &rec);
+    memcpy(records + i * sizeof(PrSnapRecord_t), &rec, sizeof(PrSnapRecord_t));
+  }
+
+  header.kind       = PR_SNAP_FULL;
+  header.nOfPrs     = nOfPrs;
+  header.nOfRecords = nOfPrs;
+  memcpy(buffer, &header, sizeof(PrSnapHeader_t));
+  return FwPrSnapGetSize(nOfPrs);
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+FwPrCounterU4_t FwPrSnapTakeDelta(const FwPrDesc_t* prDescs, FwPrCounterU4_t nOfPrs, void* ref,
+                                  FwPrCounterU4_t refSize, void* buffer, FwPrCounterU4_t bufSize) {
+  PrSnapHeader_t  header;
+  PrSnapRecord_t  rec;
+  PrSnapRecord_t  refRec;
+  FwPrCounterU4_t i;
+  FwPrCounterU4_t nOfRecords;
+  FwPrCounterU4_t maxRecords;
+  unsigned char*  refRecords;
+  unsigned char*  records;
+
+  if ((buffer == NULL) || (bufSize < sizeof(PrSnapHeader_t)) || (ref == NULL) || (refSize != FwPrSnapGetSize(nOfPrs))) {
+    return 0;
+  }
+  memcpy(&header, ref, sizeof(PrSnapHeader_t));
+  if ((header.kind != PR_SNAP_FULL) || (header.nOfPrs != nOfPrs) || (header.nOfRecords != nOfPrs)) {
+    return 0;
+  }
+
+  /* Write the records of the procedures which differ from the reference snapshot */
+  refRecords = (unsigned char*)ref + sizeof(PrSnapHeader_t);
+  records    = (unsigned char*)buffer + sizeof(PrSnapHeader_t);
+  maxRecords = (FwPrCounterU4_t)((bufSize - sizeof(PrSnapHeader_t)) / sizeof(PrSnapRecord_t));
+  nOfRecords = 0;
+  for (i = 0; i < nOfPrs; i++) {
+    FillRecord(prDescs[i], i, &rec);
+    memcpy(&refRec, refRecords + i * sizeof(PrSnapRecord_t), sizeof(PrSnapRecord_t));
+    if ((rec.curNode != refRec.curNode) || (rec.prExecCnt != refRec.prExecCnt) ||
+        (rec.nodeExecCnt != refRec.nodeExecCnt) || (rec.errCode != refRec.errCode) ||
+        (rec.isSuspended != refRec.isSuspended)) {
+      if (nOfRecords == maxRecords) {
+        return 0;
+      }
+      memcpy(records + nOfRecords * sizeof(PrSnapRecord_t), &rec, sizeof(PrSnapRecord_t));
+      nOfRecords++;
+    }
+  }
+
+  /* Bring the reference snapshot up to date */
+  for (i = 0; i < nOfRecords; i++) {
+    memcpy(&rec, records + i * sizeof(PrSnapRecord_t), sizeof(PrSnapRecord_t));
+    memcpy(refRecords + rec.iPr * sizeof(PrSnapRecord_t), &rec, sizeof(PrSnapRecord_t));
+  }
+
+  header.kind       = PR_SNAP_DELTA;
+  header.nOfRecords = nOfRecords;
+  memcpy(buffer, &header, sizeof(PrSnapHeader_t));
+  return (FwPrCounterU4_t)(sizeof(PrSnapHeader_t) + nOfRecords * sizeof(PrSnapRecord_t));
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+FwPrBool_t FwPrSnapRestore(const FwPrDesc_t* prDescs, FwPrCounterU4_t nOfPrs, const void* snap,
+                           FwPrCounterU4_t snapSize) {
+  PrSnapHeader_t       header;
+  PrSnapRecord_t       rec;
+  FwPrCounterU4_t      i;
+  FwPrCounterU4_t      prevPr = 0;
+  const unsigned char* records;
+
+  if ((snap == NULL) || (snapSize < sizeof(PrSnapHeader_t))) {
+    return 0;
+  }
+  memcpy(&header, snap, sizeof(PrSnapHeader_t));
+  if (((header.kind != PR_SNAP_FULL) && (header.kind != PR_SNAP_DELTA)) || (header.nOfPrs != nOfPrs) ||
+      (header.nOfRecords > nOfPrs) || ((header.kind == PR_SNAP_FULL) && (header.nOfRecords != nOfPrs)) ||
+      (snapSize != sizeof(PrSnapHeader_t) + header.nOfRecords * sizeof(PrSnapRecord_t))) {
+    return 0;
+  }
+
+  /* Check all records before modifying the procedures */
+  records = (const unsigned char*)snap + sizeof(PrSnapHeader_t);
+  for (i = 0; i < header.nOfRecords; i++) {
+    memcpy(&rec, records + i * sizeof(PrSnapRecord_t), sizeof(PrSnapRecord_t));
+    if ((rec.iPr >= nOfPrs) || ((header.kind == PR_SNAP_FULL) && (rec.iPr != i)) || ((i > 0) && (rec.iPr <= prevPr))) {
+      return 0;
+    }
+    if ((rec.curNode < -1) || (rec.curNode > prDescs[rec.iPr]->prBase->nOfANodes)) {
+      return 0;
+    }
+    prevPr = rec.iPr;
+  }
+
+  for (i = 0; i < header.nOfRecords; i++) {
+    memcpy(&rec, records + i * sizeof(PrSnapRecord_t), sizeof(PrSnapRecord_t));
+    prDescs[rec.iPr]->curNode     = rec.curNode;
+    prDescs[rec.iPr]->prExecCnt   = rec.prExecCnt;
+    prDescs[rec.iPr]->nodeExecCnt = rec.nodeExecCnt;
+    prDescs[rec.iPr]->errCode     = rec.errCode;
+    prDescs[rec.iPr]->isSuspended = rec.isSuspended;
+  }
+  return 1;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+static void FillRecord(FwPrDesc_t prDesc, FwPrCounterU4_t iPr, PrSnapRecord_t* rec) {
+  memset(rec, 0, sizeof(PrSnapRecord_t));
+  rec->iPr         = iPr;
+  rec->prExecCnt   = prDesc->prExecCnt;
+  rec->nodeExecCnt = prDesc->nodeExecCnt;
+  rec->curNode     = prDesc->curNode;
+  rec->errCode     = prDesc->errCode;
+  rec->isSuspended = prDesc->isSuspended;
+}
@@ -0,0 +1,127 @@
+/**
+ * @file
+ * @ingroup prGroup
+ * Declaration of the snapshot interface for a FW Procedure.
+ * A snapshot is a compact binary record of the dynamic state of a set of procedures.
+ * The set of procedures is passed to the snapshot functions as an array of procedure
+ * descriptors.
+ * The dynamic state of a procedure consists of its current node, of its two execution
+ * counters (see <code>::FwPrGetExecCnt</code> and <code>::FwPrGetNodeExecCnt</code>),
+ * of its error code and of whether its execution was suspended by an exhausted budget
+ * (see <code>::FwPrExecuteBudget</code>).
+ * Snapshots are intended to be used to checkpoint the state of an application (e.g.
+ * for hot standby and failover) and to restore it without executing any procedure
+ * action.
+ *
+ * There are two kinds of snapshot:
+ * - A <i>full snapshot</i> holds one record for each procedure in the array.
+ *   It is created with <code>::FwPrSnapTake</code>.
+ * - A <i>delta snapshot</i> only holds records for the procedures whose dynamic
+ *   state has changed since the last checkpoint.
+ *   It is created with <code>::FwPrSnapTakeDelta</code> which compares the procedures
+ *   with a full snapshot of the last checkpoint (the <i>reference snapshot</i>) and
+ *   which brings the reference snapshot up to date.
+ * .
+ * Both kinds of snapshot are restored with <code>::FwPrSnapRestore</code>.
+ * A record refers to a procedure through its position in the array.
+ * Hence, snapshots can only be restored to an array of procedures of the same length
+ * and with the procedures in the same order.
+ * A snapshot does not hold the actions, guards, data or configuration of the
+ * procedures.
+ *
+ * Snapshots can be written to and read from buffers with any alignment.
+ * They can only be exchanged between applications which use the same version of the
+ * FW Profile, the same index width (see <code>#FW_PR_INDEX_WIDTH</code>) and processors
+ * with the same byte order.
+ *
+ * The functions declared in this header file do not allocate memory: all snapshots
+ * are held in buffers provided by the caller.
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2011, All Rights Reserved
+ *
+ * This file is part of the FW Profile.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#ifndef FWPR_SNAP_H_
+#define FWPR_SNAP_H_
+
+#include "FwPrCore.h"
+
+/**
+ * Return the size of a full snapshot of a set of procedures.
+ * This is also the largest possible size of a delta snapshot of the procedures.
+ * @param nOfPrs the number of procedures.
+ * @return the size of the snapshot in bytes.
+ */
+FwPrCounterU4_t FwPrSnapGetSize(FwPrCounterU4_t nOfPrs);
+
+/**
+ * Take a full snapshot of a set of procedures.
+ * The dynamic state of each procedure is written to the buffer.
+ * The procedures are not modified by this function.
+ * @param prDescs the array of procedure descriptors.
+ * @param nOfPrs the number of procedures in the array.
+ * @param buffer the buffer where the snapshot is written.
+ * @param bufSize the size of the buffer in bytes.
+ * @return the size of the snapshot in bytes or zero if the buffer is NULL or too small
+ * (see <code>::FwPrSnapGetSize</code>).
+ */
+FwPrCounterU4_t FwPrSnapTake(const FwPrDesc_t* prDescs, FwPrCounterU4_t nOfPrs, void* buffer, FwPrCounterU4_t bufSize);
+
+/**
+ * Take a delta snapshot of a set of procedures.
+ * The dynamic state of each procedure is compared with its record in the reference
+ * snapshot.
+ * The delta snapshot holds the records of the procedures whose dynamic state differs
+ * from their record in the reference snapshot.
+ * If the delta snapshot is successfully written to the buffer, these records are
+ * also updated in the reference snapshot.
+ * If the function fails, the reference snapshot is not modified.
+ *
+ * The reference snapshot must be a full snapshot which was taken from the same array
+ * of procedures with <code>::FwPrSnapTake</code> (and which may have been updated by
+ * earlier calls to this function).
+ * The procedures are not modified by this function.
+ * @param prDescs the array of procedure descriptors.
+ * @param nOfPrs the number of procedures in the array.
+ * @param ref the reference snapshot.
+ * @param refSize the size of the reference snapshot in bytes.
+ * @param buffer the buffer where the delta snapshot is written (it must not overlap
+ * the reference snapshot).
+ * @param bufSize the size of the buffer in bytes.
+ * @return the size of the delta snapshot in bytes or zero if the buffer is NULL or too
+ * small to hold the records of the procedures which have changed or if the reference
+ * snapshot is not a full snapshot of the procedures.
+ */
+FwPrCounterU4_t FwPrSnapTakeDelta(const FwPrDesc_t* prDescs, FwPrCounterU4_t nOfPrs, void* ref,
+                                  FwPrCounterU4_t refSize, void* buffer, FwPrCounterU4_t bufSize);
+
+/**
+ * Restore the dynamic state of a set of procedures from a full or delta snapshot.
+ * The dynamic state of each procedure which has a record in the snapshot is
+ * overwritten with the content of its record.
+ * The procedures which have no record in the snapshot are not modified.
+ * No action of the procedures is executed and their profiling data (if any) are not
+ * updated.
+ *
+ * The snapshot is checked before it is restored: if it is truncated or corrupted, if
+ * it was taken from a different number of procedures or if one of its records holds a
+ * current node which does not exist in its procedure, the function returns without
+ * modifying the procedures.
+ * @param prDescs the array of procedure descriptors.
+ * @param nOfPrs the number of procedures in the array.
+ * @param snap the snapshot.
+ * @param snapSize the size of the snapshot in bytes.
+ * @return 1 if the snapshot was restored or 0 if it was rejected.
+ */
+FwPrBool_t FwPrSnapRestore(const FwPrDesc_t* prDescs, FwPrCounterU4_t nOfPrs, const void* snap,
+                           FwPrCounterU4_t snapSize);
+
+#endif /* FWPR_SNAP_H_ */
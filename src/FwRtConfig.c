@@ -15,10 +15,21 @@
  * For information on alternative licensing, please contact P&P Software GmbH.
  */
 
+/* Needed for the scheduling, stack and mutex protocol attributes (and, on Linux, for the
+ * processor affinity) in an ANSI C build */
+#if defined(__linux__)
+#define _GNU_SOURCE
+#else
+#define _POSIX_C_SOURCE 200112L
+#endif
+
 #include "FwRtConfig.h"
 #include "FwRtConstants.h"
+#include <errno.h>
 #include <pthread.h>
+#include <sched.h>
 #include <stdlib.h>
+#include <string.h>
 
 /**
  * Dummy function which always returns 1.
@@ -28,6 +39,26 @@
  */
 FwRtOutcome_t DummyAction(FwRtDesc_t rtDesc);
 
+/**
+ * Apply the real-time settings of the Activation Thread to its attribute object.
+ * If real-time settings have been configured but no thread attributes have been
+ * loaded, the container's own thread attribute object is initialized and loaded.
+ * If a POSIX call fails, the error code and the container state are set.
+ * @param rtDesc the descriptor of the RT Container
+ * @return 1 if successful, 0 otherwise
+ */
+FwRtBool_t SetRtThreadAttr(FwRtDesc_t rtDesc);
+
+/**
+ * Apply the priority inheritance protocol to the attribute object of the container mutex.
+ * If the protocol has been configured but no mutex attributes have been loaded, the
+ * container's own mutex attribute object is initialized and loaded.
+ * If a POSIX call fails, the error code and the container state are set.
+ * @param rtDesc the descriptor of the RT Container
+ * @return 1 if successful, 0 otherwise
+ */
+FwRtBool_t SetRtMutexAttr(FwRtDesc_t rtDesc);
+
 void FwRtReset(FwRtDesc_t rtDesc) {
   rtDesc->state               = rtContUninitialized;
   rtDesc->activPrStarted      = 0;
@@ -46,6 +77,42 @@ void FwRtReset(FwRtDesc_t rtDesc) {
   rtDesc->pCondAttr           = NULL;
   rtDesc->pMutexAttr          = NULL;
   rtDesc->rtData              = NULL;
+  rtDesc->pool                = NULL;
+  rtDesc->nextReady           = NULL;
+  rtDesc->isQueued            = 0;
+  rtDesc->lockFreeNotif       = 0;
+  rtDesc->isParked            = 0;
+  rtDesc->coalesceNotif       = 0;
+  rtDesc->nOfCoalescedNotif   = 0;
+  rtDesc->isPeriodic          = 0;
+  rtDesc->nOfOverruns         = 0;
+  rtDesc->explicitSched       = 0;
+  rtDesc->schedPolicy         = 0;
+  rtDesc->schedPriority       = 0;
+  rtDesc->cpuMask             = 0;
+  rtDesc->prioInherit         = 0;
+  rtDesc->stack               = NULL;
+  rtDesc->stackSize           = 0;
+  rtDesc->memLock             = 0;
+  rtDesc->payloadSlots        = NULL;
+  rtDesc->nOfPayloadSlots     = 0;
+  rtDesc->multiProducer       = 0;
+  rtDesc->payloadHead         = 0;
+  rtDesc->payloadTail         = 0;
+
+  rtDesc->coalesceDelay.tv_sec  = 0;
+  rtDesc->coalesceDelay.tv_nsec = 0;
+  rtDesc->period.tv_sec         = 0;
+  rtDesc->period.tv_nsec        = 0;
+  rtDesc->phase.tv_sec          = 0;
+  rtDesc->phase.tv_nsec         = 0;
+  rtDesc->maxExecTime.tv_sec    = 0;
+  rtDesc->maxExecTime.tv_nsec   = 0;
+
+#ifdef FW_RT_STATS
+  memset(&(rtDesc->stats), 0, sizeof(FwRtStats_t));
+  rtDesc->isNotifTimeSet = 0;
+#endif
 }
 
 /*--------------------------------------------------------------------------------------*/
@@ -84,6 +151,14 @@ void FwRtInit(FwRtDesc_t rtDesc) {
     }
   }
 
+  /* Apply the real-time settings of the Activation Thread and of the mutex */
+  if (!SetRtThreadAttr(rtDesc)) {
+    return;
+  }
+  if (!SetRtMutexAttr(rtDesc)) {
+    return;
+  }
+
   /* Initialize mutex */
   if ((errCode = pthread_mutex_init(&(rtDesc->mutex), rtDesc->pMutexAttr)) != 0) {
     rtDesc->errCode = errCode;
@@ -176,6 +251,155 @@ pthread_condattr_t* FwRtGetCondAttr(FwRtDesc_t rtDesc) {
   return rtDesc->pCondAttr;
 }
 
+/* -------------------------------------------------------------------------------------*/
+void FwRtSetPool(FwRtDesc_t rtDesc, FwRtPoolDesc_t pool) {
+  if (rtDesc->state != rtContUninitialized) {
+    rtDesc->state = rtConfigErr;
+    return;
+  }
+  rtDesc->pool = pool;
+}
+
+/* -------------------------------------------------------------------------------------*/
+FwRtPoolDesc_t FwRtGetPool(FwRtDesc_t rtDesc) {
+  return rtDesc->pool;
+}
+
+/* -------------------------------------------------------------------------------------*/
+void FwRtSetLockFreeNotif(FwRtDesc_t rtDesc, FwRtBool_t lockFreeNotif) {
+  if (rtDesc->state != rtContUninitialized) {
+    rtDesc->state = rtConfigErr;
+    return;
+  }
+  rtDesc->lockFreeNotif = lockFreeNotif;
+}
+
+/* -------------------------------------------------------------------------------------*/
+FwRtBool_t FwRtIsLockFreeNotif(FwRtDesc_t rtDesc) {
+  return rtDesc->lockFreeNotif;
+}
+
+/* -------------------------------------------------------------------------------------*/
+void FwRtSetPayloadRing(FwRtDesc_t rtDesc, FwRtPayloadSlot_t* slots, FwRtCounterU4_t nOfSlots,
+                        FwRtBool_t multiProducer) {
+  FwRtCounterU4_t i;
+
+  if (rtDesc->state != rtContUninitialized) {
+    rtDesc->state = rtConfigErr;
+    return;
+  }
+  if ((slots != NULL) && ((nOfSlots == 0) || ((nOfSlots & (nOfSlots - 1)) != 0))) {
+    rtDesc->state = rtConfigErr;
+    return;
+  }
+
+  /* A free slot holds the position at which it is next filled */
+  for (i = 0; (slots != NULL) && (i < nOfSlots); i++) {
+    slots[i].payload = NULL;
+    slots[i].seq     = i;
+  }
+  rtDesc->payloadSlots    = slots;
+  rtDesc->nOfPayloadSlots = (slots != NULL) ? nOfSlots : 0;
+  rtDesc->multiProducer   = multiProducer;
+  rtDesc->payloadHead     = 0;
+  rtDesc->payloadTail     = 0;
+}
+
+/* -------------------------------------------------------------------------------------*/
+void FwRtSetNotifCoalescing(FwRtDesc_t rtDesc, FwRtBool_t coalesceNotif, const struct timespec* maxDelay) {
+  if (rtDesc->state != rtContUninitialized) {
+    rtDesc->state = rtConfigErr;
+    return;
+  }
+  rtDesc->coalesceNotif = coalesceNotif;
+  if (maxDelay != NULL) {
+    rtDesc->coalesceDelay = *maxDelay;
+  } else {
+    rtDesc->coalesceDelay.tv_sec  = 0;
+    rtDesc->coalesceDelay.tv_nsec = 0;
+  }
+}
+
+/* -------------------------------------------------------------------------------------*/
+FwRtBool_t FwRtIsNotifCoalescing(FwRtDesc_t rtDesc) {
+  return rtDesc->coalesceNotif;
+}
+
+/* -------------------------------------------------------------------------------------*/
+void FwRtSetPeriodic(FwRtDesc_t rtDesc, const struct timespec* period, const struct timespec* phase) {
+  if (rtDesc->state != rtContUninitialized) {
+    rtDesc->state = rtConfigErr;
+    return;
+  }
+  if ((period == NULL) || ((period->tv_sec == 0) && (period->tv_nsec == 0))) {
+    rtDesc->isPeriodic     = 0;
+    rtDesc->period.tv_sec  = 0;
+    rtDesc->period.tv_nsec = 0;
+  } else {
+    rtDesc->isPeriodic = 1;
+    rtDesc->period     = *period;
+  }
+  if (phase != NULL) {
+    rtDesc->phase = *phase;
+  } else {
+    rtDesc->phase.tv_sec  = 0;
+    rtDesc->phase.tv_nsec = 0;
+  }
+}
+
+/* -------------------------------------------------------------------------------------*/
+FwRtBool_t FwRtIsPeriodic(FwRtDesc_t rtDesc) {
+  return rtDesc->isPeriodic;
+}
+
+/* -------------------------------------------------------------------------------------*/
+void FwRtSetSchedPolicy(FwRtDesc_t rtDesc, int policy, int priority) {
+  if (rtDesc->state != rtContUninitialized) {
+    rtDesc->state = rtConfigErr;
+    return;
+  }
+  rtDesc->explicitSched = 1;
+  rtDesc->schedPolicy   = policy;
+  rtDesc->schedPriority = priority;
+}
+
+/* -------------------------------------------------------------------------------------*/
+void FwRtSetCpuAffinity(FwRtDesc_t rtDesc, unsigned long cpuMask) {
+  if (rtDesc->state != rtContUninitialized) {
+    rtDesc->state = rtConfigErr;
+    return;
+  }
+  rtDesc->cpuMask = cpuMask;
+}
+
+/* -------------------------------------------------------------------------------------*/
+void FwRtSetPrioInherit(FwRtDesc_t rtDesc, FwRtBool_t prioInherit) {
+  if (rtDesc->state != rtContUninitialized) {
+    rtDesc->state = rtConfigErr;
+    return;
+  }
+  rtDesc->prioInherit = prioInherit;
+}
+
+/* -------------------------------------------------------------------------------------*/
+void FwRtSetStack(FwRtDesc_t rtDesc, void* stack, size_t stackSize) {
+  if (rtDesc->state != rtContUninitialized) {
+    rtDesc->state = rtConfigErr;
+    return;
+  }
+  rtDesc->stack     = stack;
+  rtDesc->stackSize = stackSize;
+}
+
+/* -------------------------------------------------------------------------------------*/
+void FwRtSetMemLock(FwRtDesc_t rtDesc, FwRtBool_t memLock) {
+  if (rtDesc->state != rtContUninitialized) {
+    rtDesc->state = rtConfigErr;
+    return;
+  }
+  rtDesc->memLock = memLock;
+}
+
 /* -------------------------------------------------------------------------------------*/
 void FwRtSetData(FwRtDesc_t rtDesc, void* rtData) {
   rtDesc->rtData = rtData;
@@ -263,3 +487,91 @@ FwRtOutcome_t DummyAction(FwRtDesc_t rtDesc) {
   (void)(rtDesc);
   return 1;
 }
+
+/* -------------------------------------------------------------------------------------*/
+FwRtBool_t SetRtThreadAttr(FwRtDesc_t rtDesc) {
+  struct sched_param param;
+  int                errCode = 0;
+#if defined(__linux__)
+  cpu_set_t    cpuSet;
+  unsigned int i;
+#endif
+
+  if ((rtDesc->explicitSched == 0) && (rtDesc->cpuMask == 0) && (rtDesc->stackSize == 0)) {
+    return 1;
+  }
+
+  if (rtDesc->pThreadAttr == NULL) {
+    if ((errCode = pthread_attr_init(&(rtDesc->threadAttr))) != 0) {
+      rtDesc->errCode = errCode;
+      rtDesc->state   = rtThreadAttrInitErr;
+      return 0;
+    }
+    rtDesc->pThreadAttr = &(rtDesc->threadAttr);
+  }
+
+  if (rtDesc->explicitSched == 1) {
+    param.sched_priority = rtDesc->schedPriority;
+    if ((errCode = pthread_attr_setinheritsched(rtDesc->pThreadAttr, PTHREAD_EXPLICIT_SCHED)) == 0) {
+      if ((errCode = pthread_attr_setschedpolicy(rtDesc->pThreadAttr, rtDesc->schedPolicy)) == 0) {
+        errCode = pthread_attr_setschedparam(rtDesc->pThreadAttr, &param);
+      }
+    }
+  }
+
+  if ((errCode == 0) && (rtDesc->stackSize != 0)) {
+    if (rtDesc->stack != NULL) {
+      /* Touch the whole stack so that no page fault occurs when the thread runs */
+      memset(rtDesc->stack, 0, rtDesc->stackSize);
+      errCode = pthread_attr_setstack(rtDesc->pThreadAttr, rtDesc->stack, rtDesc->stackSize);
+    } else {
+      errCode = pthread_attr_setstacksize(rtDesc->pThreadAttr, rtDesc->stackSize);
+    }
+  }
+
+  if ((errCode == 0) && (rtDesc->cpuMask != 0)) {
+#if defined(__linux__)
+    CPU_ZERO(&cpuSet);
+    for (i = 0; i < 8 * sizeof(unsigned long); i++) {
+      if (((rtDesc->cpuMask >> i) & 1UL) == 1UL) {
+        CPU_SET(i, &cpuSet);
+      }
+    }
+    errCode = pthread_attr_setaffinity_np(rtDesc->pThreadAttr, sizeof(cpu_set_t), &cpuSet);
+#else
+    errCode = ENOTSUP;
+#endif
+  }
+
+  if (errCode != 0) {
+    rtDesc->errCode = errCode;
+    rtDesc->state   = rtThreadAttrSetErr;
+    return 0;
+  }
+  return 1;
+}
+
+/* -------------------------------------------------------------------------------------*/
+FwRtBool_t SetRtMutexAttr(FwRtDesc_t rtDesc) {
+  int errCode;
+
+  if (rtDesc->prioInherit == 0) {
+    return 1;
+  }
+
+  if (rtDesc->pMutexAttr == NULL) {
+    if ((errCode = pthread_mutexattr_init(&(rtDesc->mutexAttr))) != 0) {
+      rtDesc->errCode = errCode;
+      rtDesc->state   = rtMutexAttrInitErr;
+      return 0;
+    }
+    rtDesc->pMutexAttr = &(rtDesc->mutexAttr);
+  }
+
+  if ((errCode = pthread_mutexattr_setprotocol(rtDesc->pMutexAttr, PTHREAD_PRIO_INHERIT)) != 0) {
+    rtDesc->errCode = errCode;
+    rtDesc->state   = rtMutexAttrSetErr;
+    return 0;
+  }
+  return 1;
+}
@@ -13,10 +13,16 @@
  * -# The container descriptor is reset with function <code>::FwRtReset</code>.
  * -# The attributes of the container's POSIX objects may be set with
  *    function <code>::FwRtSetPosixAttr</code>.
+ * -# The real-time settings of the Activation Thread and of the container mutex
+ *    may be set with functions <code>::FwRtSetSchedPolicy</code>,
+ *    <code>::FwRtSetCpuAffinity</code>, <code>::FwRtSetStack</code>,
+ *    <code>::FwRtSetPrioInherit</code> and <code>::FwRtSetMemLock</code>.
  * -# The pointers to the procedure functions which implement the adaptation
  *    points of the container may be set with function <code>FwRtSetProcActions</code>.
  * -# The pointer to the RT Container data in the container descriptor
  *    may be set with the <code>::FwRtSetData</code> function.
+ * -# The container may be attached to a RT Pool with function
+ *    <code>::FwRtSetPool</code>.
  * -# The container is initialized with function <code>::FwRtInit</code>.
  *    This completes the configuration process.
  * .
@@ -58,6 +64,13 @@
  * - The container state is set to: <code>::rtContUninitialized</code>.
  * - The state of the Activation and Notification Procedures is set to: STOPPED.
  * - The pointer to the container data is set to NULL.
+ * - The container is not attached to any RT Pool.
+ * - The lock-free notification mode is disabled.
+ * - The notification coalescing mode is disabled.
+ * - The periodic activation mode is disabled.
+ * - No real-time settings are defined for the Activation Thread and for the container
+ *   mutex (the default scheduling policy, processor affinity and stack are used, the
+ *   mutex does not use priority inheritance and the memory is not locked).
  * .
  * @param rtDesc the descriptor of the RT Container
  */
@@ -75,6 +88,11 @@ void FwRtReset(FwRtDesc_t rtDesc);
  *   functions (<code>pthread_attr_init</code>, <code>pthread_mutexattr_init</code>,
  *   and <code>pthread_condattr_init</code>) and then the initialized attributes
  *   are used to initialize the mutex and the condition variable.
+ * - The real-time settings of the Activation Thread (see <code>::FwRtSetSchedPolicy</code>,
+ *   <code>::FwRtSetCpuAffinity</code> and <code>::FwRtSetStack</code>) and of the mutex
+ *   (see <code>::FwRtSetPrioInherit</code>) are applied to the initialized attributes
+ *   or, if no attributes have been loaded, to the container's own attribute objects
+ *   which are then used in their place.
  * - If no attributes have been loaded for the container's POSIX mutex and
  *   condition variable (i.e. if the user has not called function
  *   <code>::FwRtSetPosixAttr</code> or he has called it with NULL values for
@@ -193,6 +211,322 @@ pthread_mutexattr_t* FwRtGetMutexAttr(FwRtDesc_t rtDesc);
  */
 pthread_condattr_t* FwRtGetCondAttr(FwRtDesc_t rtDesc);
 
+/**
+ * Attach the RT Container to a RT Pool.
+ * By default, a RT Container has its own Activation Thread which is created by
+ * <code>::FwRtStart</code>.
+ * If the container is attached to a RT Pool, no Activation Thread is created
+ * and the Activation Procedure is instead executed by one of the worker threads
+ * of the pool (see <code>FwRtPool.h</code>).
+ * The Notification Procedure and the Activation Procedure and their adaptation
+ * points are the same in both cases.
+ *
+ * The pool must have been initialized with <code>::FwRtPoolInit</code> before
+ * the container is started and it must not be shut down while the container is
+ * STARTED.
+ * A value of NULL detaches the container from its pool.
+ *
+ * This function may only be called before the container is initialized.
+ * If it is called after the container has been initialized, the container
+ * state is set to <code>::rtConfigErr</code>.
+ * @param rtDesc the descriptor of the RT Container.
+ * @param pool the descriptor of the RT Pool (or NULL).
+ */
+void FwRtSetPool(FwRtDesc_t rtDesc, FwRtPoolDesc_t pool);
+
+/**
+ * Get the RT Pool to which the container is attached.
+ * This function returns the value set with <code>::FwRtSetPool</code> or NULL
+ * if the container has its own Activation Thread.
+ * @param rtDesc the descriptor of the RT Container.
+ * @return the descriptor of the RT Pool (or NULL).
+ */
+FwRtPoolDesc_t FwRtGetPool(FwRtDesc_t rtDesc);
+
+/**
+ * Enable or disable the lock-free notification mode of the RT Container.
+ * By default, <code>::FwRtNotify</code> locks the container mutex, executes the
+ * Notification Procedure and, if the Activation Thread is to be notified, signals
+ * the container's condition variable.
+ * In the lock-free notification mode, <code>::FwRtNotify</code> does not lock the
+ * container mutex while the Activation Thread is busy:
+ * - the Implement Notification Logic action is executed without the container mutex
+ *   (it may therefore be executed concurrently with other notifications and with the
+ *   Activation Procedure and it must protect the data it shares with them);
+ * - the Notification Counter is incremented with an atomic operation; and
+ * - the parked flag of the Activation Thread is read with an atomic operation and the
+ *   container mutex is only locked, to signal the condition variable, if the Activation
+ *   Thread is waiting for a notification.
+ * .
+ * The start-up and the termination of the Notification Procedure (i.e. the notifications
+ * received before the container is started or after its Activation Procedure has
+ * terminated) are still executed with the container mutex locked.
+ * If the latency instrumentation is enabled, the time of a notification is only recorded
+ * when it wakes up the Activation Thread.
+ *
+ * The lock-free notification mode requires compiler support for atomic operations
+ * (the GCC <code>__sync</code> built-ins).
+ * If this support is not available, or if the container is attached to a RT Pool,
+ * the setting is ignored and <code>::FwRtNotify</code> always locks the container mutex.
+ *
+ * This function may only be called before the container is initialized.
+ * If it is called after the container has been initialized, the container
+ * state is set to <code>::rtConfigErr</code>.
+ * @param rtDesc the descriptor of the RT Container.
+ * @param lockFreeNotif 1 to enable the lock-free notification mode, 0 to disable it.
+ */
+void FwRtSetLockFreeNotif(FwRtDesc_t rtDesc, FwRtBool_t lockFreeNotif);
+
+/**
+ * Return the value of the lock-free notification flag of the RT Container.
+ * @param rtDesc the descriptor of the RT Container.
+ * @return 1 if the lock-free notification mode is enabled, 0 otherwise.
+ */
+FwRtBool_t FwRtIsLockFreeNotif(FwRtDesc_t rtDesc);
+
+/**
+ * Attach a payload ring to the RT Container.
+ * The payload ring is a bounded queue through which the notifiers pass payloads (e.g.
+ * pointers to the buffers filled by a device driver) to the Activation Procedure without
+ * copying them and without locking the container mutex:
+ * - a notifier passes a payload with <code>::FwRtNotifyWithPayload</code> which puts
+ *   the payload in the ring and then notifies the container as <code>::FwRtNotify</code>;
+ * - the container actions of the Activation Procedure (and in particular the Execute
+ *   Functional Behaviour action) take the payloads from the ring in the order in which
+ *   they were passed with <code>::FwRtTakePayload</code>.
+ * .
+ * The ring only holds the payload pointers: the ownership of the payload passes from
+ * the notifier to the Activation Procedure when the payload is put in the ring.
+ * Payloads remain in the ring until they are taken: a payload which is passed to the
+ * container while a notification is skipped by the Implement Notification Logic action,
+ * or while the container is stopped, is taken with the next payloads.
+ * In the notification coalescing mode, one execution of the Activation Procedure
+ * consumes several notifications and should therefore take all pending payloads.
+ *
+ * The slots of the ring are allocated by the user and the number of slots must be a
+ * power of two.
+ * The ring has a single consumer (the Activation Procedure).
+ * If <code>multiProducer</code> is 0, payloads may only be passed to the container by
+ * one thread at a time; otherwise they may be passed by any number of threads
+ * concurrently.
+ * The ring uses the GCC <code>__sync</code> built-ins.
+ * If these are not available, the ring operations are executed with the container
+ * mutex locked.
+ *
+ * This function may only be called before the container is initialized.
+ * If it is called after the container has been initialized, or if the number of
+ * slots is not a power of two, the container state is set to <code>::rtConfigErr</code>.
+ * @param rtDesc the descriptor of the RT Container.
+ * @param slots the slots of the payload ring (or NULL to remove the payload ring).
+ * @param nOfSlots the number of slots of the payload ring.
+ * @param multiProducer 1 if payloads may be passed by more than one thread concurrently,
+ * 0 otherwise.
+ */
+void FwRtSetPayloadRing(FwRtDesc_t rtDesc, FwRtPayloadSlot_t* slots, FwRtCounterU4_t nOfSlots,
+                        FwRtBool_t multiProducer);
+
+/**
+ * Enable or disable the notification coalescing mode of the RT Container.
+ * By default, each notification which is accepted by the Implement Notification
+ * Logic action increments the Notification Counter and causes one execution of
+ * the Activation Procedure.
+ * In the notification coalescing mode, the Activation Procedure instead consumes
+ * all pending notifications at once:
+ * - when the Activation Thread is released, it optionally waits for up to
+ *   <code>maxDelay</code> for further notifications to arrive (the wait is cut
+ *   short if the container is stopped);
+ * - it then resets the Notification Counter and executes the Activation Procedure
+ *   once for all the notifications received so far;
+ * - the number of notifications consumed by this execution can be retrieved by
+ *   the container actions with <code>::FwRtGetNOfCoalescedNotif</code>.
+ * .
+ * Thus, <code>maxDelay</code> bounds the additional latency introduced by the
+ * coalescing of notifications.
+ * In this mode, the Notification Counter saturates at
+ * <code>#FW_RT_COUNTER_U2_MAX</code> instead of overflowing.
+ *
+ * For containers attached to a RT Pool, the worker threads never wait and
+ * <code>maxDelay</code> is ignored.
+ *
+ * This function may only be called before the container is initialized.
+ * If it is called after the container has been initialized, the container
+ * state is set to <code>::rtConfigErr</code>.
+ * @param rtDesc the descriptor of the RT Container.
+ * @param coalesceNotif 1 to enable the notification coalescing mode, 0 to disable it.
+ * @param maxDelay the maximum coalescing delay (a value of NULL is equivalent to a
+ * delay of zero).
+ */
+void FwRtSetNotifCoalescing(FwRtDesc_t rtDesc, FwRtBool_t coalesceNotif, const struct timespec* maxDelay);
+
+/**
+ * Return the value of the notification coalescing flag of the RT Container.
+ * @param rtDesc the descriptor of the RT Container.
+ * @return 1 if the notification coalescing mode is enabled, 0 otherwise.
+ */
+FwRtBool_t FwRtIsNotifCoalescing(FwRtDesc_t rtDesc);
+
+/**
+ * Set the periodic activation mode of the RT Container.
+ * By default, the Activation Thread of a RT Container is only released by the
+ * notifications sent to the container with <code>::FwRtNotify</code>.
+ * If the periodic activation mode is enabled, the Activation Thread is instead
+ * released at regular intervals of length <code>period</code>.
+ * The first release occurs <code>phase</code> after the container is started and the
+ * following releases occur at absolute deadlines which are computed from the first
+ * release (the activation instants therefore do not drift with the execution time
+ * of the Activation Procedure).
+ * The Activation Thread waits for its deadlines with <code>clock_nanosleep</code>
+ * on the monotonic clock.
+ *
+ * At each release, the Activation Thread consumes all pending notifications and
+ * executes the Activation Procedure once (the number of consumed notifications,
+ * which may be zero, can be retrieved with <code>::FwRtGetNOfCoalescedNotif</code>).
+ * The Notification Counter saturates at <code>#FW_RT_COUNTER_U2_MAX</code>.
+ * A stop request (see <code>::FwRtStop</code>) is processed at the next release.
+ *
+ * In the periodic activation mode, the container also monitors its deadlines:
+ * - if the Activation Procedure is still executing when one or more releases are
+ *   due, these releases are skipped and counted as overruns (see
+ *   <code>::FwRtGetNOfOverruns</code>);
+ * - the longest execution time of the Execute Functional Behaviour action is
+ *   recorded (see <code>::FwRtGetMaxExecTime</code>).
+ * .
+ * The notification coalescing delay (see <code>::FwRtSetNotifCoalescing</code>) is
+ * not used in the periodic activation mode.
+ * Containers attached to a RT Pool ignore the periodic activation mode.
+ *
+ * This function may only be called before the container is initialized.
+ * If it is called after the container has been initialized, the container
+ * state is set to <code>::rtConfigErr</code>.
+ * @param rtDesc the descriptor of the RT Container.
+ * @param period the activation period (a value of NULL or a period of zero disables
+ * the periodic activation mode).
+ * @param phase the offset of the first release from the start of the container (a
+ * value of NULL is equivalent to an offset of zero).
+ */
+void FwRtSetPeriodic(FwRtDesc_t rtDesc, const struct timespec* period, const struct timespec* phase);
+
+/**
+ * Return the value of the periodic activation flag of the RT Container.
+ * @param rtDesc the descriptor of the RT Container.
+ * @return 1 if the periodic activation mode is enabled, 0 otherwise.
+ */
+FwRtBool_t FwRtIsPeriodic(FwRtDesc_t rtDesc);
+
+/**
+ * Set the scheduling policy and priority of the Activation Thread.
+ * The policy and priority are applied to the thread attributes when the container
+ * is initialized with <code>::FwRtInit</code>, together with the
+ * <code>PTHREAD_EXPLICIT_SCHED</code> inheritance attribute (the Activation Thread
+ * therefore does not inherit the scheduling parameters of the thread which calls
+ * <code>::FwRtStart</code>).
+ * If no thread attributes have been loaded with <code>::FwRtSetPosixAttr</code>,
+ * the container uses its own attribute object.
+ *
+ * Real-time policies (<code>SCHED_FIFO</code> or <code>SCHED_RR</code>) normally
+ * require special privileges: if the caller does not have them, the creation of the
+ * Activation Thread fails and the container is put in state
+ * <code>::rtThreadCreateErr</code>.
+ * If the policy or priority is not supported, <code>::FwRtInit</code> puts the
+ * container in state <code>::rtThreadAttrSetErr</code>.
+ *
+ * This function may only be called before the container is initialized.
+ * If it is called after the container has been initialized, the container
+ * state is set to <code>::rtConfigErr</code>.
+ * @param rtDesc the descriptor of the RT Container.
+ * @param policy the scheduling policy (e.g. <code>SCHED_FIFO</code>).
+ * @param priority the scheduling priority.
+ */
+void FwRtSetSchedPolicy(FwRtDesc_t rtDesc, int policy, int priority);
+
+/**
+ * Set the processors on which the Activation Thread may run.
+ * Bit i of the mask represents processor i and a mask of zero leaves the processor
+ * affinity of the Activation Thread unchanged (this is the default).
+ * The affinity is applied to the thread attributes when the container is initialized
+ * with <code>::FwRtInit</code>.
+ * If no thread attributes have been loaded with <code>::FwRtSetPosixAttr</code>,
+ * the container uses its own attribute object.
+ * Processor affinity is only supported on Linux: on other platforms, or if the mask
+ * does not designate any available processor, <code>::FwRtInit</code> or
+ * <code>::FwRtStart</code> fail with a thread attribute or thread creation error.
+ *
+ * This function may only be called before the container is initialized.
+ * If it is called after the container has been initialized, the container
+ * state is set to <code>::rtConfigErr</code>.
+ * @param rtDesc the descriptor of the RT Container.
+ * @param cpuMask the mask of the processors on which the Activation Thread may run.
+ */
+void FwRtSetCpuAffinity(FwRtDesc_t rtDesc, unsigned long cpuMask);
+
+/**
+ * Enable or disable the priority inheritance protocol of the container mutex.
+ * If the protocol is enabled, the <code>PTHREAD_PRIO_INHERIT</code> protocol is
+ * applied to the mutex attributes when the container is initialized with
+ * <code>::FwRtInit</code>.
+ * This bounds the priority inversion which a high-priority Activation Thread
+ * may suffer when the mutex is held by a lower-priority notifying thread.
+ * If no mutex attributes have been loaded with <code>::FwRtSetPosixAttr</code>,
+ * the container uses its own attribute object.
+ * If the protocol is not supported, <code>::FwRtInit</code> puts the container in
+ * state <code>::rtMutexAttrSetErr</code>.
+ *
+ * This function may only be called before the container is initialized.
+ * If it is called after the container has been initialized, the container
+ * state is set to <code>::rtConfigErr</code>.
+ * @param rtDesc the descriptor of the RT Container.
+ * @param prioInherit 1 to enable the priority inheritance protocol, 0 to disable it.
+ */
+void FwRtSetPrioInherit(FwRtDesc_t rtDesc, FwRtBool_t prioInherit);
+
+/**
+ * Set the stack of the Activation Thread.
+ * If <code>stack</code> is not NULL, the Activation Thread uses the buffer provided by
+ * the caller as its stack.
+ * The buffer is prefaulted (i.e. all its pages are written) when the container is
+ * initialized with <code>::FwRtInit</code> so that the Activation Thread does not
+ * incur page faults on its stack when it runs.
+ * The buffer must satisfy the alignment and size constraints of
+ * <code>pthread_attr_setstack</code> and it must remain allocated until the container
+ * has been shut down.
+ * If <code>stack</code> is NULL, the stack is allocated by the POSIX library with
+ * the given size.
+ * A size of zero selects the default stack of the POSIX library (this is the default).
+ * If no thread attributes have been loaded with <code>::FwRtSetPosixAttr</code>,
+ * the container uses its own attribute object.
+ * If the stack is rejected, <code>::FwRtInit</code> puts the container in state
+ * <code>::rtThreadAttrSetErr</code>.
+ *
+ * This function may only be called before the container is initialized.
+ * If it is called after the container has been initialized, the container
+ * state is set to <code>::rtConfigErr</code>.
+ * @param rtDesc the descriptor of the RT Container.
+ * @param stack the stack buffer (or NULL if the stack is allocated by the POSIX library).
+ * @param stackSize the size of the stack in bytes (or zero for the default stack).
+ */
+void FwRtSetStack(FwRtDesc_t rtDesc, void* stack, size_t stackSize);
+
+/**
+ * Enable or disable the locking of the memory of the process when the container is
+ * started.
+ * If memory locking is enabled, <code>::FwRtStart</code> calls <code>mlockall</code>
+ * with the <code>MCL_CURRENT</code> and <code>MCL_FUTURE</code> flags before starting
+ * the container procedures.
+ * All the pages of the process (including the stack of the Activation Thread) then
+ * remain resident in memory.
+ * Memory locking normally requires special privileges: if <code>mlockall</code>
+ * fails, the container is put in state <code>::rtMemLockErr</code>.
+ * Memory locking applies to the whole process and is not undone when the container
+ * is stopped.
+ *
+ * This function may only be called before the container is initialized.
+ * If it is called after the container has been initialized, the container
+ * state is set to <code>::rtConfigErr</code>.
+ * @param rtDesc the descriptor of the RT Container.
+ * @param memLock 1 to enable memory locking, 0 to disable it.
+ */
+void FwRtSetMemLock(FwRtDesc_t rtDesc, FwRtBool_t memLock);
+
 /**
  * Set the pointer to the RT Container data in the container descriptor.
  * The container data are data which are manipulated by the container's
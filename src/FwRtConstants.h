@@ -30,6 +30,9 @@
  */
 typedef struct FwRtDesc* FwRtDesc_t;
 
+/** Forward declaration for the pointer to a RT Pool Descriptor. */
+typedef struct FwRtPool* FwRtPoolDesc_t;
+
 /** Type used for booleans (0 is "false" and 1 is "true"). */
 typedef int FwRtBool_t;
 
@@ -39,6 +42,53 @@ typedef int FwRtOutcome_t;
 /** Type used for unsigned integers with a "medium" range. */
 typedef short int FwRtCounterU2_t;
 
+/**
+ * The largest value of a <code>::FwRtCounterU2_t</code> counter.
+ * In the notification coalescing mode (see <code>::FwRtSetNotifCoalescing</code>),
+ * the Notification Counter saturates at this value.
+ */
+#define FW_RT_COUNTER_U2_MAX 32767
+
+/** Type used for unsigned integers with a "long" range. */
+typedef long unsigned int FwRtCounterU4_t;
+
+/**
+ * The number of bins of the latency histograms of a RT Container.
+ * Bin 0 counts the values 0 and 1, bin i (for i greater than zero) counts the values
+ * in the interval [2^i, 2^(i+1)) and the last bin also counts all larger values.
+ */
+#define FW_RT_N_OF_HIST_BINS 32
+
+/**
+ * Structure holding the latency histograms of a RT Container.
+ * The histograms are only updated if the RT Container module is built with the
+ * symbol <code>FW_RT_STATS</code> defined (see <code>::FwRtGetStats</code>).
+ */
+typedef struct {
+  /** The histogram of the delays in nanoseconds from a notification to the wake-up of the Activation Procedure. */
+  FwRtCounterU4_t wakeLatency[FW_RT_N_OF_HIST_BINS];
+  /** The histogram of the execution times in nanoseconds of the Execute Functional Behaviour action. */
+  FwRtCounterU4_t execTime[FW_RT_N_OF_HIST_BINS];
+  /** The histogram of the values of the Notification Counter at the wake-up of the Activation Procedure. */
+  FwRtCounterU4_t queueDepth[FW_RT_N_OF_HIST_BINS];
+  /** The number of wake-ups of the Activation Procedure. */
+  FwRtCounterU4_t nOfWakeUps;
+} FwRtStats_t;
+
+/**
+ * Structure representing a slot of the payload ring of a RT Container.
+ * The payload ring is an optional bounded queue of payload pointers which are passed
+ * from the notifiers to the Activation Procedure (see <code>::FwRtSetPayloadRing</code>).
+ * The slots are allocated by the user and managed by the container: the user should
+ * not access their fields.
+ */
+typedef struct {
+  /** The payload held in the slot. */
+  void* payload;
+  /** The sequence number which indicates whether the slot is free or holds a payload. */
+  FwRtCounterU4_t seq;
+} FwRtPayloadSlot_t;
+
 /**
  * Type for a pointer to a container action.
  * A container action is a function which encapsulates an action executed by
@@ -99,7 +149,15 @@ typedef enum {
   /** A configuration function has been called during the container's normal operation
    * (i.e. after <code>::FwRtInit</code> has been called but before <code>::FwRtShutdown</code>
    * is called) */
-  rtConfigErr = 21
+  rtConfigErr = 21,
+  /** The function to wait for the next period of a periodic container has reported an error */
+  rtClockErr = 22,
+  /** A function to set an attribute of the Activation Thread has reported an error */
+  rtThreadAttrSetErr = 23,
+  /** A function to set an attribute of the container mutex has reported an error */
+  rtMutexAttrSetErr = 24,
+  /** The function to lock the memory of the process has reported an error */
+  rtMemLockErr = 25
 } FwRtState_t;
 
 typedef enum { rtSampleEnumItem } FwRtSampleEnum;
@@ -253,6 +311,148 @@ struct FwRtDesc {
   int errCode;
   /** The pointer to the RT Container data. */
   void* rtData;
+  /**
+   * The pool whose worker threads execute the Activation Procedure.
+   * The default value of NULL indicates that the container has its own
+   * Activation Thread.
+   */
+  FwRtPoolDesc_t pool;
+  /** The next container in the ready queue of the pool. */
+  FwRtDesc_t nextReady;
+  /**
+   * The flag indicating whether the container is in the ready queue of its pool
+   * or is being executed by one of the pool's worker threads.
+   */
+  FwRtBool_t isQueued;
+  /**
+   * The flag indicating whether the lock-free notification mode is enabled
+   * (see <code>::FwRtSetLockFreeNotif</code>).
+   */
+  FwRtBool_t lockFreeNotif;
+  /**
+   * The flag indicating whether the Activation Thread is waiting (or about to
+   * wait) on the container's condition variable.
+   * This flag is only accessed through atomic operations.
+   */
+  FwRtBool_t isParked;
+  /**
+   * The flag indicating whether the notification coalescing mode is enabled
+   * (see <code>::FwRtSetNotifCoalescing</code>).
+   */
+  FwRtBool_t coalesceNotif;
+  /**
+   * The maximum time for which, in the notification coalescing mode, the Activation
+   * Thread waits for further notifications before executing the Activation Procedure.
+   */
+  struct timespec coalesceDelay;
+  /** The number of notifications consumed by the current execution of the Activation Procedure. */
+  FwRtCounterU2_t nOfCoalescedNotif;
+  /**
+   * The flag indicating whether the periodic activation mode is enabled
+   * (see <code>::FwRtSetPeriodic</code>).
+   */
+  FwRtBool_t isPeriodic;
+  /** The activation period in the periodic activation mode. */
+  struct timespec period;
+  /** The offset of the first activation from the start of the container in the periodic activation mode. */
+  struct timespec phase;
+  /** The number of activations which were missed in the periodic activation mode. */
+  FwRtCounterU4_t nOfOverruns;
+  /** The longest execution time of the Execute Functional Behaviour action in the periodic activation mode. */
+  struct timespec maxExecTime;
+  /**
+   * The flag indicating whether the scheduling policy and priority of the Activation
+   * Thread are set explicitly (see <code>::FwRtSetSchedPolicy</code>).
+   */
+  FwRtBool_t explicitSched;
+  /** The scheduling policy of the Activation Thread (e.g. <code>SCHED_FIFO</code>). */
+  int schedPolicy;
+  /** The scheduling priority of the Activation Thread. */
+  int schedPriority;
+  /**
+   * The mask of the processors on which the Activation Thread may run (bit i
+   * represents processor i and a value of zero leaves the affinity unchanged).
+   */
+  unsigned long cpuMask;
+  /** The flag indicating whether the container mutex uses the priority inheritance protocol. */
+  FwRtBool_t prioInherit;
+  /** The stack of the Activation Thread (or NULL if it is allocated by the POSIX library). */
+  void* stack;
+  /** The size of the stack of the Activation Thread (or zero for the default size). */
+  size_t stackSize;
+  /** The flag indicating whether the memory of the process is locked when the container is started. */
+  FwRtBool_t memLock;
+  /**
+   * The attributes of the Activation Thread which are used if the real-time settings
+   * of the thread are configured but no thread attributes have been loaded with
+   * <code>::FwRtSetPosixAttr</code>.
+   */
+  pthread_attr_t threadAttr;
+  /**
+   * The attributes of the container mutex which are used if the priority inheritance
+   * protocol is configured but no mutex attributes have been loaded with
+   * <code>::FwRtSetPosixAttr</code>.
+   */
+  pthread_mutexattr_t mutexAttr;
+  /** The slots of the payload ring (or NULL if the container has no payload ring). */
+  FwRtPayloadSlot_t* payloadSlots;
+  /** The number of slots of the payload ring (a power of two). */
+  FwRtCounterU4_t nOfPayloadSlots;
+  /** The flag indicating whether payloads may be passed to the container by more than one thread. */
+  FwRtBool_t multiProducer;
+  /** The position in the payload ring of the next payload to be taken by the Activation Procedure. */
+  FwRtCounterU4_t payloadHead;
+  /** The position in the payload ring of the next payload to be passed by a notifier. */
+  FwRtCounterU4_t payloadTail;
+#ifdef FW_RT_STATS
+  /** The latency histograms of the RT Container. */
+  FwRtStats_t stats;
+  /** The time of the oldest notification which has not yet woken up the Activation Procedure. */
+  struct timespec notifTime;
+  /** The flag indicating whether <code>notifTime</code> holds a valid time. */
+  FwRtBool_t isNotifTimeSet;
+#endif
+};
+
+/**
+ * Structure representing a RT Pool Descriptor.
+ * A RT Pool is a fixed set of worker threads which execute the Activation
+ * Procedures of the RT Containers attached to it.
+ * The RT Pool Descriptor holds:
+ * - The state of the pool;
+ * - The worker threads and their attributes;
+ * - The lock (a mutex) and condition variable protecting the ready queue;
+ * - The ready queue of containers with pending notifications;
+ * - The error code for the pool.
+ * .
+ * The user instantiates a RT Pool Descriptor by creating a variable of type
+ * <code>struct FwRtPool</code> and initializes it with <code>::FwRtPoolInit</code>.
+ */
+struct FwRtPool {
+  /** The state of the pool (either rtContUninitialized, rtContStarted or an error state). */
+  FwRtState_t state;
+  /** The array holding the worker threads. */
+  pthread_t* threads;
+  /** The number of worker threads which have been created. */
+  int nOfThreads;
+  /**
+   * The pointer to the worker thread attributes.
+   * The default value of NULL indicates the default values of a pthread
+   * attributes should be used.
+   */
+  pthread_attr_t* pThreadAttr;
+  /** The mutex protecting the ready queue. */
+  pthread_mutex_t mutex;
+  /** The condition variable on which idle worker threads wait. */
+  pthread_cond_t cond;
+  /** The first container in the ready queue (or NULL if the queue is empty). */
+  FwRtDesc_t head;
+  /** The last container in the ready queue (or NULL if the queue is empty). */
+  FwRtDesc_t tail;
+  /** The flag indicating whether the pool is being shut down. */
+  FwRtBool_t isShutdown;
+  /** The return value of the last system call which failed. */
+  int errCode;
 };
 
 #endif /* FWRT_CONSTANTS_H_ */
@@ -15,10 +15,53 @@
  * For information on alternative licensing, please contact P&P Software GmbH.
  */
 
+/* Needed for clock_gettime, clock_nanosleep and pthread_cond_timedwait in an ANSI C build */
+#define _POSIX_C_SOURCE 200112L
+
 #include "FwRtCore.h"
 #include "FwRtConstants.h"
+#include "FwRtPool.h"
+#include <errno.h>
 #include <pthread.h>
 #include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <time.h>
+
+#if defined(__GNUC__)
+/** Atomically add a value to a variable and return its new value (this is a full memory barrier). */
+#define FW_RT_ATOMIC_ADD(var, val) __sync_add_and_fetch(&(var), (val))
+/** Atomically subtract a value from a variable and return its new value (this is a full memory barrier). */
+#define FW_RT_ATOMIC_SUB(var, val) __sync_sub_and_fetch(&(var), (val))
+/** Atomically replace the value of a variable if it is equal to an expected value and return its old value. */
+#define FW_RT_ATOMIC_CAS(var, oldVal, newVal) __sync_val_compare_and_swap(&(var), (oldVal), (newVal))
+/** Atomically set a boolean variable to a value (this is a full memory barrier). */
+#define FW_RT_ATOMIC_SET_FLAG(var, val) __sync_val_compare_and_swap(&(var), !(val), (val))
+/** Flag indicating whether atomic operations are available for the lock-free notification mode. */
+#define FW_RT_HAS_ATOMICS 1
+#else
+#define FW_RT_ATOMIC_ADD(var, val) ((var) += (val))
+#define FW_RT_ATOMIC_SUB(var, val) ((var) -= (val))
+#define FW_RT_ATOMIC_CAS(var, oldVal, newVal) ((var) == (oldVal) ? ((var) = (newVal), (oldVal)) : (var))
+#define FW_RT_ATOMIC_SET_FLAG(var, val) ((var) = (val))
+#define FW_RT_HAS_ATOMICS 0
+#endif
+
+#ifdef FW_RT_STATS
+/** Record the time of a notification in the latency histograms. */
+#define FW_RT_STATS_NOTIF(rtDesc) StatsRecordNotif(rtDesc)
+/** Record a wake-up of the Activation Procedure in the latency histograms. */
+#define FW_RT_STATS_WAKE(rtDesc) StatsRecordWake(rtDesc)
+/** Record an execution time of the Execute Functional Behaviour action in the latency histograms. */
+#define FW_RT_STATS_EXEC(rtDesc, interval) ((rtDesc)->stats.execTime[StatsGetBin(interval)]++)
+/** Flag indicating whether the latency instrumentation is compiled in. */
+#define FW_RT_HAS_STATS 1
+#else
+#define FW_RT_STATS_NOTIF(rtDesc) ((void)0)
+#define FW_RT_STATS_WAKE(rtDesc) ((void)0)
+#define FW_RT_STATS_EXEC(rtDesc, interval) ((void)0)
+#define FW_RT_HAS_STATS 0
+#endif
 
 /**
  * The Activation Thread of the RT Container.
@@ -43,6 +86,169 @@ void ExecNotifProcedure(FwRtDesc_t rtDesc);
  */
 void ExecActivProcedure(FwRtDesc_t rtDesc);
 
+/**
+ * Signal to the Activation Procedure that the Notification Counter has been incremented.
+ * If the container has its own Activation Thread, the container's condition variable
+ * is signalled.
+ * If the container is attached to a RT Pool, the container is put in the ready queue
+ * of the pool unless it is already queued or being executed.
+ * This function must be called with the container mutex locked.
+ * If a system call fails, this function puts the container in an error state.
+ * @param rtDesc the descriptor of the RT Container
+ * @return 1 if the signal was sent successfully, 0 otherwise
+ */
+FwRtBool_t SignalActivProcedure(FwRtDesc_t rtDesc);
+
+/**
+ * Execute the Notification Procedure with a lock-free wake-up of the Activation Thread.
+ * This function implements the lock-free notification mode (see
+ * <code>::FwRtSetLockFreeNotif</code>).
+ * It only handles containers which have their own Activation Thread and whose
+ * Notification and Activation Procedures are both started.
+ * The Implement Notification Logic action is executed and the Notification Counter is
+ * incremented without locking the container mutex.
+ * The mutex is only locked to signal the condition variable if the Activation Thread
+ * is parked on it.
+ * @param rtDesc the descriptor of the RT Container
+ * @return 1 if the Notification Procedure was executed, 0 if it must instead be
+ * executed by the default notification logic
+ */
+FwRtBool_t ExecNotifLockFree(FwRtDesc_t rtDesc);
+
+/**
+ * Increment the Notification Counter.
+ * In the notification coalescing mode and in the periodic activation mode, the counter
+ * saturates at <code>#FW_RT_COUNTER_U2_MAX</code>.
+ * @param rtDesc the descriptor of the RT Container
+ */
+void IncrNotifCounter(FwRtDesc_t rtDesc);
+
+/**
+ * Consume the notifications which are processed by the next execution of the
+ * Activation Procedure.
+ * This function must be called with the container mutex locked and, except in the
+ * periodic activation mode, with a Notification Counter greater than zero.
+ * In the notification coalescing mode and in the periodic activation mode, all pending
+ * notifications are consumed; otherwise one notification is consumed.
+ * The number of consumed notifications is stored in the container descriptor.
+ * @param rtDesc the descriptor of the RT Container
+ */
+void ConsumeNotif(FwRtDesc_t rtDesc);
+
+/**
+ * Wait for further notifications in the notification coalescing mode.
+ * This function must be called by the Activation Thread with the container mutex locked.
+ * It returns when the coalescing delay has expired or when the container is stopped.
+ * If the coalescing mode is disabled or the delay is zero, it returns immediately.
+ * @param rtDesc the descriptor of the RT Container
+ * @return 1 if successful, 0 if a system call failed (error code and state set)
+ */
+FwRtBool_t WaitCoalescingDelay(FwRtDesc_t rtDesc);
+
+/**
+ * The Activation Thread of a RT Container in the periodic activation mode.
+ * This function is called by the Activation Thread when it is created if the
+ * periodic activation mode is enabled (see <code>::FwRtSetPeriodic</code>).
+ * @param ptr this parameter is not used
+ * @return this function always returns NULL
+ */
+void* ExecActivThreadPeriodic(void* ptr);
+
+/**
+ * Execute the Execute Functional Behaviour action of the Activation Procedure.
+ * In the periodic activation mode, the execution time of the action is measured
+ * and the longest execution time is updated.
+ * If the latency instrumentation is compiled in, the execution time is always
+ * measured and added to its histogram.
+ * @param rtDesc the descriptor of the RT Container
+ * @return the outcome of the Execute Functional Behaviour action
+ */
+FwRtOutcome_t ExecFuncBehaviourTimed(FwRtDesc_t rtDesc);
+
+#ifdef FW_RT_STATS
+/**
+ * Record the time of a notification in the latency histograms.
+ * The time is only recorded if notifications are pending and if the time of an
+ * earlier notification which has not yet woken up the Activation Procedure is
+ * not already recorded.
+ * This function must be called with the container mutex locked.
+ * @param rtDesc the descriptor of the RT Container
+ */
+void StatsRecordNotif(FwRtDesc_t rtDesc);
+
+/**
+ * Record a wake-up of the Activation Procedure in the latency histograms.
+ * The value of the Notification Counter and, if the time of the notification
+ * which caused the wake-up is known, the delay since that notification are
+ * added to their histograms.
+ * This function must be called with the container mutex locked before the
+ * notifications are consumed.
+ * @param rtDesc the descriptor of the RT Container
+ */
+void StatsRecordWake(FwRtDesc_t rtDesc);
+
+/**
+ * Return the bin of a time interval in a latency histogram.
+ * @param interval the time interval
+ * @return the bin of the time interval
+ */
+unsigned int StatsGetBin(const struct timespec* interval);
+
+/**
+ * Return the bin of a value in a latency histogram.
+ * @param value the value
+ * @return the bin of the value
+ */
+unsigned int StatsGetValueBin(FwRtCounterU4_t value);
+#endif
+
+/**
+ * Put a payload in the payload ring of a RT Container.
+ * Each slot of the ring holds a sequence number: a free slot holds the position at
+ * which it is next filled and a full slot holds that position plus one.
+ * A notifier claims the slot at the tail position (with a compare-and-swap if payloads
+ * may be passed by more than one thread) and then publishes the payload by incrementing
+ * the sequence number of the slot.
+ * The container mutex is only locked if atomic operations are not available.
+ * @param rtDesc the descriptor of the RT Container
+ * @param payload the payload
+ * @return 1 if the payload was put in the ring, 0 if the ring is full or does not exist
+ */
+FwRtBool_t PushPayload(FwRtDesc_t rtDesc, void* payload);
+
+/**
+ * Take the payload at the head position of the payload ring of a RT Container.
+ * The slot is freed for the next lap of the ring by adding the number of slots minus
+ * one to its sequence number.
+ * @param rtDesc the descriptor of the RT Container
+ * @return the payload or NULL if the ring is empty
+ */
+void* PopPayload(FwRtDesc_t rtDesc);
+
+/**
+ * Lock the container mutex to protect the payload ring if atomic operations are not
+ * available.
+ * If the lock operation fails, the error code and the container state are set.
+ * @param rtDesc the descriptor of the RT Container
+ * @return 1 if the payload ring may be accessed, 0 otherwise
+ */
+FwRtBool_t LockPayloadRing(FwRtDesc_t rtDesc);
+
+/**
+ * Unlock the container mutex after an access to the payload ring if atomic operations
+ * are not available.
+ * If the unlock operation fails, the error code and the container state are set.
+ * @param rtDesc the descriptor of the RT Container
+ */
+void UnlockPayloadRing(FwRtDesc_t rtDesc);
+
+/**
+ * Add a time interval to a time value.
+ * @param time the time value (it is updated by this function)
+ * @param interval the time interval
+ */
+void AddTimeInterval(struct timespec* time, const struct timespec* interval);
+
 /*--------------------------------------------------------------------------------------*/
 void FwRtStart(FwRtDesc_t rtDesc) {
   int errCode;
@@ -62,6 +268,17 @@ void FwRtStart(FwRtDesc_t rtDesc) {
     return;
   }
 
+  /* Lock the memory of the process so that the Activation Thread incurs no page faults */
+  if ((rtDesc->memLock == 1) && (mlockall(MCL_CURRENT | MCL_FUTURE) != 0)) {
+    rtDesc->errCode = errno;
+    rtDesc->state   = rtMemLockErr;
+    if ((errCode = pthread_mutex_unlock(&(rtDesc->mutex))) != 0) {
+      rtDesc->errCode = errCode;
+      rtDesc->state   = rtMutexUnlockErr;
+    }
+    return;
+  }
+
   /* Start Notification Procedure */
   rtDesc->notifPrStarted = 1;
   /* Start Activation Procedure */
@@ -74,11 +291,18 @@ void FwRtStart(FwRtDesc_t rtDesc) {
   rtDesc->initializeActivPr(rtDesc);
   rtDesc->setUpNotification(rtDesc);
 
-  rtDesc->state        = rtContStarted;
-  rtDesc->notifCounter = 0;
+  rtDesc->state               = rtContStarted;
+  rtDesc->notifCounter        = 0;
+  rtDesc->nOfOverruns         = 0;
+  rtDesc->maxExecTime.tv_sec  = 0;
+  rtDesc->maxExecTime.tv_nsec = 0;
 
-  /* Create thread */
-  if ((errCode = pthread_create(&(rtDesc->activationThread), rtDesc->pThreadAttr, ExecActivThread, rtDesc)) != 0) {
+  /* Create thread (pooled containers are executed by the worker threads of their pool) */
+  if (rtDesc->pool != NULL) {
+    rtDesc->isQueued = 0;
+  } else if ((errCode = pthread_create(&(rtDesc->activationThread), rtDesc->pThreadAttr,
+                                       (rtDesc->isPeriodic == 1) ? ExecActivThreadPeriodic : ExecActivThread,
+                                       rtDesc)) != 0) {
     rtDesc->errCode = errCode;
     rtDesc->state   = rtThreadCreateErr;
     return;
@@ -116,11 +340,9 @@ void FwRtStop(FwRtDesc_t rtDesc) {
   rtDesc->state = rtContStopped;
 
   /* Notify the Activation Thread */
-  rtDesc->notifCounter++;
+  IncrNotifCounter(rtDesc);
 
-  if ((errCode = pthread_cond_signal(&(rtDesc->cond))) != 0) {
-    rtDesc->errCode = errCode;
-    rtDesc->state   = rtCondSignalErr;
+  if (!SignalActivProcedure(rtDesc)) {
     return;
   }
 
@@ -137,6 +359,10 @@ void FwRtStop(FwRtDesc_t rtDesc) {
 void FwRtNotify(FwRtDesc_t rtDesc) {
   int errCode;
 
+  if ((rtDesc->lockFreeNotif == 1) && (ExecNotifLockFree(rtDesc) == 1)) {
+    return;
+  }
+
   if ((errCode = pthread_mutex_lock(&(rtDesc->mutex))) != 0) {
     rtDesc->errCode = errCode;
     rtDesc->state   = rtMutexLockErr;
@@ -150,11 +376,66 @@ void FwRtNotify(FwRtDesc_t rtDesc) {
   }
 }
 
+/*--------------------------------------------------------------------------------------*/
+FwRtBool_t FwRtNotifyWithPayload(FwRtDesc_t rtDesc, void* payload) {
+  FwRtBool_t isPushed;
+
+  if ((rtDesc->payloadSlots == NULL) || (LockPayloadRing(rtDesc) == 0)) {
+    return 0;
+  }
+  isPushed = PushPayload(rtDesc, payload);
+  UnlockPayloadRing(rtDesc);
+
+  if (isPushed == 1) {
+    FwRtNotify(rtDesc);
+  }
+  return isPushed;
+}
+
+/*--------------------------------------------------------------------------------------*/
+void* FwRtTakePayload(FwRtDesc_t rtDesc) {
+  void* payload;
+
+  if ((rtDesc->payloadSlots == NULL) || (LockPayloadRing(rtDesc) == 0)) {
+    return NULL;
+  }
+  payload = PopPayload(rtDesc);
+  UnlockPayloadRing(rtDesc);
+  return payload;
+}
+
+/*--------------------------------------------------------------------------------------*/
+FwRtCounterU4_t FwRtGetNOfPayloads(FwRtDesc_t rtDesc) {
+  FwRtCounterU4_t head = FW_RT_ATOMIC_ADD(rtDesc->payloadHead, 0);
+
+  return FW_RT_ATOMIC_ADD(rtDesc->payloadTail, 0) - head;
+}
+
 /*--------------------------------------------------------------------------------------*/
 void FwRtWaitForTermination(FwRtDesc_t rtDesc) {
   int   errCode;
   void* status = 0;
 
+  if (rtDesc->pool != NULL) {
+    if ((errCode = pthread_mutex_lock(&(rtDesc->mutex))) != 0) {
+      rtDesc->errCode = errCode;
+      rtDesc->state   = rtMutexLockErr;
+      return;
+    }
+    while ((rtDesc->activPrStarted == 1) || (rtDesc->isQueued == 1)) {
+      if ((errCode = pthread_cond_wait(&(rtDesc->cond), &(rtDesc->mutex))) != 0) {
+        rtDesc->errCode = errCode;
+        rtDesc->state   = rtCondWaitErr;
+        return;
+      }
+    }
+    if ((errCode = pthread_mutex_unlock(&(rtDesc->mutex))) != 0) {
+      rtDesc->errCode = errCode;
+      rtDesc->state   = rtMutexUnlockErr;
+    }
+    return;
+  }
+
   if ((errCode = pthread_join(rtDesc->activationThread, &status)) != 0) {
     rtDesc->errCode = errCode;
     rtDesc->state   = rtJoinErr;
@@ -188,9 +469,67 @@ FwRtCounterU2_t FwRtGetNotifCounter(FwRtDesc_t rtDesc) {
 }
 
 /*--------------------------------------------------------------------------------------*/
-void ExecNotifProcedure(FwRtDesc_t rtDesc) {
+FwRtCounterU2_t FwRtGetNOfCoalescedNotif(FwRtDesc_t rtDesc) {
+  return rtDesc->nOfCoalescedNotif;
+}
+
+/*--------------------------------------------------------------------------------------*/
+FwRtCounterU4_t FwRtGetNOfOverruns(FwRtDesc_t rtDesc) {
+  return rtDesc->nOfOverruns;
+}
+
+/*--------------------------------------------------------------------------------------*/
+struct timespec FwRtGetMaxExecTime(FwRtDesc_t rtDesc) {
+  return rtDesc->maxExecTime;
+}
+
+/*--------------------------------------------------------------------------------------*/
+FwRtBool_t FwRtGetStats(FwRtDesc_t rtDesc, FwRtStats_t* stats) {
+#ifdef FW_RT_STATS
   int errCode;
 
+  if ((errCode = pthread_mutex_lock(&(rtDesc->mutex))) != 0) {
+    rtDesc->errCode = errCode;
+    rtDesc->state   = rtMutexLockErr;
+    return 0;
+  }
+  *stats = rtDesc->stats;
+  if ((errCode = pthread_mutex_unlock(&(rtDesc->mutex))) != 0) {
+    rtDesc->errCode = errCode;
+    rtDesc->state   = rtMutexUnlockErr;
+    return 0;
+  }
+  return 1;
+#else
+  (void)rtDesc;
+  memset(stats, 0, sizeof(FwRtStats_t));
+  return 0;
+#endif
+}
+
+/*--------------------------------------------------------------------------------------*/
+void FwRtResetStats(FwRtDesc_t rtDesc) {
+#ifdef FW_RT_STATS
+  int errCode;
+
+  if ((errCode = pthread_mutex_lock(&(rtDesc->mutex))) != 0) {
+    rtDesc->errCode = errCode;
+    rtDesc->state   = rtMutexLockErr;
+    return;
+  }
+  memset(&(rtDesc->stats), 0, sizeof(FwRtStats_t));
+  rtDesc->isNotifTimeSet = 0;
+  if ((errCode = pthread_mutex_unlock(&(rtDesc->mutex))) != 0) {
+    rtDesc->errCode = errCode;
+    rtDesc->state   = rtMutexUnlockErr;
+  }
+#else
+  (void)rtDesc;
+#endif
+}
+
+/*--------------------------------------------------------------------------------------*/
+void ExecNotifProcedure(FwRtDesc_t rtDesc) {
   if (rtDesc->notifPrStarted == 0) {
     return;
   }
@@ -202,17 +541,78 @@ void ExecNotifProcedure(FwRtDesc_t rtDesc) {
   }
 
   if (rtDesc->implementNotifLogic(rtDesc) == 1) {
-    rtDesc->notifCounter++;
-    if ((errCode = pthread_cond_signal(&(rtDesc->cond))) != 0) {
-      rtDesc->errCode = errCode;
-      rtDesc->state   = rtCondSignalErr;
-      return;
-    }
+    IncrNotifCounter(rtDesc);
+    FW_RT_STATS_NOTIF(rtDesc);
+    (void)SignalActivProcedure(rtDesc);
   }
 
   return;
 }
 
+/*--------------------------------------------------------------------------------------*/
+FwRtBool_t ExecNotifLockFree(FwRtDesc_t rtDesc) {
+  int errCode;
+
+  if ((FW_RT_HAS_ATOMICS == 0) || (rtDesc->pool != NULL)) {
+    return 0;
+  }
+
+  /* Start-up and termination of the procedures are handled in mutual exclusion */
+  if ((FW_RT_ATOMIC_ADD(rtDesc->notifPrStarted, 0) == 0) || (FW_RT_ATOMIC_ADD(rtDesc->activPrStarted, 0) == 0)) {
+    return 0;
+  }
+
+  if (rtDesc->implementNotifLogic(rtDesc) != 1) {
+    return 1;
+  }
+
+  /* The Activation Thread sets its parked flag before checking the counter: either it
+   * sees the new counter value or this function sees the parked flag */
+  IncrNotifCounter(rtDesc);
+  if (FW_RT_ATOMIC_ADD(rtDesc->isParked, 0) == 0) {
+    return 1;
+  }
+
+  /* The Activation Thread only releases the mutex in the wait on the condition variable */
+  if ((errCode = pthread_mutex_lock(&(rtDesc->mutex))) != 0) {
+    rtDesc->errCode = errCode;
+    rtDesc->state   = rtMutexLockErr;
+    return 1;
+  }
+  FW_RT_STATS_NOTIF(rtDesc);
+  if ((errCode = pthread_cond_signal(&(rtDesc->cond))) != 0) {
+    rtDesc->errCode = errCode;
+    rtDesc->state   = rtCondSignalErr;
+    (void)pthread_mutex_unlock(&(rtDesc->mutex));
+    return 1;
+  }
+  if ((errCode = pthread_mutex_unlock(&(rtDesc->mutex))) != 0) {
+    rtDesc->errCode = errCode;
+    rtDesc->state   = rtMutexUnlockErr;
+  }
+  return 1;
+}
+
+/*--------------------------------------------------------------------------------------*/
+FwRtBool_t SignalActivProcedure(FwRtDesc_t rtDesc) {
+  int errCode;
+
+  if (rtDesc->pool != NULL) {
+    if (rtDesc->isQueued == 1) {
+      return 1;
+    }
+    rtDesc->isQueued = 1;
+    return FwRtPoolEnqueue(rtDesc->pool, rtDesc);
+  }
+
+  if ((errCode = pthread_cond_signal(&(rtDesc->cond))) != 0) {
+    rtDesc->errCode = errCode;
+    rtDesc->state   = rtCondSignalErr;
+    return 0;
+  }
+  return 1;
+}
+
 /*--------------------------------------------------------------------------------------*/
 void ExecActivProcedure(FwRtDesc_t rtDesc) {
 
@@ -223,7 +623,7 @@ void ExecActivProcedure(FwRtDesc_t rtDesc) {
   }
 
   if (rtDesc->implementActivLogic(rtDesc) == 1) { /* Execute functional behaviour */
-    if (rtDesc->execFuncBehaviour(rtDesc) == 1) { /* Functional behaviour is terminated */
+    if (ExecFuncBehaviourTimed(rtDesc) == 1) { /* Functional behaviour is terminated */
       rtDesc->finalizeActivPr(rtDesc);
       rtDesc->activPrStarted = 0;
       return;
@@ -244,14 +644,24 @@ void* ExecActivThread(void* ptr) {
       rtDesc->state   = rtMutexLockErr;
       return NULL;
     }
-    while (rtDesc->notifCounter == 0) {
+    while (FW_RT_ATOMIC_ADD(rtDesc->notifCounter, 0) == 0) {
+      /* Notifiers in the lock-free mode only signal the condition variable if the parked flag is set */
+      (void)FW_RT_ATOMIC_SET_FLAG(rtDesc->isParked, 1);
+      if (FW_RT_ATOMIC_ADD(rtDesc->notifCounter, 0) != 0) {
+        break;
+      }
       if ((errCode = pthread_cond_wait(&(rtDesc->cond), &(rtDesc->mutex))) != 0) {
         rtDesc->errCode = errCode;
         rtDesc->state   = rtCondWaitErr;
         return NULL;
       }
     }
-    rtDesc->notifCounter--;
+    (void)FW_RT_ATOMIC_SET_FLAG(rtDesc->isParked, 0);
+    if (!WaitCoalescingDelay(rtDesc)) {
+      return NULL;
+    }
+    FW_RT_STATS_WAKE(rtDesc);
+    ConsumeNotif(rtDesc);
     if ((errCode = pthread_mutex_unlock(&(rtDesc->mutex))) != 0) {
       rtDesc->errCode = errCode;
       rtDesc->state   = rtMutexUnlockErr;
@@ -275,3 +685,362 @@ void* ExecActivThread(void* ptr) {
 
   return NULL;
 }
+
+/*--------------------------------------------------------------------------------------*/
+void* ExecActivThreadPeriodic(void* ptr) {
+  FwRtDesc_t      rtDesc = (FwRtDesc_t)ptr;
+  struct timespec next;
+  struct timespec now;
+  int             errCode;
+
+  (void)clock_gettime(CLOCK_MONOTONIC, &next);
+  AddTimeInterval(&next, &(rtDesc->phase));
+
+  while (1) {
+    /* Wait for the next release (the deadline is absolute and therefore does not drift) */
+    while ((errCode = clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &next, NULL)) != 0) {
+      if (errCode != EINTR) {
+        rtDesc->errCode = errCode;
+        rtDesc->state   = rtClockErr;
+        return NULL;
+      }
+    }
+
+    if ((errCode = pthread_mutex_lock(&(rtDesc->mutex))) != 0) {
+      rtDesc->errCode = errCode;
+      rtDesc->state   = rtMutexLockErr;
+      return NULL;
+    }
+    FW_RT_STATS_WAKE(rtDesc);
+    ConsumeNotif(rtDesc);
+    if ((errCode = pthread_mutex_unlock(&(rtDesc->mutex))) != 0) {
+      rtDesc->errCode = errCode;
+      rtDesc->state   = rtMutexUnlockErr;
+      return NULL;
+    }
+
+    ExecActivProcedure(rtDesc);
+
+    if (rtDesc->activPrStarted == 0) {
+      rtDesc->state = rtContStopped; /* Put RT Container in state STOPPED */
+      FwRtNotify(rtDesc);            /* Execute Notification Procedure in mutual exclusion */
+      break;
+    }
+
+    if (rtDesc->state == rtContStopped) {
+      ExecActivProcedure(rtDesc);
+      FwRtNotify(rtDesc); /* Execute Notification Procedure in mutual exclusion */
+      break;
+    }
+
+    /* Skip the releases which have been missed */
+    AddTimeInterval(&next, &(rtDesc->period));
+    (void)clock_gettime(CLOCK_MONOTONIC, &now);
+    while ((next.tv_sec < now.tv_sec) || ((next.tv_sec == now.tv_sec) && (next.tv_nsec <= now.tv_nsec))) {
+      AddTimeInterval(&next, &(rtDesc->period));
+      rtDesc->nOfOverruns++;
+    }
+  }
+
+  return NULL;
+}
+
+/*--------------------------------------------------------------------------------------*/
+FwRtOutcome_t ExecFuncBehaviourTimed(FwRtDesc_t rtDesc) {
+  struct timespec start;
+  struct timespec end;
+  FwRtOutcome_t   outcome;
+
+  if ((FW_RT_HAS_STATS == 0) && ((rtDesc->isPeriodic == 0) || (rtDesc->pool != NULL))) {
+    return rtDesc->execFuncBehaviour(rtDesc);
+  }
+
+  (void)clock_gettime(CLOCK_MONOTONIC, &start);
+  outcome = rtDesc->execFuncBehaviour(rtDesc);
+  (void)clock_gettime(CLOCK_MONOTONIC, &end);
+
+  end.tv_sec  = end.tv_sec - start.tv_sec;
+  end.tv_nsec = end.tv_nsec - start.tv_nsec;
+  if (end.tv_nsec < 0) {
+    end.tv_sec  = end.tv_sec - 1;
+    end.tv_nsec = end.tv_nsec + 1000000000L;
+  }
+  FW_RT_STATS_EXEC(rtDesc, &end);
+  if ((rtDesc->isPeriodic == 0) || (rtDesc->pool != NULL)) {
+    return outcome;
+  }
+  if ((end.tv_sec > rtDesc->maxExecTime.tv_sec) ||
+      ((end.tv_sec == rtDesc->maxExecTime.tv_sec) && (end.tv_nsec > rtDesc->maxExecTime.tv_nsec))) {
+    rtDesc->maxExecTime = end;
+  }
+  return outcome;
+}
+
+/*--------------------------------------------------------------------------------------*/
+void FwRtRunPooled(FwRtDesc_t rtDesc) {
+  FwRtBool_t terminated = 0;
+  int        errCode;
+
+  if ((errCode = pthread_mutex_lock(&(rtDesc->mutex))) != 0) {
+    rtDesc->errCode = errCode;
+    rtDesc->state   = rtMutexLockErr;
+    return;
+  }
+  if (rtDesc->notifCounter == 0) {
+    rtDesc->isQueued = 0;
+    if ((errCode = pthread_mutex_unlock(&(rtDesc->mutex))) != 0) {
+      rtDesc->errCode = errCode;
+      rtDesc->state   = rtMutexUnlockErr;
+    }
+    return;
+  }
+  FW_RT_STATS_WAKE(rtDesc);
+  ConsumeNotif(rtDesc);
+  if ((errCode = pthread_mutex_unlock(&(rtDesc->mutex))) != 0) {
+    rtDesc->errCode = errCode;
+    rtDesc->state   = rtMutexUnlockErr;
+    return;
+  }
+
+  ExecActivProcedure(rtDesc);
+
+  if (rtDesc->activPrStarted == 0) {
+    rtDesc->state = rtContStopped; /* Put RT Container in state STOPPED */
+    FwRtNotify(rtDesc);            /* Execute Notification Procedure in mutual exclusion */
+    terminated = 1;
+  } else if (rtDesc->state == rtContStopped) {
+    ExecActivProcedure(rtDesc);
+    FwRtNotify(rtDesc); /* Execute Notification Procedure in mutual exclusion */
+    terminated = 1;
+  }
+
+  if ((errCode = pthread_mutex_lock(&(rtDesc->mutex))) != 0) {
+    rtDesc->errCode = errCode;
+    rtDesc->state   = rtMutexLockErr;
+    return;
+  }
+  if (terminated == 1) {
+    rtDesc->isQueued = 0;
+    if ((errCode = pthread_cond_broadcast(&(rtDesc->cond))) != 0) {
+      rtDesc->errCode = errCode;
+      rtDesc->state   = rtCondSignalErr;
+      return;
+    }
+  } else if (rtDesc->notifCounter == 0) {
+    rtDesc->isQueued = 0;
+  } else if (!FwRtPoolEnqueue(rtDesc->pool, rtDesc)) {
+    /* Release the container mutex without overwriting the error state set by the enqueue */
+    (void)pthread_mutex_unlock(&(rtDesc->mutex));
+    return;
+  }
+  if ((errCode = pthread_mutex_unlock(&(rtDesc->mutex))) != 0) {
+    rtDesc->errCode = errCode;
+    rtDesc->state   = rtMutexUnlockErr;
+  }
+}
+
+/*--------------------------------------------------------------------------------------*/
+void IncrNotifCounter(FwRtDesc_t rtDesc) {
+  FwRtCounterU2_t n;
+
+  if ((rtDesc->coalesceNotif == 0) && (rtDesc->isPeriodic == 0)) {
+    (void)FW_RT_ATOMIC_ADD(rtDesc->notifCounter, 1);
+    return;
+  }
+
+  do {
+    n = FW_RT_ATOMIC_ADD(rtDesc->notifCounter, 0);
+    if (n == FW_RT_COUNTER_U2_MAX) {
+      return;
+    }
+  } while (FW_RT_ATOMIC_CAS(rtDesc->notifCounter, n, (FwRtCounterU2_t)(n + 1)) != n);
+}
+
+/*--------------------------------------------------------------------------------------*/
+void ConsumeNotif(FwRtDesc_t rtDesc) {
+  FwRtCounterU2_t n;
+
+  if ((rtDesc->coalesceNotif == 0) && ((rtDesc->isPeriodic == 0) || (rtDesc->pool != NULL))) {
+    (void)FW_RT_ATOMIC_SUB(rtDesc->notifCounter, 1);
+    rtDesc->nOfCoalescedNotif = 1;
+    return;
+  }
+
+  /* The counter is reset with the same atomic operations with which it is incremented */
+  n = FW_RT_ATOMIC_ADD(rtDesc->notifCounter, 0);
+  (void)FW_RT_ATOMIC_SUB(rtDesc->notifCounter, n);
+  rtDesc->nOfCoalescedNotif = n;
+}
+
+/*--------------------------------------------------------------------------------------*/
+FwRtBool_t WaitCoalescingDelay(FwRtDesc_t rtDesc) {
+  struct timespec deadline;
+  int             errCode;
+
+  if ((rtDesc->coalesceNotif == 0) || (rtDesc->state != rtContStarted)) {
+    return 1;
+  }
+  if ((rtDesc->coalesceDelay.tv_sec == 0) && (rtDesc->coalesceDelay.tv_nsec == 0)) {
+    return 1;
+  }
+
+  (void)clock_gettime(CLOCK_REALTIME, &deadline);
+  deadline.tv_sec  = deadline.tv_sec + rtDesc->coalesceDelay.tv_sec;
+  deadline.tv_nsec = deadline.tv_nsec + rtDesc->coalesceDelay.tv_nsec;
+  if (deadline.tv_nsec >= 1000000000L) {
+    deadline.tv_sec  = deadline.tv_sec + 1;
+    deadline.tv_nsec = deadline.tv_nsec - 1000000000L;
+  }
+
+  while (rtDesc->state == rtContStarted) {
+    errCode = pthread_cond_timedwait(&(rtDesc->cond), &(rtDesc->mutex), &deadline);
+    if (errCode == ETIMEDOUT) {
+      break;
+    }
+    if (errCode != 0) {
+      rtDesc->errCode = errCode;
+      rtDesc->state   = rtCondWaitErr;
+      return 0;
+    }
+  }
+  return 1;
+}
+
+/*--------------------------------------------------------------------------------------*/
+FwRtBool_t PushPayload(FwRtDesc_t rtDesc, void* payload) {
+  FwRtPayloadSlot_t* slot;
+  FwRtCounterU4_t    mask = rtDesc->nOfPayloadSlots - 1;
+  FwRtCounterU4_t    pos  = FW_RT_ATOMIC_ADD(rtDesc->payloadTail, 0);
+  FwRtCounterU4_t    seq;
+
+  while (1) {
+    slot = &(rtDesc->payloadSlots[pos & mask]);
+    seq  = FW_RT_ATOMIC_ADD(slot->seq, 0);
+    if (seq == pos) {
+      if (rtDesc->multiProducer == 0) {
+        (void)FW_RT_ATOMIC_ADD(rtDesc->payloadTail, 1);
+        break;
+      }
+      seq = FW_RT_ATOMIC_CAS(rtDesc->payloadTail, pos, pos + 1);
+      if (seq == pos) {
+        break;
+      }
+      pos = seq; /* another notifier has claimed the slot */
+    } else if ((long)(seq - pos) < 0) {
+      return 0; /* the slot still holds the payload of the previous lap: the ring is full */
+    } else {
+      pos = FW_RT_ATOMIC_ADD(rtDesc->payloadTail, 0);
+    }
+  }
+
+  slot->payload = payload;
+  (void)FW_RT_ATOMIC_ADD(slot->seq, 1);
+  return 1;
+}
+
+/*--------------------------------------------------------------------------------------*/
+void* PopPayload(FwRtDesc_t rtDesc) {
+  FwRtPayloadSlot_t* slot;
+  FwRtCounterU4_t    mask = rtDesc->nOfPayloadSlots - 1;
+  FwRtCounterU4_t    pos  = rtDesc->payloadHead;
+  void*              payload;
+
+  slot = &(rtDesc->payloadSlots[pos & mask]);
+  if (FW_RT_ATOMIC_ADD(slot->seq, 0) != pos + 1) {
+    return NULL;
+  }
+  payload = slot->payload;
+  (void)FW_RT_ATOMIC_ADD(rtDesc->payloadHead, 1);
+  (void)FW_RT_ATOMIC_ADD(slot->seq, mask);
+  return payload;
+}
+
+/*--------------------------------------------------------------------------------------*/
+FwRtBool_t LockPayloadRing(FwRtDesc_t rtDesc) {
+  int errCode;
+
+  if (FW_RT_HAS_ATOMICS == 1) {
+    return 1;
+  }
+  if ((errCode = pthread_mutex_lock(&(rtDesc->mutex))) != 0) {
+    rtDesc->errCode = errCode;
+    rtDesc->state   = rtMutexLockErr;
+    return 0;
+  }
+  return 1;
+}
+
+/*--------------------------------------------------------------------------------------*/
+void UnlockPayloadRing(FwRtDesc_t rtDesc) {
+  int errCode;
+
+  if (FW_RT_HAS_ATOMICS == 1) {
+    return;
+  }
+  if ((errCode = pthread_mutex_unlock(&(rtDesc->mutex))) != 0) {
+    rtDesc->errCode = errCode;
+    rtDesc->state   = rtMutexUnlockErr;
+  }
+}
+
+/*--------------------------------------------------------------------------------------*/
+void AddTimeInterval(struct timespec* time, const struct timespec* interval) {
+  time->tv_sec  = time->tv_sec + interval->tv_sec;
+  time->tv_nsec = time->tv_nsec + interval->tv_nsec;
+  if (time->tv_nsec >= 1000000000L) {
+    time->tv_sec  = time->tv_sec + 1;
+    time->tv_nsec = time->tv_nsec - 1000000000L;
+  }
+}
+
+#ifdef FW_RT_STATS
+/*--------------------------------------------------------------------------------------*/
+void StatsRecordNotif(FwRtDesc_t rtDesc) {
+  if ((rtDesc->isNotifTimeSet == 1) || (FW_RT_ATOMIC_ADD(rtDesc->notifCounter, 0) == 0)) {
+    return;
+  }
+  (void)clock_gettime(CLOCK_MONOTONIC, &(rtDesc->notifTime));
+  rtDesc->isNotifTimeSet = 1;
+}
+
+/*--------------------------------------------------------------------------------------*/
+void StatsRecordWake(FwRtDesc_t rtDesc) {
+  struct timespec now;
+
+  rtDesc->stats.nOfWakeUps++;
+  rtDesc->stats.queueDepth[StatsGetValueBin((FwRtCounterU4_t)FW_RT_ATOMIC_ADD(rtDesc->notifCounter, 0))]++;
+  if (rtDesc->isNotifTimeSet == 0) {
+    return;
+  }
+
+  (void)clock_gettime(CLOCK_MONOTONIC, &now);
+  now.tv_sec  = now.tv_sec - rtDesc->notifTime.tv_sec;
+  now.tv_nsec = now.tv_nsec - rtDesc->notifTime.tv_nsec;
+  if (now.tv_nsec < 0) {
+    now.tv_sec  = now.tv_sec - 1;
+    now.tv_nsec = now.tv_nsec + 1000000000L;
+  }
+  rtDesc->stats.wakeLatency[StatsGetBin(&now)]++;
+  rtDesc->isNotifTimeSet = 0;
+}
+
+/*--------------------------------------------------------------------------------------*/
+unsigned int StatsGetBin(const struct timespec* interval) {
+  /* Intervals of four seconds or more are beyond the range of a 32-bit counter of nanoseconds */
+  if ((interval->tv_sec < 0) || (interval->tv_sec >= 4)) {
+    return (interval->tv_sec < 0) ? 0 : (FW_RT_N_OF_HIST_BINS - 1);
+  }
+  return StatsGetValueBin((FwRtCounterU4_t)interval->tv_sec * 1000000000UL + (FwRtCounterU4_t)interval->tv_nsec);
+}
+
+/*--------------------------------------------------------------------------------------*/
+unsigned int StatsGetValueBin(FwRtCounterU4_t value) {
+  unsigned int bin = 0;
+
+  while ((value > 1) && (bin < (FW_RT_N_OF_HIST_BINS - 1))) {
+    value = value >> 1;
+    bin++;
+  }
+  return bin;
+}
+#endif
@@ -3,7 +3,8 @@
  * @ingroup rtGroup
  * Declaration of the API for a RT Container.
  * A RT Container consists of:
- * - A POSIX thread (the container's Activation Thread)
+ * - A POSIX thread (the container's Activation Thread) or, alternatively, a
+ *   RT Pool whose worker threads are shared with other containers
  * - A POSIX mutex
  * - A POSIX condition variable
  * - Two procedures (the Notification Procedure and the Activation Procedure)
@@ -70,11 +71,14 @@
  *      to be performed)
  *   6. executes the Activation Procedure (this causes its initialization action
  *      to be performed)
- *   7. creates the container's Activation Thread (this also releases the thread);
+ *   7. creates the container's Activation Thread (this also releases the thread)
+ *      unless the container is attached to a RT Pool;
  *   8. release the mutex and returns
  * .
  * The attributes of the Activation Thread are NULL by default or are those
  * set with function <code>::FwRtSetPosixAttr</code>.
+ * If memory locking is enabled (see <code>::FwRtSetMemLock</code>), the memory of
+ * the process is locked before the container procedures are started.
  *
  * If any of the system calls made by this function returns an error, the
  * container is put in an error state (see <code>::FwRtState_t</code>) and
@@ -103,6 +107,21 @@
  *   }
  * }
  * </pre>
+ * In the notification coalescing mode (see <code>::FwRtSetNotifCoalescing</code>), the
+ * Activation Thread may wait for up to the coalescing delay before consuming the
+ * notifications and then resets the Notification Counter instead of decrementing it.
+ *
+ * In the periodic activation mode (see <code>::FwRtSetPeriodic</code>), the Activation
+ * Thread does not wait on the Notification Counter: it is instead released at absolute
+ * deadlines separated by the activation period and, at each release, it resets the
+ * Notification Counter and executes the Activation Procedure.
+ *
+ * If the container is attached to a RT Pool (see <code>::FwRtSetPool</code>), no
+ * Activation Thread is created.
+ * Each increment of the Notification Counter instead puts the container in the
+ * ready queue of the pool and one of the pool's worker threads executes one
+ * iteration of the loop above by calling <code>::FwRtRunPooled</code>.
+ *
  * Use of this function is subject to the following constraint:
  * - The function may only be called before the Activation Thread has been created for
  *   the first time or after the Activation Thread has terminated execution (function
@@ -136,6 +155,9 @@ void FwRtStop(FwRtDesc_t rtDesc);
  * Blocking function which returns when the Activation Thread has terminated.
  * This function uses POSIX's <code>pthread_join</code> to wait until the
  * Activation Thread has terminated.
+ * If the container is attached to a RT Pool, the function instead waits on the
+ * container's condition variable until the Activation Procedure has terminated
+ * and no worker thread of the pool is executing it.
  *
  * Use of this function is subject to the following constraints:
  * - While this function is waiting on a given container, no other call to the
@@ -155,10 +177,116 @@ void FwRtWaitForTermination(FwRtDesc_t rtDesc);
  * - It executes the Notification Procedure
  * - It releases the mutex
  * .
+ * If the lock-free notification mode is enabled (see <code>::FwRtSetLockFreeNotif</code>),
+ * the mutex is not locked while the Activation Thread is busy: the Notification Counter
+ * is incremented atomically and the mutex is only locked to signal the container's
+ * condition variable if the Activation Thread is waiting for a notification.
  * @param rtDesc the descriptor of the RT Container.
  */
 void FwRtNotify(FwRtDesc_t rtDesc);
 
+/**
+ * Pass a payload to a RT Container and execute its Notification Procedure.
+ * The payload is put in the payload ring of the container (see
+ * <code>::FwRtSetPayloadRing</code>) and the Notification Procedure is then executed
+ * as by <code>::FwRtNotify</code>.
+ * The payload is not copied: it is taken by the Activation Procedure with
+ * <code>::FwRtTakePayload</code> and its ownership passes to the Activation Procedure.
+ * If the container has no payload ring or if the ring is full, the payload is not
+ * put in the ring and the Notification Procedure is not executed.
+ * @param rtDesc the descriptor of the RT Container.
+ * @param payload the payload (this must not be NULL).
+ * @return 1 if the payload was put in the payload ring, 0 otherwise.
+ */
+FwRtBool_t FwRtNotifyWithPayload(FwRtDesc_t rtDesc, void* payload);
+
+/**
+ * Take the oldest payload from the payload ring of a RT Container.
+ * This function is intended to be called by the container actions of the Activation
+ * Procedure (and in particular by the Execute Functional Behaviour action).
+ * It frees the slot of the payload in the ring and passes the ownership of the payload
+ * to its caller.
+ * Since the ring has a single consumer, this function must not be called by more than
+ * one thread at a time (it may be called by the application once the Activation
+ * Procedure has terminated).
+ * @param rtDesc the descriptor of the RT Container.
+ * @return the oldest payload in the payload ring or NULL if the ring is empty (or if
+ * the container has no payload ring).
+ */
+void* FwRtTakePayload(FwRtDesc_t rtDesc);
+
+/**
+ * Return the number of payloads in the payload ring of a RT Container.
+ * If payloads are being passed to the container concurrently, the value which is
+ * returned may include payloads which are not yet available to
+ * <code>::FwRtTakePayload</code>.
+ * @param rtDesc the descriptor of the RT Container.
+ * @return the number of payloads in the payload ring.
+ */
+FwRtCounterU4_t FwRtGetNOfPayloads(FwRtDesc_t rtDesc);
+
+/**
+ * Return the number of notifications consumed by the current execution of the
+ * Activation Procedure.
+ * This function is intended to be called by the container actions of the Activation
+ * Procedure (and in particular by the Execute Functional Behaviour action).
+ * If the notification coalescing mode is disabled, each execution of the Activation
+ * Procedure consumes exactly one notification and this function returns 1.
+ * If the notification coalescing mode is enabled (see <code>::FwRtSetNotifCoalescing</code>),
+ * this function returns the number of notifications which have been collapsed into the
+ * current execution so that the functional behaviour can process them as a batch.
+ * @param rtDesc the descriptor of the RT Container.
+ * @return the number of notifications consumed by the current execution of the
+ * Activation Procedure.
+ */
+FwRtCounterU2_t FwRtGetNOfCoalescedNotif(FwRtDesc_t rtDesc);
+
+/**
+ * Return the number of overruns of a RT Container in the periodic activation mode.
+ * An overrun is a release of the Activation Thread which is skipped because the
+ * Activation Procedure was still executing when the release was due (see
+ * <code>::FwRtSetPeriodic</code>).
+ * The counter is reset when the container is started.
+ * This function is not thread-safe (but note that it only returns the value of
+ * a field of the RT Container descriptor).
+ * @param rtDesc the descriptor of the RT Container.
+ * @return the number of overruns since the container was last started.
+ */
+FwRtCounterU4_t FwRtGetNOfOverruns(FwRtDesc_t rtDesc);
+
+/**
+ * Return the longest execution time of the Execute Functional Behaviour action of a
+ * RT Container in the periodic activation mode.
+ * The execution time is measured on the monotonic clock for each execution of the
+ * action (see <code>::FwRtSetPeriodic</code>) and is reset when the container is
+ * started.
+ * The execution time is not measured if the periodic activation mode is disabled.
+ * This function is not thread-safe.
+ * @param rtDesc the descriptor of the RT Container.
+ * @return the longest execution time since the container was last started.
+ */
+struct timespec FwRtGetMaxExecTime(FwRtDesc_t rtDesc);
+
+/**
+ * Execute one iteration of the Activation Thread loop of a pooled RT Container.
+ * This function is called by the worker threads of a RT Pool for a container
+ * taken from the pool's ready queue (see <code>::FwRtStart</code>).
+ * It consumes one notification and executes the Activation Procedure exactly
+ * as the Activation Thread of a non-pooled container would.
+ * If further notifications are pending when the Activation Procedure returns,
+ * the container is put back at the end of the ready queue (if this fails, the
+ * container is left in the error state set by <code>::FwRtPoolEnqueue</code> and
+ * its mutex is released).
+ * If instead the Activation Procedure has terminated, the function signals the
+ * container's condition variable to release <code>::FwRtWaitForTermination</code>.
+ *
+ * The ready queue guarantees that this function is never executed concurrently
+ * on the same container.
+ * Applications do not normally call it directly.
+ * @param rtDesc the descriptor of the RT Container.
+ */
+void FwRtRunPooled(FwRtDesc_t rtDesc);
+
 /**
  * Check whether the Notification Procedure is started.
  * This function is not thread-safe (but note that it only returns the value of
@@ -206,4 +334,44 @@ int FwRtGetErrCode(FwRtDesc_t rtDesc);
  */
 FwRtCounterU2_t FwRtGetNotifCounter(FwRtDesc_t rtDesc);
 
+/**
+ * Return the latency histograms of a RT Container.
+ * The latency instrumentation of a RT Container is only compiled in if the RT
+ * Container module is built with the symbol <code>FW_RT_STATS</code> defined (e.g.
+ * <code>make release RT_STATS=1</code>).
+ * The symbol must be defined in the same way when the module and the application
+ * are built because it changes the layout of the container descriptor.
+ * If the symbol is not defined, the instrumentation has no run-time cost.
+ *
+ * The instrumentation records three histograms with logarithmic bins (see
+ * <code>#FW_RT_N_OF_HIST_BINS</code>):
+ * - the delay in nanoseconds from a notification until the Activation Procedure
+ *   wakes up to process it (if several notifications are pending, the delay is
+ *   measured from the oldest of them);
+ * - the execution time in nanoseconds of the Execute Functional Behaviour action;
+ * - the value of the Notification Counter when the Activation Procedure wakes up
+ *   (i.e. the depth of the queue of pending notifications).
+ * .
+ * The time stamps are taken on the monotonic clock.
+ * The histograms are reset by <code>::FwRtReset</code> and <code>::FwRtResetStats</code>
+ * but not when the container is started.
+ *
+ * This function copies the histograms with the container mutex locked.
+ * The execution time of an execution of the Execute Functional Behaviour action
+ * which is in progress may not yet be included in the copy.
+ * @param rtDesc the descriptor of the RT Container.
+ * @param stats the structure where the histograms are copied.
+ * @return 1 if the histograms were copied or 0 if the instrumentation is not compiled
+ * in (in that case all histograms are returned empty) or if a system call failed.
+ */
+FwRtBool_t FwRtGetStats(FwRtDesc_t rtDesc, FwRtStats_t* stats);
+
+/**
+ * Reset the latency histograms of a RT Container.
+ * This function locks the container mutex and does nothing if the latency
+ * instrumentation is not compiled in (see <code>::FwRtGetStats</code>).
+ * @param rtDesc the descriptor of the RT Container.
+ */
+void FwRtResetStats(FwRtDesc_t rtDesc);
+
 #endif /* FWRT_CORE_H_ */
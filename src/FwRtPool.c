@@ -0,0 +1,200 @@
+/**
+ * @file
+ * @ingroup rtGroup
+ * Implements the RT Pool.
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the FW Profile.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#include "FwRtPool.h"
+#include "FwRtConstants.h"
+#include "FwRtCore.h"
+#include <pthread.h>
+#include <stdlib.h>
+
+/**
+ * The worker thread of a RT Pool.
+ * The worker thread waits until the ready queue of the pool is not empty, takes the
+ * container at the head of the queue, and executes it with <code>::FwRtRunPooled</code>.
+ * The thread terminates when the pool is shut down and the ready queue is empty.
+ * @param ptr the descriptor of the RT Pool
+ * @return this function always returns NULL
+ */
+void* ExecPoolThread(void* ptr);
+
+/*--------------------------------------------------------------------------------------*/
+void FwRtPoolInit(FwRtPoolDesc_t pool, pthread_t* threads, int nOfThreads, pthread_attr_t* pThreadAttr) {
+  int errCode;
+  int i;
+
+  pool->threads     = threads;
+  pool->nOfThreads  = 0;
+  pool->pThreadAttr = pThreadAttr;
+  pool->head        = NULL;
+  pool->tail        = NULL;
+  pool->isShutdown  = 0;
+  pool->errCode     = 0;
+
+  if ((errCode = pthread_mutex_init(&(pool->mutex), NULL)) != 0) {
+    pool->errCode = errCode;
+    pool->state   = rtMutexInitErr;
+    return;
+  }
+
+  if ((errCode = pthread_cond_init(&(pool->cond), NULL)) != 0) {
+    pool->errCode = errCode;
+    pool->state   = rtCondInitErr;
+    return;
+  }
+
+  pool->state = rtContStarted;
+
+  for (i = 0; i < nOfThreads; i++) {
+    if ((errCode = pthread_create(&(threads[i]), pThreadAttr, ExecPoolThread, pool)) != 0) {
+      pool->errCode = errCode;
+      pool->state   = rtThreadCreateErr;
+      return;
+    }
+    pool->nOfThreads++;
+  }
+}
+
+/*--------------------------------------------------------------------------------------*/
+void FwRtPoolShutdown(FwRtPoolDesc_t pool) {
+  int   errCode;
+  int   i;
+  void* status = 0;
+
+  if ((errCode = pthread_mutex_lock(&(pool->mutex))) != 0) {
+    pool->errCode = errCode;
+    pool->state   = rtMutexLockErr;
+    return;
+  }
+  pool->isShutdown = 1;
+  if ((errCode = pthread_cond_broadcast(&(pool->cond))) != 0) {
+    pool->errCode = errCode;
+    pool->state   = rtCondSignalErr;
+    return;
+  }
+  if ((errCode = pthread_mutex_unlock(&(pool->mutex))) != 0) {
+    pool->errCode = errCode;
+    pool->state   = rtMutexUnlockErr;
+    return;
+  }
+
+  for (i = 0; i < pool->nOfThreads; i++) {
+    if ((errCode = pthread_join(pool->threads[i], &status)) != 0) {
+      pool->errCode = errCode;
+      pool->state   = rtJoinErr;
+      return;
+    }
+  }
+  pool->nOfThreads = 0;
+
+  if ((errCode = pthread_cond_destroy(&(pool->cond))) != 0) {
+    pool->errCode = errCode;
+    pool->state   = rtCondDestroyErr;
+    return;
+  }
+
+  if ((errCode = pthread_mutex_destroy(&(pool->mutex))) != 0) {
+    pool->errCode = errCode;
+    pool->state   = rtMutexDestroyErr;
+    return;
+  }
+
+  pool->state = rtContUninitialized;
+}
+
+/*--------------------------------------------------------------------------------------*/
+FwRtBool_t FwRtPoolEnqueue(FwRtPoolDesc_t pool, FwRtDesc_t rtDesc) {
+  int errCode;
+
+  if ((errCode = pthread_mutex_lock(&(pool->mutex))) != 0) {
+    rtDesc->errCode = errCode;
+    rtDesc->state   = rtMutexLockErr;
+    return 0;
+  }
+
+  rtDesc->nextReady = NULL;
+  if (pool->tail == NULL) {
+    pool->head = rtDesc;
+  } else {
+    pool->tail->nextReady = rtDesc;
+  }
+  pool->tail = rtDesc;
+
+  if ((errCode = pthread_cond_signal(&(pool->cond))) != 0) {
+    rtDesc->errCode = errCode;
+    rtDesc->state   = rtCondSignalErr;
+    (void)pthread_mutex_unlock(&(pool->mutex));
+    return 0;
+  }
+
+  if ((errCode = pthread_mutex_unlock(&(pool->mutex))) != 0) {
+    rtDesc->errCode = errCode;
+    rtDesc->state   = rtMutexUnlockErr;
+    return 0;
+  }
+  return 1;
+}
+
+/*--------------------------------------------------------------------------------------*/
+FwRtState_t FwRtPoolGetState(FwRtPoolDesc_t pool) {
+  return pool->state;
+}
+
+/*--------------------------------------------------------------------------------------*/
+int FwRtPoolGetErrCode(FwRtPoolDesc_t pool) {
+  return pool->errCode;
+}
+
+/*--------------------------------------------------------------------------------------*/
+void* ExecPoolThread(void* ptr) {
+  FwRtPoolDesc_t pool = (FwRtPoolDesc_t)ptr;
+  FwRtDesc_t     rtDesc;
+  int            errCode;
+
+  while (1) {
+    if ((errCode = pthread_mutex_lock(&(pool->mutex))) != 0) {
+      pool->errCode = errCode;
+      pool->state   = rtMutexLockErr;
+      return NULL;
+    }
+    while ((pool->head == NULL) && (pool->isShutdown == 0)) {
+      if ((errCode = pthread_cond_wait(&(pool->cond), &(pool->mutex))) != 0) {
+        pool->errCode = errCode;
+        pool->state   = rtCondWaitErr;
+        return NULL;
+      }
+    }
+    rtDesc = pool->head;
+    if (rtDesc != NULL) {
+      pool->head = rtDesc->nextReady;
+      if (pool->head == NULL) {
+        pool->tail = NULL;
+      }
+    }
+    if ((errCode = pthread_mutex_unlock(&(pool->mutex))) != 0) {
+      pool->errCode = errCode;
+      pool->state   = rtMutexUnlockErr;
+      return NULL;
+    }
+
+    if (rtDesc == NULL) { /* Pool is shut down and ready queue is empty */
+      break;
+    }
+    FwRtRunPooled(rtDesc);
+  }
+
+  return NULL;
+}
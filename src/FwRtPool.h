@@ -0,0 +1,130 @@
+/**
+ * @file
+ * @ingroup rtGroup
+ * Declaration of the API for a RT Pool.
+ * A RT Pool is a fixed set of POSIX worker threads which execute the
+ * Activation Procedures of the RT Containers attached to it.
+ * It is an alternative to giving each RT Container its own Activation Thread
+ * and is useful when a large number of containers must be instantiated.
+ *
+ * The RT Pool holds a ready queue of containers.
+ * A container is put at the end of the ready queue when its Notification Counter
+ * is incremented (i.e. when <code>::FwRtNotify</code> or <code>::FwRtStop</code>
+ * notify the Activation Procedure).
+ * A container is in the ready queue at most once and the idle worker threads
+ * take the containers from the head of the queue and execute them with
+ * <code>::FwRtRunPooled</code>.
+ * The Notification Procedure and the Activation Procedure of a pooled container
+ * behave as those of a container with its own Activation Thread.
+ *
+ * The basic mode of use of the functions defined in this header file is as follows:
+ * -# The user instantiates a variable of type <code>struct FwRtPool</code> and an
+ *    array of <code>pthread_t</code> to hold the worker threads.
+ * -# The pool is initialized with function <code>::FwRtPoolInit</code>.
+ * -# The RT Containers are attached to the pool with function
+ *    <code>::FwRtSetPool</code> during their configuration and are then
+ *    used as normal (see <code>FwRtCore.h</code>).
+ * -# After all containers have been stopped and have terminated, the pool is shut
+ *    down with function <code>::FwRtPoolShutdown</code>.
+ * .
+ * If the container mutex and the pool mutex must both be held, the container
+ * mutex is always locked first.
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the FW Profile.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#ifndef FWRT_POOL_H_
+#define FWRT_POOL_H_
+
+#include "FwRtConstants.h"
+#include <pthread.h>
+
+/**
+ * Initialize a RT Pool and create its worker threads.
+ * This function proceeds as follows:
+ * - It empties the ready queue of the pool.
+ * - It initializes the pool mutex and condition variable.
+ * - It creates <code>nOfThreads</code> worker threads and stores them in
+ *   <code>threads</code>.
+ * - It puts the pool in state <code>::rtContStarted</code>.
+ * .
+ * The worker threads are created with the attributes pointed at by
+ * <code>pThreadAttr</code> (a value of NULL means that default attributes are used).
+ * The attribute object, if present, must already have been initialized by the caller.
+ *
+ * If any of the system calls made by this function returns an error, the
+ * pool is put in an error state (see <code>::FwRtState_t</code>) and
+ * the error code is stored in the <code>errCode</code> field of the pool
+ * descriptor.
+ * The threads which were created before the error are still recorded in the pool
+ * descriptor and are terminated by <code>::FwRtPoolShutdown</code>.
+ * @param pool the descriptor of the RT Pool.
+ * @param threads the array where the worker threads are stored (it must hold at
+ * least <code>nOfThreads</code> elements).
+ * @param nOfThreads the number of worker threads (a positive integer).
+ * @param pThreadAttr the attributes of the worker threads (or NULL).
+ */
+void FwRtPoolInit(FwRtPoolDesc_t pool, pthread_t* threads, int nOfThreads, pthread_attr_t* pThreadAttr);
+
+/**
+ * Shut down a RT Pool.
+ * This function asks the worker threads to terminate, waits until they have
+ * terminated, and then releases the pool mutex and condition variable.
+ * The worker threads only terminate after the ready queue has been emptied.
+ *
+ * This function should only be called after all the containers attached to the pool
+ * have been stopped and have terminated.
+ * At the end of this function, the pool is in state <code>::rtContUninitialized</code>.
+ *
+ * If any of the system calls made by this function returns an error, the
+ * pool is put in an error state (see <code>::FwRtState_t</code>) and
+ * the error code is stored in the <code>errCode</code> field of the pool
+ * descriptor.
+ * @param pool the descriptor of the RT Pool.
+ */
+void FwRtPoolShutdown(FwRtPoolDesc_t pool);
+
+/**
+ * Put a RT Container at the end of the ready queue of a RT Pool and release one
+ * of the pool's idle worker threads.
+ * This function is called by the RT Container functions when the Notification
+ * Counter of a pooled container is incremented.
+ * It is called with the container mutex locked.
+ * Applications do not normally call it directly.
+ *
+ * If any of the system calls made by this function returns an error, the
+ * container (not the pool) is put in an error state (see <code>::FwRtState_t</code>)
+ * and the error code is stored in the <code>errCode</code> field of the container
+ * descriptor.
+ * @param pool the descriptor of the RT Pool.
+ * @param rtDesc the descriptor of the RT Container.
+ * @return 1 if the container was queued successfully, 0 otherwise.
+ */
+FwRtBool_t FwRtPoolEnqueue(FwRtPoolDesc_t pool, FwRtDesc_t rtDesc);
+
+/**
+ * Return the state of a RT Pool.
+ * @param pool the descriptor of the RT Pool.
+ * @return the state of the RT Pool.
+ */
+FwRtState_t FwRtPoolGetState(FwRtPoolDesc_t pool);
+
+/**
+ * Return the error code of a RT Pool.
+ * The error code is the return value of the last system call made by the pool
+ * which failed.
+ * @param pool the descriptor of the RT Pool.
+ * @return the error code of the RT Pool.
+ */
+int FwRtPoolGetErrCode(FwRtPoolDesc_t pool);
+
+#endif /* FWRT_POOL_H_ */
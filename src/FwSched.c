@@ -0,0 +1,455 @@
+/**
+ * @file
+ * @ingroup scGroup
+ * Implements the scheduler of the state machine and procedure modules.
+ * The items of a scheduler are stored in the order in which they were added to it
+ * and, for the parallel execution of a cycle, in a second array where the work
+ * lists of the workers are stored one after the other.
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the FW Profile.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#include "FwSched.h"
+#include "FwSmCore.h"
+#include "FwPrCore.h"
+#include <pthread.h>
+#include <stdlib.h>
+
+/** Atomically add a value to a counter of a scheduler and return the new value. */
+#define SCHED_ATOMIC_ADD(var, val) __sync_add_and_fetch(&(var), (val))
+
+/**
+ * Size in bytes of the padding which keeps the position counters of the work lists
+ * of different workers in different cache lines.
+ */
+#define SCHED_PAD 64
+
+/** Structure representing an item of a scheduler. */
+typedef struct {
+  /** the state machine of the item (or NULL if the item is a procedure) */
+  FwSmDesc_t smDesc;
+  /** the procedure of the item (or NULL if the item is a state machine) */
+  FwPrDesc_t prDesc;
+  /** the index of the home worker of the item */
+  int home;
+} SchedItem_t;
+
+/**
+ * Structure representing a worker of a scheduler.
+ * The work list of the worker consists of the locations <code>begin</code> to
+ * <code>end-1</code> of the work list array of the scheduler.
+ * In each cycle, the items are taken from the work list by atomically incrementing
+ * <code>next</code> (both by the worker and by the workers which steal from it).
+ */
+typedef struct {
+  /** the scheduler to which the worker belongs */
+  struct FwSched* sched;
+  /** the index of the worker */
+  int index;
+  /** the thread of the worker (not used for the first worker) */
+  pthread_t thread;
+  /** the first location of the work list of the worker */
+  FwSchedCounterU4_t begin;
+  /** the location after the last location of the work list of the worker */
+  FwSchedCounterU4_t end;
+  /** the location of the next item to be taken from the work list in the current cycle */
+  volatile FwSchedCounterU4_t next;
+  /** padding which keeps the position counters of different workers in different cache lines */
+  unsigned char pad[SCHED_PAD];
+} SchedWorker_t;
+
+/**
+ * Structure representing a scheduler descriptor.
+ * The workers other than the first wait on <code>startCond</code> until
+ * <code>parCycle</code> is incremented and, when they have completed their part of the
+ * cycle, they increment <code>nOfDone</code> and the last of them signals
+ * <code>endCond</code>.
+ * These three fields are protected by <code>mutex</code>.
+ */
+struct FwSched {
+  /** the items in the order in which they were added to the scheduler */
+  SchedItem_t* items;
+  /** the work lists of the workers */
+  SchedItem_t** workList;
+  /** the number of items */
+  FwSchedCounterU4_t nOfItems;
+  /** the maximum number of items */
+  FwSchedCounterU4_t maxNOfItems;
+  /** the workers */
+  SchedWorker_t* workers;
+  /** the number of workers */
+  int nOfWorkers;
+  /** the number of worker threads which have been created */
+  int nOfThreads;
+  /** the home worker of the next item which is added without an affinity hint */
+  int nextHome;
+  /** flag indicating whether the work lists are up-to-date */
+  int isSorted;
+  /** the execution mode of the scheduler */
+  FwSchedMode_t mode;
+  /** the mutex which protects the synchronization between the workers */
+  pthread_mutex_t mutex;
+  /** the condition on which the workers wait for the start of a cycle */
+  pthread_cond_t startCond;
+  /** the condition on which the first worker waits for the end of a cycle */
+  pthread_cond_t endCond;
+  /** the number of cycles which have been executed in parallel mode */
+  FwSchedCounterU4_t parCycle;
+  /** the number of workers other than the first which have completed the current cycle */
+  int nOfDone;
+  /** flag indicating whether the worker threads must terminate */
+  int isShutdown;
+  /** the number of cycles which have been executed */
+  FwSchedCounterU4_t nOfCycles;
+  /** the number of items which have been executed by a worker other than their home worker */
+  volatile FwSchedCounterU4_t nOfSteals;
+};
+
+/**
+ * Add an item to a scheduler.
+ * @param sched the descriptor of the scheduler.
+ * @param smDesc the state machine of the item (or NULL).
+ * @param prDesc the procedure of the item (or NULL).
+ * @param affinity the affinity hint of the item.
+ * @return 1 if the item was added or 0 if the scheduler is full.
+ */
+static int SchedAdd(FwSchedDesc_t sched, FwSmDesc_t smDesc, FwPrDesc_t prDesc, int affinity);
+
+/**
+ * Build the work lists of the workers of a scheduler.
+ * The items of each work list are in the order in which they were added.
+ * @param sched the descriptor of the scheduler.
+ */
+static void SchedSort(FwSchedDesc_t sched);
+
+/**
+ * Execute the part of a cycle of a scheduler which falls to one of its workers.
+ * The worker executes the items of its work list and then the items which remain in
+ * the work lists of the other workers.
+ * @param sched the descriptor of the scheduler.
+ * @param index the index of the worker.
+ */
+static void SchedExecute(FwSchedDesc_t sched, int index);
+
+/**
+ * Execute an item of a scheduler.
+ * @param item the item.
+ */
+static void SchedExecItem(SchedItem_t* item);
+
+/**
+ * Function executed by the threads of the workers of a scheduler (other than the first).
+ * The thread waits for the start of each cycle, executes its part of the cycle and
+ * reports its completion until the scheduler is released.
+ * @param ptr the worker.
+ * @return NULL
+ */
+static void* SchedThread(void* ptr);
+
+/**
+ * Terminate the worker threads of a scheduler and release its memory.
+ * @param sched the descriptor of the scheduler.
+ */
+static void SchedShutdown(FwSchedDesc_t sched);
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+FwSchedDesc_t FwSchedCreate(int nOfWorkers, FwSchedCounterU4_t maxNOfItems, pthread_attr_t* const* threadAttr) {
+  FwSchedDesc_t   sched;
+  pthread_attr_t* attr;
+  int             i;
+
+  if ((nOfWorkers < 1) || (maxNOfItems == 0)) {
+    return NULL;
+  }
+
+  sched = (FwSchedDesc_t)malloc(sizeof(struct FwSched));
+  if (sched == NULL) {
+    return NULL;
+  }
+  sched->items    = (SchedItem_t*)malloc(maxNOfItems * sizeof(SchedItem_t));
+  sched->workList = (SchedItem_t**)malloc(maxNOfItems * sizeof(SchedItem_t*));
+  sched->workers  = (SchedWorker_t*)malloc(((FwSchedCounterU4_t)nOfWorkers) * sizeof(SchedWorker_t));
+  if ((sched->items == NULL) || (sched->workList == NULL) || (sched->workers == NULL)) {
+    free(sched->items);
+    free(sched->workList);
+    free(sched->workers);
+    free(sched);
+    return NULL;
+  }
+
+  if (pthread_mutex_init(&(sched->mutex), NULL) != 0) {
+    free(sched->items);
+    free(sched->workList);
+    free(sched->workers);
+    free(sched);
+    return NULL;
+  }
+  if (pthread_cond_init(&(sched->startCond), NULL) != 0) {
+    (void)pthread_mutex_destroy(&(sched->mutex));
+    free(sched->items);
+    free(sched->workList);
+    free(sched->workers);
+    free(sched);
+    return NULL;
+  }
+  if (pthread_cond_init(&(sched->endCond), NULL) != 0) {
+    (void)pthread_cond_destroy(&(sched->startCond));
+    (void)pthread_mutex_destroy(&(sched->mutex));
+    free(sched->items);
+    free(sched->workList);
+    free(sched->workers);
+    free(sched);
+    return NULL;
+  }
+
+  sched->nOfItems    = 0;
+  sched->maxNOfItems = maxNOfItems;
+  sched->nOfWorkers  = nOfWorkers;
+  sched->nOfThreads  = 0;
+  sched->nextHome    = 0;
+  sched->isSorted    = 1;
+  sched->mode        = schedParallel;
+  sched->parCycle    = 0;
+  sched->nOfDone     = 0;
+  sched->isShutdown  = 0;
+  sched->nOfCycles   = 0;
+  sched->nOfSteals   = 0;
+  for (i = 0; i < nOfWorkers; i++) {
+    sched->workers[i].sched = sched;
+    sched->workers[i].index = i;
+    sched->workers[i].begin = 0;
+    sched->workers[i].end   = 0;
+    sched->workers[i].next  = 0;
+  }
+
+  /* The first worker is the thread which runs the cycles */
+  for (i = 1; i < nOfWorkers; i++) {
+    attr = (threadAttr != NULL) ? threadAttr[i - 1] : NULL;
+    if (pthread_create(&(sched->workers[i].thread), attr, SchedThread, &(sched->workers[i])) != 0) {
+      SchedShutdown(sched);
+      return NULL;
+    }
+    sched->nOfThreads++;
+  }
+
+  return sched;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+int FwSchedAddSm(FwSchedDesc_t sched, FwSmDesc_t smDesc, int affinity) {
+  return SchedAdd(sched, smDesc, NULL, affinity);
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+int FwSchedAddPr(FwSchedDesc_t sched, FwPrDesc_t prDesc, int affinity) {
+  return SchedAdd(sched, NULL, prDesc, affinity);
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+void FwSchedSetMode(FwSchedDesc_t sched, FwSchedMode_t mode) {
+  sched->mode = mode;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+void FwSchedRun(FwSchedDesc_t sched) {
+  FwSchedCounterU4_t i;
+  int                w;
+
+  if ((sched->mode == schedSerial) || (sched->nOfWorkers == 1)) {
+    for (i = 0; i < sched->nOfItems; i++) {
+      SchedExecItem(&(sched->items[i]));
+    }
+    sched->nOfCycles++;
+    return;
+  }
+
+  if (sched->isSorted == 0) {
+    SchedSort(sched);
+  }
+  for (w = 0; w < sched->nOfWorkers; w++) {
+    sched->workers[w].next = sched->workers[w].begin;
+  }
+
+  /* Release the other workers (the mutex makes the reset work lists visible to them) */
+  (void)pthread_mutex_lock(&(sched->mutex));
+  sched->nOfDone = 0;
+  sched->parCycle++;
+  (void)pthread_cond_broadcast(&(sched->startCond));
+  (void)pthread_mutex_unlock(&(sched->mutex));
+
+  SchedExecute(sched, 0);
+
+  /* Barrier at the end of the cycle */
+  (void)pthread_mutex_lock(&(sched->mutex));
+  while (sched->nOfDone < sched->nOfWorkers - 1) {
+    (void)pthread_cond_wait(&(sched->endCond), &(sched->mutex));
+  }
+  (void)pthread_mutex_unlock(&(sched->mutex));
+
+  sched->nOfCycles++;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+FwSchedCounterU4_t FwSchedGetNOfCycles(FwSchedDesc_t sched) {
+  return sched->nOfCycles;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+FwSchedCounterU4_t FwSchedGetNOfSteals(FwSchedDesc_t sched) {
+  return sched->nOfSteals;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+void FwSchedRelease(FwSchedDesc_t sched) {
+  SchedShutdown(sched);
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+static int SchedAdd(FwSchedDesc_t sched, FwSmDesc_t smDesc, FwPrDesc_t prDesc, int affinity) {
+  SchedItem_t* item;
+
+  if (sched->nOfItems == sched->maxNOfItems) {
+    return 0;
+  }
+
+  item         = &(sched->items[sched->nOfItems]);
+  item->smDesc = smDesc;
+  item->prDesc = prDesc;
+  if (affinity < 0) {
+    item->home      = sched->nextHome;
+    sched->nextHome = (sched->nextHome + 1) % sched->nOfWorkers;
+  }
+  else {
+    item->home = affinity % sched->nOfWorkers;
+  }
+  sched->nOfItems++;
+  sched->isSorted = 0;
+
+  return 1;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+static void SchedSort(FwSchedDesc_t sched) {
+  FwSchedCounterU4_t i;
+  SchedWorker_t*     worker;
+  int                w;
+
+  /* The "end" fields first count the items of each work list and then serve as insertion points */
+  for (w = 0; w < sched->nOfWorkers; w++) {
+    sched->workers[w].end = 0;
+  }
+  for (i = 0; i < sched->nOfItems; i++) {
+    sched->workers[sched->items[i].home].end++;
+  }
+  sched->workers[0].begin = 0;
+  for (w = 1; w < sched->nOfWorkers; w++) {
+    sched->workers[w].begin = sched->workers[w - 1].begin + sched->workers[w - 1].end;
+  }
+  for (w = 0; w < sched->nOfWorkers; w++) {
+    sched->workers[w].end = sched->workers[w].begin;
+  }
+  for (i = 0; i < sched->nOfItems; i++) {
+    worker                       = &(sched->workers[sched->items[i].home]);
+    sched->workList[worker->end] = &(sched->items[i]);
+    worker->end++;
+  }
+
+  sched->isSorted = 1;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+static void SchedExecute(FwSchedDesc_t sched, int index) {
+  SchedWorker_t*     worker;
+  FwSchedCounterU4_t pos;
+  FwSchedCounterU4_t nOfSteals = 0;
+  int                k;
+
+  /* The own work list is visited first (k=0) and then those of the following workers */
+  for (k = 0; k < sched->nOfWorkers; k++) {
+    worker = &(sched->workers[(index + k) % sched->nOfWorkers]);
+    for (;;) {
+      pos = SCHED_ATOMIC_ADD(worker->next, 1) - 1;
+      if (pos >= worker->end) {
+        break;
+      }
+      SchedExecItem(sched->workList[pos]);
+      if (k > 0) {
+        nOfSteals++;
+      }
+    }
+  }
+
+  if (nOfSteals > 0) {
+    (void)SCHED_ATOMIC_ADD(sched->nOfSteals, nOfSteals);
+  }
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+static void SchedExecItem(SchedItem_t* item) {
+  if (item->smDesc != NULL) {
+    FwSmExecute(item->smDesc);
+  }
+  else {
+    FwPrExecute(item->prDesc);
+  }
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+static void* SchedThread(void* ptr) {
+  SchedWorker_t*     worker = (SchedWorker_t*)ptr;
+  FwSchedDesc_t      sched  = worker->sched;
+  FwSchedCounterU4_t cycle  = 0;
+
+  (void)pthread_mutex_lock(&(sched->mutex));
+  for (;;) {
+    while ((sched->parCycle == cycle) && (sched->isShutdown == 0)) {
+      (void)pthread_cond_wait(&(sched->startCond), &(sched->mutex));
+    }
+    if (sched->isShutdown != 0) {
+      break;
+    }
+    cycle = sched->parCycle;
+    (void)pthread_mutex_unlock(&(sched->mutex));
+
+    SchedExecute(sched, worker->index);
+
+    (void)pthread_mutex_lock(&(sched->mutex));
+    sched->nOfDone++;
+    if (sched->nOfDone == sched->nOfWorkers - 1) {
+      (void)pthread_cond_signal(&(sched->endCond));
+    }
+  }
+  (void)pthread_mutex_unlock(&(sched->mutex));
+
+  return NULL;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+static void SchedShutdown(FwSchedDesc_t sched) {
+  int i;
+
+  (void)pthread_mutex_lock(&(sched->mutex));
+  sched->isShutdown = 1;
+  (void)pthread_cond_broadcast(&(sched->startCond));
+  (void)pthread_mutex_unlock(&(sched->mutex));
+  for (i = 1; i <= sched->nOfThreads; i++) {
+    (void)pthread_join(sched->workers[i].thread, NULL);
+  }
+
+  (void)pthread_cond_destroy(&(sched->endCond));
+  (void)pthread_cond_destroy(&(sched->startCond));
+  (void)pthread_mutex_destroy(&(sched->mutex));
+  free(sched->items);
+  free(sched->workList);
+  free(sched->workers);
+  free(sched);
+}
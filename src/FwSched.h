@@ -0,0 +1,187 @@
+/**
+ * @file
+ * @ingroup scGroup
+ * Declaration of the scheduler interface of the state machine and procedure modules.
+ * A scheduler executes a set of independent top-level state machines and procedures
+ * (the <i>items</i> of the scheduler) in cycles.
+ * In each cycle, each item is executed once (with <code>::FwSmExecute</code> or
+ * <code>::FwPrExecute</code>) and the cycle ends when all items have been executed.
+ *
+ * The basic mode of use of the functions declared in this file is as follows:
+ * -# The scheduler is created with function <code>::FwSchedCreate</code>.
+ * -# The state machines and procedures are added to the scheduler with functions
+ *    <code>::FwSchedAddSm</code> and <code>::FwSchedAddPr</code>.
+ * -# The state machines and procedures are started by the application.
+ * -# The application executes one cycle of the scheduler with function
+ *    <code>::FwSchedRun</code> whenever the items are due for execution (e.g. once
+ *    every period).
+ * -# The scheduler is released with function <code>::FwSchedRelease</code>.
+ * .
+ * A scheduler has a fixed number of <i>workers</i>.
+ * The first worker is the thread which calls <code>::FwSchedRun</code> and the other
+ * workers are POSIX threads which are created together with the scheduler.
+ * Each item is assigned to a <i>home worker</i> when it is added to the scheduler
+ * (either as requested by the application through an affinity hint or in round-robin
+ * order) and the items assigned to the same worker form its <i>work list</i>.
+ * In each cycle, a worker first executes the items of its own work list and then
+ * steals items which have not yet been executed from the work lists of the other
+ * workers.
+ * Hence, an item is normally executed by the same worker in every cycle and it is
+ * only executed by another worker when its home worker falls behind.
+ * If the worker threads are bound to processor cores through the attributes with
+ * which they are created, the items therefore stay on the same core between cycles.
+ * The end of a cycle is a barrier: <code>::FwSchedRun</code> only returns after all
+ * items have been executed.
+ *
+ * Items are taken from a work list through an atomic increment of its position
+ * counter and are therefore executed exactly once per cycle without locking.
+ * The workers are released at the start of a cycle and wait for the next cycle at
+ * its end through a mutex and condition variables.
+ * The items of a scheduler must be independent: they must not share data which is
+ * modified by their actions and guards and they must not embed each other.
+ * The state machines embedded in an item are executed by the worker which executes
+ * the item.
+ *
+ * A scheduler can be put in <i>serial mode</i> (see <code>::FwSchedSetMode</code>).
+ * In serial mode, the items are executed by the thread which calls
+ * <code>::FwSchedRun</code> in the order in which they were added to the scheduler.
+ * The execution of a cycle is then deterministic which is useful, for instance, to
+ * replay a recorded sequence of cycles.
+ *
+ * The memory for the scheduler descriptor is allocated dynamically through calls
+ * to <code>malloc</code> and released through calls to <code>free</code>.
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the FW Profile.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#ifndef FWSCHED_H_
+#define FWSCHED_H_
+
+#include "FwSmConstants.h"
+#include "FwPrConstants.h"
+#include <pthread.h>
+
+/**
+ * Forward declaration for the pointer to a scheduler descriptor.
+ * The internal definition of the scheduler descriptor (see <code>FwSched.c</code>)
+ * is kept hidden from users.
+ */
+typedef struct FwSched* FwSchedDesc_t;
+
+/** Type used for the numbers of items and for the counters of a scheduler. */
+typedef long unsigned int FwSchedCounterU4_t;
+
+/** Enumerated type for the execution modes of a scheduler. */
+typedef enum {
+  /** The items are executed in parallel by the workers of the scheduler. */
+  schedParallel = 0,
+  /** The items are executed in the order in which they were added by the calling thread. */
+  schedSerial = 1
+} FwSchedMode_t;
+
+/**
+ * Value of the affinity hint of an item which asks the scheduler to select the
+ * home worker of the item (see <code>::FwSchedAddSm</code>).
+ */
+#define FW_SCHED_ANY_WORKER (-1)
+
+/**
+ * Create a new scheduler and its worker threads.
+ * The scheduler is created in parallel mode and it holds no items.
+ * The worker threads (all workers other than the first) are created with the
+ * attributes in array <code>threadAttr</code>: the i-th element of the array holds
+ * the attributes of the (i+1)-th worker.
+ * The attributes can, for instance, bind the workers to processor cores.
+ * A value of NULL for the array or for one of its elements means that default
+ * attributes are used.
+ * @param nOfWorkers the number of workers (a positive integer).
+ * @param maxNOfItems the maximum number of items of the scheduler (a positive integer).
+ * @param threadAttr the attributes of the worker threads (or NULL).
+ * @return the descriptor of the new scheduler (or NULL if the creation of the data
+ * structures to hold the scheduler descriptor or of the worker threads failed or if
+ * one of the arguments is illegal).
+ */
+FwSchedDesc_t FwSchedCreate(int nOfWorkers, FwSchedCounterU4_t maxNOfItems, pthread_attr_t* const* threadAttr);
+
+/**
+ * Add a state machine to a scheduler.
+ * The state machine is executed with <code>::FwSmExecute</code> in each cycle of the
+ * scheduler.
+ * The affinity hint is either the index of the home worker of the state machine
+ * (an integer in the range [0,N-1] where N is the number of workers; larger values
+ * are reduced modulo N) or <code>#FW_SCHED_ANY_WORKER</code>.
+ * This function must not be called while a cycle is executed.
+ * @param sched the descriptor of the scheduler.
+ * @param smDesc the state machine.
+ * @param affinity the affinity hint of the state machine.
+ * @return 1 if the state machine was added or 0 if the scheduler is full.
+ */
+int FwSchedAddSm(FwSchedDesc_t sched, FwSmDesc_t smDesc, int affinity);
+
+/**
+ * Add a procedure to a scheduler.
+ * The procedure is executed with <code>::FwPrExecute</code> in each cycle of the
+ * scheduler.
+ * The affinity hint has the same meaning as for <code>::FwSchedAddSm</code>.
+ * This function must not be called while a cycle is executed.
+ * @param sched the descriptor of the scheduler.
+ * @param prDesc the procedure.
+ * @param affinity the affinity hint of the procedure.
+ * @return 1 if the procedure was added or 0 if the scheduler is full.
+ */
+int FwSchedAddPr(FwSchedDesc_t sched, FwPrDesc_t prDesc, int affinity);
+
+/**
+ * Set the execution mode of a scheduler.
+ * This function must not be called while a cycle is executed.
+ * @param sched the descriptor of the scheduler.
+ * @param mode the execution mode.
+ */
+void FwSchedSetMode(FwSchedDesc_t sched, FwSchedMode_t mode);
+
+/**
+ * Execute one cycle of a scheduler.
+ * Each item of the scheduler is executed once and the function returns when all
+ * items have been executed.
+ * In parallel mode, the calling thread acts as the first worker of the scheduler.
+ * This function must only be called by one thread at a time.
+ * @param sched the descriptor of the scheduler.
+ */
+void FwSchedRun(FwSchedDesc_t sched);
+
+/**
+ * Return the number of cycles which have been executed by a scheduler.
+ * @param sched the descriptor of the scheduler.
+ * @return the number of cycles.
+ */
+FwSchedCounterU4_t FwSchedGetNOfCycles(FwSchedDesc_t sched);
+
+/**
+ * Return the number of items which have been executed by a worker other than their
+ * home worker since the scheduler was created.
+ * @param sched the descriptor of the scheduler.
+ * @return the number of stolen items.
+ */
+FwSchedCounterU4_t FwSchedGetNOfSteals(FwSchedDesc_t sched);
+
+/**
+ * Release a scheduler.
+ * The worker threads are terminated and the memory which was allocated when the
+ * scheduler was created is released.
+ * The items of the scheduler are not affected.
+ * This function must not be called while a cycle is executed.
+ * After this operation is called, the scheduler descriptor can no longer be used.
+ * @param sched the descriptor of the scheduler.
+ */
+void FwSchedRelease(FwSchedDesc_t sched);
+
+#endif /* FWSCHED_H_ */
@@ -0,0 +1,220 @@
+/**
+ * @file
+ * @ingroup smGroup
+ * Implements the action offload functions for the FW State Machine Module.
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2011, All Rights Reserved
+ *
+ * This file is part of the FW Profile.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#include "FwSmAsync.h"
+#include "FwSmQueue.h"
+#include "FwSmPrivate.h"
+#include "FwRtConfig.h"
+#include "FwRtCore.h"
+#include <pthread.h>
+#include <stdlib.h>
+
+/**
+ * Offload an operation to the RT Container of an offload descriptor.
+ * @param async the offload descriptor.
+ * @param smDesc the state machine.
+ * @param queue the event queue to which the completion trigger is posted (or NULL).
+ * @param operation the operation.
+ * @param transId the completion trigger.
+ * @return <code>#smSuccess</code> if the operation was offloaded or
+ * <code>#smAsyncFull</code> otherwise.
+ */
+static FwSmErrCode_t AsyncRun(FwSmAsyncDesc_t async, FwSmDesc_t smDesc, FwSmQueueDesc_t queue,
+                              FwSmAction_t operation, FwSmCounterU2_t transId);
+
+/**
+ * Execute Functional Behaviour action of the RT Container of an offload descriptor.
+ * The action executes the operations of all the jobs in the payload ring of the container
+ * and then either posts their completion triggers to their queues (and frees the jobs) or
+ * puts the jobs in the list of completed jobs.
+ * @param rtDesc the RT Container.
+ * @return always return 0 (the functional behaviour never terminates).
+ */
+static FwRtOutcome_t AsyncExec(FwRtDesc_t rtDesc);
+
+/**
+ * Put a job in the list of free jobs of an offload descriptor.
+ * @param async the offload descriptor.
+ * @param job the job.
+ */
+static void AsyncFreeJob(FwSmAsyncDesc_t async, SmAsyncJob_t* job);
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+FwSmAsyncDesc_t FwSmAsyncCreate(FwRtDesc_t rtDesc, FwSmCounterU4_t nOfJobs) {
+  FwSmAsyncDesc_t async;
+  FwSmCounterU4_t nOfSlots = 1;
+  FwSmCounterU4_t i;
+
+  if ((nOfJobs == 0) || (FwRtGetContState(rtDesc) != rtContUninitialized)) {
+    return NULL;
+  }
+
+  /* The payload ring holds all the jobs so that passing a job to the container never fails */
+  while (nOfSlots < nOfJobs) {
+    nOfSlots = nOfSlots << 1;
+  }
+
+  async = (FwSmAsyncDesc_t)malloc(sizeof(struct FwSmAsync));
+  if (async == NULL) {
+    return NULL;
+  }
+  async->jobs  = (SmAsyncJob_t*)malloc(nOfJobs * sizeof(SmAsyncJob_t));
+  async->slots = malloc(nOfSlots * sizeof(FwRtPayloadSlot_t));
+  if ((async->jobs == NULL) || (async->slots == NULL) || (pthread_mutex_init(&(async->mutex), NULL) != 0)) {
+    free(async->jobs);
+    free(async->slots);
+    free(async);
+    return NULL;
+  }
+
+  for (i = 0; i < nOfJobs; i++) {
+    async->jobs[i].next = ((i + 1) < nOfJobs) ? &(async->jobs[i + 1]) : NULL;
+  }
+  async->rtDesc     = rtDesc;
+  async->freeJobs   = async->jobs;
+  async->doneHead   = NULL;
+  async->doneTail   = NULL;
+  async->nOfPending = 0;
+
+  FwRtSetData(rtDesc, async);
+  FwRtSetExecFuncBehaviour(rtDesc, &AsyncExec);
+  FwRtSetPayloadRing(rtDesc, (FwRtPayloadSlot_t*)async->slots, nOfSlots, 1);
+  return async;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+FwSmErrCode_t FwSmAsyncRun(FwSmAsyncDesc_t async, FwSmDesc_t smDesc, FwSmAction_t operation,
+                           FwSmCounterU2_t transId) {
+  return AsyncRun(async, smDesc, NULL, operation, transId);
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+FwSmErrCode_t FwSmAsyncRunQueued(FwSmAsyncDesc_t async, FwSmQueueDesc_t queue, FwSmAction_t operation,
+                                 FwSmCounterU2_t transId) {
+  return AsyncRun(async, queue->smDesc, queue, operation, transId);
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+FwSmCounterU4_t FwSmAsyncDispatch(FwSmAsyncDesc_t async, FwSmCounterU4_t maxEvents) {
+  FwSmCounterU4_t nOfEvents = 0;
+  SmAsyncJob_t*   job;
+  FwSmDesc_t      smDesc;
+  FwSmCounterU2_t transId;
+
+  while (nOfEvents < maxEvents) {
+    (void)pthread_mutex_lock(&(async->mutex));
+    job = async->doneHead;
+    if (job != NULL) {
+      async->doneHead = job->next;
+      if (async->doneHead == NULL) {
+        async->doneTail = NULL;
+      }
+    }
+    (void)pthread_mutex_unlock(&(async->mutex));
+    if (job == NULL) {
+      break;
+    }
+
+    /* The job is freed first so that the actions triggered by its completion can re-use it */
+    smDesc  = job->smDesc;
+    transId = job->transId;
+    AsyncFreeJob(async, job);
+    FwSmMakeTrans(smDesc, transId);
+    nOfEvents++;
+  }
+
+  return nOfEvents;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+FwSmCounterU4_t FwSmAsyncGetNOfPending(FwSmAsyncDesc_t async) {
+  FwSmCounterU4_t nOfPending;
+
+  (void)pthread_mutex_lock(&(async->mutex));
+  nOfPending = async->nOfPending;
+  (void)pthread_mutex_unlock(&(async->mutex));
+  return nOfPending;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+void FwSmAsyncRelease(FwSmAsyncDesc_t async) {
+  (void)pthread_mutex_destroy(&(async->mutex));
+  free(async->jobs);
+  free(async->slots);
+  free(async);
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+static FwSmErrCode_t AsyncRun(FwSmAsyncDesc_t async, FwSmDesc_t smDesc, FwSmQueueDesc_t queue,
+                              FwSmAction_t operation, FwSmCounterU2_t transId) {
+  SmAsyncJob_t* job;
+
+  (void)pthread_mutex_lock(&(async->mutex));
+  job = async->freeJobs;
+  if (job != NULL) {
+    async->freeJobs = job->next;
+    async->nOfPending++;
+  }
+  (void)pthread_mutex_unlock(&(async->mutex));
+  if (job == NULL) {
+    smDesc->errCode = smAsyncFull;
+    return smAsyncFull;
+  }
+
+  job->smDesc  = smDesc;
+  job->queue   = queue;
+  job->action  = operation;
+  job->transId = transId;
+  job->next    = NULL;
+  (void)FwRtNotifyWithPayload(async->rtDesc, job);
+  return smSuccess;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+static FwRtOutcome_t AsyncExec(FwRtDesc_t rtDesc) {
+  FwSmAsyncDesc_t async = (FwSmAsyncDesc_t)FwRtGetData(rtDesc);
+  SmAsyncJob_t*   job;
+
+  while ((job = (SmAsyncJob_t*)FwRtTakePayload(rtDesc)) != NULL) {
+    job->action(job->smDesc);
+
+    if ((job->queue != NULL) && (FwSmQueuePost(job->queue, job->transId) == smSuccess)) {
+      AsyncFreeJob(async, job);
+      continue;
+    }
+
+    (void)pthread_mutex_lock(&(async->mutex));
+    if (async->doneTail == NULL) {
+      async->doneHead = job;
+    } else {
+      async->doneTail->next = job;
+    }
+    async->doneTail = job;
+    (void)pthread_mutex_unlock(&(async->mutex));
+  }
+
+  return 0;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+static void AsyncFreeJob(FwSmAsyncDesc_t async, SmAsyncJob_t* job) {
+  (void)pthread_mutex_lock(&(async->mutex));
+  job->next       = async->freeJobs;
+  async->freeJobs = job;
+  async->nOfPending--;
+  (void)pthread_mutex_unlock(&(async->mutex));
+}
@@ -0,0 +1,168 @@
+/**
+ * @file
+ * @ingroup smGroup
+ * Declaration of the action offload interface for a FW State Machine.
+ * The actions of a state machine are normally executed synchronously by
+ * <code>::FwSmMakeTrans</code> and by <code>::FwSmExecute</code> and an action which
+ * performs a slow operation (e.g. a write to a flash memory or a bus transaction)
+ * therefore blocks the thread which owns the state machine.
+ * An offload descriptor allows such an operation to be executed instead on a RT
+ * Container (see <code>FwRtCore.h</code>): an action of the state machine
+ * <i>offloads</i> the operation to the container and returns immediately and, when
+ * the container has executed the operation, a <i>completion trigger</i> is sent
+ * back to the state machine.
+ * Waiting for the completion of an operation then simply consists in staying in a
+ * state which has an out-going transition on the completion trigger.
+ *
+ * The basic mode of use of the functions declared in this file is as follows:
+ * -# The RT Container is reset with <code>::FwRtReset</code> and, optionally,
+ *    configured (e.g. to run on a RT Pool or with real-time thread attributes).
+ * -# The offload descriptor is created for the RT Container with function
+ *    <code>::FwSmAsyncCreate</code>.
+ * -# The RT Container is initialized with <code>::FwRtInit</code> and started with
+ *    <code>::FwRtStart</code>.
+ * -# The actions of the state machines offload operations with function
+ *    <code>::FwSmAsyncRun</code> or <code>::FwSmAsyncRunQueued</code>.
+ * -# The thread which owns the state machines periodically dispatches the completion
+ *    triggers with function <code>::FwSmAsyncDispatch</code> (or with
+ *    <code>::FwSmQueueDispatch</code> for the operations offloaded with
+ *    <code>::FwSmAsyncRunQueued</code>).
+ * -# The RT Container is stopped and shut down and the offload descriptor is released
+ *    with function <code>::FwSmAsyncRelease</code>.
+ * .
+ * An operation is a function with the same signature as a state machine action which
+ * is called on the Activation Thread of the RT Container with the state machine as its
+ * argument.
+ * It runs concurrently with the thread which owns the state machine: it may read the
+ * state machine data but it must not call any function other than
+ * <code>::FwSmGetData</code> on the state machine and it must only modify the data
+ * which are reserved to it.
+ * The operations are executed one at a time in the order in which they were offloaded.
+ *
+ * The completion trigger of an operation offloaded with <code>::FwSmAsyncRun</code>
+ * is held by the offload descriptor until it is dispatched with
+ * <code>::FwSmAsyncDispatch</code>.
+ * The completion trigger of an operation offloaded with <code>::FwSmAsyncRunQueued</code>
+ * is posted to a state machine event queue (see <code>FwSmQueue.h</code>) and it is
+ * dispatched together with the other transition commands of the queue.
+ * If the queue is full, the completion trigger is held by the offload descriptor as if
+ * the operation had been offloaded with <code>::FwSmAsyncRun</code>.
+ * In both cases, the completion trigger is processed by <code>::FwSmMakeTrans</code> on
+ * the thread which owns the state machine: it has no effect if the state machine has
+ * left the state in which it waited for the completion of the operation.
+ *
+ * An offload descriptor holds a fixed number of <i>jobs</i>.
+ * A job is used from the time an operation is offloaded until its completion trigger
+ * has been dispatched (or posted to its queue).
+ * If all jobs are in use, the operation is not offloaded and the error code of the state
+ * machine is set to <code>#smAsyncFull</code>.
+ * The lists of free and of completed jobs are protected by a mutex which is only held
+ * while a job is taken from, or put in, one of them.
+ * The jobs are passed to the RT Container through its payload ring (see
+ * <code>::FwRtSetPayloadRing</code>).
+ *
+ * The memory for the offload descriptor is allocated dynamically through calls
+ * to <code>malloc</code> and released through calls to <code>free</code>.
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2011, All Rights Reserved
+ *
+ * This file is part of the FW Profile.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#ifndef FWSM_ASYNC_H_
+#define FWSM_ASYNC_H_
+
+#include "FwSmCore.h"
+#include "FwRtConstants.h"
+
+/**
+ * Create a new offload descriptor which executes operations on a RT Container.
+ * The RT Container must have been reset (see <code>::FwRtReset</code>) but not yet
+ * initialized.
+ * This function loads the container data, the Execute Functional Behaviour action and
+ * the payload ring of the container: these must not be modified by the application.
+ * The other container actions must return 1 (as their default implementations do).
+ * @param rtDesc the RT Container which executes the operations.
+ * @param nOfJobs the number of jobs of the descriptor (a positive integer).
+ * @return the descriptor of the new offload descriptor (or NULL if the creation of the
+ * data structures to hold the descriptor failed, if the number of jobs is zero, or if
+ * the RT Container has already been initialized).
+ */
+FwSmAsyncDesc_t FwSmAsyncCreate(FwRtDesc_t rtDesc, FwSmCounterU4_t nOfJobs);
+
+/**
+ * Offload an operation of a state machine to the RT Container of an offload descriptor.
+ * This function is intended to be called by the actions of the state machine.
+ * The completion trigger is held by the offload descriptor until it is dispatched with
+ * <code>::FwSmAsyncDispatch</code>.
+ * If all the jobs of the descriptor are in use, the operation is not offloaded and the
+ * error code of the state machine is set to <code>#smAsyncFull</code>.
+ * @param async the offload descriptor.
+ * @param smDesc the state machine.
+ * @param operation the operation.
+ * @param transId the completion trigger.
+ * @return <code>#smSuccess</code> if the operation was offloaded or
+ * <code>#smAsyncFull</code> otherwise.
+ */
+FwSmErrCode_t FwSmAsyncRun(FwSmAsyncDesc_t async, FwSmDesc_t smDesc, FwSmAction_t operation,
+                           FwSmCounterU2_t transId);
+
+/**
+ * Offload an operation of a state machine to the RT Container of an offload descriptor
+ * and post its completion trigger to an event queue.
+ * This function is the same as <code>::FwSmAsyncRun</code> except that the completion
+ * trigger is posted to the event queue of the state machine when the operation has been
+ * executed.
+ * @param async the offload descriptor.
+ * @param queue the event queue of the state machine (the state machine is the one to
+ * which the queue dispatches its transition commands).
+ * @param operation the operation.
+ * @param transId the completion trigger.
+ * @return <code>#smSuccess</code> if the operation was offloaded or
+ * <code>#smAsyncFull</code> otherwise.
+ */
+FwSmErrCode_t FwSmAsyncRunQueued(FwSmAsyncDesc_t async, FwSmQueueDesc_t queue, FwSmAction_t operation,
+                                 FwSmCounterU2_t transId);
+
+/**
+ * Dispatch the completion triggers of the completed operations of an offload descriptor.
+ * The completion triggers are sent with <code>::FwSmMakeTrans</code> to their state
+ * machines in the order in which the operations were completed.
+ * At most <code>maxEvents</code> completion triggers are dispatched.
+ * The job of an operation is freed before its completion trigger is sent and it can
+ * therefore be used by the actions which are executed in response to the trigger.
+ * This function must be called by the thread which owns the state machines and it must
+ * not be called by more than one thread at a time.
+ * @param async the offload descriptor.
+ * @param maxEvents the maximum number of completion triggers to dispatch.
+ * @return the number of completion triggers which were dispatched.
+ */
+FwSmCounterU4_t FwSmAsyncDispatch(FwSmAsyncDesc_t async, FwSmCounterU4_t maxEvents);
+
+/**
+ * Return the number of jobs of an offload descriptor which are in use.
+ * A job is in use from the time its operation is offloaded until its completion trigger
+ * has been dispatched (or posted to its queue).
+ * @param async the offload descriptor.
+ * @return the number of jobs which are in use.
+ */
+FwSmCounterU4_t FwSmAsyncGetNOfPending(FwSmAsyncDesc_t async);
+
+/**
+ * Release the memory allocated to an offload descriptor.
+ * The RT Container of the descriptor must have been stopped and its Activation Thread
+ * must have terminated (see <code>::FwRtWaitForTermination</code>).
+ * The completion triggers which have not yet been dispatched are discarded.
+ * The RT Container itself is not released.
+ * @param async the offload descriptor.
+ */
+void FwSmAsyncRelease(FwSmAsyncDesc_t async);
+
+#endif /* FWSM_ASYNC_H_ */
@@ -17,7 +17,133 @@
 
 #include "FwSmAux.h"
 #include "FwSmConfig.h"
+#include "FwSmCost.h"
 #include "FwSmPrivate.h"
+#include <stdlib.h>
+
+/**
+ * Print the destination of a transition to an output stream.
+ * @param stream the output stream
+ * @param dest the destination of the transition (see <code>::SmTrans_t</code>)
+ */
+static void SmPrintDest(FILE* stream, FwSmCounterS1_t dest);
+
+/**
+ * Print the worst-case step costs of a state machine to an output stream (see
+ * <code>FwSmCost.h</code>).
+ * @param stream the output stream
+ * @param smDesc the descriptor of the state machine
+ */
+static void SmPrintCosts(FILE* stream, FwSmDesc_t smDesc);
+
+/**
+ * Print a worst-case step cost to an output stream.
+ * @param stream the output stream
+ * @param label the label of the step
+ * @param cost the worst-case cost of the step
+ */
+static void SmPrintCost(FILE* stream, const char* label, const FwSmCost_t* cost);
+
+/**
+ * Print the profiling data of a transition to an output stream.
+ * @param stream the output stream
+ * @param smDesc the descriptor of the state machine
+ * @param iTrans the location of the transition in the transition array
+ * @param isFromCps true if the transition is a transition out of a choice pseudo-state
+ */
+static void SmPrintTransProfile(FILE* stream, FwSmDesc_t smDesc, FwSmCounterS1_t iTrans, FwSmBool_t isFromCps);
+
+/**
+ * Print the hot spots in the evaluation order of the transitions out of a state or
+ * choice pseudo-state to an output stream.
+ * A transition is a hot spot if it has been fired more often than a transition which
+ * precedes it in the evaluation order or if its guard has returned false more often
+ * than true.
+ * @param stream the output stream
+ * @param smDesc the descriptor of the state machine
+ * @param srcName the name of the source of the transitions ("State" or "Choice Pseudo-State")
+ * @param srcId the identifier of the source of the transitions
+ * @param baseLoc the location of the first transition out of the source
+ * @param nOfOutTrans the number of transitions out of the source
+ * @param sameTrigger true if only transitions with the same trigger are evaluated in sequence
+ * @return the number of hot spots which have been printed
+ */
+static int SmPrintOrderHotSpots(FILE* stream, FwSmDesc_t smDesc, const char* srcName, FwSmCounterS1_t srcId,
+                                FwSmCounterS1_t baseLoc, FwSmCounterS1_t nOfOutTrans, FwSmBool_t sameTrigger);
+
+/**
+ * Return the name under which an action or a guard is called by the generated code
+ * of a state machine (see <code>::FwSmGenerateCode</code>).
+ * Only one of the action and guard arguments is not NULL.
+ * @param action the action (or NULL if the name of a guard is requested)
+ * @param guard the guard (or NULL if the name of an action is requested)
+ * @param names the names of the actions and guards
+ * @param nOfNames the number of elements in <code>names</code>
+ * @return the name of the action or guard (or NULL if it has no name)
+ */
+static const char* SmGenGetName(FwSmAction_t action, FwSmGuard_t guard, const FwSmFuncName_t* names,
+                                FwSmCounterU4_t nOfNames);
+
+/**
+ * Write the call to an action of a state machine to the generated code of the state machine.
+ * Nothing is written if the action is the dummy action.
+ * @param stream the output stream
+ * @param smDesc the descriptor of the state machine
+ * @param iAction the location of the action in the action array
+ * @param names the names of the actions and guards
+ * @param nOfNames the number of elements in <code>names</code>
+ * @param indent the indentation of the call
+ */
+static void SmGenAction(FILE* stream, FwSmDesc_t smDesc, FwSmCounterS1_t iAction, const FwSmFuncName_t* names,
+                        FwSmCounterU4_t nOfNames, const char* indent);
+
+/**
+ * Write the call to a guard of a state machine to the generated code of the state machine.
+ * The guard should not be the dummy guard.
+ * @param stream the output stream
+ * @param smDesc the descriptor of the state machine
+ * @param iGuard the location of the guard in the guard array
+ * @param names the names of the actions and guards
+ * @param nOfNames the number of elements in <code>names</code>
+ */
+static void SmGenGuard(FILE* stream, FwSmDesc_t smDesc, FwSmCounterS1_t iGuard, const FwSmFuncName_t* names,
+                       FwSmCounterU4_t nOfNames);
+
+/**
+ * Write the code which enters the destination of a transition to the generated code of
+ * a state machine.
+ * If the destination is a state, the code sets the current state, resets the state
+ * execution counter, executes the entry action and starts the embedded state machine
+ * (if any).
+ * If the destination is the final pseudo-state, the code stops the state machine.
+ * If the destination is a choice pseudo-state (which is only possible for a transition
+ * out of a choice pseudo-state), the code sets the error code to #smTransErr.
+ * @param stream the output stream
+ * @param smDesc the descriptor of the state machine
+ * @param dest the destination of the transition (see <code>::SmTrans_t</code>)
+ * @param names the names of the actions and guards
+ * @param nOfNames the number of elements in <code>names</code>
+ * @param indent the indentation of the code
+ */
+static void SmGenDest(FILE* stream, FwSmDesc_t smDesc, FwSmCounterS1_t dest, const FwSmFuncName_t* names,
+                      FwSmCounterU4_t nOfNames, const char* indent);
+
+/**
+ * Write the function which executes a transition out of a state or out of the initial
+ * pseudo-state to the generated code of a state machine.
+ * The function executes the transition action and enters the destination of the
+ * transition.
+ * If the destination is a choice pseudo-state, the transitions out of the choice
+ * pseudo-state are checked in the order in which they were added to the state machine.
+ * @param stream the output stream
+ * @param smDesc the descriptor of the state machine
+ * @param prefix the prefix of the names of the generated functions
+ * @param iTrans the location of the transition in the transition array
+ * @param names the names of the actions and guards
+ * @param nOfNames the number of elements in <code>names</code>
+ */
+static void SmGenTrans(FILE* stream, FwSmDesc_t smDesc, const char* prefix, FwSmCounterS1_t iTrans,
+                       const FwSmFuncName_t* names, FwSmCounterU4_t nOfNames);
 
 /* ------------------------------------------------------------------------------- */
 void FwSmPrintConfig(FwSmDesc_t smDesc, FILE* stream) {
@@ -257,6 +383,8 @@ void FwSmPrintConfig(FwSmDesc_t smDesc, FILE* stream) {
       }
     }
   }
+
+  SmPrintCosts(stream, smDesc);
 }
 
 /* ------------------------------------------------------------------------------- */
@@ -335,7 +463,640 @@ char* FwSmPrintErrCode(FwSmErrCode_t errCode) {
     return (char*)"smWrongNOfActions";
   case smWrongNOfGuards:
     return (char*)"smWrongNOfGuards";
+  case smQueueFull:
+    return (char*)"smQueueFull";
+  case smAsyncFull:
+    return (char*)"smAsyncFull";
   default:
     return (char*)"invalid error code";
   }
 }
+
+/* ------------------------------------------------------------------------------- */
+void FwSmEnableProfile(FwSmDesc_t smDesc, FwSmProfileClock_t clock) {
+  SmProfile_t*     profile    = smDesc->profile;
+  FwSmCounterU4_t  nOfPStates = (FwSmCounterU4_t)(smDesc->smBase->nOfPStates);
+  FwSmCounterU4_t  nOfTrans   = (FwSmCounterU4_t)(smDesc->smBase->nOfTrans);
+  FwSmCounterU4_t* counters;
+
+  if (profile == NULL) {
+    /* The profiling arrays are located in the same block of memory as the profiling structure */
+    profile = (SmProfile_t*)malloc(sizeof(SmProfile_t) + (2 * nOfPStates + 3 * nOfTrans) * sizeof(FwSmCounterU4_t));
+    if (profile == NULL) {
+      smDesc->errCode = smOutOfMemory;
+      return;
+    }
+    counters               = (FwSmCounterU4_t*)(void*)(profile + 1);
+    profile->stateEntryCnt = counters;
+    profile->stateDwell    = counters + nOfPStates;
+    profile->transFireCnt  = counters + 2 * nOfPStates;
+    profile->guardTrueCnt  = profile->transFireCnt + nOfTrans;
+    profile->guardFalseCnt = profile->guardTrueCnt + nOfTrans;
+    smDesc->profile        = profile;
+  }
+
+  profile->clock = clock;
+  FwSmResetProfile(smDesc);
+}
+
+/* ------------------------------------------------------------------------------- */
+void FwSmDisableProfile(FwSmDesc_t smDesc) {
+  free(smDesc->profile);
+  smDesc->profile = NULL;
+}
+
+/* ------------------------------------------------------------------------------- */
+void FwSmResetProfile(FwSmDesc_t smDesc) {
+  SmProfile_t*    profile = smDesc->profile;
+  FwSmCounterS1_t i;
+
+  if (profile == NULL) {
+    return;
+  }
+
+  for (i = 0; i < smDesc->smBase->nOfPStates; i++) {
+    profile->stateEntryCnt[i] = 0;
+    profile->stateDwell[i]    = 0;
+  }
+  for (i = 0; i < smDesc->smBase->nOfTrans; i++) {
+    profile->transFireCnt[i]  = 0;
+    profile->guardTrueCnt[i]  = 0;
+    profile->guardFalseCnt[i] = 0;
+  }
+
+  /* If the state machine is already in a state, its time in the state is measured from now */
+  profile->entryTime = (profile->clock != NULL) ? profile->clock() : 0;
+}
+
+/* ------------------------------------------------------------------------------- */
+void FwSmPrintProfile(FwSmDesc_t smDesc, FILE* stream) {
+  SmBaseDesc_t*   smBase;
+  SmProfile_t*    profile;
+  FwSmCounterS1_t i, j, baseLoc;
+  FwSmCounterS1_t hotState = 0;
+  FwSmCounterS1_t hotTrans = 0;
+  FwSmCounterU4_t hotValue = 0;
+  FwSmCounterU4_t totDwell = 0;
+  FwSmCounterU4_t value;
+  int             nOfHotSpots = 0;
+
+  if (smDesc == NULL) {
+    fprintf(stream, "The argument state machine descriptor is NULL\n");
+    return;
+  }
+  if (smDesc->profile == NULL) {
+    fprintf(stream, "Profiling is not enabled on the argument state machine\n");
+    return;
+  }
+  smBase  = smDesc->smBase;
+  profile = smDesc->profile;
+
+  for (i = 0; i < smBase->nOfPStates; i++) {
+    totDwell += profile->stateDwell[i];
+  }
+
+  fprintf(stream, "\n");
+  fprintf(stream, "STATE MACHINE PROFILE\n");
+  fprintf(stream, "---------------------\n");
+  fprintf(stream, "The SM Execution Counter is              : %u\n", smDesc->smExecCnt);
+  if (profile->clock == NULL) {
+    fprintf(stream, "The time spent in the states is          : not measured\n");
+  }
+  else {
+    fprintf(stream, "The time spent in the states is          : %lu\n", totDwell);
+  }
+  fprintf(stream, "Transition from the initial pseudo-state : fired %lu times\n", profile->transFireCnt[0]);
+  fprintf(stream, "\n");
+
+  if (smBase->nOfPStates > 0) {
+    fprintf(stream, "PROFILE OF STATES\n");
+    fprintf(stream, "-----------------\n");
+  }
+  for (i = 0; i < smBase->nOfPStates; i++) {
+    if (smBase->pStates[i].outTransIndex == 0) {
+      continue;
+    }
+    if (profile->clock == NULL) {
+      fprintf(stream, "State %d: entered %lu times\n", i + 1, profile->stateEntryCnt[i]);
+    }
+    else {
+      fprintf(stream, "State %d: entered %lu times, time spent %lu (%.1f%%)\n", i + 1, profile->stateEntryCnt[i],
+              profile->stateDwell[i],
+              (totDwell > 0) ? (100.0 * (double)profile->stateDwell[i]) / (double)totDwell : 0.0);
+    }
+    value = (profile->clock == NULL) ? profile->stateEntryCnt[i] : profile->stateDwell[i];
+    if ((hotState == 0) || (value > hotValue)) {
+      hotState = (FwSmCounterS1_t)(i + 1);
+      hotValue = value;
+    }
+    baseLoc = smBase->pStates[i].outTransIndex;
+    for (j = baseLoc; j < (baseLoc + smBase->pStates[i].nOfOutTrans); j++) {
+      SmPrintTransProfile(stream, smDesc, j, 0);
+    }
+  }
+  fprintf(stream, "\n");
+
+  if (smBase->nOfCStates > 0) {
+    fprintf(stream, "PROFILE OF CHOICE PSEUDO-STATES\n");
+    fprintf(stream, "-------------------------------\n");
+  }
+  for (i = 0; i < smBase->nOfCStates; i++) {
+    if (smBase->cStates[i].outTransIndex == 0) {
+      continue;
+    }
+    fprintf(stream, "Choice Pseudo-State %d:\n", i + 1);
+    baseLoc = smBase->cStates[i].outTransIndex;
+    for (j = baseLoc; j < (baseLoc + smBase->cStates[i].nOfOutTrans); j++) {
+      SmPrintTransProfile(stream, smDesc, j, 1);
+    }
+  }
+  if (smBase->nOfCStates > 0) {
+    fprintf(stream, "\n");
+  }
+
+  for (i = 1; i < smBase->nOfTrans; i++) {
+    if ((smBase->trans[i].iTrAction != -1) && (profile->transFireCnt[i] > profile->transFireCnt[hotTrans])) {
+      hotTrans = i;
+    }
+  }
+
+  fprintf(stream, "HOT SPOTS\n");
+  fprintf(stream, "---------\n");
+  if (hotState != 0) {
+    fprintf(stream, "The hottest state is state %d\n", hotState);
+  }
+  fprintf(stream, "The most frequently fired transition is the transition in location %d (to ", hotTrans);
+  SmPrintDest(stream, smBase->trans[hotTrans].dest);
+  fprintf(stream, ")\n");
+  for (i = 0; i < smBase->nOfPStates; i++) {
+    if (smBase->pStates[i].outTransIndex != 0) {
+      nOfHotSpots += SmPrintOrderHotSpots(stream, smDesc, "State", (FwSmCounterS1_t)(i + 1),
+                                          smBase->pStates[i].outTransIndex, smBase->pStates[i].nOfOutTrans, 1);
+    }
+  }
+  for (i = 0; i < smBase->nOfCStates; i++) {
+    if (smBase->cStates[i].outTransIndex != 0) {
+      nOfHotSpots += SmPrintOrderHotSpots(stream, smDesc, "Choice Pseudo-State", (FwSmCounterS1_t)(i + 1),
+                                          smBase->cStates[i].outTransIndex, smBase->cStates[i].nOfOutTrans, 0);
+    }
+  }
+  if (nOfHotSpots == 0) {
+    fprintf(stream, "No transitions or guards need to be reordered\n");
+  }
+}
+
+/* ------------------------------------------------------------------------------- */
+static void SmPrintCosts(FILE* stream, FwSmDesc_t smDesc) {
+  SmBaseDesc_t*   smBase = smDesc->smBase;
+  FwSmCost_t      cost;
+  FwSmCounterS1_t i, j, k;
+  FwSmCounterU2_t transId;
+  char            label[32];
+
+  fprintf(stream, "\n");
+  fprintf(stream, "WORST-CASE STEP COSTS\n");
+  fprintf(stream, "---------------------\n");
+  if (FwSmCostStart(smDesc, NULL, 0, &cost) != smSuccess) {
+    fprintf(stream, "The step costs are only computed if the configuration check is passed\n");
+    return;
+  }
+  SmPrintCost(stream, "Start", &cost);
+  (void)FwSmCostStop(smDesc, NULL, 0, &cost);
+  SmPrintCost(stream, "Stop", &cost);
+
+  for (i = 0; i < smBase->nOfPStates; i++) {
+    fprintf(stream, "State %d:\n", i + 1);
+    (void)FwSmCostMakeTrans(smDesc, (FwSmCounterS1_t)(i + 1), FW_TR_EXECUTE, NULL, 0, &cost);
+    SmPrintCost(stream, "\t'Execute' command", &cost);
+    for (j = 0; j < smBase->pStates[i].nOfOutTrans; j++) {
+      transId = smBase->trans[smBase->pStates[i].outTransIndex + j].id;
+      for (k = 0; k < j; k++) { /* each transition command is only printed once */
+        if (smBase->trans[smBase->pStates[i].outTransIndex + k].id == transId) {
+          break;
+        }
+      }
+      if ((transId != FW_TR_EXECUTE) && (k == j)) {
+        (void)FwSmCostMakeTrans(smDesc, (FwSmCounterS1_t)(i + 1), transId, NULL, 0, &cost);
+        sprintf(label, "\tTransition command %u", (unsigned int)transId);
+        SmPrintCost(stream, label, &cost);
+      }
+    }
+  }
+}
+
+/* ------------------------------------------------------------------------------- */
+static void SmPrintCost(FILE* stream, const char* label, const FwSmCost_t* cost) {
+  fprintf(stream, "%s: %lu actions, %lu guards, %lu levels, cost %lu\n", label, cost->nOfActions, cost->nOfGuards,
+          cost->nOfLevels, cost->cost);
+}
+
+/* ------------------------------------------------------------------------------- */
+static void SmPrintDest(FILE* stream, FwSmCounterS1_t dest) {
+  if (dest > 0) {
+    fprintf(stream, "state %d", dest);
+  }
+  else if (dest < 0) {
+    fprintf(stream, "choice pseudo-state %d", -dest);
+  }
+  else {
+    fprintf(stream, "final pseudo-state");
+  }
+}
+
+/* ------------------------------------------------------------------------------- */
+static void SmPrintTransProfile(FILE* stream, FwSmDesc_t smDesc, FwSmCounterS1_t iTrans, FwSmBool_t isFromCps) {
+  SmTrans_t*   trans   = &(smDesc->smBase->trans[iTrans]);
+  SmProfile_t* profile = smDesc->profile;
+
+  if (isFromCps != 0) {
+    fprintf(stream, "\tTransition to ");
+  }
+  else if (trans->id == FW_TR_EXECUTE) {
+    fprintf(stream, "\t'Execute' transition to ");
+  }
+  else {
+    fprintf(stream, "\tTransition %d to ", trans->id);
+  }
+  SmPrintDest(stream, trans->dest);
+  fprintf(stream, ": fired %lu times", profile->transFireCnt[iTrans]);
+  if (trans->iTrGuard != 0) {
+    fprintf(stream, ", guard true %lu times and false %lu times", profile->guardTrueCnt[iTrans],
+            profile->guardFalseCnt[iTrans]);
+  }
+  fprintf(stream, "\n");
+}
+
+/* ------------------------------------------------------------------------------- */
+static int SmPrintOrderHotSpots(FILE* stream, FwSmDesc_t smDesc, const char* srcName, FwSmCounterS1_t srcId,
+                                FwSmCounterS1_t baseLoc, FwSmCounterS1_t nOfOutTrans, FwSmBool_t sameTrigger) {
+  SmTrans_t*      trans   = smDesc->smBase->trans;
+  SmProfile_t*    profile = smDesc->profile;
+  FwSmCounterS1_t j, k;
+  int             nOfHotSpots = 0;
+
+  for (j = baseLoc; j < (baseLoc + nOfOutTrans); j++) {
+    /* Look for the first preceding transition which is fired less often */
+    for (k = baseLoc; k < j; k++) {
+      if (((sameTrigger == 0) || (trans[k].id == trans[j].id)) &&
+          (profile->transFireCnt[k] < profile->transFireCnt[j])) {
+        fprintf(stream, "%s %d: the transition to ", srcName, srcId);
+        SmPrintDest(stream, trans[j].dest);
+        fprintf(stream, " is fired more often (%lu times) than the preceding transition to ", profile->transFireCnt[j]);
+        SmPrintDest(stream, trans[k].dest);
+        fprintf(stream, " (%lu times)\n", profile->transFireCnt[k]);
+        nOfHotSpots++;
+        break;
+      }
+    }
+    if ((trans[j].iTrGuard != 0) && (profile->guardFalseCnt[j] > profile->guardTrueCnt[j])) {
+      fprintf(stream, "%s %d: the guard of the transition to ", srcName, srcId);
+      SmPrintDest(stream, trans[j].dest);
+      fprintf(stream, " is false more often (%lu times) than true (%lu times)\n", profile->guardFalseCnt[j],
+              profile->guardTrueCnt[j]);
+      nOfHotSpots++;
+    }
+  }
+  return nOfHotSpots;
+}
+
+/* ------------------------------------------------------------------------------- */
+FwSmCounterU4_t FwSmGenerateCode(FwSmDesc_t smDesc, const char* prefix, const FwSmFuncName_t* names,
+                                 FwSmCounterU4_t nOfNames, FILE* stream) {
+  SmBaseDesc_t*   smBase = smDesc->smBase;
+  SmPState_t*     pState;
+  SmTrans_t*      trans;
+  FwSmCounterS1_t i, j;
+  FwSmCounterU4_t k;
+  FwSmCounterU4_t nOfIndirect = 0;
+  FwSmBool_t      isGuarded;
+
+  fprintf(stream, "/*\n");
+  fprintf(stream, " * Code generated by FwSmGenerateCode.\n");
+  fprintf(stream, " * The functions with prefix %s are functionally equivalent to FwSmStart, FwSmStop,\n", prefix);
+  fprintf(stream, " * FwSmMakeTrans and FwSmExecute for a state machine with the following size:\n");
+  fprintf(stream, " * - number of states: %d\n", smBase->nOfPStates);
+  fprintf(stream, " * - number of choice pseudo-states: %d\n", smBase->nOfCStates);
+  fprintf(stream, " * - number of transitions: %d\n", smBase->nOfTrans);
+  fprintf(stream, " * .\n");
+  fprintf(stream, " */\n\n");
+  fprintf(stream, "#include \"FwSmCore.h\"\n");
+  fprintf(stream, "#include \"FwSmPrivate.h\"\n\n");
+
+  /* Declare the actions and guards which are called by name */
+  for (k = 0; k < nOfNames; k++) {
+    if (names[k].action != NULL) {
+      fprintf(stream, "void %s(FwSmDesc_t smDesc);\n", names[k].name);
+    }
+    else {
+      fprintf(stream, "FwSmBool_t %s(FwSmDesc_t smDesc);\n", names[k].name);
+    }
+  }
+  if (nOfNames > 0) {
+    fprintf(stream, "\n");
+  }
+
+  fprintf(stream, "void %sStart(FwSmDesc_t smDesc);\n", prefix);
+  fprintf(stream, "void %sStop(FwSmDesc_t smDesc);\n", prefix);
+  fprintf(stream, "void %sMakeTrans(FwSmDesc_t smDesc, FwSmCounterU2_t transId);\n", prefix);
+  fprintf(stream, "void %sExecute(FwSmDesc_t smDesc);\n", prefix);
+
+  /* One function for each transition out of the initial pseudo-state or out of a state */
+  SmGenTrans(stream, smDesc, prefix, 0, names, nOfNames);
+  for (i = 0; i < smBase->nOfPStates; i++) {
+    pState = &(smBase->pStates[i]);
+    for (j = 0; j < pState->nOfOutTrans; j++) {
+      SmGenTrans(stream, smDesc, prefix, (FwSmCounterS1_t)(pState->outTransIndex + j), names, nOfNames);
+    }
+  }
+
+  /* Start function */
+  fprintf(stream, "\n/* ------------------------------------------------------------------------------- */\n");
+  fprintf(stream, "void %sStart(FwSmDesc_t smDesc) {\n", prefix);
+  fprintf(stream, "  if (smDesc->curState != 0) {\n");
+  fprintf(stream, "    return;\n");
+  fprintf(stream, "  }\n");
+  fprintf(stream, "  smDesc->smExecCnt    = 0;\n");
+  fprintf(stream, "  smDesc->stateExecCnt = 0;\n");
+  fprintf(stream, "  %sTrans0(smDesc);\n", prefix);
+  fprintf(stream, "}\n");
+
+  /* Stop function: the embedded state machine is stopped before the exit action is executed */
+  fprintf(stream, "\n/* ------------------------------------------------------------------------------- */\n");
+  fprintf(stream, "void %sStop(FwSmDesc_t smDesc) {\n", prefix);
+  fprintf(stream, "  switch (smDesc->curState) {\n");
+  for (i = 0; i < smBase->nOfPStates; i++) {
+    fprintf(stream, "  case %d:\n", i + 1);
+    if (smDesc->esmDesc[i] != NULL) {
+      fprintf(stream, "    FwSmStop(smDesc->esmDesc[%d]);\n", i);
+    }
+    SmGenAction(stream, smDesc, smBase->pStates[i].iExitAction, names, nOfNames, "    ");
+    fprintf(stream, "    break;\n");
+  }
+  fprintf(stream, "  default:\n");
+  fprintf(stream, "    return;\n");
+  fprintf(stream, "  }\n");
+  fprintf(stream, "  smDesc->curState = 0;\n");
+  fprintf(stream, "}\n");
+
+  /* Transition function: the embedded state machine reacts to the trigger before its embedding state */
+  fprintf(stream, "\n/* ------------------------------------------------------------------------------- */\n");
+  fprintf(stream, "void %sMakeTrans(FwSmDesc_t smDesc, FwSmCounterU2_t transId) {\n", prefix);
+  if (smBase->nOfPStates == 0) {
+    fprintf(stream, "  (void)(transId);\n");
+  }
+  fprintf(stream, "  switch (smDesc->curState) {\n");
+  for (i = 0; i < smBase->nOfPStates; i++) {
+    pState = &(smBase->pStates[i]);
+    fprintf(stream, "  case %d:\n", i + 1);
+    fprintf(stream, "    if (transId == FW_TR_EXECUTE) {\n");
+    fprintf(stream, "      smDesc->smExecCnt++;\n");
+    fprintf(stream, "      smDesc->stateExecCnt++;\n");
+    SmGenAction(stream, smDesc, pState->iDoAction, names, nOfNames, "      ");
+    fprintf(stream, "    }\n");
+    if (smDesc->esmDesc[i] != NULL) {
+      fprintf(stream, "    FwSmMakeTrans(smDesc->esmDesc[%d], transId);\n", i);
+    }
+    for (j = 0; j < pState->nOfOutTrans; j++) {
+      trans = &(smBase->trans[pState->outTransIndex + j]);
+      isGuarded = (FwSmBool_t)(smDesc->smGuards[trans->iTrGuard] != &SmDummyGuard);
+      fprintf(stream, (isGuarded ? "    if ((transId == " : "    if (transId == "));
+      if (trans->id == FW_TR_EXECUTE) {
+        fprintf(stream, "FW_TR_EXECUTE");
+      }
+      else {
+        fprintf(stream, "%d", trans->id);
+      }
+      if (isGuarded) {
+        fprintf(stream, ") && (");
+        SmGenGuard(stream, smDesc, trans->iTrGuard, names, nOfNames);
+        fprintf(stream, ")");
+      }
+      fprintf(stream, ") {\n");
+      if (smDesc->esmDesc[i] != NULL) {
+        fprintf(stream, "      FwSmStop(smDesc->esmDesc[%d]);\n", i);
+      }
+      SmGenAction(stream, smDesc, pState->iExitAction, names, nOfNames, "      ");
+      fprintf(stream, "      %sTrans%d(smDesc);\n", prefix, pState->outTransIndex + j);
+      fprintf(stream, "      return;\n");
+      fprintf(stream, "    }\n");
+    }
+    fprintf(stream, "    break;\n");
+  }
+  fprintf(stream, "  default:\n");
+  fprintf(stream, "    break;\n");
+  fprintf(stream, "  }\n");
+  fprintf(stream, "}\n");
+
+  /* Execute function */
+  fprintf(stream, "\n/* ------------------------------------------------------------------------------- */\n");
+  fprintf(stream, "void %sExecute(FwSmDesc_t smDesc) {\n", prefix);
+  fprintf(stream, "  %sMakeTrans(smDesc, FW_TR_EXECUTE);\n", prefix);
+  fprintf(stream, "}\n");
+
+  /* Count the actions and guards which are called through the action and guard arrays */
+  for (i = 0; i < smDesc->nOfActions; i++) {
+    if ((smDesc->smActions[i] != &SmDummyAction) &&
+        (SmGenGetName(smDesc->smActions[i], NULL, names, nOfNames) == NULL)) {
+      nOfIndirect++;
+    }
+  }
+  for (i = 0; i < smDesc->nOfGuards; i++) {
+    if ((smDesc->smGuards[i] != &SmDummyGuard) && (SmGenGetName(NULL, smDesc->smGuards[i], names, nOfNames) == NULL)) {
+      nOfIndirect++;
+    }
+  }
+  return nOfIndirect;
+}
+
+/* ------------------------------------------------------------------------------- */
+FwSmErrCode_t FwSmGenerateConstBase(FwSmDesc_t smDesc, const char* name, FILE* stream) {
+  SmBaseDesc_t*   smBase = smDesc->smBase;
+  FwSmErrCode_t   outcome;
+  FwSmCounterS1_t i;
+  FwSmCounterU4_t j;
+
+  /* The dispatch table is part of the constant base descriptor: the state machine must be compiled */
+  outcome = FwSmCompile(smDesc);
+  if (outcome != smSuccess) {
+    return outcome;
+  }
+
+  fprintf(stream, "/*\n");
+  fprintf(stream, " * Code generated by FwSmGenerateConstBase.\n");
+  fprintf(stream, " * Constant base descriptor %s of a state machine with the following size:\n", name);
+  fprintf(stream, " * - number of states: %d\n", smBase->nOfPStates);
+  fprintf(stream, " * - number of choice pseudo-states: %d\n", smBase->nOfCStates);
+  fprintf(stream, " * - number of transitions: %d\n", smBase->nOfTrans);
+  fprintf(stream, " * - number of actions: %d\n", smDesc->nOfActions - 1);
+  fprintf(stream, " * - number of guards: %d\n", smDesc->nOfGuards - 1);
+  fprintf(stream, " * .\n");
+  fprintf(stream, " * The state machine is instantiated with FW_SM_INST_CONST(SM_DESC, %s, %d, %d, %d).\n", name,
+          smBase->nOfPStates, smDesc->nOfActions - 1, smDesc->nOfGuards - 1);
+  fprintf(stream, " */\n\n");
+  fprintf(stream, "#include \"FwSmPrivate.h\"\n\n");
+
+  if (smBase->nOfPStates > 0) {
+    fprintf(stream, "static const SmPState_t %s_pState[%d] = {\n", name, smBase->nOfPStates);
+    for (i = 0; i < smBase->nOfPStates; i++) {
+      fprintf(stream, "  {%d, %d, %d, %d, %d, %d, %u, %u}%s\n", smBase->pStates[i].outTransIndex,
+              smBase->pStates[i].nOfOutTrans, smBase->pStates[i].iEntryAction, smBase->pStates[i].iDoAction,
+              smBase->pStates[i].iExitAction, smBase->pStates[i].isExecInert,
+              (unsigned int)smBase->pStates[i].dispMinId, (unsigned int)smBase->pStates[i].dispNOfIds,
+              (i < smBase->nOfPStates - 1) ? "," : "");
+    }
+    fprintf(stream, "};\n\n");
+  }
+
+  if (smBase->nOfCStates > 0) {
+    fprintf(stream, "static const SmCState_t %s_cState[%d] = {\n", name, smBase->nOfCStates);
+    for (i = 0; i < smBase->nOfCStates; i++) {
+      fprintf(stream, "  {%d, %d}%s\n", smBase->cStates[i].outTransIndex, smBase->cStates[i].nOfOutTrans,
+              (i < smBase->nOfCStates - 1) ? "," : "");
+    }
+    fprintf(stream, "};\n\n");
+  }
+
+  fprintf(stream, "static const SmTrans_t %s_trans[%d] = {\n", name, smBase->nOfTrans);
+  for (i = 0; i < smBase->nOfTrans; i++) {
+    fprintf(stream, "  {%d, %u, %d, %d}%s\n", smBase->trans[i].dest, (unsigned int)smBase->trans[i].id,
+            smBase->trans[i].iTrAction, smBase->trans[i].iTrGuard, (i < smBase->nOfTrans - 1) ? "," : "");
+  }
+  fprintf(stream, "};\n\n");
+
+  fprintf(stream, "static const FwSmCounterS1_t %s_disp[%d] = {", name, SM_DISP_SIZE(smBase->nOfTrans));
+  for (j = 0; j < (FwSmCounterU4_t)SM_DISP_SIZE(smBase->nOfTrans); j++) {
+    fprintf(stream, "%s%d", (j > 0) ? ", " : "", smBase->transDisp[j]);
+  }
+  fprintf(stream, "};\n\n");
+
+  /* The arrays are constant: the casts only remove the qualifier required by the type of the fields */
+  fprintf(stream, "const SmBaseDesc_t %s = {\n", name);
+  if (smBase->nOfPStates > 0) {
+    fprintf(stream, "  (SmPState_t*)%s_pState,\n", name);
+  }
+  else {
+    fprintf(stream, "  NULL,\n");
+  }
+  if (smBase->nOfCStates > 0) {
+    fprintf(stream, "  (SmCState_t*)%s_cState,\n", name);
+  }
+  else {
+    fprintf(stream, "  NULL,\n");
+  }
+  fprintf(stream, "  (SmTrans_t*)%s_trans,\n", name);
+  fprintf(stream, "  %d,\n", smBase->nOfPStates);
+  fprintf(stream, "  %d,\n", smBase->nOfCStates);
+  fprintf(stream, "  %d,\n", smBase->nOfTrans);
+  fprintf(stream, "  (FwSmCounterS1_t*)%s_disp,\n", name);
+  fprintf(stream, "  1\n");
+  fprintf(stream, "};\n");
+
+  return smSuccess;
+}
+
+/* ------------------------------------------------------------------------------- */
+static const char* SmGenGetName(FwSmAction_t action, FwSmGuard_t guard, const FwSmFuncName_t* names,
+                                FwSmCounterU4_t nOfNames) {
+  FwSmCounterU4_t k;
+
+  for (k = 0; k < nOfNames; k++) {
+    if ((action != NULL) && (names[k].action == action)) {
+      return names[k].name;
+    }
+    if ((guard != NULL) && (names[k].guard == guard)) {
+      return names[k].name;
+    }
+  }
+  return NULL;
+}
+
+/* ------------------------------------------------------------------------------- */
+static void SmGenAction(FILE* stream, FwSmDesc_t smDesc, FwSmCounterS1_t iAction, const FwSmFuncName_t* names,
+                        FwSmCounterU4_t nOfNames, const char* indent) {
+  const char* name;
+
+  if (smDesc->smActions[iAction] == &SmDummyAction) {
+    return;
+  }
+  name = SmGenGetName(smDesc->smActions[iAction], NULL, names, nOfNames);
+  if (name != NULL) {
+    fprintf(stream, "%s%s(smDesc);\n", indent, name);
+  }
+  else {
+    fprintf(stream, "%ssmDesc->smActions[%d](smDesc);\n", indent, iAction);
+  }
+}
+
+/* ------------------------------------------------------------------------------- */
+static void SmGenGuard(FILE* stream, FwSmDesc_t smDesc, FwSmCounterS1_t iGuard, const FwSmFuncName_t* names,
+                       FwSmCounterU4_t nOfNames) {
+  const char* name;
+
+  name = SmGenGetName(NULL, smDesc->smGuards[iGuard], names, nOfNames);
+  if (name != NULL) {
+    fprintf(stream, "%s(smDesc)", name);
+  }
+  else {
+    fprintf(stream, "smDesc->smGuards[%d](smDesc)", iGuard);
+  }
+}
+
+/* ------------------------------------------------------------------------------- */
+static void SmGenDest(FILE* stream, FwSmDesc_t smDesc, FwSmCounterS1_t dest, const FwSmFuncName_t* names,
+                      FwSmCounterU4_t nOfNames, const char* indent) {
+  if (dest < 0) {
+    fprintf(stream, "%ssmDesc->errCode = smTransErr;\n", indent);
+    return;
+  }
+  if (dest == 0) {
+    fprintf(stream, "%ssmDesc->curState = 0;\n", indent);
+    return;
+  }
+  fprintf(stream, "%ssmDesc->curState     = %d;\n", indent, dest);
+  fprintf(stream, "%ssmDesc->stateExecCnt = 0;\n", indent);
+  SmGenAction(stream, smDesc, smDesc->smBase->pStates[dest - 1].iEntryAction, names, nOfNames, indent);
+  if (smDesc->esmDesc[dest - 1] != NULL) {
+    fprintf(stream, "%sFwSmStart(smDesc->esmDesc[%d]);\n", indent, dest - 1);
+  }
+}
+
+/* ------------------------------------------------------------------------------- */
+static void SmGenTrans(FILE* stream, FwSmDesc_t smDesc, const char* prefix, FwSmCounterS1_t iTrans,
+                       const FwSmFuncName_t* names, FwSmCounterU4_t nOfNames) {
+  SmBaseDesc_t*   smBase = smDesc->smBase;
+  SmTrans_t*      trans  = &(smBase->trans[iTrans]);
+  SmTrans_t*      cTrans;
+  SmCState_t*     cState;
+  FwSmCounterS1_t i;
+
+  fprintf(stream, "\n/* ------------------------------------------------------------------------------- */\n");
+  fprintf(stream, "static void %sTrans%d(FwSmDesc_t smDesc) {\n", prefix, iTrans);
+  SmGenAction(stream, smDesc, trans->iTrAction, names, nOfNames, "  ");
+  if (trans->dest >= 0) {
+    SmGenDest(stream, smDesc, trans->dest, names, nOfNames, "  ");
+    fprintf(stream, "}\n");
+    return;
+  }
+
+  /* The destination is a choice pseudo-state: its out-going transitions are checked in order */
+  cState = &(smBase->cStates[-(trans->dest) - 1]);
+  for (i = 0; i < cState->nOfOutTrans; i++) {
+    cTrans = &(smBase->trans[cState->outTransIndex + i]);
+    if (smDesc->smGuards[cTrans->iTrGuard] == &SmDummyGuard) {
+      /* A transition without guard is always taken: the following transitions are never checked */
+      SmGenAction(stream, smDesc, cTrans->iTrAction, names, nOfNames, "  ");
+      SmGenDest(stream, smDesc, cTrans->dest, names, nOfNames, "  ");
+      fprintf(stream, "}\n");
+      return;
+    }
+    fprintf(stream, "  if (");
+    SmGenGuard(stream, smDesc, cTrans->iTrGuard, names, nOfNames);
+    fprintf(stream, ") {\n");
+    SmGenAction(stream, smDesc, cTrans->iTrAction, names, nOfNames, "    ");
+    SmGenDest(stream, smDesc, cTrans->dest, names, nOfNames, "    ");
+    fprintf(stream, "    return;\n");
+    fprintf(stream, "  }\n");
+  }
+  fprintf(stream, "  smDesc->errCode = smTransErr;\n");
+  fprintf(stream, "}\n");
+}
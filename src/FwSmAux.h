@@ -48,6 +48,12 @@
  *   total number of guards declared for the state machine and the
  *   guard with identifier 'i' is the i-th guard to have been added
  *   to the state machine.
+ * .
+ * If the state machine and its embedded state machines pass their configuration
+ * check, the function also prints the worst-case costs of starting and stopping the
+ * state machine and of sending it, in each of its states, the "Execute" command and
+ * the transition commands to which the state responds (see <code>FwSmCost.h</code>).
+ * The costs are computed without cost annotations.
  *
  * This function assumes the argument output stream to be open and
  * to have enough space to receive the output generated by the function.
@@ -74,6 +80,176 @@ void FwSmPrintConfig(FwSmDesc_t smDesc, FILE* stream);
  */
 void FwSmPrintConfigRec(FwSmDesc_t smDesc, FILE* stream);
 
+/**
+ * Enable the profiling mode of a state machine.
+ * In profiling mode, the state machine keeps the following profiling data:
+ * - the number of entries into each state and the total time spent in each state;
+ * - the number of times each transition has been fired;
+ * - the number of times the guard of each transition has returned true and false.
+ * .
+ * The profiling data belong to the argument state machine and are not shared with
+ * the state machines which are derived from it or with its embedded state machines
+ * (profiling must be enabled separately on each of them).
+ *
+ * The times spent in the states are measured with the argument clock function.
+ * If the clock function is NULL, the times spent in the states are not measured.
+ * The time spent in a state is accumulated when the state is exited.
+ *
+ * The profiling data are allocated with <code>malloc</code>.
+ * If the allocation fails, the error code of the state machine is set to
+ * #smOutOfMemory and profiling remains disabled.
+ * If profiling is already enabled, the profiling data are reset and the clock
+ * function is replaced.
+ * The profiling data are released by <code>::FwSmDisableProfile</code> and by the
+ * functions which release a state machine created with the <code>DCreate</code>
+ * interface.
+ * State machines created with the <code>SCreate</code> interface must be released
+ * with <code>::FwSmDisableProfile</code>.
+ * @param smDesc the descriptor of the state machine
+ * @param clock the function providing the time stamps (or NULL)
+ */
+void FwSmEnableProfile(FwSmDesc_t smDesc, FwSmProfileClock_t clock);
+
+/**
+ * Disable the profiling mode of a state machine and release its profiling data.
+ * This function has no effect if profiling is not enabled.
+ * @param smDesc the descriptor of the state machine
+ */
+void FwSmDisableProfile(FwSmDesc_t smDesc);
+
+/**
+ * Reset the profiling data of a state machine.
+ * This function has no effect if profiling is not enabled.
+ * @param smDesc the descriptor of the state machine
+ */
+void FwSmResetProfile(FwSmDesc_t smDesc);
+
+/**
+ * Print the profiling data of a state machine to an output stream.
+ * The report lists, for each state and choice pseudo-state, the profiling data of
+ * the state and of its out-going transitions and it then lists the hot spots of the
+ * state machine.
+ * The hot spots are:
+ * - the state where the state machine spent most of its time (or which has been
+ *   entered most often if the times are not measured);
+ * - the transition which has been fired most often;
+ * - the transitions which have been fired more often than a transition which
+ *   precedes them in the evaluation order (i.e. a transition out of the same
+ *   choice pseudo-state or a transition out of the same state with the same
+ *   trigger): moving such a transition ahead saves guard evaluations;
+ * - the guards which have returned false more often than true.
+ * .
+ * This function assumes the argument output stream to be open and
+ * to have enough space to receive the output generated by the function.
+ * The function neither closes nor flushes the output stream.
+ * @param smDesc the descriptor of the state machine
+ * @param stream the output stream to which the profiling data are printed
+ */
+void FwSmPrintProfile(FwSmDesc_t smDesc, FILE* stream);
+
+/**
+ * Generate C code which implements the behaviour of a state machine without
+ * interpreting its tables.
+ * The generated code defines the following four functions (where
+ * <code>P</code> stands for the argument <code>prefix</code>):
+ * - <code>void PStart(FwSmDesc_t smDesc)</code>
+ * - <code>void PStop(FwSmDesc_t smDesc)</code>
+ * - <code>void PMakeTrans(FwSmDesc_t smDesc, FwSmCounterU2_t transId)</code>
+ * - <code>void PExecute(FwSmDesc_t smDesc)</code>
+ * .
+ * These functions are functionally equivalent to <code>::FwSmStart</code>,
+ * <code>::FwSmStop</code>, <code>::FwSmMakeTrans</code> and <code>::FwSmExecute</code>
+ * when they are called on the argument state machine.
+ * They take a state machine descriptor as an argument and they use it in the same way
+ * as the functions of <code>FwSmCore.h</code> (i.e. they update its current state,
+ * its execution counters and its error code and they pass it to the actions and
+ * guards).
+ * The other functions of the state machine module can therefore be used on this
+ * descriptor.
+ * The generated functions may be called on the argument state machine or on any
+ * state machine which has the same topology and the same actions and guards.
+ *
+ * The generated code consists of a <code>switch</code> on the current state of the
+ * state machine where, for each state, the transitions out of the state are
+ * checked in the order in which they were added to the state machine.
+ * Each action or guard which appears in the <code>names</code> array is called
+ * directly by name and the prototype of its function is declared at the start of
+ * the generated code (the functions must therefore have external linkage or be
+ * defined before the generated code is included in a translation unit).
+ * The other actions and guards are called through the action and guard arrays of the
+ * state machine descriptor.
+ * The generated code does not call the dummy action and the dummy guard which the
+ * state machine module uses for states and transitions without actions or guards.
+ *
+ * The generated code has the following limitations:
+ * - The state machines embedded in the argument state machine are started, stopped
+ *   and executed through the functions of <code>FwSmCore.h</code> (code can be
+ *   generated for each of them separately but the generated code of the embedding
+ *   state machine does not call it).
+ * - The profiling data of the state machine (see <code>::FwSmEnableProfile</code>)
+ *   are not updated and the tracing hooks (see <code>FwTrace.h</code>) are not
+ *   called.
+ * .
+ * The argument state machine should be fully and correctly configured (i.e. it should
+ * pass the configuration check implemented by <code>::FwSmCheck</code>).
+ * Compliance with this constraint is not checked by this function.
+ *
+ * The generated code only depends on the header files <code>FwSmCore.h</code> and
+ * <code>FwSmPrivate.h</code> and it complies with the ANSI C standard.
+ * This function assumes the argument output stream to be open and
+ * to have enough space to receive the output generated by the function.
+ * The function neither closes nor flushes the output stream.
+ * @param smDesc the descriptor of the state machine
+ * @param prefix the prefix of the names of the generated functions
+ * @param names the names of the actions and guards which are called by name (or NULL
+ * if all actions and guards are called through the action and guard arrays)
+ * @param nOfNames the number of elements in <code>names</code>
+ * @param stream the output stream to which the code is written
+ * @return the number of actions and guards of the state machine which do not appear
+ * in <code>names</code> and which are therefore called through the action and guard
+ * arrays
+ */
+FwSmCounterU4_t FwSmGenerateCode(FwSmDesc_t smDesc, const char* prefix, const FwSmFuncName_t* names,
+                                 FwSmCounterU4_t nOfNames, FILE* stream);
+
+/**
+ * Generate C code which defines a constant base descriptor for a state machine.
+ * The generated code defines a variable of type <code>const SmBaseDesc_t</code> with
+ * the argument name whose arrays of states, choice pseudo-states, transitions and
+ * whose transition dispatch table are constant arrays which are fully initialized
+ * with the content of the base descriptor of the argument state machine.
+ * Since neither the variable nor its arrays are modified at run-time, a compiler
+ * normally places them in a read-only section (e.g. <code>.rodata</code>) which,
+ * on targets with flash memory, does not use any RAM.
+ *
+ * State machines which use the constant base descriptor are instantiated with macro
+ * <code>#FW_SM_INST_CONST</code> and they are initialized with function
+ * <code>::FwSmInitConst</code> (the arguments of the macro are given in the comment at
+ * the start of the generated code).
+ * The actions and guards are not part of the constant base descriptor: they are
+ * referred to by their positions in the action and guard arrays of the argument state
+ * machine and they are bound to functions by <code>::FwSmInitConst</code>.
+ *
+ * The state machine is compiled with <code>::FwSmCompile</code> before the code is
+ * generated and no code is generated if this fails.
+ * State machines which use the constant base descriptor are therefore already
+ * compiled.
+ *
+ * The generated code only depends on the header file <code>FwSmPrivate.h</code> and
+ * it complies with the ANSI C standard.
+ * It must be compiled with the same index width (see <code>#FW_SM_INDEX_WIDTH</code>)
+ * as the application which generated it.
+ * This function assumes the argument output stream to be open and
+ * to have enough space to receive the output generated by the function.
+ * The function neither closes nor flushes the output stream.
+ * @param smDesc the descriptor of the state machine
+ * @param name the name of the generated constant base descriptor
+ * @param stream the output stream to which the code is written
+ * @return <code>#smSuccess</code> if the code was generated or the error code returned
+ * by <code>::FwSmCompile</code> otherwise
+ */
+FwSmErrCode_t FwSmGenerateConstBase(FwSmDesc_t smDesc, const char* name, FILE* stream);
+
 /**
  * Print the name of a state machine error code.
  * Error code are defined as instances of an enumerated type in
@@ -0,0 +1,355 @@
+/**
+ * @file
+ * @ingroup smGroup
+ * Implements the broadcast functions for the FW State Machine Module.
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2011, All Rights Reserved
+ *
+ * This file is part of the FW Profile.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#include "FwSmBcast.h"
+#include "FwSmPrivate.h"
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * Check whether none of the state machines in a hierarchy is in a broadcast registry.
+ * @param smDesc the state machine at the top of the hierarchy.
+ * @return 1 if none of the state machines is in a registry or 0 otherwise.
+ */
+static FwSmBool_t BcastIsFree(FwSmDesc_t smDesc);
+
+/**
+ * Set the link to a broadcast registry of all the state machines in a hierarchy.
+ * @param smDesc the state machine at the top of the hierarchy.
+ * @param link the link (or NULL if the hierarchy is removed from its registry).
+ */
+static void BcastSetLink(FwSmDesc_t smDesc, SmBcastLink_t* link);
+
+/**
+ * Return the position of a broadcast trigger in a broadcast registry.
+ * @param bcast the registry.
+ * @param transId the identifier of the transition command.
+ * @return the position of the broadcast trigger or the number of broadcast triggers
+ * if the transition command is not a broadcast trigger of the registry.
+ */
+static FwSmCounterU4_t BcastFindTrig(FwSmBcastDesc_t bcast, FwSmCounterU2_t transId);
+
+/**
+ * Bring up to date the subscriptions of the hierarchies of a broadcast registry which
+ * have changed since their subscriptions were last computed.
+ * The current states of each changed hierarchy are walked down from its top and the
+ * broadcast triggers to which their out-going transitions respond are collected.
+ * @param bcast the registry.
+ */
+static void BcastRefresh(FwSmBcastDesc_t bcast);
+
+/**
+ * Remove a hierarchy from a broadcast registry.
+ * The hierarchy is removed from the subscribers of each broadcast trigger and from the
+ * list of changed hierarchies and the last hierarchy of the registry is moved to its
+ * position (its subscriptions, its entry in the list of changed hierarchies and the
+ * links of its state machines are updated accordingly).
+ * @param bcast the registry.
+ * @param iSm the position of the hierarchy in the registry.
+ */
+static void BcastRemove(FwSmBcastDesc_t bcast, FwSmCounterU4_t iSm);
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+FwSmBcastDesc_t FwSmBcastCreate(const FwSmCounterU2_t* transIds, FwSmCounterU4_t nOfTransIds,
+                                FwSmCounterU4_t maxNOfSms) {
+  FwSmBcastDesc_t bcast;
+  FwSmCounterU4_t i;
+
+  if ((nOfTransIds == 0) || (maxNOfSms == 0)) {
+    return NULL;
+  }
+
+  bcast = (FwSmBcastDesc_t)malloc(sizeof(struct FwSmBcast));
+  if (bcast == NULL) {
+    return NULL;
+  }
+
+  bcast->transIds = (FwSmCounterU2_t*)malloc(nOfTransIds * sizeof(FwSmCounterU2_t));
+  bcast->react    = (FwSmCounterU1_t*)malloc(nOfTransIds * sizeof(FwSmCounterU1_t));
+  bcast->smDesc   = (FwSmDesc_t*)malloc(maxNOfSms * sizeof(FwSmDesc_t));
+  bcast->links    = (SmBcastLink_t*)malloc(maxNOfSms * sizeof(SmBcastLink_t));
+  bcast->subs     = (FwSmCounterU4_t*)malloc(nOfTransIds * maxNOfSms * sizeof(FwSmCounterU4_t));
+  bcast->iSub     = (FwSmCounterU4_t*)malloc(nOfTransIds * maxNOfSms * sizeof(FwSmCounterU4_t));
+  bcast->nOfSubs  = (FwSmCounterU4_t*)malloc(nOfTransIds * sizeof(FwSmCounterU4_t));
+  bcast->dirty    = (FwSmCounterU4_t*)malloc(maxNOfSms * sizeof(FwSmCounterU4_t));
+  bcast->nOfSms   = 0;
+  if ((bcast->transIds == NULL) || (bcast->react == NULL) || (bcast->smDesc == NULL) || (bcast->links == NULL) ||
+      (bcast->subs == NULL) || (bcast->iSub == NULL) || (bcast->nOfSubs == NULL) || (bcast->dirty == NULL)) {
+    FwSmBcastRelease(bcast);
+    return NULL;
+  }
+
+  for (i = 0; i < nOfTransIds; i++) {
+    bcast->transIds[i] = transIds[i];
+    bcast->nOfSubs[i]  = 0;
+  }
+  memset(bcast->iSub, 0, nOfTransIds * maxNOfSms * sizeof(FwSmCounterU4_t));
+  bcast->nOfTransIds = nOfTransIds;
+  bcast->maxNOfSms   = maxNOfSms;
+  bcast->nOfDirty    = 0;
+
+  return bcast;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+FwSmErrCode_t FwSmBcastAdd(FwSmBcastDesc_t bcast, FwSmDesc_t smDesc) {
+  SmBcastLink_t* link;
+
+  if (bcast->nOfSms == bcast->maxNOfSms) {
+    return smBcastFull;
+  }
+
+  if (BcastIsFree(smDesc) == 0) {
+    return smBcastBusy;
+  }
+
+  /* The subscriptions of the new hierarchy are computed at the next broadcast */
+  link                          = &(bcast->links[bcast->nOfSms]);
+  link->bcast                   = bcast;
+  link->iSm                     = bcast->nOfSms;
+  link->isDirty                 = 1;
+  bcast->dirty[bcast->nOfDirty] = bcast->nOfSms;
+  bcast->smDesc[bcast->nOfSms]  = smDesc;
+  bcast->nOfDirty++;
+  bcast->nOfSms++;
+  BcastSetLink(smDesc, link);
+  return smSuccess;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+FwSmErrCode_t FwSmBcastRemove(FwSmBcastDesc_t bcast, FwSmDesc_t smDesc) {
+  SmBcastLink_t* link = smDesc->bcast;
+
+  if ((link == NULL) || (link->bcast != bcast) || (bcast->smDesc[link->iSm] != smDesc)) {
+    return smBcastNotFound;
+  }
+  BcastRemove(bcast, link->iSm);
+  return smSuccess;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+void SmBcastRemove(FwSmDesc_t smDesc) {
+  BcastRemove(smDesc->bcast->bcast, smDesc->bcast->iSm);
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+FwSmCounterU4_t FwSmBcastGetNOfSms(FwSmBcastDesc_t bcast) {
+  return bcast->nOfSms;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+FwSmCounterU4_t FwSmBcastGetNOfSubs(FwSmBcastDesc_t bcast, FwSmCounterU2_t transId) {
+  FwSmCounterU4_t iTrig = BcastFindTrig(bcast, transId);
+
+  if (iTrig == bcast->nOfTransIds) {
+    return bcast->nOfSms;
+  }
+  BcastRefresh(bcast);
+  return bcast->nOfSubs[iTrig];
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+FwSmCounterU4_t FwSmBcastMakeTrans(FwSmBcastDesc_t bcast, FwSmCounterU2_t transId) {
+  FwSmCounterU4_t  iTrig = BcastFindTrig(bcast, transId);
+  FwSmCounterU4_t  i, nOfSubs;
+  FwSmCounterU4_t* subs;
+
+  if (iTrig == bcast->nOfTransIds) { /* not a broadcast trigger: send it to all hierarchies */
+    for (i = 0; i < bcast->nOfSms; i++) {
+      FwSmMakeTrans(bcast->smDesc[i], transId);
+    }
+    return bcast->nOfSms;
+  }
+
+  /* The subscriptions are only brought up to date at the next broadcast: the list of subscribers
+   * therefore remains unchanged while the command is sent */
+  BcastRefresh(bcast);
+  subs    = &(bcast->subs[iTrig * bcast->maxNOfSms]);
+  nOfSubs = bcast->nOfSubs[iTrig];
+  for (i = 0; i < nOfSubs; i++) {
+    FwSmMakeTrans(bcast->smDesc[subs[i]], transId);
+  }
+  return nOfSubs;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+void FwSmBcastRelease(FwSmBcastDesc_t bcast) {
+  FwSmCounterU4_t i;
+
+  for (i = 0; i < bcast->nOfSms; i++) {
+    BcastSetLink(bcast->smDesc[i], NULL);
+  }
+  free(bcast->transIds);
+  free(bcast->react);
+  free(bcast->smDesc);
+  free(bcast->links);
+  free(bcast->subs);
+  free(bcast->iSub);
+  free(bcast->nOfSubs);
+  free(bcast->dirty);
+  free(bcast);
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+static FwSmBool_t BcastIsFree(FwSmDesc_t smDesc) {
+  FwSmCounterS1_t i;
+
+  if (smDesc->bcast != NULL) {
+    return 0;
+  }
+  for (i = 0; i < smDesc->smBase->nOfPStates; i++) {
+    if ((smDesc->esmDesc[i] != NULL) && (BcastIsFree(smDesc->esmDesc[i]) == 0)) {
+      return 0;
+    }
+  }
+  return 1;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+static void BcastSetLink(FwSmDesc_t smDesc, SmBcastLink_t* link) {
+  FwSmCounterS1_t i;
+
+  smDesc->bcast = link;
+  for (i = 0; i < smDesc->smBase->nOfPStates; i++) {
+    if (smDesc->esmDesc[i] != NULL) {
+      BcastSetLink(smDesc->esmDesc[i], link);
+    }
+  }
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+static FwSmCounterU4_t BcastFindTrig(FwSmBcastDesc_t bcast, FwSmCounterU2_t transId) {
+  FwSmCounterU4_t i;
+
+  for (i = 0; i < bcast->nOfTransIds; i++) {
+    if (bcast->transIds[i] == transId) {
+      break;
+    }
+  }
+  return i;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+static void BcastRefresh(FwSmBcastDesc_t bcast) {
+  FwSmCounterU4_t  i, iSm, iTrig, pos, last;
+  FwSmCounterU4_t* subs;
+  FwSmCounterU4_t* iSub;
+  FwSmCounterS1_t  j;
+  FwSmDesc_t       smDesc;
+  SmPState_t*      curState;
+  SmTrans_t*       trans;
+
+  for (i = 0; i < bcast->nOfDirty; i++) {
+    iSm                       = bcast->dirty[i];
+    bcast->links[iSm].isDirty = 0;
+    memset(bcast->react, 0, bcast->nOfTransIds);
+
+    /* Collect the broadcast triggers which respond to the current states of the hierarchy */
+    smDesc = bcast->smDesc[iSm];
+    if (smDesc->curState != 0) {
+      for (iTrig = 0; iTrig < bcast->nOfTransIds; iTrig++) {
+        if (bcast->transIds[iTrig] == FW_TR_EXECUTE) {
+          bcast->react[iTrig] = 1;
+        }
+      }
+    }
+    while ((smDesc != NULL) && (smDesc->curState != 0)) {
+      curState = &(smDesc->smBase->pStates[(smDesc->curState) - 1]);
+      for (j = 0; j < curState->nOfOutTrans; j++) {
+        trans = &(smDesc->smBase->trans[curState->outTransIndex + j]);
+        for (iTrig = 0; iTrig < bcast->nOfTransIds; iTrig++) {
+          if (bcast->transIds[iTrig] == trans->id) {
+            bcast->react[iTrig] = 1;
+          }
+        }
+      }
+      smDesc = smDesc->esmDesc[(smDesc->curState) - 1];
+    }
+
+    /* Add the hierarchy to (or remove it from) the subscribers of each broadcast trigger */
+    for (iTrig = 0; iTrig < bcast->nOfTransIds; iTrig++) {
+      subs = &(bcast->subs[iTrig * bcast->maxNOfSms]);
+      iSub = &(bcast->iSub[iTrig * bcast->maxNOfSms]);
+      if ((bcast->react[iTrig] != 0) && (iSub[iSm] == 0)) {
+        subs[bcast->nOfSubs[iTrig]] = iSm;
+        bcast->nOfSubs[iTrig]++;
+        iSub[iSm] = bcast->nOfSubs[iTrig];
+      }
+      else if ((bcast->react[iTrig] == 0) && (iSub[iSm] != 0)) {
+        pos        = iSub[iSm] - 1;
+        last       = subs[bcast->nOfSubs[iTrig] - 1];
+        subs[pos]  = last;
+        iSub[last] = pos + 1;
+        iSub[iSm]  = 0;
+        bcast->nOfSubs[iTrig]--;
+      }
+    }
+  }
+  bcast->nOfDirty = 0;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+static void BcastRemove(FwSmBcastDesc_t bcast, FwSmCounterU4_t iSm) {
+  FwSmCounterU4_t  i, iTrig, pos, lastSub;
+  FwSmCounterU4_t  last = bcast->nOfSms - 1;
+  FwSmCounterU4_t* subs;
+  FwSmCounterU4_t* iSub;
+
+  BcastSetLink(bcast->smDesc[iSm], NULL);
+
+  /* Remove the hierarchy from the subscribers of each broadcast trigger and give its position to the last one */
+  for (iTrig = 0; iTrig < bcast->nOfTransIds; iTrig++) {
+    subs = &(bcast->subs[iTrig * bcast->maxNOfSms]);
+    iSub = &(bcast->iSub[iTrig * bcast->maxNOfSms]);
+    if (iSub[iSm] != 0) {
+      pos           = iSub[iSm] - 1;
+      lastSub       = subs[bcast->nOfSubs[iTrig] - 1];
+      subs[pos]     = lastSub;
+      iSub[lastSub] = pos + 1;
+      iSub[iSm]     = 0;
+      bcast->nOfSubs[iTrig]--;
+    }
+    if ((iSm != last) && (iSub[last] != 0)) {
+      subs[iSub[last] - 1] = iSm;
+      iSub[iSm]            = iSub[last];
+      iSub[last]           = 0;
+    }
+  }
+
+  /* Remove the hierarchy from the list of changed hierarchies and renumber the last one */
+  for (i = 0; i < bcast->nOfDirty; i++) {
+    if (bcast->dirty[i] == iSm) {
+      bcast->nOfDirty--;
+      bcast->dirty[i] = bcast->dirty[bcast->nOfDirty];
+      break;
+    }
+  }
+  for (i = 0; i < bcast->nOfDirty; i++) {
+    if (bcast->dirty[i] == last) {
+      bcast->dirty[i] = iSm;
+    }
+  }
+
+  /* The state machines of the last hierarchy point to its link which is moved */
+  if (iSm != last) {
+    bcast->smDesc[iSm]    = bcast->smDesc[last];
+    bcast->links[iSm]     = bcast->links[last];
+    bcast->links[iSm].iSm = iSm;
+    BcastSetLink(bcast->smDesc[iSm], &(bcast->links[iSm]));
+  }
+  bcast->nOfSms--;
+}
@@ -0,0 +1,155 @@
+/**
+ * @file
+ * @ingroup smGroup
+ * Declaration of the broadcast interface for a FW State Machine.
+ * A broadcast registry holds a set of hierarchies of state machines to which some
+ * transition commands (the <i>broadcast triggers</i>) are broadcast.
+ * A hierarchy consists of a state machine and of all the state machines which are
+ * embedded in its states (recursively) and it is identified by the state machine at
+ * its top.
+ *
+ * Broadcasting a transition command to a set of hierarchies is functionally equivalent
+ * to calling <code>::FwSmMakeTrans</code> on each of them.
+ * However, most hierarchies normally have no out-going transition which responds to the
+ * broadcast trigger from their current states and the command has no effect on them.
+ * For this reason, the registry holds, for each broadcast trigger, the set of
+ * hierarchies which <i>subscribe</i> to it.
+ * A hierarchy subscribes to a broadcast trigger if one of the current states of its
+ * state machines has an out-going transition which responds to the trigger (or, for the
+ * "Execute" transition command, if the hierarchy is started).
+ * A broadcast trigger is only sent to the hierarchies which subscribe to it.
+ *
+ * The subscriptions are tracked by the state machines: when the current state of a
+ * state machine in a registry changes, its hierarchy is marked as changed and its
+ * subscriptions are brought up to date when the next transition command is broadcast.
+ * Hence, the hierarchies in a registry may also be started, stopped and sent transition
+ * commands with the functions of the <code>Core</code> module.
+ *
+ * The basic mode of use of the functions declared in this file is as follows:
+ * -# The registry is created for a set of broadcast triggers with function
+ *    <code>::FwSmBcastCreate</code>.
+ * -# The hierarchies are added to the registry with function <code>::FwSmBcastAdd</code>.
+ * -# The broadcast triggers are sent to the hierarchies with function
+ *    <code>::FwSmBcastMakeTrans</code>.
+ * -# Hierarchies may be removed from the registry with function
+ *    <code>::FwSmBcastRemove</code>.
+ * -# The registry is released with function <code>::FwSmBcastRelease</code>.
+ * .
+ * A state machine can be in at most one registry.
+ * A hierarchy stays in its registry until it is removed from it, until the registry is
+ * released, or until one of its state machines is released (with
+ * <code>::FwSmRelease</code>, <code>::FwSmReleaseDer</code>,
+ * <code>::FwSmReleaseArena</code> or one of the functions which call them) or is
+ * returned to its pool (with <code>::FwSmPoolPut</code>), in which case the whole
+ * hierarchy is removed from the registry.
+ * The topology of the state machines in a registry must not be modified.
+ * The registry must not be modified (i.e. hierarchies must not be added to it or
+ * removed from it, directly or by releasing them) while a transition command is
+ * broadcast to it.
+ *
+ * The memory for the registry descriptor is allocated dynamically through calls
+ * to <code>malloc</code> and released through calls to <code>free</code>.
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2011, All Rights Reserved
+ *
+ * This file is part of the FW Profile.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#ifndef FWSM_BCAST_H_
+#define FWSM_BCAST_H_
+
+#include "FwSmCore.h"
+
+/**
+ * Create a new broadcast registry.
+ * The identifiers of the broadcast triggers are copied into the registry.
+ * @param transIds the identifiers of the broadcast triggers.
+ * @param nOfTransIds the number of broadcast triggers (a positive integer).
+ * @param maxNOfSms the maximum number of hierarchies in the registry (a positive integer).
+ * @return the descriptor of the new registry (or NULL if the creation of the data
+ * structures to hold the registry descriptor failed or if the number of broadcast
+ * triggers or the maximum number of hierarchies is zero).
+ */
+FwSmBcastDesc_t FwSmBcastCreate(const FwSmCounterU2_t* transIds, FwSmCounterU4_t nOfTransIds,
+                                FwSmCounterU4_t maxNOfSms);
+
+/**
+ * Add a hierarchy of state machines to a broadcast registry.
+ * The hierarchy may be started or stopped.
+ * @param bcast the descriptor of the registry.
+ * @param smDesc the descriptor of the state machine at the top of the hierarchy.
+ * @return <code>#smSuccess</code> if the hierarchy was added to the registry,
+ * <code>#smBcastFull</code> if the registry already holds its maximum number of
+ * hierarchies, or <code>#smBcastBusy</code> if one of the state machines in the
+ * hierarchy is already in a registry.
+ */
+FwSmErrCode_t FwSmBcastAdd(FwSmBcastDesc_t bcast, FwSmDesc_t smDesc);
+
+/**
+ * Remove a hierarchy of state machines from a broadcast registry.
+ * The last hierarchy of the registry takes the position of the removed one (this
+ * changes the order in which <code>::FwSmBcastMakeTrans</code> sends transition
+ * commands which are not broadcast triggers).
+ * The state machines of the removed hierarchy are not affected (but they can be added
+ * to another registry).
+ * @param bcast the descriptor of the registry.
+ * @param smDesc the descriptor of the state machine at the top of the hierarchy.
+ * @return <code>#smSuccess</code> if the hierarchy was removed from the registry or
+ * <code>#smBcastNotFound</code> if the state machine is not at the top of a hierarchy
+ * in the registry.
+ */
+FwSmErrCode_t FwSmBcastRemove(FwSmBcastDesc_t bcast, FwSmDesc_t smDesc);
+
+/**
+ * Return the number of hierarchies in a broadcast registry.
+ * @param bcast the descriptor of the registry.
+ * @return the number of hierarchies in the registry.
+ */
+FwSmCounterU4_t FwSmBcastGetNOfSms(FwSmBcastDesc_t bcast);
+
+/**
+ * Return the number of hierarchies in a broadcast registry which subscribe to a
+ * broadcast trigger.
+ * The subscriptions of the hierarchies which have changed are brought up to date.
+ * @param bcast the descriptor of the registry.
+ * @param transId the identifier of the broadcast trigger.
+ * @return the number of hierarchies which subscribe to the broadcast trigger or the
+ * number of hierarchies in the registry if the trigger is not a broadcast trigger of
+ * the registry.
+ */
+FwSmCounterU4_t FwSmBcastGetNOfSubs(FwSmBcastDesc_t bcast, FwSmCounterU2_t transId);
+
+/**
+ * Broadcast a transition command to the hierarchies in a broadcast registry.
+ * The subscriptions of the hierarchies which have changed are brought up to date and
+ * <code>::FwSmMakeTrans</code> is called on the hierarchies which subscribe to the
+ * transition command.
+ * The order in which the hierarchies receive the command is deterministic but it is
+ * not necessarily the order in which they were added to the registry.
+ * If the transition command is not a broadcast trigger of the registry, it is sent to
+ * all the hierarchies in the order of their positions in the registry (this is the
+ * order in which they were added to the registry unless hierarchies were removed from
+ * it, see <code>::FwSmBcastRemove</code>).
+ * @param bcast the descriptor of the registry.
+ * @param transId the identifier of the transition command.
+ * @return the number of hierarchies to which the transition command was sent.
+ */
+FwSmCounterU4_t FwSmBcastMakeTrans(FwSmBcastDesc_t bcast, FwSmCounterU2_t transId);
+
+/**
+ * Release the memory which was allocated when the broadcast registry was created.
+ * After this operation is called, the registry descriptor can no longer be used.
+ * The state machines in the registry are not affected (but they can be added to
+ * another registry).
+ * @param bcast the descriptor of the registry.
+ */
+void FwSmBcastRelease(FwSmBcastDesc_t bcast);
+
+#endif /* FWSM_BCAST_H_ */
@@ -18,6 +18,14 @@
 #include "FwSmConfig.h"
 #include "FwSmPrivate.h"
 #include <stdlib.h>
+#include <string.h>
+
+/**
+ * Number of states and choice pseudo-states up to which <code>::FwSmCheck</code> performs
+ * its reachability analysis in local buffers (for larger state machines, the buffers are
+ * allocated with <code>malloc</code>).
+ */
+#define SM_CHECK_LOCAL_NODES 64
 
 /**
  * Create a transition (other than the transition from the initial pseudo-state) with the
@@ -53,6 +61,8 @@ static void AddTrans(FwSmDesc_t smDesc, FwSmCounterU2_t transId, FwSmCounterS1_t
  *   location;
  * - if the argument action is not present but the array of actions is already full,
  *   the function returns 0.
+ * If the state machine has a configuration index (see #FW_SM_CFG_INDEX_MIN), the
+ * look-up is done through the index and does not scan the array of actions.
  * @param smDesc descriptor of the state machine where the action is added
  * @param action action to be added
  * @return the location where the action is stored in the array or -1 if the
@@ -72,6 +82,8 @@ static FwSmCounterS1_t AddAction(FwSmDesc_t smDesc, FwSmAction_t action);
  *   location;
  * - if the argument guard is not present but the array of guards is already full, the
  *   function returns 0.
+ * If the state machine has a configuration index (see #FW_SM_CFG_INDEX_MIN), the
+ * look-up is done through the index and does not scan the array of guards.
  * @param smDesc descriptor of the state machine where the guard is added
  * @param guard guard to be added
  * @return the location where the guard is stored in the array or -1 if the
@@ -79,6 +91,168 @@ static FwSmCounterS1_t AddAction(FwSmDesc_t smDesc, FwSmAction_t action);
  */
 static FwSmCounterS1_t AddGuard(FwSmDesc_t smDesc, FwSmGuard_t guard);
 
+/**
+ * Sort a section of the transition dispatch table of a state machine.
+ * The section holds the indices of the transitions out of one state.
+ * The indices are sorted by increasing transition identifier and, for transitions with
+ * the same identifier, by increasing transition index.
+ * Since no two transitions have the same index, the sorting key is unique and the
+ * resulting order does not depend on the stability of the sorting algorithm.
+ * @param smBase the base descriptor of the state machine
+ * @param first the first location of the section of the dispatch table to be sorted
+ * @param n the number of locations in the section of the dispatch table to be sorted
+ */
+static void SortTransDisp(SmBaseDesc_t* smBase, FwSmCounterS1_t first, FwSmCounterS1_t n);
+
+/**
+ * Build the direct-index section of the transition dispatch table for a proper state
+ * of a state machine (see <code>::SmBaseDesc_t</code>).
+ * The section is only built if the state has at least
+ * <code>#FW_SM_DISP_MIN_DIRECT_OUT_TRANS</code> out-going transitions and if the
+ * range of their identifiers is small enough; otherwise field <code>dispNOfIds</code>
+ * of the state is set to zero.
+ * The part of the sorted section of the dispatch table which belongs to the state
+ * must already have been sorted.
+ * @param smBase the base descriptor of the state machine
+ * @param pState the proper state
+ */
+static void SetDirectDisp(SmBaseDesc_t* smBase, SmPState_t* pState);
+
+/**
+ * Give a derived state machine its own copy of arrays which it shares with its base
+ * state machine (see <code>::FwSmCreateDerShared</code>).
+ * Arrays which are not shared are not affected.
+ * If the copy of an array cannot be allocated, the error code of the state machine is
+ * set to #smOutOfMemory.
+ * @param smDesc the descriptor of the derived state machine
+ * @param arrays the arrays to be copied (a combination of #SM_SHARED_ACTIONS,
+ * #SM_SHARED_GUARDS and #SM_SHARED_ESM)
+ * @return 1 if the state machine owns the arrays or 0 if the copy of an array could
+ * not be allocated
+ */
+static FwSmBool_t UnshareArrays(FwSmDesc_t smDesc, FwSmCounterU1_t arrays);
+
+/**
+ * Set or clear the bit of a guard in the bitmask of the pure guards of a state machine.
+ * The bit of the guard in the bitmask of the cached outcomes is cleared.
+ * This function does nothing if the state machine has no guard memo.
+ * @param smDesc the descriptor of the state machine
+ * @param iGuard the index of the guard in the guard array of the state machine
+ * @param isPure 1 if the bit is to be set, 0 if it is to be cleared
+ */
+static void MarkGuardPure(FwSmDesc_t smDesc, FwSmCounterS1_t iGuard, FwSmBool_t isPure);
+
+/**
+ * Return the guard memo of a state machine (the guard memo is allocated if it does not exist).
+ * A new guard memo has no pure guards and no declarative guards.
+ * @param smDesc the descriptor of the state machine
+ * @return the guard memo (or NULL if its allocation failed)
+ */
+static SmGuardMemo_t* GetGuardMemo(FwSmDesc_t smDesc);
+
+/**
+ * Remove the pure mark and the declaration of a guard of a state machine.
+ * This function does nothing if the state machine has no guard memo.
+ * @param smDesc the descriptor of the state machine
+ * @param iGuard the index of the guard in the guard array of the state machine
+ */
+static void ForgetGuard(FwSmDesc_t smDesc, FwSmCounterS1_t iGuard);
+
+/**
+ * Check that all states and choice pseudo-states of a state machine are reachable.
+ * The states and choice pseudo-states (the "nodes" of the state machine) are numbered
+ * consecutively: proper states first and then choice pseudo-states.
+ * The function first makes one pass over the transitions to mark, in a bitmap, all nodes
+ * which are the destination of a transition.
+ * It then performs a depth-first search from the destination of the initial transition
+ * to mark all nodes which can be reached from the initial pseudo-state.
+ * This function assumes that the destinations of all transitions are legal.
+ * @param smDesc the descriptor of the state machine
+ * Only the states have to be checked after the search because the transitions into a
+ * choice pseudo-state start either from the initial pseudo-state or from a state.
+ * @return #smSuccess if all nodes are reachable, #smUnreachablePState or
+ * #smUnreachableCState if a node is not the destination of any transition,
+ * #smDisconnectedPState if a state cannot be reached from the initial pseudo-state,
+ * or #smOutOfMemory if the buffers cannot be allocated
+ */
+static FwSmErrCode_t CheckReachability(FwSmDesc_t smDesc);
+
+/**
+ * Mark the destination of a transition in the bitmap of reached nodes.
+ * @param smBase the base descriptor of the state machine
+ * @param map the bitmap of reached nodes
+ * @param dest the destination of the transition
+ * @param node the node number of the destination (only set if the destination is
+ * a state or a choice pseudo-state)
+ * @return 1 if the destination is a state or choice pseudo-state which was not yet
+ * marked, 0 otherwise
+ */
+static FwSmBool_t MarkDest(SmBaseDesc_t* smBase, unsigned char* map, FwSmCounterS1_t dest, FwSmCounterU4_t* node);
+
+/**
+ * Return the configuration index of a state machine and build it if it does not yet exist.
+ * The configuration index is only built if the sum of the sizes of the action and guard
+ * arrays is at least equal to #FW_SM_CFG_INDEX_MIN.
+ * @param smDesc the descriptor of the state machine
+ * @return the configuration index or NULL if the configuration index is not used or
+ * cannot be allocated (in which case the action and guard arrays must be scanned)
+ */
+static SmCfgIndex_t* GetCfgIndex(FwSmDesc_t smDesc);
+
+/**
+ * Compute the hash of a function pointer from the bytes of its representation.
+ * @param key the address of the function pointer
+ * @param size the size of the function pointer
+ * @return the hash of the function pointer
+ */
+static FwSmCounterU4_t HashFunc(const void* key, size_t size);
+
+/**
+ * Fill the hash table of an action or guard array with the non-NULL function pointers
+ * which precede the first NULL location at or after location <code>next</code>.
+ * @param index the hash table
+ * @param array the action or guard array
+ * @param elemSize the size of the elements of the array
+ * @param n the number of elements of the array
+ * @param nullKey the address of a NULL function pointer of the type of the array elements
+ */
+static void AdvanceIndex(SmFuncIndex_t* index, const void* array, size_t elemSize, FwSmCounterS1_t n,
+                         const void* nullKey);
+
+/**
+ * Look for a function pointer in the hash table of an action or guard array.
+ * @param index the hash table
+ * @param array the action or guard array
+ * @param elemSize the size of the elements of the array
+ * @param key the address of the function pointer
+ * @return the entry of the hash table which holds the function pointer or, if the function
+ * pointer is not in the hash table, the empty entry where it can be inserted
+ */
+static FwSmCounterU4_t ProbeIndex(SmFuncIndex_t* index, const void* array, size_t elemSize, const void* key);
+
+/**
+ * Insert a location of an action or guard array in its hash table.
+ * If the function pointer at the location is already in the hash table, the hash table
+ * keeps the smaller of the two locations.
+ * @param index the hash table
+ * @param array the action or guard array
+ * @param elemSize the size of the elements of the array
+ * @param loc the location of the array
+ */
+static void InsertInIndex(SmFuncIndex_t* index, const void* array, size_t elemSize, FwSmCounterS1_t loc);
+
+/**
+ * Update the hash table of an action or guard array after the function pointer held in
+ * one of its entries has been overwritten with a non-NULL function pointer.
+ * @param index the hash table
+ * @param array the action or guard array (the location has already been overwritten)
+ * @param elemSize the size of the elements of the array
+ * @param pos the entry of the hash table which holds the overwritten location
+ * @param oldKey the address of the overwritten function pointer
+ */
+static void ReplaceInIndex(SmFuncIndex_t* index, const void* array, size_t elemSize, FwSmCounterU4_t pos,
+                           const void* oldKey);
+
 /* ----------------------------------------------------------------------------------------------------------------- */
 void FwSmSetData(FwSmDesc_t smDesc, void* smData) {
   smDesc->smData = smData;
@@ -125,6 +299,7 @@ void FwSmAddState(FwSmDesc_t smDesc, FwSmCounterS1_t stateId, FwSmCounterS1_t nO
 
   pState->outTransIndex = smDesc->transCnt;
   smDesc->transCnt      = (FwSmCounterS1_t)(smDesc->transCnt + nOfOutTrans);
+  smBase->isCompiled    = 0;
 
   pState->iDoAction    = AddAction(smDesc, doAction);
   pState->iEntryAction = AddAction(smDesc, entryAction);
@@ -132,6 +307,7 @@ void FwSmAddState(FwSmDesc_t smDesc, FwSmCounterS1_t stateId, FwSmCounterS1_t nO
 
   smDesc->esmDesc[stateId - 1] = esmDesc;
   pState->nOfOutTrans          = nOfOutTrans;
+  pState->isExecInert          = (FwSmCounterU1_t)(pState->iDoAction == 0);
 
   return;
 }
@@ -292,17 +468,45 @@ static void AddTrans(FwSmDesc_t smDesc, FwSmCounterU2_t transId, FwSmCounterS1_t
   /* add guard to transition descriptor */
   trans->iTrGuard = AddGuard(smDesc, trGuard);
 
+  /* The transition dispatch table (if any) is no longer up-to-date and an "Execute" transition makes its source
+   * state not execute-inert */
+  smBase->isCompiled = 0;
+  if ((srcType == properState) && (transId == FW_TR_EXECUTE)) {
+    smBase->pStates[srcId - 1].isExecInert = 0;
+  }
+
   return;
 }
 
 /* ----------------------------------------------------------------------------------------------------------------- */
 static FwSmCounterS1_t AddAction(FwSmDesc_t smDesc, FwSmAction_t action) {
   FwSmCounterS1_t i;
+  SmCfgIndex_t*   cfgIndex;
+  FwSmCounterU4_t pos;
+  FwSmAction_t    nullAction = NULL;
 
   if (action == NULL) {
     return 0;
   }
 
+  cfgIndex = GetCfgIndex(smDesc);
+  if (cfgIndex != NULL) {
+    pos = ProbeIndex(&(cfgIndex->actions), smDesc->smActions, sizeof(FwSmAction_t), &action);
+    if (cfgIndex->actions.table[pos] != -1) {
+      return cfgIndex->actions.table[pos];
+    }
+    i = cfgIndex->actions.next;
+    if (i < smDesc->nOfActions) {
+      smDesc->smActions[i]         = action;
+      cfgIndex->actions.table[pos] = i;
+      cfgIndex->actions.next       = (FwSmCounterS1_t)(i + 1);
+      AdvanceIndex(&(cfgIndex->actions), smDesc->smActions, sizeof(FwSmAction_t), smDesc->nOfActions, &nullAction);
+      return i;
+    }
+    smDesc->errCode = smTooManyActions;
+    return 0;
+  }
+
   for (i = 1; i < smDesc->nOfActions; i++) {
     if (smDesc->smActions[i] == NULL) {
       break;
@@ -324,11 +528,32 @@ static FwSmCounterS1_t AddAction(FwSmDesc_t smDesc, FwSmAction_t action) {
 /* ----------------------------------------------------------------------------------------------------------------- */
 static FwSmCounterS1_t AddGuard(FwSmDesc_t smDesc, FwSmGuard_t guard) {
   FwSmCounterS1_t i;
+  SmCfgIndex_t*   cfgIndex;
+  FwSmCounterU4_t pos;
+  FwSmGuard_t     nullGuard = NULL;
 
   if (guard == NULL) {
     return 0;
   }
 
+  cfgIndex = GetCfgIndex(smDesc);
+  if (cfgIndex != NULL) {
+    pos = ProbeIndex(&(cfgIndex->guards), smDesc->smGuards, sizeof(FwSmGuard_t), &guard);
+    if (cfgIndex->guards.table[pos] != -1) {
+      return cfgIndex->guards.table[pos];
+    }
+    i = cfgIndex->guards.next;
+    if (i < smDesc->nOfGuards) {
+      smDesc->smGuards[i]         = guard;
+      cfgIndex->guards.table[pos] = i;
+      cfgIndex->guards.next       = (FwSmCounterS1_t)(i + 1);
+      AdvanceIndex(&(cfgIndex->guards), smDesc->smGuards, sizeof(FwSmGuard_t), smDesc->nOfGuards, &nullGuard);
+      return i;
+    }
+    smDesc->errCode = smTooManyGuards;
+    return 0;
+  }
+
   for (i = 1; i < smDesc->nOfGuards; i++) {
     if (smDesc->smGuards[i] == NULL) {
       break;
@@ -349,8 +574,8 @@ static FwSmCounterS1_t AddGuard(FwSmDesc_t smDesc, FwSmGuard_t guard) {
 /* ----------------------------------------------------------------------------------------------------------------- */
 FwSmErrCode_t FwSmCheck(FwSmDesc_t smDesc) {
 
-  FwSmCounterS1_t i, j;
-  FwSmBool_t      found;
+  FwSmCounterS1_t i;
+  FwSmErrCode_t   outcome;
   SmBaseDesc_t*   smBase = smDesc->smBase;
 
   /* Check that no error occurred during the configuration process */
@@ -403,49 +628,281 @@ FwSmErrCode_t FwSmCheck(FwSmDesc_t smDesc) {
     }
   }
 
-  /* Check that all states are reachable */
-  for (i = 1; i <= smBase->nOfPStates; i++) {
-    found = 0;
-    for (j = 0; j < smBase->nOfTrans; j++) {
-      if (smBase->trans[j].dest == i) {
-        found = 1;
-        break;
-      }
+  /* Check that all states and choice pseudo-states are reachable */
+  outcome = CheckReachability(smDesc);
+  if (outcome != smSuccess) {
+    return outcome;
+  }
+
+  /* The configuration index is no longer needed once the configuration is complete (the index belongs to the
+   * state machine descriptor: the base descriptor is never modified by the check) */
+  free(smDesc->cfgIndex);
+  smDesc->cfgIndex = NULL;
+
+  return smSuccess;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+static FwSmBool_t UnshareArrays(FwSmDesc_t smDesc, FwSmCounterU1_t arrays) {
+  FwSmAction_t*     smActions;
+  FwSmGuard_t*      smGuards;
+  struct FwSmDesc** esmDesc;
+  FwSmCounterU4_t   nOfPStates = (FwSmCounterU4_t)(smDesc->smBase->nOfPStates);
+
+  arrays = (FwSmCounterU1_t)(arrays & smDesc->shared);
+
+  if ((arrays & SM_SHARED_ACTIONS) != 0) {
+    smActions = (FwSmAction_t*)malloc(((FwSmCounterU4_t)(smDesc->nOfActions)) * sizeof(FwSmAction_t));
+    if (smActions == NULL) {
+      smDesc->errCode = smOutOfMemory;
+      return 0;
+    }
+    memcpy(smActions, smDesc->smActions, ((FwSmCounterU4_t)(smDesc->nOfActions)) * sizeof(FwSmAction_t));
+    smDesc->smActions = smActions;
+    smDesc->shared    = (FwSmCounterU1_t)(smDesc->shared & ~SM_SHARED_ACTIONS);
+  }
+
+  if ((arrays & SM_SHARED_GUARDS) != 0) {
+    smGuards = (FwSmGuard_t*)malloc(((FwSmCounterU4_t)(smDesc->nOfGuards)) * sizeof(FwSmGuard_t));
+    if (smGuards == NULL) {
+      smDesc->errCode = smOutOfMemory;
+      return 0;
+    }
+    memcpy(smGuards, smDesc->smGuards, ((FwSmCounterU4_t)(smDesc->nOfGuards)) * sizeof(FwSmGuard_t));
+    smDesc->smGuards = smGuards;
+    smDesc->shared   = (FwSmCounterU1_t)(smDesc->shared & ~SM_SHARED_GUARDS);
+  }
+
+  /* The array of embedded state machines is only shared if it does not hold any state machine */
+  if (((arrays & SM_SHARED_ESM) != 0) && (nOfPStates > 0)) {
+    esmDesc = (struct FwSmDesc**)malloc(nOfPStates * sizeof(FwSmDesc_t));
+    if (esmDesc == NULL) {
+      smDesc->errCode = smOutOfMemory;
+      return 0;
     }
-    if (found == 0) {
-      return smUnreachablePState;
+    memcpy(esmDesc, smDesc->esmDesc, nOfPStates * sizeof(FwSmDesc_t));
+    smDesc->esmDesc = esmDesc;
+    smDesc->shared  = (FwSmCounterU1_t)(smDesc->shared & ~SM_SHARED_ESM);
+  }
+
+  return 1;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+static FwSmErrCode_t CheckReachability(FwSmDesc_t smDesc) {
+  SmBaseDesc_t*    smBase   = smDesc->smBase;
+  FwSmCounterU4_t  nOfNodes = (FwSmCounterU4_t)smBase->nOfPStates + (FwSmCounterU4_t)smBase->nOfCStates;
+  FwSmCounterU4_t  mapSize  = (nOfNodes + 7) / 8;
+  FwSmCounterU4_t  localStack[SM_CHECK_LOCAL_NODES];
+  unsigned char    localMap[SM_CHECK_LOCAL_NODES / 8];
+  FwSmCounterU4_t* stack      = localStack;
+  unsigned char*   map        = localMap;
+  FwSmCounterU4_t  nOfStacked = 0;
+  FwSmCounterU4_t  node;
+  FwSmCounterS1_t  i, first, last;
+  FwSmErrCode_t    outcome = smSuccess;
+
+  if (nOfNodes > SM_CHECK_LOCAL_NODES) {
+    stack = (FwSmCounterU4_t*)malloc(nOfNodes * sizeof(FwSmCounterU4_t) + mapSize);
+    if (stack == NULL) {
+      return smOutOfMemory;
+    }
+    map = (unsigned char*)(stack + nOfNodes);
+  }
+
+  /* Mark all nodes which are the destination of at least one transition */
+  memset(map, 0, mapSize);
+  for (i = 0; i < smBase->nOfTrans; i++) {
+    (void)MarkDest(smBase, map, smBase->trans[i].dest, &node);
+  }
+  for (node = 0; node < nOfNodes; node++) {
+    if ((map[node / 8] & (1U << (node % 8))) == 0) {
+      outcome = (node < (FwSmCounterU4_t)smBase->nOfPStates) ? smUnreachablePState : smUnreachableCState;
+      break;
     }
   }
 
-  /* Check that all choice pseudo-states are reachable */
-  for (i = 1; i <= smBase->nOfCStates; i++) {
-    found = 0;
-    for (j = 0; j < smBase->nOfTrans; j++) {
-      if (smBase->trans[j].dest == -i) {
-        found = 1;
+  /* Mark all nodes which can be reached from the initial pseudo-state (i.e. from the
+   * destination of the initial transition which is stored at location 0) */
+  if (outcome == smSuccess) {
+    memset(map, 0, mapSize);
+    if (MarkDest(smBase, map, smBase->trans[0].dest, &node) == 1) {
+      stack[nOfStacked++] = node;
+    }
+    while (nOfStacked > 0) {
+      node = stack[--nOfStacked];
+      if (node < (FwSmCounterU4_t)smBase->nOfPStates) {
+        first = smBase->pStates[node].outTransIndex;
+        last  = (FwSmCounterS1_t)(first + smBase->pStates[node].nOfOutTrans);
+      }
+      else {
+        first = smBase->cStates[node - (FwSmCounterU4_t)smBase->nOfPStates].outTransIndex;
+        last  = (FwSmCounterS1_t)(first + smBase->cStates[node - (FwSmCounterU4_t)smBase->nOfPStates].nOfOutTrans);
+      }
+      for (i = first; i < last; i++) {
+        if (MarkDest(smBase, map, smBase->trans[i].dest, &node) == 1) {
+          stack[nOfStacked++] = node;
+        }
+      }
+    }
+    for (node = 0; node < (FwSmCounterU4_t)smBase->nOfPStates; node++) {
+      if ((map[node / 8] & (1U << (node % 8))) == 0) {
+        outcome = smDisconnectedPState;
         break;
       }
     }
-    if (found == 0) {
-      return smUnreachableCState;
+  }
+
+  if (stack != localStack) {
+    free(stack);
+  }
+  return outcome;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+static FwSmBool_t MarkDest(SmBaseDesc_t* smBase, unsigned char* map, FwSmCounterS1_t dest, FwSmCounterU4_t* node) {
+  unsigned char bit;
+
+  if (dest == 0) { /* the final pseudo-state is not a node */
+    return 0;
+  }
+  if (dest > 0) {
+    *node = (FwSmCounterU4_t)(dest - 1);
+  }
+  else {
+    *node = (FwSmCounterU4_t)smBase->nOfPStates + (FwSmCounterU4_t)(-dest - 1);
+  }
+
+  bit = (unsigned char)(1U << (*node % 8));
+  if ((map[*node / 8] & bit) != 0) {
+    return 0;
+  }
+  map[*node / 8] = (unsigned char)(map[*node / 8] | bit);
+  return 1;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+FwSmErrCode_t FwSmCompile(FwSmDesc_t smDesc) {
+  FwSmErrCode_t   outcome;
+  FwSmCounterS1_t i;
+  FwSmCounterU4_t j;
+  SmBaseDesc_t*   smBase = smDesc->smBase;
+
+  outcome = FwSmCheck(smDesc);
+  if (outcome != smSuccess) {
+    return outcome;
+  }
+
+  /* The dispatch table is still valid (it may be in a read-only image, see FwSmLoadImage) */
+  if (smBase->isCompiled) {
+    return smSuccess;
+  }
+
+  if (smBase->transDisp == NULL) {
+    smBase->transDisp =
+        (FwSmCounterS1_t*)malloc(((FwSmCounterU4_t)SM_DISP_SIZE(smBase->nOfTrans)) * sizeof(FwSmCounterS1_t));
+    if (smBase->transDisp == NULL) {
+      return smOutOfMemory;
     }
   }
 
+  for (i = 0; i < smBase->nOfTrans; i++) {
+    smBase->transDisp[i] = i;
+  }
+  /* The unused locations of the direct-index section are cleared so that images do not depend on them */
+  for (j = (FwSmCounterU4_t)smBase->nOfTrans; j < (FwSmCounterU4_t)SM_DISP_SIZE(smBase->nOfTrans); j++) {
+    smBase->transDisp[j] = 0;
+  }
+
+  for (i = 0; i < smBase->nOfPStates; i++) {
+    SortTransDisp(smBase, smBase->pStates[i].outTransIndex, smBase->pStates[i].nOfOutTrans);
+    SetDirectDisp(smBase, &(smBase->pStates[i]));
+  }
+
+  smBase->isCompiled = 1;
   return smSuccess;
 }
 
+/* ----------------------------------------------------------------------------------------------------------------- */
+static void SortTransDisp(SmBaseDesc_t* smBase, FwSmCounterS1_t first, FwSmCounterS1_t n) {
+  FwSmCounterS1_t  i, j, gap, tmp;
+  FwSmCounterS1_t* disp  = &(smBase->transDisp[first]);
+  SmTrans_t*       trans = smBase->trans;
+
+  /* Shell sort with the gap sequence n/2, n/4, ..., 1 */
+  for (gap = (FwSmCounterS1_t)(n / 2); gap > 0; gap = (FwSmCounterS1_t)(gap / 2)) {
+    for (i = gap; i < n; i++) {
+      tmp = disp[i];
+      for (j = i; j >= gap; j = (FwSmCounterS1_t)(j - gap)) {
+        if (trans[disp[j - gap]].id < trans[tmp].id) {
+          break;
+        }
+        if ((trans[disp[j - gap]].id == trans[tmp].id) && (disp[j - gap] < tmp)) {
+          break;
+        }
+        disp[j] = disp[j - gap];
+      }
+      disp[j] = tmp;
+    }
+  }
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+static void SetDirectDisp(SmBaseDesc_t* smBase, SmPState_t* pState) {
+  FwSmCounterS1_t  i, end;
+  FwSmCounterU4_t  k, nOfIds;
+  FwSmCounterU2_t  minId;
+  FwSmCounterS1_t* disp = smBase->transDisp;
+  FwSmCounterS1_t* slot;
+  FwSmCounterU4_t  nOfOutTrans = (FwSmCounterU4_t)pState->nOfOutTrans;
+
+  pState->dispMinId  = 0;
+  pState->dispNOfIds = 0;
+  if ((nOfOutTrans < 1) || (nOfOutTrans < (FwSmCounterU4_t)FW_SM_DISP_MIN_DIRECT_OUT_TRANS)) {
+    return;
+  }
+
+  /* The sorted section holds the smallest identifier first and the largest one last */
+  end    = (FwSmCounterS1_t)(pState->outTransIndex + pState->nOfOutTrans);
+  minId  = smBase->trans[disp[pState->outTransIndex]].id;
+  nOfIds = (FwSmCounterU4_t)smBase->trans[disp[end - 1]].id - minId + 1;
+  if (nOfIds + 1 > 2 * nOfOutTrans) {
+    return;
+  }
+
+  slot = &(disp[(FwSmCounterU4_t)smBase->nOfTrans + 2 * (FwSmCounterU4_t)pState->outTransIndex]);
+  i    = pState->outTransIndex;
+  for (k = 0; k < nOfIds; k++) {
+    while ((i < end) && (smBase->trans[disp[i]].id < minId + k)) {
+      i++;
+    }
+    slot[k] = i;
+  }
+  slot[nOfIds] = end;
+
+  pState->dispMinId  = minId;
+  pState->dispNOfIds = (FwSmCounterU2_t)nOfIds;
+}
+
 /* ----------------------------------------------------------------------------------------------------------------- */
 FwSmErrCode_t FwSmCheckRec(FwSmDesc_t smDesc) {
   FwSmErrCode_t   outcome;
   FwSmCounterS1_t i;
 
-  /* Check all embedded state machines */
+  /* Check all embedded state machines (for a lazily embedded state machine which has not yet
+   * been instantiated, its template is checked) */
   for (i = 0; i < smDesc->smBase->nOfPStates; i++) {
     if (smDesc->esmDesc[i] != NULL) {
       outcome = FwSmCheckRec(smDesc->esmDesc[i]);
-      if (outcome != smSuccess) {
-        return outcome;
-      }
+    }
+    else if (SmIsLazy(smDesc, i)) {
+      outcome = FwSmCheckRec(smDesc->lazy->esm[i].esmBase);
+    }
+    else {
+      outcome = smSuccess;
+    }
+    if (outcome != smSuccess) {
+      return outcome;
     }
   }
 
@@ -454,14 +911,38 @@ FwSmErrCode_t FwSmCheckRec(FwSmDesc_t smDesc) {
 
 /* ----------------------------------------------------------------------------------------------------------------- */
 void FwSmOverrideAction(FwSmDesc_t smDesc, FwSmAction_t oldAction, FwSmAction_t newAction) {
-  FwSmCounterS1_t i;
+  FwSmCounterS1_t i = 1;
+  SmCfgIndex_t*   cfgIndex;
+  FwSmCounterU4_t pos;
 
   if (smDesc->transCnt != 0) {
     smDesc->errCode = smNotDerivedSM;
     return;
   }
 
-  for (i = 1; i < smDesc->nOfActions; i++) {
+  if (UnshareArrays(smDesc, SM_SHARED_ACTIONS) == 0) {
+    return;
+  }
+
+  cfgIndex = GetCfgIndex(smDesc);
+  if ((cfgIndex != NULL) && (oldAction != NULL)) {
+    pos = ProbeIndex(&(cfgIndex->actions), smDesc->smActions, sizeof(FwSmAction_t), &oldAction);
+    if (cfgIndex->actions.table[pos] != -1) {
+      smDesc->smActions[cfgIndex->actions.table[pos]] = newAction;
+      if (newAction == NULL) { /* the array now has a hole: the index is rebuilt when it is next needed */
+        free(smDesc->cfgIndex);
+        smDesc->cfgIndex = NULL;
+      }
+      else {
+        ReplaceInIndex(&(cfgIndex->actions), smDesc->smActions, sizeof(FwSmAction_t), pos, &oldAction);
+      }
+      return;
+    }
+    /* Only the locations after the first NULL location are not in the index */
+    i = cfgIndex->actions.next;
+  }
+
+  for (; i < smDesc->nOfActions; i++) {
     if (smDesc->smActions[i] == oldAction) {
       smDesc->smActions[i] = newAction;
       return;
@@ -473,16 +954,42 @@ void FwSmOverrideAction(FwSmDesc_t smDesc, FwSmAction_t oldAction, FwSmAction_t
 
 /* ----------------------------------------------------------------------------------------------------------------- */
 void FwSmOverrideGuard(FwSmDesc_t smDesc, FwSmGuard_t oldGuard, FwSmGuard_t newGuard) {
-  FwSmCounterS1_t i;
+  FwSmCounterS1_t i = 1;
+  SmCfgIndex_t*   cfgIndex;
+  FwSmCounterU4_t pos;
 
   if (smDesc->transCnt != 0) {
     smDesc->errCode = smNotDerivedSM;
     return;
   }
 
-  for (i = 1; i < smDesc->nOfGuards; i++) {
+  if (UnshareArrays(smDesc, SM_SHARED_GUARDS) == 0) {
+    return;
+  }
+
+  cfgIndex = GetCfgIndex(smDesc);
+  if ((cfgIndex != NULL) && (oldGuard != NULL)) {
+    pos = ProbeIndex(&(cfgIndex->guards), smDesc->smGuards, sizeof(FwSmGuard_t), &oldGuard);
+    if (cfgIndex->guards.table[pos] != -1) {
+      smDesc->smGuards[cfgIndex->guards.table[pos]] = newGuard;
+      ForgetGuard(smDesc, cfgIndex->guards.table[pos]);
+      if (newGuard == NULL) { /* the array now has a hole: the index is rebuilt when it is next needed */
+        free(smDesc->cfgIndex);
+        smDesc->cfgIndex = NULL;
+      }
+      else {
+        ReplaceInIndex(&(cfgIndex->guards), smDesc->smGuards, sizeof(FwSmGuard_t), pos, &oldGuard);
+      }
+      return;
+    }
+    /* Only the locations after the first NULL location are not in the index */
+    i = cfgIndex->guards.next;
+  }
+
+  for (; i < smDesc->nOfGuards; i++) {
     if (smDesc->smGuards[i] == oldGuard) {
       smDesc->smGuards[i] = newGuard;
+      ForgetGuard(smDesc, i);
       return;
     }
   }
@@ -490,6 +997,268 @@ void FwSmOverrideGuard(FwSmDesc_t smDesc, FwSmGuard_t oldGuard, FwSmGuard_t newG
   smDesc->errCode = smUndefGuard;
 }
 
+/* ----------------------------------------------------------------------------------------------------------------- */
+FwSmErrCode_t FwSmSetGuardPure(FwSmDesc_t smDesc, FwSmGuard_t guard, FwSmBool_t isPure) {
+  FwSmCounterS1_t i;
+  FwSmBool_t      isFound = 0;
+
+  /* Location 0 holds the dummy guard which is never marked */
+  for (i = 1; i < smDesc->nOfGuards; i++) {
+    if ((smDesc->smGuards[i] == guard) && (guard != NULL)) {
+      isFound = 1;
+    }
+  }
+  if (isFound == 0) {
+    return smUndefGuard;
+  }
+
+  /* The guard memo is only allocated when a guard is first marked as pure */
+  if ((isPure != 0) && (GetGuardMemo(smDesc) == NULL)) {
+    return smOutOfMemory;
+  }
+
+  /* The same guard may be held in more than one location of a derived state machine */
+  for (i = 1; i < smDesc->nOfGuards; i++) {
+    if (smDesc->smGuards[i] == guard) {
+      MarkGuardPure(smDesc, i, isPure);
+    }
+  }
+  return smSuccess;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+static void MarkGuardPure(FwSmDesc_t smDesc, FwSmCounterS1_t iGuard, FwSmBool_t isPure) {
+  SmGuardMemo_t*  memo  = smDesc->memo;
+  FwSmCounterU4_t iByte = ((FwSmCounterU4_t)iGuard) / 8;
+  FwSmCounterU1_t bit   = (FwSmCounterU1_t)(1U << (((FwSmCounterU4_t)iGuard) % 8));
+
+  if (memo == NULL) {
+    return;
+  }
+  if (isPure != 0) {
+    memo->pure[iByte] = (FwSmCounterU1_t)(memo->pure[iByte] | bit);
+  }
+  else {
+    memo->pure[iByte] = (FwSmCounterU1_t)(memo->pure[iByte] & ~bit);
+  }
+  memo->cached[iByte] = (FwSmCounterU1_t)(memo->cached[iByte] & ~bit);
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+FwSmErrCode_t FwSmSetGuardDecl(FwSmDesc_t smDesc, FwSmGuard_t guard, FwSmGuardOpnd_t opnd, FwSmCounterU4_t offset,
+                               FwSmGuardOp_t op, long value) {
+  FwSmCounterS1_t i;
+  SmGuardMemo_t*  memo    = smDesc->memo;
+  FwSmBool_t      isFound = 0;
+
+  /* Location 0 holds the dummy guard which is never declared */
+  for (i = 1; i < smDesc->nOfGuards; i++) {
+    if ((smDesc->smGuards[i] == guard) && (guard != NULL)) {
+      isFound = 1;
+    }
+  }
+  if (isFound == 0) {
+    return smUndefGuard;
+  }
+
+  /* The guard memo is only allocated when a guard is first declared */
+  if (opnd != smGuardOpndNone) {
+    memo = GetGuardMemo(smDesc);
+    if (memo == NULL) {
+      return smOutOfMemory;
+    }
+  }
+  if (memo == NULL) {
+    return smSuccess;
+  }
+
+  /* The same guard may be held in more than one location of a derived state machine */
+  for (i = 1; i < smDesc->nOfGuards; i++) {
+    if (smDesc->smGuards[i] == guard) {
+      memo->decl[i].opnd   = opnd;
+      memo->decl[i].op     = op;
+      memo->decl[i].offset = offset;
+      memo->decl[i].value  = value;
+    }
+  }
+  return smSuccess;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+static SmGuardMemo_t* GetGuardMemo(FwSmDesc_t smDesc) {
+  SmGuardMemo_t*  memo;
+  FwSmCounterU4_t nOfGuards = (FwSmCounterU4_t)(smDesc->nOfGuards);
+  FwSmCounterU4_t nOfBytes  = (nOfGuards + 7) / 8;
+  FwSmCounterU4_t i;
+
+  if (smDesc->memo != NULL) {
+    return smDesc->memo;
+  }
+
+  /* The declarations follow the memo structure and the bitmasks follow the declarations */
+  memo = (SmGuardMemo_t*)malloc(sizeof(SmGuardMemo_t) + nOfGuards * sizeof(SmGuardDecl_t) + 3 * nOfBytes);
+  if (memo == NULL) {
+    return NULL;
+  }
+  memo->decl     = (SmGuardDecl_t*)(void*)(memo + 1);
+  memo->pure     = (FwSmCounterU1_t*)(void*)(memo->decl + nOfGuards);
+  memo->cached   = memo->pure + nOfBytes;
+  memo->value    = memo->cached + nOfBytes;
+  memo->nOfBytes = nOfBytes;
+  memo->isCached = 0;
+  memset(memo->pure, 0, 3 * nOfBytes);
+  for (i = 0; i < nOfGuards; i++) {
+    memo->decl[i].opnd   = smGuardOpndNone;
+    memo->decl[i].op     = smGuardEq;
+    memo->decl[i].offset = 0;
+    memo->decl[i].value  = 0;
+  }
+  smDesc->memo = memo;
+  return memo;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+static void ForgetGuard(FwSmDesc_t smDesc, FwSmCounterS1_t iGuard) {
+  MarkGuardPure(smDesc, iGuard, 0);
+  if (smDesc->memo != NULL) {
+    smDesc->memo->decl[iGuard].opnd = smGuardOpndNone;
+  }
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+static SmCfgIndex_t* GetCfgIndex(FwSmDesc_t smDesc) {
+  SmCfgIndex_t*   cfgIndex;
+  FwSmCounterU4_t actSize = 1;
+  FwSmCounterU4_t grdSize = 1;
+  FwSmCounterU4_t i;
+  FwSmAction_t    nullAction = NULL;
+  FwSmGuard_t     nullGuard  = NULL;
+
+  if (smDesc->cfgIndex != NULL) {
+    return smDesc->cfgIndex;
+  }
+  if ((smDesc->nOfActions + smDesc->nOfGuards) < FW_SM_CFG_INDEX_MIN) {
+    return NULL;
+  }
+
+  /* The hash tables are at most half full */
+  while (actSize < 2 * (FwSmCounterU4_t)(smDesc->nOfActions)) {
+    actSize = 2 * actSize;
+  }
+  while (grdSize < 2 * (FwSmCounterU4_t)(smDesc->nOfGuards)) {
+    grdSize = 2 * grdSize;
+  }
+  cfgIndex = (SmCfgIndex_t*)malloc(sizeof(SmCfgIndex_t) + (actSize + grdSize) * sizeof(FwSmCounterS1_t));
+  if (cfgIndex == NULL) {
+    return NULL;
+  }
+
+  cfgIndex->actions.table = (FwSmCounterS1_t*)(void*)(cfgIndex + 1);
+  cfgIndex->guards.table  = cfgIndex->actions.table + actSize;
+  for (i = 0; i < actSize + grdSize; i++) {
+    cfgIndex->actions.table[i] = -1;
+  }
+  cfgIndex->actions.size   = actSize;
+  cfgIndex->actions.first  = 1;
+  cfgIndex->actions.next   = 1;
+  cfgIndex->actions.hasDup = 0;
+  cfgIndex->guards.size    = grdSize;
+  cfgIndex->guards.first   = 1;
+  cfgIndex->guards.next    = 1;
+  cfgIndex->guards.hasDup  = 0;
+  AdvanceIndex(&(cfgIndex->actions), smDesc->smActions, sizeof(FwSmAction_t), smDesc->nOfActions, &nullAction);
+  AdvanceIndex(&(cfgIndex->guards), smDesc->smGuards, sizeof(FwSmGuard_t), smDesc->nOfGuards, &nullGuard);
+
+  smDesc->cfgIndex = cfgIndex;
+  return cfgIndex;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+static FwSmCounterU4_t HashFunc(const void* key, size_t size) {
+  const unsigned char* bytes = (const unsigned char*)key;
+  FwSmCounterU4_t      hash  = 2166136261UL; /* FNV-1a hash of the bytes of the function pointer */
+  size_t               i;
+
+  for (i = 0; i < size; i++) {
+    hash = (hash ^ bytes[i]) * 16777619UL;
+  }
+  return hash;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+static void AdvanceIndex(SmFuncIndex_t* index, const void* array, size_t elemSize, FwSmCounterS1_t n,
+                         const void* nullKey) {
+  const unsigned char* base = (const unsigned char*)array;
+
+  while ((index->next < n) && (memcmp(base + ((size_t)index->next) * elemSize, nullKey, elemSize) != 0)) {
+    InsertInIndex(index, array, elemSize, index->next);
+    index->next++;
+  }
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+static FwSmCounterU4_t ProbeIndex(SmFuncIndex_t* index, const void* array, size_t elemSize, const void* key) {
+  const unsigned char* base = (const unsigned char*)array;
+  FwSmCounterU4_t      mask = index->size - 1;
+  FwSmCounterU4_t      pos  = HashFunc(key, elemSize) & mask;
+
+  while ((index->table[pos] != -1) && (memcmp(base + ((size_t)index->table[pos]) * elemSize, key, elemSize) != 0)) {
+    pos = (pos + 1) & mask;
+  }
+  return pos;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+static void InsertInIndex(SmFuncIndex_t* index, const void* array, size_t elemSize, FwSmCounterS1_t loc) {
+  const unsigned char* base = (const unsigned char*)array;
+  FwSmCounterU4_t      pos  = ProbeIndex(index, array, elemSize, base + ((size_t)loc) * elemSize);
+
+  if (index->table[pos] == -1) {
+    index->table[pos] = loc;
+  }
+  else {
+    index->hasDup = 1;
+    if (loc < index->table[pos]) {
+      index->table[pos] = loc;
+    }
+  }
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+static void ReplaceInIndex(SmFuncIndex_t* index, const void* array, size_t elemSize, FwSmCounterU4_t pos,
+                           const void* oldKey) {
+  const unsigned char* base = (const unsigned char*)array;
+  FwSmCounterU4_t      mask = index->size - 1;
+  FwSmCounterU4_t      next = (pos + 1) & mask;
+  FwSmCounterU4_t      home;
+  FwSmCounterS1_t      loc = index->table[pos];
+  FwSmCounterS1_t      i;
+
+  /* Remove the entry and move back the entries after it which would no longer be found */
+  index->table[pos] = -1;
+  while (index->table[next] != -1) {
+    home = HashFunc(base + ((size_t)index->table[next]) * elemSize, elemSize) & mask;
+    if (((pos - home) & mask) < ((next - home) & mask)) {
+      index->table[pos]  = index->table[next];
+      index->table[next] = -1;
+      pos                = next;
+    }
+    next = (next + 1) & mask;
+  }
+
+  /* If the old function pointer may be stored in a later location, that location is now its first one */
+  if (index->hasDup != 0) {
+    for (i = (FwSmCounterS1_t)(loc + 1); i < index->next; i++) {
+      if (memcmp(base + ((size_t)i) * elemSize, oldKey, elemSize) == 0) {
+        InsertInIndex(index, array, elemSize, i);
+        break;
+      }
+    }
+  }
+
+  InsertInIndex(index, array, elemSize, loc);
+}
+
 /* ----------------------------------------------------------------------------------------------------------------- */
 void FwSmEmbed(FwSmDesc_t smDesc, FwSmCounterS1_t stateId, FwSmDesc_t esmDesc) {
 
@@ -508,11 +1277,15 @@ void FwSmEmbed(FwSmDesc_t smDesc, FwSmCounterS1_t stateId, FwSmDesc_t esmDesc) {
     return;
   }
 
-  if (smDesc->esmDesc[stateId - 1] != NULL) {
+  if ((smDesc->esmDesc[stateId - 1] != NULL) || SmIsLazy(smDesc, (FwSmCounterS1_t)(stateId - 1))) {
     smDesc->errCode = smEsmDefined;
     return;
   }
 
+  if (UnshareArrays(smDesc, SM_SHARED_ESM) == 0) {
+    return;
+  }
+
   smDesc->esmDesc[stateId - 1] = esmDesc;
   return;
 }
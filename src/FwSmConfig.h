@@ -27,6 +27,10 @@
  *    functions, one for each type of transition source and destination).
  * -# The pointer to the state machine data in the state machine descriptor
  *    is set with the <code>::FwSmSetData</code> function.
+ * -# The guards of the state machine may be marked as pure with the
+ *    <code>::FwSmSetGuardPure</code> function. Use of this function is optional.
+ * -# The guards of the state machine may be declared as comparisons with the
+ *    <code>::FwSmSetGuardDecl</code> function. Use of this function is optional.
  * -# The consistency and completeness of the state machine configuration may
  *    be verified with function <code>::FwSmCheck</code> or
  *    <code>::FwSmCheckRec</code>. Use of this function is optional.
@@ -40,6 +44,8 @@
  * -# An action (either a state or a transition action) can be overridden
  *    with the <code>::FwSmOverrideAction</code> function.
  * -# A guard can be overridden with the <code>::FwSmOverrideGuard</code> function.
+ * -# A guard can be marked as pure with the <code>::FwSmSetGuardPure</code> function.
+ * -# A guard can be declared as a comparison with the <code>::FwSmSetGuardDecl</code> function.
  * -# A state machine can be embedded in the state of the derived state
  *    machine with the <code>::FwSmEmbed</code> function.
  * -# The consistency and completeness of the configuration of the derived
@@ -377,6 +383,10 @@ void FwSmAddTransCpsToFps(FwSmDesc_t smDesc, FwSmCounterS1_t srcId, FwSmAction_t
  * -# Check that all states are reachable (i.e. they are at the end of at least one transition).
  * -# Check that all choice pseudo-states are reachable (i.e. they are at the end of at least
  *    one transition).
+ * -# Check that all states can be reached from the initial pseudo-state (if this is the
+ *    case, all choice pseudo-states which pass check 10 can also be reached from the initial
+ *    pseudo-state because the transitions into a choice pseudo-state start either from the
+ *    initial pseudo-state or from a state).
  * .
  * Note that there are configuration errors which are not covered by this function because
  * they cannot occur if the state machine is configured using the functions declared in
@@ -386,6 +396,11 @@ void FwSmAddTransCpsToFps(FwSmDesc_t smDesc, FwSmCounterS1_t srcId, FwSmAction_t
  * - Defining a transition which has a choice pseudo-state as both source and destination
  *   of the transition.
  * .
+ * This function never modifies the base descriptor of the state machine (which may be
+ * a constant base descriptor or be located in a read-only image).
+ * Its only side effect is on the state machine descriptor: if all checks are passed,
+ * the configuration index of the state machine (see <code>#FW_SM_CFG_INDEX_MIN</code>)
+ * is released.
  * @param smDesc the descriptor of the state machine to be checked.
  * @return the outcome of the check. The outcome of the check is one of the following:
  * - #smSuccess: all checks have been passed.
@@ -399,12 +414,62 @@ void FwSmAddTransCpsToFps(FwSmDesc_t smDesc, FwSmCounterS1_t srcId, FwSmAction_t
  * - #smTooFewGuards: check 8 has failed
  * - #smUnreachablePState: check 9 has failed
  * - #smUnreachableCState: check 10 has failed
+ * - #smDisconnectedPState: check 11 has failed
+ * - #smOutOfMemory: the state machine has more than 64 states and choice pseudo-states
+ *   and the memory for checks 9 to 11 could not be allocated
  * .
  * This function returns when it encounters the first error. Hence, the function return value
  * is determined by the first error encountered by the function.
  */
 FwSmErrCode_t FwSmCheck(FwSmDesc_t smDesc);
 
+/**
+ * Check the configuration of a state machine and build its transition dispatch table.
+ * This function first checks the state machine configuration with function
+ * <code>::FwSmCheck</code>.
+ * If the check is successful, the function builds the transition dispatch table
+ * of the state machine (see <code>::SmBaseDesc_t</code>) and marks the state machine
+ * as "compiled".
+ * The transition dispatch table sorts the transitions out of each state by their
+ * identifier so that <code>::FwSmMakeTrans</code> can locate the transitions which
+ * match a trigger without a linear scan.
+ * If the identifiers of the transitions out of a state with at least
+ * <code>#FW_SM_DISP_MIN_DIRECT_OUT_TRANS</code> out-going transitions lie in a range
+ * which is not larger than twice the number of these transitions, the transitions
+ * which match a trigger are located through a direct index on the trigger
+ * identifier.
+ * Otherwise, they are located through a binary search if the state has at least
+ * <code>#FW_SM_DISP_MIN_OUT_TRANS</code> out-going transitions, and through the same
+ * linear scan as in a non-compiled state machine if it has fewer.
+ * The order in which transitions with the same identifier are evaluated is not
+ * affected (i.e. it remains the order in which they were added to the state machine).
+ * Hence, a compiled state machine has the same behaviour as a non-compiled one.
+ *
+ * The transition dispatch table is part of the base descriptor of the state machine.
+ * Calling this function on a derived state machine therefore compiles the base
+ * state machine and all the other state machines derived from it.
+ * If the state machine descriptor was created dynamically, the dispatch table is
+ * allocated by this function (if it was not already allocated) and it is released
+ * by <code>::FwSmRelease</code>.
+ * If the state machine descriptor was instantiated statically, the dispatch table
+ * is allocated by the instantiation macro.
+ *
+ * Use of this function is optional.
+ * It should be called after the configuration of the state machine has been completed.
+ * If, after the state machine has been compiled, a state or transition is added to it,
+ * the state machine reverts to the non-compiled mode and must be compiled again.
+ *
+ * This function only compiles the argument state machine.
+ * Embedded state machines must be compiled separately.
+ * @param smDesc the descriptor of the state machine to be compiled.
+ * @return the outcome of the compilation. This is either the outcome of
+ * <code>::FwSmCheck</code> (if the check failed) or:
+ * - #smSuccess: the state machine has been compiled.
+ * - #smOutOfMemory: the memory for the dispatch table could not be allocated.
+ * .
+ */
+FwSmErrCode_t FwSmCompile(FwSmDesc_t smDesc);
+
 /**
  * Recursively check the configuration of a state machine and all its embedded state
  * machines.
@@ -414,6 +479,9 @@ FwSmErrCode_t FwSmCheck(FwSmDesc_t smDesc);
  * outer state machine and its embedded state machine.
  * Thus, the error reported by this function may have arisen either in the outer
  * state machine or in one of its embedded state machines.
+ * For a state whose embedded state machine is lazily instantiated (see
+ * <code>::FwSmEmbedLazy</code>) and has not yet been instantiated, the template of the
+ * embedded state machine is checked.
  * @param smDesc the descriptor of the state machine to be checked.
  * @return the outcome of the check (this is the same as for <code>::FwSmCheck</code>).
  */
@@ -493,6 +561,103 @@ void FwSmOverrideAction(FwSmDesc_t smDesc, FwSmAction_t oldAction, FwSmAction_t
  */
 void FwSmOverrideGuard(FwSmDesc_t smDesc, FwSmGuard_t oldGuard, FwSmGuard_t newGuard);
 
+/**
+ * Mark a guard of a state machine as pure (or remove the mark).
+ * A guard is pure if its outcome only depends on data which are not modified
+ * while the state machine processes a transition command, except by the actions
+ * of the state machine itself.
+ * The outcome of a pure guard is cached when the guard is first evaluated
+ * while the state machine processes a transition command (see
+ * <code>::FwSmMakeTrans</code>) and the cached outcome is used if the same guard
+ * is evaluated again, for instance because it is attached to several transitions
+ * out of the current state or to transitions out of a choice pseudo-state.
+ * The cached outcomes are discarded when an action of the state machine (other
+ * than the dummy action) is executed, when one of its embedded state machines is
+ * stopped and when the processing of the transition command is completed.
+ * Hence, a pure guard is called at most once between two executions of an
+ * action of the state machine.
+ *
+ * The guard outcomes are cached in a <i>guard memo</i> which is attached to the
+ * state machine descriptor.
+ * The guard memo holds three bitmasks with one bit for each guard of the state
+ * machine.
+ * It is allocated by this function when a guard is first marked as pure (or by
+ * <code>::FwSmSetGuardDecl</code> when a guard is first declared) and it
+ * is released when the state machine is released.
+ * A state machine where no guard has been marked as pure or declared has no guard memo
+ * and its guards are always called.
+ *
+ * The mark applies to all transitions of the state machine which have the argument
+ * guard.
+ * It only applies to the argument state machine: it is neither inherited by the
+ * state machines derived from it nor is it propagated to its embedded state machines.
+ * The mark of a guard is removed when the guard is overridden with
+ * <code>::FwSmOverrideGuard</code>.
+ * Since the state machine must already hold the guard, this function should be
+ * called after the transitions of the state machine have been added.
+ * @param smDesc the descriptor of the state machine.
+ * @param guard the guard to be marked.
+ * @param isPure 1 if the guard is to be marked as pure, 0 if its mark is to be removed.
+ * @return the outcome of the operation:
+ * - #smSuccess: the guard has been marked (or its mark has been removed).
+ * - #smUndefGuard: the guard does not exist in the state machine.
+ * - #smOutOfMemory: the memory for the guard memo could not be allocated.
+ * .
+ */
+FwSmErrCode_t FwSmSetGuardPure(FwSmDesc_t smDesc, FwSmGuard_t guard, FwSmBool_t isPure);
+
+/**
+ * Declare a guard of a state machine as a comparison of an operand with a constant.
+ * Most guards are simple comparisons such as "the field x of the state machine data is
+ * greater than 10" or "the state has been executed at least N times".
+ * Once such a guard has been declared, the state machine evaluates the comparison
+ * directly instead of calling the guard function.
+ * The declarative guard is true if "operand operator constant" holds where the
+ * operand is one of the following (see <code>::FwSmGuardOpnd_t</code>):
+ * - an <code>int</code> or a <code>long</code> field of the state machine data which is
+ *   located <code>offset</code> bytes after the start of the data (the offset is normally
+ *   obtained with the <code>offsetof</code> macro);
+ * - the state execution counter (see <code>::FwSmGetStateExecCnt</code>);
+ * - the execution counter of the state machine (see <code>::FwSmGetExecCnt</code>).
+ * .
+ * The guard function remains registered in the state machine and it must implement
+ * the same comparison as the declaration: the declaration is only an optimization and
+ * the functions which do not execute the state machine (e.g. the functions of
+ * <code>FwSmAux.h</code>) continue to use the guard function.
+ * As for a pure guard, a state machine with a declarative guard cannot be flattened
+ * (see <code>::FwSmFlatCreate</code>).
+ * The offset is not checked: the state machine data must hold a field of the declared
+ * type at the declared offset whenever the guard is evaluated.
+ *
+ * The declarations are held in the guard memo of the state machine (see
+ * <code>::FwSmSetGuardPure</code>) which is allocated by this function if it does not
+ * exist.
+ * A declarative guard is evaluated every time it is needed: whether it is also marked
+ * as pure has no effect.
+ * The declaration applies to all transitions of the state machine which have the
+ * argument guard.
+ * It only applies to the argument state machine: it is neither inherited by the
+ * state machines derived from it nor is it propagated to its embedded state machines.
+ * The declaration of a guard is removed when the guard is overridden with
+ * <code>::FwSmOverrideGuard</code>.
+ * Since the state machine must already hold the guard, this function should be
+ * called after the transitions of the state machine have been added.
+ * @param smDesc the descriptor of the state machine.
+ * @param guard the guard to be declared.
+ * @param opnd the operand of the guard (#smGuardOpndNone removes the declaration of the guard).
+ * @param offset the offset in bytes of the operand in the state machine data (this is
+ * only used if the operand is a field of the state machine data).
+ * @param op the comparison operator.
+ * @param value the constant against which the operand is compared.
+ * @return the outcome of the operation:
+ * - #smSuccess: the guard has been declared (or its declaration has been removed).
+ * - #smUndefGuard: the guard does not exist in the state machine.
+ * - #smOutOfMemory: the memory for the guard memo could not be allocated.
+ * .
+ */
+FwSmErrCode_t FwSmSetGuardDecl(FwSmDesc_t smDesc, FwSmGuard_t guard, FwSmGuardOpnd_t opnd, FwSmCounterU4_t offset,
+                               FwSmGuardOp_t op, long value);
+
 /**
  * Embed a state machine in a state of a derived state machine.
  * By default a derived state machine has the same embedded state machines as
@@ -522,8 +687,9 @@ void FwSmOverrideGuard(FwSmDesc_t smDesc, FwSmGuard_t oldGuard, FwSmGuard_t newG
  * - #smUndefGuard: the action to be overridden does not exist
  * - #smIllStateId: the state identifier is illegal
  * - #smNotDerivedSM: the state machine is a base state machine
- * - #smEsmDefined: an embedded state machine is already defined for the target
- *   state
+ * - #smEsmDefined: an embedded state machine (or the template of a lazily embedded
+ *   state machine, see <code>::FwSmEmbedLazy</code>) is already defined for the
+ *   target state
  * .
  * @param smDesc the descriptor of the derived state machine.
  * @param stateId the identifier of the state where the state machine is to be
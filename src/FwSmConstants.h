@@ -31,6 +31,62 @@
  */
 typedef struct FwSmDesc* FwSmDesc_t;
 
+/**
+ * Forward declaration for the pointer to a state machine group descriptor.
+ * A state machine group holds a set of state machines which share the same base
+ * descriptor and which are executed together (see <code>FwSmGroup.h</code>).
+ * The internal definition of the state machine group descriptor (see
+ * <code>FwSmPrivate.h</code>) is kept hidden from users.
+ */
+typedef struct FwSmGroup* FwSmGroupDesc_t;
+
+/**
+ * Forward declaration for the pointer to a state machine pool descriptor.
+ * A state machine pool holds a set of pre-allocated state machines derived from
+ * the same state machine (see <code>FwSmPool.h</code>).
+ * The internal definition of the state machine pool descriptor (see
+ * <code>FwSmPrivate.h</code>) is kept hidden from users.
+ */
+typedef struct FwSmPool* FwSmPoolDesc_t;
+
+/**
+ * Forward declaration for the pointer to a state machine event queue descriptor.
+ * A state machine event queue holds the transition commands which are posted to a
+ * state machine until they are dispatched to it (see <code>FwSmQueue.h</code>).
+ * The internal definition of the state machine event queue descriptor (see
+ * <code>FwSmPrivate.h</code>) is kept hidden from users.
+ */
+typedef struct FwSmQueue* FwSmQueueDesc_t;
+
+/**
+ * Forward declaration for the pointer to a flat state machine descriptor.
+ * A flat state machine holds the configuration space of a hierarchy of state machines
+ * as a single table which is used to execute the hierarchy (see <code>FwSmFlat.h</code>).
+ * The internal definition of the flat state machine descriptor (see
+ * <code>FwSmPrivate.h</code>) is kept hidden from users.
+ */
+typedef struct FwSmFlat* FwSmFlatDesc_t;
+
+/**
+ * Forward declaration for the pointer to a state machine broadcast registry descriptor.
+ * A broadcast registry holds a set of state machines to which transition commands are
+ * broadcast and it tracks which of them can react to each broadcast transition command
+ * (see <code>FwSmBcast.h</code>).
+ * The internal definition of the broadcast registry descriptor (see
+ * <code>FwSmPrivate.h</code>) is kept hidden from users.
+ */
+typedef struct FwSmBcast* FwSmBcastDesc_t;
+
+/**
+ * Forward declaration for the pointer to a state machine offload descriptor.
+ * A state machine offload descriptor executes actions of state machines asynchronously
+ * on a RT Container and sends completion triggers back to the state machines (see
+ * <code>FwSmAsync.h</code>).
+ * The internal definition of the state machine offload descriptor (see
+ * <code>FwSmPrivate.h</code>) is kept hidden from users.
+ */
+typedef struct FwSmAsync* FwSmAsyncDesc_t;
+
 /**
  * Type for a pointer to a state machine action.
  * A state machine action is a function which encapsulates one of the following:
@@ -75,8 +131,241 @@ typedef unsigned int FwSmCounterU3_t;
 /** Type used for unsigned counters with a "long int" range. */
 typedef long unsigned int FwSmCounterU4_t;
 
+/**
+ * Type for a pointer to the function which provides the time stamps used by the
+ * profiling mode of a state machine (see <code>::FwSmEnableProfile</code>).
+ * The unit of the time stamps is defined by the user (e.g. processor cycles).
+ */
+typedef FwSmCounterU4_t (*FwSmProfileClock_t)(void);
+
+/**
+ * Type for the name of a state machine action or guard which is used by the
+ * code generator of the state machine module (see <code>::FwSmGenerateCode</code>).
+ * Each instance associates the name of a C function to a pointer to an action or
+ * to a guard (the other pointer is NULL).
+ */
+typedef struct {
+  /** the pointer to the action (or NULL if the name is the name of a guard) */
+  FwSmAction_t action;
+  /** the pointer to the guard (or NULL if the name is the name of an action) */
+  FwSmGuard_t guard;
+  /** the name of the C function which implements the action or guard */
+  const char* name;
+} FwSmFuncName_t;
+
+/**
+ * Type for the change list of the change notification mode of state machines (see
+ * <code>::FwSmEnableNotify</code>).
+ * A change list holds the descriptors of the state machines whose current state (or
+ * the current state of one of whose embedded state machines) has changed since the
+ * change list was last cleared.
+ * The buffer which holds the descriptors is provided by the user.
+ * A change list is initialized with <code>::FwSmInitChangeList</code> and it is
+ * cleared with <code>::FwSmClearChangeList</code>.
+ * Its fields may be read by the user but they should only be modified through these
+ * two functions.
+ */
+typedef struct {
+  /** the buffer holding the descriptors of the state machines which have changed */
+  FwSmDesc_t* smDescs;
+  /** the number of descriptors which can be held in the buffer */
+  FwSmCounterU4_t size;
+  /** the number of descriptors in the change list */
+  FwSmCounterU4_t nOfChanged;
+  /** the number of state machines which have changed but could not be added to the full change list */
+  FwSmCounterU4_t nOfLost;
+} FwSmChangeList_t;
+
+/**
+ * Type for the cost annotation of a state machine action or guard which is used by
+ * the step cost analysis of the state machine module (see <code>FwSmCost.h</code>).
+ * Each instance associates a cost to a pointer to an action or to a guard (the other
+ * pointer is NULL).
+ * The unit of the cost is defined by the user (e.g. processor cycles or microseconds).
+ */
+typedef struct {
+  /** the pointer to the action (or NULL if the annotation is for a guard) */
+  FwSmAction_t action;
+  /** the pointer to the guard (or NULL if the annotation is for an action) */
+  FwSmGuard_t guard;
+  /** the cost of one execution of the action or guard */
+  FwSmCounterU4_t cost;
+} FwSmCostAnnot_t;
+
+/**
+ * Type for the worst-case cost of a step of a state machine which is computed by the
+ * step cost analysis of the state machine module (see <code>FwSmCost.h</code>).
+ * Each field is an upper bound of its own: the bounds of different fields may be
+ * reached along different execution paths.
+ */
+typedef struct {
+  /** the maximum number of actions which are executed (including the dummy action) */
+  FwSmCounterU4_t nOfActions;
+  /** the maximum number of guards which are evaluated (including the dummy guard) */
+  FwSmCounterU4_t nOfGuards;
+  /** the maximum depth of the chain of nested state machines whose actions or guards are executed */
+  FwSmCounterU4_t nOfLevels;
+  /** the maximum sum of the costs of the actions and guards which are executed */
+  FwSmCounterU4_t cost;
+} FwSmCost_t;
+
+/**
+ * Type for the operand of a declarative guard of a state machine (see
+ * <code>::FwSmSetGuardDecl</code>).
+ */
+typedef enum {
+  /** the guard has no declaration (the guard function is called) */
+  smGuardOpndNone = 0,
+  /** an <code>int</code> field of the state machine data */
+  smGuardOpndInt = 1,
+  /** a <code>long</code> field of the state machine data */
+  smGuardOpndLong = 2,
+  /** the state execution counter of the state machine */
+  smGuardOpndStateExecCnt = 3,
+  /** the execution counter of the state machine */
+  smGuardOpndSmExecCnt = 4
+} FwSmGuardOpnd_t;
+
+/**
+ * Type for the comparison operator of a declarative guard of a state machine (see
+ * <code>::FwSmSetGuardDecl</code>).
+ * The guard is true if "operand operator constant" holds.
+ */
+typedef enum {
+  /** the operand is smaller than the constant */
+  smGuardLt = 0,
+  /** the operand is smaller than or equal to the constant */
+  smGuardLe = 1,
+  /** the operand is equal to the constant */
+  smGuardEq = 2,
+  /** the operand is not equal to the constant */
+  smGuardNe = 3,
+  /** the operand is greater than or equal to the constant */
+  smGuardGe = 4,
+  /** the operand is greater than the constant */
+  smGuardGt = 5
+} FwSmGuardOp_t;
+
+/**
+ * Width in bits of the signed counters with a "short" range.
+ * The signed counters with a "short" range (type <code>::FwSmCounterS1_t</code>) are
+ * used to hold the number of states, choice pseudo-states, transitions, actions and guards in a state machine and to index them.
+ * Their width therefore determines the maximum size of a state machine.
+ * The width can be selected at build time by defining this symbol as either 8, 16 or 32
+ * (for instance, through the <code>-D</code> option of the compiler).
+ * The default value of 8 bits gives the most compact memory layout and is intended for
+ * small targets.
+ * The library and the applications which use it must be built with the same value.
+ */
+#ifndef FW_SM_INDEX_WIDTH
+#define FW_SM_INDEX_WIDTH 8
+#endif
+
+#if (FW_SM_INDEX_WIDTH == 8)
 /** Type used for signed counters with a "short" range. */
 typedef signed char FwSmCounterS1_t;
+/** Maximum value of a signed counter with a "short" range. */
+#define FW_SM_COUNTER_S1_MAX 127
+#elif (FW_SM_INDEX_WIDTH == 16)
+/** Type used for signed counters with a "short" range. */
+typedef short int FwSmCounterS1_t;
+/** Maximum value of a signed counter with a "short" range. */
+#define FW_SM_COUNTER_S1_MAX 32767
+#elif (FW_SM_INDEX_WIDTH == 32)
+/** Type used for signed counters with a "short" range. */
+typedef int FwSmCounterS1_t;
+/** Maximum value of a signed counter with a "short" range. */
+#define FW_SM_COUNTER_S1_MAX 2147483647
+#else
+#error "FW_SM_INDEX_WIDTH must be either 8, 16 or 32"
+#endif
+
+/**
+ * Maximum depth of nesting of embedded state machines which is handled iteratively.
+ * Functions <code>::FwSmMakeTrans</code> and <code>::FwSmStop</code> walk the chain of
+ * active embedded state machines with an explicit stack of this size (the
+ * top-level state machine counts as one level).
+ * If the chain is deeper than this value, the remaining levels are handled through
+ * a recursive call.
+ * The value can be overridden at build time and must be a positive integer.
+ */
+#ifndef FW_SM_MAX_NESTING
+#define FW_SM_MAX_NESTING 8
+#endif
+
+/**
+ * Minimum number of out-going transitions of a state for which the binary search in
+ * the transition dispatch table is used.
+ * Function <code>::FwSmMakeTrans</code> locates the transitions which match a trigger
+ * out of a state of a compiled state machine (see <code>::FwSmCompile</code>) which
+ * does not use the direct index (see <code>#FW_SM_DISP_MIN_DIRECT_OUT_TRANS</code>)
+ * through a binary search in the transition dispatch table only if the state has at
+ * least this number of out-going transitions.
+ * For states with fewer out-going transitions, a linear scan of the transition array
+ * is at least as fast and is used instead.
+ * The default value was measured on a one-state state machine with N self-transitions
+ * with distinct identifiers triggered in a non-sequential order (benchmark cases
+ * <code>sm_make_trans_wide</code> and <code>sm_make_trans_out*</code>, 16-bit indices,
+ * direct index disabled): a call to <code>::FwSmMakeTrans</code> took 27 ns with the
+ * linear scan against 28 ns with the binary search for N=32, 80 ns against 34 ns for
+ * N=128 and 135 ns against 42 ns for N=250.
+ * The value can be overridden at build time (a value of 1 always uses the dispatch
+ * table of a compiled state machine).
+ */
+#ifndef FW_SM_DISP_MIN_OUT_TRANS
+#define FW_SM_DISP_MIN_OUT_TRANS 32
+#endif
+
+/**
+ * Minimum number of out-going transitions of a state for which the direct-index
+ * section of the transition dispatch table is used.
+ * Function <code>::FwSmCompile</code> builds a direct index on the trigger identifier
+ * for the states with at least this number of out-going transitions whose
+ * identifiers lie in a range which is not larger than twice the number of
+ * out-going transitions.
+ * Function <code>::FwSmMakeTrans</code> then locates the transitions which match a
+ * trigger out of these states without comparing identifiers.
+ * On the same benchmark as for <code>#FW_SM_DISP_MIN_OUT_TRANS</code>, a call to
+ * <code>::FwSmMakeTrans</code> took about 20 ns with the direct index for all values
+ * of N between 8 and 250, against 22 ns with the linear scan for N=8, 26 ns for N=16
+ * and the figures above for larger values of N (for N=4, the direct index and the
+ * linear scan took the same time).
+ * The value can be overridden at build time (a value larger than
+ * <code>#FW_SM_COUNTER_S1_MAX</code> disables the direct index).
+ */
+#ifndef FW_SM_DISP_MIN_DIRECT_OUT_TRANS
+#define FW_SM_DISP_MIN_DIRECT_OUT_TRANS 8
+#endif
+
+/**
+ * Minimum size of the action and guard arrays of a state machine for which a
+ * configuration index is used.
+ * The configuration functions which register or override actions and guards
+ * (e.g. <code>::FwSmAddState</code> or <code>::FwSmOverrideAction</code>) must
+ * check whether an action or guard is already present in the state machine.
+ * If the sum of the number of actions and of the number of guards of a state machine
+ * is at least equal to this value, these functions use a hash table which is
+ * allocated with <code>malloc</code> on first use and released when the
+ * configuration of the state machine passes <code>::FwSmCheck</code>.
+ * Otherwise (or if the allocation of the hash table fails), they scan the action
+ * and guard arrays.
+ * The value can be overridden at build time (a very large value disables the hash
+ * table).
+ */
+#ifndef FW_SM_CFG_INDEX_MIN
+#define FW_SM_CFG_INDEX_MIN 32
+#endif
+
+/**
+ * Capacity of the per-thread caches of a thread-safe state machine pool.
+ * A thread which obtains state machines from a thread-safe pool (see
+ * <code>::FwSmPoolCreate</code>) holds up to this number of free state machines
+ * in a cache which it can access without locking the pool.
+ * The value can be overridden at build time.
+ */
+#ifndef FW_SM_POOL_CACHE_SIZE
+#define FW_SM_POOL_CACHE_SIZE 16
+#endif
 
 /** Error codes and function return codes for the state machine functions. */
 typedef enum {
@@ -220,7 +509,47 @@ typedef enum {
   /**
    * The state machine has a choice pseudo-state which is not a destination of any transition
    */
-  smUnreachableCState = 50
+  smUnreachableCState = 50,
+  /**
+   * A state machine is added to a state machine group which is already full
+   * (see <code>::FwSmGroupAdd</code>).
+   */
+  smGroupFull = 51,
+  /**
+   * A state machine is added to a state machine group but it does not have the same base
+   * descriptor as the state machines in the group (see <code>::FwSmGroupAdd</code>).
+   */
+  smWrongBase = 52,
+  /**
+   * The state machine has a state which is the destination of a transition but which
+   * cannot be reached from the initial pseudo-state
+   */
+  smDisconnectedPState = 53,
+  /**
+   * A transition command is posted to a state machine event queue but the lane of the
+   * queue which should hold it is full (see <code>::FwSmQueuePost</code>).
+   */
+  smQueueFull = 54,
+  /**
+   * A state machine is added to a broadcast registry which is already full
+   * (see <code>::FwSmBcastAdd</code>).
+   */
+  smBcastFull = 55,
+  /**
+   * A state machine is added to a broadcast registry but it (or one of its embedded
+   * state machines) is already in a broadcast registry (see <code>::FwSmBcastAdd</code>).
+   */
+  smBcastBusy = 56,
+  /**
+   * An action is offloaded to a RT Container but all the jobs of the offload descriptor
+   * are in use (see <code>::FwSmAsyncRun</code>).
+   */
+  smAsyncFull = 57,
+  /**
+   * A state machine is removed from a broadcast registry but it is not at the top of
+   * a hierarchy in the registry (see <code>::FwSmBcastRemove</code>).
+   */
+  smBcastNotFound = 58
 } FwSmErrCode_t;
 
 /**
@@ -17,7 +17,37 @@
 
 #include "FwSmCore.h"
 #include "FwSmPrivate.h"
+#include "FwTrace.h"
 #include <stdlib.h>
+#include <string.h>
+
+/**
+ * One level in the chain of active state machines which is walked by the
+ * iterative implementation of <code>::FwSmMakeTrans</code> and <code>::FwSmStop</code>.
+ */
+typedef struct {
+  /** The state machine at this level. */
+  FwSmDesc_t smDesc;
+  /** The current state of the state machine at this level. */
+  SmPState_t* curState;
+  /** The state machine embedded in the current state (or NULL if there is none). */
+  FwSmDesc_t esmDesc;
+} SmLevel_t;
+
+/**
+ * The chain of active state machines which is walked by the iterative implementation
+ * of <code>::FwSmMakeTrans</code>.
+ * The chain is resolved when a transition command is processed and it remains valid
+ * until a transition is fired in one of its state machines.
+ */
+typedef struct {
+  /** The levels of the chain (the first level holds the top-level state machine). */
+  SmLevel_t level[FW_SM_MAX_NESTING];
+  /** The number of levels in the chain. */
+  int nOfLevels;
+  /** Flag indicating whether the levels of the chain have been resolved. */
+  FwSmBool_t isResolved;
+} SmChain_t;
 
 /**
  *  Private helper function implementing the transition logic from the point where the
@@ -31,11 +61,115 @@
  *    destination of the same transition.
  *  .
  *  In both the above cases, the state machine may remain in an inconsistent state.
+ *
+ *  If the destination state of the transition has an embedded state machine, the embedded
+ *  state machine is started.
+ *  Since this amounts to executing the transition out of its initial pseudo-state, the
+ *  start of the embedded state machines is done iteratively within this function.
  *  @param smDesc the descriptor of the state machine where the transition is executed
  *  @param trans the transition which is executed
  */
 static void ExecTrans(FwSmDesc_t smDesc, SmTrans_t* trans);
 
+/**
+ *  Private helper function which looks for the transition out of the current state of a
+ *  state machine which responds to a given trigger and which has a true guard.
+ *  The transitions out of the current state are evaluated in the order in which they were
+ *  added to the state machine and the first one which responds to the trigger and has a
+ *  true guard is returned.
+ *  If the state machine has been compiled (see <code>::FwSmCompile</code>), the transitions
+ *  which respond to the trigger are located through the direct-index section of the
+ *  transition dispatch table or through a binary search in its sorted section (if the
+ *  current state has enough out-going transitions); otherwise, all transitions out of the
+ *  current state are scanned.
+ *  @param smDesc the descriptor of the state machine
+ *  @param curState the current state of the state machine
+ *  @param transId the identifier of the transition trigger
+ *  @return the transition to be executed or NULL if no transition out of the current
+ *  state responds to the trigger with a true guard
+ */
+static SmTrans_t* FindTrans(FwSmDesc_t smDesc, SmPState_t* curState, FwSmCounterU2_t transId);
+
+/**
+ *  Private helper function which processes a transition command in a chain of active
+ *  state machines.
+ *  If the chain has not yet been resolved, it is resolved while walking down from the
+ *  argument state machine to its innermost active embedded state machine.
+ *  Otherwise, the levels already held in the chain are used.
+ *  The chain is marked as unresolved if the transition command causes a transition
+ *  to be fired.
+ *  @param smDesc the descriptor of the top-level state machine of the chain
+ *  @param transId the identifier of the transition trigger
+ *  @param chain the chain of active state machines
+ *  @return 1 if a transition was fired in one of the state machines of the chain or
+ *  0 otherwise
+ */
+static FwSmBool_t MakeTransInChain(FwSmDesc_t smDesc, FwSmCounterU2_t transId, SmChain_t* chain);
+
+/**
+ *  Private helper function which processes a transition command in a state machine.
+ *  The chain of active state machines is resolved from scratch.
+ *  @param smDesc the descriptor of the state machine where the transition is triggered
+ *  @param transId the identifier of the transition trigger
+ *  @return 1 if a transition was fired in the state machine or in one of its embedded
+ *  state machines or 0 otherwise
+ */
+static FwSmBool_t MakeTrans(FwSmDesc_t smDesc, FwSmCounterU2_t transId);
+
+/**
+ *  Private helper function which updates the profiling data of a state machine when
+ *  the state machine exits its current state.
+ *  The time elapsed since the entry into the current state is added to the time spent
+ *  in the current state.
+ *  This function should only be called if profiling is enabled on the state machine.
+ *  @param smDesc the descriptor of the state machine
+ */
+static void SmProfileExit(FwSmDesc_t smDesc);
+
+/**
+ *  Private helper function which updates the profiling data of a state machine after
+ *  the guard of a transition has been evaluated.
+ *  This function should only be called if profiling is enabled on the state machine.
+ *  @param smDesc the descriptor of the state machine
+ *  @param trans the transition whose guard has been evaluated
+ *  @param guard the outcome of the guard evaluation
+ */
+static void SmProfileGuard(FwSmDesc_t smDesc, SmTrans_t* trans, FwSmBool_t guard);
+
+/**
+ *  Private helper function which evaluates a guard of a state machine which has a
+ *  guard memo (see <code>::FwSmSetGuardPure</code>).
+ *  If the guard has a declaration (see <code>::FwSmSetGuardDecl</code>), the declaration
+ *  is evaluated without calling the guard.
+ *  If the guard is pure and its outcome is cached, the cached outcome is returned
+ *  without calling the guard.
+ *  If the guard is pure and its outcome is not cached, the guard is called and its
+ *  outcome is cached.
+ *  Otherwise, the guard is called.
+ *  This function should only be called if the guard memo of the state machine exists.
+ *  @param smDesc the descriptor of the state machine
+ *  @param iGuard the index of the guard in the guard array of the state machine
+ *  @return the outcome of the guard
+ */
+static FwSmBool_t SmMemoGuard(FwSmDesc_t smDesc, FwSmCounterS1_t iGuard);
+
+/**
+ *  Private helper function which evaluates the declaration of a declarative guard of a
+ *  state machine (see <code>::FwSmSetGuardDecl</code>).
+ *  @param smDesc the descriptor of the state machine
+ *  @param decl the declaration of the guard
+ *  @return the outcome of the guard
+ */
+static FwSmBool_t SmDeclGuard(FwSmDesc_t smDesc, SmGuardDecl_t* decl);
+
+/**
+ *  Private helper function which discards the guard outcomes cached in the guard
+ *  memo of a state machine.
+ *  This function does nothing if the state machine has no guard memo.
+ *  @param smDesc the descriptor of the state machine
+ */
+static void SmMemoClear(FwSmDesc_t smDesc);
+
 /* ----------------------------------------------------------------------------------------------------------------- */
 void SmDummyAction(FwSmDesc_t smDesc) {
   (void)(smDesc);
@@ -48,6 +182,80 @@ FwSmBool_t SmDummyGuard(FwSmDesc_t smDesc) {
   return 1;
 }
 
+/* ----------------------------------------------------------------------------------------------------------------- */
+void SmReleaseNotify(FwSmDesc_t smDesc) {
+  SmNotify_t*       notify = smDesc->notify;
+  FwSmChangeList_t* list;
+  FwSmCounterU4_t   i;
+
+  if (notify == NULL) {
+    return;
+  }
+  list = notify->list;
+  if ((notify->isListed != 0) && (list != NULL)) {
+    for (i = 0; i < list->nOfChanged; i++) {
+      if (list->smDescs[i] == smDesc) {
+        list->nOfChanged--;
+        list->smDescs[i] = list->smDescs[list->nOfChanged];
+        break;
+      }
+    }
+  }
+  free(notify);
+  smDesc->notify = NULL;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+void SmNotifyChange(FwSmDesc_t smDesc) {
+  FwSmDesc_t        owner  = smDesc->notify->owner;
+  SmNotify_t*       notify = owner->notify;
+  FwSmChangeList_t* list;
+
+  if (notify == NULL) { /* change notification has been disabled on the owner */
+    return;
+  }
+  notify->changeSeq++;
+  list = notify->list;
+  if ((notify->isListed != 0) || (list == NULL)) {
+    return;
+  }
+  if (list->nOfChanged < list->size) {
+    list->smDescs[list->nOfChanged] = owner;
+    list->nOfChanged++;
+    notify->isListed = 1;
+  }
+  else {
+    list->nOfLost++;
+  }
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+void SmBcastChange(FwSmDesc_t smDesc) {
+  SmBcastLink_t*    link  = smDesc->bcast;
+  struct FwSmBcast* bcast = link->bcast;
+
+  if (link->isDirty == 0) {
+    link->isDirty                 = 1;
+    bcast->dirty[bcast->nOfDirty] = link->iSm;
+    bcast->nOfDirty++;
+  }
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+FwSmBool_t SmIsLazy(FwSmDesc_t smDesc, FwSmCounterS1_t i) {
+  return ((smDesc->lazy != NULL) && (smDesc->lazy->esm[i].esmBase != NULL));
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+void SmExecuteDo(FwSmDesc_t smDesc, FwSmCounterS1_t iDoAction) {
+  FW_TRACE_EVENT(traceSmExecuteCmd, smDesc, 0, 0);
+  smDesc->smExecCnt++;
+  smDesc->stateExecCnt++;
+  smDesc->smActions[iDoAction](smDesc);
+  FW_TRACE_EVENT(traceSmDoAction, smDesc, smDesc->curState, 0);
+  SmMemoClear(smDesc);
+}
+
 /* ----------------------------------------------------------------------------------------------------------------- */
 void FwSmStart(FwSmDesc_t smDesc) {
   SmTrans_t* trans;
@@ -61,86 +269,98 @@ void FwSmStart(FwSmDesc_t smDesc) {
   smDesc->stateExecCnt = 0;
 
   /* Execution transition into initial state */
+  SmMemoClear(smDesc);
   trans = &(smDesc->smBase->trans[0]);
   ExecTrans(smDesc, trans);
 }
 
 /* ----------------------------------------------------------------------------------------------------------------- */
 void FwSmStop(FwSmDesc_t smDesc) {
-  SmPState_t*     pState;
-  SmBaseDesc_t*   smBase    = smDesc->smBase;
-  FwSmCounterS1_t iCurState = smDesc->curState;
-
-  /* check if state machine (SM) is already stopped */
-  if (iCurState == 0) {
-    return;
+  SmLevel_t       level[FW_SM_MAX_NESTING];
+  FwSmCounterS1_t iCurState;
+  int             n = 0;
+
+  /* Walk down the chain of started state machines (SMs) starting from the argument SM */
+  while ((smDesc != NULL) && (smDesc->curState != 0)) {
+    if (n == FW_SM_MAX_NESTING) { /* nesting too deep for the stack: stop the other SMs recursively */
+      FwSmStop(smDesc);
+      break;
+    }
+    iCurState          = smDesc->curState;
+    level[n].smDesc    = smDesc;
+    level[n].curState  = &(smDesc->smBase->pStates[iCurState - 1]); /* get current state */
+    smDesc             = smDesc->esmDesc[iCurState - 1];
+    n++;
   }
 
-  pState = &(smBase->pStates[iCurState - 1]); /* get current state */
-  /* If the current state (CS) has an embedded SM (ESM), stop it */
-  if (smDesc->esmDesc[iCurState - 1] != NULL) {
-    FwSmStop(smDesc->esmDesc[iCurState - 1]);
+  /* Walk up the chain: the embedded SM (ESM) of a state is stopped before its exit action is executed */
+  while (n > 0) {
+    n--;
+    smDesc = level[n].smDesc;
+    /* a lazily embedded SM has been stopped and it is returned to its pool (if it has one) */
+    if (smDesc->lazy != NULL) {
+      iCurState = (FwSmCounterS1_t)(level[n].curState - smDesc->smBase->pStates);
+      if (SmIsLazy(smDesc, iCurState)) {
+        smDesc->lazy->put(smDesc, iCurState, 0);
+      }
+    }
+    /* execute exit action of current state */
+    smDesc->smActions[level[n].curState->iExitAction](smDesc);
+    FW_TRACE_EVENT(traceSmStateExit, smDesc, smDesc->curState, 0);
+    if (smDesc->profile != NULL) {
+      SmProfileExit(smDesc);
+    }
+    /* set state of SM to "undefined" */
+    smDesc->curState = 0;
+    if (smDesc->notify != NULL) {
+      SmNotifyChange(smDesc);
+    }
+    if (smDesc->bcast != NULL) {
+      SmBcastChange(smDesc);
+    }
   }
-  /* execute exit action of current state */
-  smDesc->smActions[pState->iExitAction](smDesc);
-  /* set state of SM to "undefined" */
-  smDesc->curState = 0;
   return;
 }
 
 /* ----------------------------------------------------------------------------------------------------------------- */
 void FwSmMakeTrans(FwSmDesc_t smDesc, FwSmCounterU2_t transId) {
-  SmPState_t*     curState;
-  SmTrans_t*      trans;
-  FwSmCounterS1_t i;
-  FwSmDesc_t      esmDesc;
-  SmBaseDesc_t*   smBase = smDesc->smBase;
-
-  /* check if state machine (SM) is started */
-  if (smDesc->curState == 0) {
-    return;
-  }
-
-  /* get current state */
-  curState = &(smBase->pStates[(smDesc->curState) - 1]);
-
-  /* If this is the "execute" transition, increment execution counters and execute do-action */
-  if (transId == FW_TR_EXECUTE) {
-    smDesc->smExecCnt++;
-    smDesc->stateExecCnt++;
-    smDesc->smActions[curState->iDoAction](smDesc);
-  }
-
-  /* If there is an embedded SM (ESM), propagate transition trigger to it */
-  esmDesc = smDesc->esmDesc[(smDesc->curState) - 1];
-  if (esmDesc != NULL) {
-    FwSmMakeTrans(esmDesc, transId);
-  }
+  FW_TRACE_EVENT(traceSmMakeTransCmd, smDesc, transId, 0);
+  (void)MakeTrans(smDesc, transId);
+}
 
-  /* look for transition from CS matching transition trigger */
-  for (i = 0; i < curState->nOfOutTrans; i++) {
-    trans = &(smBase->trans[curState->outTransIndex + i]);
-    /* check if outgoing transition responds to trigger tr_id */
-    if (trans->id == transId) {
-      /* check if outgoing transition has a true guard */
-      if (smDesc->smGuards[trans->iTrGuard](smDesc) != 0) {
-        /* If CS has an ESM, stop it before exiting the CS */
-        if (esmDesc != NULL) {
-          FwSmStop(esmDesc);
-        }
-        /* Execute exit action of CS */
-        smDesc->smActions[curState->iExitAction](smDesc);
-        ExecTrans(smDesc, trans);
-        return;
-      }
+/* ----------------------------------------------------------------------------------------------------------------- */
+FwSmCounterU4_t FwSmMakeTransBatch(FwSmDesc_t smDesc, const FwSmCounterU2_t* transIds, FwSmCounterU4_t nOfTransIds) {
+  SmChain_t       chain;
+  FwSmCounterU4_t i;
+  FwSmCounterU4_t nOfFired = 0;
+
+  /* The chain of active SMs is only resolved again after a transition has been fired */
+  chain.isResolved = 0;
+  for (i = 0; i < nOfTransIds; i++) {
+    FW_TRACE_EVENT(traceSmMakeTransCmd, smDesc, transIds[i], 0);
+    if (MakeTransInChain(smDesc, transIds[i], &chain) != 0) {
+      nOfFired++;
     }
   }
-  return;
+  return nOfFired;
 }
 
 /* ----------------------------------------------------------------------------------------------------------------- */
 void FwSmExecute(FwSmDesc_t smDesc) {
-  FwSmMakeTrans(smDesc, FW_TR_EXECUTE);
+  FwSmCounterS1_t iCurState = smDesc->curState;
+
+  FW_TRACE_EVENT(traceSmExecuteCmd, smDesc, 0, 0);
+
+  /* If the current state is execute-inert and has no embedded SM, only the execution counters are updated */
+  if ((iCurState != 0) && (smDesc->smBase->pStates[iCurState - 1].isExecInert != 0) &&
+      (smDesc->esmDesc[iCurState - 1] == NULL)) {
+    smDesc->smExecCnt++;
+    smDesc->stateExecCnt++;
+    FW_TRACE_EVENT(traceSmDoAction, smDesc, iCurState, 0);
+    SmMemoClear(smDesc);
+    return;
+  }
+  (void)MakeTrans(smDesc, FW_TR_EXECUTE);
 }
 
 /* ----------------------------------------------------------------------------------------------------------------- */
@@ -149,58 +369,366 @@ static void ExecTrans(FwSmDesc_t smDesc, SmTrans_t* trans) {
   SmCState_t*     cDest;
   SmTrans_t*      cTrans;
   FwSmCounterS1_t i;
+  FwSmCounterS1_t iGuard;
   FwSmDesc_t      esmDesc;
-  SmBaseDesc_t*   smBase = smDesc->smBase;
+  SmBaseDesc_t*   smBase;
+  FwSmBool_t      guard;
 
-  /* execute transition action */
-  smDesc->smActions[trans->iTrAction](smDesc);
+  for (;;) {
+    smBase = smDesc->smBase;
+
+    /* execute transition action (the guard outcomes cached before a non-dummy action are discarded) */
+    smDesc->smActions[trans->iTrAction](smDesc);
+    if (trans->iTrAction != 0) {
+      SmMemoClear(smDesc);
+    }
+    if (smDesc->profile != NULL) {
+      smDesc->profile->transFireCnt[trans - smBase->trans]++;
+    }
 
-  if (trans->dest > 0) { /* destination is a proper state */
+    if (trans->dest < 0) { /* destination is a choice pseudo-state */
+      cDest  = &(smBase->cStates[-(trans->dest) - 1]);
+      cTrans = NULL;
+      for (i = 0; i < cDest->nOfOutTrans; i++) {
+        iGuard = smBase->trans[cDest->outTransIndex + i].iTrGuard;
+        guard  = (smDesc->memo == NULL) ? smDesc->smGuards[iGuard](smDesc) : SmMemoGuard(smDesc, iGuard);
+        FW_TRACE_EVENT(traceSmGuard, smDesc, trans->dest, guard);
+        if (smDesc->profile != NULL) {
+          SmProfileGuard(smDesc, &(smBase->trans[cDest->outTransIndex + i]), guard);
+        }
+        if (guard != 0) {
+          cTrans = &(smBase->trans[cDest->outTransIndex + i]);
+          break;
+        }
+      }
+      if (cTrans == NULL) {
+        smDesc->errCode = smTransErr;
+        return;
+      }
+      /* Execute transition from choice pseudo-state */
+      smDesc->smActions[cTrans->iTrAction](smDesc);
+      if (smDesc->profile != NULL) {
+        smDesc->profile->transFireCnt[cTrans - smBase->trans]++;
+      }
+      if (cTrans->dest < 0) { /* this point is reached only if there is a transition from a CPS to a CPS */
+        smDesc->errCode = smTransErr;
+        return;
+      }
+      trans = cTrans;
+    }
+
+    if (trans->dest == 0) { /* destination is a final pseudo-state */
+      if ((smDesc->notify != NULL) && (smDesc->curState != 0)) {
+        SmNotifyChange(smDesc);
+      }
+      if ((smDesc->bcast != NULL) && (smDesc->curState != 0)) {
+        SmBcastChange(smDesc);
+      }
+      smDesc->curState = 0;
+      return;
+    }
+
+    /* destination is a proper state (a self-transition does not change the current state) */
+    if ((smDesc->notify != NULL) && (smDesc->curState != trans->dest)) {
+      SmNotifyChange(smDesc);
+    }
+    if ((smDesc->bcast != NULL) && (smDesc->curState != trans->dest)) {
+      SmBcastChange(smDesc);
+    }
     smDesc->curState     = trans->dest;
     smDesc->stateExecCnt = 0;
     pDest                = &(smBase->pStates[(trans->dest) - 1]);
     /* execute entry action of destination state */
     smDesc->smActions[pDest->iEntryAction](smDesc);
+    FW_TRACE_EVENT(traceSmStateEntry, smDesc, trans->dest, 0);
+    if (smDesc->profile != NULL) {
+      smDesc->profile->stateEntryCnt[(trans->dest) - 1]++;
+      if (smDesc->profile->clock != NULL) {
+        smDesc->profile->entryTime = smDesc->profile->clock();
+      }
+    }
+
+    /* If the destination state has an embedded SM which is not yet started, start it (a lazily
+     * embedded SM is instantiated when it is first needed) */
     esmDesc = smDesc->esmDesc[(trans->dest) - 1];
-    if (esmDesc != NULL) {
-      FwSmStart(esmDesc);
+    if ((esmDesc == NULL) && (smDesc->lazy != NULL) && SmIsLazy(smDesc, (FwSmCounterS1_t)((trans->dest) - 1))) {
+      esmDesc = smDesc->lazy->get(smDesc, (FwSmCounterS1_t)((trans->dest) - 1));
     }
-    return;
+    if ((esmDesc == NULL) || (esmDesc->curState != 0)) {
+      return;
+    }
+    SmMemoClear(esmDesc);
+    esmDesc->smExecCnt    = 0;
+    esmDesc->stateExecCnt = 0;
+    smDesc                = esmDesc;
+    trans                 = &(smDesc->smBase->trans[0]);
   }
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+static FwSmBool_t MakeTrans(FwSmDesc_t smDesc, FwSmCounterU2_t transId) {
+  SmChain_t chain;
+
+  chain.isResolved = 0;
+  return MakeTransInChain(smDesc, transId, &chain);
+}
 
-  if (trans->dest < 0) { /* destination is a choice pseudo-state */
-    cDest = &(smBase->cStates[-(trans->dest) - 1]);
-    for (i = 0; i < cDest->nOfOutTrans; i++) {
-      cTrans = &(smBase->trans[cDest->outTransIndex + i]);
-      if (smDesc->smGuards[cTrans->iTrGuard](smDesc) != 0) {
-        /* Execute transition from choice pseudo-state */
-        smDesc->smActions[cTrans->iTrAction](smDesc);
-        if (cTrans->dest > 0) { /* destination is a proper state */
-          smDesc->curState     = cTrans->dest;
-          smDesc->stateExecCnt = 0;
-          pDest                = &(smBase->pStates[(cTrans->dest) - 1]);
-          /* execute entry action of destination state */
-          smDesc->smActions[pDest->iEntryAction](smDesc);
-          esmDesc = smDesc->esmDesc[(cTrans->dest) - 1];
-          if (esmDesc != NULL) {
-            FwSmStart(esmDesc);
-          }
-          return;
+/* ----------------------------------------------------------------------------------------------------------------- */
+static FwSmBool_t MakeTransInChain(FwSmDesc_t smDesc, FwSmCounterU2_t transId, SmChain_t* chain) {
+  SmLevel_t*  level   = chain->level;
+  FwSmBool_t  isFired = 0;
+  SmPState_t* curState;
+  SmTrans_t*  trans;
+  int         n;
+
+  if (chain->isResolved == 0) {
+    /* Walk down the chain of started state machines (SMs) and execute the do-actions top-down */
+    n = 0;
+    while ((smDesc != NULL) && (smDesc->curState != 0) && (n < FW_SM_MAX_NESTING)) {
+      /* get current state */
+      curState = &(smDesc->smBase->pStates[(smDesc->curState) - 1]);
+
+      /* If this is the "execute" transition, increment execution counters and execute do-action */
+      if (transId == FW_TR_EXECUTE) {
+        smDesc->smExecCnt++;
+        smDesc->stateExecCnt++;
+        smDesc->smActions[curState->iDoAction](smDesc);
+        FW_TRACE_EVENT(traceSmDoAction, smDesc, smDesc->curState, 0);
+      }
+
+      /* If there is an embedded SM (ESM), the transition trigger is propagated to it */
+      level[n].smDesc   = smDesc;
+      level[n].curState = curState;
+      level[n].esmDesc  = smDesc->esmDesc[(smDesc->curState) - 1];
+      smDesc            = level[n].esmDesc;
+      n++;
+    }
+    chain->nOfLevels  = n;
+    chain->isResolved = 1;
+  }
+  else {
+    /* The chain is unchanged since the last transition command: only execute the do-actions */
+    n = chain->nOfLevels;
+    if (transId == FW_TR_EXECUTE) {
+      for (n = 0; n < chain->nOfLevels; n++) {
+        smDesc = level[n].smDesc;
+        smDesc->smExecCnt++;
+        smDesc->stateExecCnt++;
+        smDesc->smActions[level[n].curState->iDoAction](smDesc);
+        FW_TRACE_EVENT(traceSmDoAction, smDesc, smDesc->curState, 0);
+      }
+    }
+  }
+
+  /* If the nesting is too deep for the chain, propagate the trigger recursively */
+  if ((n == FW_SM_MAX_NESTING) && (level[n - 1].esmDesc != NULL)) {
+    isFired = MakeTrans(level[n - 1].esmDesc, transId);
+  }
+
+  /* Walk up the chain so that the innermost SM reacts to the trigger first */
+  while (n > 0) {
+    n--;
+    smDesc = level[n].smDesc;
+    /* look for transition from CS matching transition trigger (the guard outcomes cached in earlier
+     * transition commands are discarded) */
+    SmMemoClear(smDesc);
+    trans = FindTrans(smDesc, level[n].curState, transId);
+    if (trans != NULL) {
+      /* If CS has an ESM, stop it before exiting the CS */
+      if (level[n].esmDesc != NULL) {
+        FwSmStop(level[n].esmDesc);
+        SmMemoClear(smDesc);
+        if ((smDesc->lazy != NULL) && SmIsLazy(smDesc, (FwSmCounterS1_t)((smDesc->curState) - 1))) {
+          smDesc->lazy->put(smDesc, (FwSmCounterS1_t)((smDesc->curState) - 1), 0);
         }
+      }
+      /* Execute exit action of CS */
+      smDesc->smActions[level[n].curState->iExitAction](smDesc);
+      if (level[n].curState->iExitAction != 0) {
+        SmMemoClear(smDesc);
+      }
+      FW_TRACE_EVENT(traceSmStateExit, smDesc, smDesc->curState, 0);
+      if (smDesc->profile != NULL) {
+        SmProfileExit(smDesc);
+      }
+      FW_TRACE_EVENT(traceSmTrans, smDesc, transId, smDesc->curState);
+      ExecTrans(smDesc, trans);
+      isFired = 1;
+    }
+  }
+
+  if (isFired != 0) {
+    chain->isResolved = 0;
+  }
+  return isFired;
+}
 
-        if (cTrans->dest == 0) { /* destination is a final state */
-          smDesc->curState = 0;
-          return;
+/* ----------------------------------------------------------------------------------------------------------------- */
+static SmTrans_t* FindTrans(FwSmDesc_t smDesc, SmPState_t* curState, FwSmCounterU2_t transId) {
+  SmTrans_t*      trans;
+  FwSmCounterS1_t i, lo, hi, mid, end;
+  SmBaseDesc_t*   smBase = smDesc->smBase;
+  FwSmBool_t      guard;
+  FwSmCounterU4_t k;
+  FwSmCounterU4_t nOfOutTrans = (FwSmCounterU4_t)curState->nOfOutTrans;
+
+  /* the binary search is only faster than a linear scan for states with many out-going transitions */
+  if ((smBase->isCompiled == 0) ||
+      ((curState->dispNOfIds == 0) && (nOfOutTrans < (FwSmCounterU4_t)FW_SM_DISP_MIN_OUT_TRANS))) {
+    for (i = 0; i < curState->nOfOutTrans; i++) {
+      trans = &(smBase->trans[curState->outTransIndex + i]);
+      /* check if outgoing transition responds to trigger tr_id and has a true guard */
+      if (trans->id == transId) {
+        guard = (smDesc->memo == NULL) ? smDesc->smGuards[trans->iTrGuard](smDesc)
+                                       : SmMemoGuard(smDesc, trans->iTrGuard);
+        FW_TRACE_EVENT(traceSmGuard, smDesc, transId, guard);
+        if (smDesc->profile != NULL) {
+          SmProfileGuard(smDesc, trans, guard);
         }
+        if (guard != 0) {
+          return trans;
+        }
+      }
+    }
+    return NULL;
+  }
 
-        break; /* this point is reached only if there is a transition from a CPS to a CPS */
+  /* the transitions which respond to trigger tr_id are located through the direct-index section */
+  if (curState->dispNOfIds != 0) {
+    k = (FwSmCounterU4_t)transId - (FwSmCounterU4_t)curState->dispMinId;
+    if (k >= (FwSmCounterU4_t)curState->dispNOfIds) {
+      return NULL;
+    }
+    k   = k + (FwSmCounterU4_t)smBase->nOfTrans + 2 * (FwSmCounterU4_t)curState->outTransIndex;
+    lo  = smBase->transDisp[k];
+    end = smBase->transDisp[k + 1];
+  }
+  else {
+    /* look for the first entry in the dispatch table which responds to trigger tr_id */
+    lo  = curState->outTransIndex;
+    end = (FwSmCounterS1_t)(curState->outTransIndex + curState->nOfOutTrans);
+    hi  = end;
+    while (lo < hi) {
+      mid = (FwSmCounterS1_t)(lo + (hi - lo) / 2);
+      if (smBase->trans[smBase->transDisp[mid]].id < transId) {
+        lo = (FwSmCounterS1_t)(mid + 1);
+      }
+      else {
+        hi = mid;
       }
     }
-    smDesc->errCode = smTransErr;
   }
-  else { /* destination is a final pseudo-state */
-    smDesc->curState = 0;
-    return;
+
+  /* evaluate the guards of the transitions which respond to trigger tr_id */
+  for (i = lo; i < end; i++) {
+    trans = &(smBase->trans[smBase->transDisp[i]]);
+    if (trans->id != transId) {
+      break;
+    }
+    guard = (smDesc->memo == NULL) ? smDesc->smGuards[trans->iTrGuard](smDesc)
+                                   : SmMemoGuard(smDesc, trans->iTrGuard);
+    FW_TRACE_EVENT(traceSmGuard, smDesc, transId, guard);
+    if (smDesc->profile != NULL) {
+      SmProfileGuard(smDesc, trans, guard);
+    }
+    if (guard != 0) {
+      return trans;
+    }
+  }
+  return NULL;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+static FwSmBool_t SmMemoGuard(FwSmDesc_t smDesc, FwSmCounterS1_t iGuard) {
+  SmGuardMemo_t*  memo  = smDesc->memo;
+  FwSmCounterU4_t iByte = ((FwSmCounterU4_t)iGuard) / 8;
+  FwSmCounterU1_t bit   = (FwSmCounterU1_t)(1U << (((FwSmCounterU4_t)iGuard) % 8));
+  FwSmBool_t      guard;
+
+  if (memo->decl[iGuard].opnd != smGuardOpndNone) {
+    return SmDeclGuard(smDesc, &(memo->decl[iGuard]));
+  }
+  if ((memo->pure[iByte] & bit) == 0) {
+    return smDesc->smGuards[iGuard](smDesc);
+  }
+  if ((memo->cached[iByte] & bit) != 0) {
+    return ((memo->value[iByte] & bit) != 0);
+  }
+
+  guard               = smDesc->smGuards[iGuard](smDesc);
+  memo->cached[iByte] = (FwSmCounterU1_t)(memo->cached[iByte] | bit);
+  if (guard != 0) {
+    memo->value[iByte] = (FwSmCounterU1_t)(memo->value[iByte] | bit);
+  }
+  else {
+    memo->value[iByte] = (FwSmCounterU1_t)(memo->value[iByte] & ~bit);
+  }
+  memo->isCached = 1;
+  return guard;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+static FwSmBool_t SmDeclGuard(FwSmDesc_t smDesc, SmGuardDecl_t* decl) {
+  const char* data = (const char*)(smDesc->smData);
+  long        opnd;
+
+  switch (decl->opnd) {
+  case smGuardOpndInt:
+    opnd = (long)(*(const int*)(const void*)(data + decl->offset));
+    break;
+  case smGuardOpndLong:
+    opnd = *(const long*)(const void*)(data + decl->offset);
+    break;
+  case smGuardOpndStateExecCnt:
+    opnd = (long)(smDesc->stateExecCnt);
+    break;
+  default:
+    opnd = (long)(smDesc->smExecCnt);
+    break;
+  }
+
+  switch (decl->op) {
+  case smGuardLt:
+    return (opnd < decl->value);
+  case smGuardLe:
+    return (opnd <= decl->value);
+  case smGuardEq:
+    return (opnd == decl->value);
+  case smGuardNe:
+    return (opnd != decl->value);
+  case smGuardGe:
+    return (opnd >= decl->value);
+  default:
+    return (opnd > decl->value);
+  }
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+static void SmMemoClear(FwSmDesc_t smDesc) {
+  SmGuardMemo_t* memo = smDesc->memo;
+
+  if ((memo != NULL) && (memo->isCached != 0)) {
+    memset(memo->cached, 0, memo->nOfBytes);
+    memo->isCached = 0;
+  }
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+static void SmProfileExit(FwSmDesc_t smDesc) {
+  SmProfile_t* profile = smDesc->profile;
+
+  if (profile->clock != NULL) {
+    profile->stateDwell[(smDesc->curState) - 1] += profile->clock() - profile->entryTime;
+  }
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+static void SmProfileGuard(FwSmDesc_t smDesc, SmTrans_t* trans, FwSmBool_t guard) {
+  if (guard != 0) {
+    smDesc->profile->guardTrueCnt[trans - smDesc->smBase->trans]++;
+  }
+  else {
+    smDesc->profile->guardFalseCnt[trans - smDesc->smBase->trans]++;
   }
 }
 
@@ -244,6 +772,21 @@ FwSmBool_t FwSmIsStarted(FwSmDesc_t smDesc) {
   return 0;
 }
 
+/* ----------------------------------------------------------------------------------------------------------------- */
+FwSmBool_t FwSmIsExecInert(FwSmDesc_t smDesc) {
+  FwSmCounterS1_t iCurState = smDesc->curState;
+  FwSmDesc_t      esmDesc;
+
+  if ((iCurState == 0) || (smDesc->smBase->pStates[iCurState - 1].isExecInert == 0)) {
+    return 0;
+  }
+  esmDesc = smDesc->esmDesc[iCurState - 1];
+  if ((esmDesc == NULL) || (esmDesc->curState == 0)) {
+    return 1;
+  }
+  return FwSmIsExecInert(esmDesc);
+}
+
 /* ----------------------------------------------------------------------------------------------------------------- */
 FwSmErrCode_t FwSmGetErrCode(FwSmDesc_t smDesc) {
   return smDesc->errCode;
@@ -64,6 +64,10 @@ void FwSmStart(FwSmDesc_t smDesc);
  * diagram on the right-hand side of the following figure
  * (this is figure 4.3-1 in the "FW Profile Definition Document"):
  * @image html SM_StartStop.png
+ * The embedded state machines of the current state are stopped from the innermost
+ * outwards.
+ * As in the case of <code>::FwSmMakeTrans</code>, the chain of embedded state machines
+ * is walked iteratively with an explicit stack of <code>#FW_SM_MAX_NESTING</code> levels.
  * @param smDesc the descriptor of the state machine to be started.
  */
 void FwSmStop(FwSmDesc_t smDesc);
@@ -77,9 +81,15 @@ void FwSmStop(FwSmDesc_t smDesc);
  * diagram (this is taken from figure 4.3-3 in the "FW Profile
  * Definition Document"):
  * @image html SM_TransitionExecution.png
- * This operation is recursive because a transition request is propagated to the
- * embedded state machine of the source state. The maximum depth of recursion is the
- * maximum depth of nesting of embedded state machines.
+ * A transition request is propagated to the embedded state machine of the source state.
+ * This operation walks the chain of active embedded state machines iteratively: it first
+ * descends the chain from the argument state machine to the innermost active embedded
+ * state machine (executing the do-actions top-down if the transition request is the
+ * "Execute" command) and it then ascends the chain giving each state machine, starting
+ * from the innermost one, the chance to react to the transition request.
+ * The chain is walked with an explicit stack of <code>#FW_SM_MAX_NESTING</code> levels.
+ * The operation is only recursive if the depth of nesting of the embedded state
+ * machines exceeds this value.
  *
  * If there are two transitions out of the current state which are both activated by
  * this operation, the transition that will actually be taken is the one which was
@@ -90,6 +100,13 @@ void FwSmStop(FwSmDesc_t smDesc);
  * there are two transitions out of the CPS which have guards which evaluate to true,
  * the transition to be taken is the one which was added first to the state machine.
  *
+ * If the state machine has been compiled (see <code>::FwSmCompile</code>), the transitions
+ * out of the current state which respond to the transition trigger are located through
+ * the transition dispatch table of the state machine (either through a direct index on
+ * the trigger identifier or through a binary search, see <code>::FwSmCompile</code>).
+ * Otherwise, all the transitions out of the current state are scanned.
+ * In both cases, the order of evaluation of the transitions is the same.
+ *
  * The FW Profile stipulates that at least one of the transitions out of a CPS
  * must have a guard evaluating to true. This constraint is not enforced by the
  * State Machine Module. If the constraint is violated, the error code is set to
@@ -108,11 +125,33 @@ void FwSmStop(FwSmDesc_t smDesc);
  */
 void FwSmMakeTrans(FwSmDesc_t smDesc, FwSmCounterU2_t transId);
 
+/**
+ * Trigger a sequence of transitions in a state machine.
+ * This function is functionally equivalent to calling <code>::FwSmMakeTrans</code>
+ * on each transition identifier in the argument array in the order in which they
+ * appear in the array.
+ *
+ * The chain of active embedded state machines is resolved when the first transition
+ * command is processed and it is only resolved again after a transition command has
+ * caused a transition to be fired.
+ * Hence, the actions executed during the processing of the batch must not start, stop
+ * or trigger transitions in the state machines in the chain by means other than this
+ * function.
+ * @param smDesc the descriptor of the state machine where the transitions are triggered.
+ * @param transIds the array of identifiers of the transition triggers.
+ * @param nOfTransIds the number of transition identifiers in the array.
+ * @return the number of transition commands which caused a transition to be fired
+ * (either in the argument state machine or in one of its embedded state machines).
+ */
+FwSmCounterU4_t FwSmMakeTransBatch(FwSmDesc_t smDesc, const FwSmCounterU2_t* transIds, FwSmCounterU4_t nOfTransIds);
+
 /**
  * Convenience method to execute a state machine. Executing a state machine is equivalent
  * to sending it the "Execute" transition command with function
  * <code>::FwSmMakeTrans</code>.
  * The identifier of the "Execute" transition command is stored in #FW_TR_EXECUTE.
+ * If the current state is execute-inert (see <code>::FwSmIsExecInert</code>) and has
+ * no embedded state machine, only the execution counters are incremented.
  * @param smDesc the descriptor of the state machine which is executed.
  */
 void FwSmExecute(FwSmDesc_t smDesc);
@@ -177,6 +216,27 @@ FwSmCounterS1_t FwSmGetCurStateEmb(FwSmDesc_t smDesc);
  */
 FwSmBool_t FwSmIsStarted(FwSmDesc_t smDesc);
 
+/**
+ * Check whether executing the state machine has no effect other than incrementing
+ * the execution counters of its state machines.
+ * This is the case if the state machine is started, its current state is execute-inert
+ * (its do-action is the dummy action and none of its out-going transitions is triggered
+ * by the "Execute" transition command) and the state machine embedded in the current
+ * state (if any) is either stopped or itself satisfies this condition.
+ * The execute-inert flags of the states are updated by the configuration functions
+ * as the states and their out-going transitions are added to the state machine.
+ *
+ * A scheduler may use this function to skip the execution of a state machine in a cycle
+ * (in which case the execution counters of the state machine are not incremented).
+ * Function <code>::FwSmExecute</code> uses the execute-inert flags to skip the search
+ * for an "Execute" transition when the current state is execute-inert and has no
+ * embedded state machine.
+ * @param smDesc the descriptor of the state machine.
+ * @return 1 if executing the state machine has no effect other than incrementing its
+ * execution counters or 0 otherwise.
+ */
+FwSmBool_t FwSmIsExecInert(FwSmDesc_t smDesc);
+
 /**
  * Return the error code of the argument state machine.
  * The error code of a state machine holds either <code>#smSuccess</code> if the state
@@ -0,0 +1,409 @@
+/**
+ * @file
+ * @ingroup smGroup
+ * Implements the step cost analysis functions for the FW State Machine Module.
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2011, All Rights Reserved
+ *
+ * This file is part of the FW Profile.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#include "FwSmCost.h"
+#include "FwSmConfig.h"
+#include "FwSmPrivate.h"
+#include <stdlib.h>
+
+/**
+ * The cost annotations which are used by an analysis.
+ */
+typedef struct {
+  /** the cost annotations (or NULL) */
+  const FwSmCostAnnot_t* annots;
+  /** the number of cost annotations */
+  FwSmCounterU4_t nOfAnnots;
+} SmCostAnnots_t;
+
+/**
+ * Initialize the cost of a step which does not execute any action or guard.
+ * @param cost the cost.
+ */
+static void CostInit(FwSmCost_t* cost);
+
+/**
+ * Add the cost of a part of a step to the cost of the step.
+ * @param cost the cost of the step.
+ * @param part the cost of the part of the step.
+ * @param isEmb 1 if the part of the step is executed by an embedded state machine or 0
+ * if it is executed by the state machine of the step.
+ */
+static void CostAdd(FwSmCost_t* cost, const FwSmCost_t* part, FwSmCounterU4_t isEmb);
+
+/**
+ * Replace the cost of a step with the field-by-field maximum of its cost and of the
+ * cost of an alternative execution path of the step.
+ * @param cost the cost of the step.
+ * @param alt the cost of the alternative execution path.
+ */
+static void CostMax(FwSmCost_t* cost, const FwSmCost_t* alt);
+
+/**
+ * Return the cost of an action or guard from the cost annotations.
+ * @param annots the cost annotations.
+ * @param action the action (or NULL if the cost of a guard is requested).
+ * @param guard the guard (or NULL if the cost of an action is requested).
+ * @return the annotated cost or 1 if the action or guard is not annotated.
+ */
+static FwSmCounterU4_t CostOf(const SmCostAnnots_t* annots, FwSmAction_t action, FwSmGuard_t guard);
+
+/**
+ * Add the execution of an action to the cost of a step.
+ * @param annots the cost annotations.
+ * @param smDesc the state machine which executes the action.
+ * @param iAction the index of the action in the action array of the state machine.
+ * @param cost the cost of the step.
+ */
+static void CostAction(const SmCostAnnots_t* annots, FwSmDesc_t smDesc, FwSmCounterS1_t iAction, FwSmCost_t* cost);
+
+/**
+ * Add the evaluation of a guard to the cost of a step.
+ * @param annots the cost annotations.
+ * @param smDesc the state machine which evaluates the guard.
+ * @param iGuard the index of the guard in the guard array of the state machine.
+ * @param cost the cost of the step.
+ */
+static void CostGuard(const SmCostAnnots_t* annots, FwSmDesc_t smDesc, FwSmCounterS1_t iGuard, FwSmCost_t* cost);
+
+/**
+ * Compute the worst-case cost of the execution of a transition (see function
+ * <code>ExecTrans</code> in <code>FwSmCore.c</code>).
+ * This includes the transition out of the choice pseudo-state at the destination
+ * of the transition (if any) and the start of the embedded state machine of the
+ * state which is entered.
+ * @param annots the cost annotations.
+ * @param smDesc the state machine.
+ * @param trans the transition.
+ * @param cost the worst-case cost.
+ */
+static void CostExecTrans(const SmCostAnnots_t* annots, FwSmDesc_t smDesc, SmTrans_t* trans, FwSmCost_t* cost);
+
+/**
+ * Compute the worst-case cost of entering the destination of a transition out of
+ * a choice pseudo-state or of a transition into a state or into the final pseudo-state.
+ * @param annots the cost annotations.
+ * @param smDesc the state machine.
+ * @param dest the destination (a state or the final pseudo-state).
+ * @param cost the worst-case cost.
+ */
+static void CostDest(const SmCostAnnots_t* annots, FwSmDesc_t smDesc, FwSmCounterS1_t dest, FwSmCost_t* cost);
+
+/**
+ * Return the state machine embedded in a state of a state machine or, if the state has
+ * a lazily embedded state machine which has not yet been instantiated, its template.
+ * @param smDesc the state machine.
+ * @param i the index of the state in the state array of the state machine.
+ * @return the embedded state machine or its template (or NULL if the state has neither).
+ */
+static FwSmDesc_t CostEsm(FwSmDesc_t smDesc, FwSmCounterS1_t i);
+
+/**
+ * Compute the worst-case cost of stopping a state machine over all its states.
+ * @param annots the cost annotations.
+ * @param smDesc the state machine.
+ * @param cost the worst-case cost.
+ */
+static void CostStop(const SmCostAnnots_t* annots, FwSmDesc_t smDesc, FwSmCost_t* cost);
+
+/**
+ * Compute the worst-case cost of sending a transition command to a state machine
+ * in a given state.
+ * @param annots the cost annotations.
+ * @param smDesc the state machine.
+ * @param i the index of the current state in the state array of the state machine.
+ * @param transId the identifier of the transition command.
+ * @param cost the worst-case cost.
+ */
+static void CostState(const SmCostAnnots_t* annots, FwSmDesc_t smDesc, FwSmCounterS1_t i, FwSmCounterU2_t transId,
+                      FwSmCost_t* cost);
+
+/**
+ * Compute the worst-case cost of sending a transition command to a state machine
+ * over all its states.
+ * @param annots the cost annotations.
+ * @param smDesc the state machine.
+ * @param transId the identifier of the transition command.
+ * @param cost the worst-case cost.
+ */
+static void CostAnyState(const SmCostAnnots_t* annots, FwSmDesc_t smDesc, FwSmCounterU2_t transId, FwSmCost_t* cost);
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+FwSmErrCode_t FwSmCostStart(FwSmDesc_t smDesc, const FwSmCostAnnot_t* annots, FwSmCounterU4_t nOfAnnots,
+                            FwSmCost_t* cost) {
+  SmCostAnnots_t costAnnots;
+  FwSmErrCode_t  outcome;
+
+  outcome = FwSmCheckRec(smDesc);
+  if (outcome != smSuccess) {
+    return outcome;
+  }
+
+  costAnnots.annots    = annots;
+  costAnnots.nOfAnnots = nOfAnnots;
+  CostExecTrans(&costAnnots, smDesc, &(smDesc->smBase->trans[0]), cost);
+  return smSuccess;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+FwSmErrCode_t FwSmCostStop(FwSmDesc_t smDesc, const FwSmCostAnnot_t* annots, FwSmCounterU4_t nOfAnnots,
+                           FwSmCost_t* cost) {
+  SmCostAnnots_t costAnnots;
+  FwSmErrCode_t  outcome;
+
+  outcome = FwSmCheckRec(smDesc);
+  if (outcome != smSuccess) {
+    return outcome;
+  }
+
+  costAnnots.annots    = annots;
+  costAnnots.nOfAnnots = nOfAnnots;
+  CostStop(&costAnnots, smDesc, cost);
+  return smSuccess;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+FwSmErrCode_t FwSmCostMakeTrans(FwSmDesc_t smDesc, FwSmCounterS1_t stateId, FwSmCounterU2_t transId,
+                                const FwSmCostAnnot_t* annots, FwSmCounterU4_t nOfAnnots, FwSmCost_t* cost) {
+  SmCostAnnots_t costAnnots;
+  FwSmErrCode_t  outcome;
+
+  if ((stateId < 0) || (stateId > smDesc->smBase->nOfPStates)) {
+    return smIllStateId;
+  }
+
+  outcome = FwSmCheckRec(smDesc);
+  if (outcome != smSuccess) {
+    return outcome;
+  }
+
+  costAnnots.annots    = annots;
+  costAnnots.nOfAnnots = nOfAnnots;
+  if (stateId == 0) {
+    CostAnyState(&costAnnots, smDesc, transId, cost);
+  }
+  else {
+    CostState(&costAnnots, smDesc, (FwSmCounterS1_t)(stateId - 1), transId, cost);
+  }
+  return smSuccess;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+static void CostInit(FwSmCost_t* cost) {
+  cost->nOfActions = 0;
+  cost->nOfGuards  = 0;
+  cost->nOfLevels  = 1;
+  cost->cost       = 0;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+static void CostAdd(FwSmCost_t* cost, const FwSmCost_t* part, FwSmCounterU4_t isEmb) {
+  cost->nOfActions += part->nOfActions;
+  cost->nOfGuards += part->nOfGuards;
+  cost->cost += part->cost;
+  if (cost->nOfLevels < part->nOfLevels + isEmb) {
+    cost->nOfLevels = part->nOfLevels + isEmb;
+  }
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+static void CostMax(FwSmCost_t* cost, const FwSmCost_t* alt) {
+  if (cost->nOfActions < alt->nOfActions) {
+    cost->nOfActions = alt->nOfActions;
+  }
+  if (cost->nOfGuards < alt->nOfGuards) {
+    cost->nOfGuards = alt->nOfGuards;
+  }
+  if (cost->nOfLevels < alt->nOfLevels) {
+    cost->nOfLevels = alt->nOfLevels;
+  }
+  if (cost->cost < alt->cost) {
+    cost->cost = alt->cost;
+  }
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+static FwSmCounterU4_t CostOf(const SmCostAnnots_t* annots, FwSmAction_t action, FwSmGuard_t guard) {
+  FwSmCounterU4_t i;
+
+  for (i = 0; i < annots->nOfAnnots; i++) {
+    if ((action != NULL) && (annots->annots[i].action == action)) {
+      return annots->annots[i].cost;
+    }
+    if ((guard != NULL) && (annots->annots[i].guard == guard)) {
+      return annots->annots[i].cost;
+    }
+  }
+  return 1;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+static void CostAction(const SmCostAnnots_t* annots, FwSmDesc_t smDesc, FwSmCounterS1_t iAction, FwSmCost_t* cost) {
+  cost->nOfActions++;
+  if (iAction != 0) { /* the dummy action has no cost */
+    cost->cost += CostOf(annots, smDesc->smActions[iAction], NULL);
+  }
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+static void CostGuard(const SmCostAnnots_t* annots, FwSmDesc_t smDesc, FwSmCounterS1_t iGuard, FwSmCost_t* cost) {
+  cost->nOfGuards++;
+  if (iGuard != 0) { /* the dummy guard has no cost */
+    cost->cost += CostOf(annots, NULL, smDesc->smGuards[iGuard]);
+  }
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+static void CostExecTrans(const SmCostAnnots_t* annots, FwSmDesc_t smDesc, SmTrans_t* trans, FwSmCost_t* cost) {
+  SmBaseDesc_t*   smBase = smDesc->smBase;
+  SmCState_t*     cDest;
+  SmTrans_t*      cTrans;
+  FwSmCost_t      guards, alt, dest, worst;
+  FwSmCounterS1_t i;
+
+  CostInit(cost);
+  CostAction(annots, smDesc, trans->iTrAction, cost);
+
+  if (trans->dest >= 0) {
+    CostDest(annots, smDesc, trans->dest, &dest);
+    CostAdd(cost, &dest, 0);
+    return;
+  }
+
+  /* The guards out of the choice pseudo-state are evaluated until one is true: the worst case
+   * is taken over the transition which is fired and the case where no guard is true */
+  cDest = &(smBase->cStates[-(trans->dest) - 1]);
+  CostInit(&guards);
+  CostInit(&worst);
+  for (i = 0; i < cDest->nOfOutTrans; i++) {
+    cTrans = &(smBase->trans[cDest->outTransIndex + i]);
+    CostGuard(annots, smDesc, cTrans->iTrGuard, &guards);
+    alt = guards;
+    CostAction(annots, smDesc, cTrans->iTrAction, &alt);
+    if (cTrans->dest >= 0) { /* a transition to a choice pseudo-state is not executed */
+      CostDest(annots, smDesc, cTrans->dest, &dest);
+      CostAdd(&alt, &dest, 0);
+    }
+    CostMax(&worst, &alt);
+  }
+  CostMax(&worst, &guards);
+  CostAdd(cost, &worst, 0);
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+static void CostDest(const SmCostAnnots_t* annots, FwSmDesc_t smDesc, FwSmCounterS1_t dest, FwSmCost_t* cost) {
+  FwSmDesc_t esmDesc;
+  FwSmCost_t start;
+
+  CostInit(cost);
+  if (dest == 0) { /* final pseudo-state */
+    return;
+  }
+
+  CostAction(annots, smDesc, smDesc->smBase->pStates[dest - 1].iEntryAction, cost);
+  esmDesc = CostEsm(smDesc, (FwSmCounterS1_t)(dest - 1));
+  if (esmDesc != NULL) {
+    CostExecTrans(annots, esmDesc, &(esmDesc->smBase->trans[0]), &start);
+    CostAdd(cost, &start, 1);
+  }
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+static FwSmDesc_t CostEsm(FwSmDesc_t smDesc, FwSmCounterS1_t i) {
+  if ((smDesc->esmDesc[i] == NULL) && SmIsLazy(smDesc, i)) {
+    return smDesc->lazy->esm[i].esmBase;
+  }
+  return smDesc->esmDesc[i];
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+static void CostStop(const SmCostAnnots_t* annots, FwSmDesc_t smDesc, FwSmCost_t* cost) {
+  FwSmCost_t      alt, stop;
+  FwSmDesc_t      esmDesc;
+  FwSmCounterS1_t i;
+
+  CostInit(cost);
+  for (i = 0; i < smDesc->smBase->nOfPStates; i++) {
+    CostInit(&alt);
+    esmDesc = CostEsm(smDesc, i);
+    if (esmDesc != NULL) {
+      CostStop(annots, esmDesc, &stop);
+      CostAdd(&alt, &stop, 1);
+    }
+    CostAction(annots, smDesc, smDesc->smBase->pStates[i].iExitAction, &alt);
+    CostMax(cost, &alt);
+  }
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+static void CostState(const SmCostAnnots_t* annots, FwSmDesc_t smDesc, FwSmCounterS1_t i, FwSmCounterU2_t transId,
+                      FwSmCost_t* cost) {
+  SmBaseDesc_t*   smBase  = smDesc->smBase;
+  SmPState_t*     pState  = &(smBase->pStates[i]);
+  FwSmDesc_t      esmDesc = CostEsm(smDesc, i);
+  SmTrans_t*      trans;
+  FwSmCost_t      guards, alt, emb, stop, exec, worst;
+  FwSmCounterS1_t j;
+
+  CostInit(cost);
+  if (transId == FW_TR_EXECUTE) {
+    CostAction(annots, smDesc, pState->iDoAction, cost);
+  }
+
+  /* The embedded state machine reacts first to the transition command */
+  CostInit(&stop);
+  if (esmDesc != NULL) {
+    CostAnyState(annots, esmDesc, transId, &emb);
+    CostAdd(cost, &emb, 1);
+    CostStop(annots, esmDesc, &stop);
+  }
+
+  /* The guards of the transitions which respond to the command are evaluated until one is
+   * true: the worst case is taken over the transition which is fired and the case where no
+   * guard is true */
+  CostInit(&guards);
+  CostInit(&worst);
+  for (j = 0; j < pState->nOfOutTrans; j++) {
+    trans = &(smBase->trans[pState->outTransIndex + j]);
+    if (trans->id != transId) {
+      continue;
+    }
+    CostGuard(annots, smDesc, trans->iTrGuard, &guards);
+    alt = guards;
+    if (esmDesc != NULL) {
+      CostAdd(&alt, &stop, 1);
+    }
+    CostAction(annots, smDesc, pState->iExitAction, &alt);
+    CostExecTrans(annots, smDesc, trans, &exec);
+    CostAdd(&alt, &exec, 0);
+    CostMax(&worst, &alt);
+  }
+  CostMax(&worst, &guards);
+  CostAdd(cost, &worst, 0);
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+static void CostAnyState(const SmCostAnnots_t* annots, FwSmDesc_t smDesc, FwSmCounterU2_t transId, FwSmCost_t* cost) {
+  FwSmCost_t      alt;
+  FwSmCounterS1_t i;
+
+  CostInit(cost);
+  for (i = 0; i < smDesc->smBase->nOfPStates; i++) {
+    CostState(annots, smDesc, i, transId, &alt);
+    CostMax(cost, &alt);
+  }
+}
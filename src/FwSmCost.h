@@ -0,0 +1,122 @@
+/**
+ * @file
+ * @ingroup smGroup
+ * Declaration of the step cost analysis interface for a FW State Machine.
+ * The functions declared in this file compute, from the configuration of a state
+ * machine and of the state machines embedded in it (recursively), an upper bound on
+ * the work done by one call to <code>::FwSmStart</code>, <code>::FwSmStop</code>,
+ * <code>::FwSmMakeTrans</code> or <code>::FwSmExecute</code>.
+ * The bound is expressed as a <code>::FwSmCost_t</code> which holds the maximum number
+ * of actions which are executed, the maximum number of guards which are evaluated,
+ * the maximum depth of the chain of nested state machines which are involved and the
+ * maximum cost of the step.
+ *
+ * The analysis follows the execution paths of the <code>Core</code> module:
+ * - the do-actions of the current states are executed top-down when the "Execute"
+ *   transition command is processed;
+ * - the transition command is then processed by each state machine in the chain of
+ *   embedded state machines from the innermost to the outermost one (the states of
+ *   the embedded state machines may be any of their states);
+ * - all the guards of the out-going transitions which respond to the command may be
+ *   evaluated before a transition is fired (or no transition is fired);
+ * - when a transition is fired, the embedded state machine of the source state is
+ *   stopped, the exit action of the source state, the transition action, the guards
+ *   and the action of a transition out of a choice pseudo-state, the entry action of
+ *   the destination state are executed and the embedded state machine of the
+ *   destination state is started.
+ * .
+ * Since a transition out of a choice pseudo-state cannot lead to another choice
+ * pseudo-state and the state machines are nested in a finite hierarchy, the bound
+ * always exists.
+ * Guard memoization (see <code>::FwSmSetGuardPure</code>) and the short-cuts for
+ * execute-inert states (see <code>::FwSmIsExecInert</code>) can only reduce the work
+ * done in a step and they are ignored by the analysis.
+ *
+ * The cost of each action and guard is taken from an optional array of cost
+ * annotations (see <code>::FwSmCostAnnot_t</code>) which associates a cost to the
+ * function pointers of the actions and guards.
+ * The dummy action and guard (the ones which are used when an action or guard is not
+ * defined) have a cost of zero and the actions and guards which are not annotated
+ * have a cost of one.
+ * Hence, without annotations, the cost of a step is the number of calls to actions
+ * and guards defined by the user.
+ *
+ * The analysis only reads the configuration of the state machines: it does not matter
+ * whether they are started or stopped.
+ * For a state whose embedded state machine is lazily instantiated (see
+ * <code>::FwSmEmbedLazy</code>) and has not yet been instantiated, the template of the
+ * embedded state machine is analysed.
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2011, All Rights Reserved
+ *
+ * This file is part of the FW Profile.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#ifndef FWSM_COST_H_
+#define FWSM_COST_H_
+
+#include "FwSmCore.h"
+
+/**
+ * Compute the worst-case cost of starting a state machine with <code>::FwSmStart</code>.
+ * The state machine and its embedded state machines are checked with
+ * <code>::FwSmCheckRec</code>.
+ * @param smDesc the descriptor of the state machine.
+ * @param annots the cost annotations of the actions and guards (or NULL if there are
+ * no annotations).
+ * @param nOfAnnots the number of cost annotations.
+ * @param cost the worst-case cost of the step (only set if the function returns
+ * <code>#smSuccess</code>).
+ * @return <code>#smSuccess</code> or the outcome of <code>::FwSmCheckRec</code> if the
+ * state machine did not pass its configuration check.
+ */
+FwSmErrCode_t FwSmCostStart(FwSmDesc_t smDesc, const FwSmCostAnnot_t* annots, FwSmCounterU4_t nOfAnnots,
+                            FwSmCost_t* cost);
+
+/**
+ * Compute the worst-case cost of stopping a state machine with <code>::FwSmStop</code>.
+ * The worst case is taken over all the states of the state machine and of its
+ * embedded state machines.
+ * The parameters and return values are the same as for <code>::FwSmCostStart</code>.
+ * @param smDesc the descriptor of the state machine.
+ * @param annots the cost annotations of the actions and guards (or NULL).
+ * @param nOfAnnots the number of cost annotations.
+ * @param cost the worst-case cost of the step.
+ * @return <code>#smSuccess</code> or the outcome of <code>::FwSmCheckRec</code>.
+ */
+FwSmErrCode_t FwSmCostStop(FwSmDesc_t smDesc, const FwSmCostAnnot_t* annots, FwSmCounterU4_t nOfAnnots,
+                           FwSmCost_t* cost);
+
+/**
+ * Compute the worst-case cost of sending a transition command to a state machine
+ * with <code>::FwSmMakeTrans</code>.
+ * The current state of the state machine is given as an argument and the worst case
+ * is taken over all the states of its embedded state machines.
+ * If the given current state is zero, the worst case is taken over all the states of
+ * the state machine.
+ * The worst-case cost of a call to <code>::FwSmExecute</code> is the worst-case cost
+ * of the #FW_TR_EXECUTE transition command.
+ * @param smDesc the descriptor of the state machine.
+ * @param stateId the identifier of the current state (or zero for the worst case over
+ * all states).
+ * @param transId the identifier of the transition command.
+ * @param annots the cost annotations of the actions and guards (or NULL if there are
+ * no annotations).
+ * @param nOfAnnots the number of cost annotations.
+ * @param cost the worst-case cost of the step (only set if the function returns
+ * <code>#smSuccess</code>).
+ * @return <code>#smSuccess</code>, <code>#smIllStateId</code> if the state identifier is
+ * negative or greater than the number of states, or the outcome of
+ * <code>::FwSmCheckRec</code> if the state machine did not pass its configuration check.
+ */
+FwSmErrCode_t FwSmCostMakeTrans(FwSmDesc_t smDesc, FwSmCounterS1_t stateId, FwSmCounterU2_t transId,
+                                const FwSmCostAnnot_t* annots, FwSmCounterU4_t nOfAnnots, FwSmCost_t* cost);
+
+#endif /* FWSM_COST_H_ */
@@ -16,34 +16,198 @@
  */
 
 #include "FwSmDCreate.h"
+#include "FwSmConfig.h"
 #include "FwSmPrivate.h"
 #include <stdlib.h>
+#include <string.h>
 
-/* ----------------------------------------------------------------------------------------------------------------- */
-FwSmDesc_t FwSmCreate(FwSmCounterS1_t nOfStates, FwSmCounterS1_t nOfChoicePseudoStates, FwSmCounterS1_t nOfTrans,
-                      FwSmCounterS1_t nOfActions, FwSmCounterS1_t nOfGuards) {
+/**
+ * Union of the types held in the sections of a state machine arena.
+ * The size of this union is used as the alignment of the sections within the arena.
+ */
+typedef union {
+  /** A data pointer. */
+  void* p;
+  /** A function pointer. */
+  FwSmAction_t a;
+  /** An integer. */
+  FwSmCounterU4_t n;
+} SmArenaAlign_t;
 
-  FwSmCounterS1_t i;
-  SmBaseDesc_t*   smBase;
-  FwSmDesc_t      smDesc;
+/** The value of the first word of a state machine image ("FWSM" in ASCII). */
+#define SM_IMAGE_MAGIC 0x4657534DUL
 
-  if (nOfTrans < 1) {
-    return NULL;
-  }
+/**
+ * Header of a state machine image (see <code>::FwSmExportImage</code>).
+ * The header is located at the start of the image and it is followed by the
+ * sections which hold the arrays of the base descriptor of the exported state
+ * machine.
+ * The sections are located through their offsets from the start of the image
+ * and each section is aligned to the size of <code>::SmArenaAlign_t</code>.
+ * Field <code>layout</code> holds the sizes of the types of the array elements
+ * and of <code>::SmArenaAlign_t</code> (one byte each) and is used to detect
+ * images which were created with a different memory layout.
+ * Field <code>checksum</code> holds the 32-bit FNV-1a hash of the image bytes
+ * which follow the header.
+ */
+typedef struct {
+  /** the magic number (<code>#SM_IMAGE_MAGIC</code>) */
+  FwSmCounterU4_t magic;
+  /** the version of the image format (<code>#FW_SM_IMAGE_VERSION</code>) */
+  FwSmCounterU4_t version;
+  /** the memory layout of the image */
+  FwSmCounterU4_t layout;
+  /** the size of the image in bytes */
+  FwSmCounterU4_t size;
+  /** the checksum of the image */
+  FwSmCounterU4_t checksum;
+  /** the number of proper states */
+  FwSmCounterU4_t nOfPStates;
+  /** the number of choice pseudo-states */
+  FwSmCounterU4_t nOfCStates;
+  /** the number of transitions */
+  FwSmCounterU4_t nOfTrans;
+  /** the number of actions (excluding the dummy action) */
+  FwSmCounterU4_t nOfActions;
+  /** the number of guards (excluding the dummy guard) */
+  FwSmCounterU4_t nOfGuards;
+  /** the offset of the array of proper states */
+  FwSmCounterU4_t pStatesOffset;
+  /** the offset of the array of choice pseudo-states */
+  FwSmCounterU4_t cStatesOffset;
+  /** the offset of the array of transitions */
+  FwSmCounterU4_t transOffset;
+  /** the offset of the transition dispatch table */
+  FwSmCounterU4_t transDispOffset;
+} SmImageHeader_t;
 
-  if (nOfStates < 0) {
-    return NULL;
-  }
+/**
+ * Round a size in bytes up to the alignment of the sections of a state machine arena.
+ * @param n the size to be rounded up
+ * @return the rounded-up size
+ */
+static FwSmCounterU4_t SmArenaRound(FwSmCounterU4_t n);
 
-  if (nOfChoicePseudoStates < 0) {
-    return NULL;
-  }
+/**
+ * Check the legality of the size parameters of a new state machine.
+ * The constraints on the parameters are those of function <code>::FwSmCreate</code>.
+ * @param nOfStates the number of states
+ * @param nOfChoicePseudoStates the number of choice pseudo-states
+ * @param nOfTrans the number of transitions
+ * @param nOfActions the number of actions
+ * @param nOfGuards the number of guards
+ * @return 1 if the parameters are legal or 0 otherwise
+ */
+static FwSmBool_t SmIsLegalSize(FwSmCounterS1_t nOfStates, FwSmCounterS1_t nOfChoicePseudoStates,
+                                FwSmCounterS1_t nOfTrans, FwSmCounterS1_t nOfActions, FwSmCounterS1_t nOfGuards);
 
-  if (nOfActions < 0) {
-    return NULL;
-  }
+/**
+ * Initialize a newly created state machine descriptor.
+ * The arrays of the state machine descriptor must already have been allocated
+ * and linked to the descriptor.
+ * This function initializes their content and the scalar attributes of the
+ * descriptor.
+ * The transition dispatch table is set to NULL.
+ * @param smDesc the state machine descriptor
+ * @param nOfStates the number of states
+ * @param nOfChoicePseudoStates the number of choice pseudo-states
+ * @param nOfTrans the number of transitions
+ * @param nOfActions the number of actions (excluding the dummy action)
+ * @param nOfGuards the number of guards (excluding the dummy guard)
+ */
+static void SmInitDesc(FwSmDesc_t smDesc, FwSmCounterS1_t nOfStates, FwSmCounterS1_t nOfChoicePseudoStates,
+                       FwSmCounterS1_t nOfTrans, FwSmCounterS1_t nOfActions, FwSmCounterS1_t nOfGuards);
 
-  if (nOfGuards < 0) {
+/**
+ * Lay out the descriptor of a new state machine in a memory block.
+ * The memory block must be at least as large as the value returned by
+ * <code>::FwSmGetArenaSize</code> for the same state machine parameters.
+ * The descriptor is placed at the first address in the block which is aligned to
+ * <code>#FW_SM_ARENA_ALIGN</code>.
+ * The distance between this address and the start of the block is stored in the
+ * byte immediately preceding it.
+ * @param block the memory block
+ * @param nOfStates the number of states
+ * @param nOfChoicePseudoStates the number of choice pseudo-states
+ * @param nOfTrans the number of transitions
+ * @param nOfActions the number of actions
+ * @param nOfGuards the number of guards
+ * @return the descriptor of the new state machine
+ */
+static FwSmDesc_t SmLayOutArena(unsigned char* block, FwSmCounterS1_t nOfStates, FwSmCounterS1_t nOfChoicePseudoStates,
+                                FwSmCounterS1_t nOfTrans, FwSmCounterS1_t nOfActions, FwSmCounterS1_t nOfGuards);
+
+/**
+ * Compute the layout of a state machine image.
+ * The magic number, the version, the memory layout, the offsets of the sections and the size
+ * of the image are set in the argument header from the numbers of states, choice pseudo-states
+ * and transitions which it holds.
+ * The checksum is set to zero.
+ * @param header the header of the image
+ * @return the size of the image in bytes
+ */
+static FwSmCounterU4_t SmImageLayOut(SmImageHeader_t* header);
+
+/**
+ * Compute the checksum of a sequence of bytes in a state machine image.
+ * @param bytes the sequence of bytes
+ * @param n the number of bytes
+ * @return the 32-bit FNV-1a hash of the bytes
+ */
+static FwSmCounterU4_t SmImageChecksum(const unsigned char* bytes, FwSmCounterU4_t n);
+
+/**
+ * Check whether a memory block holds a valid state machine image.
+ * The image is valid if its start is aligned to the size of <code>::SmArenaAlign_t</code>,
+ * if its header is consistent with the layout computed by <code>::SmImageLayOut</code>,
+ * if it fits in the memory block, if its checksum is correct and if its content is valid
+ * (see <code>::SmIsValidContent</code>).
+ * @param image the memory block
+ * @param imageSize the size of the memory block in bytes
+ * @return 1 if the image is valid or 0 otherwise
+ */
+static FwSmBool_t SmIsValidImage(const void* image, FwSmCounterU4_t imageSize);
+
+/**
+ * Check whether the arrays of a state machine image only hold indices which are within
+ * the bounds of the arrays which they index.
+ * The content is valid if:
+ * - the out-going transitions of each state and choice pseudo-state are within the
+ *   transition array;
+ * - the destination of each transition is a proper state, a choice pseudo-state or the
+ *   final pseudo-state and its action and guard are within the action and guard arrays;
+ * - the actions of each state are within the action array;
+ * - the sorted section of the dispatch table of each state only holds out-going transitions
+ *   of the state;
+ * - the direct-index section of the dispatch table of each state which uses it fits in the
+ *   dispatch table and its entries are non-decreasing positions in the sorted section of
+ *   the state.
+ * .
+ * This check protects the state machine functions against images which have a correct
+ * checksum but which were not produced by <code>::FwSmExportImage</code>.
+ * The header of the image must have been checked by <code>::SmIsValidImage</code>.
+ * @param header the header of the image
+ * @return 1 if the content of the image is valid or 0 otherwise
+ */
+static FwSmBool_t SmIsValidContent(const SmImageHeader_t* header);
+
+/**
+ * Release the lazily embedded state machines of a state machine which have been
+ * instantiated (or return them to their pool) and release its lazy embedding data
+ * (unless they are shared with the state machine from which it is derived).
+ * This function does nothing if the state machine has no lazy embedding data.
+ * @param smDesc the descriptor of the state machine
+ */
+static void SmReleaseLazy(FwSmDesc_t smDesc);
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+FwSmDesc_t FwSmCreate(FwSmCounterS1_t nOfStates, FwSmCounterS1_t nOfChoicePseudoStates, FwSmCounterS1_t nOfTrans,
+                      FwSmCounterS1_t nOfActions, FwSmCounterS1_t nOfGuards) {
+
+  SmBaseDesc_t* smBase;
+  FwSmDesc_t    smDesc;
+
+  if (SmIsLegalSize(nOfStates, nOfChoicePseudoStates, nOfTrans, nOfActions, nOfGuards) == 0) {
     return NULL;
   }
 
@@ -54,64 +218,375 @@ FwSmDesc_t FwSmCreate(FwSmCounterS1_t nOfStates, FwSmCounterS1_t nOfChoicePseudo
 
   smBase = (SmBaseDesc_t*)malloc(sizeof(SmBaseDesc_t));
   if (smBase == NULL) {
+    free(smDesc);
     return NULL;
   }
 
+  /* Set all array pointers to NULL so that a partially created descriptor can be released */
+  smDesc->smBase    = smBase;
+  smDesc->esmDesc   = NULL;
+  smDesc->smActions = NULL;
+  smDesc->smGuards  = NULL;
+  smDesc->profile   = NULL;
+  smDesc->cfgIndex  = NULL;
+  smDesc->memo      = NULL;
+  smDesc->notify    = NULL;
+  smDesc->bcast     = NULL;
+  smDesc->lazy      = NULL;
+  smDesc->shared    = 0;
+  smBase->pStates   = NULL;
+  smBase->cStates   = NULL;
+  smBase->trans     = NULL;
+  smBase->transDisp = NULL;
+
   if (nOfStates > 0) {
     smBase->pStates = (SmPState_t*)malloc(((FwSmCounterU4_t)(nOfStates)) * sizeof(SmPState_t));
-    if (smBase->pStates == NULL) {
-      return NULL;
-    }
-    for (i = 0; i < nOfStates; i++) {
-      smBase->pStates[i].outTransIndex = 0;
-    }
     smDesc->esmDesc = (struct FwSmDesc**)malloc(((FwSmCounterU4_t)(nOfStates)) * sizeof(FwSmDesc_t));
-    if (smDesc->esmDesc == NULL) {
+    if ((smBase->pStates == NULL) || (smDesc->esmDesc == NULL)) {
+      FwSmRelease(smDesc);
       return NULL;
     }
-    for (i = 0; i < nOfStates; i++) {
-      smDesc->esmDesc[i] = NULL;
-    }
-  }
-  else {
-    smBase->pStates = NULL;
-    smDesc->esmDesc = NULL;
   }
 
   if (nOfChoicePseudoStates > 0) {
     smBase->cStates = (SmCState_t*)malloc(((FwSmCounterU4_t)(nOfChoicePseudoStates)) * sizeof(SmCState_t));
     if (smBase->cStates == NULL) {
+      FwSmRelease(smDesc);
       return NULL;
     }
-    for (i = 0; i < nOfChoicePseudoStates; i++) {
-      smBase->cStates[i].outTransIndex = 0;
+  }
+
+  smBase->trans     = (SmTrans_t*)malloc(((FwSmCounterU4_t)(nOfTrans)) * sizeof(SmTrans_t));
+  smDesc->smActions = (FwSmAction_t*)malloc(((FwSmCounterU4_t)(nOfActions + 1)) * sizeof(FwSmAction_t));
+  smDesc->smGuards  = (FwSmGuard_t*)malloc(((FwSmCounterU4_t)(nOfGuards + 1)) * sizeof(FwSmGuard_t));
+  if ((smBase->trans == NULL) || (smDesc->smActions == NULL) || (smDesc->smGuards == NULL)) {
+    FwSmRelease(smDesc);
+    return NULL;
+  }
+
+  SmInitDesc(smDesc, nOfStates, nOfChoicePseudoStates, nOfTrans, nOfActions, nOfGuards);
+
+  return smDesc;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+FwSmCounterU4_t FwSmGetArenaSize(FwSmCounterS1_t nOfStates, FwSmCounterS1_t nOfChoicePseudoStates,
+                                 FwSmCounterS1_t nOfTrans, FwSmCounterS1_t nOfActions, FwSmCounterS1_t nOfGuards) {
+  FwSmCounterU4_t size;
+
+  if (SmIsLegalSize(nOfStates, nOfChoicePseudoStates, nOfTrans, nOfActions, nOfGuards) == 0) {
+    return 0;
+  }
+
+  /* The first FW_SM_ARENA_ALIGN bytes are reserved for the alignment of the descriptor */
+  size = FW_SM_ARENA_ALIGN;
+  size += SmArenaRound(sizeof(struct FwSmDesc));
+  size += SmArenaRound(sizeof(SmBaseDesc_t));
+  size += SmArenaRound(((FwSmCounterU4_t)(nOfTrans)) * sizeof(SmTrans_t));
+  size += SmArenaRound(((FwSmCounterU4_t)(nOfStates)) * sizeof(SmPState_t));
+  size += SmArenaRound(((FwSmCounterU4_t)(nOfActions + 1)) * sizeof(FwSmAction_t));
+  size += SmArenaRound(((FwSmCounterU4_t)(nOfGuards + 1)) * sizeof(FwSmGuard_t));
+  size += SmArenaRound(((FwSmCounterU4_t)(nOfStates)) * sizeof(FwSmDesc_t));
+  size += SmArenaRound(((FwSmCounterU4_t)(nOfChoicePseudoStates)) * sizeof(SmCState_t));
+  size += SmArenaRound(((FwSmCounterU4_t)SM_DISP_SIZE(nOfTrans)) * sizeof(FwSmCounterS1_t));
+
+  return size;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+FwSmDesc_t FwSmCreateArena(FwSmCounterS1_t nOfStates, FwSmCounterS1_t nOfChoicePseudoStates, FwSmCounterS1_t nOfTrans,
+                           FwSmCounterS1_t nOfActions, FwSmCounterS1_t nOfGuards) {
+  FwSmCounterU4_t size;
+  unsigned char*  block;
+
+  size = FwSmGetArenaSize(nOfStates, nOfChoicePseudoStates, nOfTrans, nOfActions, nOfGuards);
+  if (size == 0) {
+    return NULL;
+  }
+
+  block = (unsigned char*)malloc(size);
+  if (block == NULL) {
+    return NULL;
+  }
+
+  return SmLayOutArena(block, nOfStates, nOfChoicePseudoStates, nOfTrans, nOfActions, nOfGuards);
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+FwSmDesc_t FwSmCreateInBuffer(void* buffer, FwSmCounterU4_t bufSize, FwSmCounterS1_t nOfStates,
+                              FwSmCounterS1_t nOfChoicePseudoStates, FwSmCounterS1_t nOfTrans,
+                              FwSmCounterS1_t nOfActions, FwSmCounterS1_t nOfGuards) {
+  FwSmCounterU4_t size;
+
+  if (buffer == NULL) {
+    return NULL;
+  }
+
+  size = FwSmGetArenaSize(nOfStates, nOfChoicePseudoStates, nOfTrans, nOfActions, nOfGuards);
+  if ((size == 0) || (bufSize < size)) {
+    return NULL;
+  }
+
+  return SmLayOutArena((unsigned char*)buffer, nOfStates, nOfChoicePseudoStates, nOfTrans, nOfActions, nOfGuards);
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+void FwSmReleaseArena(FwSmDesc_t smDesc) {
+  unsigned char* desc = (unsigned char*)smDesc;
+
+  /* Remove the hierarchy of the state machine from its broadcast registry */
+  if (smDesc->bcast != NULL) {
+    SmBcastRemove(smDesc);
+  }
+
+  /* The lazy embedding data, the profiling data, the configuration index, the guard memo and the change
+   * notification data are not in the arena (the array of embedded state machines is in the arena: it is never
+   * shared and it is therefore never replaced by an unshared copy, see FwSmEmbedLazy) */
+  SmReleaseLazy(smDesc);
+  free(smDesc->profile);
+  free(smDesc->cfgIndex);
+  free(smDesc->memo);
+  SmReleaseNotify(smDesc);
+
+  /* The byte before the descriptor holds its offset from the start of the allocated block */
+  free(desc - desc[-1]);
+
+  return;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+FwSmCounterU4_t FwSmGetImageSize(FwSmDesc_t smDesc) {
+  SmImageHeader_t header;
+
+  header.nOfPStates = (FwSmCounterU4_t)smDesc->smBase->nOfPStates;
+  header.nOfCStates = (FwSmCounterU4_t)smDesc->smBase->nOfCStates;
+  header.nOfTrans   = (FwSmCounterU4_t)smDesc->smBase->nOfTrans;
+
+  return SmImageLayOut(&header);
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+FwSmCounterU4_t FwSmExportImage(FwSmDesc_t smDesc, void* buffer, FwSmCounterU4_t bufSize) {
+  FwSmCounterS1_t  i;
+  SmBaseDesc_t*    smBase = smDesc->smBase;
+  unsigned char*   image  = (unsigned char*)buffer;
+  SmImageHeader_t* header = (SmImageHeader_t*)buffer;
+  SmPState_t*      pStates;
+  SmCState_t*      cStates;
+  SmTrans_t*       trans;
+  FwSmCounterS1_t* transDisp;
+  FwSmCounterU4_t  j;
+  FwSmCounterU4_t  size;
+
+  if ((buffer == NULL) || ((((size_t)buffer) % sizeof(SmArenaAlign_t)) != 0)) {
+    return 0;
+  }
+
+  size = FwSmGetImageSize(smDesc);
+  if (bufSize < size) {
+    return 0;
+  }
+
+  /* The dispatch table is part of the image: the state machine must be compiled */
+  if (FwSmCompile(smDesc) != smSuccess) {
+    return 0;
+  }
+
+  /* The image is cleared so that its padding bytes do not depend on the content of the buffer */
+  memset(buffer, 0, (size_t)size);
+  header->nOfPStates = (FwSmCounterU4_t)smBase->nOfPStates;
+  header->nOfCStates = (FwSmCounterU4_t)smBase->nOfCStates;
+  header->nOfTrans   = (FwSmCounterU4_t)smBase->nOfTrans;
+  header->nOfActions = (FwSmCounterU4_t)(smDesc->nOfActions - 1);
+  header->nOfGuards  = (FwSmCounterU4_t)(smDesc->nOfGuards - 1);
+  SmImageLayOut(header);
+
+  pStates   = (SmPState_t*)(void*)(image + header->pStatesOffset);
+  cStates   = (SmCState_t*)(void*)(image + header->cStatesOffset);
+  trans     = (SmTrans_t*)(void*)(image + header->transOffset);
+  transDisp = (FwSmCounterS1_t*)(void*)(image + header->transDispOffset);
+  for (i = 0; i < smBase->nOfPStates; i++) {
+    pStates[i] = smBase->pStates[i];
+  }
+  for (i = 0; i < smBase->nOfCStates; i++) {
+    cStates[i] = smBase->cStates[i];
+  }
+  for (i = 0; i < smBase->nOfTrans; i++) {
+    trans[i] = smBase->trans[i];
+  }
+  for (j = 0; j < (FwSmCounterU4_t)SM_DISP_SIZE(smBase->nOfTrans); j++) {
+    transDisp[j] = smBase->transDisp[j];
+  }
+
+  header->checksum = SmImageChecksum(image + header->pStatesOffset, size - header->pStatesOffset);
+
+  return size;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+FwSmDesc_t FwSmLoadImage(const void* image, FwSmCounterU4_t imageSize, const FwSmAction_t* actions,
+                         FwSmCounterS1_t nOfActions, const FwSmGuard_t* guards, FwSmCounterS1_t nOfGuards) {
+  FwSmCounterS1_t        i;
+  const unsigned char*   bytes  = (const unsigned char*)image;
+  const SmImageHeader_t* header = (const SmImageHeader_t*)image;
+  FwSmCounterS1_t        nOfPStates;
+  FwSmCounterU4_t        size;
+  FwSmCounterU4_t        offset;
+  unsigned char*         block;
+  unsigned char*         next;
+  SmBaseDesc_t*          smBase;
+  FwSmDesc_t             smDesc;
+
+  if (SmIsValidImage(image, imageSize) == 0) {
+    return NULL;
+  }
+
+  if ((nOfActions < 0) || (nOfGuards < 0) || (header->nOfActions != (FwSmCounterU4_t)nOfActions) ||
+      (header->nOfGuards != (FwSmCounterU4_t)nOfGuards)) {
+    return NULL;
+  }
+  for (i = 0; i < nOfActions; i++) {
+    if (actions[i] == NULL) {
+      return NULL;
     }
   }
-  else {
-    smBase->cStates = NULL;
+  for (i = 0; i < nOfGuards; i++) {
+    if (guards[i] == NULL) {
+      return NULL;
+    }
   }
 
-  smBase->trans = (SmTrans_t*)malloc(((FwSmCounterU4_t)(nOfTrans)) * sizeof(SmTrans_t));
-  if (smBase->trans == NULL) {
+  /* Only the descriptor, the base descriptor and the action, guard and embedded state machine
+   * arrays are allocated: the other arrays of the base descriptor are those of the image */
+  nOfPStates = (FwSmCounterS1_t)header->nOfPStates;
+  size       = FW_SM_ARENA_ALIGN;
+  size += SmArenaRound(sizeof(struct FwSmDesc));
+  size += SmArenaRound(sizeof(SmBaseDesc_t));
+  size += SmArenaRound(((FwSmCounterU4_t)(nOfActions + 1)) * sizeof(FwSmAction_t));
+  size += SmArenaRound(((FwSmCounterU4_t)(nOfGuards + 1)) * sizeof(FwSmGuard_t));
+  size += SmArenaRound(((FwSmCounterU4_t)(nOfPStates)) * sizeof(FwSmDesc_t));
+  block = (unsigned char*)malloc(size);
+  if (block == NULL) {
     return NULL;
   }
+
+  /* The memory block is laid out like an arena so that it is released by FwSmReleaseArena */
+  offset   = FW_SM_ARENA_ALIGN - (((FwSmCounterU4_t)block) % FW_SM_ARENA_ALIGN);
+  next     = block + offset;
+  next[-1] = (unsigned char)offset;
+  smDesc   = (FwSmDesc_t)(void*)next;
+  next += SmArenaRound(sizeof(struct FwSmDesc));
+  smBase = (SmBaseDesc_t*)(void*)next;
+  next += SmArenaRound(sizeof(SmBaseDesc_t));
+  smDesc->smActions = (FwSmAction_t*)(void*)next;
+  next += SmArenaRound(((FwSmCounterU4_t)(nOfActions + 1)) * sizeof(FwSmAction_t));
+  smDesc->smGuards = (FwSmGuard_t*)(void*)next;
+  next += SmArenaRound(((FwSmCounterU4_t)(nOfGuards + 1)) * sizeof(FwSmGuard_t));
+  smDesc->esmDesc = (nOfPStates > 0) ? (struct FwSmDesc**)(void*)next : NULL;
+
+  smBase->pStates    = (nOfPStates > 0) ? (SmPState_t*)(void*)(bytes + header->pStatesOffset) : NULL;
+  smBase->cStates    = (header->nOfCStates > 0) ? (SmCState_t*)(void*)(bytes + header->cStatesOffset) : NULL;
+  smBase->trans      = (SmTrans_t*)(void*)(bytes + header->transOffset);
+  smBase->transDisp  = (FwSmCounterS1_t*)(void*)(bytes + header->transDispOffset);
+  smBase->nOfPStates = nOfPStates;
+  smBase->nOfCStates = (FwSmCounterS1_t)header->nOfCStates;
+  smBase->nOfTrans   = (FwSmCounterS1_t)header->nOfTrans;
+  smBase->isCompiled = 1;
+
+  smDesc->smActions[0] = &SmDummyAction;
+  for (i = 0; i < nOfActions; i++) {
+    smDesc->smActions[i + 1] = actions[i];
+  }
+  smDesc->smGuards[0] = &SmDummyGuard;
+  for (i = 0; i < nOfGuards; i++) {
+    smDesc->smGuards[i + 1] = guards[i];
+  }
+  for (i = 0; i < nOfPStates; i++) {
+    smDesc->esmDesc[i] = NULL;
+  }
+
+  /* The state machine is configured as a derived state machine whose base is the image */
+  smDesc->smBase       = smBase;
+  smDesc->curState     = 0;
+  smDesc->smData       = NULL;
+  smDesc->transCnt     = 0;
+  smDesc->nOfActions   = (FwSmCounterS1_t)(nOfActions + 1);
+  smDesc->nOfGuards    = (FwSmCounterS1_t)(nOfGuards + 1);
+  smDesc->smExecCnt    = 0;
+  smDesc->stateExecCnt = 0;
+  smDesc->errCode      = smSuccess;
+  smDesc->profile      = NULL;
+  smDesc->cfgIndex     = NULL;
+  smDesc->memo         = NULL;
+  smDesc->notify       = NULL;
+  smDesc->bcast        = NULL;
+  smDesc->lazy         = NULL;
+  smDesc->shared       = 0;
+
+  return smDesc;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+static FwSmCounterU4_t SmArenaRound(FwSmCounterU4_t n) {
+  FwSmCounterU4_t align = (FwSmCounterU4_t)sizeof(SmArenaAlign_t);
+  return ((n + align - 1) / align) * align;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+static FwSmBool_t SmIsLegalSize(FwSmCounterS1_t nOfStates, FwSmCounterS1_t nOfChoicePseudoStates,
+                                FwSmCounterS1_t nOfTrans, FwSmCounterS1_t nOfActions, FwSmCounterS1_t nOfGuards) {
+  if (nOfTrans < 1) {
+    return 0;
+  }
+
+  if (nOfStates < 0) {
+    return 0;
+  }
+
+  if (nOfChoicePseudoStates < 0) {
+    return 0;
+  }
+
+  if (nOfActions < 0) {
+    return 0;
+  }
+
+  if (nOfGuards < 0) {
+    return 0;
+  }
+
+  /* The dummy action and the dummy guard must fit in the action and guard arrays */
+  if ((nOfActions == FW_SM_COUNTER_S1_MAX) || (nOfGuards == FW_SM_COUNTER_S1_MAX)) {
+    return 0;
+  }
+
+  return 1;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+static void SmInitDesc(FwSmDesc_t smDesc, FwSmCounterS1_t nOfStates, FwSmCounterS1_t nOfChoicePseudoStates,
+                       FwSmCounterS1_t nOfTrans, FwSmCounterS1_t nOfActions, FwSmCounterS1_t nOfGuards) {
+  FwSmCounterS1_t i;
+  SmBaseDesc_t*   smBase = smDesc->smBase;
+
+  for (i = 0; i < nOfStates; i++) {
+    smBase->pStates[i].outTransIndex = 0;
+    smDesc->esmDesc[i]               = NULL;
+  }
+
+  for (i = 0; i < nOfChoicePseudoStates; i++) {
+    smBase->cStates[i].outTransIndex = 0;
+  }
+
   for (i = 0; i < nOfTrans; i++) {
     smBase->trans[i].iTrAction = -1;
   }
 
-  smDesc->smActions = (FwSmAction_t*)malloc(((FwSmCounterU4_t)(nOfActions + 1)) * sizeof(FwSmAction_t));
-  if (smDesc->smActions == NULL) {
-    return NULL;
-  }
   smDesc->smActions[0] = &SmDummyAction;
   for (i = 1; i <= nOfActions; i++) {
     smDesc->smActions[i] = NULL;
   }
 
-  smDesc->smGuards = (FwSmGuard_t*)malloc(((FwSmCounterU4_t)(nOfGuards + 1)) * sizeof(FwSmGuard_t));
-  if (smDesc->smGuards == NULL) {
-    return NULL;
-  }
   smDesc->smGuards[0] = &SmDummyGuard;
   for (i = 1; i <= nOfGuards; i++) {
     smDesc->smGuards[i] = NULL;
@@ -120,7 +595,8 @@ FwSmDesc_t FwSmCreate(FwSmCounterS1_t nOfStates, FwSmCounterS1_t nOfChoicePseudo
   smBase->nOfCStates   = nOfChoicePseudoStates;
   smBase->nOfPStates   = nOfStates;
   smBase->nOfTrans     = nOfTrans;
-  smDesc->smBase       = smBase;
+  smBase->transDisp    = NULL;
+  smBase->isCompiled   = 0;
   smDesc->curState     = 0;
   smDesc->smData       = NULL;
   smDesc->transCnt     = 1;
@@ -129,6 +605,51 @@ FwSmDesc_t FwSmCreate(FwSmCounterS1_t nOfStates, FwSmCounterS1_t nOfChoicePseudo
   smDesc->smExecCnt    = 0;
   smDesc->stateExecCnt = 0;
   smDesc->errCode      = smSuccess;
+  smDesc->profile      = NULL;
+  smDesc->cfgIndex     = NULL;
+  smDesc->memo         = NULL;
+  smDesc->notify       = NULL;
+  smDesc->bcast        = NULL;
+  smDesc->lazy         = NULL;
+  smDesc->shared       = 0;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+static FwSmDesc_t SmLayOutArena(unsigned char* block, FwSmCounterS1_t nOfStates, FwSmCounterS1_t nOfChoicePseudoStates,
+                                FwSmCounterS1_t nOfTrans, FwSmCounterS1_t nOfActions, FwSmCounterS1_t nOfGuards) {
+  FwSmCounterU4_t offset;
+  unsigned char*  next;
+  SmBaseDesc_t*   smBase;
+  FwSmDesc_t      smDesc;
+
+  /* Align the descriptor and record its offset (which is in [1,FW_SM_ARENA_ALIGN]) just before it */
+  offset   = FW_SM_ARENA_ALIGN - (((FwSmCounterU4_t)block) % FW_SM_ARENA_ALIGN);
+  next     = block + offset;
+  next[-1] = (unsigned char)offset;
+
+  /* Carve the sections of the arena in the order in which they are laid out by FwSmGetArenaSize */
+  smDesc = (FwSmDesc_t)(void*)next;
+  next += SmArenaRound(sizeof(struct FwSmDesc));
+  smBase = (SmBaseDesc_t*)(void*)next;
+  next += SmArenaRound(sizeof(SmBaseDesc_t));
+  smBase->trans = (SmTrans_t*)(void*)next;
+  next += SmArenaRound(((FwSmCounterU4_t)(nOfTrans)) * sizeof(SmTrans_t));
+  smBase->pStates = (nOfStates > 0) ? (SmPState_t*)(void*)next : NULL;
+  next += SmArenaRound(((FwSmCounterU4_t)(nOfStates)) * sizeof(SmPState_t));
+  smDesc->smActions = (FwSmAction_t*)(void*)next;
+  next += SmArenaRound(((FwSmCounterU4_t)(nOfActions + 1)) * sizeof(FwSmAction_t));
+  smDesc->smGuards = (FwSmGuard_t*)(void*)next;
+  next += SmArenaRound(((FwSmCounterU4_t)(nOfGuards + 1)) * sizeof(FwSmGuard_t));
+  smDesc->esmDesc = (nOfStates > 0) ? (struct FwSmDesc**)(void*)next : NULL;
+  next += SmArenaRound(((FwSmCounterU4_t)(nOfStates)) * sizeof(FwSmDesc_t));
+  smBase->cStates = (nOfChoicePseudoStates > 0) ? (SmCState_t*)(void*)next : NULL;
+  next += SmArenaRound(((FwSmCounterU4_t)(nOfChoicePseudoStates)) * sizeof(SmCState_t));
+
+  smDesc->smBase = smBase;
+  SmInitDesc(smDesc, nOfStates, nOfChoicePseudoStates, nOfTrans, nOfActions, nOfGuards);
+
+  /* The transition dispatch table is reserved in the arena so that FwSmCompile does not allocate it */
+  smBase->transDisp = (FwSmCounterS1_t*)(void*)next;
 
   return smDesc;
 }
@@ -145,38 +666,36 @@ FwSmDesc_t FwSmCreateDer(FwSmDesc_t smDesc) {
     return NULL;
   }
 
-  /* Create array of embedded state machines in the derived SM */
+  /* Create the arrays of embedded state machines, actions and guards in the derived SM */
+  extSmDesc->esmDesc = NULL;
+  extSmDesc->profile  = NULL;
+  extSmDesc->cfgIndex = NULL;
+  extSmDesc->memo     = NULL;
+  extSmDesc->notify   = NULL;
+  extSmDesc->bcast    = NULL;
+  extSmDesc->lazy     = NULL;
+  extSmDesc->shared   = 0;
   if (smBase->nOfPStates > 0) {
     extSmDesc->esmDesc = (struct FwSmDesc**)malloc(((FwSmCounterU4_t)(smBase->nOfPStates)) * sizeof(FwSmDesc_t));
-    if (extSmDesc->esmDesc == NULL) {
-      return NULL;
-    }
   }
-  else {
-    extSmDesc->esmDesc = NULL;
-  }
-
-  /* Create array of actions in the derived SM */
   extSmDesc->smActions = (FwSmAction_t*)malloc(((FwSmCounterU4_t)(smDesc->nOfActions)) * sizeof(FwSmAction_t));
-  if (extSmDesc->smActions == NULL) {
+  extSmDesc->smGuards  = (FwSmGuard_t*)malloc(((FwSmCounterU4_t)(smDesc->nOfGuards)) * sizeof(FwSmGuard_t));
+  if (((smBase->nOfPStates > 0) && (extSmDesc->esmDesc == NULL)) || (extSmDesc->smActions == NULL) ||
+      (extSmDesc->smGuards == NULL)) {
+    FwSmReleaseDer(extSmDesc);
     return NULL;
   }
+
   for (i = 0; i < smDesc->nOfActions; i++) {
     extSmDesc->smActions[i] = smDesc->smActions[i];
   }
-
-  /* Create array of guards in the derived SM */
-  extSmDesc->smGuards = (FwSmGuard_t*)malloc(((FwSmCounterU4_t)(smDesc->nOfGuards)) * sizeof(FwSmGuard_t));
-  if (extSmDesc->smGuards == NULL) {
-    return NULL;
-  }
   for (i = 0; i < smDesc->nOfGuards; i++) {
     extSmDesc->smGuards[i] = smDesc->smGuards[i];
   }
 
-  /* Create embedded state machines */
+  /* Create embedded state machines (the lazily embedded state machines are only instantiated when needed) */
   for (i = 0; i < smBase->nOfPStates; i++) {
-    if (smDesc->esmDesc[i] != NULL) {
+    if ((smDesc->esmDesc[i] != NULL) && !SmIsLazy(smDesc, i)) {
       extSmDesc->esmDesc[i] = FwSmCreateDer(smDesc->esmDesc[i]);
     }
     else {
@@ -184,6 +703,77 @@ FwSmDesc_t FwSmCreateDer(FwSmDesc_t smDesc) {
     }
   }
 
+  /* Share the lazy embedding data (if any) */
+  if (smDesc->lazy != NULL) {
+    extSmDesc->lazy   = smDesc->lazy;
+    extSmDesc->shared = SM_SHARED_LAZY;
+  }
+
+  extSmDesc->smBase       = smBase;
+  extSmDesc->curState     = 0;
+  extSmDesc->smData       = NULL;
+  extSmDesc->transCnt     = 0;
+  extSmDesc->nOfActions   = smDesc->nOfActions;
+  extSmDesc->nOfGuards    = smDesc->nOfGuards;
+  extSmDesc->errCode      = smDesc->errCode;
+  extSmDesc->smExecCnt    = 0;
+  extSmDesc->stateExecCnt = 0;
+
+  return extSmDesc;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+FwSmDesc_t FwSmCreateDerShared(FwSmDesc_t smDesc) {
+  FwSmCounterS1_t i;
+  SmBaseDesc_t*   smBase = smDesc->smBase;
+  FwSmDesc_t      extSmDesc;
+
+  /* Create descriptor for derived SM */
+  extSmDesc = (FwSmDesc_t)malloc(sizeof(struct FwSmDesc));
+  if (extSmDesc == NULL) {
+    return NULL;
+  }
+
+  /* Share the arrays of embedded state machines, actions and guards of the base SM */
+  extSmDesc->smActions = smDesc->smActions;
+  extSmDesc->smGuards  = smDesc->smGuards;
+  extSmDesc->esmDesc   = smDesc->esmDesc;
+  extSmDesc->shared    = SM_SHARED_ACTIONS | SM_SHARED_GUARDS | SM_SHARED_ESM;
+  extSmDesc->profile   = NULL;
+  extSmDesc->cfgIndex  = NULL;
+  extSmDesc->memo      = NULL;
+  extSmDesc->notify    = NULL;
+  extSmDesc->bcast     = NULL;
+  extSmDesc->lazy      = NULL;
+
+  /* The embedded state machines cannot be shared: if the base SM has any (or if it has lazily
+   * embedded state machines), the derived SM needs its own array of embedded state machines */
+  for (i = 0; i < smBase->nOfPStates; i++) {
+    if (smDesc->esmDesc[i] != NULL) {
+      break;
+    }
+  }
+  if ((i < smBase->nOfPStates) || (smDesc->lazy != NULL)) {
+    extSmDesc->shared  = SM_SHARED_ACTIONS | SM_SHARED_GUARDS;
+    extSmDesc->esmDesc = (struct FwSmDesc**)malloc(((FwSmCounterU4_t)(smBase->nOfPStates)) * sizeof(FwSmDesc_t));
+    if (extSmDesc->esmDesc == NULL) {
+      FwSmReleaseDer(extSmDesc);
+      return NULL;
+    }
+    for (i = 0; i < smBase->nOfPStates; i++) {
+      if ((smDesc->esmDesc[i] != NULL) && !SmIsLazy(smDesc, i)) {
+        extSmDesc->esmDesc[i] = FwSmCreateDerShared(smDesc->esmDesc[i]);
+      }
+      else {
+        extSmDesc->esmDesc[i] = NULL;
+      }
+    }
+  }
+  if (smDesc->lazy != NULL) {
+    extSmDesc->lazy   = smDesc->lazy;
+    extSmDesc->shared = (FwSmCounterU1_t)(extSmDesc->shared | SM_SHARED_LAZY);
+  }
+
   extSmDesc->smBase       = smBase;
   extSmDesc->curState     = 0;
   extSmDesc->smData       = NULL;
@@ -201,6 +791,11 @@ FwSmDesc_t FwSmCreateDer(FwSmDesc_t smDesc) {
 void FwSmRelease(FwSmDesc_t smDesc) {
   SmBaseDesc_t* smBase;
 
+  /* Remove the hierarchy of the state machine from its broadcast registry (while its base descriptor exists) */
+  if (smDesc->bcast != NULL) {
+    SmBcastRemove(smDesc);
+  }
+
   /* Release memory allocated to base descriptor */
   smBase = smDesc->smBase;
   free(smBase->pStates);
@@ -210,6 +805,9 @@ void FwSmRelease(FwSmDesc_t smDesc) {
    * have at least one element, see operation FwSmCreate) */
   free(smBase->trans);
 
+  /* Release the transition dispatch table (this is only allocated if the state machine was compiled) */
+  free(smBase->transDisp);
+
   /* Release memory allocated to base descriptor */
   free(smDesc->smBase);
 
@@ -221,12 +819,37 @@ void FwSmRelease(FwSmDesc_t smDesc) {
 
 /* ----------------------------------------------------------------------------------------------------------------- */
 void FwSmReleaseDer(FwSmDesc_t smDesc) {
+  /* Remove the hierarchy of the state machine from its broadcast registry */
+  if (smDesc->bcast != NULL) {
+    SmBcastRemove(smDesc);
+  }
+
+  /* Release the lazily embedded state machines which have been instantiated and the lazy embedding data */
+  SmReleaseLazy(smDesc);
 
   /* Release pointer to the action and guard arrays (note that both arrays are guaranteed to
-   * have non-zero length) */
-  free(smDesc->smActions);
-  free(smDesc->smGuards);
-  free(smDesc->esmDesc);
+   * have non-zero length) unless they are shared with the base state machine */
+  if ((smDesc->shared & SM_SHARED_ACTIONS) == 0) {
+    free(smDesc->smActions);
+  }
+  if ((smDesc->shared & SM_SHARED_GUARDS) == 0) {
+    free(smDesc->smGuards);
+  }
+  if ((smDesc->shared & SM_SHARED_ESM) == 0) {
+    free(smDesc->esmDesc);
+  }
+
+  /* Release the profiling data (this is only allocated if profiling was enabled) */
+  free(smDesc->profile);
+
+  /* Release the configuration index (this is only allocated until the configuration passes FwSmCheck) */
+  free(smDesc->cfgIndex);
+
+  /* Release the guard memo (this is only allocated if a guard was marked as pure) */
+  free(smDesc->memo);
+
+  /* Release the change notification data (this is only allocated if change notification was enabled) */
+  SmReleaseNotify(smDesc);
 
   /* Release pointer to state machine descriptor */
   free(smDesc);
@@ -239,9 +862,10 @@ void FwSmReleaseDer(FwSmDesc_t smDesc) {
 void FwSmReleaseRec(FwSmDesc_t smDesc) {
   FwSmCounterS1_t i;
 
-  /* Release memory used by the embedded state machines */
+  /* Release memory used by the embedded state machines (the lazily embedded state machines are
+   * released by FwSmReleaseDer) */
   for (i = 0; i < smDesc->smBase->nOfPStates; i++) {
-    if (smDesc->esmDesc[i] != NULL) {
+    if ((smDesc->esmDesc[i] != NULL) && !SmIsLazy(smDesc, i)) {
       FwSmReleaseRec(smDesc->esmDesc[i]);
     }
   }
@@ -251,3 +875,155 @@ void FwSmReleaseRec(FwSmDesc_t smDesc) {
 
   return;
 }
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+static void SmReleaseLazy(FwSmDesc_t smDesc) {
+  FwSmCounterS1_t i;
+
+  if (smDesc->lazy == NULL) {
+    return;
+  }
+  for (i = 0; i < smDesc->smBase->nOfPStates; i++) {
+    if (SmIsLazy(smDesc, i)) {
+      smDesc->lazy->put(smDesc, i, 1);
+    }
+  }
+  if ((smDesc->shared & SM_SHARED_LAZY) == 0) {
+    free(smDesc->lazy->esm);
+    free(smDesc->lazy);
+  }
+  smDesc->lazy = NULL;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+static FwSmCounterU4_t SmImageLayOut(SmImageHeader_t* header) {
+  header->magic   = SM_IMAGE_MAGIC;
+  header->version = FW_SM_IMAGE_VERSION;
+  header->layout  = (FwSmCounterU4_t)((sizeof(SmPState_t) << 24) | (sizeof(SmCState_t) << 16) |
+                                     (sizeof(SmTrans_t) << 8) | sizeof(SmArenaAlign_t));
+  header->checksum = 0;
+
+  header->pStatesOffset   = SmArenaRound(sizeof(SmImageHeader_t));
+  header->cStatesOffset   = header->pStatesOffset + SmArenaRound(header->nOfPStates * sizeof(SmPState_t));
+  header->transOffset     = header->cStatesOffset + SmArenaRound(header->nOfCStates * sizeof(SmCState_t));
+  header->transDispOffset = header->transOffset + SmArenaRound(header->nOfTrans * sizeof(SmTrans_t));
+  header->size =
+      header->transDispOffset + SmArenaRound(SM_DISP_SIZE(header->nOfTrans) * sizeof(FwSmCounterS1_t));
+
+  return header->size;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+static FwSmCounterU4_t SmImageChecksum(const unsigned char* bytes, FwSmCounterU4_t n) {
+  FwSmCounterU4_t i;
+  FwSmCounterU4_t hash = 2166136261UL;
+
+  for (i = 0; i < n; i++) {
+    hash = ((hash ^ bytes[i]) * 16777619UL) & 0xFFFFFFFFUL;
+  }
+
+  return hash;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+static FwSmBool_t SmIsValidImage(const void* image, FwSmCounterU4_t imageSize) {
+  const SmImageHeader_t* header = (const SmImageHeader_t*)image;
+  SmImageHeader_t        layout;
+
+  if ((image == NULL) || ((((size_t)image) % sizeof(SmArenaAlign_t)) != 0) || (imageSize < sizeof(SmImageHeader_t))) {
+    return 0;
+  }
+
+  /* The counts are bounded by the image size before the layout is computed to avoid overflows */
+  if ((header->nOfPStates > imageSize / sizeof(SmPState_t)) || (header->nOfCStates > imageSize / sizeof(SmCState_t)) ||
+      (header->nOfTrans > imageSize / sizeof(SmTrans_t)) || (header->nOfTrans < 1)) {
+    return 0;
+  }
+  if ((header->nOfPStates > FW_SM_COUNTER_S1_MAX) || (header->nOfCStates > FW_SM_COUNTER_S1_MAX) ||
+      (header->nOfTrans > FW_SM_COUNTER_S1_MAX) || (header->nOfActions >= FW_SM_COUNTER_S1_MAX) ||
+      (header->nOfGuards >= FW_SM_COUNTER_S1_MAX)) {
+    return 0;
+  }
+
+  layout.nOfPStates = header->nOfPStates;
+  layout.nOfCStates = header->nOfCStates;
+  layout.nOfTrans   = header->nOfTrans;
+  SmImageLayOut(&layout);
+  if ((header->magic != layout.magic) || (header->version != layout.version) || (header->layout != layout.layout) ||
+      (header->size != layout.size) || (header->pStatesOffset != layout.pStatesOffset) ||
+      (header->cStatesOffset != layout.cStatesOffset) || (header->transOffset != layout.transOffset) ||
+      (header->transDispOffset != layout.transDispOffset) || (header->size > imageSize)) {
+    return 0;
+  }
+
+  if (header->checksum != SmImageChecksum((const unsigned char*)image + header->pStatesOffset,
+                                          header->size - header->pStatesOffset)) {
+    return 0;
+  }
+
+  return SmIsValidContent(header);
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+static FwSmBool_t SmIsValidContent(const SmImageHeader_t* header) {
+  const unsigned char*   bytes      = (const unsigned char*)header;
+  const SmPState_t*      pStates    = (const SmPState_t*)(const void*)(bytes + header->pStatesOffset);
+  const SmCState_t*      cStates    = (const SmCState_t*)(const void*)(bytes + header->cStatesOffset);
+  const SmTrans_t*       trans      = (const SmTrans_t*)(const void*)(bytes + header->transOffset);
+  const FwSmCounterS1_t* transDisp  = (const FwSmCounterS1_t*)(const void*)(bytes + header->transDispOffset);
+  FwSmCounterS1_t        nOfPStates = (FwSmCounterS1_t)header->nOfPStates;
+  FwSmCounterS1_t        nOfCStates = (FwSmCounterS1_t)header->nOfCStates;
+  FwSmCounterS1_t        nOfTrans   = (FwSmCounterS1_t)header->nOfTrans;
+  FwSmCounterS1_t        nOfActions = (FwSmCounterS1_t)header->nOfActions;
+  FwSmCounterS1_t        nOfGuards  = (FwSmCounterS1_t)header->nOfGuards;
+  FwSmCounterS1_t        i, j, first, end, pos;
+  FwSmCounterU4_t        k, iDirect;
+
+  for (i = 0; i < nOfTrans; i++) {
+    if ((trans[i].dest < -nOfCStates) || (trans[i].dest > nOfPStates) || (trans[i].iTrAction < 0) ||
+        (trans[i].iTrAction > nOfActions) || (trans[i].iTrGuard < 0) || (trans[i].iTrGuard > nOfGuards)) {
+      return 0;
+    }
+  }
+
+  for (i = 0; i < nOfCStates; i++) {
+    if ((cStates[i].outTransIndex < 0) || (cStates[i].nOfOutTrans < 0) ||
+        (cStates[i].outTransIndex > nOfTrans - cStates[i].nOfOutTrans)) {
+      return 0;
+    }
+  }
+
+  for (i = 0; i < nOfPStates; i++) {
+    first = pStates[i].outTransIndex;
+    if ((first < 0) || (pStates[i].nOfOutTrans < 0) || (first > nOfTrans - pStates[i].nOfOutTrans)) {
+      return 0;
+    }
+    if ((pStates[i].iEntryAction < 0) || (pStates[i].iEntryAction > nOfActions) || (pStates[i].iDoAction < 0) ||
+        (pStates[i].iDoAction > nOfActions) || (pStates[i].iExitAction < 0) || (pStates[i].iExitAction > nOfActions)) {
+      return 0;
+    }
+    end = (FwSmCounterS1_t)(first + pStates[i].nOfOutTrans);
+    for (j = first; j < end; j++) {
+      if ((transDisp[j] < first) || (transDisp[j] >= end)) {
+        return 0;
+      }
+    }
+    if (pStates[i].dispNOfIds == 0) {
+      continue;
+    }
+    /* The direct-index section of the state holds dispNOfIds+1 positions out of 2*nOfOutTrans entries */
+    if ((FwSmCounterU4_t)pStates[i].dispNOfIds >= 2 * (FwSmCounterU4_t)pStates[i].nOfOutTrans) {
+      return 0;
+    }
+    iDirect = (FwSmCounterU4_t)nOfTrans + 2 * (FwSmCounterU4_t)first;
+    pos     = first;
+    for (k = 0; k <= (FwSmCounterU4_t)pStates[i].dispNOfIds; k++) {
+      if ((transDisp[iDirect + k] < pos) || (transDisp[iDirect + k] > end)) {
+        return 0;
+      }
+      pos = transDisp[iDirect + k];
+    }
+  }
+
+  return 1;
+}
@@ -29,7 +29,24 @@
  * success of calls to <code>malloc</code>.
  * In case of failure, the function aborts and returns a NULL pointer.
  * Memory which had already been allocated at the time the function aborts,
- * is not released.
+ * is released.
+ *
+ * Function <code>::FwSmCreate</code> allocates each array of the state machine
+ * descriptor separately.
+ * Applications which create and release many state machines can instead use the
+ * arena creation functions (<code>::FwSmCreateArena</code> and
+ * <code>::FwSmCreateInBuffer</code>).
+ * These functions place the state machine descriptor and all its arrays in a single
+ * contiguous memory block (the arena) whose start is aligned to
+ * <code>#FW_SM_ARENA_ALIGN</code>.
+ * The arena is either allocated with one call to <code>malloc</code> or it is
+ * provided by the caller.
+ *
+ * The topology of a configured state machine (its states, choice pseudo-states,
+ * transitions and transition dispatch table) can be exported to a binary image with
+ * <code>::FwSmExportImage</code>.
+ * The image can be stored (e.g. in a file or in ROM) and state machines can later be
+ * loaded from it with <code>::FwSmLoadImage</code> without any configuration calls.
  *
  * Applications which do not wish to use dynamic memory allocation can
  * create a state machine descriptor statically using the services offered
@@ -52,13 +69,30 @@
 
 #include "FwSmCore.h"
 
+/**
+ * The alignment in bytes of the state machine descriptors created by the arena
+ * creation functions.
+ * The default value is the size of a cache line on most current processors.
+ * The value must be a power of two in the range [8,128].
+ */
+#ifndef FW_SM_ARENA_ALIGN
+#define FW_SM_ARENA_ALIGN 64
+#endif
+
+/**
+ * The version of the format of the state machine images created by
+ * <code>::FwSmExportImage</code>.
+ * The version is stored in the image and <code>::FwSmLoadImage</code> rejects images
+ * which have a different version.
+ */
+#define FW_SM_IMAGE_VERSION 5
+
 /**
  * Create a new state machine descriptor.
  * This function creates the state machine descriptor and its internal data structures
  * dynamically through calls to <code>malloc</code>.
- * If any of these calls fails, the function aborts and returns NULL.
- * In this case, there may be a memory leak if part of the state machine descriptor memory
- * had been allocated before the function was aborted.
+ * If any of these calls fails, the function releases the memory it had already
+ * allocated and returns NULL.
  *
  * It is legal to create a state machine descriptor with no states or with no choice
  * pseudo-states but it is not legal to create a state machine descriptor with no
@@ -71,11 +105,13 @@
  * positive integer).
  * @param nOfActions the total number of actions (state actions + transition actions) which the
  * user wishes to define for the state machine.
- * The total number of actions must be a non-negative integer.
+ * The total number of actions must be a non-negative integer smaller than
+ * <code>#FW_SM_COUNTER_S1_MAX</code>.
  * If the same action appears more than once in a state machine, it is counted only once.
  * @param nOfGuards the total number of transition guards which the
  * user wishes to define for the state machine.
- * The total number of guards must be a non-negative integer.
+ * The total number of guards must be a non-negative integer smaller than
+ * <code>#FW_SM_COUNTER_S1_MAX</code>.
  * If the same guard appears more than once in a state machine, it is counted only once.
  * @return the descriptor of the new state machine (or NULL if creation of the
  * data structures to hold the state machine descriptor failed or one of the
@@ -154,6 +190,198 @@ FwSmDesc_t FwSmCreate(FwSmCounterS1_t nOfStates, FwSmCounterS1_t nOfChoicePseudo
  */
 FwSmDesc_t FwSmCreateDer(FwSmDesc_t smDesc);
 
+/**
+ * Create the descriptor of a derived state machine which shares the arrays of its base
+ * state machine.
+ * This function is functionally equivalent to <code>::FwSmCreateDer</code> but, instead
+ * of copying the action and guard arrays of the base state machine, the derived state
+ * machine points at them.
+ * A derived state machine only gets its own copy of its action array, guard array or
+ * array of embedded state machines when it first modifies it (i.e. on the first call to
+ * <code>::FwSmOverrideAction</code>, <code>::FwSmOverrideGuard</code> or
+ * <code>::FwSmEmbed</code> respectively).
+ * A derived state machine which is never reconfigured therefore only allocates its
+ * descriptor.
+ *
+ * The embedded state machines of the base state machine are not shared: if the base
+ * state machine has embedded state machines, the derived state machine has its own array
+ * of embedded state machines which holds state machines derived from them with this
+ * same function.
+ *
+ * Since the arrays are shared, the base state machine must not be reconfigured or
+ * released as long as state machines derived from it with this function exist.
+ * If the copy of an array cannot be allocated, the reconfiguration function sets the
+ * error code of the derived state machine to <code>#smOutOfMemory</code>.
+ * The derived state machine is released with <code>::FwSmReleaseDer</code>.
+ * @param smDesc the descriptor of the base state machine. The base state machine
+ * should be a fully and correctly configured state machine (i.e. it should pass
+ * the <code>::FwSmCheck</code> configuration check).
+ * @return the descriptor of the derived state machine (or NULL if creation of the
+ * descriptor failed).
+ */
+FwSmDesc_t FwSmCreateDerShared(FwSmDesc_t smDesc);
+
+/**
+ * Return the size of the arena required to hold a state machine descriptor.
+ * The arena holds the state machine descriptor, its base descriptor, all their
+ * arrays and the transition dispatch table used by <code>::FwSmCompile</code>.
+ * The returned size includes the space required to align the state machine
+ * descriptor to <code>#FW_SM_ARENA_ALIGN</code>.
+ * The parameters of this function are subject to the same constraints as the parameters
+ * of <code>::FwSmCreate</code>.
+ * @param nOfStates the number of states in the new state machine.
+ * @param nOfChoicePseudoStates the number of choice pseudo-states in the new state machine.
+ * @param nOfTrans the number of transitions in the new state machine.
+ * @param nOfActions the total number of actions in the new state machine.
+ * @param nOfGuards the total number of guards in the new state machine.
+ * @return the size of the arena in bytes or zero if one of the function parameters
+ * had an illegal value.
+ */
+FwSmCounterU4_t FwSmGetArenaSize(FwSmCounterS1_t nOfStates, FwSmCounterS1_t nOfChoicePseudoStates,
+                                 FwSmCounterS1_t nOfTrans, FwSmCounterS1_t nOfActions, FwSmCounterS1_t nOfGuards);
+
+/**
+ * Create a new state machine descriptor in a single memory block.
+ * This function is functionally equivalent to <code>::FwSmCreate</code> but it allocates
+ * the state machine descriptor and all its internal data structures through one single
+ * call to <code>malloc</code>.
+ * The size of the allocated memory block is given by <code>::FwSmGetArenaSize</code>.
+ * The state machine descriptor is aligned to <code>#FW_SM_ARENA_ALIGN</code>.
+ *
+ * The transition dispatch table is part of the memory block.
+ * Hence, compiling the state machine with <code>::FwSmCompile</code> does not
+ * allocate any memory.
+ *
+ * A state machine descriptor created by this function must be released with
+ * <code>::FwSmReleaseArena</code>.
+ * It must not be released with <code>::FwSmRelease</code> or <code>::FwSmReleaseRec</code>.
+ * State machines embedded in it are not affected by its release.
+ * State machines derived from it with <code>::FwSmCreateDer</code> share its base
+ * descriptor and are therefore no longer usable after it has been released.
+ * @param nOfStates the number of states in the new state machine (a non-negative number).
+ * @param nOfChoicePseudoStates the number of choice pseudo-states in the new state machine
+ * (a non-negative integer).
+ * @param nOfTrans the number of transitions in the new state machine (a
+ * positive integer).
+ * @param nOfActions the total number of actions (state actions + transition actions) which the
+ * user wishes to define for the state machine (a non-negative integer smaller than
+ * <code>#FW_SM_COUNTER_S1_MAX</code>).
+ * @param nOfGuards the total number of transition guards which the
+ * user wishes to define for the state machine (a non-negative integer smaller than
+ * <code>#FW_SM_COUNTER_S1_MAX</code>).
+ * @return the descriptor of the new state machine (or NULL if the allocation of the
+ * memory block failed or one of the function parameters had an illegal value).
+ */
+FwSmDesc_t FwSmCreateArena(FwSmCounterS1_t nOfStates, FwSmCounterS1_t nOfChoicePseudoStates, FwSmCounterS1_t nOfTrans,
+                           FwSmCounterS1_t nOfActions, FwSmCounterS1_t nOfGuards);
+
+/**
+ * Create a new state machine descriptor in a memory block provided by the caller.
+ * This function is functionally equivalent to <code>::FwSmCreateArena</code> but it does
+ * not allocate any memory: the state machine descriptor and all its internal data structures
+ * are placed in the argument buffer.
+ * The buffer must be at least as large as the value returned by
+ * <code>::FwSmGetArenaSize</code> for the same state machine parameters.
+ * No alignment constraints apply to the buffer.
+ *
+ * The buffer remains owned by the caller.
+ * The state machine descriptor must not be released: it becomes unusable when the
+ * buffer is released or re-used.
+ * @param buffer the memory block where the state machine descriptor is created.
+ * @param bufSize the size of the memory block in bytes.
+ * @param nOfStates the number of states in the new state machine (a non-negative number).
+ * @param nOfChoicePseudoStates the number of choice pseudo-states in the new state machine
+ * (a non-negative integer).
+ * @param nOfTrans the number of transitions in the new state machine (a
+ * positive integer).
+ * @param nOfActions the total number of actions (state actions + transition actions) which the
+ * user wishes to define for the state machine (a non-negative integer smaller than
+ * <code>#FW_SM_COUNTER_S1_MAX</code>).
+ * @param nOfGuards the total number of transition guards which the
+ * user wishes to define for the state machine (a non-negative integer smaller than
+ * <code>#FW_SM_COUNTER_S1_MAX</code>).
+ * @return the descriptor of the new state machine (or NULL if the buffer is NULL or
+ * too small or if one of the function parameters had an illegal value).
+ */
+FwSmDesc_t FwSmCreateInBuffer(void* buffer, FwSmCounterU4_t bufSize, FwSmCounterS1_t nOfStates,
+                              FwSmCounterS1_t nOfChoicePseudoStates, FwSmCounterS1_t nOfTrans,
+                              FwSmCounterS1_t nOfActions, FwSmCounterS1_t nOfGuards);
+
+/**
+ * Return the size of the binary image of a state machine.
+ * The image is created by <code>::FwSmExportImage</code>.
+ * @param smDesc the descriptor of the state machine.
+ * @return the size of the image in bytes.
+ */
+FwSmCounterU4_t FwSmGetImageSize(FwSmDesc_t smDesc);
+
+/**
+ * Export the topology of a state machine to a binary image.
+ * The image holds the states, the choice pseudo-states, the transitions and the
+ * transition dispatch table of the state machine (i.e. the content of its base
+ * descriptor).
+ * It does not hold the actions, the guards, the embedded state machines or the data
+ * of the state machine.
+ * The actions and guards are referred to by their positions in the action and guard
+ * arrays of the state machine, which are the positions in which they were first added
+ * to the state machine during its configuration.
+ *
+ * The state machine is compiled with <code>::FwSmCompile</code> before the image is
+ * created and no image is created if this fails.
+ * Hence, the image always holds a checked topology and state machines loaded from it
+ * are already compiled.
+ *
+ * The image is position-independent: its sections are located through offsets from its
+ * start.
+ * It carries a version number (see <code>#FW_SM_IMAGE_VERSION</code>), a checksum and a
+ * description of the memory layout of the base descriptor arrays.
+ * It can only be loaded by an application which uses the same version of the FW
+ * Profile, the same index width (see <code>#FW_SM_INDEX_WIDTH</code>) and a processor
+ * with the same byte order and alignment rules.
+ * @param smDesc the descriptor of the state machine.
+ * @param buffer the buffer where the image is written (its start must be aligned like a
+ * pointer).
+ * @param bufSize the size of the buffer in bytes.
+ * @return the size of the image in bytes or zero if the buffer is NULL, misaligned or
+ * too small or if the state machine failed to compile.
+ */
+FwSmCounterU4_t FwSmExportImage(FwSmDesc_t smDesc, void* buffer, FwSmCounterU4_t bufSize);
+
+/**
+ * Create a new state machine from a binary image created by <code>::FwSmExportImage</code>.
+ * The base descriptor of the new state machine uses the arrays of the image in place:
+ * they are neither copied nor modified.
+ * The image can therefore be located in read-only memory or in a memory-mapped file
+ * but it must remain valid and unchanged for as long as the state machine (or any state
+ * machine derived from it) is in use.
+ *
+ * The actions and guards of the new state machine are taken from the argument arrays.
+ * The i-th element of <code>actions</code> (<code>guards</code>) is bound to the
+ * action (guard) which was added in the i-th position to the exported state machine.
+ * The new state machine is allocated through one single call to <code>malloc</code>
+ * and it must be released with <code>::FwSmReleaseArena</code>.
+ *
+ * The new state machine behaves like a state machine derived from the exported state
+ * machine: it is already configured and compiled, its actions and guards can be
+ * overridden with <code>::FwSmOverrideAction</code> and <code>::FwSmOverrideGuard</code>
+ * and state machines can be embedded in it with <code>::FwSmEmbed</code>.
+ * Its topology cannot be changed: the configuration functions which add states or
+ * transitions must not be called on it.
+ * @param image the image (its start must be aligned like a pointer).
+ * @param imageSize the size of the image in bytes.
+ * @param actions the actions of the state machine (excluding the dummy action).
+ * @param nOfActions the number of elements of <code>actions</code>.
+ * @param guards the guards of the state machine (excluding the dummy guard).
+ * @param nOfGuards the number of elements of <code>guards</code>.
+ * @return the descriptor of the new state machine (or NULL if the image is misaligned,
+ * truncated or corrupted, if it was created with a different version or memory layout,
+ * if it holds an index which is out of the bounds of the array which it indexes,
+ * if the number of actions or guards does not match the image, if an action or guard
+ * is NULL or if the allocation of the memory block failed).
+ */
+FwSmDesc_t FwSmLoadImage(const void* image, FwSmCounterU4_t imageSize, const FwSmAction_t* actions,
+                         FwSmCounterS1_t nOfActions, const FwSmGuard_t* guards, FwSmCounterS1_t nOfGuards);
+
 /**
  * Release the memory which was allocated when the state machine descriptor.
  * After this operation is called, the state machine descriptor can no longer be used.
@@ -166,6 +394,8 @@ FwSmDesc_t FwSmCreateDer(FwSmDesc_t smDesc);
  *
  * This function only releases the memory of the argument state machine.
  * The memory allocated to embedded state machines is not affected.
+ * If the state machine is in a broadcast registry, the hierarchy which holds it is
+ * removed from the registry (see <code>::FwSmBcastRemove</code>).
  *
  * Use of this function is subject to the following constraints:
  * - It should only be called on a state machine descriptor which was created using
@@ -189,10 +419,13 @@ void FwSmRelease(FwSmDesc_t smDesc);
  *
  * This function only releases the memory of the argument state machine.
  * The memory allocated to embedded state machines is not affected.
+ * If the state machine is in a broadcast registry, the hierarchy which holds it is
+ * removed from the registry (see <code>::FwSmBcastRemove</code>).
  *
  * Use of this function is subject to the following constraints:
  * - It should only be called on a state machine descriptor which was created using
- *   function <code>FwSmCreateDer</code>.
+ *   function <code>FwSmCreateDer</code> or <code>FwSmCreateDerShared</code> (in the latter
+ *   case, the arrays which are still shared with the base state machine are not released).
  * - It should only be called once on the same state machine descriptor.
  * - It should only be called on a state machine descriptor which is correctly
  *   configured.
@@ -223,4 +456,26 @@ void FwSmReleaseDer(FwSmDesc_t smDesc);
  */
 void FwSmReleaseRec(FwSmDesc_t smDesc);
 
+/**
+ * Release the memory block which was allocated when a state machine descriptor was
+ * created with <code>::FwSmCreateArena</code> or <code>::FwSmLoadImage</code>.
+ * After this operation is called, the state machine descriptor can no longer be used.
+ * The memory is released with one single call to <code>free</code>.
+ *
+ * This function only releases the memory of the argument state machine.
+ * The memory allocated to embedded state machines is not affected (except for the
+ * lazily embedded state machines of a state machine loaded from an image: as for
+ * <code>::FwSmReleaseDer</code>, the lazily embedded state machines which have been
+ * instantiated are released or returned to their pool and the lazy embedding data
+ * are released, see <code>::FwSmEmbedLazy</code>).
+ * Derived state machines which share the base descriptor of the argument state machine
+ * are no longer usable after the function has been called.
+ *
+ * This function should only be called once on a state machine descriptor which was
+ * created using function <code>::FwSmCreateArena</code> or <code>::FwSmLoadImage</code>.
+ * Violation of this constraint may result in memory corruption.
+ * @param smDesc the descriptor of the state machine.
+ */
+void FwSmReleaseArena(FwSmDesc_t smDesc);
+
 #endif /* FWSM_DCREATE_H_ */
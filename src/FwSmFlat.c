@@ -0,0 +1,452 @@
+/**
+ * @file
+ * @ingroup smGroup
+ * Implements the flat execution functions for the FW State Machine Module.
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2011, All Rights Reserved
+ *
+ * This file is part of the FW Profile.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#include "FwSmFlat.h"
+#include "FwSmConfig.h"
+#include "FwSmPrivate.h"
+#include "FwTrace.h"
+#include <stdlib.h>
+
+/**
+ * Count the configurations, the transitions and the path entries which are needed
+ * for the states of a state machine and of its embedded state machines (recursively).
+ * @param smDesc the state machine.
+ * @param depth the number of states in the configurations of the state machine.
+ * @param nOfNodes the number of configurations (incremented by this function).
+ * @param nOfTrans the number of transitions (incremented by this function).
+ * @param nOfPath the number of path entries (incremented by this function).
+ * @return 1 if the state machines can be flattened or 0 if one of them has profiling,
+ * guard memoization or change notification enabled or is in a broadcast registry.
+ */
+static FwSmBool_t FlatCount(FwSmDesc_t smDesc, FwSmCounterU4_t depth, FwSmCounterU4_t* nOfNodes,
+                            FwSmCounterU4_t* nOfTrans, FwSmCounterU4_t* nOfPath);
+
+/**
+ * Return the innermost configuration which is reached from a configuration by walking
+ * down the started embedded state machines.
+ * @param flat the flat state machine.
+ * @param iNode the position of the configuration in the configuration table.
+ * @return the position of the innermost configuration in the configuration table.
+ */
+static FwSmCounterU4_t FlatDescend(FwSmFlatDesc_t flat, FwSmCounterU4_t iNode);
+
+/**
+ * Look for the transition out of the innermost state of a configuration which responds
+ * to a given trigger and which has a true guard.
+ * This function evaluates the guards in the same order as the <code>Core</code> module.
+ * @param node the configuration.
+ * @param trans the transition table.
+ * @param transId the identifier of the transition trigger.
+ * @return the transition to be executed or NULL if no transition out of the state
+ * responds to the trigger with a true guard.
+ */
+static SmTrans_t* FlatFindTrans(SmFlatNode_t* node, SmFlatTrans_t* trans, FwSmCounterU2_t transId);
+
+/**
+ * Execute a transition from the point where the transition action is executed to the
+ * end of the transition and update the current configuration of a flat state machine.
+ * The actions are executed in the same order as in the <code>Core</code> module: the
+ * choice pseudo-states are resolved, the entry action of the destination state is
+ * executed and, if the destination state has an embedded state machine which is
+ * stopped, the embedded state machine is started.
+ * @param flat the flat state machine.
+ * @param iNode the position in the configuration table of the configuration which
+ * encloses the state machine where the transition is executed.
+ * @param smDesc the state machine where the transition is executed.
+ * @param trans the transition.
+ */
+static void FlatExecTrans(FwSmFlatDesc_t flat, FwSmCounterU4_t iNode, FwSmDesc_t smDesc, SmTrans_t* trans);
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+FwSmFlatDesc_t FwSmFlatCreate(FwSmDesc_t smDesc) {
+  FwSmCounterU4_t nOfNodes = 1;
+  FwSmCounterU4_t nOfTrans = 0;
+  FwSmCounterU4_t nOfPath  = 0;
+  FwSmCounterU4_t i, k;
+  FwSmCounterS1_t j, m;
+  SmFlatNode_t*   node;
+  SmFlatNode_t*   parent;
+  SmFlatTrans_t   tmp;
+  SmFlatTrans_t*  trans;
+  SmBaseDesc_t*   smBase;
+  FwSmDesc_t      esmDesc;
+  FwSmFlatDesc_t  flat;
+
+  if (FwSmCheckRec(smDesc) != smSuccess) {
+    return NULL;
+  }
+  if (FlatCount(smDesc, 1, &nOfNodes, &nOfTrans, &nOfPath) == 0) {
+    return NULL;
+  }
+
+  flat = (FwSmFlatDesc_t)malloc(sizeof(struct FwSmFlat));
+  if (flat == NULL) {
+    return NULL;
+  }
+  flat->nodes = (SmFlatNode_t*)malloc(nOfNodes * sizeof(SmFlatNode_t));
+  flat->path  = (FwSmCounterU4_t*)malloc((nOfPath + 1) * sizeof(FwSmCounterU4_t));
+  flat->trans = (SmFlatTrans_t*)malloc((nOfTrans + 1) * sizeof(SmFlatTrans_t));
+  if ((flat->nodes == NULL) || (flat->path == NULL) || (flat->trans == NULL)) {
+    FwSmFlatRelease(flat);
+    return NULL;
+  }
+
+  /* The root configuration is the configuration where the top state machine is stopped */
+  node           = &(flat->nodes[0]);
+  node->smDesc   = smDesc;
+  node->pState   = NULL;
+  node->state    = 0;
+  node->parent   = 0;
+  node->depth    = 0;
+  node->iPath    = 0;
+  node->esmDesc  = smDesc;
+  node->iChild   = 0;
+  node->iTrans   = 0;
+  node->nOfTrans = 0;
+  nOfNodes       = 1;
+  nOfTrans       = 0;
+  nOfPath        = 0;
+
+  /* The configurations are visited in the order in which they are stored: the configurations for the
+   * states of the SM embedded in a configuration are appended to the table when it is visited */
+  for (i = 0; i < nOfNodes; i++) {
+    esmDesc = flat->nodes[i].esmDesc;
+    if (esmDesc == NULL) {
+      continue;
+    }
+    flat->nodes[i].iChild = nOfNodes;
+    smBase                = esmDesc->smBase;
+    for (j = 0; j < smBase->nOfPStates; j++) {
+      parent         = &(flat->nodes[i]);
+      node           = &(flat->nodes[nOfNodes]);
+      node->smDesc   = esmDesc;
+      node->pState   = &(smBase->pStates[j]);
+      node->state    = (FwSmCounterS1_t)(j + 1);
+      node->parent   = i;
+      node->depth    = parent->depth + 1;
+      node->iPath    = nOfPath;
+      node->esmDesc  = esmDesc->esmDesc[j];
+      node->iChild   = 0;
+      node->iTrans   = nOfTrans;
+      node->nOfTrans = (FwSmCounterU4_t)(node->pState->nOfOutTrans);
+      for (k = 0; k < parent->depth; k++) {
+        flat->path[nOfPath + k] = flat->path[parent->iPath + k];
+      }
+      flat->path[nOfPath + parent->depth] = nOfNodes;
+      nOfPath += node->depth;
+
+      /* Sort the out-going transitions by identifier (the insertion sort keeps the order in which
+       * transitions with the same identifier were added to the SM) */
+      trans = &(flat->trans[nOfTrans]);
+      for (m = 0; m < node->pState->nOfOutTrans; m++) {
+        tmp.trans    = &(smBase->trans[node->pState->outTransIndex + m]);
+        tmp.id       = tmp.trans->id;
+        tmp.iTrGuard = tmp.trans->iTrGuard;
+        for (k = (FwSmCounterU4_t)m; (k > 0) && (trans[k - 1].id > tmp.id); k--) {
+          trans[k] = trans[k - 1];
+        }
+        trans[k] = tmp;
+      }
+      nOfTrans += node->nOfTrans;
+      nOfNodes++;
+    }
+  }
+
+  flat->smDesc   = smDesc;
+  flat->nOfNodes = nOfNodes;
+  flat->curNode  = FlatDescend(flat, 0);
+  return flat;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+void FwSmFlatStart(FwSmFlatDesc_t flat) {
+  FwSmDesc_t smDesc = flat->smDesc;
+
+  if (smDesc->curState != 0) { /* Check if SM is already STARTED */
+    return;
+  }
+
+  /* Reset execution counters and execute transition into initial state */
+  smDesc->smExecCnt    = 0;
+  smDesc->stateExecCnt = 0;
+  FlatExecTrans(flat, 0, smDesc, &(smDesc->smBase->trans[0]));
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+void FwSmFlatStop(FwSmFlatDesc_t flat) {
+  SmFlatNode_t* node;
+  FwSmDesc_t    smDesc;
+
+  /* Walk up the current configuration and execute the exit actions innermost-first */
+  while (flat->curNode != 0) {
+    node   = &(flat->nodes[flat->curNode]);
+    smDesc = node->smDesc;
+    smDesc->smActions[node->pState->iExitAction](smDesc);
+    FW_TRACE_EVENT(traceSmStateExit, smDesc, smDesc->curState, 0);
+    smDesc->curState = 0;
+    flat->curNode    = node->parent;
+  }
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+void FwSmFlatMakeTrans(FwSmFlatDesc_t flat, FwSmCounterU2_t transId) {
+  SmFlatNode_t*    nodes = flat->nodes;
+  SmFlatNode_t*    node;
+  FwSmCounterU4_t* path;
+  FwSmCounterU4_t  k;
+  FwSmDesc_t       smDesc;
+  SmTrans_t*       trans;
+
+  /* The path of the current configuration remains valid while it is walked up because a transition
+   * fired at one level only changes the configurations below that level */
+  path = &(flat->path[nodes[flat->curNode].iPath]);
+  k    = nodes[flat->curNode].depth;
+
+  /* If this is the "execute" transition, execute the do-actions top-down */
+  if (transId == FW_TR_EXECUTE) {
+    for (k = 0; k < nodes[flat->curNode].depth; k++) {
+      node   = &(nodes[path[k]]);
+      smDesc = node->smDesc;
+      smDesc->smExecCnt++;
+      smDesc->stateExecCnt++;
+      smDesc->smActions[node->pState->iDoAction](smDesc);
+      FW_TRACE_EVENT(traceSmDoAction, smDesc, node->state, 0);
+    }
+  }
+
+  /* Walk up the configuration so that the innermost SM reacts to the trigger first */
+  while (k > 0) {
+    k--;
+    node  = &(nodes[path[k]]);
+    trans = FlatFindTrans(node, flat->trans, transId);
+    if (trans == NULL) {
+      continue;
+    }
+    /* If the state has a started ESM, stop it before exiting the state */
+    while (flat->curNode != path[k]) {
+      smDesc = nodes[flat->curNode].smDesc;
+      smDesc->smActions[nodes[flat->curNode].pState->iExitAction](smDesc);
+      FW_TRACE_EVENT(traceSmStateExit, smDesc, smDesc->curState, 0);
+      smDesc->curState = 0;
+      flat->curNode    = nodes[flat->curNode].parent;
+    }
+    /* Execute exit action of the state and then the transition */
+    smDesc = node->smDesc;
+    smDesc->smActions[node->pState->iExitAction](smDesc);
+    FW_TRACE_EVENT(traceSmStateExit, smDesc, smDesc->curState, 0);
+    FW_TRACE_EVENT(traceSmTrans, smDesc, transId, smDesc->curState);
+    FlatExecTrans(flat, node->parent, smDesc, trans);
+  }
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+void FwSmFlatExecute(FwSmFlatDesc_t flat) {
+  FwSmFlatMakeTrans(flat, FW_TR_EXECUTE);
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+void FwSmFlatSync(FwSmFlatDesc_t flat) {
+  flat->curNode = FlatDescend(flat, 0);
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+FwSmCounterU4_t FwSmFlatGetNOfConfigs(FwSmFlatDesc_t flat) {
+  return flat->nOfNodes;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+FwSmCounterU4_t FwSmFlatGetNOfLevels(FwSmFlatDesc_t flat) {
+  return flat->nodes[flat->curNode].depth;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+FwSmCounterS1_t FwSmFlatGetCurStateAt(FwSmFlatDesc_t flat, FwSmCounterU4_t level) {
+  SmFlatNode_t* node = &(flat->nodes[flat->curNode]);
+
+  if (level < node->depth) {
+    return flat->nodes[flat->path[node->iPath + level]].state;
+  }
+  if ((level == node->depth) && (node->esmDesc != NULL)) {
+    return 0;
+  }
+  return -1;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+FwSmCounterS1_t FwSmFlatGetCurState(FwSmFlatDesc_t flat) {
+  return FwSmFlatGetCurStateAt(flat, 0);
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+FwSmCounterS1_t FwSmFlatGetCurStateEmb(FwSmFlatDesc_t flat) {
+  if (flat->curNode == 0) {
+    return -1;
+  }
+  return FwSmFlatGetCurStateAt(flat, 1);
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+FwSmDesc_t FwSmFlatGetSmAt(FwSmFlatDesc_t flat, FwSmCounterU4_t level) {
+  SmFlatNode_t* node = &(flat->nodes[flat->curNode]);
+
+  if (level < node->depth) {
+    return flat->nodes[flat->path[node->iPath + level]].smDesc;
+  }
+  if (level == node->depth) {
+    return node->esmDesc;
+  }
+  return NULL;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+void FwSmFlatRelease(FwSmFlatDesc_t flat) {
+  free(flat->nodes);
+  free(flat->path);
+  free(flat->trans);
+  free(flat);
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+static FwSmBool_t FlatCount(FwSmDesc_t smDesc, FwSmCounterU4_t depth, FwSmCounterU4_t* nOfNodes,
+                            FwSmCounterU4_t* nOfTrans, FwSmCounterU4_t* nOfPath) {
+  SmBaseDesc_t*   smBase = smDesc->smBase;
+  FwSmCounterS1_t i;
+
+  if ((smDesc->profile != NULL) || (smDesc->memo != NULL) || (smDesc->notify != NULL) || (smDesc->bcast != NULL) ||
+      (smDesc->lazy != NULL)) {
+    return 0;
+  }
+  for (i = 0; i < smBase->nOfPStates; i++) {
+    (*nOfNodes)++;
+    (*nOfTrans) += (FwSmCounterU4_t)(smBase->pStates[i].nOfOutTrans);
+    (*nOfPath) += depth;
+    if (smDesc->esmDesc[i] != NULL) {
+      if (FlatCount(smDesc->esmDesc[i], depth + 1, nOfNodes, nOfTrans, nOfPath) == 0) {
+        return 0;
+      }
+    }
+  }
+  return 1;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+static FwSmCounterU4_t FlatDescend(FwSmFlatDesc_t flat, FwSmCounterU4_t iNode) {
+  SmFlatNode_t* node = &(flat->nodes[iNode]);
+
+  while ((node->esmDesc != NULL) && (node->esmDesc->curState != 0)) {
+    iNode = node->iChild + (FwSmCounterU4_t)(node->esmDesc->curState) - 1;
+    node  = &(flat->nodes[iNode]);
+  }
+  return iNode;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+static SmTrans_t* FlatFindTrans(SmFlatNode_t* node, SmFlatTrans_t* trans, FwSmCounterU2_t transId) {
+  FwSmDesc_t      smDesc = node->smDesc;
+  FwSmCounterU4_t lo     = node->iTrans;
+  FwSmCounterU4_t end    = node->iTrans + node->nOfTrans;
+  FwSmCounterU4_t hi     = end;
+  FwSmCounterU4_t i, mid;
+  FwSmBool_t      guard;
+
+  /* look for the first transition which responds to trigger tr_id */
+  while (lo < hi) {
+    mid = lo + (hi - lo) / 2;
+    if (trans[mid].id < transId) {
+      lo = mid + 1;
+    }
+    else {
+      hi = mid;
+    }
+  }
+
+  /* evaluate the guards of the transitions which respond to trigger tr_id */
+  for (i = lo; (i < end) && (trans[i].id == transId); i++) {
+    guard = smDesc->smGuards[trans[i].iTrGuard](smDesc);
+    FW_TRACE_EVENT(traceSmGuard, smDesc, transId, guard);
+    if (guard != 0) {
+      return trans[i].trans;
+    }
+  }
+  return NULL;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+static void FlatExecTrans(FwSmFlatDesc_t flat, FwSmCounterU4_t iNode, FwSmDesc_t smDesc, SmTrans_t* trans) {
+  SmCState_t*     cDest;
+  SmTrans_t*      cTrans;
+  FwSmCounterS1_t i;
+  FwSmDesc_t      esmDesc;
+  SmBaseDesc_t*   smBase;
+  FwSmBool_t      guard;
+
+  for (;;) {
+    smBase = smDesc->smBase;
+
+    /* execute transition action */
+    smDesc->smActions[trans->iTrAction](smDesc);
+
+    if (trans->dest < 0) { /* destination is a choice pseudo-state */
+      cDest  = &(smBase->cStates[-(trans->dest) - 1]);
+      cTrans = NULL;
+      for (i = 0; i < cDest->nOfOutTrans; i++) {
+        guard = smDesc->smGuards[smBase->trans[cDest->outTransIndex + i].iTrGuard](smDesc);
+        FW_TRACE_EVENT(traceSmGuard, smDesc, trans->dest, guard);
+        if (guard != 0) {
+          cTrans = &(smBase->trans[cDest->outTransIndex + i]);
+          break;
+        }
+      }
+      if ((cTrans == NULL) || (cTrans->dest < 0)) {
+        if (cTrans != NULL) { /* transition from a CPS to a CPS */
+          smDesc->smActions[cTrans->iTrAction](smDesc);
+        }
+        smDesc->errCode = smTransErr;
+        flat->curNode   = FlatDescend(flat, iNode);
+        return;
+      }
+      /* Execute transition from choice pseudo-state */
+      smDesc->smActions[cTrans->iTrAction](smDesc);
+      trans = cTrans;
+    }
+
+    if (trans->dest == 0) { /* destination is a final pseudo-state */
+      smDesc->curState = 0;
+      flat->curNode    = iNode;
+      return;
+    }
+
+    /* destination is a proper state */
+    smDesc->curState     = trans->dest;
+    smDesc->stateExecCnt = 0;
+    iNode                = flat->nodes[iNode].iChild + (FwSmCounterU4_t)(trans->dest) - 1;
+    /* execute entry action of destination state */
+    smDesc->smActions[flat->nodes[iNode].pState->iEntryAction](smDesc);
+    FW_TRACE_EVENT(traceSmStateEntry, smDesc, trans->dest, 0);
+
+    /* If the destination state has an embedded SM which is not yet started, start it */
+    esmDesc = flat->nodes[iNode].esmDesc;
+    if ((esmDesc == NULL) || (esmDesc->curState != 0)) {
+      flat->curNode = FlatDescend(flat, iNode);
+      return;
+    }
+    esmDesc->smExecCnt    = 0;
+    esmDesc->stateExecCnt = 0;
+    smDesc                = esmDesc;
+    trans                 = &(smDesc->smBase->trans[0]);
+  }
+}
@@ -0,0 +1,210 @@
+/**
+ * @file
+ * @ingroup smGroup
+ * Declaration of the flat execution interface for a FW State Machine.
+ * A flat state machine is a single execution table which is computed from a hierarchy
+ * of state machines.
+ * The hierarchy consists of a state machine and of all the state machines which are
+ * embedded in its states (recursively).
+ *
+ * The configuration space of a hierarchy is the set of combinations of current states
+ * which its state machines can take.
+ * Since a state holds at most one embedded state machine, a configuration is identified
+ * by the innermost current state of the hierarchy and there is one configuration for
+ * each state of each state machine in the hierarchy (plus the configuration where the
+ * state machine at the top of the hierarchy is stopped).
+ * A flat state machine holds one entry for each configuration.
+ * The entry holds:
+ * - the states of the configuration from the outermost to the innermost one (this is
+ *   the sequence in which the do-actions are executed and, in the reverse order, the
+ *   sequence in which the exit actions are executed when the configuration is left);
+ * - the transitions out of the innermost state sorted by their identifiers;
+ * - the position in the table of the configurations entered through the states of the
+ *   state machine embedded in the innermost state.
+ * .
+ * When a transition command is processed by a flat state machine, the state machines
+ * in the current configuration are not resolved by walking down the hierarchy and the
+ * transitions which respond to the command are located through a binary search.
+ *
+ * The basic mode of use of the functions declared in this file is as follows:
+ * -# The hierarchy of state machines is created and configured.
+ * -# The flat state machine is created with function <code>::FwSmFlatCreate</code>.
+ * -# The hierarchy is started, executed and stopped with functions
+ *    <code>::FwSmFlatStart</code>, <code>::FwSmFlatExecute</code>,
+ *    <code>::FwSmFlatMakeTrans</code> and <code>::FwSmFlatStop</code>.
+ * -# The flat state machine is released with function <code>::FwSmFlatRelease</code>.
+ * .
+ * These functions execute the actions and guards of the state machines in the same
+ * order as the corresponding functions of the <code>Core</code> module and they
+ * update the state machine descriptors in the same way (current states, execution
+ * counters, error codes and trace events).
+ * Hence, the state of the hierarchy can still be queried with the functions of the
+ * <code>Core</code> module.
+ * The functions <code>::FwSmFlatGetCurState</code> and <code>::FwSmFlatGetCurStateEmb</code>
+ * answer the same queries directly from the current configuration.
+ *
+ * A flat state machine only knows its current configuration.
+ * If the state of the hierarchy is changed by other means than the functions declared
+ * in this file (e.g. by calling <code>::FwSmMakeTrans</code> on one of its state machines
+ * or by restoring a snapshot), the current configuration must be re-computed with
+ * <code>::FwSmFlatSync</code> before the flat state machine is used again.
+ * The topology of the hierarchy must not be modified after the flat state machine has
+ * been created, profiling, guard memoization and change notification must not be
+ * enabled on its state machines, they must not be added to a broadcast registry and
+ * they must not have lazily embedded state machines (see <code>::FwSmEmbedLazy</code>).
+ *
+ * The memory for the flat state machine descriptor is allocated dynamically through
+ * calls to <code>malloc</code> and released through calls to <code>free</code>.
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2011, All Rights Reserved
+ *
+ * This file is part of the FW Profile.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#ifndef FWSM_FLAT_H_
+#define FWSM_FLAT_H_
+
+#include "FwSmCore.h"
+
+/**
+ * Create a flat state machine for a hierarchy of state machines.
+ * The hierarchy is checked with <code>::FwSmCheckRec</code> and its configuration
+ * space is computed.
+ * The current configuration of the flat state machine is computed from the current
+ * states of the hierarchy (which therefore need not be stopped).
+ * @param smDesc the descriptor of the state machine at the top of the hierarchy.
+ * @return the descriptor of the new flat state machine (or NULL if the hierarchy did
+ * not pass its configuration check, if one of its state machines has profiling, guard
+ * memoization or change notification enabled, is in a broadcast registry or has lazily
+ * embedded state machines, or if the creation of the data structures to hold the flat
+ * state machine descriptor failed).
+ */
+FwSmFlatDesc_t FwSmFlatCreate(FwSmDesc_t smDesc);
+
+/**
+ * Start the hierarchy of a flat state machine.
+ * This function is functionally equivalent to calling <code>::FwSmStart</code> on the
+ * state machine at the top of the hierarchy.
+ * @param flat the descriptor of the flat state machine.
+ */
+void FwSmFlatStart(FwSmFlatDesc_t flat);
+
+/**
+ * Stop the hierarchy of a flat state machine.
+ * This function is functionally equivalent to calling <code>::FwSmStop</code> on the
+ * state machine at the top of the hierarchy.
+ * The exit actions of the states of the current configuration are executed from the
+ * innermost to the outermost one.
+ * @param flat the descriptor of the flat state machine.
+ */
+void FwSmFlatStop(FwSmFlatDesc_t flat);
+
+/**
+ * Trigger a transition in the hierarchy of a flat state machine.
+ * This function is functionally equivalent to calling <code>::FwSmMakeTrans</code> on
+ * the state machine at the top of the hierarchy.
+ * @param flat the descriptor of the flat state machine.
+ * @param transId the identifier of the transition trigger.
+ */
+void FwSmFlatMakeTrans(FwSmFlatDesc_t flat, FwSmCounterU2_t transId);
+
+/**
+ * Execute the hierarchy of a flat state machine.
+ * This function is functionally equivalent to calling <code>::FwSmExecute</code> on
+ * the state machine at the top of the hierarchy.
+ * @param flat the descriptor of the flat state machine.
+ */
+void FwSmFlatExecute(FwSmFlatDesc_t flat);
+
+/**
+ * Re-compute the current configuration of a flat state machine from the current
+ * states of its hierarchy.
+ * This function must be called after the state of the hierarchy has been changed by
+ * other means than the functions declared in this file.
+ * @param flat the descriptor of the flat state machine.
+ */
+void FwSmFlatSync(FwSmFlatDesc_t flat);
+
+/**
+ * Return the number of configurations of a flat state machine.
+ * This is the number of states in the hierarchy plus one (for the configuration where
+ * the state machine at the top of the hierarchy is stopped).
+ * @param flat the descriptor of the flat state machine.
+ * @return the number of configurations.
+ */
+FwSmCounterU4_t FwSmFlatGetNOfConfigs(FwSmFlatDesc_t flat);
+
+/**
+ * Return the number of state machines which are started in the current configuration
+ * of a flat state machine.
+ * This is zero if the state machine at the top of the hierarchy is stopped.
+ * @param flat the descriptor of the flat state machine.
+ * @return the number of started state machines.
+ */
+FwSmCounterU4_t FwSmFlatGetNOfLevels(FwSmFlatDesc_t flat);
+
+/**
+ * Return the current state of the state machine at a given level of the current
+ * configuration of a flat state machine.
+ * Level 0 is the state machine at the top of the hierarchy, level 1 is the state
+ * machine embedded in its current state, and so on.
+ * Hence, the values returned for levels 0 and 1 are the same as the values returned
+ * by <code>::FwSmGetCurState</code> and <code>::FwSmGetCurStateEmb</code> for the state
+ * machine at the top of the hierarchy.
+ * @param flat the descriptor of the flat state machine.
+ * @param level the level in the current configuration.
+ * @return the current state of the state machine at the given level (or 0 if that state
+ * machine is stopped) or -1 if there is no state machine at the given level.
+ * For level 0, the function returns 0 if the hierarchy is stopped.
+ */
+FwSmCounterS1_t FwSmFlatGetCurStateAt(FwSmFlatDesc_t flat, FwSmCounterU4_t level);
+
+/**
+ * Return the current state of the state machine at the top of the hierarchy of a flat
+ * state machine.
+ * This function returns the same value as <code>::FwSmGetCurState</code>.
+ * @param flat the descriptor of the flat state machine.
+ * @return the current state of the state machine at the top of the hierarchy (or 0 if
+ * it is stopped).
+ */
+FwSmCounterS1_t FwSmFlatGetCurState(FwSmFlatDesc_t flat);
+
+/**
+ * Return the current state of the state machine embedded in the current state of the
+ * state machine at the top of the hierarchy of a flat state machine.
+ * This function returns the same value as <code>::FwSmGetCurStateEmb</code>.
+ * @param flat the descriptor of the flat state machine.
+ * @return the current state of the embedded state machine (or 0 if it is stopped) or -1
+ * if the state machine at the top of the hierarchy is stopped or its current state has
+ * no embedded state machine.
+ */
+FwSmCounterS1_t FwSmFlatGetCurStateEmb(FwSmFlatDesc_t flat);
+
+/**
+ * Return the state machine at a given level of the current configuration of a flat
+ * state machine.
+ * The levels are defined as for <code>::FwSmFlatGetCurStateAt</code>.
+ * @param flat the descriptor of the flat state machine.
+ * @param level the level in the current configuration.
+ * @return the state machine at the given level or NULL if there is no state machine at
+ * the given level.
+ */
+FwSmDesc_t FwSmFlatGetSmAt(FwSmFlatDesc_t flat, FwSmCounterU4_t level);
+
+/**
+ * Release the memory which was allocated when the flat state machine was created.
+ * After this operation is called, the flat state machine descriptor can no longer be
+ * used.
+ * The state machines in the hierarchy are not affected.
+ * @param flat the descriptor of the flat state machine.
+ */
+void FwSmFlatRelease(FwSmFlatDesc_t flat);
+
+#endif /* FWSM_FLAT_H_ */
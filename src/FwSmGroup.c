@@ -0,0 +1,152 @@
+/**
+ * @file
+ * @ingroup smGroup
+ * Implements the group execution functions for the FW State Machine Module.
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2011, All Rights Reserved
+ *
+ * This file is part of the FW Profile.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#include "FwSmGroup.h"
+#include "FwSmPrivate.h"
+#include <stdlib.h>
+#include <string.h>
+
+/** The "Execute" class of a state which has not yet been scanned in the current group execution. */
+#define SM_EXEC_UNKNOWN 0
+/** The "Execute" class of a state which has no out-going transition triggered by the "Execute" command. */
+#define SM_EXEC_NO_TRANS 1
+/** The "Execute" class of a state which has an out-going transition triggered by the "Execute" command. */
+#define SM_EXEC_TRANS 2
+
+/**
+ * Return the "Execute" class of a proper state of a base descriptor.
+ * @param smBase the base descriptor.
+ * @param pState the proper state.
+ * @return <code>#SM_EXEC_TRANS</code> if the state has an out-going transition triggered
+ * by the "Execute" command or <code>#SM_EXEC_NO_TRANS</code> otherwise.
+ */
+static FwSmCounterU1_t GetExecClass(SmBaseDesc_t* smBase, SmPState_t* pState);
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+FwSmGroupDesc_t FwSmGroupCreate(FwSmDesc_t smDesc, FwSmCounterU4_t maxNOfSms) {
+  FwSmGroupDesc_t group;
+
+  if (maxNOfSms == 0) {
+    return NULL;
+  }
+
+  group = (FwSmGroupDesc_t)malloc(sizeof(struct FwSmGroup));
+  if (group == NULL) {
+    return NULL;
+  }
+
+  group->smDesc    = (FwSmDesc_t*)malloc(maxNOfSms * sizeof(FwSmDesc_t));
+  group->execClass = NULL;
+  if (smDesc->smBase->nOfPStates > 0) {
+    group->execClass =
+        (FwSmCounterU1_t*)malloc(((FwSmCounterU4_t)(smDesc->smBase->nOfPStates)) * sizeof(FwSmCounterU1_t));
+  }
+  if ((group->smDesc == NULL) || ((smDesc->smBase->nOfPStates > 0) && (group->execClass == NULL))) {
+    FwSmGroupRelease(group);
+    return NULL;
+  }
+
+  group->smBase    = smDesc->smBase;
+  group->nOfSms    = 0;
+  group->maxNOfSms = maxNOfSms;
+
+  return group;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+FwSmErrCode_t FwSmGroupAdd(FwSmGroupDesc_t group, FwSmDesc_t smDesc) {
+
+  if (group->nOfSms == group->maxNOfSms) {
+    return smGroupFull;
+  }
+
+  if (smDesc->smBase != group->smBase) {
+    return smWrongBase;
+  }
+
+  group->smDesc[group->nOfSms] = smDesc;
+  group->nOfSms++;
+  return smSuccess;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+FwSmCounterU4_t FwSmGroupGetNOfSms(FwSmGroupDesc_t group) {
+  return group->nOfSms;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+void FwSmGroupStart(FwSmGroupDesc_t group) {
+  FwSmCounterU4_t i;
+
+  for (i = 0; i < group->nOfSms; i++) {
+    FwSmStart(group->smDesc[i]);
+  }
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+void FwSmGroupExecute(FwSmGroupDesc_t group) {
+  FwSmCounterU4_t  i;
+  FwSmCounterS1_t  iCurState;
+  FwSmDesc_t       smDesc;
+  SmBaseDesc_t*    smBase    = group->smBase;
+  SmPState_t*      pStates   = smBase->pStates;
+  FwSmCounterU1_t* execClass = group->execClass;
+
+  /* The "Execute" classes are computed again at each execution in case the configuration has changed */
+  if (execClass != NULL) {
+    memset(execClass, SM_EXEC_UNKNOWN, ((FwSmCounterU4_t)(smBase->nOfPStates)) * sizeof(FwSmCounterU1_t));
+  }
+
+  for (i = 0; i < group->nOfSms; i++) {
+    smDesc    = group->smDesc[i];
+    iCurState = smDesc->curState;
+
+    /* A stopped state machine is not affected by FwSmExecute but its "Execute" command is still traced */
+    if ((iCurState == 0) || (smDesc->esmDesc[iCurState - 1] != NULL)) {
+      FwSmExecute(smDesc);
+      continue;
+    }
+    if (execClass[iCurState - 1] == SM_EXEC_UNKNOWN) {
+      execClass[iCurState - 1] = GetExecClass(smBase, &(pStates[iCurState - 1]));
+    }
+    if (execClass[iCurState - 1] == SM_EXEC_NO_TRANS) {
+      SmExecuteDo(smDesc, pStates[iCurState - 1].iDoAction);
+    }
+    else {
+      FwSmExecute(smDesc);
+    }
+  }
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+void FwSmGroupRelease(FwSmGroupDesc_t group) {
+  free(group->smDesc);
+  free(group->execClass);
+  free(group);
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+static FwSmCounterU1_t GetExecClass(SmBaseDesc_t* smBase, SmPState_t* pState) {
+  FwSmCounterS1_t i;
+
+  for (i = 0; i < pState->nOfOutTrans; i++) {
+    if (smBase->trans[pState->outTransIndex + i].id == FW_TR_EXECUTE) {
+      return SM_EXEC_TRANS;
+    }
+  }
+  return SM_EXEC_NO_TRANS;
+}
@@ -0,0 +1,124 @@
+/**
+ * @file
+ * @ingroup smGroup
+ * Declaration of the group execution interface for a FW State Machine.
+ * A state machine group holds a set of state machines which share the same
+ * base descriptor (typically, a base state machine and state machines derived
+ * from it with <code>::FwSmCreateDer</code> or <code>#FW_SM_INST_DER</code>) and
+ * which are executed together.
+ *
+ * The basic mode of use of the functions declared in this file is as follows:
+ * -# The group is created with function <code>::FwSmGroupCreate</code>.
+ * -# The state machines are added to the group with function <code>::FwSmGroupAdd</code>.
+ * -# The state machines in the group are started with function <code>::FwSmGroupStart</code>.
+ * -# The state machines in the group are executed with function <code>::FwSmGroupExecute</code>.
+ * -# The group is released with function <code>::FwSmGroupRelease</code>.
+ * .
+ * Executing a group is functionally equivalent to calling <code>::FwSmExecute</code>
+ * on each of its state machines in the order in which they were added to the group.
+ * However, the group execution function reads the shared base descriptor once per
+ * execution and it records, for each state of the base descriptor, whether the state
+ * has an out-going transition triggered by the "Execute" command.
+ * The transitions out of a state are therefore scanned at most once per group
+ * execution, however many state machines in the group are in that state.
+ * A state machine whose current state has no such transition and no embedded state
+ * machine is executed without searching for a transition: its execution counters are
+ * incremented and the do-action of its current state is executed.
+ * The other state machines are executed with <code>::FwSmExecute</code>.
+ * In both cases, the group execution records the same trace events as the individual
+ * executions (in particular, one <code>#traceSmExecuteCmd</code> event for each state
+ * machine in the group, including the state machines which are stopped) and it can
+ * be recorded and replayed like them (see <code>FwTrace.h</code>).
+ * It also has the same effect on the guard memo and the profiling data of the state
+ * machines.
+ *
+ * The state machine actions take the state machine descriptor as their argument.
+ * For this reason, the state of each state machine in a group remains stored in its
+ * own descriptor and the group only holds a dense array of pointers to the
+ * descriptors of its state machines.
+ *
+ * The memory for the group descriptor is allocated dynamically through calls
+ * to <code>malloc</code> and released through calls to <code>free</code>.
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2011, All Rights Reserved
+ *
+ * This file is part of the FW Profile.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#ifndef FWSM_GROUP_H_
+#define FWSM_GROUP_H_
+
+#include "FwSmCore.h"
+
+/**
+ * Create a new state machine group.
+ * The group is created for the state machines which share the base descriptor
+ * of the argument state machine.
+ * The argument state machine is not added to the group.
+ *
+ * The information which the group derives from the configuration of the state machine
+ * is computed again at each group execution.
+ * Hence, the state machine may be configured before or after the group is created but
+ * it should be fully and correctly configured (i.e. it should pass the configuration
+ * check implemented by <code>::FwSmCheck</code>) before the group is started.
+ * @param smDesc a state machine whose base descriptor is shared by the state machines
+ * in the group.
+ * @param maxNOfSms the maximum number of state machines in the group (a positive integer).
+ * @return the descriptor of the new group (or NULL if the creation of the data structures
+ * to hold the group descriptor failed or the maximum number of state machines is zero).
+ */
+FwSmGroupDesc_t FwSmGroupCreate(FwSmDesc_t smDesc, FwSmCounterU4_t maxNOfSms);
+
+/**
+ * Add a state machine to a state machine group.
+ * The state machine must share the base descriptor of the group.
+ * The same state machine should not be added more than once to a group.
+ * @param group the descriptor of the group.
+ * @param smDesc the descriptor of the state machine to be added to the group.
+ * @return <code>#smSuccess</code> if the state machine was added to the group,
+ * <code>#smGroupFull</code> if the group already holds its maximum number of state
+ * machines, or <code>#smWrongBase</code> if the state machine does not share the
+ * base descriptor of the group.
+ */
+FwSmErrCode_t FwSmGroupAdd(FwSmGroupDesc_t group, FwSmDesc_t smDesc);
+
+/**
+ * Return the number of state machines in a state machine group.
+ * @param group the descriptor of the group.
+ * @return the number of state machines in the group.
+ */
+FwSmCounterU4_t FwSmGroupGetNOfSms(FwSmGroupDesc_t group);
+
+/**
+ * Start all the state machines in a state machine group.
+ * This function calls <code>::FwSmStart</code> on each state machine in the group in
+ * the order in which they were added to the group.
+ * @param group the descriptor of the group.
+ */
+void FwSmGroupStart(FwSmGroupDesc_t group);
+
+/**
+ * Execute all the state machines in a state machine group.
+ * The state machines in the group are executed in the order in which they were added
+ * to the group and each execution is equivalent to a call to <code>::FwSmExecute</code>.
+ * State machines in the group which are stopped are not affected.
+ * @param group the descriptor of the group.
+ */
+void FwSmGroupExecute(FwSmGroupDesc_t group);
+
+/**
+ * Release the memory which was allocated when the state machine group was created.
+ * After this operation is called, the group descriptor can no longer be used.
+ * The state machines in the group are not affected.
+ * @param group the descriptor of the group.
+ */
+void FwSmGroupRelease(FwSmGroupDesc_t group);
+
+#endif /* FWSM_GROUP_H_ */
@@ -0,0 +1,236 @@
+/**
+ * @file
+ * @ingroup smGroup
+ * Implements the lazy embedding functions for the FW State Machine Module.
+ * The embedded state machines are instantiated and returned by the functions of
+ * <code>FwSmCore.c</code> through the function pointers of the lazy embedding data.
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2011, All Rights Reserved
+ *
+ * This file is part of the FW Profile.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#include "FwSmLazy.h"
+#include "FwSmDCreate.h"
+#include "FwSmPool.h"
+#include "FwSmPrivate.h"
+#include <stdlib.h>
+
+/**
+ * Embed a template in a state of a state machine.
+ * @param smDesc the descriptor of the state machine.
+ * @param stateId the identifier of the state.
+ * @param esmBase the state machine from which the embedded state machine is derived.
+ * @param pool the pool from which the embedded state machine is obtained (or NULL).
+ */
+static void LazyEmbed(FwSmDesc_t smDesc, FwSmCounterS1_t stateId, FwSmDesc_t esmBase, FwSmPoolDesc_t pool);
+
+/**
+ * Give a state machine its own array of embedded state machines and its own lazy
+ * embedding data (the lazy embedding data are allocated if they do not exist).
+ * @param smDesc the descriptor of the state machine.
+ * @return 1 if the state machine has its own array and data or 0 if an allocation
+ * failed (in this case, the error code of the state machine is set to #smOutOfMemory).
+ */
+static FwSmBool_t LazyUnshare(FwSmDesc_t smDesc);
+
+/**
+ * Instantiate the embedded state machine of a state from its template.
+ * This function is called through the <code>get</code> pointer of the lazy embedding data.
+ * @param smDesc the descriptor of the embedding state machine.
+ * @param i the index of the state in the state array of the state machine.
+ * @return the embedded state machine (or NULL if it could not be instantiated).
+ */
+static FwSmDesc_t LazyGet(FwSmDesc_t smDesc, FwSmCounterS1_t i);
+
+/**
+ * Return the instantiated embedded state machine of a state to its pool or release it.
+ * This function is called through the <code>put</code> pointer of the lazy embedding data.
+ * It does nothing if the embedded state machine has not been instantiated or if it was
+ * derived from its template and it is not released.
+ * @param smDesc the descriptor of the embedding state machine.
+ * @param i the index of the state in the state array of the state machine.
+ * @param isRelease 1 if the embedded state machine is released or 0 if it is only
+ * returned to its pool.
+ */
+static void LazyPut(FwSmDesc_t smDesc, FwSmCounterS1_t i, FwSmBool_t isRelease);
+
+/**
+ * Release a derived state machine and the state machines which were derived for its
+ * states (recursively).
+ * @param smDesc the descriptor of the state machine.
+ */
+static void LazyReleaseDer(FwSmDesc_t smDesc);
+
+/**
+ * Set the link to a broadcast registry of all the state machines in a hierarchy.
+ * @param smDesc the state machine at the top of the hierarchy.
+ * @param link the link (or NULL if the hierarchy is removed from its registry).
+ */
+static void LazySetBcast(FwSmDesc_t smDesc, SmBcastLink_t* link);
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+void FwSmEmbedLazy(FwSmDesc_t smDesc, FwSmCounterS1_t stateId, FwSmDesc_t esmBase) {
+  LazyEmbed(smDesc, stateId, esmBase, NULL);
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+void FwSmEmbedLazyPool(FwSmDesc_t smDesc, FwSmCounterS1_t stateId, FwSmPoolDesc_t pool) {
+  LazyEmbed(smDesc, stateId, pool->smDesc, pool);
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+FwSmBool_t FwSmIsEsmLazy(FwSmDesc_t smDesc, FwSmCounterS1_t stateId) {
+  if ((stateId < 1) || (stateId > smDesc->smBase->nOfPStates)) {
+    return 0;
+  }
+  return SmIsLazy(smDesc, (FwSmCounterS1_t)(stateId - 1));
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+static void LazyEmbed(FwSmDesc_t smDesc, FwSmCounterS1_t stateId, FwSmDesc_t esmBase, FwSmPoolDesc_t pool) {
+
+  if (smDesc->transCnt != 0) {
+    smDesc->errCode = smNotDerivedSM;
+    return;
+  }
+
+  if ((stateId < 1) || (stateId > smDesc->smBase->nOfPStates)) {
+    smDesc->errCode = smIllStateId;
+    return;
+  }
+
+  if ((smDesc->esmDesc[stateId - 1] != NULL) || SmIsLazy(smDesc, (FwSmCounterS1_t)(stateId - 1))) {
+    smDesc->errCode = smEsmDefined;
+    return;
+  }
+
+  if (LazyUnshare(smDesc) == 0) {
+    return;
+  }
+
+  smDesc->lazy->esm[stateId - 1].esmBase = esmBase;
+  smDesc->lazy->esm[stateId - 1].pool    = pool;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+static FwSmBool_t LazyUnshare(FwSmDesc_t smDesc) {
+  struct FwSmDesc** esmDesc;
+  SmLazy_t*         lazy;
+  FwSmCounterS1_t   i;
+  FwSmCounterU4_t   nOfPStates = (FwSmCounterU4_t)(smDesc->smBase->nOfPStates);
+
+  if ((smDesc->shared & SM_SHARED_ESM) != 0) {
+    esmDesc = (struct FwSmDesc**)malloc(nOfPStates * sizeof(FwSmDesc_t));
+    if (esmDesc == NULL) {
+      smDesc->errCode = smOutOfMemory;
+      return 0;
+    }
+    for (i = 0; i < smDesc->smBase->nOfPStates; i++) {
+      esmDesc[i] = smDesc->esmDesc[i];
+    }
+    smDesc->esmDesc = esmDesc;
+    smDesc->shared  = (FwSmCounterU1_t)(smDesc->shared & ~SM_SHARED_ESM);
+  }
+
+  if ((smDesc->lazy != NULL) && ((smDesc->shared & SM_SHARED_LAZY) == 0)) {
+    return 1;
+  }
+
+  lazy = (SmLazy_t*)malloc(sizeof(SmLazy_t));
+  if (lazy == NULL) {
+    smDesc->errCode = smOutOfMemory;
+    return 0;
+  }
+  lazy->esm = (SmLazyEsm_t*)malloc(nOfPStates * sizeof(SmLazyEsm_t));
+  if (lazy->esm == NULL) {
+    free(lazy);
+    smDesc->errCode = smOutOfMemory;
+    return 0;
+  }
+  for (i = 0; i < smDesc->smBase->nOfPStates; i++) {
+    if (smDesc->lazy != NULL) {
+      lazy->esm[i] = smDesc->lazy->esm[i];
+    }
+    else {
+      lazy->esm[i].esmBase = NULL;
+      lazy->esm[i].pool    = NULL;
+    }
+  }
+  lazy->get      = &LazyGet;
+  lazy->put      = &LazyPut;
+  smDesc->lazy   = lazy;
+  smDesc->shared = (FwSmCounterU1_t)(smDesc->shared & ~SM_SHARED_LAZY);
+  return 1;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+static FwSmDesc_t LazyGet(FwSmDesc_t smDesc, FwSmCounterS1_t i) {
+  SmLazyEsm_t* esm = &(smDesc->lazy->esm[i]);
+  FwSmDesc_t   esmDesc;
+
+  esmDesc = (esm->pool != NULL) ? FwSmPoolGet(esm->pool) : FwSmCreateDer(esm->esmBase);
+  if (esmDesc == NULL) {
+    smDesc->errCode = smOutOfMemory;
+    return NULL;
+  }
+
+  esmDesc->smData = smDesc->smData;
+  if (smDesc->bcast != NULL) {
+    LazySetBcast(esmDesc, smDesc->bcast);
+  }
+  smDesc->esmDesc[i] = esmDesc;
+  return esmDesc;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+static void LazyPut(FwSmDesc_t smDesc, FwSmCounterS1_t i, FwSmBool_t isRelease) {
+  SmLazyEsm_t* esm     = &(smDesc->lazy->esm[i]);
+  FwSmDesc_t   esmDesc = smDesc->esmDesc[i];
+
+  if ((esmDesc == NULL) || ((esm->pool == NULL) && (isRelease == 0))) {
+    return;
+  }
+
+  if (esmDesc->bcast != NULL) {
+    LazySetBcast(esmDesc, NULL);
+  }
+  smDesc->esmDesc[i] = NULL;
+  if (esm->pool != NULL) {
+    (void)FwSmPoolPut(esm->pool, esmDesc);
+  }
+  else {
+    LazyReleaseDer(esmDesc);
+  }
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+static void LazyReleaseDer(FwSmDesc_t smDesc) {
+  FwSmCounterS1_t i;
+
+  for (i = 0; i < smDesc->smBase->nOfPStates; i++) {
+    if ((smDesc->esmDesc[i] != NULL) && !SmIsLazy(smDesc, i)) {
+      LazyReleaseDer(smDesc->esmDesc[i]);
+    }
+  }
+  FwSmReleaseDer(smDesc);
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+static void LazySetBcast(FwSmDesc_t smDesc, SmBcastLink_t* link) {
+  FwSmCounterS1_t i;
+
+  smDesc->bcast = link;
+  for (i = 0; i < smDesc->smBase->nOfPStates; i++) {
+    if (smDesc->esmDesc[i] != NULL) {
+      LazySetBcast(smDesc->esmDesc[i], link);
+    }
+  }
+}
@@ -0,0 +1,119 @@
+/**
+ * @file
+ * @ingroup smGroup
+ * Declaration of the lazy embedding interface for a FW State Machine.
+ * Lazy embedding allows a state machine to be embedded in a state of another state
+ * machine without being instantiated until the state is entered.
+ * This saves memory in applications with many instances of large hierarchies of state
+ * machines whose embedded state machines are seldom (or never) used.
+ *
+ * Instead of a state machine, a <i>template</i> is embedded in the state with one of
+ * the following functions:
+ * - <code>::FwSmEmbedLazy</code>: the embedded state machine is derived from a state
+ *   machine (with <code>::FwSmCreateDer</code>) when the state is first entered.
+ *   It then stays embedded in the state until the embedding state machine is released.
+ * - <code>::FwSmEmbedLazyPool</code>: the embedded state machine is obtained from a
+ *   state machine pool (with <code>::FwSmPoolGet</code>) each time the state is
+ *   entered and it is returned to the pool (with <code>::FwSmPoolPut</code>) after it
+ *   has been stopped when the state is exited.
+ *   Hence, the embedded state machine only exists while the state is active and the
+ *   embedded state machine is reset each time the state is entered.
+ * .
+ * The embedded state machine is instantiated after the entry action of the state has
+ * been executed and before it is started.
+ * Its data are the data of the embedding state machine.
+ * If the embedded state machine cannot be instantiated, the state is entered without
+ * an embedded state machine and the error code of the embedding state machine is set
+ * to #smOutOfMemory.
+ * The embedded state machine of a state is returned by <code>::FwSmGetEmbSm</code>
+ * (this is NULL until it has been instantiated).
+ *
+ * The templates are configuration data: they are shared by the state machines which
+ * are derived from the state machine on which they are defined (with
+ * <code>::FwSmCreateDer</code> or <code>::FwSmCreateDerShared</code> or from a state
+ * machine pool).
+ * Each derived state machine instantiates its own embedded state machines.
+ * For a state with a template, <code>::FwSmCheckRec</code> checks the template until
+ * the embedded state machine has been instantiated.
+ * The instantiated embedded state machines are released (or returned to their pool)
+ * when the embedding state machine is released with <code>::FwSmReleaseDer</code>,
+ * <code>::FwSmRelease</code>, <code>::FwSmReleaseRec</code> or (for a state machine
+ * loaded from an image) <code>::FwSmReleaseArena</code> or when it is returned to a pool.
+ * The state machines and the pools which are used as templates must therefore only be
+ * released after all the state machines which use them.
+ *
+ * If a hierarchy is in a broadcast registry (see <code>::FwSmBcastAdd</code>), the
+ * embedded state machines are added to the registry when they are instantiated and
+ * removed from it when they are returned to their pool.
+ * Change notification (see <code>::FwSmEnableNotify</code>) only covers the embedded
+ * state machines which were instantiated when it was enabled.
+ * Hierarchies with templates cannot be flattened (see <code>::FwSmFlatCreate</code>)
+ * and the snapshots of a hierarchy (see <code>::FwSmSnapTake</code>) only hold its
+ * instantiated embedded state machines.
+ *
+ * The memory for the templates and for the embedded state machines is allocated
+ * through calls to <code>malloc</code> and released through calls to <code>free</code>.
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2011, All Rights Reserved
+ *
+ * This file is part of the FW Profile.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#ifndef FWSM_LAZY_H_
+#define FWSM_LAZY_H_
+
+#include "FwSmCore.h"
+
+/**
+ * Embed in a state of a derived state machine a template from which the embedded state
+ * machine is derived when the state is first entered.
+ * The embedded state machine is created with <code>::FwSmCreateDer</code> from the
+ * template state machine.
+ * As for <code>::FwSmEmbed</code>, this function is only available for derived state
+ * machines.
+ *
+ * This function reports the following errors in the error code of the state
+ * machine descriptor:
+ * - #smIllStateId: the state identifier is illegal
+ * - #smNotDerivedSM: the state machine is a base state machine
+ * - #smEsmDefined: an embedded state machine or a template is already defined for the
+ *   target state
+ * - #smOutOfMemory: the memory for the template could not be allocated
+ * .
+ * @param smDesc the descriptor of the derived state machine.
+ * @param stateId the identifier of the state where the template is to be embedded.
+ * @param esmBase the descriptor of the state machine from which the embedded state
+ * machine is derived (this must not be NULL).
+ */
+void FwSmEmbedLazy(FwSmDesc_t smDesc, FwSmCounterS1_t stateId, FwSmDesc_t esmBase);
+
+/**
+ * Embed in a state of a derived state machine a template from which the embedded state
+ * machine is obtained each time the state is entered.
+ * The embedded state machine is obtained from the state machine pool when the state is
+ * entered and it is returned to it after it has been stopped when the state is exited.
+ * The parameters and the errors are the same as for <code>::FwSmEmbedLazy</code>.
+ * @param smDesc the descriptor of the derived state machine.
+ * @param stateId the identifier of the state where the template is to be embedded.
+ * @param pool the descriptor of the state machine pool (this must not be NULL).
+ */
+void FwSmEmbedLazyPool(FwSmDesc_t smDesc, FwSmCounterS1_t stateId, FwSmPoolDesc_t pool);
+
+/**
+ * Check whether a state of a state machine has a template of a lazily embedded state
+ * machine.
+ * @param smDesc the descriptor of the state machine.
+ * @param stateId the identifier of the state.
+ * @return 1 if the state has a template or 0 otherwise (or if the state identifier is
+ * illegal).
+ */
+FwSmBool_t FwSmIsEsmLazy(FwSmDesc_t smDesc, FwSmCounterS1_t stateId);
+
+#endif /* FWSM_LAZY_H_ */
@@ -0,0 +1,105 @@
+/**
+ * @file
+ * @ingroup smGroup
+ * Implements the change notification functions for the FW State Machine Module.
+ * The changes of the current state are reported by the functions of
+ * <code>FwSmCore.c</code>.
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2011, All Rights Reserved
+ *
+ * This file is part of the FW Profile.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#include "FwSmNotify.h"
+#include "FwSmPrivate.h"
+#include <stdlib.h>
+
+/**
+ * Enable change notification on a state machine and on its embedded state machines
+ * (recursively).
+ * @param smDesc the descriptor of the state machine.
+ * @param owner the owner of the hierarchy.
+ * @param list the change list of the owner (or NULL).
+ * @return 1 if change notification was enabled on all state machines or 0 if an
+ * allocation failed.
+ */
+static FwSmBool_t EnableNotify(FwSmDesc_t smDesc, FwSmDesc_t owner, FwSmChangeList_t* list);
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+void FwSmInitChangeList(FwSmChangeList_t* list, FwSmDesc_t* buffer, FwSmCounterU4_t size) {
+  list->smDescs    = buffer;
+  list->size       = size;
+  list->nOfChanged = 0;
+  list->nOfLost    = 0;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+void FwSmClearChangeList(FwSmChangeList_t* list) {
+  FwSmCounterU4_t i;
+
+  for (i = 0; i < list->nOfChanged; i++) {
+    list->smDescs[i]->notify->isListed = 0;
+  }
+  list->nOfChanged = 0;
+  list->nOfLost    = 0;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+void FwSmEnableNotify(FwSmDesc_t smDesc, FwSmChangeList_t* list) {
+  if (EnableNotify(smDesc, smDesc, list) == 0) {
+    FwSmDisableNotify(smDesc);
+    smDesc->errCode = smOutOfMemory;
+  }
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+void FwSmDisableNotify(FwSmDesc_t smDesc) {
+  FwSmCounterS1_t i;
+
+  for (i = 0; i < smDesc->smBase->nOfPStates; i++) {
+    if (smDesc->esmDesc[i] != NULL) {
+      FwSmDisableNotify(smDesc->esmDesc[i]);
+    }
+  }
+  SmReleaseNotify(smDesc);
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+FwSmCounterU4_t FwSmGetChangeSeq(FwSmDesc_t smDesc) {
+  if ((smDesc->notify == NULL) || (smDesc->notify->owner->notify == NULL)) {
+    return 0;
+  }
+  return smDesc->notify->owner->notify->changeSeq;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+static FwSmBool_t EnableNotify(FwSmDesc_t smDesc, FwSmDesc_t owner, FwSmChangeList_t* list) {
+  FwSmCounterS1_t i;
+
+  /* A state machine which is already in a change list is removed from it */
+  SmReleaseNotify(smDesc);
+  smDesc->notify = (SmNotify_t*)malloc(sizeof(SmNotify_t));
+  if (smDesc->notify == NULL) {
+    return 0;
+  }
+  smDesc->notify->owner     = owner;
+  smDesc->notify->list      = (smDesc == owner) ? list : NULL;
+  smDesc->notify->changeSeq = 0;
+  smDesc->notify->isListed  = 0;
+
+  for (i = 0; i < smDesc->smBase->nOfPStates; i++) {
+    if (smDesc->esmDesc[i] != NULL) {
+      if (EnableNotify(smDesc->esmDesc[i], owner, list) == 0) {
+        return 0;
+      }
+    }
+  }
+  return 1;
+}
@@ -0,0 +1,137 @@
+/**
+ * @file
+ * @ingroup smGroup
+ * Declaration of the change notification interface for a FW State Machine.
+ * Change notification allows an application which monitors a large number of state
+ * machines to find out which of them have changed state without polling them.
+ *
+ * Change notification is enabled on a state machine with
+ * <code>::FwSmEnableNotify</code>.
+ * It then covers the state machine and all the state machines which are embedded in
+ * its states (recursively).
+ * Whenever the current state of any state machine in this hierarchy changes, the
+ * change is reported to the state machine on which change notification was enabled
+ * (the <i>owner</i> of the hierarchy):
+ * - the change sequence number of the owner is incremented (see
+ *   <code>::FwSmGetChangeSeq</code>) and
+ * - if the owner has a change list and it is not yet in it, the owner is added to
+ *   its change list.
+ * .
+ * The current state changes when a transition leads to a different state or to
+ * the final pseudo-state, when a state machine is started and when it is stopped
+ * (including when an embedded state machine is stopped because its embedding state
+ * is exited).
+ * A self-transition does not change the current state.
+ * Changes are reported when they are made by the functions of <code>FwSmCore.h</code>
+ * and when a snapshot is restored (see <code>::FwSmSnapRestore</code>): the functions
+ * generated by <code>::FwSmGenerateCode</code> do not report them.
+ *
+ * The basic mode of use of the functions declared in this file is as follows:
+ * -# The application initializes a change list with <code>::FwSmInitChangeList</code>
+ *    on a buffer which it provides.
+ * -# Change notification is enabled on each monitored state machine with
+ *    <code>::FwSmEnableNotify</code> (several state machines can share the same
+ *    change list).
+ * -# In each cycle, the application processes the state machines in the change list
+ *    and it then clears the change list with <code>::FwSmClearChangeList</code>.
+ *    If the <code>nOfLost</code> field of the change list is not zero, the change list
+ *    overflowed and the application must poll all the state machines.
+ * .
+ * A state machine is added to its change list at most once until the change list is
+ * cleared.
+ * The cost of change notification on the execution of a state machine on which it is
+ * not enabled is one test of a pointer each time its current state changes.
+ *
+ * The change notification data are allocated with <code>malloc</code> when change
+ * notification is enabled.
+ * They are released by <code>::FwSmDisableNotify</code> and by the functions which
+ * release a state machine created with the <code>DCreate</code> interface (a
+ * released state machine is also removed from its change list).
+ * State machines created with the <code>SCreate</code> interface must be released
+ * with <code>::FwSmDisableNotify</code>.
+ * If the owner of a hierarchy is released without its embedded state machines, change
+ * notification must first be disabled on it with <code>::FwSmDisableNotify</code>.
+ * The functions declared in this file are not thread-safe: the state machines which
+ * share a change list, and the change list itself, must be used by one thread at a
+ * time.
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2011, All Rights Reserved
+ *
+ * This file is part of the FW Profile.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#ifndef FWSM_NOTIFY_H_
+#define FWSM_NOTIFY_H_
+
+#include "FwSmCore.h"
+
+/**
+ * Initialize a change list.
+ * After this function has been executed, the change list is empty.
+ * @param list the change list.
+ * @param buffer the buffer which holds the descriptors of the state machines in the
+ * change list.
+ * @param size the number of descriptors which can be held in the buffer.
+ */
+void FwSmInitChangeList(FwSmChangeList_t* list, FwSmDesc_t* buffer, FwSmCounterU4_t size);
+
+/**
+ * Clear a change list.
+ * The state machines in the change list are removed from it (they are added to
+ * it again when they next change) and the counter of lost changes is reset.
+ * @param list the change list.
+ */
+void FwSmClearChangeList(FwSmChangeList_t* list);
+
+/**
+ * Enable change notification on a state machine and on all the state machines which
+ * are embedded in its states (recursively).
+ * The argument state machine becomes the owner of the hierarchy: the changes of the
+ * current state of any state machine in the hierarchy are reported to it.
+ * Its change sequence number is reset to zero.
+ * If change notification is already enabled on a state machine in the hierarchy, its
+ * owner and its change list are replaced.
+ * The state machines which are embedded after this function has been called are
+ * not covered by change notification (this function must then be called again).
+ *
+ * If the allocation of the change notification data fails, the error code of the
+ * argument state machine is set to #smOutOfMemory and change notification is
+ * disabled on the hierarchy.
+ * @param smDesc the descriptor of the state machine.
+ * @param list the change list to which the state machine is added when it changes (or
+ * NULL if only the change sequence number is used).
+ */
+void FwSmEnableNotify(FwSmDesc_t smDesc, FwSmChangeList_t* list);
+
+/**
+ * Disable change notification on a state machine and on all the state machines which
+ * are embedded in its states (recursively) and release their change notification data.
+ * The state machines are removed from their change lists.
+ * This function has no effect on the state machines on which change notification is
+ * not enabled.
+ * @param smDesc the descriptor of the state machine.
+ */
+void FwSmDisableNotify(FwSmDesc_t smDesc);
+
+/**
+ * Return the change sequence number of the hierarchy to which a state machine
+ * belongs.
+ * The change sequence number is the number of changes of the current state of the
+ * state machines in the hierarchy since change notification was enabled on its
+ * owner.
+ * An application can detect the changes of a hierarchy by comparing its change
+ * sequence number with the value it read earlier.
+ * @param smDesc the descriptor of the state machine.
+ * @return the change sequence number of the hierarchy (or zero if change notification
+ * is not enabled on the state machine).
+ */
+FwSmCounterU4_t FwSmGetChangeSeq(FwSmDesc_t smDesc);
+
+#endif /* FWSM_NOTIFY_H_ */
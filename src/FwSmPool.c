@@ -0,0 +1,421 @@
+/**
+ * @file
+ * @ingroup smGroup
+ * Implements the pool functions for the FW State Machine Module.
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2011, All Rights Reserved
+ *
+ * This file is part of the FW Profile.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#include "FwSmPool.h"
+#include "FwSmAux.h"
+#include "FwSmDCreate.h"
+#include "FwSmPrivate.h"
+#include <pthread.h>
+#include <stdlib.h>
+
+/** Number of state machines moved between a per-thread cache and the pool when the cache is empty or full. */
+#define SM_POOL_BATCH ((FW_SM_POOL_CACHE_SIZE + 1) / 2)
+
+/** Atomically add a value to a counter of a thread-safe pool and return the new value. */
+#define SM_POOL_ATOMIC_ADD(var, val) __sync_add_and_fetch(&(var), (val))
+/** Atomically subtract a value from a counter of a thread-safe pool and return the new value. */
+#define SM_POOL_ATOMIC_SUB(var, val) __sync_sub_and_fetch(&(var), (val))
+/** Atomically set a counter of a thread-safe pool to a new value if it holds an old value and return its old value. */
+#define SM_POOL_ATOMIC_CAS(var, oldVal, newVal) __sync_val_compare_and_swap(&(var), (oldVal), (newVal))
+
+/**
+ * Reset a state machine obtained from a pool to the state of a newly derived state machine.
+ * The actions and guards of the state machine are copied from the pool state machine
+ * and the embedded state machines are reset recursively.
+ * Embedded state machines which are not present in the pool state machine are detached.
+ * @param smDesc the state machine to be reset.
+ * @param poolSmDesc the state machine from which <code>smDesc</code> was derived.
+ */
+static void ResetSm(FwSmDesc_t smDesc, FwSmDesc_t poolSmDesc);
+
+/**
+ * Release a state machine of a pool together with its embedded state machines.
+ * The embedded state machines are those which were derived with
+ * <code>::FwSmCreateDer</code> when the state machine was created.
+ * Each state machine is released with <code>::FwSmReleaseDer</code>.
+ * @param smDesc the state machine to be released.
+ */
+static void ReleaseSm(FwSmDesc_t smDesc);
+
+/**
+ * Update the in-use counter and the high-water mark of a pool after a state machine has
+ * been obtained from it.
+ * @param pool the descriptor of the pool.
+ */
+static void AddInUse(FwSmPoolDesc_t pool);
+
+/**
+ * Return the per-thread cache of the calling thread for a thread-safe pool.
+ * If the calling thread does not yet own a cache, a cache which is not owned by any
+ * thread is assigned to it or, if there is no such cache, a new cache is created.
+ * @param pool the descriptor of the pool.
+ * @return the cache of the calling thread (or NULL if no cache could be assigned to it).
+ */
+static SmPoolCache_t* GetCache(FwSmPoolDesc_t pool);
+
+/**
+ * Return the state machines in a per-thread cache to its pool and make the cache
+ * available to other threads.
+ * This function is called when the thread which owns the cache terminates.
+ * State machines which do not fit in the pool are released.
+ * @param cache the cache.
+ */
+static void ReleaseCache(void* cache);
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+FwSmPoolDesc_t FwSmPoolCreate(FwSmDesc_t smDesc, FwSmCounterU4_t nOfSms, FwSmBool_t threadSafe) {
+  FwSmPoolDesc_t pool;
+  FwSmDesc_t     derSmDesc;
+
+  if (nOfSms == 0) {
+    return NULL;
+  }
+
+  pool = (FwSmPoolDesc_t)malloc(sizeof(struct FwSmPool));
+  if (pool == NULL) {
+    return NULL;
+  }
+
+  pool->freeSms = (FwSmDesc_t*)malloc(nOfSms * sizeof(FwSmDesc_t));
+  if (pool->freeSms == NULL) {
+    free(pool);
+    return NULL;
+  }
+
+  pool->smDesc     = smDesc;
+  pool->nOfFree    = 0;
+  pool->maxNOfFree = nOfSms;
+  pool->nOfInUse   = 0;
+  pool->highWater  = 0;
+  pool->nOfMisses  = 0;
+  pool->threadSafe = threadSafe;
+  pool->caches     = NULL;
+
+  if (threadSafe) {
+    if (pthread_mutex_init(&(pool->mutex), NULL) != 0) {
+      free(pool->freeSms);
+      free(pool);
+      return NULL;
+    }
+    if (pthread_key_create(&(pool->cacheKey), ReleaseCache) != 0) {
+      (void)pthread_mutex_destroy(&(pool->mutex));
+      free(pool->freeSms);
+      free(pool);
+      return NULL;
+    }
+  }
+
+  while (pool->nOfFree < nOfSms) {
+    derSmDesc = FwSmCreateDer(smDesc);
+    if (derSmDesc == NULL) {
+      FwSmPoolRelease(pool);
+      return NULL;
+    }
+    pool->freeSms[pool->nOfFree] = derSmDesc;
+    pool->nOfFree++;
+  }
+
+  return pool;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+FwSmDesc_t FwSmPoolGet(FwSmPoolDesc_t pool) {
+  FwSmDesc_t     smDesc = NULL;
+  SmPoolCache_t* cache  = NULL;
+
+  if (!pool->threadSafe) {
+    if (pool->nOfFree > 0) {
+      pool->nOfFree--;
+      smDesc = pool->freeSms[pool->nOfFree];
+    }
+  }
+  else {
+    cache = GetCache(pool);
+    if ((cache == NULL) || (cache->nOfSms == 0)) {
+      /* Refill the cache from the pool (or take a state machine directly from the pool if there is no cache) */
+      (void)pthread_mutex_lock(&(pool->mutex));
+      if (cache != NULL) {
+        while ((pool->nOfFree > 0) && (cache->nOfSms < SM_POOL_BATCH)) {
+          pool->nOfFree--;
+          cache->smDesc[cache->nOfSms] = pool->freeSms[pool->nOfFree];
+          cache->nOfSms++;
+        }
+      }
+      else if (pool->nOfFree > 0) {
+        pool->nOfFree--;
+        smDesc = pool->freeSms[pool->nOfFree];
+      }
+      (void)pthread_mutex_unlock(&(pool->mutex));
+    }
+    if ((cache != NULL) && (cache->nOfSms > 0)) {
+      cache->nOfSms--;
+      smDesc = cache->smDesc[cache->nOfSms];
+    }
+  }
+
+  if (smDesc == NULL) {
+    smDesc = FwSmCreateDer(pool->smDesc);
+    if (smDesc == NULL) {
+      return NULL;
+    }
+    if (pool->threadSafe) {
+      (void)SM_POOL_ATOMIC_ADD(pool->nOfMisses, 1);
+    }
+    else {
+      pool->nOfMisses++;
+    }
+  }
+
+  AddInUse(pool);
+  return smDesc;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+FwSmErrCode_t FwSmPoolPut(FwSmPoolDesc_t pool, FwSmDesc_t smDesc) {
+  SmPoolCache_t* cache;
+  FwSmBool_t     release = 0;
+
+  if (smDesc->smBase != pool->smDesc->smBase) {
+    return smWrongBase;
+  }
+
+  ResetSm(smDesc, pool->smDesc);
+
+  if (!pool->threadSafe) {
+    if (pool->nOfFree < pool->maxNOfFree) {
+      pool->freeSms[pool->nOfFree] = smDesc;
+      pool->nOfFree++;
+    }
+    else {
+      ReleaseSm(smDesc);
+    }
+    pool->nOfInUse--;
+    return smSuccess;
+  }
+
+  cache = GetCache(pool);
+  if ((cache != NULL) && (cache->nOfSms < FW_SM_POOL_CACHE_SIZE)) {
+    cache->smDesc[cache->nOfSms] = smDesc;
+    cache->nOfSms++;
+  }
+  else {
+    /* Spill part of the cache to the pool (or return the state machine directly to the pool if there is no cache) */
+    (void)pthread_mutex_lock(&(pool->mutex));
+    if (cache != NULL) {
+      while ((cache->nOfSms > FW_SM_POOL_CACHE_SIZE - SM_POOL_BATCH) && (pool->nOfFree < pool->maxNOfFree)) {
+        cache->nOfSms--;
+        pool->freeSms[pool->nOfFree] = cache->smDesc[cache->nOfSms];
+        pool->nOfFree++;
+      }
+    }
+    if ((cache != NULL) && (cache->nOfSms < FW_SM_POOL_CACHE_SIZE)) {
+      cache->smDesc[cache->nOfSms] = smDesc;
+      cache->nOfSms++;
+    }
+    else if (pool->nOfFree < pool->maxNOfFree) {
+      pool->freeSms[pool->nOfFree] = smDesc;
+      pool->nOfFree++;
+    }
+    else {
+      release = 1;
+    }
+    (void)pthread_mutex_unlock(&(pool->mutex));
+    if (release) {
+      ReleaseSm(smDesc);
+    }
+  }
+  (void)SM_POOL_ATOMIC_SUB(pool->nOfInUse, 1);
+  return smSuccess;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+FwSmCounterU4_t FwSmPoolGetNOfInUse(FwSmPoolDesc_t pool) {
+  return pool->nOfInUse;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+FwSmCounterU4_t FwSmPoolGetHighWater(FwSmPoolDesc_t pool) {
+  return pool->highWater;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+FwSmCounterU4_t FwSmPoolGetNOfMisses(FwSmPoolDesc_t pool) {
+  return pool->nOfMisses;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+void FwSmPoolRelease(FwSmPoolDesc_t pool) {
+  SmPoolCache_t* cache;
+
+  if (pool->threadSafe) {
+    (void)pthread_key_delete(pool->cacheKey);
+    while (pool->caches != NULL) {
+      cache = pool->caches;
+      while (cache->nOfSms > 0) {
+        cache->nOfSms--;
+        ReleaseSm(cache->smDesc[cache->nOfSms]);
+      }
+      pool->caches = cache->next;
+      free(cache);
+    }
+    (void)pthread_mutex_destroy(&(pool->mutex));
+  }
+
+  while (pool->nOfFree > 0) {
+    pool->nOfFree--;
+    ReleaseSm(pool->freeSms[pool->nOfFree]);
+  }
+  free(pool->freeSms);
+  free(pool);
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+static void ResetSm(FwSmDesc_t smDesc, FwSmDesc_t poolSmDesc) {
+  FwSmCounterS1_t i;
+
+  /* The hierarchy is removed from its broadcast registry before its embedded state machines are reset */
+  if (smDesc->bcast != NULL) {
+    SmBcastRemove(smDesc);
+  }
+
+  for (i = 0; i < smDesc->nOfActions; i++) {
+    smDesc->smActions[i] = poolSmDesc->smActions[i];
+  }
+  for (i = 0; i < smDesc->nOfGuards; i++) {
+    smDesc->smGuards[i] = poolSmDesc->smGuards[i];
+  }
+  for (i = 0; i < smDesc->smBase->nOfPStates; i++) {
+    if (SmIsLazy(smDesc, i)) { /* a lazily embedded SM is instantiated again when it is needed */
+      smDesc->lazy->put(smDesc, i, 1);
+    }
+    else if (poolSmDesc->esmDesc[i] == NULL) {
+      smDesc->esmDesc[i] = NULL;
+    }
+    else if (smDesc->esmDesc[i] != NULL) {
+      ResetSm(smDesc->esmDesc[i], poolSmDesc->esmDesc[i]);
+    }
+  }
+
+  if (smDesc->profile != NULL) {
+    FwSmDisableProfile(smDesc);
+  }
+  SmReleaseNotify(smDesc);
+  free(smDesc->cfgIndex);
+  free(smDesc->memo);
+  smDesc->cfgIndex = NULL;
+  smDesc->memo     = NULL;
+
+  smDesc->curState     = 0;
+  smDesc->smData       = NULL;
+  smDesc->transCnt     = 0;
+  smDesc->errCode      = poolSmDesc->errCode;
+  smDesc->smExecCnt    = 0;
+  smDesc->stateExecCnt = 0;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+static void ReleaseSm(FwSmDesc_t smDesc) {
+  FwSmCounterS1_t i;
+
+  for (i = 0; i < smDesc->smBase->nOfPStates; i++) {
+    if ((smDesc->esmDesc[i] != NULL) && !SmIsLazy(smDesc, i)) { /* lazily embedded SMs are released by FwSmReleaseDer */
+      ReleaseSm(smDesc->esmDesc[i]);
+    }
+  }
+  FwSmReleaseDer(smDesc);
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+static void AddInUse(FwSmPoolDesc_t pool) {
+  FwSmCounterU4_t nOfInUse;
+  FwSmCounterU4_t highWater;
+  FwSmCounterU4_t oldHighWater;
+
+  if (!pool->threadSafe) {
+    pool->nOfInUse++;
+    if (pool->nOfInUse > pool->highWater) {
+      pool->highWater = pool->nOfInUse;
+    }
+    return;
+  }
+
+  nOfInUse  = SM_POOL_ATOMIC_ADD(pool->nOfInUse, 1);
+  highWater = SM_POOL_ATOMIC_ADD(pool->highWater, 0);
+  while (nOfInUse > highWater) {
+    oldHighWater = SM_POOL_ATOMIC_CAS(pool->highWater, highWater, nOfInUse);
+    if (oldHighWater == highWater) {
+      break;
+    }
+    highWater = oldHighWater;
+  }
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+static SmPoolCache_t* GetCache(FwSmPoolDesc_t pool) {
+  SmPoolCache_t* cache;
+
+  cache = (SmPoolCache_t*)pthread_getspecific(pool->cacheKey);
+  if (cache != NULL) {
+    return cache;
+  }
+
+  (void)pthread_mutex_lock(&(pool->mutex));
+  for (cache = pool->caches; cache != NULL; cache = cache->next) {
+    if (!cache->isOwned) {
+      break;
+    }
+  }
+  if (cache == NULL) {
+    cache = (SmPoolCache_t*)malloc(sizeof(SmPoolCache_t));
+    if (cache != NULL) {
+      cache->pool   = pool;
+      cache->nOfSms = 0;
+      cache->next   = pool->caches;
+      pool->caches  = cache;
+    }
+  }
+  if (cache != NULL) {
+    cache->isOwned = 1;
+    if (pthread_setspecific(pool->cacheKey, cache) != 0) {
+      cache->isOwned = 0;
+      cache          = NULL;
+    }
+  }
+  (void)pthread_mutex_unlock(&(pool->mutex));
+
+  return cache;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+static void ReleaseCache(void* cache) {
+  SmPoolCache_t* smCache = (SmPoolCache_t*)cache;
+  FwSmPoolDesc_t pool    = smCache->pool;
+
+  (void)pthread_mutex_lock(&(pool->mutex));
+  while (smCache->nOfSms > 0) {
+    smCache->nOfSms--;
+    if (pool->nOfFree < pool->maxNOfFree) {
+      pool->freeSms[pool->nOfFree] = smCache->smDesc[smCache->nOfSms];
+      pool->nOfFree++;
+    }
+    else {
+      ReleaseSm(smCache->smDesc[smCache->nOfSms]);
+    }
+  }
+  smCache->isOwned = 0;
+  (void)pthread_mutex_unlock(&(pool->mutex));
+}
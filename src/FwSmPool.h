@@ -0,0 +1,147 @@
+/**
+ * @file
+ * @ingroup smGroup
+ * Declaration of the pool interface for a FW State Machine.
+ * A state machine pool holds a set of state machines which are derived from the
+ * same state machine (the <i>pool state machine</i>) and which are handed out to
+ * and returned by applications which need state machines of the same type for a
+ * limited time.
+ *
+ * The basic mode of use of the functions declared in this file is as follows:
+ * -# The pool is created with function <code>::FwSmPoolCreate</code>.
+ * -# A state machine is obtained from the pool with function <code>::FwSmPoolGet</code>.
+ * -# The state machine is used like any other derived state machine.
+ * -# The state machine is returned to the pool with function <code>::FwSmPoolPut</code>.
+ * -# The pool is released with function <code>::FwSmPoolRelease</code>.
+ * .
+ * The state machines in the pool are created with <code>::FwSmCreateDer</code> when
+ * the pool is created.
+ * A state machine obtained from the pool is in the same state as a state machine
+ * newly created with <code>::FwSmCreateDer</code>.
+ * Obtaining a state machine from the pool and returning it to the pool do not
+ * normally allocate or release memory.
+ * If a state machine is requested when the pool is empty, a new state machine is
+ * created with <code>::FwSmCreateDer</code> (this is counted as a <i>miss</i>).
+ * If a state machine is returned when the pool is full, it is released together
+ * with its embedded state machines.
+ *
+ * A pool can be created as a thread-safe pool.
+ * In that case, each thread which uses the pool holds up to
+ * #FW_SM_POOL_CACHE_SIZE free state machines in a private cache which it accesses
+ * without locking the pool.
+ * The pool is only locked when a cache is empty or full.
+ *
+ * The memory for the pool descriptor is allocated dynamically through calls
+ * to <code>malloc</code> and released through calls to <code>free</code>.
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2011, All Rights Reserved
+ *
+ * This file is part of the FW Profile.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#ifndef FWSM_POOL_H_
+#define FWSM_POOL_H_
+
+#include "FwSmCore.h"
+
+/**
+ * Create a new state machine pool.
+ * The pool is created for state machines derived from the argument state machine
+ * and it initially holds <code>nOfSms</code> such state machines.
+ *
+ * The argument state machine should be fully and correctly configured (i.e. it should
+ * pass the configuration check implemented by <code>::FwSmCheck</code>) and it should
+ * not be modified or released as long as the pool exists.
+ * Compliance with these constraints is not checked by this function.
+ * @param smDesc the state machine from which the state machines in the pool are derived.
+ * @param nOfSms the number of state machines held by the pool (a positive integer).
+ * @param threadSafe 1 if the pool is to be used by more than one thread, 0 otherwise.
+ * @return the descriptor of the new pool (or NULL if the creation of the data structures
+ * to hold the pool descriptor or of the state machines in the pool failed or if the
+ * number of state machines is zero).
+ */
+FwSmPoolDesc_t FwSmPoolCreate(FwSmDesc_t smDesc, FwSmCounterU4_t nOfSms, FwSmBool_t threadSafe);
+
+/**
+ * Obtain a state machine from a state machine pool.
+ * The state machine is derived from the pool state machine and it is in the
+ * same state as a state machine newly created with <code>::FwSmCreateDer</code>:
+ * it is stopped, its execution counters are zero, its data are NULL and its actions,
+ * guards and embedded state machines are those of the pool state machine.
+ * @param pool the descriptor of the pool.
+ * @return the descriptor of the state machine (or NULL if the pool is empty and the
+ * creation of a new state machine failed).
+ */
+FwSmDesc_t FwSmPoolGet(FwSmPoolDesc_t pool);
+
+/**
+ * Return a state machine to a state machine pool.
+ * The state machine should have been obtained from the same pool with
+ * <code>::FwSmPoolGet</code> and it should no longer be used after it has been
+ * returned.
+ * The state machine is reset to the state in which <code>::FwSmPoolGet</code> hands
+ * it out.
+ * This is done without executing any state machine action: a state machine which is
+ * still started is simply put back in the stopped state.
+ * Actions and guards overridden with <code>::FwSmOverrideAction</code> and
+ * <code>::FwSmOverrideGuard</code> are restored.
+ * State machines embedded with <code>::FwSmEmbed</code> are detached from the
+ * state machine but they are not released.
+ * If the state machine is in a broadcast registry, the hierarchy which holds it is
+ * removed from the registry (see <code>::FwSmBcastRemove</code>).
+ * @param pool the descriptor of the pool.
+ * @param smDesc the descriptor of the state machine to be returned to the pool.
+ * @return <code>#smSuccess</code> if the state machine was returned to the pool or
+ * <code>#smWrongBase</code> if the state machine does not share the base descriptor
+ * of the pool state machine (in this case, the state machine is not affected).
+ */
+FwSmErrCode_t FwSmPoolPut(FwSmPoolDesc_t pool, FwSmDesc_t smDesc);
+
+/**
+ * Return the number of state machines which have been obtained from a state machine
+ * pool and which have not yet been returned to it.
+ * @param pool the descriptor of the pool.
+ * @return the number of state machines in use.
+ */
+FwSmCounterU4_t FwSmPoolGetNOfInUse(FwSmPoolDesc_t pool);
+
+/**
+ * Return the high-water mark of a state machine pool.
+ * The high-water mark is the largest number of state machines which have been in use
+ * at the same time since the pool was created.
+ * @param pool the descriptor of the pool.
+ * @return the high-water mark of the pool.
+ */
+FwSmCounterU4_t FwSmPoolGetHighWater(FwSmPoolDesc_t pool);
+
+/**
+ * Return the number of misses of a state machine pool.
+ * A miss is a call to <code>::FwSmPoolGet</code> which cannot be served with a free
+ * state machine and which therefore creates a new state machine.
+ * @param pool the descriptor of the pool.
+ * @return the number of misses of the pool.
+ */
+FwSmCounterU4_t FwSmPoolGetNOfMisses(FwSmPoolDesc_t pool);
+
+/**
+ * Release the memory which was allocated when the state machine pool was created.
+ * The free state machines of the pool (including those held in the per-thread
+ * caches of a thread-safe pool) are released together with their embedded state
+ * machines.
+ * State machines which are in use are not affected and should be released by the
+ * application with <code>::FwSmReleaseDer</code> (the state machines embedded in them
+ * are derived state machines which must be released in the same way).
+ * This function should only be called when no other thread uses the pool.
+ * After this operation is called, the pool descriptor can no longer be used.
+ * @param pool the descriptor of the pool.
+ */
+void FwSmPoolRelease(FwSmPoolDesc_t pool);
+
+#endif /* FWSM_POOL_H_ */
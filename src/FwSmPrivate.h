@@ -50,6 +50,7 @@
 #define FWSM_PRIVATE_H_
 
 #include "FwSmConstants.h"
+#include <pthread.h>
 
 /**
  * Enumerated type for the type of a state in a state machine.
@@ -88,6 +89,75 @@ void SmDummyAction(FwSmDesc_t smDesc);
  */
 FwSmBool_t SmDummyGuard(FwSmDesc_t smDesc);
 
+/**
+ * Release the change notification data of a state machine (see
+ * <code>::FwSmEnableNotify</code>).
+ * If the state machine is in a change list, it is removed from it.
+ * This function has no effect if change notification is not enabled on the state
+ * machine.
+ * This function is used internally by the state machine module.
+ * @param smDesc state machine descriptor.
+ */
+void SmReleaseNotify(FwSmDesc_t smDesc);
+
+/**
+ * Report a change of the current state of a state machine to the owner of its change
+ * notification data (see <code>::SmNotify_t</code>).
+ * The change sequence number of the owner is incremented and, if the owner has a change
+ * list and it is not yet in it, the owner is added to its change list.
+ * This function should only be called if change notification is enabled on the state
+ * machine.
+ * This function is used internally by the state machine module.
+ * @param smDesc state machine descriptor.
+ */
+void SmNotifyChange(FwSmDesc_t smDesc);
+
+/**
+ * Report a change of the current state of a state machine to the broadcast registry
+ * which holds its hierarchy (see <code>::FwSmBcastAdd</code>).
+ * The hierarchy is marked as changed and its broadcast subscriptions are brought up to
+ * date when the next transition command is broadcast.
+ * This function should only be called if the state machine is in a broadcast registry.
+ * This function is used internally by the state machine module.
+ * @param smDesc state machine descriptor.
+ */
+void SmBcastChange(FwSmDesc_t smDesc);
+
+/**
+ * Remove the hierarchy which holds a state machine from its broadcast registry (see
+ * <code>::FwSmBcastRemove</code>).
+ * The state machine may be at the top of the hierarchy or embedded in it.
+ * This function should only be called if the state machine is in a broadcast registry.
+ * This function is used internally by the state machine module when a state machine
+ * is released or returned to its pool.
+ * @param smDesc state machine descriptor.
+ */
+void SmBcastRemove(FwSmDesc_t smDesc);
+
+/**
+ * Check whether a state of a state machine has the template of a lazily embedded state
+ * machine (see <code>::FwSmEmbedLazy</code>).
+ * This function is used internally by the state machine module.
+ * @param smDesc state machine descriptor.
+ * @param i the index of the state in the state array of the state machine.
+ * @return 1 if the state has a template or 0 otherwise.
+ */
+FwSmBool_t SmIsLazy(FwSmDesc_t smDesc, FwSmCounterS1_t i);
+
+/**
+ * Execute a started state machine whose current state has no embedded state machine
+ * and no out-going transition triggered by the "Execute" command.
+ * The execution counters are incremented and the do-action of the current state is
+ * executed.
+ * The trace events and the clearing of the guard memo are the same as in
+ * <code>::FwSmExecute</code>, to which this function is therefore equivalent for
+ * such a state machine.
+ * This function is used internally by the state machine module.
+ * @param smDesc state machine descriptor.
+ * @param iDoAction the index of the do-action of the current state.
+ */
+void SmExecuteDo(FwSmDesc_t smDesc, FwSmCounterS1_t iDoAction);
+
 /**
  * Structure representing a proper state in state machine. A proper state is characterized by:
  * - the set of out-going transitions from the state
@@ -117,6 +187,23 @@ FwSmBool_t SmDummyGuard(FwSmDesc_t smDesc);
  *
  * By convention, the implementation treats a state as uninitialized if its
  * <code>outTransIndex</code> field is equal to zero.
+ *
+ * A state is <i>execute-inert</i> if its do-action is the dummy action and none of its
+ * out-going transitions is triggered by the "Execute" transition command.
+ * Executing a state machine whose current state is execute-inert and has no embedded
+ * state machine has no effect other than incrementing its execution counters.
+ * Field <code>isExecInert</code> is maintained by the configuration functions: it is set
+ * by <code>::FwSmAddState</code> if the do-action of the state is the dummy action and it
+ * is cleared by <code>::FwSmAddTransStaToSta</code> (and the other functions which add
+ * transitions out of a state) when an "Execute" transition out of the state is added.
+ *
+ * Fields <code>dispMinId</code> and <code>dispNOfIds</code> are only meaningful if the
+ * state machine is compiled (see <code>::FwSmCompile</code>).
+ * If field <code>dispNOfIds</code> is not zero, the identifiers of the out-going
+ * transitions of the state are in the range [<code>dispMinId</code>,
+ * <code>dispMinId</code>+<code>dispNOfIds</code>-1] and the transitions which respond
+ * to a trigger are located through the direct-index section of the transition
+ * dispatch table (see <code>::SmBaseDesc_t</code>).
  */
 typedef struct {
   /** index of first out-going transition in the transition array of <code>::SmBaseDesc_t</code> */
@@ -129,6 +216,12 @@ typedef struct {
   FwSmCounterS1_t iDoAction;
   /** the exit action for the state */
   FwSmCounterS1_t iExitAction;
+  /** 1 if the state is execute-inert or 0 otherwise */
+  FwSmCounterU1_t isExecInert;
+  /** the smallest identifier of the out-going transitions (if <code>dispNOfIds</code> is not zero) */
+  FwSmCounterU2_t dispMinId;
+  /** the size of the range of identifiers of the direct-index dispatch or 0 if it is not used */
+  FwSmCounterU2_t dispNOfIds;
 } SmPState_t;
 
 /**
@@ -231,6 +324,37 @@ typedef struct {
  * holds the transitions out of the same state or choice pseudo-state (see also
  * <code>::SmPState_t</code> and <code>::SmPState_t</code>).
  * The number of transitions is stored in field <code>nOfTrans</code>.
+ *
+ * Array <code>transDisp</code> holds the transition dispatch table which is built
+ * by <code>::FwSmCompile</code>.
+ * The dispatch table has <code>#SM_DISP_SIZE</code>(<code>nOfTrans</code>) locations.
+ * The first <code>nOfTrans</code> locations are the sorted section of the table.
+ * The locations of the sorted section which correspond to the transitions out of a
+ * proper state hold the indices of those transitions sorted by increasing transition
+ * identifier (transitions with the same identifier are kept in the order in which
+ * they were added to the state machine).
+ * This allows the transitions which match a given trigger to be found through a
+ * binary search.
+ * The remaining locations are the direct-index section of the table.
+ * A proper state whose out-going transitions have the identifiers in the range
+ * [m, m+R-1] (see fields <code>dispMinId</code> and <code>dispNOfIds</code> of
+ * <code>::SmPState_t</code>) owns the R+1 locations of the direct-index section which
+ * start at location <code>nOfTrans</code>+2*<code>outTransIndex</code>.
+ * The k-th of these locations holds the first location of the sorted section for the
+ * state whose transition has an identifier greater than or equal to m+k (the last one
+ * holds the end of the state's part of the sorted section).
+ * The transitions which respond to trigger m+k are therefore those between the k-th
+ * and the (k+1)-th locations and they are found without any comparison.
+ * This is only done if R+1 is not greater than twice the number of out-going
+ * transitions of the state, so that the direct-index section fits in
+ * 2*<code>nOfTrans</code> locations.
+ * The dispatch table is only used if field <code>isCompiled</code> is true.
+ * The direct-index section is used for the states with at least
+ * <code>#FW_SM_DISP_MIN_DIRECT_OUT_TRANS</code> out-going transitions, the binary
+ * search for the other states with at least <code>#FW_SM_DISP_MIN_OUT_TRANS</code>
+ * out-going transitions.
+ * Since the dispatch table is part of the base descriptor, it is shared by all
+ * the state machines which are derived from the same base state machine.
  */
 typedef struct {
   /** array holding the proper states in the state machine */
@@ -245,8 +369,18 @@ typedef struct {
   FwSmCounterS1_t nOfCStates;
   /** the number of transitions in SM */
   FwSmCounterS1_t nOfTrans;
+  /** the transition dispatch table (or NULL if no dispatch table has yet been allocated) */
+  FwSmCounterS1_t* transDisp;
+  /** flag indicating whether the transition dispatch table is valid */
+  FwSmBool_t isCompiled;
 } SmBaseDesc_t;
 
+/**
+ * The number of locations of the transition dispatch table of a state machine
+ * with N transitions (see <code>::SmBaseDesc_t</code>).
+ */
+#define SM_DISP_SIZE(N) (3 * (N))
+
 /**
  * Structure representing a state machine descriptor.
  * Field <code>smBase</code> points to the base descriptor for the state machine
@@ -300,6 +434,224 @@ typedef struct {
  * the state machine was started and the State Execution Counter holds the number of cycle
  * since the current state was entered.
  */
+/**
+ * Structure holding the profiling data of a state machine.
+ * The profiling data are only collected if profiling has been enabled on the state
+ * machine with <code>::FwSmEnableProfile</code>.
+ * The profiling data belong to a state machine instance (they are not shared by
+ * the state machines which are derived from the same base state machine).
+ * The arrays of the profiling data are located immediately after the structure in
+ * the same block of memory and are indexed in the same way as the arrays of the
+ * base descriptor (see <code>::SmBaseDesc_t</code>):
+ * - Arrays <code>stateEntryCnt</code> and <code>stateDwell</code> have one element
+ *   for each proper state (the i-th state is in the (i-1)-th location).
+ * - Arrays <code>transFireCnt</code>, <code>guardTrueCnt</code> and
+ *   <code>guardFalseCnt</code> have one element for each transition (the element
+ *   in location i refers to the transition in location i of the transition array).
+ * .
+ * The time spent in a state is only measured if a clock function has been provided.
+ * It is accumulated in the state when the state is exited.
+ */
+typedef struct {
+  /** the function which provides the time stamps (or NULL if times are not measured) */
+  FwSmProfileClock_t clock;
+  /** the time stamp of the entry into the current state */
+  FwSmCounterU4_t entryTime;
+  /** the number of entries into each state */
+  FwSmCounterU4_t* stateEntryCnt;
+  /** the total time spent in each state */
+  FwSmCounterU4_t* stateDwell;
+  /** the number of times each transition has been fired */
+  FwSmCounterU4_t* transFireCnt;
+  /** the number of times the guard of each transition has returned true */
+  FwSmCounterU4_t* guardTrueCnt;
+  /** the number of times the guard of each transition has returned false */
+  FwSmCounterU4_t* guardFalseCnt;
+} SmProfile_t;
+
+/**
+ * Structure representing a hash table which maps the function pointers in an action
+ * or guard array to their locations in the array.
+ * The hash table uses open addressing with linear probing.
+ * Each entry holds the location in the array of one function pointer or -1 if the
+ * entry is empty.
+ * If the same function pointer is stored in more than one location, the hash table
+ * holds its first location.
+ * The locations of the array from <code>first</code> to <code>next-1</code> are
+ * non-NULL and are held in the hash table.
+ */
+typedef struct {
+  /** the entries of the hash table */
+  FwSmCounterS1_t* table;
+  /** the number of entries (a power of two which is at least twice the size of the array) */
+  FwSmCounterU4_t size;
+  /** the first location which is held in the hash table */
+  FwSmCounterS1_t first;
+  /** the first free location of the array */
+  FwSmCounterS1_t next;
+  /** flag indicating whether the same function pointer may be stored in more than one location */
+  FwSmBool_t hasDup;
+} SmFuncIndex_t;
+
+/**
+ * Structure representing the configuration index of a state machine.
+ * The configuration index allows actions and guards to be registered and overridden
+ * in constant time.
+ * It is built on demand by the configuration functions (see #FW_SM_CFG_INDEX_MIN) and
+ * it is released when the configuration of the state machine passes
+ * <code>::FwSmCheck</code>.
+ * The configuration index and its hash tables are allocated in one block of memory.
+ */
+typedef struct {
+  /** the hash table for the action array */
+  SmFuncIndex_t actions;
+  /** the hash table for the guard array */
+  SmFuncIndex_t guards;
+} SmCfgIndex_t;
+
+/**
+ * Structure representing the declaration of a declarative guard of a state machine
+ * (see <code>::FwSmSetGuardDecl</code>).
+ */
+typedef struct {
+  /** the operand of the guard (#smGuardOpndNone if the guard has no declaration) */
+  FwSmGuardOpnd_t opnd;
+  /** the comparison operator of the guard */
+  FwSmGuardOp_t op;
+  /** the offset in bytes of the operand in the state machine data */
+  FwSmCounterU4_t offset;
+  /** the constant against which the operand is compared */
+  long value;
+} SmGuardDecl_t;
+
+/**
+ * Structure representing the guard memo of a state machine.
+ * The guard memo caches the outcome of the guards which have been marked as pure
+ * (see <code>::FwSmSetGuardPure</code>) so that a pure guard is evaluated at most
+ * once between two executions of an action of the state machine.
+ * Each bitmask field has one bit for each location of the guard array: the
+ * i-th guard is represented by bit (i%8) of byte (i/8).
+ * A cached outcome is only used within the transition command in which it was computed.
+ * The guard memo also holds the declarations of the declarative guards (see
+ * <code>::FwSmSetGuardDecl</code>) which are evaluated without calling the guards.
+ * The guard memo, its declarations and its bitmasks are allocated in one block of memory.
+ */
+typedef struct {
+  /** the declarations of the guards (one for each location of the guard array) */
+  SmGuardDecl_t* decl;
+  /** the bitmask of the guards which have been marked as pure */
+  FwSmCounterU1_t* pure;
+  /** the bitmask of the pure guards whose outcome is cached */
+  FwSmCounterU1_t* cached;
+  /** the bitmask of the cached outcomes (the bit is set if the guard was true) */
+  FwSmCounterU1_t* value;
+  /** the number of bytes in each bitmask */
+  FwSmCounterU4_t nOfBytes;
+  /** flag indicating whether at least one outcome is cached */
+  FwSmBool_t isCached;
+} SmGuardMemo_t;
+
+/**
+ * Structure representing the change notification data of a state machine.
+ * The change notification data are allocated when change notification is enabled on
+ * a state machine (see <code>::FwSmEnableNotify</code>) and they are allocated
+ * separately for the state machine and for each of its embedded state machines.
+ * The changes of the current state of any state machine in the hierarchy are
+ * reported to the state machine on which change notification was enabled (the
+ * <i>owner</i>): the change sequence number and the change list are only used in the
+ * change notification data of the owner.
+ */
+typedef struct {
+  /** the state machine to which the changes are reported */
+  struct FwSmDesc* owner;
+  /** the change list to which the owner is added when it changes (or NULL) */
+  FwSmChangeList_t* list;
+  /** the number of changes of the current states in the hierarchy of the owner */
+  FwSmCounterU4_t changeSeq;
+  /** flag indicating whether the owner is in the change list */
+  FwSmBool_t isListed;
+} SmNotify_t;
+
+/**
+ * Structure representing the link between a hierarchy of state machines and the
+ * broadcast registry which holds it (see <code>::FwSmBcastAdd</code>).
+ * The link is owned by the registry and all the state machines in the hierarchy point
+ * to it.
+ */
+typedef struct {
+  /** the broadcast registry */
+  struct FwSmBcast* bcast;
+  /** the position of the hierarchy in the registry */
+  FwSmCounterU4_t iSm;
+  /** flag indicating whether the hierarchy has changed since its subscriptions were computed */
+  FwSmBool_t isDirty;
+} SmBcastLink_t;
+
+/**
+ * Structure representing the template of the state machine which is lazily embedded in
+ * a state of a state machine (see <code>::FwSmEmbedLazy</code> and
+ * <code>::FwSmEmbedLazyPool</code>).
+ */
+typedef struct {
+  /** the state machine from which the embedded state machine is derived (or NULL if the state has no template) */
+  struct FwSmDesc* esmBase;
+  /** the pool from which the embedded state machine is obtained (or NULL if it is derived from the template) */
+  struct FwSmPool* pool;
+} SmLazyEsm_t;
+
+/**
+ * Structure representing the lazy embedding data of a state machine.
+ * The lazy embedding data hold a template for each state of the state machine.
+ * The state machine embedded in a state with a template is only instantiated when the
+ * state is entered and its embedded state machine is undefined.
+ * The lazy embedding data are allocated when a template is first defined on a state
+ * machine and they are shared by the state machines which are derived from it.
+ * The functions which instantiate and release the embedded state machines are accessed
+ * through function pointers so that the <code>Core</code> module does not depend on the
+ * modules which create state machines.
+ */
+typedef struct {
+  /** the templates of the embedded state machines (one for each state) */
+  SmLazyEsm_t* esm;
+  /**
+   * the function which instantiates the embedded state machine of the i-th state of a
+   * state machine and which returns it (or NULL if it could not be instantiated)
+   */
+  struct FwSmDesc* (*get)(struct FwSmDesc* smDesc, FwSmCounterS1_t i);
+  /**
+   * the function which returns the instantiated embedded state machine of the i-th state
+   * of a state machine to its pool after it has been stopped (or which releases it if the
+   * flag <code>isRelease</code> is set)
+   */
+  void (*put)(struct FwSmDesc* smDesc, FwSmCounterS1_t i, FwSmBool_t isRelease);
+} SmLazy_t;
+
+/**
+ * Flag of field <code>shared</code> of <code>::FwSmDesc</code> which is set if the action
+ * array is shared with the base state machine (see <code>::FwSmCreateDerShared</code>).
+ */
+#define SM_SHARED_ACTIONS 1
+
+/**
+ * Flag of field <code>shared</code> of <code>::FwSmDesc</code> which is set if the guard
+ * array is shared with the base state machine (see <code>::FwSmCreateDerShared</code>).
+ */
+#define SM_SHARED_GUARDS 2
+
+/**
+ * Flag of field <code>shared</code> of <code>::FwSmDesc</code> which is set if the array
+ * of embedded state machines is shared with the base state machine (see
+ * <code>::FwSmCreateDerShared</code>).
+ */
+#define SM_SHARED_ESM 4
+
+/**
+ * Flag of field <code>shared</code> of <code>::FwSmDesc</code> which is set if the lazy
+ * embedding data are shared with the state machine from which the state machine is
+ * derived (see <code>::FwSmEmbedLazy</code>).
+ */
+#define SM_SHARED_LAZY 8
+
 struct FwSmDesc {
   /** pointer to the base descriptor */
   SmBaseDesc_t* smBase;
@@ -325,6 +677,330 @@ struct FwSmDesc {
   FwSmErrCode_t errCode;
   /** the pointer to the data manipulated by the state machine actions and guards */
   void* smData;
+  /** the profiling data of the state machine (or NULL if profiling is disabled) */
+  SmProfile_t* profile;
+  /** the configuration index of the state machine (or NULL if it has not been built) */
+  SmCfgIndex_t* cfgIndex;
+  /** the guard memo of the state machine (or NULL if no guard has been marked as pure or declared) */
+  SmGuardMemo_t* memo;
+  /** the change notification data of the state machine (or NULL if change notification is disabled) */
+  SmNotify_t* notify;
+  /** the link to the broadcast registry of the state machine (or NULL if it is in no registry) */
+  SmBcastLink_t* bcast;
+  /** the lazy embedding data of the state machine (or NULL if no template of an embedded state machine is defined) */
+  SmLazy_t* lazy;
+  /** the arrays which are shared with the base state machine (see #SM_SHARED_ACTIONS) */
+  FwSmCounterU1_t shared;
+};
+
+/**
+ * Structure representing a state machine group descriptor.
+ * A state machine group holds state machines which share the same base descriptor.
+ * The base descriptor is stored in field <code>smBase</code>.
+ * The descriptors of the state machines in the group are stored in the dense array
+ * <code>smDesc</code> in the order in which they were added to the group.
+ *
+ * Array <code>execClass</code> holds one entry for each proper state of the base
+ * descriptor.
+ * The entries are cleared at the start of each group execution and an entry is set,
+ * when a state machine in the group is first found in its state, to record whether
+ * the state has an out-going transition triggered by the "Execute" command.
+ * The transitions out of a state are therefore scanned at most once per group
+ * execution and the entries always reflect the current configuration of the base
+ * descriptor.
+ */
+struct FwSmGroup {
+  /** pointer to the base descriptor shared by the state machines in the group */
+  SmBaseDesc_t* smBase;
+  /** the "Execute" class of each proper state of the base descriptor, computed at each group execution */
+  FwSmCounterU1_t* execClass;
+  /** the descriptors of the state machines in the group */
+  FwSmDesc_t* smDesc;
+  /** the number of state machines in the group */
+  FwSmCounterU4_t nOfSms;
+  /** the maximum number of state machines in the group */
+  FwSmCounterU4_t maxNOfSms;
+};
+
+/**
+ * Structure representing the per-thread cache of a thread-safe state machine pool.
+ * A thread which uses a thread-safe pool owns one cache where it stores up to
+ * #FW_SM_POOL_CACHE_SIZE free state machines.
+ * The cache is accessed by its owner thread without locking the pool.
+ * The caches of a pool are linked in a list and they are released together with
+ * the pool.
+ * When its owner thread terminates, a cache returns its state machines to the pool
+ * and becomes available to other threads.
+ */
+typedef struct SmPoolCache {
+  /** the pool to which the cache belongs */
+  struct FwSmPool* pool;
+  /** the free state machines held in the cache */
+  FwSmDesc_t smDesc[FW_SM_POOL_CACHE_SIZE];
+  /** the number of free state machines held in the cache */
+  FwSmCounterU4_t nOfSms;
+  /** flag indicating whether the cache is owned by a thread */
+  FwSmBool_t isOwned;
+  /** the next cache of the pool */
+  struct SmPoolCache* next;
+} SmPoolCache_t;
+
+/**
+ * Structure representing a state machine pool descriptor.
+ * A state machine pool holds state machines which are derived from the state
+ * machine stored in field <code>smDesc</code>.
+ * The free state machines of the pool are stored in the array <code>freeSms</code>
+ * which is used as a stack.
+ *
+ * If the pool is thread-safe, the array of free state machines and the list of
+ * caches are protected by <code>mutex</code> and each thread using the pool holds
+ * a pointer to its cache in the thread-specific data identified by
+ * <code>cacheKey</code>.
+ * The usage statistics are then updated with atomic operations.
+ */
+struct FwSmPool {
+  /** the state machine from which the state machines in the pool are derived */
+  FwSmDesc_t smDesc;
+  /** the free state machines of the pool */
+  FwSmDesc_t* freeSms;
+  /** the number of free state machines in <code>freeSms</code> */
+  FwSmCounterU4_t nOfFree;
+  /** the maximum number of free state machines in <code>freeSms</code> */
+  FwSmCounterU4_t maxNOfFree;
+  /** the number of state machines which have been obtained from the pool and not returned */
+  FwSmCounterU4_t nOfInUse;
+  /** the maximum value reached by <code>nOfInUse</code> */
+  FwSmCounterU4_t highWater;
+  /** the number of requests which were served by creating a new state machine */
+  FwSmCounterU4_t nOfMisses;
+  /** flag indicating whether the pool is thread-safe */
+  FwSmBool_t threadSafe;
+  /** the mutex protecting the pool (only used if the pool is thread-safe) */
+  pthread_mutex_t mutex;
+  /** the key of the per-thread caches (only used if the pool is thread-safe) */
+  pthread_key_t cacheKey;
+  /** the first per-thread cache of the pool */
+  SmPoolCache_t* caches;
+};
+
+/**
+ * Size in bytes of the padding which separates the fields of a lane of a state
+ * machine event queue which are written by the producers from those which are
+ * written by the consumer (see <code>::SmQueueLane_t</code>).
+ * The padding keeps the two groups of fields in different cache lines.
+ */
+#define SM_QUEUE_PAD 64
+
+/**
+ * Structure representing a cell of a lane of a state machine event queue.
+ * The sequence number of a cell records whether the cell is free or whether it holds
+ * a transition command.
+ * The cell in position <code>(pos & mask)</code> of a lane can receive the
+ * <code>pos</code>-th transition command posted to the lane when its sequence number
+ * is equal to <code>pos</code> and it holds that transition command when its sequence
+ * number is equal to <code>(pos+1)</code>.
+ * When the transition command is taken from the cell, its sequence number is set to
+ * <code>(pos+mask+1)</code> which makes it available to the transition command which
+ * is posted to the lane after the lane has wrapped around.
+ */
+typedef struct {
+  /** the sequence number of the cell */
+  volatile FwSmCounterU4_t seq;
+  /** the identifier of the transition command held in the cell */
+  FwSmCounterU2_t transId;
+} SmQueueCell_t;
+
+/**
+ * Structure representing a lane of a state machine event queue.
+ * A lane is a bounded multi-producer single-consumer queue built on an array of cells
+ * whose size is a power of two (see <code>::SmQueueCell_t</code>).
+ * The position where the next transition command is posted is claimed by a producer
+ * through an atomic compare-and-swap operation on <code>tail</code>.
+ * The position where the next transition command is taken is only accessed by the
+ * consumer.
+ */
+typedef struct {
+  /** the cells of the lane */
+  SmQueueCell_t* cells;
+  /** the number of cells of the lane minus one */
+  FwSmCounterU4_t mask;
+  /** the position where the next transition command is posted */
+  volatile FwSmCounterU4_t tail;
+  /** padding which keeps <code>tail</code> and <code>head</code> in different cache lines */
+  unsigned char pad[SM_QUEUE_PAD];
+  /** the position where the next transition command is taken */
+  volatile FwSmCounterU4_t head;
+} SmQueueLane_t;
+
+/**
+ * Structure representing a state machine event queue descriptor.
+ * The first lane of the queue holds the transition commands other than "Execute" and
+ * the second lane holds the "Execute" transition commands.
+ */
+struct FwSmQueue {
+  /** the state machine to which the transition commands are dispatched */
+  FwSmDesc_t smDesc;
+  /** the command lane and the execute lane of the queue */
+  SmQueueLane_t lanes[2];
+  /** the number of transition commands which were rejected because their lane was full */
+  volatile FwSmCounterU4_t nOfRejected;
+};
+
+/**
+ * Structure representing a transition in a flat state machine.
+ * The transitions out of a state are held in the order of their identifiers and, for
+ * transitions with the same identifier, in the order in which they were added to the
+ * state machine.
+ */
+typedef struct {
+  /** the identifier (the name) of the transition */
+  FwSmCounterU2_t id;
+  /** the index of the transition guard in the guard array of the state machine */
+  FwSmCounterS1_t iTrGuard;
+  /** the transition in the base descriptor of the state machine */
+  SmTrans_t* trans;
+} SmFlatTrans_t;
+
+/**
+ * Structure representing a configuration in a flat state machine.
+ * A configuration is identified by a state of one of the state machines in a hierarchy and
+ * it holds the states of the enclosing state machines.
+ * The first configuration (the root configuration) is the configuration where the
+ * state machine at the top of the hierarchy is stopped.
+ * The configurations for the states of a state machine are stored in consecutive
+ * positions of the configuration table.
+ */
+typedef struct {
+  /** the state machine to which the state belongs (the top state machine for the root) */
+  FwSmDesc_t smDesc;
+  /** the state (or NULL for the root configuration) */
+  SmPState_t* pState;
+  /** the identifier of the state (or 0 for the root configuration) */
+  FwSmCounterS1_t state;
+  /** the position in the configuration table of the enclosing configuration */
+  FwSmCounterU4_t parent;
+  /** the number of states in the configuration (its depth in the hierarchy) */
+  FwSmCounterU4_t depth;
+  /** the position in the path table of the states of the configuration */
+  FwSmCounterU4_t iPath;
+  /** the state machine embedded in the state (or the top state machine for the root) */
+  FwSmDesc_t esmDesc;
+  /** the position in the configuration table of the states of the embedded state machine */
+  FwSmCounterU4_t iChild;
+  /** the position in the transition table of the transitions out of the state */
+  FwSmCounterU4_t iTrans;
+  /** the number of transitions out of the state */
+  FwSmCounterU4_t nOfTrans;
+} SmFlatNode_t;
+
+/**
+ * Structure representing a flat state machine descriptor.
+ * The path table holds, for each configuration, the positions of its states in the
+ * configuration table from the outermost to the innermost state.
+ * This is the order in which the do-actions of the states are executed. The exit
+ * actions of the states are executed in the reverse order.
+ */
+struct FwSmFlat {
+  /** the state machine at the top of the hierarchy */
+  FwSmDesc_t smDesc;
+  /** the configuration table */
+  SmFlatNode_t* nodes;
+  /** the path table */
+  FwSmCounterU4_t* path;
+  /** the transition table */
+  SmFlatTrans_t* trans;
+  /** the number of configurations in the configuration table */
+  FwSmCounterU4_t nOfNodes;
+  /** the position in the configuration table of the current configuration */
+  FwSmCounterU4_t curNode;
+};
+
+/**
+ * Structure representing a state machine broadcast registry descriptor.
+ * The registry holds the hierarchies of state machines which were added to it and the
+ * transition commands which can be broadcast to them (the <i>broadcast triggers</i>).
+ * A hierarchy <i>subscribes</i> to a broadcast trigger if one of the current states of
+ * its state machines has an out-going transition which responds to the trigger (or, for
+ * the "Execute" transition command, if it is started).
+ *
+ * For the i-th broadcast trigger, the positions of the subscribed hierarchies are held
+ * in the i-th row of array <code>subs</code> (in no particular order) and the position
+ * in that row of the j-th hierarchy plus one (or zero if it is not subscribed) is held
+ * in the i-th row of array <code>iSub</code>.
+ * The hierarchies whose current states have changed since their subscriptions were
+ * computed are held in array <code>dirty</code>.
+ */
+struct FwSmBcast {
+  /** the broadcast triggers */
+  FwSmCounterU2_t* transIds;
+  /** flags indicating which broadcast triggers respond to a hierarchy (scratch array) */
+  FwSmCounterU1_t* react;
+  /** the state machines at the top of the hierarchies in the registry */
+  FwSmDesc_t* smDesc;
+  /** the links of the hierarchies in the registry */
+  SmBcastLink_t* links;
+  /** the subscribed hierarchies of each broadcast trigger */
+  FwSmCounterU4_t* subs;
+  /** the positions of the hierarchies in the rows of <code>subs</code> plus one */
+  FwSmCounterU4_t* iSub;
+  /** the number of subscribed hierarchies of each broadcast trigger */
+  FwSmCounterU4_t* nOfSubs;
+  /** the hierarchies which have changed since their subscriptions were computed */
+  FwSmCounterU4_t* dirty;
+  /** the number of hierarchies which have changed */
+  FwSmCounterU4_t nOfDirty;
+  /** the number of broadcast triggers */
+  FwSmCounterU4_t nOfTransIds;
+  /** the number of hierarchies in the registry */
+  FwSmCounterU4_t nOfSms;
+  /** the maximum number of hierarchies in the registry */
+  FwSmCounterU4_t maxNOfSms;
+};
+
+/**
+ * Structure representing an asynchronous job of a state machine offload descriptor.
+ * A job holds an action which is executed on the RT Container of the offload descriptor
+ * and the completion trigger which is sent to a state machine when the action has been
+ * executed.
+ */
+typedef struct SmAsyncJob {
+  /** the state machine to which the action belongs */
+  FwSmDesc_t smDesc;
+  /** the queue to which the completion trigger is posted (or NULL if it is dispatched by the offload descriptor) */
+  FwSmQueueDesc_t queue;
+  /** the action which is executed on the RT Container */
+  FwSmAction_t action;
+  /** the completion trigger */
+  FwSmCounterU2_t transId;
+  /** the next job in the list of free jobs or of completed jobs */
+  struct SmAsyncJob* next;
+} SmAsyncJob_t;
+
+/**
+ * Structure representing a state machine offload descriptor.
+ * The jobs of the descriptor are either free, or pending on the RT Container, or
+ * completed and waiting for their completion triggers to be dispatched.
+ * The free and completed jobs are held in two linked lists which are protected by
+ * <code>mutex</code>.
+ * The pending jobs are passed to the RT Container through its payload ring.
+ */
+struct FwSmAsync {
+  /** the RT Container which executes the actions */
+  struct FwRtDesc* rtDesc;
+  /** the jobs of the descriptor */
+  SmAsyncJob_t* jobs;
+  /** the slots of the payload ring of the RT Container */
+  void* slots;
+  /** the first free job */
+  SmAsyncJob_t* freeJobs;
+  /** the oldest completed job */
+  SmAsyncJob_t* doneHead;
+  /** the newest completed job */
+  SmAsyncJob_t* doneTail;
+  /** the number of jobs which are not free */
+  FwSmCounterU4_t nOfPending;
+  /** the mutex protecting the lists of jobs */
+  pthread_mutex_t mutex;
 };
 
 #endif /* FWSM_PRIVATE_H_ */
@@ -0,0 +1,230 @@
+/**
+ * @file
+ * @ingroup smGroup
+ * Implements the event queue functions for the FW State Machine Module.
+ * The lanes of a queue are implemented as bounded multi-producer single-consumer
+ * queues where each cell carries a sequence number (see <code>::SmQueueCell_t</code>).
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2011, All Rights Reserved
+ *
+ * This file is part of the FW Profile.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#include "FwSmQueue.h"
+#include "FwSmPrivate.h"
+#include <stdlib.h>
+
+/** Index of the command lane in the lane array of a queue. */
+#define SM_QUEUE_CMD 0
+/** Index of the execute lane in the lane array of a queue. */
+#define SM_QUEUE_EXEC 1
+
+/** Atomically add a value to a counter of a queue and return the new value. */
+#define SM_QUEUE_ATOMIC_ADD(var, val) __sync_add_and_fetch(&(var), (val))
+/** Atomically set a counter of a queue to a new value if it holds an old value and return its old value. */
+#define SM_QUEUE_ATOMIC_CAS(var, oldVal, newVal) __sync_val_compare_and_swap(&(var), (oldVal), (newVal))
+/** Full memory barrier separating the accesses to the content of a cell from those to its sequence number. */
+#define SM_QUEUE_BARRIER() __sync_synchronize()
+
+/**
+ * Allocate and initialize the cells of a lane of a queue.
+ * The number of cells is the smallest power of two which is not smaller than the
+ * requested capacity.
+ * @param lane the lane.
+ * @param size the requested capacity of the lane.
+ * @return 1 if the lane was initialized or 0 if the capacity is illegal or if the
+ * allocation of the cells failed.
+ */
+static FwSmBool_t InitLane(SmQueueLane_t* lane, FwSmCounterU4_t size);
+
+/**
+ * Add a transition command to a lane of a queue.
+ * @param lane the lane.
+ * @param transId the identifier of the transition command.
+ * @return 1 if the transition command was added to the lane or 0 if the lane is full.
+ */
+static FwSmBool_t PushLane(SmQueueLane_t* lane, FwSmCounterU2_t transId);
+
+/**
+ * Take the oldest transition command from a lane of a queue.
+ * This function must only be called by the consumer of the queue.
+ * @param lane the lane.
+ * @param transId the location where the identifier of the transition command is stored.
+ * @return 1 if a transition command was taken from the lane or 0 if the lane is empty.
+ */
+static FwSmBool_t PopLane(SmQueueLane_t* lane, FwSmCounterU2_t* transId);
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+FwSmQueueDesc_t FwSmQueueCreate(FwSmDesc_t smDesc, FwSmCounterU4_t cmdSize, FwSmCounterU4_t execSize) {
+  FwSmQueueDesc_t queue;
+
+  queue = (FwSmQueueDesc_t)malloc(sizeof(struct FwSmQueue));
+  if (queue == NULL) {
+    return NULL;
+  }
+
+  if (InitLane(&(queue->lanes[SM_QUEUE_CMD]), cmdSize) == 0) {
+    free(queue);
+    return NULL;
+  }
+  if (InitLane(&(queue->lanes[SM_QUEUE_EXEC]), execSize) == 0) {
+    free(queue->lanes[SM_QUEUE_CMD].cells);
+    free(queue);
+    return NULL;
+  }
+
+  queue->smDesc      = smDesc;
+  queue->nOfRejected = 0;
+
+  return queue;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+FwSmErrCode_t FwSmQueuePost(FwSmQueueDesc_t queue, FwSmCounterU2_t transId) {
+  SmQueueLane_t* lane;
+
+  lane = &(queue->lanes[(transId == FW_TR_EXECUTE) ? SM_QUEUE_EXEC : SM_QUEUE_CMD]);
+  if (PushLane(lane, transId) == 0) {
+    (void)SM_QUEUE_ATOMIC_ADD(queue->nOfRejected, 1);
+    return smQueueFull;
+  }
+
+  return smSuccess;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+FwSmCounterU4_t FwSmQueueDispatch(FwSmQueueDesc_t queue, FwSmCounterU4_t maxEvents) {
+  FwSmCounterU4_t nOfEvents = 0;
+  FwSmCounterU2_t transId;
+
+  while (nOfEvents < maxEvents) {
+    /* The execute lane is only visited when the command lane is empty */
+    if ((PopLane(&(queue->lanes[SM_QUEUE_CMD]), &transId) == 0) &&
+        (PopLane(&(queue->lanes[SM_QUEUE_EXEC]), &transId) == 0)) {
+      break;
+    }
+    FwSmMakeTrans(queue->smDesc, transId);
+    nOfEvents++;
+  }
+
+  return nOfEvents;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+FwSmCounterU4_t FwSmQueueGetNOfPending(FwSmQueueDesc_t queue) {
+  FwSmCounterU4_t nOfPending = 0;
+  FwSmCounterU4_t tail;
+  FwSmCounterU4_t head;
+  int             i;
+
+  for (i = 0; i < 2; i++) {
+    head = queue->lanes[i].head;
+    tail = queue->lanes[i].tail;
+    /* A position may be claimed by a producer which has not yet written its cell */
+    if ((tail - head) <= (queue->lanes[i].mask + 1)) {
+      nOfPending += tail - head;
+    }
+  }
+
+  return nOfPending;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+FwSmCounterU4_t FwSmQueueGetNOfRejected(FwSmQueueDesc_t queue) {
+  return queue->nOfRejected;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+void FwSmQueueRelease(FwSmQueueDesc_t queue) {
+  free(queue->lanes[SM_QUEUE_CMD].cells);
+  free(queue->lanes[SM_QUEUE_EXEC].cells);
+  free(queue);
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+static FwSmBool_t InitLane(SmQueueLane_t* lane, FwSmCounterU4_t size) {
+  FwSmCounterU4_t nOfCells = 1;
+  FwSmCounterU4_t i;
+
+  /* The capacity is bounded so that the size of the cell array does not overflow */
+  if ((size == 0) || (size > ((FwSmCounterU4_t)-1) / (2 * sizeof(SmQueueCell_t)))) {
+    return 0;
+  }
+  while (nOfCells < size) {
+    nOfCells = 2 * nOfCells;
+  }
+
+  lane->cells = (SmQueueCell_t*)malloc(nOfCells * sizeof(SmQueueCell_t));
+  if (lane->cells == NULL) {
+    return 0;
+  }
+  for (i = 0; i < nOfCells; i++) {
+    lane->cells[i].seq     = i;
+    lane->cells[i].transId = 0;
+  }
+  lane->mask = nOfCells - 1;
+  lane->tail = 0;
+  lane->head = 0;
+
+  return 1;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+static FwSmBool_t PushLane(SmQueueLane_t* lane, FwSmCounterU2_t transId) {
+  SmQueueCell_t*  cell;
+  FwSmCounterU4_t pos;
+  FwSmCounterU4_t seq;
+
+  pos = lane->tail;
+  for (;;) {
+    cell = &(lane->cells[pos & lane->mask]);
+    seq  = cell->seq;
+    if (seq == pos) {
+      /* The cell is free: claim its position (another producer may have claimed it first) */
+      if (SM_QUEUE_ATOMIC_CAS(lane->tail, pos, pos + 1) == pos) {
+        break;
+      }
+      pos = lane->tail;
+    }
+    else if ((long)(seq - pos) < 0) {
+      /* The cell still holds the transition command posted one wrap-around earlier */
+      return 0;
+    }
+    else {
+      pos = lane->tail;
+    }
+  }
+
+  cell->transId = transId;
+  SM_QUEUE_BARRIER();
+  cell->seq = pos + 1;
+
+  return 1;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+static FwSmBool_t PopLane(SmQueueLane_t* lane, FwSmCounterU2_t* transId) {
+  SmQueueCell_t*  cell;
+  FwSmCounterU4_t pos;
+
+  pos  = lane->head;
+  cell = &(lane->cells[pos & lane->mask]);
+  if (cell->seq != pos + 1) {
+    return 0;
+  }
+
+  SM_QUEUE_BARRIER();
+  *transId = cell->transId;
+  SM_QUEUE_BARRIER();
+  cell->seq  = pos + lane->mask + 1;
+  lane->head = pos + 1;
+
+  return 1;
+}
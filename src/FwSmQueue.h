@@ -0,0 +1,131 @@
+/**
+ * @file
+ * @ingroup smGroup
+ * Declaration of the event queue interface for a FW State Machine.
+ * An event queue holds the transition commands which are posted to a state machine
+ * by one or more <i>producer</i> threads until they are dispatched to the state machine
+ * by a single <i>consumer</i> thread which owns the state machine.
+ * Producers can therefore send transition commands to a state machine without calling
+ * <code>::FwSmMakeTrans</code> and without serializing their access to the state machine.
+ *
+ * The basic mode of use of the functions declared in this file is as follows:
+ * -# The queue is created for a state machine with function <code>::FwSmQueueCreate</code>.
+ * -# The producers post transition commands with function <code>::FwSmQueuePost</code>.
+ * -# The consumer dispatches the transition commands to the state machine with
+ *    function <code>::FwSmQueueDispatch</code>.
+ * -# The queue is released with function <code>::FwSmQueueRelease</code>.
+ * .
+ * The queue has two <i>lanes</i>: the "Execute" transition commands (see
+ * <code>#FW_TR_EXECUTE</code>) are held in the <i>execute lane</i> and all other
+ * transition commands are held in the <i>command lane</i>.
+ * Each lane is a bounded first-in-first-out buffer.
+ * The dispatcher gives priority to the command lane: an "Execute" transition command is
+ * only dispatched when the command lane is empty.
+ *
+ * Dispatching has run-to-completion semantics: each transition command is processed by
+ * <code>::FwSmMakeTrans</code> to completion before the next transition command is taken
+ * from the queue.
+ * A transition command which is posted by a state machine action while a transition
+ * command is being dispatched is held in the queue and is dispatched after the current
+ * transition command has been processed.
+ *
+ * Posting a transition command is lock-free: it consists of one atomic
+ * compare-and-swap operation on the lane (which is repeated if another producer posts
+ * to the same lane at the same time) and of two stores.
+ * A transition command is rejected when its lane is full.
+ * The producer is informed of this through the return value of
+ * <code>::FwSmQueuePost</code> and the number of rejected transition commands is
+ * counted by the queue.
+ *
+ * The memory for the queue descriptor is allocated dynamically through calls
+ * to <code>malloc</code> and released through calls to <code>free</code>.
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2011, All Rights Reserved
+ *
+ * This file is part of the FW Profile.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#ifndef FWSM_QUEUE_H_
+#define FWSM_QUEUE_H_
+
+#include "FwSmCore.h"
+
+/**
+ * Create a new event queue for a state machine.
+ * The capacities of the two lanes of the queue are rounded up to the next power
+ * of two.
+ * The state machine is not modified by this function.
+ * @param smDesc the state machine to which the queue dispatches its transition commands.
+ * @param cmdSize the capacity of the command lane (a positive integer).
+ * @param execSize the capacity of the execute lane (a positive integer).
+ * @return the descriptor of the new queue (or NULL if the creation of the data structures
+ * to hold the queue descriptor failed or if one of the capacities is zero or too large).
+ */
+FwSmQueueDesc_t FwSmQueueCreate(FwSmDesc_t smDesc, FwSmCounterU4_t cmdSize, FwSmCounterU4_t execSize);
+
+/**
+ * Post a transition command to an event queue.
+ * The transition command is added to the execute lane if it is the "Execute" transition
+ * command and to the command lane otherwise.
+ * This function can be called by any thread at any time while the queue exists
+ * (including from the actions of the state machine to which the queue dispatches its
+ * transition commands).
+ * @param queue the descriptor of the queue.
+ * @param transId the identifier of the transition command.
+ * @return <code>#smSuccess</code> if the transition command was added to the queue or
+ * <code>#smQueueFull</code> if its lane is full (in this case, the transition command is
+ * discarded and the counter of rejected transition commands is incremented).
+ */
+FwSmErrCode_t FwSmQueuePost(FwSmQueueDesc_t queue, FwSmCounterU2_t transId);
+
+/**
+ * Dispatch the transition commands held in an event queue to its state machine.
+ * The transition commands are taken from the queue one by one (from the command lane
+ * if it is not empty and from the execute lane otherwise) and they are processed with
+ * <code>::FwSmMakeTrans</code>.
+ * The function returns when the queue is empty or when <code>maxEvents</code> transition
+ * commands have been dispatched.
+ *
+ * This function must only be called by the thread which owns the state machine of the
+ * queue and it must not be called from the actions or guards of that state machine.
+ * @param queue the descriptor of the queue.
+ * @param maxEvents the maximum number of transition commands to be dispatched.
+ * @return the number of transition commands which have been dispatched.
+ */
+FwSmCounterU4_t FwSmQueueDispatch(FwSmQueueDesc_t queue, FwSmCounterU4_t maxEvents);
+
+/**
+ * Return the number of transition commands which are held in an event queue.
+ * If producers post transition commands or the consumer dispatches them while
+ * this function is called, the returned value is only an approximation.
+ * @param queue the descriptor of the queue.
+ * @return the number of transition commands held in the queue.
+ */
+FwSmCounterU4_t FwSmQueueGetNOfPending(FwSmQueueDesc_t queue);
+
+/**
+ * Return the number of transition commands which have been rejected by an event queue
+ * because their lane was full.
+ * @param queue the descriptor of the queue.
+ * @return the number of rejected transition commands.
+ */
+FwSmCounterU4_t FwSmQueueGetNOfRejected(FwSmQueueDesc_t queue);
+
+/**
+ * Release the memory which was allocated when the event queue was created.
+ * The transition commands held in the queue are discarded and the state machine of
+ * the queue is not affected.
+ * This function should only be called when no other thread uses the queue.
+ * After this operation is called, the queue descriptor can no longer be used.
+ * @param queue the descriptor of the queue.
+ */
+void FwSmQueueRelease(FwSmQueueDesc_t queue);
+
+#endif /* FWSM_QUEUE_H_ */
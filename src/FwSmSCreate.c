@@ -26,6 +26,12 @@ void FwSmInit(FwSmDesc_t smDesc) {
   FwSmCounterS1_t i;
   SmBaseDesc_t*   smBase = smDesc->smBase;
 
+  /* The configuration index and the guard memo (if any) no longer match the action and guard arrays */
+  free(smDesc->cfgIndex);
+  free(smDesc->memo);
+  smDesc->cfgIndex = NULL;
+  smDesc->memo     = NULL;
+
   for (i = 0; i < smBase->nOfPStates; i++) {
     smBase->pStates[i].outTransIndex = 0;
     smDesc->esmDesc[i]               = NULL;
@@ -38,6 +44,7 @@ void FwSmInit(FwSmDesc_t smDesc) {
   for (i = 0; i < smBase->nOfTrans; i++) {
     smBase->trans[i].iTrAction = -1;
   }
+  smBase->isCompiled = 0;
 
   smDesc->smActions[0] = &SmDummyAction;
   for (i = 1; i < smDesc->nOfActions; i++) {
@@ -94,6 +101,74 @@ void FwSmInitDer(FwSmDesc_t smDesc, FwSmDesc_t smDescBase) {
   smDesc->stateExecCnt = 0;
   smDesc->transCnt     = 0;
   smDesc->curState     = 0;
+  smDesc->profile      = NULL;
+  smDesc->notify       = NULL;
+  smDesc->bcast        = NULL;
+  smDesc->lazy         = NULL;
+
+  /* The configuration index and the guard memo (if any) no longer match the action and guard arrays */
+  free(smDesc->cfgIndex);
+  free(smDesc->memo);
+  smDesc->cfgIndex = NULL;
+  smDesc->memo     = NULL;
+
+  return;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+void FwSmInitConst(FwSmDesc_t smDesc, const FwSmAction_t* actions, const FwSmGuard_t* guards) {
+  FwSmCounterS1_t i;
+  SmBaseDesc_t*   smBase = smDesc->smBase;
+
+  /* The action and guard indices of the constant base descriptor must fit in the arrays */
+  for (i = 0; i < smBase->nOfPStates; i++) {
+    if ((smBase->pStates[i].iEntryAction >= smDesc->nOfActions) ||
+        (smBase->pStates[i].iDoAction >= smDesc->nOfActions) ||
+        (smBase->pStates[i].iExitAction >= smDesc->nOfActions)) {
+      smDesc->errCode = smWrongNOfActions;
+      return;
+    }
+  }
+  for (i = 0; i < smBase->nOfTrans; i++) {
+    if (smBase->trans[i].iTrAction >= smDesc->nOfActions) {
+      smDesc->errCode = smWrongNOfActions;
+      return;
+    }
+    if (smBase->trans[i].iTrGuard >= smDesc->nOfGuards) {
+      smDesc->errCode = smWrongNOfGuards;
+      return;
+    }
+  }
+
+  smDesc->smActions[0] = &SmDummyAction;
+  for (i = 1; i < smDesc->nOfActions; i++) {
+    smDesc->smActions[i] = actions[i - 1];
+  }
+
+  smDesc->smGuards[0] = &SmDummyGuard;
+  for (i = 1; i < smDesc->nOfGuards; i++) {
+    smDesc->smGuards[i] = guards[i - 1];
+  }
+
+  for (i = 0; i < smBase->nOfPStates; i++) {
+    smDesc->esmDesc[i] = NULL;
+  }
+
+  smDesc->errCode      = smSuccess;
+  smDesc->smExecCnt    = 0;
+  smDesc->stateExecCnt = 0;
+  smDesc->transCnt     = 0;
+  smDesc->curState     = 0;
+  smDesc->profile      = NULL;
+  smDesc->notify       = NULL;
+  smDesc->bcast        = NULL;
+  smDesc->lazy         = NULL;
+
+  /* The configuration index and the guard memo (if any) no longer match the action and guard arrays */
+  free(smDesc->cfgIndex);
+  free(smDesc->memo);
+  smDesc->cfgIndex = NULL;
+  smDesc->memo     = NULL;
 
   return;
 }
@@ -48,6 +48,14 @@
  * initialized, it will normally need to be configured.
  * Configuration of a state machine descriptor can be done using the
  * functions described in the <code>FwSmConfig.h</code> file.
+ *
+ * The sizes passed to the instantiation macros (number of states, choice pseudo-states,
+ * transitions, actions and guards) must fit in the type <code>::FwSmCounterS1_t</code>.
+ * The number of actions and the number of guards must be smaller than
+ * <code>#FW_SM_COUNTER_S1_MAX</code> (because the macros reserve an additional location
+ * for the dummy action and the dummy guard).
+ * The width of <code>::FwSmCounterS1_t</code> is selected at build time through
+ * <code>#FW_SM_INDEX_WIDTH</code>.
  * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
  * @author Alessandro Pasetti <pasetti@pnp-software.com>
  * @copyright P&P Software GmbH, 2011, All Rights Reserved
@@ -83,6 +91,9 @@
  *   represent the array holding the state machine choice pseudo-states.
  * - It defines an array of NTRANS elements of type <code>SmTrans_t</code> to
  *   represent the array holding the state machine transitions.
+ * - It defines an array of <code>#SM_DISP_SIZE</code>(NTRANS) elements of type
+ *   <code>FwSmCounterS1_t</code> to represent the transition dispatch table (see
+ *   <code>::FwSmCompile</code>).
  * - It defines an array of (NA+1) elements of type <code>SmAction_t</code> to
  *   represent the array holding the state machine actions.
  * - It defines an array of (NG+1) elements of type <code>SmGuard_t</code> to
@@ -110,26 +121,41 @@
  * @param NG a non-negative integer representing the number of guards (i.e. the
  * number of transition actions which are defined on the state machine)
  */
-#define FW_SM_INST(SM_DESC, NS, NCPS, NTRANS, NA, NG)                                                                 \
-  static SmPState_t   SM_DESC##_pState[(NS)];                                                                         \
-  static SmCState_t   SM_DESC##_cState[(NCPS)];                                                                       \
-  static SmTrans_t    SM_DESC##_trans[(NTRANS)];                                                                      \
-  static FwSmAction_t SM_DESC##_actions[(NA) + 1];                                                                    \
-  static FwSmGuard_t  SM_DESC##_guards[(NG) + 1];                                                                     \
-  static FwSmDesc_t   SM_DESC##_esm[(NS)];                                                                            \
-  static SmBaseDesc_t SM_DESC##_base = {(SM_DESC##_pState), (SM_DESC##_cState), (SM_DESC##_trans), NS, NCPS, NTRANS}; \
-  static struct FwSmDesc(SM_DESC)    = {&(SM_DESC##_base),                                                            \
-                                     (SM_DESC##_actions),                                                             \
-                                     (SM_DESC##_guards),                                                              \
-                                     (SM_DESC##_esm),                                                                 \
-                                     (NA) + 1,                                                                        \
-                                     (NG) + 1,                                                                        \
-                                     1,                                                                               \
-                                     0,                                                                               \
-                                     0,                                                                               \
-                                     0,                                                                               \
-                                     smSuccess,                                                                       \
-                                     NULL};
+#define FW_SM_INST(SM_DESC, NS, NCPS, NTRANS, NA, NG)          \
+  static SmPState_t      SM_DESC##_pState[(NS)];               \
+  static SmCState_t      SM_DESC##_cState[(NCPS)];             \
+  static SmTrans_t       SM_DESC##_trans[(NTRANS)];            \
+  static FwSmCounterS1_t SM_DESC##_disp[SM_DISP_SIZE(NTRANS)]; \
+  static FwSmAction_t    SM_DESC##_actions[(NA) + 1];          \
+  static FwSmGuard_t     SM_DESC##_guards[(NG) + 1];           \
+  static FwSmDesc_t      SM_DESC##_esm[(NS)];                  \
+  static SmBaseDesc_t    SM_DESC##_base = {(SM_DESC##_pState), \
+                                           (SM_DESC##_cState), \
+                                           (SM_DESC##_trans),  \
+                                           NS,                 \
+                                           NCPS,               \
+                                           NTRANS,             \
+                                           (SM_DESC##_disp),   \
+                                           0};                 \
+  static struct FwSmDesc(SM_DESC) = {&(SM_DESC##_base),        \
+                                     (SM_DESC##_actions),      \
+                                     (SM_DESC##_guards),       \
+                                     (SM_DESC##_esm),          \
+                                     (NA) + 1,                 \
+                                     (NG) + 1,                 \
+                                     1,                        \
+                                     0,                        \
+                                     0,                        \
+                                     0,                        \
+                                     smSuccess,                \
+                                     NULL,                     \
+                                     NULL,                     \
+                                     NULL,                     \
+                                     NULL,                     \
+                                     NULL,                     \
+                                     NULL,                     \
+                                     NULL,                     \
+                                     0};
 
 /**
  * Instantiate a state machine descriptor and its internal data structure.
@@ -147,6 +173,9 @@
  *   the state machines embedded in the NS states.
  * - It defines an array of NTRANS elements of type <code>SmTrans_t</code> to
  *   represent the array holding the state machine transitions.
+ * - It defines an array of <code>#SM_DISP_SIZE</code>(NTRANS) elements of type
+ *   <code>FwSmCounterS1_t</code> to represent the transition dispatch table (see
+ *   <code>::FwSmCompile</code>).
  * - It defines an array of (NA+1) elements of type <code>SmAction_t</code> to
  *   represent the array holding the state machine actions.
  * - It defines an array of (NG+1) elements of type <code>SmGuard_t</code> to
@@ -173,25 +202,40 @@
  * @param NG a non-negative integer representing the number of guards (i.e. the
  * number of transition actions which are defined on the state machine)
  */
-#define FW_SM_INST_NOCPS(SM_DESC, NS, NTRANS, NA, NG)                                                \
-  static SmPState_t   SM_DESC##_pState[(NS)];                                                        \
-  static SmTrans_t    SM_DESC##_trans[(NTRANS)];                                                     \
-  static FwSmAction_t SM_DESC##_actions[(NA) + 1];                                                   \
-  static FwSmGuard_t  SM_DESC##_guards[(NG) + 1];                                                    \
-  static FwSmDesc_t   SM_DESC##_esm[(NS)];                                                           \
-  static SmBaseDesc_t SM_DESC##_base = {(SM_DESC##_pState), NULL, (SM_DESC##_trans), NS, 0, NTRANS}; \
-  static struct FwSmDesc(SM_DESC)    = {&(SM_DESC##_base),                                           \
-                                     (SM_DESC##_actions),                                            \
-                                     (SM_DESC##_guards),                                             \
-                                     (SM_DESC##_esm),                                                \
-                                     (NA) + 1,                                                       \
-                                     (NG) + 1,                                                       \
-                                     1,                                                              \
-                                     0,                                                              \
-                                     0,                                                              \
-                                     0,                                                              \
-                                     smSuccess,                                                      \
-                                     NULL};
+#define FW_SM_INST_NOCPS(SM_DESC, NS, NTRANS, NA, NG)          \
+  static SmPState_t      SM_DESC##_pState[(NS)];               \
+  static SmTrans_t       SM_DESC##_trans[(NTRANS)];            \
+  static FwSmCounterS1_t SM_DESC##_disp[SM_DISP_SIZE(NTRANS)]; \
+  static FwSmAction_t    SM_DESC##_actions[(NA) + 1];          \
+  static FwSmGuard_t     SM_DESC##_guards[(NG) + 1];           \
+  static FwSmDesc_t      SM_DESC##_esm[(NS)];                  \
+  static SmBaseDesc_t    SM_DESC##_base = {(SM_DESC##_pState), \
+                                           NULL,               \
+                                           (SM_DESC##_trans),  \
+                                           NS,                 \
+                                           0,                  \
+                                           NTRANS,             \
+                                           (SM_DESC##_disp),   \
+                                           0};                 \
+  static struct FwSmDesc(SM_DESC) = {&(SM_DESC##_base),        \
+                                     (SM_DESC##_actions),      \
+                                     (SM_DESC##_guards),       \
+                                     (SM_DESC##_esm),          \
+                                     (NA) + 1,                 \
+                                     (NG) + 1,                 \
+                                     1,                        \
+                                     0,                        \
+                                     0,                        \
+                                     0,                        \
+                                     smSuccess,                \
+                                     NULL,                     \
+                                     NULL,                     \
+                                     NULL,                     \
+                                     NULL,                     \
+                                     NULL,                     \
+                                     NULL,                     \
+                                     NULL,                     \
+                                     0};
 
 /**
  * Instantiate a descriptor for a derived state machine.
@@ -235,7 +279,56 @@
   static struct FwSmDesc(SM_DESC) =                                                                                  \
       {                                                                                                              \
           NULL, (SM_DESC##_actions), (SM_DESC##_guards), (SM_DESC##_esm), (NA) + 1, (NG) + 1, 1, 0, 0, 0, smSuccess, \
-          NULL};
+          NULL, NULL, NULL, NULL, NULL, NULL, NULL, 0};
+
+/**
+ * Instantiate a descriptor for a state machine whose base descriptor is a constant.
+ * The constant base descriptor SM_BASE is a variable of type <code>const SmBaseDesc_t</code>
+ * whose arrays are also constant.
+ * It is normally generated by <code>::FwSmGenerateConstBase</code> from a configured state
+ * machine and it can then be placed in read-only memory.
+ * The state machine instantiated by this macro uses the constant base descriptor in the
+ * same way as a derived state machine uses the base descriptor of its base state machine
+ * (see <code>#FW_SM_INST_DER</code>).
+ * Only the parts of the state machine descriptor which may change at run-time (its
+ * actions, guards, embedded state machines, current state, execution counters, error
+ * code and data) are allocated in writable memory.
+ *
+ * More precisely, this macro generates code that does the following:
+ * - It declares the constant base descriptor SM_BASE as an <code>extern</code> variable.
+ * - It defines an array of (NA+1) elements of type <code>SmAction_t</code> to
+ *   represent the array holding the state machine actions.
+ * - It defines an array of (NG+1) elements of type <code>SmGuard_t</code> to
+ *   represent the array holding the state machine guards.
+ * - It defines an array of NS elements to represent the array holding the state
+ *   machines embedded in the NS states.
+ * - It defines and initializes a variable with the name SM_DESC of type
+ *   <code>struct FwSmDesc</code> to represent the state machine descriptor.
+ * .
+ * All variables defined by this macro are <code>static</code>.
+ *
+ * The state machine descriptor instantiated by the macro is only partially
+ * initialized.
+ * Full initialization is performed using function <code>::FwSmInitConst</code>.
+ *
+ * Since the macro includes the declaration of several variables, it should be located
+ * in the section of a c-file where variable declaration is legal.
+ *
+ * @param SM_DESC the variable holding the state machine descriptor
+ * @param SM_BASE the constant base descriptor
+ * @param NS a positive integer representing the number of states
+ * @param NA a non-negative integer representing the number of actions (i.e. the
+ * number of transition or state actions which are defined on the state machine)
+ * @param NG a non-negative integer representing the number of guards
+ */
+#define FW_SM_INST_CONST(SM_DESC, SM_BASE, NS, NA, NG)                                                         \
+  extern const SmBaseDesc_t(SM_BASE);                                                                         \
+  static FwSmAction_t SM_DESC##_actions[(NA) + 1];                                                            \
+  static FwSmGuard_t  SM_DESC##_guards[(NG) + 1];                                                             \
+  static FwSmDesc_t   SM_DESC##_esm[(NS)];                                                                    \
+  static struct FwSmDesc(SM_DESC) = {(SmBaseDesc_t*)&(SM_BASE), (SM_DESC##_actions), (SM_DESC##_guards),      \
+                                     (SM_DESC##_esm), (NA) + 1, (NG) + 1, 0, 0, 0, 0, smSuccess, NULL, NULL,  \
+                                     NULL, NULL, NULL, NULL, NULL, 0};
 
 /**
  * Initialize a state machine descriptor to represent an unconfigured state
@@ -319,4 +412,34 @@ void FwSmInit(FwSmDesc_t smDesc);
  */
 void FwSmInitDer(FwSmDesc_t smDesc, FwSmDesc_t smDescBase);
 
+/**
+ * Initialize a state machine descriptor which has been instantiated with macro
+ * <code>#FW_SM_INST_CONST</code>.
+ * The actions and guards of the state machine are taken from the argument arrays.
+ * The i-th element of <code>actions</code> (<code>guards</code>) is bound to the
+ * action (guard) which was added in the i-th position to the state machine from which
+ * the constant base descriptor was generated.
+ * The argument arrays must therefore hold NA actions and NG guards (where NA and NG are
+ * the arguments of <code>#FW_SM_INST_CONST</code>).
+ *
+ * This function checks that the constant base descriptor does not refer to more actions
+ * or guards than the state machine descriptor holds.
+ * If this is not the case, the function sets the error code of the state machine
+ * descriptor to <code>#smWrongNOfActions</code> or <code>#smWrongNOfGuards</code> and
+ * returns.
+ * Otherwise, the function initializes the states of the state machine to have no embedded
+ * state machines and it sets its state to STOPPED.
+ *
+ * The state machine is then fully configured and, since the constant base descriptor
+ * holds the transition dispatch table, it is also compiled.
+ * Its actions and guards can be overridden with <code>::FwSmOverrideAction</code> and
+ * <code>::FwSmOverrideGuard</code> and state machines can be embedded in it with
+ * <code>::FwSmEmbed</code>.
+ * The configuration functions which add states or transitions must not be called on it.
+ * @param smDesc the state machine descriptor to be initialized.
+ * @param actions the actions of the state machine (excluding the dummy action).
+ * @param guards the guards of the state machine (excluding the dummy guard).
+ */
+void FwSmInitConst(FwSmDesc_t smDesc, const FwSmAction_t* actions, const FwSmGuard_t* guards);
+
 #endif /* FWSM_SCREATE_H_ */
@@ -0,0 +1,445 @@
+/**
+ * @file
+ * @ingroup smGroup
+ * Implements the snapshot functions for the FW State Machine Module.
+ * A snapshot consists of a header (see <code>::SmSnapHeader_t</code>) followed by
+ * an array of records (see <code>::SmSnapRecord_t</code>).
+ * The header and the records are copied to and from the snapshot with
+ * <code>memcpy</code> so that the snapshot buffers need not be aligned.
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2011, All Rights Reserved
+ *
+ * This file is part of the FW Profile.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#include "FwSmSnap.h"
+#include "FwSmPrivate.h"
+#include <string.h>
+
+/** The identifier of a full snapshot (stored in the <code>kind</code> field of its header). */
+#define SM_SNAP_FULL 0x534D5346UL
+/** The identifier of a delta snapshot (stored in the <code>kind</code> field of its header). */
+#define SM_SNAP_DELTA 0x534D5344UL
+
+/**
+ * The header of a snapshot.
+ */
+typedef struct {
+  /** the kind of snapshot (either <code>#SM_SNAP_FULL</code> or <code>#SM_SNAP_DELTA</code>) */
+  FwSmCounterU4_t kind;
+  /** the number of state machines in the hierarchy from which the snapshot was taken */
+  FwSmCounterU4_t nOfSms;
+  /** the number of records in the snapshot */
+  FwSmCounterU4_t nOfRecords;
+} SmSnapHeader_t;
+
+/**
+ * The record of the dynamic state of one state machine in a snapshot.
+ * In a full snapshot, the i-th record belongs to the i-th state machine of the
+ * hierarchy.
+ * In a delta snapshot, the records are sorted by increasing position of their state
+ * machine in the hierarchy.
+ */
+typedef struct {
+  /** the position of the state machine in the hierarchy */
+  FwSmCounterU4_t iSm;
+  /** the state machine execution counter */
+  FwSmCounterU3_t smExecCnt;
+  /** the state execution counter */
+  FwSmCounterU3_t stateExecCnt;
+  /** the current state of the state machine */
+  FwSmCounterS1_t curState;
+  /** the error code of the state machine */
+  FwSmErrCode_t errCode;
+  /** 1 if the state machine is instantiated or 0 if it is a lazily embedded state machine which is not instantiated */
+  FwSmBool_t isInst;
+} SmSnapRecord_t;
+
+/**
+ * The context of a visit of a hierarchy of state machines.
+ */
+typedef struct {
+  /** the position in the hierarchy of the state machine being visited */
+  FwSmCounterU4_t iSm;
+  /** the records which are written by the visit */
+  unsigned char* out;
+  /** the records which are read by the visit */
+  const unsigned char* in;
+  /** the number of records which have been written (or read) by the visit */
+  FwSmCounterU4_t nOfRecords;
+  /** the number of records which can be written (or which are available for reading) */
+  FwSmCounterU4_t maxRecords;
+  /**
+   * the state machine being visited or, if the position being visited holds a lazily
+   * embedded state machine which is not instantiated, its template (a visit function
+   * which instantiates or releases the embedded state machine updates this field)
+   */
+  FwSmDesc_t smDesc;
+  /** 1 if the state machine being visited is instantiated or 0 if it is a template */
+  FwSmBool_t isInst;
+  /** the state machine in which the state machine being visited is lazily embedded (or NULL) */
+  FwSmDesc_t lazyOwner;
+  /** the index of the state of <code>lazyOwner</code> in which the state machine is lazily embedded */
+  FwSmCounterS1_t iLazyState;
+} SmSnapCtx_t;
+
+/**
+ * Type of the functions which are called on each state machine of a hierarchy by
+ * <code>::SnapVisit</code>.
+ * @param smDesc the state machine.
+ * @param ctx the context of the visit.
+ * @return 1 if the visit is to be continued or 0 if it is to be aborted.
+ */
+typedef FwSmBool_t (*SmSnapVisit_t)(FwSmDesc_t smDesc, SmSnapCtx_t* ctx);
+
+/**
+ * Visit a hierarchy of state machines in depth-first order.
+ * The visit function is called on the argument state machine and then on the state
+ * machines embedded in its states (recursively).
+ * The position of the visited state machine is incremented after each call to the
+ * visit function.
+ *
+ * A state with the template of a lazily embedded state machine always occupies the
+ * positions of the hierarchy of its template: if the embedded state machine is not
+ * instantiated, the template is visited in its place (and the state machines of the
+ * hierarchy of the template are visited as not instantiated).
+ * Hence, the positions of the state machines do not depend on which lazily embedded
+ * state machines are instantiated.
+ * @param smDesc the state machine at the top of the hierarchy.
+ * @param isInst 1 if the state machine is instantiated or 0 if it is a template.
+ * @param lazyOwner the state machine in which the state machine is lazily embedded (or NULL).
+ * @param iLazyState the index of the state of <code>lazyOwner</code> in which the state machine is embedded.
+ * @param visit the visit function (or NULL if the state machines are only counted).
+ * @param ctx the context of the visit.
+ * @return 1 if all state machines were visited or 0 if the visit was aborted.
+ */
+static FwSmBool_t SnapVisit(FwSmDesc_t smDesc, FwSmBool_t isInst, FwSmDesc_t lazyOwner, FwSmCounterS1_t iLazyState,
+                            SmSnapVisit_t visit, SmSnapCtx_t* ctx);
+
+/**
+ * Visit function which writes the record of a state machine to a full snapshot.
+ * @param smDesc the state machine.
+ * @param ctx the context of the visit.
+ * @return always 1.
+ */
+static FwSmBool_t TakeRecord(FwSmDesc_t smDesc, SmSnapCtx_t* ctx);
+
+/**
+ * Visit function which writes the record of a state machine to a delta snapshot if
+ * the state machine differs from its record in the reference snapshot.
+ * @param smDesc the state machine.
+ * @param ctx the context of the visit.
+ * @return 1 if the visit is to be continued or 0 if the delta snapshot is full.
+ */
+static FwSmBool_t TakeDeltaRecord(FwSmDesc_t smDesc, SmSnapCtx_t* ctx);
+
+/**
+ * Visit function which checks the record of a state machine in a snapshot.
+ * @param smDesc the state machine.
+ * @param ctx the context of the visit.
+ * @return 1 if the state machine has no record or if its record is valid, 0 otherwise.
+ */
+static FwSmBool_t CheckRecord(FwSmDesc_t smDesc, SmSnapCtx_t* ctx);
+
+/**
+ * Visit function which restores a state machine from its record in a snapshot.
+ * If the state machine is lazily embedded and the record has a different instantiated
+ * flag, the state machine is first instantiated or released through the lazy embedding
+ * functions of its owner.
+ * @param smDesc the state machine.
+ * @param ctx the context of the visit.
+ * @return 1 if the visit is to be continued or 0 if the state machine could not be
+ * instantiated.
+ */
+static FwSmBool_t RestoreRecord(FwSmDesc_t smDesc, SmSnapCtx_t* ctx);
+
+/**
+ * Read the record of the state machine being visited from the snapshot which is read
+ * by a visit.
+ * The records of a snapshot are read in the order in which they are stored: the next
+ * record is consumed if it belongs to the state machine being visited.
+ * Since the state machines are visited in increasing order of position, all records
+ * are consumed by a visit if and only if they are sorted by increasing position and
+ * they only refer to state machines in the hierarchy.
+ * @param ctx the context of the visit.
+ * @param rec the location where the record is stored.
+ * @return 1 if the snapshot holds a record of the state machine or 0 otherwise.
+ */
+static FwSmBool_t GetRecord(SmSnapCtx_t* ctx, SmSnapRecord_t* rec);
+
+/**
+ * Fill a record with the dynamic state of the state machine being visited.
+ * The record of a state machine which is not instantiated only holds its position.
+ * @param smDesc the state machine.
+ * @param ctx the context of the visit.
+ * @param rec the record.
+ */
+static void FillRecord(FwSmDesc_t smDesc, SmSnapCtx_t* ctx, SmSnapRecord_t* rec);
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+FwSmCounterU4_t FwSmSnapGetSize(FwSmDesc_t smDesc) {
+  SmSnapCtx_t ctx;
+
+  ctx.iSm = 0;
+  (void)SnapVisit(smDesc, 1, NULL, 0, NULL, &ctx);
+  return (FwSmCounterU4_t)(sizeof(SmSnapHeader_t) + ctx.iSm * sizeof(SmSnapRecord_t));
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+FwSmCounterU4_t FwSmSnapTake(FwSmDesc_t smDesc, void* buffer, FwSmCounterU4_t bufSize) {
+  SmSnapHeader_t  header;
+  SmSnapCtx_t     ctx;
+  FwSmCounterU4_t size = FwSmSnapGetSize(smDesc);
+
+  if ((buffer == NULL) || (bufSize < size)) {
+    return 0;
+  }
+
+  ctx.iSm        = 0;
+  ctx.out        = (unsigned char*)buffer + sizeof(SmSnapHeader_t);
+  ctx.nOfRecords = 0;
+  (void)SnapVisit(smDesc, 1, NULL, 0, &TakeRecord, &ctx);
+
+  header.kind       = SM_SNAP_FULL;
+  header.nOfSms     = ctx.iSm;
+  header.nOfRecords = ctx.nOfRecords;
+  memcpy(buffer, &header, sizeof(SmSnapHeader_t));
+  return size;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+FwSmCounterU4_t FwSmSnapTakeDelta(FwSmDesc_t smDesc, void* ref, FwSmCounterU4_t refSize, void* buffer,
+                                  FwSmCounterU4_t bufSize) {
+  SmSnapHeader_t  header;
+  SmSnapRecord_t  rec;
+  SmSnapCtx_t     ctx;
+  FwSmCounterU4_t i;
+  unsigned char*  refRecords;
+
+  if ((buffer == NULL) || (bufSize < sizeof(SmSnapHeader_t)) || (ref == NULL) || (refSize != FwSmSnapGetSize(smDesc))) {
+    return 0;
+  }
+  refRecords = (unsigned char*)ref + sizeof(SmSnapHeader_t);
+  memcpy(&header, ref, sizeof(SmSnapHeader_t));
+  if ((header.kind != SM_SNAP_FULL) || (header.nOfRecords != header.nOfSms) ||
+      (refSize != sizeof(SmSnapHeader_t) + header.nOfSms * sizeof(SmSnapRecord_t))) {
+    return 0;
+  }
+
+  /* Write the records of the state machines which differ from the reference snapshot */
+  ctx.iSm        = 0;
+  ctx.out        = (unsigned char*)buffer + sizeof(SmSnapHeader_t);
+  ctx.in         = refRecords;
+  ctx.nOfRecords = 0;
+  ctx.maxRecords = (FwSmCounterU4_t)((bufSize - sizeof(SmSnapHeader_t)) / sizeof(SmSnapRecord_t));
+  if (SnapVisit(smDesc, 1, NULL, 0, &TakeDeltaRecord, &ctx) == 0) {
+    return 0;
+  }
+
+  /* Bring the reference snapshot up to date */
+  for (i = 0; i < ctx.nOfRecords; i++) {
+    memcpy(&rec, ctx.out + i * sizeof(SmSnapRecord_t), sizeof(SmSnapRecord_t));
+    memcpy(refRecords + rec.iSm * sizeof(SmSnapRecord_t), &rec, sizeof(SmSnapRecord_t));
+  }
+
+  header.kind       = SM_SNAP_DELTA;
+  header.nOfRecords = ctx.nOfRecords;
+  memcpy(buffer, &header, sizeof(SmSnapHeader_t));
+  return (FwSmCounterU4_t)(sizeof(SmSnapHeader_t) + ctx.nOfRecords * sizeof(SmSnapRecord_t));
+}
+
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+FwSmBool_t FwSmSnapRestore(FwSmDesc_t smDesc, const void* snap, FwSmCounterU4_t snapSize) {
+  SmSnapHeader_t header;
+  SmSnapCtx_t    ctx;
+
+  if ((snap == NULL) || (snapSize < sizeof(SmSnapHeader_t))) {
+    return 0;
+  }
+  memcpy(&header, snap, sizeof(SmSnapHeader_t));
+  ctx.iSm = 0;
+  (void)SnapVisit(smDesc, 1, NULL, 0, NULL, &ctx);
+  if (((header.kind != SM_SNAP_FULL) && (header.kind != SM_SNAP_DELTA)) || (header.nOfSms != ctx.iSm) ||
+      (header.nOfRecords > header.nOfSms) || ((header.kind == SM_SNAP_FULL) && (header.nOfRecords != header.nOfSms)) ||
+      (snapSize != sizeof(SmSnapHeader_t) + header.nOfRecords * sizeof(SmSnapRecord_t))) {
+    return 0;
+  }
+
+  /* Check all records before modifying the hierarchy */
+  ctx.iSm        = 0;
+  ctx.in         = (const unsigned char*)snap + sizeof(SmSnapHeader_t);
+  ctx.nOfRecords = 0;
+  ctx.maxRecords = header.nOfRecords;
+  if ((SnapVisit(smDesc, 1, NULL, 0, &CheckRecord, &ctx) == 0) || (ctx.nOfRecords != header.nOfRecords)) {
+    return 0;
+  }
+
+  ctx.iSm        = 0;
+  ctx.nOfRecords = 0;
+  return SnapVisit(smDesc, 1, NULL, 0, &RestoreRecord, &ctx);
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+static FwSmBool_t SnapVisit(FwSmDesc_t smDesc, FwSmBool_t isInst, FwSmDesc_t lazyOwner, FwSmCounterS1_t iLazyState,
+                            SmSnapVisit_t visit, SmSnapCtx_t* ctx) {
+  FwSmCounterS1_t i;
+  FwSmBool_t      isVisited;
+
+  ctx->smDesc     = smDesc;
+  ctx->isInst     = isInst;
+  ctx->lazyOwner  = lazyOwner;
+  ctx->iLazyState = iLazyState;
+  if ((visit != NULL) && (visit(smDesc, ctx) == 0)) {
+    return 0;
+  }
+  /* The visit function may have instantiated or released a lazily embedded state machine */
+  smDesc = ctx->smDesc;
+  isInst = ctx->isInst;
+  ctx->iSm++;
+  for (i = 0; i < smDesc->smBase->nOfPStates; i++) {
+    if (SmIsLazy(smDesc, i)) {
+      if ((isInst == 1) && (smDesc->esmDesc[i] != NULL)) {
+        isVisited = SnapVisit(smDesc->esmDesc[i], 1, smDesc, i, visit, ctx);
+      }
+      else {
+        isVisited = SnapVisit(smDesc->lazy->esm[i].esmBase, 0, ((isInst == 1) ? smDesc : NULL), i, visit, ctx);
+      }
+    }
+    else if (smDesc->esmDesc[i] != NULL) {
+      isVisited = SnapVisit(smDesc->esmDesc[i], isInst, NULL, 0, visit, ctx);
+    }
+    else {
+      isVisited = 1;
+    }
+    if (isVisited == 0) {
+      return 0;
+    }
+  }
+  return 1;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+static FwSmBool_t TakeRecord(FwSmDesc_t smDesc, SmSnapCtx_t* ctx) {
+  SmSnapRecord_t rec;
+
+  FillRecord(smDesc, ctx, &rec);
+  memcpy(ctx->out + ctx->nOfRecords * sizeof(SmSnapRecord_t), &rec, sizeof(SmSnapRecord_t));
+  ctx->nOfRecords++;
+  return 1;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+static FwSmBool_t TakeDeltaRecord(FwSmDesc_t smDesc, SmSnapCtx_t* ctx) {
+  SmSnapRecord_t rec;
+  SmSnapRecord_t refRec;
+
+  FillRecord(smDesc, ctx, &rec);
+  memcpy(&refRec, ctx->in + ctx->iSm * sizeof(SmSnapRecord_t), sizeof(SmSnapRecord_t));
+  if ((rec.curState == refRec.curState) && (rec.smExecCnt == refRec.smExecCnt) &&
+      (rec.stateExecCnt == refRec.stateExecCnt) && (rec.errCode == refRec.errCode) && (rec.isInst == refRec.isInst)) {
+    return 1;
+  }
+  if (ctx->nOfRecords == ctx->maxRecords) {
+    return 0;
+  }
+  memcpy(ctx->out + ctx->nOfRecords * sizeof(SmSnapRecord_t), &rec, sizeof(SmSnapRecord_t));
+  ctx->nOfRecords++;
+  return 1;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+static FwSmBool_t CheckRecord(FwSmDesc_t smDesc, SmSnapCtx_t* ctx) {
+  SmSnapRecord_t rec;
+
+  if (GetRecord(ctx, &rec) == 0) {
+    return 1;
+  }
+  if ((rec.isInst != 0) && (rec.isInst != 1)) {
+    return 0;
+  }
+  /* A state machine can only be instantiated or released if it is lazily embedded */
+  if ((rec.isInst != ctx->isInst) && (ctx->lazyOwner == NULL) && (ctx->isInst == 1)) {
+    return 0;
+  }
+  return (FwSmBool_t)((rec.curState >= 0) && (rec.curState <= smDesc->smBase->nOfPStates));
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+static FwSmBool_t RestoreRecord(FwSmDesc_t smDesc, SmSnapCtx_t* ctx) {
+  SmSnapRecord_t rec;
+  FwSmDesc_t     owner = ctx->lazyOwner;
+
+  if (GetRecord(ctx, &rec) == 0) {
+    return 1;
+  }
+
+  /* Instantiate or release a lazily embedded state machine (the positions of the embedded hierarchy are unchanged) */
+  if ((rec.isInst != ctx->isInst) && (owner != NULL)) {
+    if (rec.isInst == 1) {
+      smDesc = owner->lazy->get(owner, ctx->iLazyState);
+      if (smDesc == NULL) {
+        return 0;
+      }
+    }
+    else {
+      owner->lazy->put(owner, ctx->iLazyState, 1);
+      smDesc = owner->lazy->esm[ctx->iLazyState].esmBase;
+    }
+    if (owner->bcast != NULL) {
+      SmBcastChange(owner);
+    }
+    ctx->smDesc = smDesc;
+    ctx->isInst = rec.isInst;
+  }
+  if (ctx->isInst == 0) {
+    return 1;
+  }
+
+  if (smDesc->curState != rec.curState) {
+    if (smDesc->notify != NULL) {
+      SmNotifyChange(smDesc);
+    }
+    if (smDesc->bcast != NULL) {
+      SmBcastChange(smDesc);
+    }
+  }
+  smDesc->curState     = rec.curState;
+  smDesc->smExecCnt    = rec.smExecCnt;
+  smDesc->stateExecCnt = rec.stateExecCnt;
+  smDesc->errCode      = rec.errCode;
+  return 1;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+static FwSmBool_t GetRecord(SmSnapCtx_t* ctx, SmSnapRecord_t* rec) {
+  if (ctx->nOfRecords == ctx->maxRecords) {
+    return 0;
+  }
+  memcpy(rec, ctx->in + ctx->nOfRecords * sizeof(SmSnapRecord_t), sizeof(SmSnapRecord_t));
+  if (rec->iSm != ctx->iSm) {
+    return 0;
+  }
+  ctx->nOfRecords++;
+  return 1;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+static void FillRecord(FwSmDesc_t smDesc, SmSnapCtx_t* ctx, SmSnapRecord_t* rec) {
+  memset(rec, 0, sizeof(SmSnapRecord_t));
+  rec->iSm    = ctx->iSm;
+  rec->isInst = ctx->isInst;
+  if (ctx->isInst == 1) {
+    rec->smExecCnt    = smDesc->smExecCnt;
+    rec->stateExecCnt = smDesc->stateExecCnt;
+    rec->curState     = smDesc->curState;
+    rec->errCode      = smDesc->errCode;
+  }
+}
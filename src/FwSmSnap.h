@@ -0,0 +1,156 @@
+/**
+ * @file
+ * @ingroup smGroup
+ * Declaration of the snapshot interface for a FW State Machine.
+ * A snapshot is a compact binary record of the dynamic state of a hierarchy of state
+ * machines.
+ * The hierarchy consists of a state machine and of all the state machines which are
+ * embedded in its states (recursively).
+ * The dynamic state of a state machine in the hierarchy consists of its current state,
+ * of its two execution counters (see <code>::FwSmGetExecCnt</code> and
+ * <code>::FwSmGetStateExecCnt</code>) and of its error code.
+ * Snapshots are intended to be used to checkpoint the state of an application (e.g.
+ * for hot standby and failover) and to restore it without executing any state machine
+ * action.
+ *
+ * There are two kinds of snapshot:
+ * - A <i>full snapshot</i> holds one record for each state machine in the hierarchy.
+ *   It is created with <code>::FwSmSnapTake</code>.
+ * - A <i>delta snapshot</i> only holds records for the state machines whose dynamic
+ *   state has changed since the last checkpoint.
+ *   It is created with <code>::FwSmSnapTakeDelta</code> which compares the hierarchy
+ *   with a full snapshot of the last checkpoint (the <i>reference snapshot</i>) and
+ *   which brings the reference snapshot up to date.
+ * .
+ * Both kinds of snapshot are restored with <code>::FwSmSnapRestore</code>.
+ * A hierarchy is brought back to the state of its last checkpoint by restoring its
+ * first full snapshot and then all the delta snapshots taken after it in the order
+ * in which they were taken (or, equivalently, by restoring the reference snapshot).
+ *
+ * The state machines in a hierarchy are visited in depth-first order: a state machine
+ * is visited before the state machines embedded in its states and the state machines
+ * embedded in a state are visited before those embedded in the states with higher
+ * identifiers.
+ * A record refers to a state machine through its position in this order.
+ * Hence, snapshots can only be restored to a hierarchy which has the same structure
+ * as the hierarchy from which they were taken.
+ *
+ * A state with the template of a lazily embedded state machine (see
+ * <code>::FwSmEmbedLazy</code> and <code>::FwSmEmbedLazyPool</code>) always occupies
+ * the positions of the hierarchy of its template, whether or not the embedded state
+ * machine is instantiated.
+ * The number of state machines in a hierarchy and their positions therefore do not
+ * change when lazily embedded state machines are instantiated or released.
+ * The record of a lazily embedded state machine holds a flag which indicates whether
+ * it is instantiated and only holds its dynamic state if it is instantiated.
+ * The templates must not be recursive (i.e. the hierarchy of a template must not hold
+ * the template itself).
+ * A snapshot does not hold the actions, guards, data or configuration of the state
+ * machines.
+ *
+ * Snapshots can be written to and read from buffers with any alignment.
+ * They can only be exchanged between applications which use the same version of the
+ * FW Profile, the same index width (see <code>#FW_SM_INDEX_WIDTH</code>) and processors
+ * with the same byte order.
+ *
+ * The functions declared in this header file do not allocate memory: all snapshots
+ * are held in buffers provided by the caller.
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2011, All Rights Reserved
+ *
+ * This file is part of the FW Profile.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#ifndef FWSM_SNAP_H_
+#define FWSM_SNAP_H_
+
+#include "FwSmCore.h"
+
+/**
+ * Return the size of a full snapshot of a hierarchy of state machines.
+ * This is also the largest possible size of a delta snapshot of the hierarchy.
+ * @param smDesc the descriptor of the state machine at the top of the hierarchy.
+ * @return the size of the snapshot in bytes.
+ */
+FwSmCounterU4_t FwSmSnapGetSize(FwSmDesc_t smDesc);
+
+/**
+ * Take a full snapshot of a hierarchy of state machines.
+ * The hierarchy is visited once and the dynamic state of each of its state machines
+ * is written to the buffer.
+ * The state machines are not modified by this function.
+ * @param smDesc the descriptor of the state machine at the top of the hierarchy.
+ * @param buffer the buffer where the snapshot is written.
+ * @param bufSize the size of the buffer in bytes.
+ * @return the size of the snapshot in bytes or zero if the buffer is NULL or too small
+ * (see <code>::FwSmSnapGetSize</code>).
+ */
+FwSmCounterU4_t FwSmSnapTake(FwSmDesc_t smDesc, void* buffer, FwSmCounterU4_t bufSize);
+
+/**
+ * Take a delta snapshot of a hierarchy of state machines.
+ * The hierarchy is visited once and the dynamic state of each of its state machines
+ * is compared with its record in the reference snapshot.
+ * The delta snapshot holds the records of the state machines whose dynamic state
+ * differs from their record in the reference snapshot.
+ * If the delta snapshot is successfully written to the buffer, these records are
+ * also updated in the reference snapshot which therefore always holds the dynamic
+ * state of the hierarchy at the time of the last checkpoint.
+ * If the function fails, the reference snapshot is not modified.
+ *
+ * The reference snapshot must be a full snapshot which was taken from the same
+ * hierarchy with <code>::FwSmSnapTake</code> (and which may have been updated by
+ * earlier calls to this function).
+ * The state machines are not modified by this function.
+ * @param smDesc the descriptor of the state machine at the top of the hierarchy.
+ * @param ref the reference snapshot.
+ * @param refSize the size of the reference snapshot in bytes.
+ * @param buffer the buffer where the delta snapshot is written (it must not overlap
+ * the reference snapshot).
+ * @param bufSize the size of the buffer in bytes.
+ * @return the size of the delta snapshot in bytes or zero if the buffer is NULL or too
+ * small to hold the records of the state machines which have changed or if the
+ * reference snapshot is not a full snapshot of the hierarchy.
+ */
+FwSmCounterU4_t FwSmSnapTakeDelta(FwSmDesc_t smDesc, void* ref, FwSmCounterU4_t refSize, void* buffer,
+                                  FwSmCounterU4_t bufSize);
+
+/**
+ * Restore the dynamic state of a hierarchy of state machines from a full or delta
+ * snapshot.
+ * The dynamic state of each state machine which has a record in the snapshot is
+ * overwritten with the content of its record.
+ * The state machines which have no record in the snapshot are not modified.
+ * No action of the state machines is executed and their profiling data (if any) are
+ * not updated.
+ * The state machines whose current state is modified are reported to the owner of their
+ * change notification data (see <code>::FwSmEnableNotify</code>) and to their broadcast
+ * registry (see <code>::FwSmBcastAdd</code>), if any.
+ * If a lazily embedded state machine is instantiated in the hierarchy but not in its
+ * record, it is released (or returned to its pool).
+ * If it is instantiated in its record but not in the hierarchy, it is instantiated
+ * (or taken from its pool) and then restored from its record.
+ * If its instantiation fails, the restoration is aborted and the function returns 0
+ * (in this case, the hierarchy may have been partially restored and the error code
+ * of the state machine in which the embedded state machine is embedded is set).
+ *
+ * The snapshot is checked before it is restored: if it is truncated or corrupted, if
+ * it was taken from a hierarchy with a different number of state machines or if one
+ * of its records holds a current state which does not exist in its state machine, the
+ * function returns without modifying the hierarchy.
+ * @param smDesc the descriptor of the state machine at the top of the hierarchy.
+ * @param snap the snapshot.
+ * @param snapSize the size of the snapshot in bytes.
+ * @return 1 if the snapshot was restored or 0 if it was rejected or if an embedded state
+ * machine could not be instantiated.
+ */
+FwSmBool_t FwSmSnapRestore(FwSmDesc_t smDesc, const void* snap, FwSmCounterU4_t snapSize);
+
+#endif /* FWSM_SNAP_H_ */
@@ -0,0 +1,122 @@
+/**
+ * @file
+ * @ingroup trGroup
+ * Implements the tracing interface of the state machine and procedure modules.
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the FW Profile.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#include "FwTrace.h"
+#include <stdlib.h>
+
+#if defined(__GNUC__)
+/** Storage class of the per-thread ring buffer pointer. */
+#define FW_TRACE_TLS __thread
+/** Full memory barrier between the accesses to the events and to the ring buffer indices. */
+#define FW_TRACE_BARRIER() __sync_synchronize()
+#else
+#define FW_TRACE_TLS
+#define FW_TRACE_BARRIER() ((void)0)
+#endif
+
+/** The ring buffer attached to the calling thread. */
+static FW_TRACE_TLS struct FwTraceRing* traceRing = NULL;
+
+/** The function which provides the time stamps of the events. */
+static FwTraceClock_t traceClock = NULL;
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+int FwTraceRingInit(struct FwTraceRing* ring, FwTraceEvent_t* events, FwTraceCounterU4_t size) {
+  if ((size == 0) || ((size & (size - 1)) != 0)) {
+    return 0;
+  }
+  ring->events     = events;
+  ring->size       = size;
+  ring->head       = 0;
+  ring->tail       = 0;
+  ring->nOfDropped = 0;
+  ring->mask       = FW_TRACE_MASK_DEFAULT;
+  return 1;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+void FwTraceSetMask(struct FwTraceRing* ring, FwTraceCounterU4_t mask) {
+  ring->mask = mask;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+void FwTraceSetRing(struct FwTraceRing* ring) {
+  traceRing = ring;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+struct FwTraceRing* FwTraceGetRing(void) {
+  return traceRing;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+void FwTraceSetClock(FwTraceClock_t clock) {
+  traceClock = clock;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+void FwTraceRecord(FwTraceEventType_t type, const void* desc, int id, int value) {
+  struct FwTraceRing* ring = traceRing;
+  FwTraceEvent_t*     event;
+  FwTraceCounterU4_t  head;
+
+  if ((ring == NULL) || ((ring->mask & FW_TRACE_MASK(type)) == 0)) {
+    return;
+  }
+
+  head = ring->head;
+  if ((head - ring->tail) >= ring->size) { /* ring buffer is full */
+    ring->nOfDropped++;
+    return;
+  }
+
+  event        = &(ring->events[head & (ring->size - 1)]);
+  event->time  = (traceClock != NULL) ? traceClock() : 0;
+  event->desc  = desc;
+  event->type  = (int)type;
+  event->id    = id;
+  event->value = value;
+
+  /* The event must be visible to the consumer before the new head */
+  FW_TRACE_BARRIER();
+  ring->head = head + 1;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+FwTraceCounterU4_t FwTraceDrain(struct FwTraceRing* ring, FwTraceEvent_t* events, FwTraceCounterU4_t maxNOfEvents) {
+  FwTraceCounterU4_t tail = ring->tail;
+  FwTraceCounterU4_t head = ring->head;
+  FwTraceCounterU4_t n    = 0;
+
+  /* The events up to the head must be read after the head */
+  FW_TRACE_BARRIER();
+  while ((tail != head) && (n < maxNOfEvents)) {
+    events[n] = ring->events[tail & (ring->size - 1)];
+    tail++;
+    n++;
+  }
+
+  /* The events must have been read before the producer can overwrite them */
+  FW_TRACE_BARRIER();
+  ring->tail = tail;
+  return n;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+FwTraceCounterU4_t FwTraceGetNOfDropped(struct FwTraceRing* ring) {
+  return ring->nOfDropped;
+}
@@ -0,0 +1,249 @@
+/**
+ * @file
+ * @ingroup trGroup
+ * Declaration of the tracing interface of the state machine and procedure modules.
+ * The tracing interface records the hot-path events of state machines and
+ * procedures (state entries and exits, fired transitions, guard outcomes,
+ * decision node outcomes, etc.) in a fixed-size binary ring buffer.
+ *
+ * The tracing hooks are only compiled into the state machine and procedure
+ * modules if the symbol <code>FW_TRACE</code> is defined at build time
+ * (e.g. <code>make release TRACE=1</code>).
+ * If the symbol is not defined, the hooks expand to nothing and tracing has no
+ * run-time cost.
+ *
+ * The basic mode of use of the tracing interface is as follows:
+ * -# The user instantiates a <code>struct FwTraceRing</code> and an array of
+ *    <code>::FwTraceEvent_t</code> whose size is a power of two and initializes the
+ *    ring buffer with <code>::FwTraceRingInit</code>.
+ * -# The thread which executes the state machines and procedures to be traced
+ *    attaches the ring buffer to itself with <code>::FwTraceSetRing</code>.
+ *    Each thread has its own ring buffer and threads without a ring buffer are not
+ *    traced.
+ * -# Optionally, the user sets the function which provides the time stamps of the
+ *    events with <code>::FwTraceSetClock</code>.
+ * -# Another thread (or the same thread) periodically extracts the recorded events
+ *    with <code>::FwTraceDrain</code> and, for instance, writes them to disk with
+ *    <code>fwrite</code>.
+ * .
+ * Each ring buffer has one producer (the thread to which it is attached) and one
+ * consumer (the thread which drains it) and is lock-free.
+ *
+ * A ring buffer only records the kinds of events which are selected by its mask
+ * (see <code>::FwTraceSetMask</code>).
+ * By default, the hot-path events are recorded and the <i>command events</i> are not.
+ * The command events record the calls to <code>::FwSmMakeTrans</code> (including the
+ * transition commands of <code>::FwSmMakeTransBatch</code>), <code>::FwSmExecute</code>
+ * and <code>::FwPrExecute</code> made by the application (but not the calls made internally
+ * by these functions).
+ * A ring buffer which only records the command events holds the stream of commands
+ * received by the state machines and procedures, which can be replayed offline
+ * (see the <code>replay</code> target of the Makefile).
+ * If the ring buffer is full, new events are discarded and counted as dropped.
+ *
+ * On compilers other than GCC, the ring buffers are shared by all threads and
+ * the ring buffer may only be drained by the thread which fills it.
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the FW Profile.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#ifndef FWTRACE_H_
+#define FWTRACE_H_
+
+/** Type used for the time stamps of the trace events. */
+typedef long unsigned int FwTraceTime_t;
+
+/** Type used for the sizes and indices of the trace ring buffers. */
+typedef long unsigned int FwTraceCounterU4_t;
+
+/**
+ * Type for a pointer to the function which provides the time stamps of the trace events.
+ * The unit of the time stamps is defined by the user (e.g. processor cycles or ns).
+ */
+typedef FwTraceTime_t (*FwTraceClock_t)(void);
+
+/** Enumerated type for the kinds of trace events. */
+typedef enum {
+  /** A state machine has entered a state (the identifier is the state). */
+  traceSmStateEntry = 1,
+  /** A state machine has exited a state (the identifier is the state). */
+  traceSmStateExit = 2,
+  /** A state machine has executed the do-action of a state (the identifier is the state). */
+  traceSmDoAction = 3,
+  /**
+   * A state machine has fired a transition (the identifier is the transition trigger and
+   * the value is the source state).
+   */
+  traceSmTrans = 4,
+  /**
+   * A state machine has evaluated the guard of a transition (the identifier is the transition
+   * trigger or, for transitions out of a choice pseudo-state, the choice pseudo-state and the
+   * value is the outcome of the guard).
+   */
+  traceSmGuard = 5,
+  /** A procedure has executed an action node (the identifier is the node). */
+  tracePrNode = 6,
+  /**
+   * A procedure has evaluated the guard of a control flow (the identifier is the destination of
+   * the flow and the value is the outcome of the guard).
+   */
+  tracePrGuard = 7,
+  /**
+   * A procedure has left a decision node (the identifier is the decision node and the value is the
+   * index of the selected control flow or -1 if all control flows have a false guard).
+   */
+  tracePrDecision = 8,
+  /** A procedure has reached its final node. */
+  tracePrFinal = 9,
+  /** A state machine has received a transition command (the identifier is the transition command). */
+  traceSmMakeTransCmd = 10,
+  /** A state machine has been executed. */
+  traceSmExecuteCmd = 11,
+  /** A procedure has been executed. */
+  tracePrExecuteCmd = 12
+} FwTraceEventType_t;
+
+/** Bit of the mask of a ring buffer which selects a kind of trace events (see <code>::FwTraceSetMask</code>). */
+#define FW_TRACE_MASK(type) (1UL << (type))
+
+/**
+ * Mask of a ring buffer which selects the hot-path events (this is the default mask of a ring buffer).
+ * The hot-path events are the events from <code>#traceSmStateEntry</code> to <code>#tracePrFinal</code>.
+ */
+#define FW_TRACE_MASK_DEFAULT (FW_TRACE_MASK(traceSmMakeTransCmd) - FW_TRACE_MASK(traceSmStateEntry))
+
+/** Mask of a ring buffer which selects the command events. */
+#define FW_TRACE_MASK_CMDS (FW_TRACE_MASK(traceSmMakeTransCmd) | FW_TRACE_MASK(traceSmExecuteCmd) | \
+                            FW_TRACE_MASK(tracePrExecuteCmd))
+
+/** Structure representing a trace event. */
+typedef struct {
+  /** The time stamp of the event (0 if no clock has been set). */
+  FwTraceTime_t time;
+  /** The descriptor of the state machine or procedure which generated the event. */
+  const void* desc;
+  /** The kind of the event. */
+  int type;
+  /** The identifier of the event (its meaning depends on the kind of the event). */
+  int id;
+  /** The value of the event (its meaning depends on the kind of the event). */
+  int value;
+} FwTraceEvent_t;
+
+/**
+ * Structure representing a trace ring buffer.
+ * The indices grow monotonically and are reduced modulo the size of the buffer
+ * when the buffer is accessed.
+ */
+struct FwTraceRing {
+  /** The array holding the events. */
+  FwTraceEvent_t* events;
+  /** The size of the array (a power of two). */
+  FwTraceCounterU4_t size;
+  /** The index where the next event is written (only written by the producer). */
+  volatile FwTraceCounterU4_t head;
+  /** The index where the next event is read (only written by the consumer). */
+  volatile FwTraceCounterU4_t tail;
+  /** The number of events which have been discarded because the buffer was full. */
+  volatile FwTraceCounterU4_t nOfDropped;
+  /** The mask selecting the kinds of events which are recorded (see <code>::FwTraceSetMask</code>). */
+  FwTraceCounterU4_t mask;
+};
+
+/**
+ * Record a trace event if tracing is compiled in.
+ * This macro is used by the state machine and procedure modules to record their events.
+ * @param type the kind of the event
+ * @param desc the descriptor of the state machine or procedure
+ * @param id the identifier of the event
+ * @param value the value of the event
+ */
+#ifdef FW_TRACE
+#define FW_TRACE_EVENT(type, desc, id, value) FwTraceRecord((type), (desc), (int)(id), (int)(value))
+#else
+#define FW_TRACE_EVENT(type, desc, id, value) ((void)0)
+#endif
+
+/**
+ * Initialize a trace ring buffer.
+ * @param ring the ring buffer
+ * @param events the array where the events are stored
+ * @param size the number of elements in the array (it must be a power of two)
+ * @return 1 if the ring buffer was initialized, 0 if the size is not a power of two
+ */
+int FwTraceRingInit(struct FwTraceRing* ring, FwTraceEvent_t* events, FwTraceCounterU4_t size);
+
+/**
+ * Select the kinds of events which are recorded in a ring buffer.
+ * The mask is a combination of the bits <code>#FW_TRACE_MASK</code> of the kinds of
+ * events (e.g. <code>#FW_TRACE_MASK_DEFAULT</code> or <code>#FW_TRACE_MASK_CMDS</code>).
+ * The events of the other kinds are neither recorded nor counted as dropped.
+ * A ring buffer has mask <code>#FW_TRACE_MASK_DEFAULT</code> when it is initialized.
+ * This function should be called before the ring buffer is attached to a thread.
+ * @param ring the ring buffer
+ * @param mask the mask of the kinds of events to be recorded
+ */
+void FwTraceSetMask(struct FwTraceRing* ring, FwTraceCounterU4_t mask);
+
+/**
+ * Attach a ring buffer to the calling thread.
+ * All subsequent events generated by the calling thread are recorded in the ring buffer.
+ * A value of NULL stops the tracing of the calling thread.
+ * @param ring the ring buffer (or NULL)
+ */
+void FwTraceSetRing(struct FwTraceRing* ring);
+
+/**
+ * Return the ring buffer attached to the calling thread.
+ * @return the ring buffer attached to the calling thread (or NULL)
+ */
+struct FwTraceRing* FwTraceGetRing(void);
+
+/**
+ * Set the function which provides the time stamps of the trace events.
+ * The function is shared by all threads.
+ * A value of NULL means that events are not time stamped.
+ * @param clock the clock function (or NULL)
+ */
+void FwTraceSetClock(FwTraceClock_t clock);
+
+/**
+ * Record a trace event in the ring buffer of the calling thread.
+ * This function is normally called through macro <code>#FW_TRACE_EVENT</code>.
+ * If no ring buffer is attached to the calling thread or if the kind of the event is
+ * not selected by the mask of the ring buffer, the function returns without doing anything.
+ * @param type the kind of the event
+ * @param desc the descriptor of the state machine or procedure
+ * @param id the identifier of the event
+ * @param value the value of the event
+ */
+void FwTraceRecord(FwTraceEventType_t type, const void* desc, int id, int value);
+
+/**
+ * Extract the recorded events from a ring buffer.
+ * The events are copied, oldest first, to the argument array and are removed from
+ * the ring buffer.
+ * @param ring the ring buffer
+ * @param events the array where the events are copied
+ * @param maxNOfEvents the number of elements in the array
+ * @return the number of events copied to the array
+ */
+FwTraceCounterU4_t FwTraceDrain(struct FwTraceRing* ring, FwTraceEvent_t* events, FwTraceCounterU4_t maxNOfEvents);
+
+/**
+ * Return the number of events which have been discarded because the ring buffer was full.
+ * @param ring the ring buffer
+ * @return the number of discarded events
+ */
+FwTraceCounterU4_t FwTraceGetNOfDropped(struct FwTraceRing* ring);
+
+#endif /* FWTRACE_H_ */
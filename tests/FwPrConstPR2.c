@@ -0,0 +1,59 @@
+/*
+ * Code generated by FwPrGenerateConstBase.
+ * Constant base descriptor FwPrConstPR2 of a procedure with the following size:
+ * - number of action nodes: 3
+ * - number of decision nodes: 2
+ * - number of control flows: 9
+ * - number of actions: 1
+ * - number of guards: 8
+ * .
+ * The procedure is instantiated with FW_PR_INST_CONST(PR_DESC, FwPrConstPR2, 1, 8).
+ */
+
+#include "FwPrPrivate.h"
+
+static const PrANode_t FwPrConstPR2_aNodes[3] = {
+  {1, 0},
+  {2, 0},
+  {3, 0}
+};
+
+static const PrDNode_t FwPrConstPR2_dNodes[2] = {
+  {4, 3},
+  {7, 2}
+};
+
+static const PrFlow_t FwPrConstPR2_flows[9] = {
+  {1, 1},
+  {2, 2},
+  {-1, 0},
+  {2, 6},
+  {0, 3},
+  {-2, 4},
+  {3, 5},
+  {3, 7},
+  {0, 8}
+};
+
+static const PrExecFlow_t FwPrConstPR2_exec[9] = {
+  {1, 1, 0, 1, 1},
+  {2, 2, 0, 2, 1},
+  {-1, 0, 0, 4, 3},
+  {2, 6, 0, 2, 1},
+  {0, 3, 0, 0, 0},
+  {-2, 4, 0, 7, 2},
+  {3, 5, 0, 3, 1},
+  {3, 7, 0, 3, 1},
+  {0, 8, 0, 0, 0}
+};
+
+const PrBaseDesc_t FwPrConstPR2 = {
+  (PrANode_t*)FwPrConstPR2_aNodes,
+  (PrDNode_t*)FwPrConstPR2_dNodes,
+  (PrFlow_t*)FwPrConstPR2_flows,
+  3,
+  2,
+  9,
+  (PrExecFlow_t*)FwPrConstPR2_exec,
+  1
+};
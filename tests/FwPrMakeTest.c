@@ -60,6 +60,15 @@ static void incrCnt1By1(FwPrDesc_t prDesc) {
 	fwPrLogIndex++;
 }
 
+/**
+ * Operation used as node action in the procedures of <code>::FwPrMakeTestPRLarge</code>.
+ * This operation increments counter_1 by 1 but does not write to the log arrays.
+ * @param prDesc the procedure descriptor
+ */
+static void incrCnt1By1NoLog(FwPrDesc_t prDesc) {
+	GetTestPrData(prDesc)->counter_1++;
+}
+
 /**
  * Operation used as node action in the test procedures.
  * This operation increments counter_1 by 8.
@@ -169,6 +178,25 @@ static FwPrBool_t returnCounter1SmallerThan6(FwPrDesc_t prDesc) {
 	return (prData->counter_1 < 6);
 }
 
+/**
+ * Configure a procedure with the topology of the procedures created by
+ * <code>::FwPrMakeTestPRLarge</code>.
+ * @param prDesc the procedure descriptor
+ * @param nOfANodes the number of action nodes in the procedure
+ * @param prData the data structure upon which the procedure operates
+ */
+static void ConfigTestPRLarge(FwPrDesc_t prDesc, FwPrCounterS1_t nOfANodes, struct TestPrData* prData) {
+	FwPrCounterS1_t i;
+
+	FwPrSetData(prDesc, prData);
+	for (i=1; i<=nOfANodes; i++)
+		FwPrAddActionNode(prDesc, i, &incrCnt1By1NoLog);
+	FwPrAddFlowIniToAct(prDesc, N1, NULL);
+	for (i=1; i<nOfANodes; i++)
+		FwPrAddFlowActToAct(prDesc, i, (FwPrCounterS1_t)(i+1), NULL);
+	FwPrAddFlowActToFin(prDesc, nOfANodes, NULL);
+}
+
 struct TestPrData* GetTestPrData(FwPrDesc_t prDesc) {
 	return (struct TestPrData*)FwPrGetData(prDesc);
 }
@@ -329,6 +357,8 @@ FwPrDesc_t FwPrMakeTestPR2Dir(struct TestPrData* prData) {
 	prBase.nOfANodes = 3;
 	prBase.nOfDNodes = 2;
 	prBase.nOfFlows = 9;
+	prBase.execFlows = NULL;
+	prBase.isCompiled = 0;
 	prDesc.curNode = 0;
 	prDesc.errCode = prSuccess;
 	prDesc.flowCnt = 0;
@@ -585,3 +615,32 @@ FwPrDesc_t FwPrMakeTestPRDer1Static(FwPrDesc_t prDescBase, struct TestPrData* pr
 	return p_pr;
 }
 
+/* ----------------------------------------------------------------------------------------------------------------- */
+FwPrDesc_t FwPrMakeTestPRLarge(FwPrCounterS1_t nOfANodes, struct TestPrData* prData) {
+	FwPrDesc_t p_pr;
+
+	/* Create and configure the procedure */
+	p_pr = FwPrCreate(nOfANodes, 0, (FwPrCounterS1_t)(nOfANodes+1), 1, 0);
+	if (p_pr == NULL)
+		return NULL;
+	ConfigTestPRLarge(p_pr, nOfANodes, prData);
+
+	return p_pr;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+FwPrDesc_t FwPrMakeTestPRLargeArena(FwPrCounterS1_t nOfANodes, void* buffer, FwPrCounterU4_t bufSize,
+                                    struct TestPrData* prData) {
+	FwPrDesc_t p_pr;
+
+	/* Create the procedure in its arena and configure it */
+	if (buffer == NULL)
+		p_pr = FwPrCreateArena(nOfANodes, 0, (FwPrCounterS1_t)(nOfANodes+1), 1, 0);
+	else
+		p_pr = FwPrCreateInBuffer(buffer, bufSize, nOfANodes, 0, (FwPrCounterS1_t)(nOfANodes+1), 1, 0);
+	if (p_pr == NULL)
+		return NULL;
+	ConfigTestPRLarge(p_pr, nOfANodes, prData);
+
+	return p_pr;
+}
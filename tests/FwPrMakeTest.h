@@ -45,6 +45,14 @@
 /** Size of the log arrays */
 #define LOG_ARRAY_SIZE 50
 
+/**
+ * Maximum number of action nodes of the procedures created by <code>::FwPrMakeTestPRLarge</code>
+ * in the test cases.
+ * The limit keeps the size of the test procedures reasonable when the index types
+ * are 32 bits wide.
+ */
+#define LARGE_MAX_ANODES 1000
+
 /**
  * Type for the data structure passed to all procedures made by the functions declared
  * by this header file.
@@ -334,4 +342,44 @@ FwPrDesc_t FwPrMakeTestPRDer1(FwPrDesc_t prDescBase, struct TestPrData* prData);
  */
 FwPrDesc_t FwPrMakeTestPRDer1Static(FwPrDesc_t prDescBase, struct TestPrData* prData);
 
+/**
+ * Operation to create a test procedure with a configurable number of action nodes.
+ * This procedure is intended to verify the behaviour of procedures whose size
+ * depends on the width of the <code>::FwPrCounterS1_t</code> type.
+ * This procedure has the following characteristics:
+ * - N action nodes N1 to NN (N is given by the function argument).
+ * - No decision nodes.
+ * - N+1 control flows: from the initial node to N1, from Ni to N(i+1) for i
+ *   in [1,N-1], and from NN to the final node.
+ * - Node actions increment counter Counter_1 by 1 (unlike the actions of the other test
+ *   procedures, they do not write to the log arrays, which only hold
+ *   <code>#LOG_ARRAY_SIZE</code> entries).
+ * - No guards.
+ * .
+ * Since all control flows have no guards, the procedure runs from the initial node
+ * to the final node when it is executed for the first time.
+ * @param nOfANodes the number of action nodes N (a positive integer smaller than the
+ * maximum value of <code>::FwPrCounterS1_t</code>)
+ * @param prData the data structure upon which the procedure operates
+ * @return the descriptor of the created procedure or NULL if the creation
+ * of the procedure failed.
+ */
+FwPrDesc_t FwPrMakeTestPRLarge(FwPrCounterS1_t nOfANodes, struct TestPrData* prData);
+
+/**
+ * Operation to create and configure in an arena a procedure with the same
+ * characteristics as the procedure created by <code>::FwPrMakeTestPRLarge</code>.
+ * If the buffer argument is NULL, the procedure is created with
+ * <code>::FwPrCreateArena</code>.
+ * Otherwise, it is created in the buffer with <code>::FwPrCreateInBuffer</code>.
+ * @param nOfANodes the number of action nodes N
+ * @param buffer the buffer where the procedure is created (or NULL)
+ * @param bufSize the size of the buffer in bytes
+ * @param prData the data structure upon which the procedure operates
+ * @return the descriptor of the created procedure or NULL if the creation
+ * of the procedure failed.
+ */
+FwPrDesc_t FwPrMakeTestPRLargeArena(FwPrCounterS1_t nOfANodes, void* buffer, FwPrCounterU4_t bufSize,
+                                    struct TestPrData* prData);
+
 #endif /* FWPR_MAKETESTPR_H_ */
@@ -18,9 +18,19 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <stddef.h>
 #include "FwPrConstants.h"
 #include "FwPrDCreate.h"
 #include "FwPrSCreate.h"
+#include "FwPrAux.h"
+#include "FwPrPool.h"
+#include "FwPrConfig.h"
+#include "FwPrSnap.h"
+#include "FwPrCost.h"
+#include "FwSched.h"
+#include "FwPrPrivate.h"
+#include "FwTrace.h"
 #include "FwPrTestCases.h"
 #include "FwPrMakeTest.h"
 
@@ -2309,3 +2319,1639 @@ FwPrTestOutcome_t FwPrTestCaseCheck14() {
 	return prTestCaseSuccess;
 }
 
+
+/*------------------------------------------------------------------------------------------------- */
+FwPrTestOutcome_t FwPrTestCaseCheck15() {
+	FwPrDesc_t prDesc;
+	const FwPrCounterS1_t nOfANodes = 3;
+	const FwPrCounterS1_t nOfDNodes = 0;
+	const FwPrCounterS1_t nOfFlows = 4;
+	const FwPrCounterS1_t nOfActions = 1;
+	const FwPrCounterS1_t nOfGuards = 0;
+
+	/* Create the procedure */
+	prDesc = FwPrCreate(nOfANodes,nOfDNodes,nOfFlows,nOfActions,nOfGuards);
+	if (prDesc == NULL)
+		return prTestCaseFailure;
+
+	/* Define the procedure (N2 and N3 only have control flows to each other) */
+	FwPrAddActionNode(prDesc, N1, &DummyAction);
+	FwPrAddActionNode(prDesc, N2, &DummyAction);
+	FwPrAddActionNode(prDesc, N3, &DummyAction);
+	FwPrAddFlowIniToAct(prDesc, N1, NULL);
+	FwPrAddFlowActToFin(prDesc, N1, NULL);
+	FwPrAddFlowActToAct(prDesc, N2, N3, NULL);
+	FwPrAddFlowActToAct(prDesc, N3, N2, NULL);
+
+	/* Verify that configuration check fails */
+	if (FwPrCheck(prDesc) != prDisconnectedANode) {
+		FwPrRelease(prDesc);
+		return prTestCaseFailure;
+	}
+
+	/* Release memory used by test procedure and return */
+	FwPrRelease(prDesc);
+	return prTestCaseSuccess;
+}
+
+/*------------------------------------------------------------------------------------------------- */
+FwPrTestOutcome_t FwPrTestCaseCheck16() {
+	FwPrDesc_t prDesc;
+	const FwPrCounterS1_t nOfANodes = 1;
+	const FwPrCounterS1_t nOfDNodes = 2;
+	const FwPrCounterS1_t nOfFlows = 6;
+	const FwPrCounterS1_t nOfActions = 1;
+	const FwPrCounterS1_t nOfGuards = 0;
+
+	/* Create the procedure */
+	prDesc = FwPrCreate(nOfANodes,nOfDNodes,nOfFlows,nOfActions,nOfGuards);
+	if (prDesc == NULL)
+		return prTestCaseFailure;
+
+	/* Define the procedure (D1 and D2 are only reached from each other) */
+	FwPrAddActionNode(prDesc, N1, &DummyAction);
+	FwPrAddDecisionNode(prDesc, D1, 2);
+	FwPrAddDecisionNode(prDesc, D2, 2);
+	FwPrAddFlowIniToAct(prDesc, N1, NULL);
+	FwPrAddFlowActToFin(prDesc, N1, NULL);
+	FwPrAddFlowDecToDec(prDesc, D1, D2, NULL);
+	FwPrAddFlowDecToFin(prDesc, D1, NULL);
+	FwPrAddFlowDecToDec(prDesc, D2, D1, NULL);
+	FwPrAddFlowDecToFin(prDesc, D2, NULL);
+
+	/* Verify that configuration check fails */
+	if (FwPrCheck(prDesc) != prDisconnectedDNode) {
+		FwPrRelease(prDesc);
+		return prTestCaseFailure;
+	}
+
+	/* Release memory used by test procedure and return */
+	FwPrRelease(prDesc);
+	return prTestCaseSuccess;
+}
+/* ----------------------------------------------------------------------------------------------------------------- */
+FwPrTestOutcome_t FwPrTestCaseLarge1() {
+	struct TestPrData sPrData;
+	struct TestPrData* prData = &sPrData;
+	const FwPrCounterS1_t nOfANodes = (FwPrCounterS1_t)((FW_PR_COUNTER_S1_MAX - 2 < LARGE_MAX_ANODES) ?
+	                                  (FW_PR_COUNTER_S1_MAX - 2) : LARGE_MAX_ANODES);
+	FwPrDesc_t prDesc;
+
+	/* Initialize data structures holding the procedure data */
+	prData->counter_1 = 0;
+	prData->marker = 0;
+	prData->flag_1 = 0;
+	prData->flag_2 = 0;
+	prData->flag_3 = 0;
+	prData->flag_4 = 0;
+
+	/* Create and check the test procedure */
+	prDesc = FwPrMakeTestPRLarge(nOfANodes, prData);
+	if (prDesc == NULL)
+		return prTestCaseFailure;
+	if (FwPrCheck(prDesc) != prSuccess) {
+		FwPrRelease(prDesc);
+		return prTestCaseFailure;
+	}
+
+	/* Start and execute the procedure */
+	FwPrStart(prDesc);
+	FwPrExecute(prDesc);
+	if ((FwPrIsStarted(prDesc) != 0) || (prData->counter_1 != nOfANodes) ||
+	        (FwPrGetErrCode(prDesc) != prSuccess)) {
+		FwPrRelease(prDesc);
+		return prTestCaseFailure;
+	}
+
+	FwPrRelease(prDesc);
+	return prTestCaseSuccess;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+FwPrTestOutcome_t FwPrTestCaseArena1() {
+	struct TestPrData sPrData;
+	struct TestPrData* prData = &sPrData;
+	const FwPrCounterS1_t nOfANodes = 5;
+	static unsigned char buffer[1024];
+	FwPrDesc_t prDesc1, prDesc2;
+	FwPrCounterU4_t size;
+
+	/* Initialize data structures holding the procedure data */
+	prData->counter_1 = 0;
+	prData->marker = 0;
+	prData->flag_1 = 0;
+	prData->flag_2 = 0;
+	prData->flag_3 = 0;
+	prData->flag_4 = 0;
+
+	/* Check the arena size and the creation in a buffer which is too small */
+	size = FwPrGetArenaSize(nOfANodes, 0, (FwPrCounterS1_t)(nOfANodes+1), 1, 0);
+	if ((size == 0) || (size > sizeof(buffer)-1))
+		return prTestCaseFailure;
+	if (FwPrGetArenaSize(nOfANodes, 0, 1, 1, 0) != 0)
+		return prTestCaseFailure;
+	if (FwPrCreateInBuffer(buffer, size-1, nOfANodes, 0, (FwPrCounterS1_t)(nOfANodes+1), 1, 0) != NULL)
+		return prTestCaseFailure;
+
+	/* Create the test procedures and check their alignment */
+	prDesc1 = FwPrMakeTestPRLargeArena(nOfANodes, NULL, 0, prData);
+	if (prDesc1 == NULL)
+		return prTestCaseFailure;
+	prDesc2 = FwPrMakeTestPRLargeArena(nOfANodes, buffer+1, size, prData);
+	if ((prDesc2 == NULL) || (((FwPrCounterU4_t)prDesc1) % FW_PR_ARENA_ALIGN != 0) ||
+	        (((FwPrCounterU4_t)prDesc2) % FW_PR_ARENA_ALIGN != 0)) {
+		FwPrReleaseArena(prDesc1);
+		return prTestCaseFailure;
+	}
+
+	/* Check, start and execute the procedures */
+	if ((FwPrCheck(prDesc1) != prSuccess) || (FwPrCheck(prDesc2) != prSuccess)) {
+		FwPrReleaseArena(prDesc1);
+		return prTestCaseFailure;
+	}
+	fwPrLogIndex = 0;
+	FwPrStart(prDesc1);
+	FwPrStart(prDesc2);
+	FwPrExecute(prDesc1);
+	FwPrExecute(prDesc2);
+	if ((FwPrIsStarted(prDesc1) != 0) || (FwPrIsStarted(prDesc2) != 0) || (prData->counter_1 != 2*nOfANodes) ||
+	        (fwPrLogIndex != 0)) {
+		FwPrReleaseArena(prDesc1);
+		return prTestCaseFailure;
+	}
+
+	/* Only the first procedure is released because the memory of the second one is owned by the caller */
+	FwPrReleaseArena(prDesc1);
+	return prTestCaseSuccess;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+FwPrTestOutcome_t FwPrTestCaseTrace1() {
+	struct TestPrData sPrData;
+	struct TestPrData* prData = &sPrData;
+	static FwTraceEvent_t events[32];
+	FwTraceEvent_t drained[32];
+	struct FwTraceRing ring;
+	FwTraceCounterU4_t n;
+	FwPrDesc_t prDesc;
+
+	/* reset log */
+	fwPrLogIndex = 0;
+
+	/* Initialize data structures holding the procedure data */
+	prData->counter_1 = 0;
+	prData->flag_1 = 1;
+	prData->flag_2 = 1;
+	prData->flag_3 = 1;
+	prData->flag_4 = 0;
+	prData->flag_5 = 0;
+	prData->flag_6 = 0;
+	prData->marker = 1;
+
+	/* Create the test procedure and execute it from the initial to the final node */
+	prDesc = FwPrMakeTestPR2(prData);
+	if ((prDesc == NULL) || (FwTraceRingInit(&ring, events, 32) != 1))
+		return prTestCaseFailure;
+	FwTraceSetRing(&ring);
+	FwPrStart(prDesc);
+	FwPrExecute(prDesc);
+	FwTraceSetRing(NULL);
+	if ((FwPrIsStarted(prDesc) != 0) || (prData->counter_1 != 2)) {
+		FwPrRelease(prDesc);
+		return prTestCaseFailure;
+	}
+	n = FwTraceDrain(&ring, drained, 32);
+
+#ifdef FW_TRACE
+	/* Five events up to the flow into D1, one guard event per flow out of D1, the decision and the final node */
+	if ((n < 8) || (FwTraceGetNOfDropped(&ring) != 0) ||
+	        (drained[0].type != tracePrGuard) || (drained[0].id != N1) || (drained[0].value != 1) ||
+	        (drained[1].type != tracePrNode) || (drained[1].id != N1) || (drained[1].desc != prDesc) ||
+	        (drained[3].type != tracePrNode) || (drained[3].id != N2) ||
+	        (drained[4].type != tracePrGuard) || (drained[4].id != -D1) ||
+	        (drained[n-2].type != tracePrDecision) || (drained[n-2].id != D1) ||
+	        (drained[n-2].value != (int)(n-8)) || (drained[n-1].type != tracePrFinal)) {
+		FwPrRelease(prDesc);
+		return prTestCaseFailure;
+	}
+#else
+	/* With the tracing hooks compiled out, the procedure records no events */
+	if (n != 0) {
+		FwPrRelease(prDesc);
+		return prTestCaseFailure;
+	}
+#endif
+
+	FwPrRelease(prDesc);
+	return prTestCaseSuccess;
+}
+
+/**
+ * Clock function used by the profiling test cases: each call advances the time by 10 units.
+ * @return the current time
+ */
+static FwPrCounterU4_t PrProfileTestClock() {
+	static FwPrCounterU4_t time = 0;
+	time = time + 10;
+	return time;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+FwPrTestOutcome_t FwPrTestCaseProfile1() {
+	struct TestPrData sPrData;
+	struct TestPrData* prData = &sPrData;
+	FwPrCounterS1_t i, iFlowN1, baseLoc;
+	FwPrCounterU4_t nOfTaken = 0;
+	FwPrDesc_t prDesc;
+	FILE* outfile;
+
+	/* reset log */
+	fwPrLogIndex = 0;
+
+	/* Initialize data structures holding the procedure data */
+	prData->counter_1 = 0;
+	prData->flag_1 = 1;
+	prData->flag_2 = 0;
+	prData->flag_3 = 1;
+	prData->flag_4 = 0;
+	prData->flag_5 = 0;
+	prData->flag_6 = 0;
+	prData->marker = 1;
+
+	/* Create the test procedure and enable profiling on it */
+	prDesc = FwPrMakeTestPR2(prData);
+	if ((prDesc == NULL) || (prDesc->profile != NULL))
+		return prTestCaseFailure;
+	FwPrEnableProfile(prDesc, &PrProfileTestClock);
+	if ((prDesc->profile == NULL) || (FwPrGetErrCode(prDesc) != prSuccess)) {
+		FwPrRelease(prDesc);
+		return prTestCaseFailure;
+	}
+
+	/* Execute the procedure: it waits in N1 once and then terminates through D1 */
+	FwPrStart(prDesc);
+	FwPrExecute(prDesc);
+	prData->flag_2 = 1;
+	FwPrExecute(prDesc);
+	iFlowN1 = prDesc->prBase->aNodes[N1-1].iFlow;
+	baseLoc = prDesc->prBase->dNodes[D1-1].outFlowIndex;
+	for (i = baseLoc; i < baseLoc + prDesc->prBase->dNodes[D1-1].nOfOutTrans; i++)
+		nOfTaken += prDesc->profile->flowTakenCnt[i];
+	if ((FwPrIsStarted(prDesc) != 0) || (prData->counter_1 != 2) || (prDesc->profile->flowTakenCnt[0] != 1) ||
+	        (prDesc->profile->nodeExecCnt[N1-1] != 1) || (prDesc->profile->nodeExecCnt[N2-1] != 1) ||
+	        (prDesc->profile->nodeDwell[N1-1] != 10) || (prDesc->profile->nodeDwell[N2-1] != 10) ||
+	        (prDesc->profile->guardFalseCnt[iFlowN1] != 1) || (prDesc->profile->guardTrueCnt[iFlowN1] != 1) ||
+	        (prDesc->profile->flowTakenCnt[iFlowN1] != 1) || (nOfTaken != 1)) {
+		FwPrRelease(prDesc);
+		return prTestCaseFailure;
+	}
+
+	/* Print the profile report */
+	outfile = tmpfile();
+	if (outfile != NULL) {
+		FwPrPrintProfile(prDesc, outfile);
+		fclose(outfile);
+	}
+
+	/* Reset and disable profiling */
+	FwPrResetProfile(prDesc);
+	if ((prDesc->profile->flowTakenCnt[0] != 0) || (prDesc->profile->nodeDwell[N1-1] != 0)) {
+		FwPrRelease(prDesc);
+		return prTestCaseFailure;
+	}
+	FwPrDisableProfile(prDesc);
+	if (prDesc->profile != NULL) {
+		FwPrRelease(prDesc);
+		return prTestCaseFailure;
+	}
+
+	FwPrRelease(prDesc);
+	return prTestCaseSuccess;
+}
+
+/**
+ * Action used by the configuration index test cases.
+ * @param prDesc the procedure descriptor
+ */
+static void PrCfgIndexAction1(FwPrDesc_t prDesc) {
+	(void)prDesc;
+}
+
+/**
+ * Action used by the configuration index test cases.
+ * @param prDesc the procedure descriptor
+ */
+static void PrCfgIndexAction2(FwPrDesc_t prDesc) {
+	(void)prDesc;
+}
+
+/**
+ * Action used by the configuration index test cases.
+ * @param prDesc the procedure descriptor
+ */
+static void PrCfgIndexAction3(FwPrDesc_t prDesc) {
+	(void)prDesc;
+}
+
+/**
+ * Action used by the configuration index test cases.
+ * @param prDesc the procedure descriptor
+ */
+static void PrCfgIndexAction4(FwPrDesc_t prDesc) {
+	(void)prDesc;
+}
+
+/**
+ * Guard used by the configuration index test cases.
+ * @param prDesc the procedure descriptor
+ * @return always 1
+ */
+static FwPrBool_t PrCfgIndexGuard1(FwPrDesc_t prDesc) {
+	(void)prDesc;
+	return 1;
+}
+
+/**
+ * Guard used by the configuration index test cases.
+ * @param prDesc the procedure descriptor
+ * @return always 0
+ */
+static FwPrBool_t PrCfgIndexGuard2(FwPrDesc_t prDesc) {
+	(void)prDesc;
+	return 0;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+FwPrTestOutcome_t FwPrTestCaseCfgIndex1() {
+	FwPrDesc_t prDesc, prDescDer, prDescFull;
+	PrBaseDesc_t* prBase;
+	FwPrCounterS1_t i;
+
+	/* Create a procedure whose action and guard arrays are large enough to use the index (the
+	 * number of guards may not exceed the number of control flows and most control flows are
+	 * therefore from a decision node to the final node) */
+	prDesc = FwPrCreate(3, 1, FW_PR_CFG_INDEX_MIN, 3, FW_PR_CFG_INDEX_MIN);
+	if ((prDesc == NULL) || (prDesc->cfgIndex != NULL))
+		return prTestCaseFailure;
+	prBase = prDesc->prBase;
+
+	/* Add the action nodes and check that actions are stored once */
+	FwPrAddActionNode(prDesc, 1, &PrCfgIndexAction1);
+	FwPrAddActionNode(prDesc, 2, &PrCfgIndexAction2);
+	FwPrAddActionNode(prDesc, 3, &PrCfgIndexAction1);
+	FwPrAddDecisionNode(prDesc, 1, FW_PR_CFG_INDEX_MIN - 4);
+	if ((prDesc->cfgIndex == NULL) || (prBase->aNodes[0].iAction != 0) || (prBase->aNodes[1].iAction != 1) ||
+	        (prBase->aNodes[2].iAction != 0) || (prDesc->prActions[2] != NULL)) {
+		FwPrRelease(prDesc);
+		return prTestCaseFailure;
+	}
+
+	/* Add the control flows and check that guards are stored once */
+	FwPrAddFlowIniToAct(prDesc, 1, &PrCfgIndexGuard1);
+	FwPrAddFlowActToAct(prDesc, 1, 2, &PrCfgIndexGuard1);
+	FwPrAddFlowActToAct(prDesc, 2, 3, NULL);
+	FwPrAddFlowActToDec(prDesc, 3, 1, &PrCfgIndexGuard1);
+	for (i = 0; i < FW_PR_CFG_INDEX_MIN - 4; i++)
+		FwPrAddFlowDecToFin(prDesc, 1, &PrCfgIndexGuard2);
+	if ((FwPrGetErrCode(prDesc) != prSuccess) || (prBase->flows[0].iGuard != 1) ||
+	        (prBase->flows[prBase->aNodes[0].iFlow].iGuard != 1) ||
+	        (prBase->flows[prBase->aNodes[1].iFlow].iGuard != 0) ||
+	        (prBase->flows[prBase->aNodes[2].iFlow].iGuard != 1) ||
+	        (prBase->flows[prBase->dNodes[0].outFlowIndex].iGuard != 2) ||
+	        (prDesc->prGuards[1] != &PrCfgIndexGuard1) || (prDesc->prGuards[2] != &PrCfgIndexGuard2) ||
+	        (prDesc->prGuards[3] != NULL)) {
+		FwPrRelease(prDesc);
+		return prTestCaseFailure;
+	}
+
+	/* Fill the unused action and guard locations and check that the index is released by FwPrCheck */
+	prDesc->prActions[2] = &PrCfgIndexAction3;
+	for (i = 3; i < prDesc->nOfGuards; i++)
+		prDesc->prGuards[i] = &PrCfgIndexGuard1;
+	if ((FwPrCheck(prDesc) != prSuccess) || (prDesc->cfgIndex != NULL)) {
+		FwPrRelease(prDesc);
+		return prTestCaseFailure;
+	}
+
+	/* Override actions in a derived procedure (the overrides create and resolve a duplicate) */
+	prDescDer = FwPrCreateDer(prDesc);
+	if ((prDescDer == NULL) || (prDescDer->cfgIndex != NULL)) {
+		FwPrRelease(prDesc);
+		return prTestCaseFailure;
+	}
+	FwPrOverrideAction(prDescDer, &PrCfgIndexAction1, &PrCfgIndexAction4);
+	FwPrOverrideAction(prDescDer, &PrCfgIndexAction4, &PrCfgIndexAction2);
+	FwPrOverrideAction(prDescDer, &PrCfgIndexAction2, &PrCfgIndexAction1);
+	FwPrOverrideAction(prDescDer, &PrCfgIndexAction2, &PrCfgIndexAction4);
+	FwPrOverrideGuard(prDescDer, &PrCfgIndexGuard1, &PrCfgIndexGuard2);
+	FwPrOverrideGuard(prDescDer, &PrCfgIndexGuard2, &PrCfgIndexGuard1);
+	if ((prDescDer->cfgIndex == NULL) || (FwPrGetErrCode(prDescDer) != prSuccess) ||
+	        (prDescDer->prActions[0] != &PrCfgIndexAction1) || (prDescDer->prActions[1] != &PrCfgIndexAction4) ||
+	        (prDescDer->prActions[2] != &PrCfgIndexAction3) || (prDescDer->prGuards[1] != &PrCfgIndexGuard1) ||
+	        (prDescDer->prGuards[2] != &PrCfgIndexGuard2)) {
+		FwPrReleaseDer(prDescDer);
+		FwPrRelease(prDesc);
+		return prTestCaseFailure;
+	}
+
+	/* Override an action which is not in the derived procedure */
+	FwPrOverrideAction(prDescDer, &PrCfgIndexAction2, &PrCfgIndexAction4);
+	if (FwPrGetErrCode(prDescDer) != prUndefAction) {
+		FwPrReleaseDer(prDescDer);
+		FwPrRelease(prDesc);
+		return prTestCaseFailure;
+	}
+	FwPrReleaseDer(prDescDer);
+	FwPrRelease(prDesc);
+
+	/* Add one action too many to a procedure which uses the index */
+	prDescFull = FwPrCreate(2, 1, FW_PR_CFG_INDEX_MIN, 1, FW_PR_CFG_INDEX_MIN);
+	FwPrAddActionNode(prDescFull, 1, &PrCfgIndexAction1);
+	FwPrAddActionNode(prDescFull, 2, &PrCfgIndexAction2);
+	if ((prDescFull->cfgIndex == NULL) || (FwPrGetErrCode(prDescFull) != prTooManyActions) ||
+	        (prDescFull->prBase->aNodes[1].iAction != 0)) {
+		FwPrRelease(prDescFull);
+		return prTestCaseFailure;
+	}
+
+	FwPrRelease(prDescFull);
+	return prTestCaseSuccess;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+FwPrTestOutcome_t FwPrTestCaseDerShared1() {
+	struct TestPrData prData = {0, 0, 1, 1, 1, 0, 0, 0};
+	struct TestPrData derPrData = {0, 0, 0, 1, 1, 0, 0, 0};
+	FwPrDesc_t prDescBase, prDescDer;
+	FwPrAction_t action;
+	FwPrGuard_t guard;
+
+	/* reset log */
+	fwPrLogIndex = 0;
+
+	/* Create the base procedure */
+	prDescBase = FwPrMakeTestPR1(&prData);
+	if (prDescBase == NULL)
+		return prTestCaseFailure;
+
+	/* The derived procedure shares the action and guard arrays */
+	prDescDer = FwPrCreateDerShared(prDescBase);
+	if ((prDescDer == NULL) || (prDescDer->prActions != prDescBase->prActions) ||
+	        (prDescDer->prGuards != prDescBase->prGuards) ||
+	        (prDescDer->shared != (PR_SHARED_ACTIONS | PR_SHARED_GUARDS)) || (FwPrCheck(prDescDer) != prSuccess)) {
+		FwPrRelease(prDescBase);
+		return prTestCaseFailure;
+	}
+	FwPrSetData(prDescDer, &derPrData);
+
+	/* Override the action: the derived procedure gets its own action array */
+	action = prDescBase->prActions[0];
+	FwPrOverrideAction(prDescDer, action, &PrCfgIndexAction1);
+	if ((FwPrGetErrCode(prDescDer) != prSuccess) || (prDescDer->prActions == prDescBase->prActions) ||
+	        (prDescDer->shared != PR_SHARED_GUARDS) || (prDescBase->prActions[0] != action)) {
+		FwPrReleaseDer(prDescDer);
+		FwPrRelease(prDescBase);
+		return prTestCaseFailure;
+	}
+
+	/* Override the guard on the initial control flow (the derived procedure has flag_1 false) */
+	guard = prDescBase->prGuards[prDescBase->prBase->flows[0].iGuard];
+	FwPrOverrideGuard(prDescDer, guard, &PrCfgIndexGuard1);
+	if ((FwPrGetErrCode(prDescDer) != prSuccess) || (prDescDer->prGuards == prDescBase->prGuards) ||
+	        (prDescDer->shared != 0) || (prDescBase->prGuards[prDescBase->prBase->flows[0].iGuard] != guard)) {
+		FwPrReleaseDer(prDescDer);
+		FwPrRelease(prDescBase);
+		return prTestCaseFailure;
+	}
+
+	/* Run both procedures to completion: only the base executes the original action */
+	FwPrStart(prDescDer);
+	FwPrExecute(prDescDer);
+	FwPrStart(prDescBase);
+	FwPrExecute(prDescBase);
+	if ((FwPrIsStarted(prDescDer) != 0) || (FwPrIsStarted(prDescBase) != 0) || (derPrData.counter_1 != 0) ||
+	        (prData.counter_1 != 3)) {
+		FwPrReleaseDer(prDescDer);
+		FwPrRelease(prDescBase);
+		return prTestCaseFailure;
+	}
+
+	FwPrReleaseDer(prDescDer);
+	FwPrRelease(prDescBase);
+	return prTestCaseSuccess;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+FwPrTestOutcome_t FwPrTestCasePool1() {
+	struct TestPrData prData = {0, 0, 1, 1, 1, 0, 0, 0};
+	struct TestPrData derPrData = {0, 0, 1, 1, 1, 0, 0, 0};
+	FwPrDesc_t prDescBase, prDescOther, prDesc1, prDesc2;
+	FwPrPoolDesc_t pool;
+	FwPrAction_t action;
+
+	/* reset log */
+	fwPrLogIndex = 0;
+
+	prDescBase = FwPrMakeTestPR1(&prData);
+	if (prDescBase == NULL)
+		return prTestCaseFailure;
+
+	/* The pool is thread-safe but it is only used by the calling thread */
+	pool = FwPrPoolCreate(prDescBase, 1, 1);
+	if ((pool == NULL) || (FwPrPoolCreate(prDescBase, 0, 1) != NULL)) {
+		FwPrRelease(prDescBase);
+		return prTestCaseFailure;
+	}
+
+	/* Obtain two procedures: the second one is a miss */
+	prDesc1 = FwPrPoolGet(pool);
+	prDesc2 = FwPrPoolGet(pool);
+	if ((prDesc1 == NULL) || (prDesc2 == NULL) || (prDesc1->prBase != prDescBase->prBase) ||
+	        (FwPrPoolGetNOfInUse(pool) != 2) || (FwPrPoolGetHighWater(pool) != 2) ||
+	        (FwPrPoolGetNOfMisses(pool) != 1)) {
+		FwPrPoolRelease(pool);
+		FwPrRelease(prDescBase);
+		return prTestCaseFailure;
+	}
+
+	/* Run the first procedure to completion with an overridden action */
+	action = prDescBase->prActions[0];
+	FwPrSetData(prDesc1, &derPrData);
+	FwPrOverrideAction(prDesc1, action, &PrCfgIndexAction1);
+	FwPrStart(prDesc1);
+	FwPrExecute(prDesc1);
+	if ((FwPrGetErrCode(prDesc1) != prSuccess) || (FwPrGetExecCnt(prDesc1) == 0) || (derPrData.counter_1 != 0)) {
+		FwPrPoolRelease(pool);
+		FwPrRelease(prDescBase);
+		return prTestCaseFailure;
+	}
+
+	/* Return the procedures: the first one is reset */
+	if ((FwPrPoolPut(pool, prDesc1) != prSuccess) || (FwPrPoolPut(pool, prDesc2) != prSuccess) ||
+	        (FwPrPoolGetNOfInUse(pool) != 0) || (FwPrPoolGetHighWater(pool) != 2) ||
+	        (FwPrIsStarted(prDesc1) != 0) || (FwPrGetData(prDesc1) != NULL) || (FwPrGetExecCnt(prDesc1) != 0) ||
+	        (prDesc1->prActions[0] != action)) {
+		FwPrPoolRelease(pool);
+		FwPrRelease(prDescBase);
+		return prTestCaseFailure;
+	}
+
+	/* The procedures are served again without misses */
+	prDesc1 = FwPrPoolGet(pool);
+	prDesc2 = FwPrPoolGet(pool);
+	if ((prDesc1 == NULL) || (prDesc2 == NULL) || (FwPrPoolGetNOfMisses(pool) != 1)) {
+		FwPrPoolRelease(pool);
+		FwPrRelease(prDescBase);
+		return prTestCaseFailure;
+	}
+
+	/* A procedure with a different base descriptor cannot be returned to the pool */
+	prDescOther = FwPrMakeTestPR1(&prData);
+	if (FwPrPoolPut(pool, prDescOther) != prWrongBase) {
+		FwPrRelease(prDescOther);
+		FwPrPoolRelease(pool);
+		FwPrRelease(prDescBase);
+		return prTestCaseFailure;
+	}
+
+	FwPrRelease(prDescOther);
+	FwPrPoolPut(pool, prDesc1);
+	FwPrPoolPut(pool, prDesc2);
+	FwPrPoolRelease(pool);
+	FwPrRelease(prDescBase);
+	return prTestCaseSuccess;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+FwPrTestOutcome_t FwPrTestCaseImage1() {
+	struct TestPrData prData = {0, 0, 1, 1, 0, 0, 0, 0};
+	struct TestPrData imgPrData = {0, 0, 1, 1, 0, 0, 0, 0};
+	int flags[4][3] = {{0, 1, 0}, {0, 1, 0}, {1, 0, 1}, {1, 0, 1}};
+	FwPrDesc_t prDesc, imgPrDesc;
+	FwPrCounterU4_t size;
+	unsigned char* image;
+	int i;
+
+	prDesc = FwPrMakeTestPR2(&prData);
+	size = FwPrGetImageSize(prDesc);
+	image = (unsigned char*)malloc(size);
+	if ((image == NULL) || (FwPrExportImage(prDesc, image, size - 1) != 0) ||
+	        (FwPrExportImage(prDesc, image, size) != size)) {
+		free(image);
+		FwPrRelease(prDesc);
+		return prTestCaseFailure;
+	}
+
+	/* The image is rejected if it is truncated or if the actions and guards do not match */
+	if ((FwPrLoadImage(image, size - 1, prDesc->prActions, prDesc->nOfActions, prDesc->prGuards + 1,
+	                   (FwPrCounterS1_t)(prDesc->nOfGuards - 1)) != NULL) ||
+	        (FwPrLoadImage(image, size, prDesc->prActions, prDesc->nOfActions, prDesc->prGuards + 1,
+	                       (FwPrCounterS1_t)(prDesc->nOfGuards - 2)) != NULL)) {
+		free(image);
+		FwPrRelease(prDesc);
+		return prTestCaseFailure;
+	}
+
+	imgPrDesc = FwPrLoadImage(image, size, prDesc->prActions, prDesc->nOfActions, prDesc->prGuards + 1,
+	                          (FwPrCounterS1_t)(prDesc->nOfGuards - 1));
+	if ((imgPrDesc == NULL) || (FwPrCheck(imgPrDesc) != prSuccess)) {
+		if (imgPrDesc != NULL)
+			FwPrReleaseArena(imgPrDesc);
+		free(image);
+		FwPrRelease(prDesc);
+		return prTestCaseFailure;
+	}
+	FwPrSetData(imgPrDesc, &imgPrData);
+
+	/* The loaded procedure behaves like the exported one (it waits in N3, loops back to N3 through D2 and terminates) */
+	FwPrStart(prDesc);
+	FwPrStart(imgPrDesc);
+	for (i = 0; i < 4; i++) {
+		fwPrLogIndex = 0;
+		prData.flag_4 = flags[i][0];
+		prData.flag_5 = flags[i][1];
+		prData.flag_6 = flags[i][2];
+		imgPrData.flag_4 = flags[i][0];
+		imgPrData.flag_5 = flags[i][1];
+		imgPrData.flag_6 = flags[i][2];
+		FwPrExecute(prDesc);
+		FwPrExecute(imgPrDesc);
+		if ((FwPrGetCurNode(prDesc) != FwPrGetCurNode(imgPrDesc)) || (FwPrGetExecCnt(prDesc) != FwPrGetExecCnt(imgPrDesc)) ||
+		        (FwPrGetNodeExecCnt(prDesc) != FwPrGetNodeExecCnt(imgPrDesc)) ||
+		        (FwPrGetErrCode(prDesc) != FwPrGetErrCode(imgPrDesc)) || (prData.counter_1 != imgPrData.counter_1)) {
+			FwPrReleaseArena(imgPrDesc);
+			free(image);
+			FwPrRelease(prDesc);
+			return prTestCaseFailure;
+		}
+	}
+	if ((prData.counter_1 != 6) || (FwPrIsStarted(imgPrDesc) != 0)) {
+		FwPrReleaseArena(imgPrDesc);
+		free(image);
+		FwPrRelease(prDesc);
+		return prTestCaseFailure;
+	}
+
+	FwPrReleaseArena(imgPrDesc);
+	free(image);
+	FwPrRelease(prDesc);
+	return prTestCaseSuccess;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+FwPrTestOutcome_t FwPrTestCaseConst1() {
+	struct TestPrData prData = {0, 0, 1, 1, 0, 0, 0, 0};
+	struct TestPrData constPrData = {0, 0, 1, 1, 0, 0, 0, 0};
+	int flags[4][3] = {{0, 1, 0}, {0, 1, 0}, {1, 0, 1}, {1, 0, 1}};
+	FwPrDesc_t prDesc;
+	int i;
+	FW_PR_INST_CONST(constPrDesc, FwPrConstPR2, 1, 8)
+	FW_PR_INST_CONST(constPrDescSmall, FwPrConstPR2, 1, 7)	/* PR2 has 8 guards */
+
+	prDesc = FwPrMakeTestPR2(&prData);
+
+	/* The initialization fails if the constant base descriptor refers to too many guards */
+	FwPrInitConst(&constPrDescSmall, prDesc->prActions, prDesc->prGuards + 1);
+	if (FwPrGetErrCode(&constPrDescSmall) != prWrongNOfGuards) {
+		FwPrRelease(prDesc);
+		return prTestCaseFailure;
+	}
+
+	FwPrInitConst(&constPrDesc, prDesc->prActions, prDesc->prGuards + 1);
+	FwPrSetData(&constPrDesc, &constPrData);
+	if ((FwPrCheck(&constPrDesc) != prSuccess) || (constPrDesc.prBase != &FwPrConstPR2) ||
+	        (FwPrIsStarted(&constPrDesc) != 0)) {
+		FwPrRelease(prDesc);
+		return prTestCaseFailure;
+	}
+
+	/* The constant procedure behaves like the procedure from which its base descriptor was generated */
+	FwPrStart(prDesc);
+	FwPrStart(&constPrDesc);
+	for (i = 0; i < 4; i++) {
+		fwPrLogIndex = 0;
+		prData.flag_4 = flags[i][0];
+		prData.flag_5 = flags[i][1];
+		prData.flag_6 = flags[i][2];
+		constPrData.flag_4 = flags[i][0];
+		constPrData.flag_5 = flags[i][1];
+		constPrData.flag_6 = flags[i][2];
+		FwPrExecute(prDesc);
+		FwPrExecute(&constPrDesc);
+		if ((FwPrGetCurNode(prDesc) != FwPrGetCurNode(&constPrDesc)) ||
+		        (FwPrGetExecCnt(prDesc) != FwPrGetExecCnt(&constPrDesc)) ||
+		        (FwPrGetNodeExecCnt(prDesc) != FwPrGetNodeExecCnt(&constPrDesc)) ||
+		        (FwPrGetErrCode(prDesc) != FwPrGetErrCode(&constPrDesc)) || (prData.counter_1 != constPrData.counter_1)) {
+			FwPrRelease(prDesc);
+			return prTestCaseFailure;
+		}
+	}
+	if ((constPrData.counter_1 != 6) || (FwPrIsStarted(&constPrDesc) != 0)) {
+		FwPrRelease(prDesc);
+		return prTestCaseFailure;
+	}
+
+	FwPrRelease(prDesc);
+	return prTestCaseSuccess;
+}
+
+/** The number of procedures of the scheduler test case (see <code>::FwPrTestCaseSched1</code>). */
+#define PR_SCHED_N_OF_PRS 64
+
+/** The order in which the procedures of the scheduler test case are executed in serial mode. */
+static int prSchedOrder[PR_SCHED_N_OF_PRS];
+
+/** The number of entries in <code>#prSchedOrder</code> (or -1 if the order is not recorded). */
+static int prSchedOrderIndex = -1;
+
+/**
+ * Action of the procedures of the scheduler test case.
+ * The procedure data are an array of two integers: the action increments the first one
+ * and, when the order of execution is recorded, it stores the second one (the number of
+ * the procedure) in <code>#prSchedOrder</code>.
+ * @param prDesc the procedure descriptor
+ */
+static void PrSchedAction(FwPrDesc_t prDesc) {
+	int* prData = (int*)FwPrGetData(prDesc);
+
+	prData[0]++;
+	if ((prSchedOrderIndex >= 0) && (prSchedOrderIndex < PR_SCHED_N_OF_PRS)) {
+		prSchedOrder[prSchedOrderIndex] = prData[1];
+		prSchedOrderIndex++;
+	}
+}
+
+/**
+ * Guard of the control flow from N1 back to N1 of the procedures of the scheduler test case.
+ * The guard is true if the procedure has already been executed once since it entered N1.
+ * The action of N1 is therefore executed once in every execution of the procedure.
+ * @param prDesc the procedure descriptor
+ * @return 1 if the guard is true, 0 otherwise
+ */
+static FwPrBool_t PrSchedGuard(FwPrDesc_t prDesc) {
+	return (FwPrBool_t)(FwPrGetNodeExecCnt(prDesc) > 0);
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+FwPrTestOutcome_t FwPrTestCaseSched1() {
+	FwPrDesc_t prDesc[PR_SCHED_N_OF_PRS];
+	int prData[PR_SCHED_N_OF_PRS][2];
+	FwSchedDesc_t sched;
+	int i, j, nOfPrs;
+	FwPrTestOutcome_t outcome = prTestCaseSuccess;
+
+	if ((FwSchedCreate(0, 1, NULL) != NULL) || (FwSchedCreate(1, 0, NULL) != NULL))
+		return prTestCaseFailure;
+	sched = FwSchedCreate(4, PR_SCHED_N_OF_PRS, NULL);
+	if (sched == NULL)
+		return prTestCaseFailure;
+
+	/* Create the procedures (one action node N1 which is re-entered in every execution) */
+	for (nOfPrs = 0; nOfPrs < PR_SCHED_N_OF_PRS; nOfPrs++) {
+		prDesc[nOfPrs] = FwPrCreate(1, 0, 2, 1, 1);
+		if (prDesc[nOfPrs] == NULL) {
+			outcome = prTestCaseFailure;
+			break;
+		}
+		prData[nOfPrs][0] = 0;
+		prData[nOfPrs][1] = nOfPrs;
+		FwPrSetData(prDesc[nOfPrs], prData[nOfPrs]);
+		FwPrAddActionNode(prDesc[nOfPrs], 1, &PrSchedAction);
+		FwPrAddFlowIniToAct(prDesc[nOfPrs], 1, NULL);
+		FwPrAddFlowActToAct(prDesc[nOfPrs], 1, 1, &PrSchedGuard);
+		if (FwPrCheck(prDesc[nOfPrs]) != prSuccess)
+			outcome = prTestCaseFailure;
+		FwPrStart(prDesc[nOfPrs]);
+		/* Half of the procedures are bound to the first worker */
+		if (FwSchedAddPr(sched, prDesc[nOfPrs], ((nOfPrs % 2) == 0) ? 0 : FW_SCHED_ANY_WORKER) != 1)
+			outcome = prTestCaseFailure;
+	}
+	if ((outcome == prTestCaseSuccess) && (FwSchedAddPr(sched, prDesc[0], FW_SCHED_ANY_WORKER) != 0))
+		outcome = prTestCaseFailure;
+
+	/* Execute the procedures in parallel: each procedure is executed once per cycle */
+	for (i = 0; (i < 100) && (outcome == prTestCaseSuccess); i++)
+		FwSchedRun(sched);
+	for (j = 0; (j < nOfPrs) && (outcome == prTestCaseSuccess); j++)
+		if ((prData[j][0] != 100) || (FwPrGetExecCnt(prDesc[j]) != 100))
+			outcome = prTestCaseFailure;
+	if ((outcome == prTestCaseSuccess) && ((FwSchedGetNOfCycles(sched) != 100) ||
+	                                       (FwSchedGetNOfSteals(sched) > (FwSchedCounterU4_t)(100 * PR_SCHED_N_OF_PRS))))
+		outcome = prTestCaseFailure;
+
+	/* Execute the procedures in serial mode: they are executed in the order in which they were added */
+	FwSchedSetMode(sched, schedSerial);
+	prSchedOrderIndex = 0;
+	if (outcome == prTestCaseSuccess)
+		FwSchedRun(sched);
+	prSchedOrderIndex = -1;
+	for (j = 0; (j < nOfPrs) && (outcome == prTestCaseSuccess); j++)
+		if ((prSchedOrder[j] != j) || (prData[j][0] != 101))
+			outcome = prTestCaseFailure;
+
+	/* The scheduler can return to parallel mode */
+	FwSchedSetMode(sched, schedParallel);
+	if (outcome == prTestCaseSuccess)
+		FwSchedRun(sched);
+	for (j = 0; (j < nOfPrs) && (outcome == prTestCaseSuccess); j++)
+		if (prData[j][0] != 102)
+			outcome = prTestCaseFailure;
+	if ((outcome == prTestCaseSuccess) && (FwSchedGetNOfCycles(sched) != 102))
+		outcome = prTestCaseFailure;
+
+	FwSchedRelease(sched);
+	for (j = 0; j < nOfPrs; j++)
+		FwPrRelease(prDesc[j]);
+	return outcome;
+}
+
+/**
+ * Action of the procedure of the execution budget test case (see
+ * <code>::FwPrTestCaseBudget1</code>).
+ * The action increments the integer which is attached to the procedure as its data.
+ * @param prDesc the procedure descriptor
+ */
+static void PrBudgetAction(FwPrDesc_t prDesc) {
+	(*(int*)FwPrGetData(prDesc))++;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+FwPrTestOutcome_t FwPrTestCaseBudget1() {
+	FwPrDesc_t prDesc;
+	int counter = 0;
+	FwPrTestOutcome_t outcome = prTestCaseSuccess;
+
+	/* Create a procedure with a chain of three action nodes (N1->N2->N3->Final) with true guards */
+	prDesc = FwPrCreate(3, 0, 4, 1, 0);
+	if (prDesc == NULL)
+		return prTestCaseFailure;
+	FwPrSetData(prDesc, &counter);
+	FwPrAddActionNode(prDesc, 1, &PrBudgetAction);
+	FwPrAddActionNode(prDesc, 2, &PrBudgetAction);
+	FwPrAddActionNode(prDesc, 3, &PrBudgetAction);
+	FwPrAddFlowIniToAct(prDesc, 1, NULL);
+	FwPrAddFlowActToAct(prDesc, 1, 2, NULL);
+	FwPrAddFlowActToAct(prDesc, 2, 3, NULL);
+	FwPrAddFlowActToFin(prDesc, 3, NULL);
+	if (FwPrCheck(prDesc) != prSuccess) {
+		FwPrRelease(prDesc);
+		return prTestCaseFailure;
+	}
+
+	/* A stopped procedure is not executed */
+	if ((FwPrExecuteBudget(prDesc, 1) != 0) || (counter != 0))
+		outcome = prTestCaseFailure;
+
+	/* Execute the procedure one node at a time */
+	FwPrStart(prDesc);
+	if ((outcome == prTestCaseSuccess) && ((FwPrExecuteBudget(prDesc, 1) != 1) || (FwPrGetCurNode(prDesc) != 1) ||
+	                                       (counter != 1) || (FwPrGetNodeExecCnt(prDesc) != 0)))
+		outcome = prTestCaseFailure;
+	if ((outcome == prTestCaseSuccess) && ((FwPrExecuteBudget(prDesc, 1) != 1) || (FwPrGetCurNode(prDesc) != 2) ||
+	                                       (counter != 2) || (FwPrGetExecCnt(prDesc) != 2)))
+		outcome = prTestCaseFailure;
+	/* The procedure terminates before the budget is exhausted */
+	if ((outcome == prTestCaseSuccess) && ((FwPrExecuteBudget(prDesc, 5) != 0) || (FwPrIsStarted(prDesc) != 0) ||
+	                                       (counter != 3)))
+		outcome = prTestCaseFailure;
+
+	/* A budget of zero does not limit the execution */
+	FwPrStart(prDesc);
+	if ((outcome == prTestCaseSuccess) && ((FwPrExecuteBudget(prDesc, 0) != 0) || (FwPrIsStarted(prDesc) != 0) ||
+	                                       (counter != 6)))
+		outcome = prTestCaseFailure;
+
+	/* A procedure suspended by the budget is resumed by FwPrExecute */
+	FwPrStart(prDesc);
+	if ((outcome == prTestCaseSuccess) && ((FwPrExecuteBudget(prDesc, 2) != 1) || (FwPrGetCurNode(prDesc) != 2) ||
+	                                       (counter != 8)))
+		outcome = prTestCaseFailure;
+	FwPrExecute(prDesc);
+	if ((outcome == prTestCaseSuccess) && ((FwPrIsStarted(prDesc) != 0) || (counter != 9)))
+		outcome = prTestCaseFailure;
+
+	if ((outcome == prTestCaseSuccess) && (FwPrGetErrCode(prDesc) != prSuccess))
+		outcome = prTestCaseFailure;
+	FwPrRelease(prDesc);
+	return outcome;
+}
+
+/**
+ * Action used by the second budget test case (see <code>::FwPrTestCaseBudget2</code>).
+ * The action increments counter_1.
+ * @param prDesc the procedure descriptor
+ */
+static void PrBudget2Action(FwPrDesc_t prDesc) {
+	((struct TestPrData*)FwPrGetData(prDesc))->counter_1++;
+}
+
+/**
+ * Guard used by the second budget test case (see <code>::FwPrTestCaseBudget2</code>).
+ * The guard appends the value of the node execution counter plus one as a decimal
+ * digit to the marker and it returns true if the node execution counter is at least 2.
+ * @param prDesc the procedure descriptor
+ * @return 1 if the node execution counter is at least 2, 0 otherwise
+ */
+static FwPrBool_t PrBudget2Guard(FwPrDesc_t prDesc) {
+	struct TestPrData* prData = (struct TestPrData*)FwPrGetData(prDesc);
+	prData->marker = prData->marker * 10 + (int)FwPrGetNodeExecCnt(prDesc) + 1;
+	return (FwPrGetNodeExecCnt(prDesc) >= 2);
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+FwPrTestOutcome_t FwPrTestCaseBudget2() {
+	struct TestPrData prData[3] = {{0, 0, 0, 0, 0, 0, 0, 0}, {0, 0, 0, 0, 0, 0, 0, 0}, {0, 0, 0, 0, 0, 0, 0, 0}};
+	FwPrDesc_t prDesc[3];
+	FwPrTestOutcome_t outcome = prTestCaseSuccess;
+	int i, j;
+
+	/* Create three instances of a procedure Initial->N1->N2->Final where the flow out of N1 waits for two cycles */
+	for (i=0; i<3; i++) {
+		prDesc[i] = FwPrCreate(2, 0, 3, 1, 1);
+		if (prDesc[i] == NULL) {
+			for (j=0; j<i; j++)
+				FwPrRelease(prDesc[j]);
+			return prTestCaseFailure;
+		}
+		FwPrSetData(prDesc[i], &prData[i]);
+		FwPrAddActionNode(prDesc[i], 1, &PrBudget2Action);
+		FwPrAddActionNode(prDesc[i], 2, &PrBudget2Action);
+		FwPrAddFlowIniToAct(prDesc[i], 1, NULL);
+		FwPrAddFlowActToAct(prDesc[i], 1, 2, &PrBudget2Guard);
+		FwPrAddFlowActToFin(prDesc[i], 2, NULL);
+		if (FwPrCheck(prDesc[i]) != prSuccess)
+			outcome = prTestCaseFailure;
+	}
+	if ((outcome == prTestCaseSuccess) && (FwPrCompile(prDesc[2]) != prSuccess))
+		outcome = prTestCaseFailure;
+
+	/* Without budget, the guard sees the node execution counter values 0, 1 and 2 */
+	FwPrStart(prDesc[0]);
+	for (i=0; (i<3) && (outcome == prTestCaseSuccess); i++)
+		FwPrExecute(prDesc[0]);
+	if ((outcome == prTestCaseSuccess) &&
+	        ((FwPrIsStarted(prDesc[0]) != 0) || (prData[0].marker != 123) || (prData[0].counter_1 != 2)))
+		outcome = prTestCaseFailure;
+
+	/* With a budget of one node, the guard sees the same values (the resumed execution does not increment the counter) */
+	for (i=1; (i<3) && (outcome == prTestCaseSuccess); i++) {
+		FwPrStart(prDesc[i]);
+		if ((FwPrExecuteBudget(prDesc[i], 1) != 1) || (FwPrGetCurNode(prDesc[i]) != 1) ||
+		        (FwPrGetNodeExecCnt(prDesc[i]) != 0) || (prData[i].marker != 0))
+			outcome = prTestCaseFailure;
+		if ((outcome == prTestCaseSuccess) && ((FwPrExecuteBudget(prDesc[i], 1) != 0) ||
+		                                       (FwPrGetCurNode(prDesc[i]) != 1) || (FwPrGetNodeExecCnt(prDesc[i]) != 0) ||
+		                                       (prData[i].marker != 1)))
+			outcome = prTestCaseFailure;
+		if ((outcome == prTestCaseSuccess) && ((FwPrExecuteBudget(prDesc[i], 1) != 0) ||
+		                                       (FwPrGetNodeExecCnt(prDesc[i]) != 1) || (prData[i].marker != 12)))
+			outcome = prTestCaseFailure;
+		if ((outcome == prTestCaseSuccess) && ((FwPrExecuteBudget(prDesc[i], 1) != 1) ||
+		                                       (FwPrGetCurNode(prDesc[i]) != 2) || (prData[i].marker != 123)))
+			outcome = prTestCaseFailure;
+		FwPrExecute(prDesc[i]);
+		if ((outcome == prTestCaseSuccess) && ((FwPrIsStarted(prDesc[i]) != 0) || (prData[i].counter_1 != 2) ||
+		                                       (FwPrGetExecCnt(prDesc[i]) != 5)))
+			outcome = prTestCaseFailure;
+	}
+
+	/* A procedure which is restarted after being stopped while suspended is not resumed */
+	FwPrStart(prDesc[1]);
+	if ((outcome == prTestCaseSuccess) && (FwPrExecuteBudget(prDesc[1], 1) != 1))
+		outcome = prTestCaseFailure;
+	FwPrStop(prDesc[1]);
+	FwPrStart(prDesc[1]);
+	prData[1].marker = 0;
+	FwPrExecute(prDesc[1]);
+	if ((outcome == prTestCaseSuccess) && ((FwPrGetCurNode(prDesc[1]) != 1) || (prData[1].marker != 1)))
+		outcome = prTestCaseFailure;
+
+	for (i=0; i<3; i++) {
+		if ((outcome == prTestCaseSuccess) && (FwPrGetErrCode(prDesc[i]) != prSuccess))
+			outcome = prTestCaseFailure;
+		FwPrRelease(prDesc[i]);
+	}
+	return outcome;
+}
+
+/**
+ * Set the flags of the data of a procedure of the compilation test case (see
+ * <code>::FwPrTestCaseCompile1</code>).
+ * Bits 0 to 5 of the argument integer are the values of flags 1 to 6.
+ * @param prData the procedure data
+ * @param flags the values of the flags
+ */
+static void PrCompileSetFlags(struct TestPrData* prData, int flags) {
+	prData->flag_1 = flags & 1;
+	prData->flag_2 = (flags >> 1) & 1;
+	prData->flag_3 = (flags >> 2) & 1;
+	prData->flag_4 = (flags >> 3) & 1;
+	prData->flag_5 = (flags >> 4) & 1;
+	prData->flag_6 = (flags >> 5) & 1;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+FwPrTestOutcome_t FwPrTestCaseCompile1() {
+	struct TestPrData prData = {0, 0, 0, 0, 0, 0, 0, 0};
+	struct TestPrData cPrData = {0, 0, 0, 0, 0, 0, 0, 0};
+	struct TestPrData derPrData = {0, 0, 0, 0, 0, 0, 0, 0};
+	FwPrDesc_t prDesc, cPrDesc, derPrDesc, incPrDesc;
+	PrExecFlow_t* execFlow;
+	unsigned int seed = 1;
+	int i, flags;
+	FwPrBool_t budget, cBudget;
+	FwPrTestOutcome_t outcome = prTestCaseSuccess;
+
+	/* A procedure whose configuration is not complete cannot be compiled */
+	incPrDesc = FwPrCreate(1, 0, 2, 1, 0);
+	if (incPrDesc == NULL)
+		return prTestCaseFailure;
+	FwPrAddActionNode(incPrDesc, 1, &PrBudgetAction);
+	if ((FwPrCompile(incPrDesc) != prNullFlow) || (incPrDesc->prBase->isCompiled != 0)) {
+		FwPrRelease(incPrDesc);
+		return prTestCaseFailure;
+	}
+	FwPrRelease(incPrDesc);
+
+	/* PR2 has two decision nodes and a control flow from one decision node to the other */
+	prDesc = FwPrMakeTestPR2(&prData);
+	cPrDesc = FwPrMakeTestPR2(&cPrData);
+	if ((FwPrCompile(cPrDesc) != prSuccess) || (cPrDesc->prBase->isCompiled == 0) || (prDesc->prBase->isCompiled != 0))
+		outcome = prTestCaseFailure;
+
+	/* Check the entries of the execution table */
+	for (i = 0; (i < cPrDesc->prBase->nOfFlows) && (outcome == prTestCaseSuccess); i++) {
+		execFlow = &(cPrDesc->prBase->execFlows[i]);
+		if ((execFlow->dest != cPrDesc->prBase->flows[i].dest) || (execFlow->iGuard != cPrDesc->prBase->flows[i].iGuard))
+			outcome = prTestCaseFailure;
+		else if ((execFlow->dest > 0) && ((execFlow->nOfNext != 1) ||
+		                                  (execFlow->iNext != cPrDesc->prBase->aNodes[execFlow->dest - 1].iFlow)))
+			outcome = prTestCaseFailure;
+		else if ((execFlow->dest < 0) &&
+		         ((execFlow->iNext != cPrDesc->prBase->dNodes[-execFlow->dest - 1].outFlowIndex) ||
+		          (execFlow->nOfNext != cPrDesc->prBase->dNodes[-execFlow->dest - 1].nOfOutTrans)))
+			outcome = prTestCaseFailure;
+		else if ((execFlow->dest == 0) && (execFlow->nOfNext != 0))
+			outcome = prTestCaseFailure;
+	}
+
+	/* A derived procedure shares the execution table of its base procedure */
+	derPrDesc = FwPrCreateDer(cPrDesc);
+	if (derPrDesc == NULL) {
+		FwPrRelease(prDesc);
+		FwPrRelease(cPrDesc);
+		return prTestCaseFailure;
+	}
+	FwPrSetData(derPrDesc, &derPrData);
+
+	/* Execute the compiled and non-compiled procedures with the same (pseudo-random) guard values */
+	for (i = 0; (i < 2000) && (outcome == prTestCaseSuccess); i++) {
+		if (FwPrIsStarted(prDesc) == 0) {
+			FwPrStart(prDesc);
+			FwPrStart(cPrDesc);
+			FwPrStart(derPrDesc);
+			prData.counter_1 = 0;
+			cPrData.counter_1 = 0;
+			derPrData.counter_1 = 0;
+		}
+		seed = seed * 1103515245u + 12345u;
+		flags = (int)((seed >> 16) & 0x3F);
+		PrCompileSetFlags(&prData, flags);
+		PrCompileSetFlags(&cPrData, flags);
+		PrCompileSetFlags(&derPrData, flags);
+		/* The execution is budgeted because PR2 loops forever through N2, D1 and N3 for some guard values */
+		fwPrLogIndex = 0;
+		budget = FwPrExecuteBudget(prDesc, (FwPrCounterU4_t)(1 + i % 4));
+		cBudget = FwPrExecuteBudget(cPrDesc, (FwPrCounterU4_t)(1 + i % 4));
+		if ((budget != cBudget) || (FwPrExecuteBudget(derPrDesc, (FwPrCounterU4_t)(1 + i % 4)) != cBudget))
+			outcome = prTestCaseFailure;
+		if ((FwPrGetCurNode(prDesc) != FwPrGetCurNode(cPrDesc)) ||
+		        (FwPrGetNodeExecCnt(prDesc) != FwPrGetNodeExecCnt(cPrDesc)) ||
+		        (FwPrGetErrCode(prDesc) != FwPrGetErrCode(cPrDesc)) || (prData.counter_1 != cPrData.counter_1))
+			outcome = prTestCaseFailure;
+		if ((FwPrGetCurNode(derPrDesc) != FwPrGetCurNode(cPrDesc)) || (derPrData.counter_1 != cPrData.counter_1))
+			outcome = prTestCaseFailure;
+	}
+
+	FwPrReleaseDer(derPrDesc);
+	FwPrRelease(prDesc);
+	FwPrRelease(cPrDesc);
+	return outcome;
+}
+
+/**
+ * Guard used by the guard memo test case (see <code>::FwPrTestCaseMemo1</code>).
+ * The guard increments counter_1 by 1 and returns flag_1.
+ * @param prDesc the procedure descriptor
+ * @return the value of flag_1
+ */
+static FwPrBool_t PrMemoGuard1(FwPrDesc_t prDesc) {
+	struct TestPrData* prData = (struct TestPrData*)FwPrGetData(prDesc);
+	prData->counter_1 += 1;
+	return prData->flag_1;
+}
+
+/**
+ * Guard used by the guard memo test case (see <code>::FwPrTestCaseMemo1</code>).
+ * The guard increments counter_1 by 10 and returns flag_2.
+ * @param prDesc the procedure descriptor
+ * @return the value of flag_2
+ */
+static FwPrBool_t PrMemoGuard2(FwPrDesc_t prDesc) {
+	struct TestPrData* prData = (struct TestPrData*)FwPrGetData(prDesc);
+	prData->counter_1 += 10;
+	return prData->flag_2;
+}
+
+/**
+ * Action used by the guard memo test case (see <code>::FwPrTestCaseMemo1</code>).
+ * The action increments the marker.
+ * @param prDesc the procedure descriptor
+ */
+static void PrMemoAction(FwPrDesc_t prDesc) {
+	((struct TestPrData*)FwPrGetData(prDesc))->marker++;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+FwPrTestOutcome_t FwPrTestCaseMemo1() {
+	struct TestPrData prData = {0, 0, 0, 0, 0, 0, 0, 0};
+	FwPrDesc_t prDesc, prDescDer;
+	FwPrTestOutcome_t outcome = prTestCaseSuccess;
+
+	/* Create a procedure N1->D1->N2/N3->Final where PrMemoGuard1 guards the flows N1->D1, D1->N3 and N3->Final */
+	prDesc = FwPrCreate(3, 1, 6, 1, 2);
+	if (prDesc == NULL)
+		return prTestCaseFailure;
+	FwPrSetData(prDesc, &prData);
+	FwPrAddActionNode(prDesc, 1, &PrMemoAction);
+	FwPrAddActionNode(prDesc, 2, &PrMemoAction);
+	FwPrAddActionNode(prDesc, 3, &PrMemoAction);
+	FwPrAddDecisionNode(prDesc, 1, 2);
+	FwPrAddFlowIniToAct(prDesc, 1, NULL);
+	FwPrAddFlowActToDec(prDesc, 1, 1, &PrMemoGuard1);
+	FwPrAddFlowDecToAct(prDesc, 1, 2, &PrMemoGuard2);
+	FwPrAddFlowDecToAct(prDesc, 1, 3, &PrMemoGuard1);
+	FwPrAddFlowActToFin(prDesc, 2, NULL);
+	FwPrAddFlowActToFin(prDesc, 3, &PrMemoGuard1);
+	if (FwPrCheck(prDesc) != prSuccess) {
+		FwPrRelease(prDesc);
+		return prTestCaseFailure;
+	}
+
+	/* Guards which are not in the procedure cannot be marked */
+	if ((FwPrSetGuardPure(prDesc, &DummyGuard, 1) != prUndefGuard) || (prDesc->memo != NULL))
+		outcome = prTestCaseFailure;
+	if ((outcome == prTestCaseSuccess) && ((FwPrSetGuardPure(prDesc, &PrMemoGuard1, 1) != prSuccess) ||
+	                                       (FwPrSetGuardPure(prDesc, &PrMemoGuard2, 1) != prSuccess) ||
+	                                       (prDesc->memo == NULL)))
+		outcome = prTestCaseFailure;
+
+	/* The outcomes cached in one execution are not used in the next one */
+	FwPrStart(prDesc);
+	FwPrExecute(prDesc);
+	FwPrExecute(prDesc);
+	if ((outcome == prTestCaseSuccess) &&
+	        ((FwPrGetCurNode(prDesc) != 1) || (prData.counter_1 != 2) || (prData.marker != 1)))
+		outcome = prTestCaseFailure;
+
+	/* A pure guard is called once until the next action node is executed */
+	prData.counter_1 = 0;
+	prData.flag_1    = 1;
+	FwPrExecute(prDesc);
+	if ((outcome == prTestCaseSuccess) &&
+	        ((FwPrIsStarted(prDesc) != 0) || (prData.counter_1 != 12) || (prData.marker != 2)))
+		outcome = prTestCaseFailure;
+
+	/* The guard memo also works on a compiled procedure */
+	prData.counter_1 = 0;
+	if ((outcome == prTestCaseSuccess) && (FwPrCompile(prDesc) != prSuccess))
+		outcome = prTestCaseFailure;
+	FwPrRun(prDesc);
+	if ((outcome == prTestCaseSuccess) && ((prData.counter_1 != 12) || (prData.marker != 4)))
+		outcome = prTestCaseFailure;
+
+	/* The mark is not inherited: in a derived procedure, each guard is called whenever it is evaluated */
+	prDescDer = FwPrCreateDer(prDesc);
+	if ((prDescDer == NULL) || (prDescDer->memo != NULL)) {
+		FwPrRelease(prDesc);
+		return prTestCaseFailure;
+	}
+	FwPrSetData(prDescDer, &prData);
+	prData.counter_1 = 0;
+	FwPrRun(prDescDer);
+	if ((outcome == prTestCaseSuccess) && ((prData.counter_1 != 13) || (prData.marker != 6)))
+		outcome = prTestCaseFailure;
+
+	/* The mark is removed when the guard is overridden */
+	if ((outcome == prTestCaseSuccess) && ((FwPrSetGuardPure(prDescDer, &PrMemoGuard2, 1) != prSuccess) ||
+	                                       ((prDescDer->memo->pure[0] & 4) == 0)))
+		outcome = prTestCaseFailure;
+	FwPrOverrideGuard(prDescDer, &PrMemoGuard2, &PrMemoGuard1);
+	if ((outcome == prTestCaseSuccess) &&
+	        ((FwPrGetErrCode(prDescDer) != prSuccess) || ((prDescDer->memo->pure[0] & 4) != 0)))
+		outcome = prTestCaseFailure;
+
+	FwPrReleaseDer(prDescDer);
+	FwPrRelease(prDesc);
+	return outcome;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+FwPrTestOutcome_t FwPrTestCaseSnap1() {
+	struct TestPrData prData[3];
+	FwPrDesc_t prDescs[3];
+	unsigned char ref[128];
+	unsigned char first[128];
+	unsigned char delta[128];
+	FwPrCounterU4_t size, recSize, hdrSize, deltaSize;
+	FwPrTestOutcome_t outcome = prTestCaseSuccess;
+	int i;
+
+	memset(prData, 0, sizeof(prData));
+	for (i = 0; i < 3; i++) {
+		prDescs[i] = FwPrMakeTestPR1(&prData[i]);
+		if (prDescs[i] == NULL)
+			return prTestCaseFailure;
+	}
+	size = FwPrSnapGetSize(3);
+	hdrSize = FwPrSnapGetSize(0);
+	recSize = FwPrSnapGetSize(1) - hdrSize;
+	if ((size != hdrSize + 3 * recSize) || (size > sizeof(ref)))
+		outcome = prTestCaseFailure;
+
+	/* Take a full snapshot after PR1 of the second procedure has moved to N1 */
+	for (i = 0; i < 3; i++)
+		FwPrStart(prDescs[i]);
+	prData[1].flag_1 = 1;
+	FwPrExecute(prDescs[1]);
+	if ((outcome == prTestCaseSuccess) && ((FwPrSnapTake(prDescs, 3, ref + 1, size - 1) != 0) ||
+	                                       (FwPrSnapTake(prDescs, 3, ref + 1, size) != size) ||
+	                                       (FwPrSnapTake(prDescs, 3, first, size) != size)))
+		outcome = prTestCaseFailure;
+
+	/* A delta snapshot only holds the procedures which have changed */
+	if ((outcome == prTestCaseSuccess) && (FwPrSnapTakeDelta(prDescs, 3, ref + 1, size, delta, size) != hdrSize))
+		outcome = prTestCaseFailure;
+	prData[2].flag_1 = 1;
+	FwPrExecute(prDescs[2]);
+	FwPrExecute(prDescs[2]);
+	if ((outcome == prTestCaseSuccess) && ((FwPrSnapTakeDelta(prDescs, 3, ref + 1, size, delta, hdrSize) != 0) ||
+	                                       (memcmp(ref + 1, first, size) != 0)))
+		outcome = prTestCaseFailure;
+	deltaSize = FwPrSnapTakeDelta(prDescs, 3, ref + 1, size, delta + 3, sizeof(delta) - 3);
+	if ((outcome == prTestCaseSuccess) && ((deltaSize != hdrSize + recSize) || (memcmp(ref + 1, first, size) == 0)))
+		outcome = prTestCaseFailure;
+	if ((outcome == prTestCaseSuccess) && (FwPrSnapTakeDelta(prDescs, 3, ref + 1, size, delta + 64, 64) != hdrSize))
+		outcome = prTestCaseFailure;
+
+	/* Snapshots which do not match the procedures are rejected */
+	if ((outcome == prTestCaseSuccess) &&
+	        ((FwPrSnapRestore(prDescs, 2, first, size) != 0) || (FwPrSnapRestore(prDescs, 3, first, size - 1) != 0) ||
+	         (FwPrSnapRestore(prDescs, 3, NULL, size) != 0) ||
+	         (FwPrSnapTakeDelta(prDescs, 3, delta + 3, deltaSize, delta + 64, 64) != 0)))
+		outcome = prTestCaseFailure;
+	first[0] = (unsigned char)(first[0] ^ 0xFF);
+	if ((outcome == prTestCaseSuccess) && (FwPrSnapRestore(prDescs, 3, first, size) != 0))
+		outcome = prTestCaseFailure;
+	first[0] = (unsigned char)(first[0] ^ 0xFF);
+
+	/* The checkpoint is restored from the first full snapshot and the delta snapshot without executing actions */
+	for (i = 0; i < 3; i++) {
+		FwPrStop(prDescs[i]);
+		prData[i].counter_1 = 0;
+	}
+	if ((outcome == prTestCaseSuccess) && ((FwPrSnapRestore(prDescs, 3, first, size) != 1) ||
+	                                       (FwPrSnapRestore(prDescs, 3, delta + 3, deltaSize) != 1)))
+		outcome = prTestCaseFailure;
+	if ((outcome == prTestCaseSuccess) &&
+	        ((FwPrGetCurNode(prDescs[0]) != -1) || (FwPrGetCurNode(prDescs[1]) != 1) ||
+	         (FwPrGetCurNode(prDescs[2]) != 1) || (FwPrGetExecCnt(prDescs[2]) != 2) ||
+	         (FwPrGetNodeExecCnt(prDescs[2]) != 1) || (prData[1].counter_1 != 0) || (prData[2].counter_1 != 0)))
+		outcome = prTestCaseFailure;
+
+	for (i = 0; i < 3; i++)
+		FwPrRelease(prDescs[i]);
+	return outcome;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+FwPrTestOutcome_t FwPrTestCaseCost1() {
+	FwPrDesc_t prDesc1, prDesc2, prDesc3;
+	FwPrCostAnnot_t annots[2];
+	FwPrCost_t cost;
+	FwPrTestOutcome_t outcome = prTestCaseSuccess;
+
+	/* Create a procedure without cycles (Ini->D1, D1->N1, D1->Final, N1->Final) */
+	prDesc1 = FwPrCreate(1, 1, 4, 1, 2);
+	FwPrAddActionNode(prDesc1, 1, &DummyAction);
+	FwPrAddDecisionNode(prDesc1, 1, 2);
+	FwPrAddFlowIniToDec(prDesc1, 1, NULL);
+	FwPrAddFlowDecToAct(prDesc1, 1, 1, &DummyGuard);
+	FwPrAddFlowDecToFin(prDesc1, 1, &DummyGuardBis);
+	FwPrAddFlowActToFin(prDesc1, 1, NULL);
+
+	/* Create a procedure with a cycle (Ini->N1, N1->N2, N2->D1, D1->N1, D1->Final) */
+	prDesc2 = FwPrCreate(2, 1, 5, 1, 2);
+	FwPrAddActionNode(prDesc2, 1, &DummyAction);
+	FwPrAddActionNode(prDesc2, 2, &DummyAction);
+	FwPrAddDecisionNode(prDesc2, 1, 2);
+	FwPrAddFlowIniToAct(prDesc2, 1, NULL);
+	FwPrAddFlowActToAct(prDesc2, 1, 2, NULL);
+	FwPrAddFlowActToDec(prDesc2, 2, 1, NULL);
+	FwPrAddFlowDecToAct(prDesc2, 1, 1, &DummyGuard);
+	FwPrAddFlowDecToFin(prDesc2, 1, &DummyGuardBis);
+
+	/* First execution: dummy guard, the two guards out of D1, the action of N1 and the dummy guard out of N1 */
+	if ((FwPrCostExecute(prDesc1, -1, 0, NULL, 0, &cost) != prSuccess) || (cost.nOfActions != 1) ||
+	        (cost.nOfGuards != 3) || (cost.nOfNodes != 1) || (cost.cost != 2))
+		outcome = prTestCaseFailure;
+	if ((outcome == prTestCaseSuccess) && ((FwPrCostExecute(prDesc1, 1, 0, NULL, 0, &cost) != prSuccess) ||
+	                                       (cost.nOfActions != 0) || (cost.nOfGuards != 1) || (cost.cost != 0)))
+		outcome = prTestCaseFailure;
+	if ((outcome == prTestCaseSuccess) && ((FwPrCostExecute(prDesc1, 0, 0, NULL, 0, &cost) != prSuccess) ||
+	                                       (cost.nOfActions != 1) || (cost.nOfGuards != 3) || (cost.cost != 2)))
+		outcome = prTestCaseFailure;
+
+	/* Illegal node identifiers */
+	if ((outcome == prTestCaseSuccess) && ((FwPrCostExecute(prDesc1, 2, 0, NULL, 0, &cost) != prIllActNodeId) ||
+	                                       (FwPrCostExecute(prDesc1, -2, 0, NULL, 0, &cost) != prIllActNodeId)))
+		outcome = prTestCaseFailure;
+
+	/* The cost annotations replace the default cost of the action and of the first guard out of D1 */
+	annots[0].action = &DummyAction;
+	annots[0].guard = NULL;
+	annots[0].cost = 10;
+	annots[1].action = NULL;
+	annots[1].guard = &DummyGuard;
+	annots[1].cost = 4;
+	if ((outcome == prTestCaseSuccess) && ((FwPrCostExecute(prDesc1, -1, 0, annots, 2, &cost) != prSuccess) ||
+	                                       (cost.cost != 14)))
+		outcome = prTestCaseFailure;
+
+	/* The cost of a procedure with a cycle is only bounded by a node budget */
+	if ((outcome == prTestCaseSuccess) && (FwPrCostExecute(prDesc2, -1, 0, NULL, 0, &cost) != prCostUnbounded))
+		outcome = prTestCaseFailure;
+	if ((outcome == prTestCaseSuccess) && ((FwPrCostExecute(prDesc2, -1, 3, NULL, 0, &cost) != prSuccess) ||
+	                                       (cost.nOfActions != 3) || (cost.nOfGuards != 5) ||
+	                                       (cost.nOfNodes != 3) || (cost.cost != 4)))
+		outcome = prTestCaseFailure;
+	if ((outcome == prTestCaseSuccess) && ((FwPrCostExecute(prDesc2, 2, 1, NULL, 0, &cost) != prSuccess) ||
+	                                       (cost.nOfActions != 1) || (cost.nOfGuards != 3) ||
+	                                       (cost.nOfNodes != 1) || (cost.cost != 2)))
+		outcome = prTestCaseFailure;
+
+	/* A procedure which does not pass its configuration check is not analysed */
+	prDesc3 = FwPrCreate(1, 0, 2, 1, 0);
+	if ((outcome == prTestCaseSuccess) && (FwPrCostExecute(prDesc3, -1, 0, NULL, 0, &cost) == prSuccess))
+		outcome = prTestCaseFailure;
+
+	FwPrRelease(prDesc1);
+	FwPrRelease(prDesc2);
+	FwPrRelease(prDesc3);
+	return outcome;
+}
+
+/**
+ * Guard used by the declarative guard test case (see <code>::FwPrTestCaseDecl1</code>).
+ * The guard increments counter_1 and returns true if the node execution counter is at
+ * least 2.
+ * @param prDesc the procedure descriptor
+ * @return 1 if the node execution counter is greater than or equal to 2, 0 otherwise
+ */
+static FwPrBool_t PrDeclGuardCnt(FwPrDesc_t prDesc) {
+	((struct TestPrData*)FwPrGetData(prDesc))->counter_1++;
+	return (FwPrGetNodeExecCnt(prDesc) >= 2);
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+FwPrTestOutcome_t FwPrTestCaseDecl1() {
+	struct TestPrData prData = {0, 0, 0, 0, 0, 0, 0, 0};
+	FwPrDesc_t prDesc, prDescCnt, prDescDer;
+	FwPrTestOutcome_t outcome = prTestCaseSuccess;
+	FwPrCounterU4_t offset1 = (FwPrCounterU4_t)offsetof(struct TestPrData, flag_1);
+	FwPrCounterU4_t offset2 = (FwPrCounterU4_t)offsetof(struct TestPrData, flag_2);
+	FwPrCounterS1_t ref[8];
+	int i;
+
+	/* Create the procedure of the guard memo test case (see FwPrTestCaseMemo1) */
+	prDesc = FwPrCreate(3, 1, 6, 1, 2);
+	if (prDesc == NULL)
+		return prTestCaseFailure;
+	FwPrSetData(prDesc, &prData);
+	FwPrAddActionNode(prDesc, 1, &PrMemoAction);
+	FwPrAddActionNode(prDesc, 2, &PrMemoAction);
+	FwPrAddActionNode(prDesc, 3, &PrMemoAction);
+	FwPrAddDecisionNode(prDesc, 1, 2);
+	FwPrAddFlowIniToAct(prDesc, 1, NULL);
+	FwPrAddFlowActToDec(prDesc, 1, 1, &PrMemoGuard1);
+	FwPrAddFlowDecToAct(prDesc, 1, 2, &PrMemoGuard2);
+	FwPrAddFlowDecToAct(prDesc, 1, 3, &PrMemoGuard1);
+	FwPrAddFlowActToFin(prDesc, 2, NULL);
+	FwPrAddFlowActToFin(prDesc, 3, &PrMemoGuard1);
+	if (FwPrCheck(prDesc) != prSuccess) {
+		FwPrRelease(prDesc);
+		return prTestCaseFailure;
+	}
+
+	/* Guards which are not in the procedure cannot be declared */
+	if ((FwPrSetGuardDecl(prDesc, &DummyGuard, prGuardOpndInt, offset1, prGuardEq, 1) != prUndefGuard) ||
+	        (prDesc->memo != NULL))
+		outcome = prTestCaseFailure;
+
+	/* The declared guards are evaluated without calling the guard functions */
+	if ((outcome == prTestCaseSuccess) &&
+	        ((FwPrSetGuardDecl(prDesc, &PrMemoGuard1, prGuardOpndInt, offset1, prGuardEq, 1) != prSuccess) ||
+	         (FwPrSetGuardDecl(prDesc, &PrMemoGuard2, prGuardOpndInt, offset2, prGuardNe, 0) != prSuccess) ||
+	         (prDesc->memo == NULL)))
+		outcome = prTestCaseFailure;
+	FwPrStart(prDesc);
+	FwPrExecute(prDesc);
+	FwPrExecute(prDesc);
+	if ((outcome == prTestCaseSuccess) &&
+	        ((FwPrGetCurNode(prDesc) != 1) || (prData.counter_1 != 0) || (prData.marker != 1)))
+		outcome = prTestCaseFailure;
+	prData.flag_1 = 1;
+	FwPrExecute(prDesc);
+	if ((outcome == prTestCaseSuccess) &&
+	        ((FwPrIsStarted(prDesc) != 0) || (prData.counter_1 != 0) || (prData.marker != 2)))
+		outcome = prTestCaseFailure;
+
+	/* The declared guards are also evaluated on a compiled procedure */
+	if ((outcome == prTestCaseSuccess) && (FwPrCompile(prDesc) != prSuccess))
+		outcome = prTestCaseFailure;
+	FwPrRun(prDesc);
+	if ((outcome == prTestCaseSuccess) && ((prData.counter_1 != 0) || (prData.marker != 4)))
+		outcome = prTestCaseFailure;
+
+	/* The declaration is neither inherited nor kept when the guard is overridden */
+	prDescDer = FwPrCreateDer(prDesc);
+	if ((prDescDer == NULL) || (prDescDer->memo != NULL)) {
+		FwPrRelease(prDesc);
+		return prTestCaseFailure;
+	}
+	if ((outcome == prTestCaseSuccess) &&
+	        ((FwPrSetGuardDecl(prDescDer, &PrMemoGuard2, prGuardOpndInt, offset2, prGuardNe, 0) != prSuccess) ||
+	         (prDescDer->memo->decl[2].opnd != prGuardOpndInt)))
+		outcome = prTestCaseFailure;
+	FwPrOverrideGuard(prDescDer, &PrMemoGuard2, &PrMemoGuard1);
+	if ((outcome == prTestCaseSuccess) &&
+	        ((FwPrGetErrCode(prDescDer) != prSuccess) || (prDescDer->memo->decl[2].opnd != prGuardOpndNone)))
+		outcome = prTestCaseFailure;
+	FwPrReleaseDer(prDescDer);
+	FwPrRelease(prDesc);
+
+	/* A guard declared on the node execution counter behaves like the guard function */
+	prDescCnt = FwPrCreate(2, 0, 3, 1, 1);
+	if (prDescCnt == NULL)
+		return prTestCaseFailure;
+	FwPrSetData(prDescCnt, &prData);
+	FwPrAddActionNode(prDescCnt, 1, &PrMemoAction);
+	FwPrAddActionNode(prDescCnt, 2, &PrMemoAction);
+	FwPrAddFlowIniToAct(prDescCnt, 1, NULL);
+	FwPrAddFlowActToAct(prDescCnt, 1, 2, &PrDeclGuardCnt);
+	FwPrAddFlowActToFin(prDescCnt, 2, &PrDeclGuardCnt);
+	if (FwPrCheck(prDescCnt) != prSuccess) {
+		FwPrRelease(prDescCnt);
+		return prTestCaseFailure;
+	}
+	FwPrStart(prDescCnt);
+	for (i = 0; i < 8; i++) {
+		FwPrExecute(prDescCnt);
+		ref[i] = FwPrGetCurNode(prDescCnt);
+	}
+	if ((outcome == prTestCaseSuccess) && ((prData.counter_1 == 0) || (ref[7] != 0)))
+		outcome = prTestCaseFailure;
+	prData.counter_1 = 0;
+	if ((outcome == prTestCaseSuccess) &&
+	        (FwPrSetGuardDecl(prDescCnt, &PrDeclGuardCnt, prGuardOpndNodeExecCnt, 0, prGuardGe, 2) != prSuccess))
+		outcome = prTestCaseFailure;
+	FwPrStart(prDescCnt);
+	for (i = 0; i < 8; i++) {
+		FwPrExecute(prDescCnt);
+		if ((outcome == prTestCaseSuccess) && (FwPrGetCurNode(prDescCnt) != ref[i]))
+			outcome = prTestCaseFailure;
+	}
+	if ((outcome == prTestCaseSuccess) && (prData.counter_1 != 0))
+		outcome = prTestCaseFailure;
+
+	FwPrRelease(prDescCnt);
+	return outcome;
+}
+
+/**
+ * Recompute the checksum of a procedure image whose content has been modified.
+ * The header of the image holds the size of the image, the checksum and the offset of
+ * the first section in its fourth, fifth and eleventh words (see
+ * <code>::FwPrExportImage</code>).
+ * @param image the image
+ */
+static void PrImageRehash(unsigned char* image) {
+	FwPrCounterU4_t* header = (FwPrCounterU4_t*)(void*)image;
+	FwPrCounterU4_t hash = 2166136261UL;
+	FwPrCounterU4_t i;
+
+	for (i = header[10]; i < header[3]; i++)
+		hash = ((hash ^ image[i]) * 16777619UL) & 0xFFFFFFFFUL;
+	header[4] = hash;
+}
+
+/**
+ * Modify one index of a copy of a procedure image, recompute its checksum and try to
+ * load a procedure from it (see <code>::FwPrTestCaseImage2</code>).
+ * @param prDesc the exported procedure
+ * @param image the image of the exported procedure
+ * @param copy the buffer which receives the modified image
+ * @param size the size of the image
+ * @param iCase the index to be modified (0 if the image is not modified)
+ * @return 1 if a procedure could be loaded from the modified image or 0 otherwise
+ */
+static int PrImageLoadModified(FwPrDesc_t prDesc, const unsigned char* image, unsigned char* copy,
+                               FwPrCounterU4_t size, int iCase) {
+	FwPrCounterU4_t* header = (FwPrCounterU4_t*)(void*)copy;
+	FwPrCounterS1_t nOfFlows = prDesc->prBase->nOfFlows;
+	PrANode_t* aNodes;
+	PrDNode_t* dNodes;
+	PrFlow_t* flows;
+	PrExecFlow_t* execFlows;
+	FwPrDesc_t imgPrDesc;
+	FwPrCounterS1_t i;
+
+	memcpy(copy, image, size);
+	aNodes = (PrANode_t*)(void*)(copy + header[10]);
+	dNodes = (PrDNode_t*)(void*)(copy + header[11]);
+	flows = (PrFlow_t*)(void*)(copy + header[12]);
+	execFlows = (PrExecFlow_t*)(void*)(copy + header[13]);
+	/* Locate the first control flow into a decision node */
+	i = 0;
+	while ((i < nOfFlows - 1) && (execFlows[i].dest >= 0))
+		i++;
+	switch (iCase) {
+	case 1: /* out-going control flow of an action node beyond the control flow array */
+		aNodes[0].iFlow = nOfFlows;
+		break;
+	case 2: /* action of an action node out of the action array */
+		aNodes[0].iAction = prDesc->nOfActions;
+		break;
+	case 3: /* out-going control flows of a decision node beyond the control flow array */
+		dNodes[0].nOfOutTrans = (FwPrCounterS1_t)(nOfFlows - dNodes[0].outFlowIndex + 1);
+		break;
+	case 4: /* destination beyond the last action node */
+		flows[1].dest = (FwPrCounterS1_t)(prDesc->prBase->nOfANodes + 1);
+		break;
+	case 5: /* guard out of the guard array */
+		flows[1].iGuard = prDesc->nOfGuards;
+		break;
+	case 6: /* destination of an entry of the execution table beyond the last decision node */
+		execFlows[1].dest = (FwPrCounterS1_t)(-prDesc->prBase->nOfDNodes - 1);
+		break;
+	case 7: /* next control flow of an action node beyond the control flow array */
+		execFlows[0].iNext = nOfFlows;
+		break;
+	case 8: /* action of the destination of an entry of the execution table out of the action array */
+		execFlows[0].iAction = prDesc->nOfActions;
+		break;
+	case 9: /* out-going control flows of a decision node beyond the control flow array */
+		execFlows[i].nOfNext = (FwPrCounterS1_t)(nOfFlows - execFlows[i].iNext + 1);
+		break;
+	default:
+		break;
+	}
+	PrImageRehash(copy);
+
+	imgPrDesc = FwPrLoadImage(copy, size, prDesc->prActions, prDesc->nOfActions, prDesc->prGuards + 1,
+	                          (FwPrCounterS1_t)(prDesc->nOfGuards - 1));
+	if (imgPrDesc == NULL)
+		return 0;
+	FwPrReleaseArena(imgPrDesc);
+	return 1;
+}
+
+/* ----------------------------------------------------------------------------------------------------------------- */
+FwPrTestOutcome_t FwPrTestCaseImage2() {
+	struct TestPrData prData = {0, 0, 1, 1, 0, 0, 0, 0};
+	FwPrDesc_t prDesc;
+	FwPrCounterU4_t size;
+	unsigned char* image;
+	unsigned char* copy;
+	FwPrTestOutcome_t outcome = prTestCaseSuccess;
+	int i;
+
+	prDesc = FwPrMakeTestPR2(&prData);
+	if (prDesc == NULL)
+		return prTestCaseFailure;
+	size = FwPrGetImageSize(prDesc);
+	image = (unsigned char*)malloc(size);
+	copy = (unsigned char*)malloc(size);
+	if ((image == NULL) || (copy == NULL) || (FwPrExportImage(prDesc, image, size) != size))
+		outcome = prTestCaseFailure;
+
+	/* An image whose checksum has been recomputed is only loaded if all its indices are within bounds */
+	for (i = 0; (i < 10) && (outcome == prTestCaseSuccess); i++)
+		if (PrImageLoadModified(prDesc, image, copy, size, i) != (i == 0))
+			outcome = prTestCaseFailure;
+
+	free(image);
+	free(copy);
+	FwPrRelease(prDesc);
+	return outcome;
+}
@@ -216,6 +216,125 @@ FwPrTestOutcome_t FwPrTestCaseCheck13();
  */
 FwPrTestOutcome_t FwPrTestCaseCheck14();
 
+/**
+ * Verify the ability of the <code>::FwPrCheck</code> function to detect and report a
+ * situation where there is an action node which is the destination of a control flow
+ * but which cannot be reached from the initial node.
+ * @return the success/failure code of the test case.
+ */
+FwPrTestOutcome_t FwPrTestCaseCheck15();
+
+/**
+ * Verify the ability of the <code>::FwPrCheck</code> function to detect and report a
+ * situation where there is a decision node which is the destination of a control flow
+ * but which cannot be reached from the initial node.
+ * @return the success/failure code of the test case.
+ */
+FwPrTestOutcome_t FwPrTestCaseCheck16();
+
+/**
+ * Verify the derivation of procedures which share the arrays of their base procedure
+ * (see <code>::FwPrCreateDerShared</code>).
+ * The test derives a procedure from procedure PR1 (see <code>::FwPrMakeTestPR1</code>)
+ * and checks that the derived procedure initially shares the action and guard arrays of
+ * PR1.
+ * It then overrides the action and the guard of the initial control flow and checks that
+ * the derived procedure gets its own copy of the action and guard arrays while the
+ * arrays of PR1 are not modified.
+ * Finally, it runs both procedures to completion and checks that only PR1 executes
+ * the original action.
+ * @return the success/failure code of the test case.
+ */
+FwPrTestOutcome_t FwPrTestCaseDerShared1();
+
+/**
+ * Test the pool of procedures (see <code>::FwPrPoolCreate</code>).
+ * The test creates a thread-safe pool of one procedure derived from procedure PR1 (see
+ * <code>::FwPrMakeTestPR1</code>) and obtains two procedures from it.
+ * It checks that the second request is counted as a miss.
+ * It then overrides an action of one of the procedures, runs it and returns it to the
+ * pool and checks that the procedure is reset.
+ * Finally, the test checks that a procedure with a different base descriptor cannot be
+ * returned to the pool.
+ * @return the success/failure code of the test case.
+ */
+FwPrTestOutcome_t FwPrTestCasePool1();
+
+/**
+ * Check the export of procedure PR2 (see <code>::FwPrMakeTestPR2</code>) to a binary
+ * image and the loading of a procedure from the image.
+ * The test case checks that the image is rejected by the loader if it is truncated or
+ * if the number of guards does not match the image and that the loaded procedure behaves
+ * like the exported procedure when both are executed until they terminate.
+ * @return the success/failure code of the test case.
+ */
+FwPrTestOutcome_t FwPrTestCaseImage1();
+
+/**
+ * Check the instantiation of procedure PR2 (see <code>::FwPrMakeTestPR2</code>) with
+ * a constant base descriptor.
+ * The constant base descriptor <code>FwPrConstPR2</code> was generated with
+ * <code>::FwPrGenerateConstBase</code> from procedure PR2.
+ * The test case checks that the initialization of a procedure instantiated with
+ * <code>#FW_PR_INST_CONST</code> fails if the procedure holds fewer guards than the
+ * constant base descriptor uses and that the initialized procedure behaves like PR2
+ * when both are executed until they terminate.
+ * @return the success/failure code of the test case.
+ */
+FwPrTestOutcome_t FwPrTestCaseConst1();
+
+/**
+ * Test the scheduler of the state machine and procedure modules (see
+ * <code>::FwSchedCreate</code>).
+ * A scheduler with four workers executes 64 procedures with one action node which
+ * is executed once in every execution of the procedure.
+ * Half of the procedures are bound to the first worker and the others are assigned
+ * to the workers by the scheduler.
+ * The test case checks that:
+ * - a scheduler cannot be created without workers or items;
+ * - no more items than the maximum number of items can be added to the scheduler;
+ * - each procedure is executed once in every cycle executed in parallel mode;
+ * - the procedures are executed in the order in which they were added to the
+ *   scheduler in serial mode;
+ * - the scheduler can return from serial mode to parallel mode.
+ * .
+ * @return the success/failure code of the test case.
+ */
+FwPrTestOutcome_t FwPrTestCaseSched1();
+
+/**
+ * Test the execution of a procedure with a budget on the number of executed action nodes
+ * (see <code>::FwPrExecuteBudget</code>).
+ * The procedure used in this test case has three action nodes N1, N2 and N3 which are
+ * connected by control flows with true guards (Initial->N1->N2->N3->Final).
+ * The test case checks that:
+ * - a stopped procedure is not executed;
+ * - the execution stops at the action node where the budget is exhausted and it
+ *   resumes from that node in the next execution;
+ * - the function reports whether the budget was exhausted;
+ * - a budget of zero does not limit the execution;
+ * - a procedure suspended by the budget can be resumed with <code>::FwPrExecute</code>.
+ * .
+ * @return the success/failure code of the test case.
+ */
+FwPrTestOutcome_t FwPrTestCaseBudget1();
+
+/**
+ * Test the compilation of a procedure (see <code>::FwPrCompile</code>).
+ * The test case checks that:
+ * - a procedure whose configuration is incomplete cannot be compiled;
+ * - the entries of the execution table of procedure PR2 (see
+ *   <code>::FwPrMakeTestPR2</code>) are consistent with its action nodes, decision
+ *   nodes and control flows;
+ * - a compiled instance of PR2 and a procedure derived from it behave like a non-compiled
+ *   instance of PR2 when they are executed with the same pseudo-random sequence of guard
+ *   values (the procedures are executed with <code>::FwPrExecuteBudget</code> because,
+ *   for some guard values, PR2 never stops or waits at an action node).
+ * .
+ * @return the success/failure code of the test case.
+ */
+FwPrTestOutcome_t FwPrTestCaseCompile1();
+
 /**
  * Verify the Run command on a procedure.
  * @return the success/failure code of the test case.
@@ -312,4 +431,171 @@ FwPrTestOutcome_t FwPrTestCaseDerCheck5();
  */
 FwPrTestOutcome_t FwPrTestCaseExecute9();
 
+/**
+ * Verify the behaviour of a procedure whose number of action nodes is close to the
+ * maximum value allowed by the width of the <code>::FwPrCounterS1_t</code> type
+ * (or equal to <code>#LARGE_MAX_ANODES</code> if this value is smaller).
+ * The test is performed on an instance of the procedure created with
+ * <code>::FwPrMakeTestPRLarge</code>.
+ * The test starts and executes the procedure once and checks that all its action
+ * nodes have been executed and that the procedure has terminated.
+ * @return the success/failure code of the test case.
+ */
+FwPrTestOutcome_t FwPrTestCaseLarge1();
+
+/**
+ * Verify the creation of procedures in arenas.
+ * The test creates two instances of the procedure of
+ * <code>::FwPrMakeTestPRLargeArena</code>: one in an arena allocated with
+ * <code>malloc</code> and one in a buffer which is not aligned to
+ * <code>#FW_PR_ARENA_ALIGN</code>.
+ * The test checks that creation in a buffer fails if the buffer is too small and that
+ * both procedure descriptors are aligned and behave like the procedure created by
+ * <code>::FwPrMakeTestPRLarge</code> (in particular, that their actions do not write
+ * to the log arrays).
+ * @return the success/failure code of the test case.
+ */
+FwPrTestOutcome_t FwPrTestCaseArena1();
+
+/**
+ * Verify the tracing hooks of the procedure module.
+ * The test executes procedure PR2 (see <code>::FwPrMakeTestPR2</code>) from its initial
+ * node to its final node through decision node D1 and checks the recorded events if the
+ * tracing hooks are compiled in or checks that no events are recorded if they are
+ * compiled out.
+ * @return the success/failure code of the test case.
+ */
+FwPrTestOutcome_t FwPrTestCaseTrace1();
+
+/**
+ * Verify the profiling mode of a procedure.
+ * The test enables profiling on procedure PR2 (see <code>::FwPrMakeTestPR2</code>)
+ * with a clock which advances by 10 units at each call.
+ * The procedure is executed twice: in the first execution it stops in N1 because the
+ * guard of the control flow out of N1 is false and in the second execution it
+ * terminates through decision node D1.
+ * The test checks the execution counts and times of the action nodes, the counts of
+ * the taken control flows and the guard counts of the control flow out of N1.
+ * It also checks that the profiling data can be printed, reset and released.
+ * @return the success/failure code of the test case.
+ */
+FwPrTestOutcome_t FwPrTestCaseProfile1();
+
+/**
+ * Verify the configuration index of a procedure.
+ * The test creates a procedure whose action and guard arrays are large enough for
+ * the configuration index to be used (see #FW_PR_CFG_INDEX_MIN).
+ * It checks that actions and guards which are added more than once are stored only
+ * once, that the index is built during the configuration and released when the
+ * procedure passes <code>::FwPrCheck</code>, that actions and guards can be
+ * overridden in a derived procedure (including when the same action is temporarily
+ * stored in two locations) and that the overriding of an undefined action and the
+ * addition of too many actions are reported as errors.
+ * @return the success/failure code of the test case.
+ */
+FwPrTestOutcome_t FwPrTestCaseCfgIndex1();
+
+/**
+ * Verify the guard memo of a procedure (see <code>::FwPrSetGuardPure</code>).
+ * The test uses a procedure where the same guard is attached to the control flow
+ * into a decision node, to one of the control flows out of the decision node and
+ * to the control flow out of the action node which is the destination of this
+ * control flow.
+ * The test checks that:
+ * - guards which are not in the procedure cannot be marked as pure;
+ * - the outcomes cached in one execution are not used in the next one;
+ * - a pure guard is called only once until the next action node is executed
+ *   (also when the procedure is compiled);
+ * - the mark is not inherited by a derived procedure and it is removed when the
+ *   guard is overridden.
+ * .
+ * @return the success/failure code of the test case.
+ */
+FwPrTestOutcome_t FwPrTestCaseMemo1();
+
+/**
+ * Test the full and delta snapshots of a set of procedures.
+ * The test uses three instances of procedure PR1 (see <code>::FwPrMakeTestPR1</code>)
+ * and it checks that:
+ * - a full snapshot is only taken if the buffer is large enough (its alignment does
+ *   not matter);
+ * - a delta snapshot only holds the procedures which have changed since the last
+ *   checkpoint and it updates the reference snapshot;
+ * - a delta snapshot is not taken and the reference snapshot is not modified if the
+ *   buffer is too small;
+ * - snapshots which are truncated, corrupted or taken from another set of procedures
+ *   are rejected;
+ * - the state of the last checkpoint is restored from the first full snapshot and the
+ *   delta snapshot without executing any action.
+ * .
+ * @return the success/failure code of the test case.
+ */
+FwPrTestOutcome_t FwPrTestCaseSnap1();
+
+/**
+ * Test the worst-case execution cost analysis of procedures.
+ * The test creates a procedure without cycles and a procedure with a cycle and it
+ * checks that:
+ * - the cost of an execution from the initial node, from a given action node or from
+ *   any node is computed;
+ * - illegal node identifiers are rejected;
+ * - the cost annotations replace the default cost of the actions and guards;
+ * - the cost of a procedure with a cycle is only bounded if a node budget is given;
+ * - a procedure which does not pass its configuration check is not analysed.
+ * .
+ * @return the success/failure code of the test case.
+ */
+FwPrTestOutcome_t FwPrTestCaseCost1();
+
+/**
+ * Test the declarative guards of a procedure.
+ * The test uses the procedure of the guard memo test case (see
+ * <code>::FwPrTestCaseMemo1</code>) and a procedure with two action nodes whose guards
+ * depend on the node execution counter.
+ * The guards of both procedures increment counter <code>counter_1</code>.
+ * The test checks that:
+ * - guards which are not in the procedure cannot be declared;
+ * - a declared guard is evaluated without calling the guard function (also when the
+ *   procedure is compiled);
+ * - the declaration is not inherited by a derived procedure and it is removed when
+ *   the guard is overridden;
+ * - a guard declared on the node execution counter has the same outcomes as the guard
+ *   function which it replaces.
+ * .
+ * @return the success/failure code of the test case.
+ */
+FwPrTestOutcome_t FwPrTestCaseDecl1();
+
+/**
+ * Test the node execution counter seen by the guards of a procedure which is executed
+ * with a budget (see <code>::FwPrExecuteBudget</code>).
+ * The procedure used in this test case has two action nodes N1 and N2
+ * (Initial->N1->N2->Final) and the guard of the control flow out of N1 records the
+ * node execution counter and becomes true when the counter reaches 2.
+ * The test case checks that:
+ * - the guard sees the same sequence of counter values when the procedure is executed
+ *   with a budget of one node as when it is executed without budget (also when the
+ *   procedure is compiled);
+ * - a suspended procedure which is stopped and started again is not resumed.
+ * .
+ * @return the success/failure code of the test case.
+ */
+FwPrTestOutcome_t FwPrTestCaseBudget2();
+
+/**
+ * Check the validation of the content of a procedure image by the loader.
+ * The test case exports the procedure PR2 (see <code>::FwPrMakeTestPR2</code>) to a
+ * binary image, modifies one index of a copy of the image at a time, recomputes the
+ * checksum of the copy and checks that:
+ * - a copy which is not modified is loaded;
+ * - a copy is rejected if the out-going control flow or the action of an action node,
+ *   the out-going control flows of a decision node or the destination or the guard of
+ *   a control flow are out of the bounds of the arrays of the image;
+ * - a copy is rejected if the destination, the action or the next control flows of an
+ *   entry of the execution table are out of the bounds of the arrays of the image.
+ * .
+ * @return the success/failure code of the test case.
+ */
+FwPrTestOutcome_t FwPrTestCaseImage2();
+
 #endif /* FWPR_TESTCASES_H_ */
@@ -35,6 +35,8 @@ static struct TestRtData rt3Data[MAX_RT_INDEX];
 static struct TestRtData rt4Data[MAX_RT_INDEX];
 /** The array of RT Container data for the RT5 containers */
 static struct TestRtData rt5Data[MAX_RT_INDEX];
+/** The array of RT Container data for the RT6 containers */
+static struct TestRtData rt6Data[MAX_RT_INDEX];
 
 /** The array of RT Container descriptors for RT1 containers */
 struct FwRtDesc rt1Desc[MAX_RT_INDEX];
@@ -46,6 +48,8 @@ struct FwRtDesc rt3Desc[MAX_RT_INDEX];
 struct FwRtDesc rt4Desc[MAX_RT_INDEX];
 /** The array of RT Container descriptors for RT5 containers */
 struct FwRtDesc rt5Desc[MAX_RT_INDEX];
+/** The array of RT Container descriptors for RT6 containers */
+struct FwRtDesc rt6Desc[MAX_RT_INDEX];
 
 /**
  * Initialization Action for Notification Procedure.
@@ -168,7 +172,8 @@ static FwRtOutcome_t apImplActivLogicRnd(FwRtDesc_t rtDesc) {
 
 /**
  * Implementation of Functional Behaviour for Activation Procedure.
- * This operation increments <code>::apImplActivLogicCounter</code> by 1
+ * This operation increments <code>::apImplActivLogicCounter</code> by 1,
+ * adds the number of consumed notifications to <code>::apNOfNotifCounter</code>
  * and returns the value of <code>::apImplActivLogicFlag</code>.
  * @param rtDesc the RT Container descriptor
  * @return return the value of <code>::apImplActivLogicFlag</code>
@@ -176,12 +181,14 @@ static FwRtOutcome_t apImplActivLogicRnd(FwRtDesc_t rtDesc) {
 static FwRtOutcome_t apImplFuncBehaviour(FwRtDesc_t rtDesc) {
 	struct TestRtData* rtData = (struct TestRtData*)FwRtGetData(rtDesc);
 	rtData->apExecFuncBehaviourCounter++;
+	rtData->apNOfNotifCounter += FwRtGetNOfCoalescedNotif(rtDesc);
 	return rtData->apExecFuncBehaviourFlag;
 }
 
 /**
  * Implementation of Functional Behaviour for Activation Procedure.
  * This operation increments <code>::apImplActivLogicCounter</code> by 1,
+ * adds the number of consumed notifications to <code>::apNOfNotifCounter</code>,
  * waits 1 millisecond and then returns the value of
  * <code>::apImplActivLogicFlag</code>.
  * @param rtDesc the RT Container descriptor
@@ -190,6 +197,7 @@ static FwRtOutcome_t apImplFuncBehaviour(FwRtDesc_t rtDesc) {
 static FwRtOutcome_t apImplFuncBehaviourWithWait(FwRtDesc_t rtDesc) {
 	struct TestRtData* rtData = (struct TestRtData*)FwRtGetData(rtDesc);
 	rtData->apExecFuncBehaviourCounter++;
+	rtData->apNOfNotifCounter += FwRtGetNOfCoalescedNotif(rtDesc);
 	nanosleep(&oneMs,NULL);
 	return rtData->apExecFuncBehaviourFlag;
 }
@@ -236,6 +244,7 @@ FwRtDesc_t FwRtMakeTestRT1(unsigned int i) {
 
 	rt1Data[i-1].apExecFuncBehaviourCounter = 0;
 	rt1Data[i-1].apExecFuncBehaviourFlag = 0;
+	rt1Data[i-1].apNOfNotifCounter = 0;
 	rt1Data[i-1].apFinalCounter = 0;
 	rt1Data[i-1].apImplActivLogicCounter = 0;
 	rt1Data[i-1].apImplActivLogicFlag = 0;
@@ -278,6 +287,7 @@ FwRtDesc_t FwRtMakeTestRT2(unsigned int i) {
 
 	rt2Data[i-1].apExecFuncBehaviourCounter = 0;
 	rt2Data[i-1].apExecFuncBehaviourFlag = 0;
+	rt2Data[i-1].apNOfNotifCounter = 0;
 	rt2Data[i-1].apFinalCounter = 0;
 	rt2Data[i-1].apImplActivLogicCounter = 0;
 	rt2Data[i-1].apImplActivLogicFlag = 0;
@@ -320,6 +330,7 @@ FwRtDesc_t FwRtMakeTestRT3(unsigned int i) {
 
 	rt3Data[i-1].apExecFuncBehaviourCounter = 0;
 	rt3Data[i-1].apExecFuncBehaviourFlag = 0;
+	rt3Data[i-1].apNOfNotifCounter = 0;
 	rt3Data[i-1].apFinalCounter = 0;
 	rt3Data[i-1].apImplActivLogicCounter = 0;
 	rt3Data[i-1].apImplActivLogicFlag = 0;
@@ -362,6 +373,7 @@ FwRtDesc_t FwRtMakeTestRT4(unsigned int i) {
 
 	rt4Data[i-1].apExecFuncBehaviourCounter = 0;
 	rt4Data[i-1].apExecFuncBehaviourFlag = 0;
+	rt4Data[i-1].apNOfNotifCounter = 0;
 	rt4Data[i-1].apFinalCounter = 0;
 	rt4Data[i-1].apImplActivLogicCounter = 0;
 	rt4Data[i-1].apImplActivLogicFlag = 0;
@@ -404,6 +416,7 @@ FwRtDesc_t FwRtMakeTestRT5(unsigned int i) {
 
 	rt5Data[i-1].apExecFuncBehaviourCounter = 0;
 	rt5Data[i-1].apExecFuncBehaviourFlag = 0;
+	rt5Data[i-1].apNOfNotifCounter = 0;
 	rt5Data[i-1].apFinalCounter = 0;
 	rt5Data[i-1].apImplActivLogicCounter = 0;
 	rt5Data[i-1].apImplActivLogicFlag = 0;
@@ -438,3 +451,47 @@ FwRtDesc_t FwRtMakeTestRT5(unsigned int i) {
 
 	return &rt5Desc[i-1];
 }
+
+/*---------------------------------------------------------------------*/
+FwRtDesc_t FwRtMakeTestRT6(unsigned int i, FwRtPoolDesc_t pool) {
+	if (i >= MAX_RT_INDEX)
+		return NULL;
+
+	rt6Data[i-1].apExecFuncBehaviourCounter = 0;
+	rt6Data[i-1].apExecFuncBehaviourFlag = 0;
+	rt6Data[i-1].apNOfNotifCounter = 0;
+	rt6Data[i-1].apFinalCounter = 0;
+	rt6Data[i-1].apImplActivLogicCounter = 0;
+	rt6Data[i-1].apImplActivLogicFlag = 0;
+	rt6Data[i-1].apInitCounter = 0;
+	rt6Data[i-1].apSetupNotifCounter = 0;
+	rt6Data[i-1].npFinalCounter = 0;
+	rt6Data[i-1].npImplNotifLogicCounter = 0;
+	rt6Data[i-1].npImplNotifLogicFlag = 0;
+	rt6Data[i-1].npInitCounter = 0;
+
+	/* Reset the RT Container */
+	FwRtReset(&rt6Desc[i-1]);
+
+	/* Load the container data into the RT Container */
+	FwRtSetData(&rt6Desc[i-1],&rt6Data[i-1]);
+
+	/* Define the actions of the RT Container */
+	FwRtSetInitializeNotifPr(&rt6Desc[i-1],&npInitAction);
+	FwRtSetFinalizeNotifPr(&rt6Desc[i-1],&npFinalAction);
+	FwRtSetImplementNotifLogic(&rt6Desc[i-1],&npImplNotifLogic);
+	FwRtSetInitializeActivPr(&rt6Desc[i-1],&apInitAction);
+	FwRtSetFinalizeActivPr(&rt6Desc[i-1],&apFinalAction);
+	FwRtSetSetUpNotif(&rt6Desc[i-1],&apSetupNotif);
+	FwRtSetImplementActivLogic(&rt6Desc[i-1],&apImplActivLogic);
+	FwRtSetExecFuncBehaviour(&rt6Desc[i-1],&apImplFuncBehaviour);
+
+	/* Set Mutex and Conditional Variable attributes and attach the container to the pool */
+	FwRtSetPosixAttr(&rt6Desc[i-1],NULL, NULL, NULL);
+	FwRtSetPool(&rt6Desc[i-1],pool);
+
+	/* Initialize the RT Container */
+	FwRtInit(&rt6Desc[i-1]);
+
+	return &rt6Desc[i-1];
+}
@@ -57,6 +57,8 @@ struct TestRtData {
 	int apExecFuncBehaviourCounter;
 	/** Flag determining the outcome of the Execute Functional Behaviour Action. */
 	FwRtOutcome_t apExecFuncBehaviourFlag;
+	/** Sum of the numbers of notifications consumed by the executions of the Execute Functional Behaviour Action. */
+	int apNOfNotifCounter;
 };
 
 /**
@@ -183,4 +185,21 @@ FwRtDesc_t FwRtMakeTestRT4(unsigned int i);
  */
 FwRtDesc_t FwRtMakeTestRT5(unsigned int i);
 
+/**
+ * This function resets the i-th instance of the Test RT Container RT6 and returns
+ * a pointer to its descriptor.
+ * The Test RT Container RT6 has the same characteristics as RT1 but it does not
+ * have its own Activation Thread: it is attached to the argument RT Pool and its
+ * Activation Procedure is executed by the worker threads of the pool.
+ *
+ * This function returns the RT Container with its counters set to zero and its
+ * flags set to false.
+ * @param i the index of the RT Container instance (an integer in the range 1 to
+ * MAX_RT_INDEX).
+ * @param pool the RT Pool to which the container is attached.
+ * @return the descriptor of the created RT Container or NULL if the argument is
+ * out-of-range.
+ */
+FwRtDesc_t FwRtMakeTestRT6(unsigned int i, FwRtPoolDesc_t pool);
+
 #endif /* FWPR_MAKETESTRT_H_ */
@@ -20,9 +20,13 @@
 #include <stdlib.h>
 #include <time.h>
 #include <pthread.h>
+#include <sched.h>
 #include <unistd.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
 #include "FwRtConstants.h"
 #include "FwRtCore.h"
+#include "FwRtPool.h"
 #include "FwRtTestCases.h"
 #include "FwRtMakeTest.h"
 
@@ -41,6 +45,24 @@ static struct timespec hundredMs = {0,100000000};
 /** Number of cycles in <code>TestCaseStressRun_Notify2</code> */
 #define N_NOTIFY2 10000
 
+/** Number of payloads passed by each notifier in <code>FwRtTestCasePayload1</code> */
+#define N_PAYLOAD1 2000
+
+/** The payloads passed by the notifiers in <code>FwRtTestCasePayload1</code> */
+static int payload1[2*N_PAYLOAD1];
+
+/** The container of <code>FwRtTestCasePayload1</code> */
+static FwRtDesc_t payload1Desc;
+
+/** The number of payloads taken by the functional behaviour in <code>FwRtTestCasePayload1</code> */
+static int nOfPayload1Taken;
+
+/** The last payload taken from each notifier in <code>FwRtTestCasePayload1</code> (-1 if none) */
+static int lastPayload1[2];
+
+/** Flag set if the payloads of a notifier are taken out of order in <code>FwRtTestCasePayload1</code> */
+static int isPayload1OutOfOrder;
+
 /*--------------------------------------------------------------------------*/
 /**
  * Send a sequence of notifications to the argument container until the
@@ -59,6 +81,36 @@ static void* TestCaseStressRun_Notify1(void* rtDesc);
  */
 static void* TestCaseStressRun_Notify2(void* rtDesc);
 
+/*--------------------------------------------------------------------------*/
+/**
+ * Pass <code>#N_PAYLOAD1</code> payloads to the container of
+ * <code>FwRtTestCasePayload1</code>.
+ * The payloads of the first notifier are the first half of <code>payload1</code>
+ * and those of the second notifier are its second half.
+ * A payload is passed again if the payload ring is full.
+ * @param notifier pointer to the index of the notifier (0 or 1)
+ * @return always return NULL
+ */
+static void* TestCasePayload1_Notify(void* notifier);
+
+/**
+ * Functional behaviour of the container of <code>FwRtTestCasePayload1</code>.
+ * The function takes all the payloads in the payload ring and checks that the
+ * payloads of each notifier are taken in the order in which they were passed.
+ * @param rtDesc the container descriptor
+ * @return always return 0
+ */
+static FwRtOutcome_t TestCasePayload1_Exec(FwRtDesc_t rtDesc);
+
+/**
+ * Send one notification to the argument container.
+ * This function is used by <code>FwRtTestCaseLockFree1</code> to notify the
+ * container while the container mutex is held by another thread.
+ * @param rtDesc the container descriptor
+ * @return always return NULL
+ */
+static void* TestCaseLockFree1_Notify(void* rtDesc);
+
 /**
  * Dummy procedure action function.
  * @param rtDesc the container descriptor
@@ -1541,4 +1593,917 @@ FwRtOutcome_t ExecFuncBehaviour(FwRtDesc_t rtDesc) {
 	return 1;
 }
 
+/*--------------------------------------------------------------------------*/
+FwRtTestOutcome_t FwRtTestCasePool1() {
+	struct FwRtPool pool;
+	pthread_t poolThreads[2];
+	FwRtDesc_t rtDesc[6];
+	struct TestRtData* rtData;
+	int i, j;
+
+	/* Initialize the RT Pool */
+	FwRtPoolInit(&pool, poolThreads, 2, NULL);
+	if (FwRtPoolGetState(&pool) != rtContStarted)
+		return rtTestCaseFailure;
+
+	/* Instantiate, initialize, configure and start the test containers RT6 */
+	for (i=0; i<6; i++) {
+		rtDesc[i] = FwRtMakeTestRT6((unsigned int)(i+1), &pool);
+		if (FwRtGetPool(rtDesc[i]) != &pool)
+			return rtTestCaseFailure;
+		rtData = (struct TestRtData*)rtDesc[i]->rtData;
+		rtData->npImplNotifLogicFlag = 1;	/* do not skip notification */
+		rtData->apExecFuncBehaviourFlag = 0; /* do not terminate functional behaviour */
+		rtData->apImplActivLogicFlag = 1; /* execute functional behaviour */
+		FwRtStart(rtDesc[i]);
+		if (FwRtGetContState(rtDesc[i]) != rtContStarted)
+			return rtTestCaseFailure;
+	}
+
+	/* Notify each RT Container five times */
+	for (j=0; j<5; j++)
+		for (i=0; i<6; i++)
+			FwRtNotify(rtDesc[i]);
+
+	/* Wait 10 ms */
+	nanosleep(&tenMs,NULL);
+
+	/* Check state of RT Containers and their procedures */
+	for (i=0; i<6; i++) {
+		rtData = (struct TestRtData*)rtDesc[i]->rtData;
+		if (FwRtGetContState(rtDesc[i]) != rtContStarted)
+			return rtTestCaseFailure;
+		if (!FwRtIsActivPrStarted(rtDesc[i]))
+			return rtTestCaseFailure;
+		if (FwRtGetNotifCounter(rtDesc[i]) != 0)
+			return rtTestCaseFailure;
+		if (rtData->apExecFuncBehaviourCounter != 5)
+			return rtTestCaseFailure;
+	}
+
+	/* Stop RT Containers and wait until their Activation Procedures have terminated */
+	for (i=0; i<6; i++)
+		FwRtStop(rtDesc[i]);
+	for (i=0; i<6; i++)
+		FwRtWaitForTermination(rtDesc[i]);
+
+	/* Check state of counters */
+	for (i=0; i<6; i++) {
+		rtData = (struct TestRtData*)rtDesc[i]->rtData;
+		if (FwRtGetContState(rtDesc[i]) != rtContStopped)
+			return rtTestCaseFailure;
+		if (FwRtIsActivPrStarted(rtDesc[i]))
+			return rtTestCaseFailure;
+		if (FwRtIsNotifPrStarted(rtDesc[i]))
+			return rtTestCaseFailure;
+		if (rtData->npFinalCounter != 1)
+			return rtTestCaseFailure;
+		if (rtData->npImplNotifLogicCounter != 5)
+			return rtTestCaseFailure;
+		if (rtData->npInitCounter != 1)
+			return rtTestCaseFailure;
+		if (rtData->apExecFuncBehaviourCounter != 5)
+			return rtTestCaseFailure;
+		if (rtData->apFinalCounter != 1)
+			return rtTestCaseFailure;
+		if (rtData->apImplActivLogicCounter != 5)
+			return rtTestCaseFailure;
+		if (rtData->apInitCounter != 1)
+			return rtTestCaseFailure;
+		if (rtData->apSetupNotifCounter != 6)
+			return rtTestCaseFailure;
+	}
+
+	/* Shutdown the RT Containers and the RT pool */
+	for (i=0; i<6; i++) {
+		FwRtShutdown(rtDesc[i]);
+		if (FwRtGetErrCode(rtDesc[i]) != 0)
+			return rtTestCaseFailure;
+	}
+	FwRtPoolShutdown(&pool);
+	if (FwRtPoolGetState(&pool) != rtContUninitialized)
+		return rtTestCaseFailure;
+	if (FwRtPoolGetErrCode(&pool) != 0)
+		return rtTestCaseFailure;
+
+	return rtTestCaseSuccess;
+}
+
+/*--------------------------------------------------------------------------*/
+FwRtTestOutcome_t FwRtTestCasePool2() {
+	struct FwRtPool pool;
+	pthread_t poolThread;
+	FwRtDesc_t rtDesc1, rtDesc2;
+	struct TestRtData* rtData1;
+	struct TestRtData* rtData2;
+
+	/* Initialize the RT Pool */
+	FwRtPoolInit(&pool, &poolThread, 1, NULL);
+
+	/* Instantiate and configure two test containers RT6 */
+	rtDesc1 = FwRtMakeTestRT6(7, &pool);
+	rtDesc2 = FwRtMakeTestRT6(8, &pool);
+	rtData1 = (struct TestRtData*)rtDesc1->rtData;
+	rtData2 = (struct TestRtData*)rtDesc2->rtData;
+	rtData1->npImplNotifLogicFlag = 1;
+	rtData1->apImplActivLogicFlag = 1;
+	rtData1->apExecFuncBehaviourFlag = 1; /* terminate functional behaviour */
+	rtData2->npImplNotifLogicFlag = 1;
+	rtData2->apImplActivLogicFlag = 1;
+	rtData2->apExecFuncBehaviourFlag = 0; /* do not terminate functional behaviour */
+
+	/* Start and notify the RT Containers and wait until the first one has terminated */
+	FwRtStart(rtDesc1);
+	FwRtStart(rtDesc2);
+	FwRtNotify(rtDesc2);
+	FwRtNotify(rtDesc1);
+	FwRtNotify(rtDesc2);
+	FwRtWaitForTermination(rtDesc1);
+
+	/* Check state of RT Containers */
+	if (FwRtGetContState(rtDesc1) != rtContStopped)
+		return rtTestCaseFailure;
+	if (FwRtIsActivPrStarted(rtDesc1))
+		return rtTestCaseFailure;
+	if (FwRtIsNotifPrStarted(rtDesc1))
+		return rtTestCaseFailure;
+	if (FwRtGetContState(rtDesc2) != rtContStarted)
+		return rtTestCaseFailure;
+	if (rtData1->apExecFuncBehaviourCounter != 1)
+		return rtTestCaseFailure;
+	if (rtData1->apFinalCounter != 1)
+		return rtTestCaseFailure;
+	if (rtData1->npFinalCounter != 1)
+		return rtTestCaseFailure;
+
+	/* Re-start the first RT Container and notify it */
+	rtData1->apExecFuncBehaviourFlag = 0;
+	FwRtStart(rtDesc1);
+	if (FwRtGetContState(rtDesc1) != rtContStarted)
+		return rtTestCaseFailure;
+	FwRtNotify(rtDesc1);
+	FwRtNotify(rtDesc1);
+
+	/* Wait 10 ms */
+	nanosleep(&tenMs,NULL);
+
+	/* Stop the RT Containers and wait until they have terminated */
+	FwRtStop(rtDesc1);
+	FwRtStop(rtDesc2);
+	FwRtWaitForTermination(rtDesc1);
+	FwRtWaitForTermination(rtDesc2);
+
+	/* Check state of counters */
+	if (FwRtGetContState(rtDesc1) != rtContStopped)
+		return rtTestCaseFailure;
+	if (FwRtGetContState(rtDesc2) != rtContStopped)
+		return rtTestCaseFailure;
+	if (rtData1->apExecFuncBehaviourCounter != 3)
+		return rtTestCaseFailure;
+	if (rtData1->apInitCounter != 2)
+		return rtTestCaseFailure;
+	if (rtData1->apFinalCounter != 2)
+		return rtTestCaseFailure;
+	if (rtData1->npFinalCounter != 2)
+		return rtTestCaseFailure;
+	if (rtData2->apExecFuncBehaviourCounter != 2)
+		return rtTestCaseFailure;
+	if (rtData2->apFinalCounter != 1)
+		return rtTestCaseFailure;
+	if (rtData2->npFinalCounter != 1)
+		return rtTestCaseFailure;
+
+	/* Shutdown the RT Containers and the RT pool */
+	FwRtShutdown(rtDesc1);
+	FwRtShutdown(rtDesc2);
+	if ((FwRtGetErrCode(rtDesc1) != 0) || (FwRtGetErrCode(rtDesc2) != 0))
+		return rtTestCaseFailure;
+	FwRtPoolShutdown(&pool);
+	if (FwRtPoolGetState(&pool) != rtContUninitialized)
+		return rtTestCaseFailure;
+
+	return rtTestCaseSuccess;
+}
+
+/*--------------------------------------------------------------------------*/
+FwRtTestOutcome_t FwRtTestCaseLockFree1() {
+	FwRtDesc_t rtDesc;
+	struct TestRtData* rtData;
+	pthread_t notifThread;
+
+	/* Instantiate test container RT1 and re-initialize it in the lock-free notification mode */
+	rtDesc = FwRtMakeTestRT1(1);
+	FwRtShutdown(rtDesc);
+	FwRtSetLockFreeNotif(rtDesc, 1);
+	FwRtInit(rtDesc);
+	if (FwRtIsLockFreeNotif(rtDesc) != 1)
+		return rtTestCaseFailure;
+
+	/* Configure RT1 */
+	rtData = (struct TestRtData*)rtDesc->rtData;
+	rtData->npImplNotifLogicFlag = 1;	/* do not skip notification */
+	rtData->apExecFuncBehaviourFlag = 0; /* do not terminate functional behaviour */
+	rtData->apImplActivLogicFlag = 1; /* execute functional behaviour */
+
+	/* Start RT Container */
+	FwRtStart(rtDesc);
+	if (FwRtGetContState(rtDesc) != rtContStarted)
+		return rtTestCaseFailure;
+
+	/* Notify RT Container five consecutive times */
+	FwRtNotify(rtDesc);
+	FwRtNotify(rtDesc);
+	FwRtNotify(rtDesc);
+	FwRtNotify(rtDesc);
+	FwRtNotify(rtDesc);
+
+	/* Wait 10 ms */
+	nanosleep(&tenMs,NULL);
+
+	/* Check state of RT Container and its procedures */
+	if (FwRtGetContState(rtDesc) != rtContStarted)
+		return rtTestCaseFailure;
+	if (!FwRtIsActivPrStarted(rtDesc))
+		return rtTestCaseFailure;
+	if (!FwRtIsNotifPrStarted(rtDesc))
+		return rtTestCaseFailure;
+	if (FwRtGetNotifCounter(rtDesc) != 0)
+		return rtTestCaseFailure;
+
+	/* Notify RT Container while its mutex is held and check that the notification logic and the
+	 * Notification Counter do not wait for the mutex but the wake-up of the Activation Thread does */
+	pthread_mutex_lock(&(rtDesc->mutex));
+	pthread_create(&notifThread, NULL, TestCaseLockFree1_Notify, rtDesc);
+	nanosleep(&tenMs,NULL);
+	if ((rtData->npImplNotifLogicCounter != 6) || (FwRtGetNotifCounter(rtDesc) != 1) ||
+	        (rtData->apExecFuncBehaviourCounter != 5)) {
+		pthread_mutex_unlock(&(rtDesc->mutex));
+		pthread_join(notifThread,NULL);
+		return rtTestCaseFailure;
+	}
+	pthread_mutex_unlock(&(rtDesc->mutex));
+	pthread_join(notifThread,NULL);
+
+	/* Wait 10 ms for the notification to be processed */
+	nanosleep(&tenMs,NULL);
+	if ((FwRtGetNotifCounter(rtDesc) != 0) || (rtData->apExecFuncBehaviourCounter != 6))
+		return rtTestCaseFailure;
+
+	/* Stop RT Container and wait until Activation Thread has terminated */
+	FwRtStop(rtDesc);
+	FwRtWaitForTermination(rtDesc);
+
+	/* Check state of counters */
+	if (FwRtIsNotifPrStarted(rtDesc))
+		return rtTestCaseFailure;
+	if (rtData->npFinalCounter != 1)
+		return rtTestCaseFailure;
+	if (rtData->npImplNotifLogicCounter != 6)
+		return rtTestCaseFailure;
+	if (rtData->npInitCounter != 1)
+		return rtTestCaseFailure;
+	if (rtData->apExecFuncBehaviourCounter != 6)
+		return rtTestCaseFailure;
+	if (rtData->apFinalCounter != 1)
+		return rtTestCaseFailure;
+	if (rtData->apImplActivLogicCounter != 6)
+		return rtTestCaseFailure;
+	if (rtData->apSetupNotifCounter != 7)
+		return rtTestCaseFailure;
+
+	/* Shutdown the RT Container */
+	FwRtShutdown(rtDesc);
+
+	/* Check error code */
+	if (FwRtGetErrCode(rtDesc) != 0)
+		return rtTestCaseFailure;
+
+	return rtTestCaseSuccess;
+}
+
+/*--------------------------------------------------------------------------*/
+FwRtTestOutcome_t FwRtTestCaseLockFree2() {
+	FwRtDesc_t rtDesc;
+	struct TestRtData* rtData;
+	int i;
+
+	/* Instantiate test container RT1 and re-initialize it in the lock-free notification mode */
+	rtDesc = FwRtMakeTestRT1(2);
+	FwRtShutdown(rtDesc);
+	FwRtSetLockFreeNotif(rtDesc, 1);
+	FwRtInit(rtDesc);
+
+	/* Configure RT1 */
+	rtData = (struct TestRtData*)rtDesc->rtData;
+	rtData->npImplNotifLogicFlag = 1;	/* do not skip notification */
+	rtData->apExecFuncBehaviourFlag = 0; /* do not terminate functional behaviour */
+	rtData->apImplActivLogicFlag = 1; /* execute functional behaviour */
+
+	/* Start RT Container and send it a sequence of notifications */
+	FwRtStart(rtDesc);
+	for (i=0; i<1000; i++) {
+		FwRtNotify(rtDesc);
+		if ((i % 50) == 0)
+			nanosleep(&oneMs,NULL);
+	}
+
+	/* Wait until all notifications have been processed (or a timeout of 1 s has expired) */
+	for (i=0; i<1000; i++) {
+		if (FwRtGetNotifCounter(rtDesc) == 0)
+			break;
+		nanosleep(&oneMs,NULL);
+	}
+	nanosleep(&oneMs,NULL);
+	if (FwRtGetNotifCounter(rtDesc) != 0)
+		return rtTestCaseFailure;
+	if (rtData->apExecFuncBehaviourCounter != 1000)
+		return rtTestCaseFailure;
+
+	/* Stop RT Container and wait until Activation Thread has terminated */
+	FwRtStop(rtDesc);
+	FwRtWaitForTermination(rtDesc);
+	if (FwRtIsActivPrStarted(rtDesc))
+		return rtTestCaseFailure;
+	if (rtData->apFinalCounter != 1)
+		return rtTestCaseFailure;
+
+	/* Shutdown the RT Container */
+	FwRtShutdown(rtDesc);
+	if (FwRtGetErrCode(rtDesc) != 0)
+		return rtTestCaseFailure;
+
+	return rtTestCaseSuccess;
+}
+
+/*--------------------------------------------------------------------------*/
+FwRtTestOutcome_t FwRtTestCaseCoalesce1() {
+	FwRtDesc_t rtDesc;
+	struct TestRtData* rtData;
+	int i;
+
+	/* Instantiate test container RT2 and re-initialize it in the notification coalescing mode */
+	rtDesc = FwRtMakeTestRT2(2);
+	FwRtShutdown(rtDesc);
+	FwRtSetNotifCoalescing(rtDesc, 1, NULL);
+	FwRtInit(rtDesc);
+	if (FwRtIsNotifCoalescing(rtDesc) != 1)
+		return rtTestCaseFailure;
+
+	/* Configure RT2 */
+	rtData = (struct TestRtData*)rtDesc->rtData;
+	rtData->npImplNotifLogicFlag = 1;	/* do not skip notification */
+	rtData->apExecFuncBehaviourFlag = 0; /* do not terminate functional behaviour */
+	rtData->apImplActivLogicFlag = 1; /* execute functional behaviour */
+
+	/* Start RT Container and notify it twenty times */
+	FwRtStart(rtDesc);
+	for (i=0; i<20; i++)
+		FwRtNotify(rtDesc);
+
+	/* Wait until all notifications have been processed (or a timeout of 1 s has expired) */
+	for (i=0; i<1000; i++) {
+		if (rtData->apNOfNotifCounter == 20)
+			break;
+		nanosleep(&oneMs,NULL);
+	}
+	if (FwRtGetNotifCounter(rtDesc) != 0)
+		return rtTestCaseFailure;
+	if (rtData->apNOfNotifCounter != 20)
+		return rtTestCaseFailure;
+	if ((rtData->apExecFuncBehaviourCounter < 1) || (rtData->apExecFuncBehaviourCounter >= 20))
+		return rtTestCaseFailure;
+	if (rtData->npImplNotifLogicCounter != 20)
+		return rtTestCaseFailure;
+
+	/* Stop RT Container and wait until Activation Thread has terminated */
+	FwRtStop(rtDesc);
+	FwRtWaitForTermination(rtDesc);
+	if (FwRtIsActivPrStarted(rtDesc))
+		return rtTestCaseFailure;
+	if (rtData->apFinalCounter != 1)
+		return rtTestCaseFailure;
+
+	/* Shutdown the RT Container */
+	FwRtShutdown(rtDesc);
+	if (FwRtGetErrCode(rtDesc) != 0)
+		return rtTestCaseFailure;
 
+	return rtTestCaseSuccess;
+}
+
+/*--------------------------------------------------------------------------*/
+FwRtTestOutcome_t FwRtTestCaseCoalesce2() {
+	FwRtDesc_t rtDesc;
+	struct TestRtData* rtData;
+	struct timespec maxDelay = {0,20000000};
+	struct timespec fiveMs = {0,5000000};
+
+	/* Instantiate test container RT1 and re-initialize it in the notification coalescing mode */
+	rtDesc = FwRtMakeTestRT1(3);
+	FwRtShutdown(rtDesc);
+	FwRtSetNotifCoalescing(rtDesc, 1, &maxDelay);
+	FwRtInit(rtDesc);
+
+	/* Configure RT1 */
+	rtData = (struct TestRtData*)rtDesc->rtData;
+	rtData->npImplNotifLogicFlag = 1;	/* do not skip notification */
+	rtData->apExecFuncBehaviourFlag = 0; /* do not terminate functional behaviour */
+	rtData->apImplActivLogicFlag = 1; /* execute functional behaviour */
+
+	/* Start RT Container and send it a first notification followed by four more after 5 ms */
+	FwRtStart(rtDesc);
+	FwRtNotify(rtDesc);
+	nanosleep(&fiveMs,NULL);
+	FwRtNotify(rtDesc);
+	FwRtNotify(rtDesc);
+	FwRtNotify(rtDesc);
+	FwRtNotify(rtDesc);
+
+	/* The coalescing delay has not yet expired */
+	if (rtData->apExecFuncBehaviourCounter != 0)
+		return rtTestCaseFailure;
+
+	/* Wait until the coalescing delay has expired */
+	nanosleep(&maxDelay,NULL);
+	nanosleep(&tenMs,NULL);
+	if (FwRtGetNotifCounter(rtDesc) != 0)
+		return rtTestCaseFailure;
+	if (rtData->apExecFuncBehaviourCounter != 1)
+		return rtTestCaseFailure;
+	if (rtData->apNOfNotifCounter != 5)
+		return rtTestCaseFailure;
+
+	/* Notify and immediately stop the RT Container: the stop request ends the coalescing delay */
+	FwRtNotify(rtDesc);
+	FwRtStop(rtDesc);
+	FwRtWaitForTermination(rtDesc);
+	if (FwRtGetContState(rtDesc) != rtContStopped)
+		return rtTestCaseFailure;
+	if (rtData->apExecFuncBehaviourCounter != 1)
+		return rtTestCaseFailure;
+	if (rtData->apFinalCounter != 1)
+		return rtTestCaseFailure;
+	if (rtData->npFinalCounter != 1)
+		return rtTestCaseFailure;
+
+	/* Shutdown the RT Container */
+	FwRtShutdown(rtDesc);
+	if (FwRtGetErrCode(rtDesc) != 0)
+		return rtTestCaseFailure;
+
+	return rtTestCaseSuccess;
+}
+
+/*--------------------------------------------------------------------------*/
+FwRtTestOutcome_t FwRtTestCasePeriodic1() {
+	FwRtDesc_t rtDesc;
+	struct TestRtData* rtData;
+	struct timespec period = {0,5000000};
+	struct timespec phase = {0,20000000};
+
+	/* Instantiate test container RT1 and re-initialize it in the periodic activation mode */
+	rtDesc = FwRtMakeTestRT1(4);
+	FwRtShutdown(rtDesc);
+	FwRtSetPeriodic(rtDesc, &period, &phase);
+	FwRtInit(rtDesc);
+	if (FwRtIsPeriodic(rtDesc) != 1)
+		return rtTestCaseFailure;
+
+	/* Configure RT1 */
+	rtData = (struct TestRtData*)rtDesc->rtData;
+	rtData->npImplNotifLogicFlag = 1;	/* do not skip notification */
+	rtData->apExecFuncBehaviourFlag = 0; /* do not terminate functional behaviour */
+	rtData->apImplActivLogicFlag = 1; /* execute functional behaviour */
+
+	/* Start RT Container and notify it three times before its first release */
+	FwRtStart(rtDesc);
+	FwRtNotify(rtDesc);
+	FwRtNotify(rtDesc);
+	FwRtNotify(rtDesc);
+	nanosleep(&tenMs,NULL);
+	if (rtData->apExecFuncBehaviourCounter != 0)
+		return rtTestCaseFailure;
+
+	/* Wait for about sixteen periods: the container is released without being notified */
+	nanosleep(&hundredMs,NULL);
+	if ((rtData->apExecFuncBehaviourCounter < 5) || (rtData->apExecFuncBehaviourCounter > 25))
+		return rtTestCaseFailure;
+	if (rtData->apNOfNotifCounter != 3)
+		return rtTestCaseFailure;
+	if (FwRtGetNotifCounter(rtDesc) != 0)
+		return rtTestCaseFailure;
+
+	/* Stop RT Container: the stop request is processed at the next release */
+	FwRtStop(rtDesc);
+	FwRtWaitForTermination(rtDesc);
+	if (FwRtGetContState(rtDesc) != rtContStopped)
+		return rtTestCaseFailure;
+	if (FwRtIsActivPrStarted(rtDesc))
+		return rtTestCaseFailure;
+	if (rtData->apFinalCounter != 1)
+		return rtTestCaseFailure;
+	if (rtData->npFinalCounter != 1)
+		return rtTestCaseFailure;
+
+	/* Shutdown the RT Container */
+	FwRtShutdown(rtDesc);
+	if (FwRtGetErrCode(rtDesc) != 0)
+		return rtTestCaseFailure;
+
+	return rtTestCaseSuccess;
+}
+
+/*--------------------------------------------------------------------------*/
+FwRtTestOutcome_t FwRtTestCasePeriodic2() {
+	FwRtDesc_t rtDesc;
+	struct TestRtData* rtData;
+	struct timespec period = {0,200000};
+	struct timespec maxExecTime;
+
+	/* Instantiate test container RT2 and re-initialize it in the periodic activation mode */
+	rtDesc = FwRtMakeTestRT2(4);
+	FwRtShutdown(rtDesc);
+	FwRtSetPeriodic(rtDesc, &period, NULL);
+	FwRtInit(rtDesc);
+
+	/* Configure RT2 */
+	rtData = (struct TestRtData*)rtDesc->rtData;
+	rtData->npImplNotifLogicFlag = 1;	/* do not skip notification */
+	rtData->apExecFuncBehaviourFlag = 0; /* do not terminate functional behaviour */
+	rtData->apImplActivLogicFlag = 1; /* execute functional behaviour */
+
+	/* Start RT Container and let it run: its functional behaviour is longer than its period */
+	FwRtStart(rtDesc);
+	nanosleep(&tenMs,NULL);
+	nanosleep(&tenMs,NULL);
+
+	/* Stop RT Container and wait until Activation Thread has terminated */
+	FwRtStop(rtDesc);
+	FwRtWaitForTermination(rtDesc);
+	if (FwRtGetContState(rtDesc) != rtContStopped)
+		return rtTestCaseFailure;
+	if (rtData->apExecFuncBehaviourCounter < 1)
+		return rtTestCaseFailure;
+	if (FwRtGetNOfOverruns(rtDesc) < rtData->apExecFuncBehaviourCounter)
+		return rtTestCaseFailure;
+	maxExecTime = FwRtGetMaxExecTime(rtDesc);
+	if ((maxExecTime.tv_sec == 0) && (maxExecTime.tv_nsec < oneMs.tv_nsec))
+		return rtTestCaseFailure;
+
+	/* Shutdown the RT Container */
+	FwRtShutdown(rtDesc);
+	if (FwRtGetErrCode(rtDesc) != 0)
+		return rtTestCaseFailure;
+
+	return rtTestCaseSuccess;
+}
+
+/*--------------------------------------------------------------------------*/
+FwRtTestOutcome_t FwRtTestCaseRtAttr1() {
+	FwRtDesc_t rtDesc;
+	struct TestRtData* rtData;
+	static long stack[65536/sizeof(long)];
+	void* stackAddr;
+	size_t stackSize;
+	int policy;
+	int i;
+	struct rlimit memLockLimit, noMemLockLimit;
+
+	/* Instantiate test container RT1 and re-initialize it with real-time settings */
+	rtDesc = FwRtMakeTestRT1(5);
+	FwRtShutdown(rtDesc);
+	FwRtSetSchedPolicy(rtDesc, SCHED_OTHER, 0);
+	FwRtSetCpuAffinity(rtDesc, 1UL);
+	FwRtSetStack(rtDesc, stack, sizeof(stack));
+	FwRtSetPrioInherit(rtDesc, 1);
+	stack[0] = 1;
+	FwRtInit(rtDesc);
+	if (FwRtGetContState(rtDesc) != rtContStopped)
+		return rtTestCaseFailure;
+
+	/* The settings have been applied to the container's own attribute objects */
+	if (FwRtGetActivThreadAttr(rtDesc) != &(rtDesc->threadAttr))
+		return rtTestCaseFailure;
+	if (FwRtGetMutexAttr(rtDesc) != &(rtDesc->mutexAttr))
+		return rtTestCaseFailure;
+	if (pthread_attr_getschedpolicy(FwRtGetActivThreadAttr(rtDesc), &policy) != 0)
+		return rtTestCaseFailure;
+	if (policy != SCHED_OTHER)
+		return rtTestCaseFailure;
+	if (pthread_attr_getstack(FwRtGetActivThreadAttr(rtDesc), &stackAddr, &stackSize) != 0)
+		return rtTestCaseFailure;
+	if ((stackAddr != (void*)stack) || (stackSize != sizeof(stack)))
+		return rtTestCaseFailure;
+	if (stack[0] != 0)	/* the stack has been prefaulted */
+		return rtTestCaseFailure;
+
+	/* Configuration functions cannot be called after initialization */
+	FwRtSetCpuAffinity(rtDesc, 2UL);
+	if (FwRtGetContState(rtDesc) != rtConfigErr)
+		return rtTestCaseFailure;
+	rtDesc->state = rtContStopped;
+	if (rtDesc->cpuMask != 1UL)
+		return rtTestCaseFailure;
+
+	/* Configure RT1 */
+	rtData = (struct TestRtData*)rtDesc->rtData;
+	rtData->npImplNotifLogicFlag = 1;	/* do not skip notification */
+	rtData->apExecFuncBehaviourFlag = 0; /* do not terminate functional behaviour */
+	rtData->apImplActivLogicFlag = 1; /* execute functional behaviour */
+
+	/* Start RT Container and notify it three times */
+	FwRtStart(rtDesc);
+	if (FwRtGetContState(rtDesc) != rtContStarted)
+		return rtTestCaseFailure;
+	for (i=0; i<3; i++) {
+		FwRtNotify(rtDesc);
+		nanosleep(&oneMs,NULL);
+	}
+
+	/* Wait until all notifications have been processed (or a timeout of 1 s has expired) */
+	for (i=0; i<1000; i++) {
+		if (rtData->apExecFuncBehaviourCounter == 3)
+			break;
+		nanosleep(&oneMs,NULL);
+	}
+	if (rtData->apExecFuncBehaviourCounter != 3)
+		return rtTestCaseFailure;
+
+	/* Stop RT Container and wait until Activation Thread has terminated */
+	FwRtStop(rtDesc);
+	FwRtWaitForTermination(rtDesc);
+	if (rtData->apFinalCounter != 1)
+		return rtTestCaseFailure;
+
+	/* Restart the RT Container with memory locking (which fails without privileges) and without
+	 * memory to lock: if the memory cannot be locked, the container mutex is released */
+	getrlimit(RLIMIT_MEMLOCK, &memLockLimit);
+	noMemLockLimit = memLockLimit;
+	noMemLockLimit.rlim_cur = 0;
+	setrlimit(RLIMIT_MEMLOCK, &noMemLockLimit);
+	rtDesc->memLock = 1;
+	FwRtStart(rtDesc);
+	rtDesc->memLock = 0;
+	setrlimit(RLIMIT_MEMLOCK, &memLockLimit);
+	if (FwRtGetContState(rtDesc) == rtMemLockErr) {
+		if (pthread_mutex_trylock(&(rtDesc->mutex)) != 0)
+			return rtTestCaseFailure;
+		pthread_mutex_unlock(&(rtDesc->mutex));
+		rtDesc->state = rtContStopped;
+		rtDesc->errCode = 0;
+	} else {
+		if (FwRtGetContState(rtDesc) != rtContStarted)
+			return rtTestCaseFailure;
+		FwRtStop(rtDesc);
+		FwRtWaitForTermination(rtDesc);
+		munlockall();
+	}
+
+	/* Shutdown the RT Container */
+	FwRtShutdown(rtDesc);
+	if (FwRtGetErrCode(rtDesc) != 0)
+		return rtTestCaseFailure;
+
+	return rtTestCaseSuccess;
+}
+
+/*--------------------------------------------------------------------------*/
+FwRtTestOutcome_t FwRtTestCaseStats1() {
+	FwRtDesc_t rtDesc;
+	struct TestRtData* rtData;
+	FwRtStats_t stats;
+	FwRtCounterU4_t nOfWakeLat = 0;
+	FwRtCounterU4_t nOfExec = 0;
+	FwRtCounterU4_t nOfDepth = 0;
+	int i;
+
+	/* Instantiate and initialize test container RT2 */
+	rtDesc = FwRtMakeTestRT2(5);
+	rtData = (struct TestRtData*)rtDesc->rtData;
+	rtData->npImplNotifLogicFlag = 1;	/* do not skip notification */
+	rtData->apExecFuncBehaviourFlag = 0; /* do not terminate functional behaviour */
+	rtData->apImplActivLogicFlag = 1; /* execute functional behaviour */
+
+	/* Start RT Container and notify it five times at intervals of 10 ms */
+	FwRtStart(rtDesc);
+	for (i=0; i<5; i++) {
+		FwRtNotify(rtDesc);
+		nanosleep(&tenMs,NULL);
+	}
+
+#ifdef FW_RT_STATS
+	if (FwRtGetStats(rtDesc, &stats) != 1)
+		return rtTestCaseFailure;
+#else
+	if (FwRtGetStats(rtDesc, &stats) != 0)
+		return rtTestCaseFailure;
+#endif
+	for (i=0; i<FW_RT_N_OF_HIST_BINS; i++) {
+		nOfWakeLat += stats.wakeLatency[i];
+		nOfExec += stats.execTime[i];
+		nOfDepth += stats.queueDepth[i];
+	}
+#ifdef FW_RT_STATS
+	/* Each notification has woken up the Activation Procedure and takes at least 1 ms to process */
+	if ((stats.nOfWakeUps != 5) || (nOfWakeLat != 5) || (nOfExec != 5) || (nOfDepth != 5))
+		return rtTestCaseFailure;
+	if (stats.queueDepth[0] != 5)
+		return rtTestCaseFailure;
+	for (i=0; i<19; i++)	/* bin 19 starts at about 0.5 ms */
+		if (stats.execTime[i] != 0)
+			return rtTestCaseFailure;
+
+	/* Reset the histograms */
+	FwRtResetStats(rtDesc);
+	(void)FwRtGetStats(rtDesc, &stats);
+	if ((stats.nOfWakeUps != 0) || (stats.execTime[19] != 0) || (stats.execTime[20] != 0))
+		return rtTestCaseFailure;
+#else
+	/* The instrumentation is compiled out */
+	if ((stats.nOfWakeUps != 0) || (nOfWakeLat != 0) || (nOfExec != 0) || (nOfDepth != 0))
+		return rtTestCaseFailure;
+	FwRtResetStats(rtDesc);
+#endif
+
+	/* Stop RT Container and wait until Activation Thread has terminated */
+	FwRtStop(rtDesc);
+	FwRtWaitForTermination(rtDesc);
+	if (rtData->apExecFuncBehaviourCounter != 5)
+		return rtTestCaseFailure;
+
+	/* Shutdown the RT Container */
+	FwRtShutdown(rtDesc);
+	if (FwRtGetErrCode(rtDesc) != 0)
+		return rtTestCaseFailure;
+
+	return rtTestCaseSuccess;
+}
+
+/*--------------------------------------------------------------------------*/
+void* TestCasePayload1_Notify(void* notifier) {
+	int n = *(int*)notifier;
+	int i;
+	for (i=0; i<N_PAYLOAD1; i++) {
+		while (FwRtNotifyWithPayload(payload1Desc, &payload1[n*N_PAYLOAD1+i]) == 0)
+			sched_yield();
+	}
+	return NULL;
+}
+
+/*--------------------------------------------------------------------------*/
+FwRtOutcome_t TestCasePayload1_Exec(FwRtDesc_t rtDesc) {
+	int* payload;
+	int n;
+	while ((payload = (int*)FwRtTakePayload(rtDesc)) != NULL) {
+		n = *payload / N_PAYLOAD1;
+		if (*payload != ((lastPayload1[n] < 0) ? n*N_PAYLOAD1 : lastPayload1[n]+1))
+			isPayload1OutOfOrder = 1;
+		lastPayload1[n] = *payload;
+		nOfPayload1Taken++;
+	}
+	return 0;
+}
+
+/*------------------------------------------------------------------------------------------------- */
+FwRtTestOutcome_t FwRtTestCasePayload1() {
+	FwRtDesc_t rtDesc;
+	struct FwRtDesc rtDescBad;
+	FwRtPayloadSlot_t slots[8];
+	struct TestRtData* rtData;
+	pthread_t notifier[2];
+	int notifierIndex[2] = {0, 1};
+	int i;
+
+	for (i=0; i<2*N_PAYLOAD1; i++)
+		payload1[i] = i;
+	nOfPayload1Taken = 0;
+	lastPayload1[0] = -1;
+	lastPayload1[1] = -1;
+	isPayload1OutOfOrder = 0;
+
+	/* The number of slots must be a power of two */
+	FwRtReset(&rtDescBad);
+	FwRtSetPayloadRing(&rtDescBad, slots, 6, 0);
+	if (FwRtGetContState(&rtDescBad) != rtConfigErr)
+		return rtTestCaseFailure;
+
+	/* Instantiate test container RT1 and re-initialize it with a payload ring */
+	rtDesc = FwRtMakeTestRT1(5);
+	if (FwRtNotifyWithPayload(rtDesc, &payload1[0]) != 0)	/* no payload ring */
+		return rtTestCaseFailure;
+	FwRtShutdown(rtDesc);
+	FwRtSetPayloadRing(rtDesc, slots, 8, 1);
+	FwRtSetExecFuncBehaviour(rtDesc, &TestCasePayload1_Exec);
+	FwRtInit(rtDesc);
+	payload1Desc = rtDesc;
+
+	/* Configuration functions cannot be called after initialization */
+	FwRtSetPayloadRing(rtDesc, slots, 4, 1);
+	if ((FwRtGetContState(rtDesc) != rtConfigErr) || (rtDesc->nOfPayloadSlots != 8))
+		return rtTestCaseFailure;
+	rtDesc->state = rtContStopped;
+
+	/* The ring holds eight payloads which are taken in the order in which they were passed */
+	for (i=0; i<8; i++)
+		if (FwRtNotifyWithPayload(rtDesc, &payload1[i]) != 1)
+			return rtTestCaseFailure;
+	if ((FwRtNotifyWithPayload(rtDesc, &payload1[8]) != 0) || (FwRtGetNOfPayloads(rtDesc) != 8))
+		return rtTestCaseFailure;
+	for (i=0; i<8; i++)
+		if (FwRtTakePayload(rtDesc) != &payload1[i])
+			return rtTestCaseFailure;
+	if ((FwRtTakePayload(rtDesc) != NULL) || (FwRtGetNOfPayloads(rtDesc) != 0))
+		return rtTestCaseFailure;
+
+	/* Configure RT1 */
+	rtData = (struct TestRtData*)rtDesc->rtData;
+	rtData->npImplNotifLogicFlag = 1;	/* do not skip notification */
+	rtData->apImplActivLogicFlag = 1; /* execute functional behaviour */
+
+	/* Start RT Container and let two threads pass payloads to it concurrently */
+	FwRtStart(rtDesc);
+	for (i=0; i<2; i++)
+		if (pthread_create(&notifier[i], NULL, TestCasePayload1_Notify, &notifierIndex[i]) != 0)
+			return rtTestCaseFailure;
+	for (i=0; i<2; i++)
+		if (pthread_join(notifier[i], NULL) != 0)
+			return rtTestCaseFailure;
+
+	/* Stop RT Container, wait until Activation Thread has terminated and take the remaining payloads */
+	FwRtStop(rtDesc);
+	FwRtWaitForTermination(rtDesc);
+	(void)TestCasePayload1_Exec(rtDesc);
+	if ((nOfPayload1Taken != 2*N_PAYLOAD1) || (isPayload1OutOfOrder != 0))
+		return rtTestCaseFailure;
+	if ((lastPayload1[0] != N_PAYLOAD1-1) || (lastPayload1[1] != 2*N_PAYLOAD1-1))
+		return rtTestCaseFailure;
+
+	/* Shutdown the RT Container */
+	FwRtShutdown(rtDesc);
+	if (FwRtGetErrCode(rtDesc) != 0)
+		return rtTestCaseFailure;
+
+	return rtTestCaseSuccess;
+}
+
+/*--------------------------------------------------------------------------*/
+FwRtTestOutcome_t FwRtTestCasePool3() {
+	struct FwRtPool pool;
+	pthread_t poolThread;
+	pthread_mutexattr_t mutexAttr;
+	FwRtDesc_t rtDesc;
+	struct TestRtData* rtData;
+
+	/* Initialize a RT Pool without worker threads whose mutex reports a re-lock by its owner */
+	FwRtPoolInit(&pool, &poolThread, 0, NULL);
+	if (FwRtPoolGetState(&pool) != rtContStarted)
+		return rtTestCaseFailure;
+	pthread_mutex_destroy(&(pool.mutex));
+	pthread_mutexattr_init(&mutexAttr);
+	pthread_mutexattr_settype(&mutexAttr, PTHREAD_MUTEX_ERRORCHECK);
+	pthread_mutex_init(&(pool.mutex), &mutexAttr);
+	pthread_mutexattr_destroy(&mutexAttr);
+
+	/* Instantiate, configure and start a test container RT6 and notify it twice */
+	rtDesc = FwRtMakeTestRT6(9, &pool);
+	rtData = (struct TestRtData*)rtDesc->rtData;
+	rtData->npImplNotifLogicFlag = 1;	/* do not skip notification */
+	rtData->apExecFuncBehaviourFlag = 0; /* do not terminate functional behaviour */
+	rtData->apImplActivLogicFlag = 1; /* execute functional behaviour */
+	FwRtStart(rtDesc);
+	FwRtNotify(rtDesc);
+	FwRtNotify(rtDesc);
+	if ((FwRtGetContState(rtDesc) != rtContStarted) || (FwRtGetNotifCounter(rtDesc) != 2) ||
+	        (pool.head != rtDesc))
+		return rtTestCaseFailure;
+	pool.head = NULL;
+	pool.tail = NULL;
+
+	/* Run the container while holding the pool mutex: the container cannot be put back in
+	 * the ready queue and its mutex is released */
+	pthread_mutex_lock(&(pool.mutex));
+	FwRtRunPooled(rtDesc);
+	pthread_mutex_unlock(&(pool.mutex));
+	if ((rtData->apExecFuncBehaviourCounter != 1) || (FwRtGetContState(rtDesc) != rtMutexLockErr) ||
+	        (FwRtGetErrCode(rtDesc) == 0) || (pool.head != NULL))
+		return rtTestCaseFailure;
+	if (pthread_mutex_trylock(&(rtDesc->mutex)) != 0)
+		return rtTestCaseFailure;
+	pthread_mutex_unlock(&(rtDesc->mutex));
+
+	/* Shutdown the RT Container and the RT pool */
+	rtDesc->state = rtContStopped;
+	rtDesc->errCode = 0;
+	FwRtShutdown(rtDesc);
+	FwRtPoolShutdown(&pool);
+	if ((FwRtGetErrCode(rtDesc) != 0) || (FwRtPoolGetState(&pool) != rtContUninitialized))
+		return rtTestCaseFailure;
+
+	return rtTestCaseSuccess;
+}
+
+/*--------------------------------------------------------------------------*/
+void* TestCaseLockFree1_Notify(void* rtDesc) {
+	FwRtNotify((FwRtDesc_t)rtDesc);
+	return NULL;
+}
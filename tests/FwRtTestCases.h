@@ -308,4 +308,211 @@ FwRtTestOutcome_t FwRtTestCaseStressRun5();
  */
 FwRtTestOutcome_t FwRtTestCaseStressRun6();
 
+/**
+ * Verify the execution of several RT Containers by the worker threads of a RT Pool.
+ * This test case performs the following actions:
+ * - Initialize a RT Pool with two worker threads.
+ * - Instantiate and initialize six RT Containers RT6 attached to the pool (the actions
+ *   of these containers increment a counter and return the value of a settable flag).
+ * - Configure the RT Containers such that: (a) notifications always result in the functional
+ *   behaviour being executed and (b) functional behaviour never terminates.
+ * - Start the RT Containers and notify each of them five times.
+ * - Wait 10 ms and verify that all notifications have been processed.
+ * - Stop the RT Containers, wait until they have terminated, and check the value of their
+ *   counters.
+ * - Shut down the RT Containers and the RT Pool and check their states.
+ * .
+ * @return the success/failure code of the test case.
+ */
+FwRtTestOutcome_t FwRtTestCasePool1();
+
+/**
+ * Verify the termination and re-start of RT Containers executed by a RT Pool.
+ * This test case performs the following actions:
+ * - Initialize a RT Pool with one worker thread.
+ * - Instantiate and initialize two RT Containers RT6 attached to the pool.
+ * - Configure the first RT Container such that its functional behaviour terminates
+ *   at its first execution and the second one such that it never terminates.
+ * - Start both Containers, notify them, and wait until the first one has terminated.
+ * - Verify that the first RT Container is STOPPED and that the second one is still STARTED.
+ * - Re-start the first RT Container, notify it, stop both containers and wait
+ *   until they have terminated.
+ * - Check the counters of the containers and shut down the RT Containers and the RT Pool.
+ * .
+ * @return the success/failure code of the test case.
+ */
+FwRtTestOutcome_t FwRtTestCasePool2();
+
+/**
+ * Verify the logic of a RT Container in the lock-free notification mode.
+ * This test case performs the following actions:
+ * - Instantiate and initialize a RT Container RT1 and enable its lock-free
+ *   notification mode.
+ * - Configure the RT Container such that: (a) notifications always result in the functional
+ *   behaviour being executed and (b) functional behaviour never terminates.
+ * - Start the RT Container and notify it five consecutive times.
+ * - Wait 10 ms and check the state of the RT Container and its procedures.
+ * - Lock the container mutex, notify the RT Container from another thread and check
+ *   that the notification logic is executed and the Notification Counter is incremented
+ *   while the mutex is held but that the waiting Activation Thread is only woken up
+ *   once the mutex is released.
+ * - Stop the RT Container, wait until its Activation Thread has terminated and check
+ *   the container's counters.
+ * .
+ * @return the success/failure code of the test case.
+ */
+FwRtTestOutcome_t FwRtTestCaseLockFree1();
+
+/**
+ * Verify that no notification is lost in the lock-free notification mode.
+ * This test case performs the following actions:
+ * - Instantiate and initialize a RT Container RT1 and enable its lock-free
+ *   notification mode.
+ * - Start the RT Container and send it a long sequence of notifications, some of which
+ *   are separated by a delay so that the Activation Thread alternates between waiting
+ *   for notifications and processing them.
+ * - Wait until the Notification Counter is zero and check that the functional behaviour
+ *   has been executed once for each notification.
+ * - Stop the RT Container and wait until its Activation Thread has terminated.
+ * .
+ * @return the success/failure code of the test case.
+ */
+FwRtTestOutcome_t FwRtTestCaseLockFree2();
+
+/**
+ * Verify the coalescing of notifications without a coalescing delay.
+ * This test case performs the following actions:
+ * - Instantiate and initialize a RT Container RT2 (its functional behaviour takes 1 ms
+ *   to execute) and enable its notification coalescing mode with no delay.
+ * - Start the RT Container and notify it twenty consecutive times.
+ * - Wait until all notifications have been processed and verify that the functional
+ *   behaviour has been executed fewer times than the number of notifications but that
+ *   all notifications have been reported to it.
+ * - Stop the RT Container and wait until its Activation Thread has terminated.
+ * .
+ * @return the success/failure code of the test case.
+ */
+FwRtTestOutcome_t FwRtTestCaseCoalesce1();
+
+/**
+ * Verify the coalescing of notifications with a coalescing delay.
+ * This test case performs the following actions:
+ * - Instantiate and initialize a RT Container RT1 and enable its notification coalescing
+ *   mode with a delay of 20 ms.
+ * - Start the RT Container, notify it once, wait 5 ms, and notify it four more times.
+ * - Verify that the functional behaviour has not yet been executed and, after the
+ *   expiration of the coalescing delay, that it has been executed once for all five
+ *   notifications.
+ * - Notify the RT Container, stop it immediately, and verify that the stop request
+ *   cuts the coalescing delay short.
+ * .
+ * @return the success/failure code of the test case.
+ */
+FwRtTestOutcome_t FwRtTestCaseCoalesce2();
+
+/**
+ * Verify the periodic activation mode.
+ * This test case performs the following actions:
+ * - Instantiate and initialize a RT Container RT1 and enable its periodic activation
+ *   mode with a period of 5 ms and a phase of 20 ms.
+ * - Start the RT Container, notify it three times and verify that the functional
+ *   behaviour has not been executed before the end of the phase.
+ * - Wait 100 ms and verify that the functional behaviour has been executed about once
+ *   per period and that the three notifications have been consumed by it.
+ * - Stop the RT Container and wait until its Activation Thread has terminated.
+ * .
+ * @return the success/failure code of the test case.
+ */
+FwRtTestOutcome_t FwRtTestCasePeriodic1();
+
+/**
+ * Verify the deadline monitoring of the periodic activation mode.
+ * This test case performs the following actions:
+ * - Instantiate and initialize a RT Container RT2 (its functional behaviour takes 1 ms
+ *   to execute) and enable its periodic activation mode with a period of 200 us.
+ * - Start the RT Container, let it run for 20 ms and then stop it.
+ * - Verify that at least one overrun has been counted for each execution of the
+ *   functional behaviour and that its recorded worst-case execution time is at
+ *   least 1 ms.
+ * .
+ * @return the success/failure code of the test case.
+ */
+FwRtTestOutcome_t FwRtTestCasePeriodic2();
+
+/**
+ * Verify the real-time settings of the Activation Thread and of the container mutex.
+ * This test case performs the following actions:
+ * - Instantiate a RT Container RT1 and configure its Activation Thread with an explicit
+ *   scheduling policy (<code>SCHED_OTHER</code>, which requires no privileges), with
+ *   an affinity to processor 0 and with a caller-provided stack and configure its mutex
+ *   with the priority inheritance protocol.
+ * - Initialize the RT Container and verify that the settings have been applied to the
+ *   container's own attribute objects and that the stack has been prefaulted.
+ * - Verify that a configuration function called after initialization puts the container
+ *   in state <code>::rtConfigErr</code>.
+ * - Start the RT Container, notify it three times and verify that the Activation Thread
+ *   processes the notifications.
+ * - Stop the RT Container and wait until its Activation Thread has terminated.
+ * - Restart the RT Container with memory locking enabled and with a zero limit on the
+ *   amount of locked memory: if the memory cannot be locked (i.e. if the process has no
+ *   privilege to lock memory), verify that the container is in state
+ *   <code>::rtMemLockErr</code> and that its mutex has been released; otherwise, stop
+ *   the container again.
+ * .
+ * @return the success/failure code of the test case.
+ */
+FwRtTestOutcome_t FwRtTestCaseRtAttr1();
+
+/**
+ * Verify the latency instrumentation of the RT Container.
+ * This test case performs the following actions:
+ * - Instantiate and initialize a RT Container RT2 (its functional behaviour takes 1 ms
+ *   to execute).
+ * - Start the RT Container and notify it five times at intervals of 10 ms.
+ * - If the instrumentation is compiled in (symbol <code>FW_RT_STATS</code>), verify that
+ *   the latency histograms hold five wake-ups with a queue depth of one and five
+ *   execution times of at least 0.5 ms and that they can be reset.
+ * - If the instrumentation is not compiled in, verify that the histograms are empty.
+ * - Stop the RT Container and wait until its Activation Thread has terminated.
+ * .
+ * @return the success/failure code of the test case.
+ */
+FwRtTestOutcome_t FwRtTestCaseStats1();
+
+/**
+ * Verify the payload ring of the RT Container.
+ * This test case performs the following actions:
+ * - Verify that a payload ring whose number of slots is not a power of two is rejected
+ *   and that payloads cannot be passed to a container without a payload ring.
+ * - Instantiate a RT Container RT1 and re-initialize it with a payload ring of eight
+ *   slots and with a functional behaviour which takes all pending payloads.
+ * - Verify that the payload ring cannot be changed after initialization.
+ * - Verify that the ring holds eight payloads which are taken in the order in which
+ *   they were passed and that further payloads are rejected when the ring is full.
+ * - Start the RT Container and let two threads pass payloads to it concurrently.
+ * - Stop the RT Container, wait until its Activation Thread has terminated and verify
+ *   that all the payloads have been taken and that the payloads of each thread have
+ *   been taken in the order in which they were passed.
+ * .
+ * @return the success/failure code of the test case.
+ */
+FwRtTestOutcome_t FwRtTestCasePayload1();
+
+/**
+ * Verify that a pooled RT Container whose re-queueing fails releases its mutex.
+ * This test case performs the following actions:
+ * - Initialize a RT Pool without worker threads and replace its mutex with an
+ *   error-checking mutex (which reports a re-lock by the thread which owns it).
+ * - Instantiate, start and notify twice a RT Container RT6 attached to the pool and
+ *   empty the ready queue of the pool.
+ * - Execute the container with <code>::FwRtRunPooled</code> while holding the pool mutex
+ *   and verify that the Activation Procedure has been executed, that the container
+ *   could not be put back in the ready queue, that it is in state
+ *   <code>::rtMutexLockErr</code> and that its mutex has been released.
+ * - Shut down the RT Container and the RT Pool.
+ * .
+ * @return the success/failure code of the test case.
+ */
+FwRtTestOutcome_t FwRtTestCasePool3();
+
 #endif /* FWRT_TESTCASES_H_ */
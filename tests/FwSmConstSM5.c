@@ -0,0 +1,45 @@
+/*
+ * Code generated by FwSmGenerateConstBase.
+ * Constant base descriptor FwSmConstSM5 of a state machine with the following size:
+ * - number of states: 2
+ * - number of choice pseudo-states: 1
+ * - number of transitions: 7
+ * - number of actions: 4
+ * - number of guards: 2
+ * .
+ * The state machine is instantiated with FW_SM_INST_CONST(SM_DESC, FwSmConstSM5, 2, 4, 2).
+ */
+
+#include "FwSmPrivate.h"
+
+static const SmPState_t FwSmConstSM5_pState[2] = {
+  {1, 1, 2, 1, 3, 0, 0, 0},
+  {2, 3, 2, 1, 3, 0, 0, 0}
+};
+
+static const SmCState_t FwSmConstSM5_cState[1] = {
+  {5, 2}
+};
+
+static const SmTrans_t FwSmConstSM5_trans[7] = {
+  {1, 0, 4, 0},
+  {2, 12, 4, 1},
+  {-1, 20, 4, 0},
+  {0, 15, 4, 1},
+  {2, 14, 4, 1},
+  {1, 0, 4, 1},
+  {2, 0, 4, 2}
+};
+
+static const FwSmCounterS1_t FwSmConstSM5_disp[21] = {0, 1, 4, 3, 2, 5, 6, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
+
+const SmBaseDesc_t FwSmConstSM5 = {
+  (SmPState_t*)FwSmConstSM5_pState,
+  (SmCState_t*)FwSmConstSM5_cState,
+  (SmTrans_t*)FwSmConstSM5_trans,
+  2,
+  1,
+  7,
+  (FwSmCounterS1_t*)FwSmConstSM5_disp,
+  1
+};
@@ -0,0 +1,139 @@
+/*
+ * Code generated by FwSmGenerateCode.
+ * The functions with prefix FwSmGenSM5 are functionally equivalent to FwSmStart, FwSmStop,
+ * FwSmMakeTrans and FwSmExecute for a state machine with the following size:
+ * - number of states: 2
+ * - number of choice pseudo-states: 1
+ * - number of transitions: 7
+ * .
+ */
+
+#include "FwSmCore.h"
+#include "FwSmPrivate.h"
+
+void FwSmGenSM5Start(FwSmDesc_t smDesc);
+void FwSmGenSM5Stop(FwSmDesc_t smDesc);
+void FwSmGenSM5MakeTrans(FwSmDesc_t smDesc, FwSmCounterU2_t transId);
+void FwSmGenSM5Execute(FwSmDesc_t smDesc);
+
+/* ------------------------------------------------------------------------------- */
+static void FwSmGenSM5Trans0(FwSmDesc_t smDesc) {
+  smDesc->smActions[4](smDesc);
+  smDesc->curState     = 1;
+  smDesc->stateExecCnt = 0;
+  smDesc->smActions[2](smDesc);
+}
+
+/* ------------------------------------------------------------------------------- */
+static void FwSmGenSM5Trans1(FwSmDesc_t smDesc) {
+  smDesc->smActions[4](smDesc);
+  smDesc->curState     = 2;
+  smDesc->stateExecCnt = 0;
+  smDesc->smActions[2](smDesc);
+}
+
+/* ------------------------------------------------------------------------------- */
+static void FwSmGenSM5Trans2(FwSmDesc_t smDesc) {
+  smDesc->smActions[4](smDesc);
+  if (smDesc->smGuards[1](smDesc)) {
+    smDesc->smActions[4](smDesc);
+    smDesc->curState     = 1;
+    smDesc->stateExecCnt = 0;
+    smDesc->smActions[2](smDesc);
+    return;
+  }
+  if (smDesc->smGuards[2](smDesc)) {
+    smDesc->smActions[4](smDesc);
+    smDesc->curState     = 2;
+    smDesc->stateExecCnt = 0;
+    smDesc->smActions[2](smDesc);
+    return;
+  }
+  smDesc->errCode = smTransErr;
+}
+
+/* ------------------------------------------------------------------------------- */
+static void FwSmGenSM5Trans3(FwSmDesc_t smDesc) {
+  smDesc->smActions[4](smDesc);
+  smDesc->curState = 0;
+}
+
+/* ------------------------------------------------------------------------------- */
+static void FwSmGenSM5Trans4(FwSmDesc_t smDesc) {
+  smDesc->smActions[4](smDesc);
+  smDesc->curState     = 2;
+  smDesc->stateExecCnt = 0;
+  smDesc->smActions[2](smDesc);
+}
+
+/* ------------------------------------------------------------------------------- */
+void FwSmGenSM5Start(FwSmDesc_t smDesc) {
+  if (smDesc->curState != 0) {
+    return;
+  }
+  smDesc->smExecCnt    = 0;
+  smDesc->stateExecCnt = 0;
+  FwSmGenSM5Trans0(smDesc);
+}
+
+/* ------------------------------------------------------------------------------- */
+void FwSmGenSM5Stop(FwSmDesc_t smDesc) {
+  switch (smDesc->curState) {
+  case 1:
+    smDesc->smActions[3](smDesc);
+    break;
+  case 2:
+    smDesc->smActions[3](smDesc);
+    break;
+  default:
+    return;
+  }
+  smDesc->curState = 0;
+}
+
+/* ------------------------------------------------------------------------------- */
+void FwSmGenSM5MakeTrans(FwSmDesc_t smDesc, FwSmCounterU2_t transId) {
+  switch (smDesc->curState) {
+  case 1:
+    if (transId == FW_TR_EXECUTE) {
+      smDesc->smExecCnt++;
+      smDesc->stateExecCnt++;
+      smDesc->smActions[1](smDesc);
+    }
+    if ((transId == 12) && (smDesc->smGuards[1](smDesc))) {
+      smDesc->smActions[3](smDesc);
+      FwSmGenSM5Trans1(smDesc);
+      return;
+    }
+    break;
+  case 2:
+    if (transId == FW_TR_EXECUTE) {
+      smDesc->smExecCnt++;
+      smDesc->stateExecCnt++;
+      smDesc->smActions[1](smDesc);
+    }
+    if (transId == 20) {
+      smDesc->smActions[3](smDesc);
+      FwSmGenSM5Trans2(smDesc);
+      return;
+    }
+    if ((transId == 15) && (smDesc->smGuards[1](smDesc))) {
+      smDesc->smActions[3](smDesc);
+      FwSmGenSM5Trans3(smDesc);
+      return;
+    }
+    if ((transId == 14) && (smDesc->smGuards[1](smDesc))) {
+      smDesc->smActions[3](smDesc);
+      FwSmGenSM5Trans4(smDesc);
+      return;
+    }
+    break;
+  default:
+    break;
+  }
+}
+
+/* ------------------------------------------------------------------------------- */
+void FwSmGenSM5Execute(FwSmDesc_t smDesc) {
+  FwSmGenSM5MakeTrans(smDesc, FW_TR_EXECUTE);
+}
@@ -0,0 +1,148 @@
+/*
+ * Code generated by FwSmGenerateCode.
+ * The functions with prefix FwSmGenSM6 are functionally equivalent to FwSmStart, FwSmStop,
+ * FwSmMakeTrans and FwSmExecute for a state machine with the following size:
+ * - number of states: 2
+ * - number of choice pseudo-states: 0
+ * - number of transitions: 6
+ * .
+ */
+
+#include "FwSmCore.h"
+#include "FwSmPrivate.h"
+
+void FwSmGenSM6Start(FwSmDesc_t smDesc);
+void FwSmGenSM6Stop(FwSmDesc_t smDesc);
+void FwSmGenSM6MakeTrans(FwSmDesc_t smDesc, FwSmCounterU2_t transId);
+void FwSmGenSM6Execute(FwSmDesc_t smDesc);
+
+/* ------------------------------------------------------------------------------- */
+static void FwSmGenSM6Trans0(FwSmDesc_t smDesc) {
+  smDesc->smActions[4](smDesc);
+  smDesc->curState     = 1;
+  smDesc->stateExecCnt = 0;
+  smDesc->smActions[2](smDesc);
+}
+
+/* ------------------------------------------------------------------------------- */
+static void FwSmGenSM6Trans1(FwSmDesc_t smDesc) {
+  smDesc->smActions[4](smDesc);
+  smDesc->curState     = 2;
+  smDesc->stateExecCnt = 0;
+  smDesc->smActions[2](smDesc);
+  FwSmStart(smDesc->esmDesc[1]);
+}
+
+/* ------------------------------------------------------------------------------- */
+static void FwSmGenSM6Trans2(FwSmDesc_t smDesc) {
+  smDesc->smActions[4](smDesc);
+  smDesc->curState     = 1;
+  smDesc->stateExecCnt = 0;
+  smDesc->smActions[2](smDesc);
+}
+
+/* ------------------------------------------------------------------------------- */
+static void FwSmGenSM6Trans3(FwSmDesc_t smDesc) {
+  smDesc->smActions[4](smDesc);
+  smDesc->curState     = 1;
+  smDesc->stateExecCnt = 0;
+  smDesc->smActions[2](smDesc);
+}
+
+/* ------------------------------------------------------------------------------- */
+static void FwSmGenSM6Trans4(FwSmDesc_t smDesc) {
+  smDesc->smActions[4](smDesc);
+  smDesc->curState = 0;
+}
+
+/* ------------------------------------------------------------------------------- */
+static void FwSmGenSM6Trans5(FwSmDesc_t smDesc) {
+  smDesc->smActions[4](smDesc);
+  smDesc->curState     = 2;
+  smDesc->stateExecCnt = 0;
+  smDesc->smActions[2](smDesc);
+  FwSmStart(smDesc->esmDesc[1]);
+}
+
+/* ------------------------------------------------------------------------------- */
+void FwSmGenSM6Start(FwSmDesc_t smDesc) {
+  if (smDesc->curState != 0) {
+    return;
+  }
+  smDesc->smExecCnt    = 0;
+  smDesc->stateExecCnt = 0;
+  FwSmGenSM6Trans0(smDesc);
+}
+
+/* ------------------------------------------------------------------------------- */
+void FwSmGenSM6Stop(FwSmDesc_t smDesc) {
+  switch (smDesc->curState) {
+  case 1:
+    smDesc->smActions[3](smDesc);
+    break;
+  case 2:
+    FwSmStop(smDesc->esmDesc[1]);
+    smDesc->smActions[3](smDesc);
+    break;
+  default:
+    return;
+  }
+  smDesc->curState = 0;
+}
+
+/* ------------------------------------------------------------------------------- */
+void FwSmGenSM6MakeTrans(FwSmDesc_t smDesc, FwSmCounterU2_t transId) {
+  switch (smDesc->curState) {
+  case 1:
+    if (transId == FW_TR_EXECUTE) {
+      smDesc->smExecCnt++;
+      smDesc->stateExecCnt++;
+      smDesc->smActions[1](smDesc);
+    }
+    if ((transId == FW_TR_EXECUTE) && (smDesc->smGuards[1](smDesc))) {
+      smDesc->smActions[3](smDesc);
+      FwSmGenSM6Trans1(smDesc);
+      return;
+    }
+    break;
+  case 2:
+    if (transId == FW_TR_EXECUTE) {
+      smDesc->smExecCnt++;
+      smDesc->stateExecCnt++;
+      smDesc->smActions[1](smDesc);
+    }
+    FwSmMakeTrans(smDesc->esmDesc[1], transId);
+    if ((transId == FW_TR_EXECUTE) && (smDesc->smGuards[1](smDesc))) {
+      FwSmStop(smDesc->esmDesc[1]);
+      smDesc->smActions[3](smDesc);
+      FwSmGenSM6Trans2(smDesc);
+      return;
+    }
+    if ((transId == 20) && (smDesc->smGuards[1](smDesc))) {
+      FwSmStop(smDesc->esmDesc[1]);
+      smDesc->smActions[3](smDesc);
+      FwSmGenSM6Trans3(smDesc);
+      return;
+    }
+    if ((transId == 13) && (smDesc->smGuards[1](smDesc))) {
+      FwSmStop(smDesc->esmDesc[1]);
+      smDesc->smActions[3](smDesc);
+      FwSmGenSM6Trans4(smDesc);
+      return;
+    }
+    if ((transId == 14) && (smDesc->smGuards[1](smDesc))) {
+      FwSmStop(smDesc->esmDesc[1]);
+      smDesc->smActions[3](smDesc);
+      FwSmGenSM6Trans5(smDesc);
+      return;
+    }
+    break;
+  default:
+    break;
+  }
+}
+
+/* ------------------------------------------------------------------------------- */
+void FwSmGenSM6Execute(FwSmDesc_t smDesc) {
+  FwSmGenSM6MakeTrans(smDesc, FW_TR_EXECUTE);
+}
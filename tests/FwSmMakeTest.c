@@ -113,6 +113,24 @@ static void incrCnt1By8(FwSmDesc_t smDesc) {
 	fwSm_logIndex++;
 }
 
+/**
+ * Operation used as entry action in the state machines of <code>::FwSmMakeTestSMLarge</code>.
+ * This operation increments counter_1 by 1 but does not write to the log arrays.
+ * @param smDesc the state machine descriptor
+ */
+static void incrCnt1By1NoLog(FwSmDesc_t smDesc) {
+	GetTestSmData(smDesc)->counter_1++;
+}
+
+/**
+ * Operation used as transition action in the state machines of <code>::FwSmMakeTestSMLarge</code>.
+ * This operation increments counter_2 by 1 but does not write to the log arrays.
+ * @param smDesc the state machine descriptor
+ */
+static void incrCnt2By1NoLog(FwSmDesc_t smDesc) {
+	GetTestSmData(smDesc)->counter_2++;
+}
+
 /**
  * Operation used as state action in the test state machines.
  * This operation assigns the value of the State Machine
@@ -199,6 +217,25 @@ static FwSmBool_t smExecCntSmallerThan4(FwSmDesc_t smDesc) {
 	return (FwSmGetExecCnt(smDesc) < 4);
 }
 
+/**
+ * Configure a state machine with the topology of the state machines created by
+ * <code>::FwSmMakeTestSMLarge</code>.
+ * @param smDesc the state machine descriptor
+ * @param nOfStates the number of states in the state machine
+ * @param smData the data structure upon which the state machine operates
+ */
+static void ConfigTestSMLarge(FwSmDesc_t smDesc, FwSmCounterS1_t nOfStates, struct TestSmData* smData) {
+	FwSmCounterS1_t i;
+
+	FwSmSetData(smDesc, smData);
+	for (i=1; i<=nOfStates; i++)
+		FwSmAddState(smDesc, i, 1, &incrCnt1By1NoLog, NULL, NULL, NULL);
+	FwSmAddTransIpsToSta(smDesc, STATE_S1, &incrCnt2By1NoLog);
+	for (i=1; i<nOfStates; i++)
+		FwSmAddTransStaToSta(smDesc, TR1, i, (FwSmCounterS1_t)(i+1), &incrCnt2By1NoLog, NULL);
+	FwSmAddTransStaToSta(smDesc, TR1, nOfStates, STATE_S1, &incrCnt2By1NoLog, NULL);
+}
+
 struct TestSmData* GetTestSmData(FwSmDesc_t smDesc) {
 	return (struct TestSmData*)FwSmGetData(smDesc);
 }
@@ -454,6 +491,8 @@ FwSmDesc_t FwSmMakeTestSM5Dir(struct TestSmData* smData) {
 	smBase.nOfPStates = 2;
 	smBase.nOfCStates = 1;
 	smBase.nOfTrans = 7;
+	smBase.transDisp = NULL;
+	smBase.isCompiled = 0;
 	smDesc.smBase = &smBase;
 	smDesc.transCnt = 0;
 	smDesc.curState = 0;
@@ -880,3 +919,35 @@ FwSmDesc_t FwSmMakeTestSM16_3(struct TestSmData* smData) {
 
 	return p_sm;
 }
+
+/*-------------------------------------------------------------------------------------------------*/
+FwSmDesc_t FwSmMakeTestSMLarge(FwSmCounterS1_t nOfStates, struct TestSmData* smData) {
+	FwSmDesc_t p_sm;
+
+	/* Create the state machine */
+	p_sm = FwSmCreate(nOfStates, 0, (FwSmCounterS1_t)(nOfStates+1), 2, 0);
+	if (p_sm == NULL)
+		return NULL;
+
+	/* Configure the state machine */
+	ConfigTestSMLarge(p_sm, nOfStates, smData);
+	return p_sm;
+}
+
+/*-------------------------------------------------------------------------------------------------*/
+FwSmDesc_t FwSmMakeTestSMLargeArena(FwSmCounterS1_t nOfStates, void* buffer, FwSmCounterU4_t bufSize,
+                                    struct TestSmData* smData) {
+	FwSmDesc_t p_sm;
+
+	/* Create the state machine in its arena */
+	if (buffer == NULL)
+		p_sm = FwSmCreateArena(nOfStates, 0, (FwSmCounterS1_t)(nOfStates+1), 2, 0);
+	else
+		p_sm = FwSmCreateInBuffer(buffer, bufSize, nOfStates, 0, (FwSmCounterS1_t)(nOfStates+1), 2, 0);
+	if (p_sm == NULL)
+		return NULL;
+
+	/* Configure the state machine */
+	ConfigTestSMLarge(p_sm, nOfStates, smData);
+	return p_sm;
+}
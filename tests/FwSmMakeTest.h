@@ -77,6 +77,14 @@
  */
 #define LOG_ARRAY_SIZE 50
 
+/**
+ * Maximum number of states of the state machines created by <code>::FwSmMakeTestSMLarge</code>
+ * in the test cases.
+ * The limit keeps the size of the test state machines reasonable when the index types
+ * are 32 bits wide.
+ */
+#define LARGE_MAX_STATES 1000
+
 /**
  * Type for the state machine data for the test state machines.
  * This data structure defines <i>counters</i> and <i>flags</i>.
@@ -654,6 +662,105 @@ FwSmDesc_t FwSmMakeTestSM16_2(struct TestSmData* smData);
  */
 FwSmDesc_t FwSmMakeTestSM16_3(struct TestSmData* smData);
 
+/**
+ * Operation to create and configure a state machine with a configurable number
+ * of states.
+ * This state machine is intended to verify the behaviour of state machines whose size
+ * depends on the width of the <code>::FwSmCounterS1_t</code> type.
+ * This state machine has the following characteristics:
+ * - N states S1 to SN (N is given by the function argument).
+ * - No choice pseudo-states.
+ * - N+1 transitions:
+ *   -# from IPS to S1
+ *   -# from Si to S(i+1) (TR1 transition trigger) for i in [1,N-1]
+ *   -# from SN to S1 (TR1 transition trigger)
+ *   .
+ * - The entry action of all states increments <code>counter_1</code> by 1.
+ * - The transition actions increment <code>counter_2</code> by 1.
+ * - No guards.
+ * .
+ * Unlike the actions of the other test state machines, the actions of this state machine
+ * do not write to the log arrays (which only hold <code>#LOG_ARRAY_SIZE</code> entries).
+ * @param nOfStates the number of states N (a positive integer smaller than the
+ * maximum value of <code>::FwSmCounterS1_t</code>)
+ * @param smData the data structure upon which the state machine operates
+ * @return the descriptor of the created state machine or NULL if the creation
+ * of the state machine failed.
+ */
+FwSmDesc_t FwSmMakeTestSMLarge(FwSmCounterS1_t nOfStates, struct TestSmData* smData);
+
+/**
+ * Operation to create and configure in an arena a state machine with the same
+ * characteristics as the state machine created by <code>::FwSmMakeTestSMLarge</code>.
+ * If the buffer argument is NULL, the state machine is created with
+ * <code>::FwSmCreateArena</code>.
+ * Otherwise, it is created in the buffer with <code>::FwSmCreateInBuffer</code>.
+ * @param nOfStates the number of states N
+ * @param buffer the buffer where the state machine is created (or NULL)
+ * @param bufSize the size of the buffer in bytes
+ * @param smData the data structure upon which the state machine operates
+ * @return the descriptor of the created state machine or NULL if the creation
+ * of the state machine failed.
+ */
+FwSmDesc_t FwSmMakeTestSMLargeArena(FwSmCounterS1_t nOfStates, void* buffer, FwSmCounterU4_t bufSize,
+                                    struct TestSmData* smData);
+
+/**
+ * Function generated by <code>::FwSmGenerateCode</code> for state machine SM5 (see <code>::FwSmMakeTestSM5</code>)
+ * which is functionally equivalent to <code>::FwSmStart</code> (see <code>FwSmGenSM5.c</code>).
+ * @param smDesc the state machine descriptor
+ */
+void FwSmGenSM5Start(FwSmDesc_t smDesc);
+
+/**
+ * Function generated by <code>::FwSmGenerateCode</code> for state machine SM5 (see <code>::FwSmMakeTestSM5</code>)
+ * which is functionally equivalent to <code>::FwSmStop</code> (see <code>FwSmGenSM5.c</code>).
+ * @param smDesc the state machine descriptor
+ */
+void FwSmGenSM5Stop(FwSmDesc_t smDesc);
+
+/**
+ * Function generated by <code>::FwSmGenerateCode</code> for state machine SM5 (see <code>::FwSmMakeTestSM5</code>)
+ * which is functionally equivalent to <code>::FwSmMakeTrans</code> (see <code>FwSmGenSM5.c</code>).
+ * @param smDesc the state machine descriptor
+ * @param transId the identifier of the transition trigger
+ */
+void FwSmGenSM5MakeTrans(FwSmDesc_t smDesc, FwSmCounterU2_t transId);
+
+/**
+ * Function generated by <code>::FwSmGenerateCode</code> for state machine SM5 (see <code>::FwSmMakeTestSM5</code>)
+ * which is functionally equivalent to <code>::FwSmExecute</code> (see <code>FwSmGenSM5.c</code>).
+ * @param smDesc the state machine descriptor
+ */
+void FwSmGenSM5Execute(FwSmDesc_t smDesc);
+
+/**
+ * Function generated by <code>::FwSmGenerateCode</code> for state machine SM6 (see <code>::FwSmMakeTestSM6</code>)
+ * which is functionally equivalent to <code>::FwSmStart</code> (see <code>FwSmGenSM6.c</code>).
+ * @param smDesc the state machine descriptor
+ */
+void FwSmGenSM6Start(FwSmDesc_t smDesc);
+
+/**
+ * Function generated by <code>::FwSmGenerateCode</code> for state machine SM6 (see <code>::FwSmMakeTestSM6</code>)
+ * which is functionally equivalent to <code>::FwSmStop</code> (see <code>FwSmGenSM6.c</code>).
+ * @param smDesc the state machine descriptor
+ */
+void FwSmGenSM6Stop(FwSmDesc_t smDesc);
 
+/**
+ * Function generated by <code>::FwSmGenerateCode</code> for state machine SM6 (see <code>::FwSmMakeTestSM6</code>)
+ * which is functionally equivalent to <code>::FwSmMakeTrans</code> (see <code>FwSmGenSM6.c</code>).
+ * @param smDesc the state machine descriptor
+ * @param transId the identifier of the transition trigger
+ */
+void FwSmGenSM6MakeTrans(FwSmDesc_t smDesc, FwSmCounterU2_t transId);
+
+/**
+ * Function generated by <code>::FwSmGenerateCode</code> for state machine SM6 (see <code>::FwSmMakeTestSM6</code>)
+ * which is functionally equivalent to <code>::FwSmExecute</code> (see <code>FwSmGenSM6.c</code>).
+ * @param smDesc the state machine descriptor
+ */
+void FwSmGenSM6Execute(FwSmDesc_t smDesc);
 
 #endif /* FWSM_MAKETESTSM_H_ */
@@ -18,10 +18,28 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <stddef.h>
+#include <pthread.h>
+#include <sched.h>
 #include "FwSmConfig.h"
 #include "FwSmSCreate.h"
 #include "FwSmDCreate.h"
 #include "FwSmAux.h"
+#include "FwSmGroup.h"
+#include "FwSmPool.h"
+#include "FwSmQueue.h"
+#include "FwSmSnap.h"
+#include "FwSmFlat.h"
+#include "FwSmBcast.h"
+#include "FwSmNotify.h"
+#include "FwSmCost.h"
+#include "FwSmLazy.h"
+#include "FwSmAsync.h"
+#include "FwRtConfig.h"
+#include "FwRtCore.h"
+#include "FwSched.h"
+#include "FwTrace.h"
 #include "FwSmPrivate.h"
 #include "FwSmTestCases.h"
 #include "FwSmMakeTest.h"
@@ -2572,6 +2590,37 @@ FwSmTestOutcome_t FwSmTestCaseCheck22() {
 	return smTestCaseSuccess;
 }
 
+
+/*------------------------------------------------------------------------------------------------- */
+FwSmTestOutcome_t FwSmTestCaseCheck23() {
+	const FwSmCounterS1_t nOfPStates = 3;	/* number of proper states */
+	const FwSmCounterS1_t nOfCStates = 0;	/* number of choice pseudo-states */
+	const FwSmCounterS1_t nOfTrans = 3;		/* number of transitions */
+	const FwSmCounterS1_t nOfActions = 0;	/* number of actions */
+	const FwSmCounterS1_t nOfGuards = 0;	/* number of guards */
+	FwSmDesc_t smDesc;
+
+	/* Create and configure the test state machine (S2 and S3 only have transitions to each other) */
+	smDesc = FwSmCreate(nOfPStates, nOfCStates, nOfTrans, nOfActions, nOfGuards);
+	FwSmSetData(smDesc, NULL);
+
+	FwSmAddState(smDesc, STATE_S1, 0, NULL, NULL, NULL, NULL);
+	FwSmAddState(smDesc, STATE_S2, 1, NULL, NULL, NULL, NULL);
+	FwSmAddState(smDesc, STATE_S3, 1, NULL, NULL, NULL, NULL);
+
+	FwSmAddTransIpsToSta(smDesc, STATE_S1, NULL);
+	FwSmAddTransStaToSta(smDesc, TR1, STATE_S2, STATE_S3, NULL, NULL);
+	FwSmAddTransStaToSta(smDesc, TR1, STATE_S3, STATE_S2, NULL, NULL);
+
+	/* Check that configuration error is detected */
+	if (FwSmCheck(smDesc) != smDisconnectedPState) {
+		FwSmRelease(smDesc);
+		return smTestCaseFailure;
+	}
+
+	FwSmRelease(smDesc);
+	return smTestCaseSuccess;
+}
 /*------------------------------------------------------------------------------------------------- */
 FwSmTestOutcome_t FwSmTestCaseDescStatic3() {
 	struct TestSmData sSmData;
@@ -4123,3 +4172,3528 @@ FwSmTestOutcome_t FwSmTestCaseTrans8() {
 	FwSmRelease(smDesc3);
 	return smTestCaseSuccess;
 }
+
+/*------------------------------------------------------------------------------------------------- */
+FwSmTestOutcome_t FwSmTestCaseCompile1() {
+	struct TestSmData sSmData;
+	struct TestSmData* smData = &sSmData;
+	FwSmDesc_t smDesc[4];
+	FwSmCounterS1_t expS2[4] = {STATE_S2, STATE_S4, STATE_S3, STATE_S2};
+	FwSmCounterS1_t expS3[4] = {STATE_S3, STATE_S4, STATE_S3, STATE_S3};
+	FwSmCounterS1_t i;
+	FwSmTestOutcome_t outcome = smTestCaseSuccess;
+
+	/* Initialize data structure holding the state machine data */
+	smData->counter_1 = 0;
+	smData->counter_2 = 0;
+	smData->flag_1 = 1;
+	smData->flag_2 = 1;
+	smData->flag_3 = 1;
+	smData->logBase = 0;
+
+	/* Create and compile test SMs */
+	smDesc[0] = FwSmMakeTestSM16_1(smData);
+	smDesc[1] = FwSmMakeTestSM16_2(smData);
+	smDesc[2] = FwSmMakeTestSM16_3(smData);
+	if ((FwSmCompile(smDesc[0]) != smSuccess) || (FwSmCompile(smDesc[1]) != smSuccess) ||
+	        (FwSmCompile(smDesc[2]) != smSuccess)) {
+		FwSmRelease(smDesc[0]);
+		FwSmRelease(smDesc[1]);
+		FwSmRelease(smDesc[2]);
+		return smTestCaseFailure;
+	}
+
+	/* Create derived SM and check that it shares the dispatch table of its base */
+	smDesc[3] = FwSmCreateDer(smDesc[0]);
+	FwSmSetData(smDesc[3], smData);
+	if ((smDesc[3]->smBase->isCompiled == 0) || (smDesc[3]->smBase->transDisp != smDesc[0]->smBase->transDisp))
+		outcome = smTestCaseFailure;
+
+	/* Start SMs and send TR1 with all guards true */
+	for (i=0; i<4; i++) {
+		FwSmStart(smDesc[i]);
+		FwSmMakeTrans(smDesc[i], TR1);
+		if (FwSmGetCurState(smDesc[i]) != expS2[i])
+			outcome = smTestCaseFailure;
+	}
+
+	/* Restart SMs and send TR1 with flag_1 set to false */
+	smData->flag_1 = 0;
+	for (i=0; i<4; i++) {
+		FwSmStop(smDesc[i]);
+		FwSmStart(smDesc[i]);
+		FwSmMakeTrans(smDesc[i], TR1);
+		if (FwSmGetCurState(smDesc[i]) != expS3[i])
+			outcome = smTestCaseFailure;
+	}
+
+	/* Restart SMs and send TR3 (no transition) and TR2 (transition through CPS) */
+	for (i=0; i<4; i++) {
+		FwSmStop(smDesc[i]);
+		FwSmStart(smDesc[i]);
+		FwSmMakeTrans(smDesc[i], TR3);
+		if (FwSmGetCurState(smDesc[i]) != STATE_S1)
+			outcome = smTestCaseFailure;
+		FwSmMakeTrans(smDesc[i], TR2);
+		if (FwSmGetCurState(smDesc[i]) != expS3[i])
+			outcome = smTestCaseFailure;
+	}
+
+	FwSmReleaseDer(smDesc[3]);
+	FwSmRelease(smDesc[0]);
+	FwSmRelease(smDesc[1]);
+	FwSmRelease(smDesc[2]);
+	return outcome;
+}
+
+/*------------------------------------------------------------------------------------------------- */
+FwSmTestOutcome_t FwSmTestCaseCompile2() {
+	struct TestSmData sSmData1, sSmData2;
+	struct TestSmData* smData1 = &sSmData1;
+	struct TestSmData* smData2 = &sSmData2;
+	FwSmDesc_t smDesc1, smDesc2;
+	FwSmCounterU2_t trig[10] = {TR2, FW_TR_EXECUTE, TR4, TR3, TR6, FW_TR_EXECUTE, TR6, TR4, TR5, TR2};
+	int i;
+
+	/* Initialize data structures holding the state machine data */
+	smData1->counter_1 = 0;
+	smData1->counter_2 = 0;
+	smData1->flag_1 = 1;
+	smData1->flag_2 = 1;
+	smData1->flag_3 = 0;
+	smData1->logBase = 0;
+	*smData2 = *smData1;
+
+	/* Create test SMs and compile the directly initialized one */
+	smDesc1 = FwSmMakeTestSM5Dir(smData1);
+	smDesc2 = FwSmMakeTestSM5(smData2);
+	if ((FwSmCompile(smDesc1) != smSuccess) || (smDesc1->smBase->isCompiled == 0)) {
+		FwSmRelease(smDesc2);
+		return smTestCaseFailure;
+	}
+
+	/* Send the same triggers to both SMs and compare their state */
+	FwSmStart(smDesc1);
+	FwSmStart(smDesc2);
+	for (i=0; i<10; i++) {
+		if (i == 6) {
+			smData1->flag_1 = 0;
+			smData2->flag_1 = 0;
+		}
+		FwSmMakeTrans(smDesc1, trig[i]);
+		FwSmMakeTrans(smDesc2, trig[i]);
+		if ((FwSmGetCurState(smDesc1) != FwSmGetCurState(smDesc2)) ||
+		        (smData1->counter_1 != smData2->counter_1) || (smData1->counter_2 != smData2->counter_2) ||
+		        (FwSmGetStateExecCnt(smDesc1) != FwSmGetStateExecCnt(smDesc2))) {
+			free(smDesc1->smBase->transDisp);
+			FwSmRelease(smDesc2);
+			return smTestCaseFailure;
+		}
+	}
+
+	/* The dispatch table of the directly initialized SM was allocated by FwSmCompile */
+	free(smDesc1->smBase->transDisp);
+	FwSmRelease(smDesc2);
+	return smTestCaseSuccess;
+}
+
+/*------------------------------------------------------------------------------------------------- */
+FwSmTestOutcome_t FwSmTestCaseLarge1() {
+	struct TestSmData sSmData;
+	struct TestSmData* smData = &sSmData;
+	const FwSmCounterS1_t nOfStates = (FwSmCounterS1_t)((FW_SM_COUNTER_S1_MAX - 2 < LARGE_MAX_STATES) ?
+	                                  (FW_SM_COUNTER_S1_MAX - 2) : LARGE_MAX_STATES);
+	FwSmDesc_t smDesc;
+	FwSmCounterS1_t i;
+
+	/* Initialize data structures holding the state machine data */
+	smData->counter_1 = 0;
+	smData->counter_2 = 0;
+	smData->flag_1 = 0;
+	smData->flag_2 = 0;
+	smData->flag_3 = 0;
+	smData->logBase = 0;
+
+	/* Create and check the test SM */
+	smDesc = FwSmMakeTestSMLarge(nOfStates, smData);
+	if (smDesc == NULL)
+		return smTestCaseFailure;
+	if (FwSmCheck(smDesc) != smSuccess) {
+		FwSmRelease(smDesc);
+		return smTestCaseFailure;
+	}
+
+	/* Start the SM and take it once around its chain of states */
+	FwSmStart(smDesc);
+	for (i=0; i<nOfStates; i++)
+		FwSmMakeTrans(smDesc, TR1);
+
+	if ((FwSmGetCurState(smDesc) != STATE_S1) || (smData->counter_1 != nOfStates+1) ||
+	        (smData->counter_2 != nOfStates+1) || (FwSmGetErrCode(smDesc) != smSuccess)) {
+		FwSmRelease(smDesc);
+		return smTestCaseFailure;
+	}
+
+	FwSmRelease(smDesc);
+	return smTestCaseSuccess;
+}
+
+/*------------------------------------------------------------------------------------------------- */
+FwSmTestOutcome_t FwSmTestCaseArena1() {
+	struct TestSmData sSmData;
+	struct TestSmData* smData = &sSmData;
+	const FwSmCounterS1_t nOfStates = 5;
+	FwSmDesc_t smDesc, smDescDer;
+	unsigned char* arena;
+	unsigned char* disp;
+	FwSmCounterU4_t size;
+	FwSmCounterS1_t i;
+
+	/* Initialize data structures holding the state machine data */
+	smData->counter_1 = 0;
+	smData->counter_2 = 0;
+	smData->flag_1 = 0;
+	smData->flag_2 = 0;
+	smData->flag_3 = 0;
+	smData->logBase = 0;
+
+	/* Create the test SM and check its alignment */
+	smDesc = FwSmMakeTestSMLargeArena(nOfStates, NULL, 0, smData);
+	if (smDesc == NULL)
+		return smTestCaseFailure;
+	if (((FwSmCounterU4_t)smDesc) % FW_SM_ARENA_ALIGN != 0) {
+		FwSmReleaseArena(smDesc);
+		return smTestCaseFailure;
+	}
+
+	/* Compile the SM and check that the dispatch table lies within the arena */
+	size = FwSmGetArenaSize(nOfStates, 0, (FwSmCounterS1_t)(nOfStates+1), 2, 0);
+	arena = (unsigned char*)smDesc;
+	disp = (unsigned char*)smDesc->smBase->transDisp;
+	if ((FwSmCompile(smDesc) != smSuccess) || (disp < arena) || (disp >= arena + size)) {
+		FwSmReleaseArena(smDesc);
+		return smTestCaseFailure;
+	}
+
+	/* Create a derived SM and take both SMs once around their chain of states */
+	smDescDer = FwSmCreateDer(smDesc);
+	FwSmSetData(smDescDer, smData);
+	fwSm_logIndex = 0;
+	FwSmStart(smDesc);
+	FwSmStart(smDescDer);
+	for (i=0; i<nOfStates; i++) {
+		FwSmMakeTrans(smDesc, TR1);
+		FwSmMakeTrans(smDescDer, TR1);
+	}
+	if ((FwSmGetCurState(smDesc) != STATE_S1) || (FwSmGetCurState(smDescDer) != STATE_S1) ||
+	        (smData->counter_1 != 2*(nOfStates+1)) || (smData->counter_2 != 2*(nOfStates+1)) ||
+	        (fwSm_logIndex != 0)) {
+		FwSmReleaseDer(smDescDer);
+		FwSmReleaseArena(smDesc);
+		return smTestCaseFailure;
+	}
+
+	FwSmReleaseDer(smDescDer);
+	FwSmReleaseArena(smDesc);
+	return smTestCaseSuccess;
+}
+
+/*------------------------------------------------------------------------------------------------- */
+FwSmTestOutcome_t FwSmTestCaseArena2() {
+	struct TestSmData sSmData;
+	struct TestSmData* smData = &sSmData;
+	const FwSmCounterS1_t nOfStates = 5;
+	static unsigned char buffer[2048];
+	FwSmDesc_t smDesc;
+	FwSmCounterU4_t size;
+	FwSmCounterS1_t i;
+
+	/* Initialize data structures holding the state machine data */
+	smData->counter_1 = 0;
+	smData->counter_2 = 0;
+	smData->flag_1 = 0;
+	smData->flag_2 = 0;
+	smData->flag_3 = 0;
+	smData->logBase = 0;
+
+	/* Check the arena size and the creation with illegal parameters */
+	size = FwSmGetArenaSize(nOfStates, 0, (FwSmCounterS1_t)(nOfStates+1), 2, 0);
+	if ((size == 0) || (size > sizeof(buffer)-1))
+		return smTestCaseFailure;
+	if (FwSmGetArenaSize(nOfStates, 0, 0, 2, 0) != 0)
+		return smTestCaseFailure;
+	if (FwSmCreateInBuffer(buffer, size, nOfStates, 0, 0, 2, 0) != NULL)
+		return smTestCaseFailure;
+	if (FwSmCreateInBuffer(NULL, size, nOfStates, 0, (FwSmCounterS1_t)(nOfStates+1), 2, 0) != NULL)
+		return smTestCaseFailure;
+	if (FwSmCreateInBuffer(buffer, size-1, nOfStates, 0, (FwSmCounterS1_t)(nOfStates+1), 2, 0) != NULL)
+		return smTestCaseFailure;
+
+	/* Create the test SM in a buffer which is not aligned */
+	smDesc = FwSmMakeTestSMLargeArena(nOfStates, buffer+1, size, smData);
+	if (smDesc == NULL)
+		return smTestCaseFailure;
+	if ((((FwSmCounterU4_t)smDesc) % FW_SM_ARENA_ALIGN != 0) || ((unsigned char*)smDesc <= buffer) ||
+	        ((unsigned char*)smDesc >= buffer+1+size))
+		return smTestCaseFailure;
+	if ((FwSmCheck(smDesc) != smSuccess) || (FwSmCompile(smDesc) != smSuccess))
+		return smTestCaseFailure;
+
+	/* Take the SM once around its chain of states */
+	fwSm_logIndex = 0;
+	FwSmStart(smDesc);
+	for (i=0; i<nOfStates; i++)
+		FwSmMakeTrans(smDesc, TR1);
+	if ((FwSmGetCurState(smDesc) != STATE_S1) || (smData->counter_1 != nOfStates+1) ||
+	        (smData->counter_2 != nOfStates+1) || (fwSm_logIndex != 0))
+		return smTestCaseFailure;
+
+	/* The SM is not released because its memory is owned by the caller */
+	return smTestCaseSuccess;
+}
+
+/*------------------------------------------------------------------------------------------------- */
+FwSmTestOutcome_t FwSmTestCaseNesting1() {
+	struct TestSmData sSmData;
+	struct TestSmData* smData = &sSmData;
+	FwSmDesc_t smBaseDesc[FW_SM_MAX_NESTING+4];
+	FwSmDesc_t smDesc[FW_SM_MAX_NESTING+4];
+	const int nOfLevels = FW_SM_MAX_NESTING+4;
+	FwSmTestOutcome_t outcome = smTestCaseSuccess;
+	int i;
+
+	/* Initialize data structures holding the state machine data */
+	smData->counter_1 = 0;
+	smData->counter_2 = 0;
+	smData->flag_1 = 0;
+	smData->flag_2 = 0;
+	smData->flag_3 = 0;
+	smData->logBase = 0;
+
+	/* Create the chain of SMs (SMs can only be embedded in derived SMs) */
+	for (i=0; i<nOfLevels; i++) {
+		smBaseDesc[i] = FwSmMakeTestSMLarge(2, smData);
+		smDesc[i] = FwSmCreateDer(smBaseDesc[i]);
+		FwSmSetData(smDesc[i], smData);
+		if (i > 0)
+			FwSmEmbed(smDesc[i-1], STATE_S1, smDesc[i]);
+	}
+
+	/* Start the chain and check that all SMs are in state S1 */
+	FwSmStart(smDesc[0]);
+	for (i=0; i<nOfLevels; i++)
+		if (FwSmGetCurState(smDesc[i]) != STATE_S1)
+			outcome = smTestCaseFailure;
+	if ((smData->counter_1 != nOfLevels) || (smData->counter_2 != nOfLevels))
+		outcome = smTestCaseFailure;
+
+	/* Execute the chain and check that all SMs have been executed */
+	FwSmExecute(smDesc[0]);
+	for (i=0; i<nOfLevels; i++)
+		if ((FwSmGetExecCnt(smDesc[i]) != 1) || (FwSmGetStateExecCnt(smDesc[i]) != 1))
+			outcome = smTestCaseFailure;
+
+	/* Send TR1: all SMs move to S2 and all SMs but the top-level one are stopped */
+	FwSmMakeTrans(smDesc[0], TR1);
+	if (FwSmGetCurState(smDesc[0]) != STATE_S2)
+		outcome = smTestCaseFailure;
+	for (i=1; i<nOfLevels; i++)
+		if (FwSmIsStarted(smDesc[i]) != 0)
+			outcome = smTestCaseFailure;
+	if ((smData->counter_1 != 2*nOfLevels) || (smData->counter_2 != 2*nOfLevels))
+		outcome = smTestCaseFailure;
+
+	/* Stop the top-level SM and release the SMs */
+	FwSmStop(smDesc[0]);
+	if (FwSmIsStarted(smDesc[0]) != 0)
+		outcome = smTestCaseFailure;
+	for (i=0; i<nOfLevels; i++) {
+		FwSmReleaseDer(smDesc[i]);
+		FwSmRelease(smBaseDesc[i]);
+	}
+
+	return outcome;
+}
+
+/*------------------------------------------------------------------------------------------------- */
+FwSmTestOutcome_t FwSmTestCaseBatch1() {
+	struct TestSmData sSmData;
+	struct TestSmData* smData = &sSmData;
+	FwSmCounterU2_t trig[8] = {TR1, FW_TR_EXECUTE, TR2, TR1, FW_TR_EXECUTE, TR1, TR3, TR1};
+	FwSmDesc_t smDesc;
+
+	/* Initialize data structures holding the state machine data */
+	smData->counter_1 = 0;
+	smData->counter_2 = 0;
+	smData->flag_1 = 0;
+	smData->flag_2 = 0;
+	smData->flag_3 = 0;
+	smData->logBase = 0;
+
+	/* Create and start the test SM */
+	smDesc = FwSmMakeTestSMLarge(3, smData);
+	if (smDesc == NULL)
+		return smTestCaseFailure;
+	FwSmStart(smDesc);
+
+	/* Only the four TR1 triggers cause a transition (S1 to S2, S2 to S3, S3 to S1 and S1 to S2) */
+	if (FwSmMakeTransBatch(smDesc, trig, 8) != 4) {
+		FwSmRelease(smDesc);
+		return smTestCaseFailure;
+	}
+	if ((FwSmGetCurState(smDesc) != STATE_S2) || (smData->counter_1 != 5) || (smData->counter_2 != 5) ||
+	        (FwSmGetExecCnt(smDesc) != 2) || (FwSmGetStateExecCnt(smDesc) != 0)) {
+		FwSmRelease(smDesc);
+		return smTestCaseFailure;
+	}
+
+	/* A batch without triggers and a batch sent to a stopped SM have no effect */
+	if (FwSmMakeTransBatch(smDesc, trig, 0) != 0) {
+		FwSmRelease(smDesc);
+		return smTestCaseFailure;
+	}
+	FwSmStop(smDesc);
+	if ((FwSmMakeTransBatch(smDesc, trig, 8) != 0) || (FwSmGetExecCnt(smDesc) != 2)) {
+		FwSmRelease(smDesc);
+		return smTestCaseFailure;
+	}
+
+	FwSmRelease(smDesc);
+	return smTestCaseSuccess;
+}
+
+/*------------------------------------------------------------------------------------------------- */
+FwSmTestOutcome_t FwSmTestCaseBatch2() {
+	struct TestSmData sSmData;
+	struct TestSmData* smData = &sSmData;
+	FwSmDesc_t smBaseDesc[FW_SM_MAX_NESTING+4];
+	FwSmDesc_t smDesc[FW_SM_MAX_NESTING+4];
+	FwSmCounterU2_t trig[5] = {FW_TR_EXECUTE, TR2, FW_TR_EXECUTE, TR1, FW_TR_EXECUTE};
+	const int nOfLevels = FW_SM_MAX_NESTING+4;
+	FwSmTestOutcome_t outcome = smTestCaseSuccess;
+	int i;
+
+	/* Initialize data structures holding the state machine data */
+	smData->counter_1 = 0;
+	smData->counter_2 = 0;
+	smData->flag_1 = 0;
+	smData->flag_2 = 0;
+	smData->flag_3 = 0;
+	smData->logBase = 0;
+
+	/* Create and start the chain of SMs (SMs can only be embedded in derived SMs) */
+	for (i=0; i<nOfLevels; i++) {
+		smBaseDesc[i] = FwSmMakeTestSMLarge(2, smData);
+		smDesc[i] = FwSmCreateDer(smBaseDesc[i]);
+		FwSmSetData(smDesc[i], smData);
+		if (i > 0)
+			FwSmEmbed(smDesc[i-1], STATE_S1, smDesc[i]);
+	}
+	FwSmStart(smDesc[0]);
+
+	/* Only the TR1 trigger causes transitions: all SMs move to S2 and the embedded SMs are stopped */
+	if (FwSmMakeTransBatch(smDesc[0], trig, 5) != 1)
+		outcome = smTestCaseFailure;
+	if ((FwSmGetCurState(smDesc[0]) != STATE_S2) || (FwSmGetExecCnt(smDesc[0]) != 3) ||
+	        (FwSmGetStateExecCnt(smDesc[0]) != 1))
+		outcome = smTestCaseFailure;
+	for (i=1; i<nOfLevels; i++)
+		if ((FwSmIsStarted(smDesc[i]) != 0) || (FwSmGetExecCnt(smDesc[i]) != 2))
+			outcome = smTestCaseFailure;
+	if ((smData->counter_1 != 2*nOfLevels) || (smData->counter_2 != 2*nOfLevels))
+		outcome = smTestCaseFailure;
+
+	/* Release the SMs */
+	for (i=0; i<nOfLevels; i++) {
+		FwSmReleaseDer(smDesc[i]);
+		FwSmRelease(smBaseDesc[i]);
+	}
+
+	return outcome;
+}
+
+/*------------------------------------------------------------------------------------------------- */
+FwSmTestOutcome_t FwSmTestCaseGroup1() {
+	struct TestSmData sSmData[4];
+	FwSmDesc_t smDesc[4];
+	FwSmDesc_t smDescOther;
+	FwSmGroupDesc_t group;
+	FwSmTestOutcome_t outcome = smTestCaseSuccess;
+	int i;
+
+	/* Initialize data structures holding the state machine data */
+	for (i=0; i<4; i++) {
+		sSmData[i].counter_1 = 0;
+		sSmData[i].counter_2 = 0;
+		sSmData[i].flag_1 = 0;
+		sSmData[i].flag_2 = 0;
+		sSmData[i].flag_3 = 0;
+		sSmData[i].logBase = 0;
+	}
+
+	/* Create a base SM, three SMs derived from it and an unrelated SM */
+	smDesc[0] = FwSmMakeTestSMLarge(2, &sSmData[0]);
+	for (i=1; i<4; i++) {
+		smDesc[i] = FwSmCreateDer(smDesc[0]);
+		FwSmSetData(smDesc[i], &sSmData[i]);
+	}
+	smDescOther = FwSmMakeTestSMLarge(2, &sSmData[0]);
+
+	/* Create the group and fill it */
+	if (FwSmGroupCreate(smDesc[0], 0) != NULL)
+		outcome = smTestCaseFailure;
+	group = FwSmGroupCreate(smDesc[0], 4);
+	if (group == NULL)
+		return smTestCaseFailure;
+	if (FwSmGroupAdd(group, smDescOther) != smWrongBase)
+		outcome = smTestCaseFailure;
+	for (i=0; i<4; i++)
+		if (FwSmGroupAdd(group, smDesc[i]) != smSuccess)
+			outcome = smTestCaseFailure;
+	if ((FwSmGroupAdd(group, smDesc[0]) != smGroupFull) || (FwSmGroupGetNOfSms(group) != 4))
+		outcome = smTestCaseFailure;
+
+	/* Start the group, stop one of its SMs, move another SM to S2 and execute the group twice */
+	FwSmGroupStart(group);
+	FwSmStop(smDesc[2]);
+	FwSmMakeTrans(smDesc[3], TR1);
+	FwSmGroupExecute(group);
+	FwSmGroupExecute(group);
+	for (i=0; i<4; i++) {
+		if (i == 2) {
+			if ((FwSmIsStarted(smDesc[i]) != 0) || (FwSmGetExecCnt(smDesc[i]) != 0))
+				outcome = smTestCaseFailure;
+		}
+		else if ((FwSmGetExecCnt(smDesc[i]) != 2) || (FwSmGetStateExecCnt(smDesc[i]) != 2))
+			outcome = smTestCaseFailure;
+	}
+	if ((FwSmGetCurState(smDesc[0]) != STATE_S1) || (FwSmGetCurState(smDesc[3]) != STATE_S2))
+		outcome = smTestCaseFailure;
+
+	FwSmGroupRelease(group);
+	for (i=1; i<4; i++)
+		FwSmReleaseDer(smDesc[i]);
+	FwSmRelease(smDesc[0]);
+	FwSmRelease(smDescOther);
+	return outcome;
+}
+
+/*------------------------------------------------------------------------------------------------- */
+FwSmTestOutcome_t FwSmTestCaseGroup2() {
+	struct TestSmData sSmData1[3], sSmData2[3];
+	FwSmDesc_t smDesc1[3], smDesc2[3];
+	FwSmGroupDesc_t group;
+	FwSmTestOutcome_t outcome = smTestCaseSuccess;
+	FwTraceEvent_t events[4];
+	FwTraceEvent_t drained[4];
+	struct FwTraceRing ring;
+	FwTraceCounterU4_t n, k;
+	int i, j;
+
+	/* Initialize data structures holding the state machine data (the first SM never changes state) */
+	for (i=0; i<3; i++) {
+		sSmData1[i].counter_1 = 0;
+		sSmData1[i].counter_2 = 0;
+		sSmData1[i].flag_1 = (i > 0);
+		sSmData1[i].flag_2 = 0;
+		sSmData1[i].flag_3 = 0;
+		sSmData1[i].logBase = 0;
+		sSmData2[i] = sSmData1[i];
+	}
+
+	/* Create two sets of SMs: a base SM and two SMs derived from it */
+	smDesc1[0] = FwSmMakeTestSM4(&sSmData1[0]);
+	smDesc2[0] = FwSmMakeTestSM4(&sSmData2[0]);
+	for (i=1; i<3; i++) {
+		smDesc1[i] = FwSmCreateDer(smDesc1[0]);
+		FwSmSetData(smDesc1[i], &sSmData1[i]);
+		smDesc2[i] = FwSmCreateDer(smDesc2[0]);
+		FwSmSetData(smDesc2[i], &sSmData2[i]);
+	}
+
+	/* Put the first set in a group */
+	group = FwSmGroupCreate(smDesc1[0], 3);
+	if (group == NULL)
+		return smTestCaseFailure;
+	for (i=0; i<3; i++)
+		FwSmGroupAdd(group, smDesc1[i]);
+
+	/* Execute the first set as a group and the second set individually (by replaying the commands
+	 * recorded during the group execution if the tracing hooks are compiled in) */
+	FwSmGroupStart(group);
+	for (i=0; i<3; i++)
+		FwSmStart(smDesc2[i]);
+	FwTraceRingInit(&ring, events, 4);
+	FwTraceSetMask(&ring, FW_TRACE_MASK_CMDS);
+	for (j=0; j<5; j++) {
+		fwSm_logIndex = 0;
+		FwTraceSetRing(&ring);
+		FwSmGroupExecute(group);
+		FwTraceSetRing(NULL);
+		n = FwTraceDrain(&ring, drained, 4);
+#ifdef FW_TRACE
+		if (n != 3)
+			outcome = smTestCaseFailure;
+		for (k=0; k<n; k++)
+			for (i=0; i<3; i++)
+				if ((drained[k].type == traceSmExecuteCmd) && (drained[k].desc == smDesc1[i]))
+					FwSmExecute(smDesc2[i]);
+#else
+		if (n != 0)
+			outcome = smTestCaseFailure;
+		for (i=0; i<3; i++)
+			FwSmExecute(smDesc2[i]);
+#endif
+		for (i=0; i<3; i++)
+			if ((FwSmGetCurState(smDesc1[i]) != FwSmGetCurState(smDesc2[i])) ||
+			        (sSmData1[i].counter_1 != sSmData2[i].counter_1) ||
+			        (sSmData1[i].counter_2 != sSmData2[i].counter_2) ||
+			        (FwSmGetExecCnt(smDesc1[i]) != FwSmGetExecCnt(smDesc2[i])) ||
+			        (FwSmGetStateExecCnt(smDesc1[i]) != FwSmGetStateExecCnt(smDesc2[i])))
+				outcome = smTestCaseFailure;
+	}
+	if ((FwSmGetCurState(smDesc1[1]) != STATE_S2) || (FwSmGetCurState(smDesc1[0]) != STATE_S1))
+		outcome = smTestCaseFailure;
+
+	FwSmGroupRelease(group);
+	for (i=1; i<3; i++) {
+		FwSmReleaseDer(smDesc1[i]);
+		FwSmReleaseDer(smDesc2[i]);
+	}
+	FwSmRelease(smDesc1[0]);
+	FwSmRelease(smDesc2[0]);
+	return outcome;
+}
+
+/*------------------------------------------------------------------------------------------------- */
+FwSmTestOutcome_t FwSmTestCaseTrace1() {
+	struct TestSmData sSmData;
+	struct TestSmData* smData = &sSmData;
+	static FwTraceEvent_t events[4];
+	FwTraceEvent_t drained[8];
+	struct FwTraceRing ring;
+	FwSmDesc_t smDesc;
+	int i;
+
+	/* Initialize data structures holding the state machine data */
+	smData->counter_1 = 0;
+	smData->counter_2 = 0;
+	smData->flag_1 = 1;
+	smData->flag_2 = 0;
+	smData->flag_3 = 0;
+	smData->logBase = 0;
+
+	/* A ring buffer whose size is not a power of two is rejected */
+	if ((FwTraceRingInit(&ring, events, 3) != 0) || (FwTraceRingInit(&ring, events, 0) != 0))
+		return smTestCaseFailure;
+	if (FwTraceRingInit(&ring, events, 4) != 1)
+		return smTestCaseFailure;
+
+	/* Events are only recorded for threads which have a ring buffer and are dropped when the ring buffer is full */
+	FwTraceRecord(traceSmStateEntry, NULL, 1, 0);
+	FwTraceSetRing(&ring);
+	if (FwTraceGetRing() != &ring) {
+		FwTraceSetRing(NULL);
+		return smTestCaseFailure;
+	}
+	for (i = 0; i < 5; i++)
+		FwTraceRecord(traceSmStateEntry, NULL, i, 0);
+	if ((FwTraceDrain(&ring, drained, 2) != 2) || (drained[0].id != 0) || (drained[1].id != 1) ||
+	        (FwTraceDrain(&ring, drained, 8) != 2) || (drained[1].id != 3) || (drained[1].time != 0) ||
+	        (FwTraceGetNOfDropped(&ring) != 1)) {
+		FwTraceSetRing(NULL);
+		return smTestCaseFailure;
+	}
+
+	/* Create the test SM and take it from S1 to the final pseudo-state */
+	smDesc = FwSmMakeTestSM1(smData);
+	if (smDesc == NULL) {
+		FwTraceSetRing(NULL);
+		return smTestCaseFailure;
+	}
+	FwSmStart(smDesc);
+	FwSmExecute(smDesc);
+	FwSmMakeTrans(smDesc, TR_S1_FPS);
+	FwTraceSetRing(NULL);
+	if ((FwSmIsStarted(smDesc) != 0) || (smData->counter_1 != 3)) {
+		FwSmRelease(smDesc);
+		return smTestCaseFailure;
+	}
+
+#ifdef FW_TRACE
+	/* Entry into S1, do-action of S1, guard of TR_S1_FPS and exit from S1 (the transition event is dropped) */
+	if ((FwTraceDrain(&ring, drained, 8) != 4) || (FwTraceGetNOfDropped(&ring) != 2) ||
+	        (drained[0].type != traceSmStateEntry) || (drained[0].id != STATE_S1) || (drained[0].desc != smDesc) ||
+	        (drained[1].type != traceSmDoAction) || (drained[1].id != STATE_S1) ||
+	        (drained[2].type != traceSmGuard) || (drained[2].id != TR_S1_FPS) || (drained[2].value != 1) ||
+	        (drained[3].type != traceSmStateExit) || (drained[3].id != STATE_S1)) {
+		FwSmRelease(smDesc);
+		return smTestCaseFailure;
+	}
+#else
+	/* With the tracing hooks compiled out, the state machine records no events */
+	if ((FwTraceDrain(&ring, drained, 8) != 0) || (FwTraceGetNOfDropped(&ring) != 1)) {
+		FwSmRelease(smDesc);
+		return smTestCaseFailure;
+	}
+#endif
+
+	/* A ring buffer whose mask selects the command events only records the commands of the application */
+	FwTraceRingInit(&ring, events, 4);
+	FwTraceSetMask(&ring, FW_TRACE_MASK_CMDS);
+	FwTraceSetRing(&ring);
+	FwSmStart(smDesc);
+	FwSmExecute(smDesc);
+	FwSmMakeTrans(smDesc, TR_S1_FPS);
+	FwTraceSetRing(NULL);
+#ifdef FW_TRACE
+	if ((FwTraceDrain(&ring, drained, 8) != 2) || (FwTraceGetNOfDropped(&ring) != 0) ||
+	        (drained[0].type != traceSmExecuteCmd) || (drained[0].desc != smDesc) ||
+	        (drained[1].type != traceSmMakeTransCmd) || (drained[1].id != TR_S1_FPS)) {
+		FwSmRelease(smDesc);
+		return smTestCaseFailure;
+	}
+#else
+	if (FwTraceDrain(&ring, drained, 8) != 0) {
+		FwSmRelease(smDesc);
+		return smTestCaseFailure;
+	}
+#endif
+
+	FwSmRelease(smDesc);
+	return smTestCaseSuccess;
+}
+
+/**
+ * Clock function used by the profiling test cases: each call advances the time by 10 units.
+ * @return the current time
+ */
+static FwSmCounterU4_t SmProfileTestClock() {
+	static FwSmCounterU4_t time = 0;
+	time = time + 10;
+	return time;
+}
+
+/*------------------------------------------------------------------------------------------------- */
+FwSmTestOutcome_t FwSmTestCaseProfile1() {
+	struct TestSmData sSmData;
+	struct TestSmData* smData = &sSmData;
+	FwSmDesc_t smDesc, smDescDer;
+	FwSmCounterS1_t iTrans;
+	FILE* outfile;
+
+	/* Initialize data structures holding the state machine data */
+	smData->counter_1 = 0;
+	smData->counter_2 = 0;
+	smData->flag_1 = 0;
+	smData->flag_2 = 0;
+	smData->flag_3 = 0;
+	smData->logBase = 0;
+
+	/* Create the test SM and enable profiling on it */
+	smDesc = FwSmMakeTestSM1(smData);
+	if ((smDesc == NULL) || (smDesc->profile != NULL))
+		return smTestCaseFailure;
+	FwSmEnableProfile(smDesc, &SmProfileTestClock);
+	if ((smDesc->profile == NULL) || (FwSmGetErrCode(smDesc) != smSuccess)) {
+		FwSmRelease(smDesc);
+		return smTestCaseFailure;
+	}
+
+	/* The profiling data are not inherited by derived state machines */
+	smDescDer = FwSmCreateDer(smDesc);
+	if ((smDescDer == NULL) || (smDescDer->profile != NULL)) {
+		FwSmRelease(smDesc);
+		return smTestCaseFailure;
+	}
+	FwSmReleaseDer(smDescDer);
+
+	/* Start the SM, execute it and send it the TR_S1_FPS trigger with a false and then a true guard */
+	iTrans = smDesc->smBase->pStates[STATE_S1-1].outTransIndex;
+	FwSmStart(smDesc);
+	FwSmExecute(smDesc);
+	FwSmExecute(smDesc);
+	FwSmMakeTrans(smDesc, TR_S1_FPS);
+	smData->flag_1 = 1;
+	FwSmMakeTrans(smDesc, TR_S1_FPS);
+	if ((FwSmIsStarted(smDesc) != 0) || (smDesc->profile->transFireCnt[0] != 1) ||
+	        (smDesc->profile->stateEntryCnt[STATE_S1-1] != 1) || (smDesc->profile->stateDwell[STATE_S1-1] != 10) ||
+	        (smDesc->profile->transFireCnt[iTrans] != 1) || (smDesc->profile->guardTrueCnt[iTrans] != 1) ||
+	        (smDesc->profile->guardFalseCnt[iTrans] != 1)) {
+		FwSmRelease(smDesc);
+		return smTestCaseFailure;
+	}
+
+	/* Print the profile report (the guard of TR_S1_FPS is not false more often than true) */
+	outfile = tmpfile();
+	if (outfile != NULL) {
+		FwSmPrintProfile(smDesc, outfile);
+		fclose(outfile);
+	}
+
+	/* Reset and disable profiling */
+	FwSmResetProfile(smDesc);
+	if ((smDesc->profile->transFireCnt[0] != 0) || (smDesc->profile->stateDwell[STATE_S1-1] != 0)) {
+		FwSmRelease(smDesc);
+		return smTestCaseFailure;
+	}
+	FwSmDisableProfile(smDesc);
+	FwSmStart(smDesc);
+	if ((smDesc->profile != NULL) || (FwSmGetCurState(smDesc) != STATE_S1)) {
+		FwSmRelease(smDesc);
+		return smTestCaseFailure;
+	}
+
+	FwSmRelease(smDesc);
+	return smTestCaseSuccess;
+}
+
+/**
+ * Action used by the configuration index test cases.
+ * @param smDesc the state machine descriptor
+ */
+static void SmCfgIndexAction1(FwSmDesc_t smDesc) {
+	(void)smDesc;
+}
+
+/**
+ * Action used by the configuration index test cases.
+ * @param smDesc the state machine descriptor
+ */
+static void SmCfgIndexAction2(FwSmDesc_t smDesc) {
+	(void)smDesc;
+}
+
+/**
+ * Action used by the configuration index test cases.
+ * @param smDesc the state machine descriptor
+ */
+static void SmCfgIndexAction3(FwSmDesc_t smDesc) {
+	(void)smDesc;
+}
+
+/**
+ * Action used by the configuration index test cases.
+ * @param smDesc the state machine descriptor
+ */
+static void SmCfgIndexAction4(FwSmDesc_t smDesc) {
+	(void)smDesc;
+}
+
+/**
+ * Guard used by the configuration index test cases.
+ * @param smDesc the state machine descriptor
+ * @return always 1
+ */
+static FwSmBool_t SmCfgIndexGuard1(FwSmDesc_t smDesc) {
+	(void)smDesc;
+	return 1;
+}
+
+/**
+ * Guard used by the configuration index test cases.
+ * @param smDesc the state machine descriptor
+ * @return always 0
+ */
+static FwSmBool_t SmCfgIndexGuard2(FwSmDesc_t smDesc) {
+	(void)smDesc;
+	return 0;
+}
+
+/*------------------------------------------------------------------------------------------------- */
+FwSmTestOutcome_t FwSmTestCaseCfgIndex1() {
+	FwSmDesc_t smDesc, smDescDer, smDescFull;
+	FwSmCounterS1_t i;
+
+	/* Create a state machine whose action and guard arrays are large enough to use the index */
+	smDesc = FwSmCreate(2, 0, 3, 3, FW_SM_CFG_INDEX_MIN);
+	if ((smDesc == NULL) || (smDesc->cfgIndex != NULL))
+		return smTestCaseFailure;
+
+	/* Add the states and check that actions are stored once */
+	FwSmAddState(smDesc, 1, 1, &SmCfgIndexAction1, &SmCfgIndexAction2, &SmCfgIndexAction1, NULL);
+	FwSmAddState(smDesc, 2, 1, &SmCfgIndexAction3, NULL, &SmCfgIndexAction2, NULL);
+	if ((smDesc->cfgIndex == NULL) || (smDesc->smBase->pStates[0].iEntryAction != 1) ||
+	        (smDesc->smBase->pStates[0].iExitAction != 2) || (smDesc->smBase->pStates[0].iDoAction != 1) ||
+	        (smDesc->smBase->pStates[1].iEntryAction != 3) || (smDesc->smBase->pStates[1].iExitAction != 0) ||
+	        (smDesc->smBase->pStates[1].iDoAction != 2)) {
+		FwSmRelease(smDesc);
+		return smTestCaseFailure;
+	}
+
+	/* Add the transitions and check that guards are stored once */
+	FwSmAddTransIpsToSta(smDesc, 1, NULL);
+	FwSmAddTransStaToSta(smDesc, TR1, 1, 2, &SmCfgIndexAction3, &SmCfgIndexGuard1);
+	FwSmAddTransStaToSta(smDesc, TR2, 2, 1, NULL, &SmCfgIndexGuard1);
+	if ((FwSmGetErrCode(smDesc) != smSuccess) || (smDesc->smBase->trans[1].iTrAction != 3) ||
+	        (smDesc->smBase->trans[1].iTrGuard != 1) || (smDesc->smBase->trans[2].iTrGuard != 1) ||
+	        (smDesc->smGuards[1] != &SmCfgIndexGuard1) || (smDesc->smGuards[2] != NULL)) {
+		FwSmRelease(smDesc);
+		return smTestCaseFailure;
+	}
+
+	/* Fill the unused guard locations and check that the index is released by FwSmCheck */
+	for (i = 2; i < smDesc->nOfGuards; i++)
+		smDesc->smGuards[i] = &SmCfgIndexGuard2;
+	if ((FwSmCheck(smDesc) != smSuccess) || (smDesc->cfgIndex != NULL)) {
+		FwSmRelease(smDesc);
+		return smTestCaseFailure;
+	}
+
+	/* Override actions in a derived state machine (the overrides create and resolve a duplicate) */
+	smDescDer = FwSmCreateDer(smDesc);
+	if ((smDescDer == NULL) || (smDescDer->cfgIndex != NULL)) {
+		FwSmRelease(smDesc);
+		return smTestCaseFailure;
+	}
+	FwSmOverrideAction(smDescDer, &SmCfgIndexAction1, &SmCfgIndexAction4);
+	FwSmOverrideAction(smDescDer, &SmCfgIndexAction4, &SmCfgIndexAction2);
+	FwSmOverrideAction(smDescDer, &SmCfgIndexAction2, &SmCfgIndexAction1);
+	FwSmOverrideAction(smDescDer, &SmCfgIndexAction2, &SmCfgIndexAction4);
+	FwSmOverrideGuard(smDescDer, &SmCfgIndexGuard1, &SmCfgIndexGuard2);
+	FwSmOverrideGuard(smDescDer, &SmCfgIndexGuard2, &SmCfgIndexGuard1);
+	if ((smDescDer->cfgIndex == NULL) || (FwSmGetErrCode(smDescDer) != smSuccess) ||
+	        (smDescDer->smActions[1] != &SmCfgIndexAction1) || (smDescDer->smActions[2] != &SmCfgIndexAction4) ||
+	        (smDescDer->smActions[3] != &SmCfgIndexAction3) || (smDescDer->smGuards[1] != &SmCfgIndexGuard1) ||
+	        (smDescDer->smGuards[2] != &SmCfgIndexGuard2)) {
+		FwSmReleaseDer(smDescDer);
+		FwSmRelease(smDesc);
+		return smTestCaseFailure;
+	}
+
+	/* Override an action which is not in the derived state machine */
+	FwSmOverrideAction(smDescDer, &SmCfgIndexAction2, &SmCfgIndexAction4);
+	if (FwSmGetErrCode(smDescDer) != smUndefAction) {
+		FwSmReleaseDer(smDescDer);
+		FwSmRelease(smDesc);
+		return smTestCaseFailure;
+	}
+	FwSmReleaseDer(smDescDer);
+	FwSmRelease(smDesc);
+
+	/* Add one action too many to a state machine which uses the index */
+	smDescFull = FwSmCreate(1, 0, 1, 1, FW_SM_CFG_INDEX_MIN);
+	FwSmAddState(smDescFull, 1, 0, &SmCfgIndexAction1, &SmCfgIndexAction2, &SmCfgIndexAction1, NULL);
+	if ((smDescFull->cfgIndex == NULL) || (FwSmGetErrCode(smDescFull) != smTooManyActions) ||
+	        (smDescFull->smBase->pStates[0].iEntryAction != 1) || (smDescFull->smBase->pStates[0].iExitAction != 0)) {
+		FwSmRelease(smDescFull);
+		return smTestCaseFailure;
+	}
+
+	FwSmRelease(smDescFull);
+	return smTestCaseSuccess;
+}
+
+/*------------------------------------------------------------------------------------------------- */
+FwSmTestOutcome_t FwSmTestCaseDerShared1() {
+	struct TestSmData smData = {0, 0, 0, 0, 0, 0};
+	struct TestSmData esmData = {0, 0, 0, 0, 0, 0};
+	struct TestSmData derSmData = {0, 0, 0, 0, 0, 0};
+	struct TestSmData derEsmData = {0, 0, 0, 0, 0, 0};
+	FwSmDesc_t smDescBase, smDescDer, smDescSimple, smDescSimpleDer, esmDesc;
+	FwSmAction_t entryAction;
+	FwSmGuard_t guard;
+
+	/* Create the base state machine (SM3 embeds SM2 in its state S1) */
+	smDescBase = FwSmMakeTestSM3(&smData, &esmData);
+	if (FwSmCheckRec(smDescBase) != smSuccess) {
+		FwSmReleaseRec(smDescBase);
+		return smTestCaseFailure;
+	}
+
+	/* The derived state machine shares the action and guard arrays but not the embedded state machine */
+	smDescDer = FwSmCreateDerShared(smDescBase);
+	if ((smDescDer == NULL) || (smDescDer->smActions != smDescBase->smActions) ||
+	        (smDescDer->smGuards != smDescBase->smGuards) || (smDescDer->esmDesc == smDescBase->esmDesc) ||
+	        (smDescDer->shared != (SM_SHARED_ACTIONS | SM_SHARED_GUARDS))) {
+		FwSmReleaseRec(smDescBase);
+		return smTestCaseFailure;
+	}
+	esmDesc = FwSmGetEmbSm(smDescDer, STATE_S1);
+	if ((esmDesc == NULL) || (esmDesc == FwSmGetEmbSm(smDescBase, STATE_S1)) ||
+	        (esmDesc->smActions != FwSmGetEmbSm(smDescBase, STATE_S1)->smActions)) {
+		FwSmReleaseDer(smDescDer);
+		FwSmReleaseRec(smDescBase);
+		return smTestCaseFailure;
+	}
+	FwSmSetData(smDescDer, &derSmData);
+	FwSmSetData(esmDesc, &derEsmData);
+
+	/* Override the entry action of S1: the derived state machine gets its own action array */
+	entryAction = smDescBase->smActions[smDescBase->smBase->pStates[STATE_S1-1].iEntryAction];
+	FwSmOverrideAction(smDescDer, entryAction, &SmCfgIndexAction1);
+	if ((FwSmGetErrCode(smDescDer) != smSuccess) || (smDescDer->smActions == smDescBase->smActions) ||
+	        (smDescDer->shared != SM_SHARED_GUARDS) ||
+	        (smDescBase->smActions[smDescBase->smBase->pStates[STATE_S1-1].iEntryAction] != entryAction)) {
+		FwSmReleaseDer(esmDesc);
+		FwSmReleaseDer(smDescDer);
+		FwSmReleaseRec(smDescBase);
+		return smTestCaseFailure;
+	}
+
+	/* Override a guard: the derived state machine gets its own guard array */
+	guard = smDescBase->smGuards[1];
+	FwSmOverrideGuard(smDescDer, guard, &SmCfgIndexGuard2);
+	if ((FwSmGetErrCode(smDescDer) != smSuccess) || (smDescDer->smGuards == smDescBase->smGuards) ||
+	        (smDescDer->shared != 0) || (smDescBase->smGuards[1] != guard)) {
+		FwSmReleaseDer(esmDesc);
+		FwSmReleaseDer(smDescDer);
+		FwSmReleaseRec(smDescBase);
+		return smTestCaseFailure;
+	}
+
+	/* Start the derived and the base state machines: only the base executes the original entry action
+	 * and each embedded state machine operates on its own data */
+	FwSmStart(smDescDer);
+	FwSmStart(smDescBase);
+	if ((FwSmGetCurState(smDescDer) != STATE_S1) || (derSmData.counter_1 != 0) || (derSmData.counter_2 != 1) ||
+	        (smData.counter_1 != 1) || (smData.counter_2 != 1) || (derEsmData.counter_2 != 1) ||
+	        (esmData.counter_2 != 1)) {
+		FwSmReleaseDer(esmDesc);
+		FwSmReleaseDer(smDescDer);
+		FwSmReleaseRec(smDescBase);
+		return smTestCaseFailure;
+	}
+	FwSmReleaseDer(esmDesc);
+	FwSmReleaseDer(smDescDer);
+	FwSmReleaseRec(smDescBase);
+
+	/* Embedding a state machine in a derived state machine gives it its own array of embedded state machines */
+	smDescSimple = FwSmMakeTestSM1(&smData);
+	smDescSimpleDer = FwSmCreateDerShared(smDescSimple);
+	if ((smDescSimpleDer == NULL) || (smDescSimpleDer->esmDesc != smDescSimple->esmDesc)) {
+		FwSmRelease(smDescSimple);
+		return smTestCaseFailure;
+	}
+	esmDesc = FwSmMakeTestSM2(&esmData);
+	FwSmEmbed(smDescSimpleDer, STATE_S1, esmDesc);
+	if ((FwSmGetErrCode(smDescSimpleDer) != smSuccess) || (smDescSimpleDer->esmDesc == smDescSimple->esmDesc) ||
+	        (FwSmGetEmbSm(smDescSimpleDer, STATE_S1) != esmDesc) || (FwSmGetEmbSm(smDescSimple, STATE_S1) != NULL)) {
+		FwSmRelease(esmDesc);
+		FwSmReleaseDer(smDescSimpleDer);
+		FwSmRelease(smDescSimple);
+		return smTestCaseFailure;
+	}
+
+	FwSmRelease(esmDesc);
+	FwSmReleaseDer(smDescSimpleDer);
+	FwSmRelease(smDescSimple);
+	return smTestCaseSuccess;
+}
+
+/*------------------------------------------------------------------------------------------------- */
+FwSmTestOutcome_t FwSmTestCasePool1() {
+	struct TestSmData smData = {0, 0, 0, 0, 0, 0};
+	struct TestSmData esmData = {0, 0, 0, 0, 0, 0};
+	struct TestSmData derSmData = {0, 0, 0, 0, 0, 0};
+	struct TestSmData derEsmData = {0, 0, 0, 0, 0, 0};
+	FwSmDesc_t smDescBase, smDescSimple, smDesc1, smDesc2, smDesc3;
+	FwSmPoolDesc_t pool;
+	FwSmAction_t entryAction;
+	FwSmCounterS1_t iEntryAction;
+
+	/* Create the pool state machine (SM3 embeds SM2 in its state S1) */
+	smDescBase = FwSmMakeTestSM3(&smData, &esmData);
+	if (FwSmCheckRec(smDescBase) != smSuccess) {
+		FwSmReleaseRec(smDescBase);
+		return smTestCaseFailure;
+	}
+
+	/* A pool with no state machines cannot be created */
+	if (FwSmPoolCreate(smDescBase, 0, 0) != NULL) {
+		FwSmReleaseRec(smDescBase);
+		return smTestCaseFailure;
+	}
+
+	pool = FwSmPoolCreate(smDescBase, 2, 0);
+	if ((pool == NULL) || (FwSmPoolGetNOfInUse(pool) != 0) || (FwSmPoolGetHighWater(pool) != 0) ||
+	        (FwSmPoolGetNOfMisses(pool) != 0)) {
+		FwSmReleaseRec(smDescBase);
+		return smTestCaseFailure;
+	}
+
+	/* Obtain three state machines: the third one is a miss */
+	smDesc1 = FwSmPoolGet(pool);
+	smDesc2 = FwSmPoolGet(pool);
+	smDesc3 = FwSmPoolGet(pool);
+	if ((smDesc1 == NULL) || (smDesc2 == NULL) || (smDesc3 == NULL) || (FwSmPoolGetNOfInUse(pool) != 3) ||
+	        (FwSmPoolGetHighWater(pool) != 3) || (FwSmPoolGetNOfMisses(pool) != 1) ||
+	        (smDesc1->smBase != smDescBase->smBase) || (FwSmGetEmbSm(smDesc1, STATE_S1) == NULL) ||
+	        (FwSmGetEmbSm(smDesc1, STATE_S1) == FwSmGetEmbSm(smDescBase, STATE_S1))) {
+		FwSmPoolRelease(pool);
+		FwSmReleaseRec(smDescBase);
+		return smTestCaseFailure;
+	}
+
+	/* Use the first state machine with an overridden entry action */
+	iEntryAction = smDescBase->smBase->pStates[STATE_S1-1].iEntryAction;
+	entryAction = smDescBase->smActions[iEntryAction];
+	FwSmSetData(smDesc1, &derSmData);
+	FwSmSetData(FwSmGetEmbSm(smDesc1, STATE_S1), &derEsmData);
+	FwSmOverrideAction(smDesc1, entryAction, &SmCfgIndexAction1);
+	FwSmStart(smDesc1);
+	if ((FwSmGetCurState(smDesc1) != STATE_S1) || (derSmData.counter_1 != 0) || (derEsmData.counter_2 != 1)) {
+		FwSmPoolRelease(pool);
+		FwSmReleaseRec(smDescBase);
+		return smTestCaseFailure;
+	}
+
+	/* Return the state machines: the first one is reset and the third one does not fit in the pool */
+	if ((FwSmPoolPut(pool, smDesc1) != smSuccess) || (FwSmPoolPut(pool, smDesc2) != smSuccess) ||
+	        (FwSmPoolPut(pool, smDesc3) != smSuccess)) {
+		FwSmPoolRelease(pool);
+		FwSmReleaseRec(smDescBase);
+		return smTestCaseFailure;
+	}
+	if ((FwSmPoolGetNOfInUse(pool) != 0) || (FwSmPoolGetHighWater(pool) != 3) || (FwSmIsStarted(smDesc1) != 0) ||
+	        (FwSmGetData(smDesc1) != NULL) || (smDesc1->smActions[iEntryAction] != entryAction) ||
+	        (FwSmGetExecCnt(smDesc1) != 0) || (FwSmIsStarted(FwSmGetEmbSm(smDesc1, STATE_S1)) != 0) ||
+	        (FwSmGetData(FwSmGetEmbSm(smDesc1, STATE_S1)) != NULL)) {
+		FwSmPoolRelease(pool);
+		FwSmReleaseRec(smDescBase);
+		return smTestCaseFailure;
+	}
+
+	/* The state machines are served again without misses */
+	smDesc2 = FwSmPoolGet(pool);
+	smDesc1 = FwSmPoolGet(pool);
+	if ((smDesc1 == NULL) || (smDesc2 == NULL) || (FwSmPoolGetNOfMisses(pool) != 1) ||
+	        (FwSmPoolGetNOfInUse(pool) != 2) || (FwSmPoolGetHighWater(pool) != 3)) {
+		FwSmPoolRelease(pool);
+		FwSmReleaseRec(smDescBase);
+		return smTestCaseFailure;
+	}
+
+	/* A state machine with a different base descriptor cannot be returned to the pool */
+	smDescSimple = FwSmMakeTestSM1(&smData);
+	if (FwSmPoolPut(pool, smDescSimple) != smWrongBase) {
+		FwSmRelease(smDescSimple);
+		FwSmPoolRelease(pool);
+		FwSmReleaseRec(smDescBase);
+		return smTestCaseFailure;
+	}
+
+	FwSmRelease(smDescSimple);
+	FwSmPoolPut(pool, smDesc1);
+	FwSmPoolPut(pool, smDesc2);
+	FwSmPoolRelease(pool);
+	FwSmReleaseRec(smDescBase);
+	return smTestCaseSuccess;
+}
+
+/**
+ * Function executed by the threads of test case <code>::FwSmTestCasePool2</code>.
+ * The function repeatedly obtains three state machines from a pool, checks that
+ * they have been reset, sets their data and returns them to the pool.
+ * The state machines are not started because the actions of the test state machines
+ * write to a global log.
+ * @param ptr the descriptor of the pool.
+ * @return NULL if the test was successful or a non-NULL value otherwise.
+ */
+static void* SmPoolThread(void* ptr) {
+	FwSmPoolDesc_t pool = (FwSmPoolDesc_t)ptr;
+	struct TestSmData smData = {0, 0, 0, 0, 0, 0};
+	FwSmDesc_t smDesc[3];
+	int i, j;
+
+	for (i = 0; i < 1000; i++) {
+		for (j = 0; j < 3; j++) {
+			smDesc[j] = FwSmPoolGet(pool);
+			if ((smDesc[j] == NULL) || (FwSmIsStarted(smDesc[j]) != 0) || (FwSmGetData(smDesc[j]) != NULL))
+				return ptr;
+			FwSmSetData(smDesc[j], &smData);
+		}
+		for (j = 0; j < 3; j++)
+			if (FwSmPoolPut(pool, smDesc[j]) != smSuccess)
+				return ptr;
+	}
+	return NULL;
+}
+
+/*------------------------------------------------------------------------------------------------- */
+FwSmTestOutcome_t FwSmTestCasePool2() {
+	struct TestSmData smData = {0, 0, 0, 0, 0, 0};
+	FwSmDesc_t smDescBase;
+	FwSmPoolDesc_t pool;
+	pthread_t thread[4];
+	void* threadResult;
+	int i, nOfThreads;
+	FwSmTestOutcome_t outcome = smTestCaseSuccess;
+
+	smDescBase = FwSmMakeTestSM1(&smData);
+	if (FwSmCheck(smDescBase) != smSuccess) {
+		FwSmRelease(smDescBase);
+		return smTestCaseFailure;
+	}
+
+	pool = FwSmPoolCreate(smDescBase, 4, 1);
+	if (pool == NULL) {
+		FwSmRelease(smDescBase);
+		return smTestCaseFailure;
+	}
+
+	for (nOfThreads = 0; nOfThreads < 4; nOfThreads++)
+		if (pthread_create(&thread[nOfThreads], NULL, SmPoolThread, pool) != 0) {
+			outcome = smTestCaseFailure;
+			break;
+		}
+	for (i = 0; i < nOfThreads; i++) {
+		if ((pthread_join(thread[i], &threadResult) != 0) || (threadResult != NULL))
+			outcome = smTestCaseFailure;
+	}
+
+	/* All state machines have been returned and each thread held at most three at a time */
+	if ((FwSmPoolGetNOfInUse(pool) != 0) || (FwSmPoolGetHighWater(pool) < 3) ||
+	        (FwSmPoolGetHighWater(pool) > (FwSmCounterU4_t)(3 * nOfThreads)))
+		outcome = smTestCaseFailure;
+
+	/* The calling thread can use the pool after the other threads have terminated */
+	if (SmPoolThread(pool) != NULL)
+		outcome = smTestCaseFailure;
+
+	FwSmPoolRelease(pool);
+	FwSmRelease(smDescBase);
+	return outcome;
+}
+
+/**
+ * Command which starts the state machines in the command sequences of the code generation
+ * test cases (see <code>::SmGenCompare</code>).
+ */
+#define SM_GEN_START (-1)
+
+/**
+ * Command which stops the state machines in the command sequences of the code generation
+ * test cases (see <code>::SmGenCompare</code>).
+ */
+#define SM_GEN_STOP (-2)
+
+/**
+ * Send a sequence of commands to a state machine through the functions of <code>FwSmCore.h</code>
+ * and to a second instance of the same state machine through the functions generated for it by
+ * <code>::FwSmGenerateCode</code> and check that the two state machines behave in the same way.
+ * Each command consists of a transition identifier (or <code>#SM_GEN_START</code> or
+ * <code>#SM_GEN_STOP</code>) and of the values of <code>flag_1</code> and <code>flag_2</code>
+ * of the state machine data when the command is sent.
+ * After each command, the current states, the execution counters, the error codes and the
+ * counters of the state machine data of the two state machines are compared.
+ * @param smDesc the state machine which is executed through the functions of <code>FwSmCore.h</code>
+ * @param genSmDesc the state machine which is executed through the generated functions
+ * @param smData the data of <code>smDesc</code> and of its embedded state machine
+ * @param genSmData the data of <code>genSmDesc</code> and of its embedded state machine
+ * @param genStart the generated start function
+ * @param genStop the generated stop function
+ * @param genMakeTrans the generated transition function
+ * @param cmd the sequence of commands
+ * @param nOfCmds the number of commands
+ * @return 1 if the two state machines behave in the same way, 0 otherwise
+ */
+static int SmGenCompare(FwSmDesc_t smDesc, FwSmDesc_t genSmDesc, struct TestSmData* smData,
+                        struct TestSmData* genSmData, void (*genStart)(FwSmDesc_t), void (*genStop)(FwSmDesc_t),
+                        void (*genMakeTrans)(FwSmDesc_t, FwSmCounterU2_t), int cmd[][3], int nOfCmds) {
+	int i, j;
+
+	for (i = 0; i < nOfCmds; i++) {
+		/* The log is not checked by the code generation test cases */
+		fwSm_logIndex = 0;
+		for (j = 0; j < 2; j++) {
+			smData[j].flag_1 = cmd[i][1];
+			smData[j].flag_2 = cmd[i][2];
+			genSmData[j].flag_1 = cmd[i][1];
+			genSmData[j].flag_2 = cmd[i][2];
+		}
+		if (cmd[i][0] == SM_GEN_START) {
+			FwSmStart(smDesc);
+			genStart(genSmDesc);
+		} else if (cmd[i][0] == SM_GEN_STOP) {
+			FwSmStop(smDesc);
+			genStop(genSmDesc);
+		} else {
+			FwSmMakeTrans(smDesc, (FwSmCounterU2_t)cmd[i][0]);
+			genMakeTrans(genSmDesc, (FwSmCounterU2_t)cmd[i][0]);
+		}
+		if ((FwSmGetCurState(smDesc) != FwSmGetCurState(genSmDesc)) ||
+		        (FwSmGetCurStateEmb(smDesc) != FwSmGetCurStateEmb(genSmDesc)) ||
+		        (FwSmGetExecCnt(smDesc) != FwSmGetExecCnt(genSmDesc)) ||
+		        (FwSmGetStateExecCnt(smDesc) != FwSmGetStateExecCnt(genSmDesc)) ||
+		        (FwSmGetErrCode(smDesc) != FwSmGetErrCode(genSmDesc)))
+			return 0;
+		for (j = 0; j < 2; j++)
+			if ((smData[j].counter_1 != genSmData[j].counter_1) || (smData[j].counter_2 != genSmData[j].counter_2))
+				return 0;
+	}
+	return 1;
+}
+
+/*------------------------------------------------------------------------------------------------- */
+FwSmTestOutcome_t FwSmTestCaseGen1() {
+	struct TestSmData smData[2] = {{0, 0, 0, 0, 0, 0}, {0, 0, 0, 0, 0, 0}};
+	struct TestSmData genSmData[2] = {{0, 0, 0, 0, 0, 0}, {0, 0, 0, 0, 0, 0}};
+	int cmd[][3] = {{SM_GEN_START, 1, 0}, {FW_TR_EXECUTE, 1, 0}, {TR2, 1, 0}, {FW_TR_EXECUTE, 1, 0},
+		{TR4, 0, 0}, {TR4, 1, 0}, {TR6, 0, 1}, {TR6, 1, 0}, {TR2, 1, 0}, {SM_GEN_STOP, 1, 0},
+		{SM_GEN_START, 1, 0}, {TR2, 1, 0}, {TR5, 0, 0}, {TR5, 1, 0}, {FW_TR_EXECUTE, 1, 0},
+		{SM_GEN_START, 1, 0}, {TR2, 0, 0}, {TR2, 1, 0}, {TR6, 0, 0}
+	};
+	FwSmDesc_t smDesc, genSmDesc;
+	FwSmFuncName_t names[2];
+	FILE* stream;
+	char code[8192];
+	size_t len;
+
+	smDesc = FwSmMakeTestSM5(&smData[0]);
+	genSmDesc = FwSmMakeTestSM5(&genSmData[0]);
+	if ((FwSmCheck(smDesc) != smSuccess) || (FwSmCheck(genSmDesc) != smSuccess)) {
+		FwSmRelease(smDesc);
+		FwSmRelease(genSmDesc);
+		return smTestCaseFailure;
+	}
+
+	/* The last command sequence ends with an error in the choice pseudo-state */
+	if ((SmGenCompare(smDesc, genSmDesc, smData, genSmData, &FwSmGenSM5Start, &FwSmGenSM5Stop, &FwSmGenSM5MakeTrans,
+	                  cmd, (int)(sizeof(cmd) / sizeof(cmd[0]))) == 0) || (FwSmGetErrCode(smDesc) != smTransErr)) {
+		FwSmRelease(smDesc);
+		FwSmRelease(genSmDesc);
+		return smTestCaseFailure;
+	}
+
+	/* Generate code where the entry action and the guard of the transitions out of CPS1 are called by name */
+	names[0].action = smDesc->smActions[smDesc->smBase->pStates[STATE_S1-1].iEntryAction];
+	names[0].guard = NULL;
+	names[0].name = "smGenEntry";
+	names[1].action = NULL;
+	names[1].guard = smDesc->smGuards[2];
+	names[1].name = "smGenFlag2";
+	stream = tmpfile();
+	if ((stream == NULL) || (FwSmGenerateCode(smDesc, "Gen", names, 2, stream) != 4)) {
+		if (stream != NULL)
+			fclose(stream);
+		FwSmRelease(smDesc);
+		FwSmRelease(genSmDesc);
+		return smTestCaseFailure;
+	}
+	rewind(stream);
+	len = fread(code, 1, sizeof(code) - 1, stream);
+	code[len] = '\0';
+	fclose(stream);
+	if ((strstr(code, "void smGenEntry(FwSmDesc_t smDesc);") == NULL) ||
+	        (strstr(code, "FwSmBool_t smGenFlag2(FwSmDesc_t smDesc);") == NULL) ||
+	        (strstr(code, "  smGenEntry(smDesc);") == NULL) || (strstr(code, "  if (smGenFlag2(smDesc)) {") == NULL) ||
+	        (strstr(code, "void GenMakeTrans(FwSmDesc_t smDesc, FwSmCounterU2_t transId) {") == NULL) ||
+	        (strstr(code, "smDesc->smGuards[2]") != NULL)) {
+		FwSmRelease(smDesc);
+		FwSmRelease(genSmDesc);
+		return smTestCaseFailure;
+	}
+
+	FwSmRelease(smDesc);
+	FwSmRelease(genSmDesc);
+	return smTestCaseSuccess;
+}
+
+/*------------------------------------------------------------------------------------------------- */
+FwSmTestOutcome_t FwSmTestCaseGen2() {
+	struct TestSmData smData[2] = {{0, 0, 0, 0, 0, 0}, {0, 0, 0, 0, 0, 0}};
+	struct TestSmData genSmData[2] = {{0, 0, 0, 0, 0, 0}, {0, 0, 0, 0, 0, 0}};
+	int cmd[][3] = {{SM_GEN_START, 0, 0}, {FW_TR_EXECUTE, 0, 0}, {FW_TR_EXECUTE, 1, 0}, {TR2, 0, 0},
+		{FW_TR_EXECUTE, 0, 0}, {TR4, 1, 0}, {TR2, 0, 0}, {TR6, 0, 1}, {TR6, 1, 0}, {SM_GEN_STOP, 0, 0},
+		{SM_GEN_START, 1, 0}, {FW_TR_EXECUTE, 0, 0}, {TR2, 0, 0}, {TR3, 1, 0}, {FW_TR_EXECUTE, 1, 0}
+	};
+	FwSmDesc_t smDesc, genSmDesc;
+
+	smDesc = FwSmMakeTestSM6(&smData[0], &smData[1]);
+	genSmDesc = FwSmMakeTestSM6(&genSmData[0], &genSmData[1]);
+	if ((FwSmCheckRec(smDesc) != smSuccess) || (FwSmCheckRec(genSmDesc) != smSuccess)) {
+		FwSmReleaseRec(smDesc);
+		FwSmReleaseRec(genSmDesc);
+		return smTestCaseFailure;
+	}
+
+	if (SmGenCompare(smDesc, genSmDesc, smData, genSmData, &FwSmGenSM6Start, &FwSmGenSM6Stop, &FwSmGenSM6MakeTrans,
+	                 cmd, (int)(sizeof(cmd) / sizeof(cmd[0]))) == 0) {
+		FwSmReleaseRec(smDesc);
+		FwSmReleaseRec(genSmDesc);
+		return smTestCaseFailure;
+	}
+
+	/* The generated execute function is equivalent to the generated transition function */
+	fwSm_logIndex = 0;
+	FwSmExecute(smDesc);
+	FwSmGenSM6Execute(genSmDesc);
+	if ((FwSmGetCurState(smDesc) != FwSmGetCurState(genSmDesc)) ||
+	        (FwSmGetExecCnt(smDesc) != FwSmGetExecCnt(genSmDesc)) || (smData[0].counter_1 != genSmData[0].counter_1)) {
+		FwSmReleaseRec(smDesc);
+		FwSmReleaseRec(genSmDesc);
+		return smTestCaseFailure;
+	}
+
+	FwSmReleaseRec(smDesc);
+	FwSmReleaseRec(genSmDesc);
+	return smTestCaseSuccess;
+}
+
+/*------------------------------------------------------------------------------------------------- */
+FwSmTestOutcome_t FwSmTestCaseImage1() {
+	struct TestSmData smData[2] = {{0, 0, 0, 0, 0, 0}, {0, 0, 0, 0, 0, 0}};
+	struct TestSmData imgSmData[2] = {{0, 0, 0, 0, 0, 0}, {0, 0, 0, 0, 0, 0}};
+	int cmd[][3] = {{SM_GEN_START, 1, 0}, {FW_TR_EXECUTE, 1, 0}, {TR2, 1, 0}, {FW_TR_EXECUTE, 1, 0},
+		{TR4, 1, 0}, {TR6, 0, 1}, {TR6, 1, 0}, {TR2, 1, 0}, {SM_GEN_STOP, 1, 0}, {SM_GEN_START, 1, 0},
+		{TR2, 1, 0}, {TR5, 1, 0}
+	};
+	FwSmDesc_t smDesc, imgSmDesc, derSmDesc;
+	FwSmCounterU4_t size;
+	unsigned char* image;
+	unsigned char* copy;
+
+	smDesc = FwSmMakeTestSM5(&smData[0]);
+	size = FwSmGetImageSize(smDesc);
+	image = (unsigned char*)malloc(size);
+	copy = (unsigned char*)malloc(size);
+	if ((image == NULL) || (copy == NULL)) {
+		free(image);
+		free(copy);
+		FwSmRelease(smDesc);
+		return smTestCaseFailure;
+	}
+
+	/* The image cannot be exported to a buffer which is too small or misaligned */
+	if ((FwSmExportImage(smDesc, image, size - 1) != 0) || (FwSmExportImage(smDesc, image + 1, size) != 0) ||
+	        (FwSmExportImage(smDesc, image, size) != size)) {
+		free(image);
+		free(copy);
+		FwSmRelease(smDesc);
+		return smTestCaseFailure;
+	}
+	memcpy(copy, image, size);
+
+	/* The image is rejected if it is truncated or if the actions and guards do not match */
+	if ((FwSmLoadImage(image, size - 1, smDesc->smActions + 1, (FwSmCounterS1_t)(smDesc->nOfActions - 1),
+	                   smDesc->smGuards + 1, (FwSmCounterS1_t)(smDesc->nOfGuards - 1)) != NULL) ||
+	        (FwSmLoadImage(image, size, smDesc->smActions + 1, (FwSmCounterS1_t)(smDesc->nOfActions - 2),
+	                       smDesc->smGuards + 1, (FwSmCounterS1_t)(smDesc->nOfGuards - 1)) != NULL) ||
+	        (FwSmLoadImage(image, size, smDesc->smActions, (FwSmCounterS1_t)(smDesc->nOfActions - 1),
+	                       smDesc->smGuards + 1, (FwSmCounterS1_t)(smDesc->nOfGuards)) != NULL)) {
+		free(image);
+		free(copy);
+		FwSmRelease(smDesc);
+		return smTestCaseFailure;
+	}
+
+	/* The image is rejected if one of its bytes is corrupted */
+	image[size - 1] = (unsigned char)(image[size - 1] ^ 1);
+	imgSmDesc = FwSmLoadImage(image, size, smDesc->smActions + 1, (FwSmCounterS1_t)(smDesc->nOfActions - 1),
+	                          smDesc->smGuards + 1, (FwSmCounterS1_t)(smDesc->nOfGuards - 1));
+	image[size - 1] = (unsigned char)(image[size - 1] ^ 1);
+	if (imgSmDesc != NULL) {
+		free(image);
+		free(copy);
+		FwSmRelease(smDesc);
+		return smTestCaseFailure;
+	}
+
+	/* The loaded state machine is already configured and compiled */
+	imgSmDesc = FwSmLoadImage(image, size, smDesc->smActions + 1, (FwSmCounterS1_t)(smDesc->nOfActions - 1),
+	                          smDesc->smGuards + 1, (FwSmCounterS1_t)(smDesc->nOfGuards - 1));
+	if ((imgSmDesc == NULL) || (FwSmCheck(imgSmDesc) != smSuccess) || (FwSmCompile(imgSmDesc) != smSuccess) ||
+	        (imgSmDesc->smBase->isCompiled == 0) || (FwSmIsStarted(imgSmDesc) != 0)) {
+		if (imgSmDesc != NULL)
+			FwSmReleaseArena(imgSmDesc);
+		free(image);
+		free(copy);
+		FwSmRelease(smDesc);
+		return smTestCaseFailure;
+	}
+	FwSmSetData(imgSmDesc, &imgSmData[0]);
+
+	/* The loaded state machine behaves like the exported one and does not modify the image */
+	if ((SmGenCompare(smDesc, imgSmDesc, smData, imgSmData, &FwSmStart, &FwSmStop, &FwSmMakeTrans,
+	                  cmd, (int)(sizeof(cmd) / sizeof(cmd[0]))) == 0) || (memcmp(copy, image, size) != 0)) {
+		FwSmReleaseArena(imgSmDesc);
+		free(image);
+		free(copy);
+		FwSmRelease(smDesc);
+		return smTestCaseFailure;
+	}
+
+	/* State machines can be derived from the loaded state machine */
+	derSmDesc = FwSmCreateDer(imgSmDesc);
+	if ((derSmDesc == NULL) || (derSmDesc->smBase != imgSmDesc->smBase) || (FwSmCheck(derSmDesc) != smSuccess)) {
+		if (derSmDesc != NULL)
+			FwSmReleaseDer(derSmDesc);
+		FwSmReleaseArena(imgSmDesc);
+		free(image);
+		free(copy);
+		FwSmRelease(smDesc);
+		return smTestCaseFailure;
+	}
+
+	FwSmReleaseDer(derSmDesc);
+	FwSmReleaseArena(imgSmDesc);
+	free(image);
+	free(copy);
+	FwSmRelease(smDesc);
+	return smTestCaseSuccess;
+}
+
+/*------------------------------------------------------------------------------------------------- */
+FwSmTestOutcome_t FwSmTestCaseConst1() {
+	struct TestSmData smData[2] = {{0, 0, 0, 0, 0, 0}, {0, 0, 0, 0, 0, 0}};
+	struct TestSmData constSmData[2] = {{0, 0, 0, 0, 0, 0}, {0, 0, 0, 0, 0, 0}};
+	int cmd[][3] = {{SM_GEN_START, 1, 0}, {FW_TR_EXECUTE, 1, 0}, {TR2, 1, 0}, {FW_TR_EXECUTE, 1, 0},
+		{TR4, 0, 0}, {TR4, 1, 0}, {TR6, 0, 1}, {TR6, 1, 0}, {TR2, 1, 0}, {SM_GEN_STOP, 1, 0},
+		{SM_GEN_START, 1, 0}, {TR2, 1, 0}, {TR5, 0, 0}, {TR5, 1, 0}
+	};
+	FwSmDesc_t smDesc, derSmDesc;
+	FW_SM_INST_CONST(constSmDesc, FwSmConstSM5, 2, 4, 2)
+	FW_SM_INST_CONST(constSmDescSmall, FwSmConstSM5, 2, 3, 2)	/* SM5 has 4 actions */
+
+	smDesc = FwSmMakeTestSM5(&smData[0]);
+
+	/* The initialization fails if the constant base descriptor refers to too many actions */
+	FwSmInitConst(&constSmDescSmall, smDesc->smActions + 1, smDesc->smGuards + 1);
+	if (FwSmGetErrCode(&constSmDescSmall) != smWrongNOfActions) {
+		FwSmRelease(smDesc);
+		return smTestCaseFailure;
+	}
+
+	/* The constant state machine is configured and uses the constant base descriptor */
+	FwSmInitConst(&constSmDesc, smDesc->smActions + 1, smDesc->smGuards + 1);
+	FwSmSetData(&constSmDesc, &constSmData[0]);
+	if ((FwSmCheck(&constSmDesc) != smSuccess) || (constSmDesc.smBase != &FwSmConstSM5) ||
+	        (FwSmCompile(&constSmDesc) != smSuccess) || (FwSmIsStarted(&constSmDesc) != 0)) {
+		FwSmRelease(smDesc);
+		return smTestCaseFailure;
+	}
+
+	/* The constant state machine behaves like the state machine from which its base descriptor was generated */
+	if (SmGenCompare(smDesc, &constSmDesc, smData, constSmData, &FwSmStart, &FwSmStop, &FwSmMakeTrans, cmd,
+	                 (int)(sizeof(cmd) / sizeof(cmd[0]))) == 0) {
+		FwSmRelease(smDesc);
+		return smTestCaseFailure;
+	}
+
+	/* State machines can be derived from the constant state machine */
+	derSmDesc = FwSmCreateDer(&constSmDesc);
+	if ((derSmDesc == NULL) || (derSmDesc->smBase != &FwSmConstSM5) || (FwSmCheck(derSmDesc) != smSuccess)) {
+		if (derSmDesc != NULL)
+			FwSmReleaseDer(derSmDesc);
+		FwSmRelease(smDesc);
+		return smTestCaseFailure;
+	}
+
+	FwSmReleaseDer(derSmDesc);
+	FwSmRelease(smDesc);
+	return smTestCaseSuccess;
+}
+
+/*------------------------------------------------------------------------------------------------- */
+FwSmTestOutcome_t FwSmTestCaseQueue1() {
+	struct TestSmData smData = {0, 0, 0, 0, 0, 0};
+	FwSmDesc_t smDesc;
+	FwSmQueueDesc_t queue;
+	int i;
+
+	smDesc = FwSmMakeTestSMLarge(16, &smData);
+	if ((smDesc == NULL) || (FwSmQueueCreate(smDesc, 0, 2) != NULL) || (FwSmQueueCreate(smDesc, 2, 0) != NULL)) {
+		if (smDesc != NULL)
+			FwSmRelease(smDesc);
+		return smTestCaseFailure;
+	}
+
+	/* The capacity of the command lane (3) is rounded up to 4 */
+	queue = FwSmQueueCreate(smDesc, 3, 2);
+	if (queue == NULL) {
+		FwSmRelease(smDesc);
+		return smTestCaseFailure;
+	}
+	fwSm_logIndex = 0;
+	FwSmStart(smDesc);
+
+	/* Fill both lanes and check that the transition commands which do not fit are rejected */
+	if ((FwSmQueuePost(queue, FW_TR_EXECUTE) != smSuccess) || (FwSmQueuePost(queue, FW_TR_EXECUTE) != smSuccess) ||
+	        (FwSmQueuePost(queue, FW_TR_EXECUTE) != smQueueFull)) {
+		FwSmQueueRelease(queue);
+		FwSmRelease(smDesc);
+		return smTestCaseFailure;
+	}
+	for (i = 0; i < 4; i++)
+		if (FwSmQueuePost(queue, TR1) != smSuccess) {
+			FwSmQueueRelease(queue);
+			FwSmRelease(smDesc);
+			return smTestCaseFailure;
+		}
+	if ((FwSmQueuePost(queue, TR1) != smQueueFull) || (FwSmQueueGetNOfRejected(queue) != 2) ||
+	        (FwSmQueueGetNOfPending(queue) != 6)) {
+		FwSmQueueRelease(queue);
+		FwSmRelease(smDesc);
+		return smTestCaseFailure;
+	}
+
+	/* The transition commands are dispatched before the "Execute" commands which were posted before them */
+	fwSm_logIndex = 0;
+	if ((FwSmQueueDispatch(queue, 3) != 3) || (FwSmGetCurState(smDesc) != 4) || (FwSmGetExecCnt(smDesc) != 0)) {
+		FwSmQueueRelease(queue);
+		FwSmRelease(smDesc);
+		return smTestCaseFailure;
+	}
+	fwSm_logIndex = 0;
+	if ((FwSmQueueDispatch(queue, 10) != 3) || (FwSmGetCurState(smDesc) != 5) || (FwSmGetExecCnt(smDesc) != 2) ||
+	        (FwSmQueueGetNOfPending(queue) != 0) || (FwSmQueueDispatch(queue, 10) != 0)) {
+		FwSmQueueRelease(queue);
+		FwSmRelease(smDesc);
+		return smTestCaseFailure;
+	}
+
+	/* The lanes can be reused after they have wrapped around */
+	for (i = 0; i < 20; i++) {
+		fwSm_logIndex = 0;
+		if ((FwSmQueuePost(queue, TR1) != smSuccess) || (FwSmQueueDispatch(queue, 1) != 1)) {
+			FwSmQueueRelease(queue);
+			FwSmRelease(smDesc);
+			return smTestCaseFailure;
+		}
+	}
+	if ((FwSmGetCurState(smDesc) != 9) || (FwSmQueueGetNOfRejected(queue) != 2)) {
+		FwSmQueueRelease(queue);
+		FwSmRelease(smDesc);
+		return smTestCaseFailure;
+	}
+
+	FwSmQueueRelease(queue);
+	FwSmRelease(smDesc);
+	return smTestCaseSuccess;
+}
+
+/** The number of transition commands posted by each thread of test case <code>::FwSmTestCaseQueue2</code>. */
+#define SM_QUEUE_N_OF_POSTS 5000
+
+/**
+ * Function executed by the producer threads of test case <code>::FwSmTestCaseQueue2</code>.
+ * The function posts <code>#SM_QUEUE_N_OF_POSTS</code> TR1 transition commands and
+ * as many "Execute" transition commands to a queue.
+ * A transition command which is rejected because its lane is full is posted again.
+ * @param ptr the descriptor of the queue.
+ * @return NULL
+ */
+static void* SmQueueThread(void* ptr) {
+	FwSmQueueDesc_t queue = (FwSmQueueDesc_t)ptr;
+	int i;
+
+	for (i = 0; i < SM_QUEUE_N_OF_POSTS; i++) {
+		while (FwSmQueuePost(queue, TR1) != smSuccess)
+			sched_yield();
+		while (FwSmQueuePost(queue, FW_TR_EXECUTE) != smSuccess)
+			sched_yield();
+	}
+	return NULL;
+}
+
+/*------------------------------------------------------------------------------------------------- */
+FwSmTestOutcome_t FwSmTestCaseQueue2() {
+	struct TestSmData smData = {0, 0, 0, 0, 0, 0};
+	FwSmDesc_t smDesc;
+	FwSmQueueDesc_t queue;
+	pthread_t thread[4];
+	int i, nOfThreads, counter_2;
+	FwSmCounterU4_t nOfEvents = 0;
+	FwSmTestOutcome_t outcome = smTestCaseSuccess;
+
+	smDesc = FwSmMakeTestSMLarge(16, &smData);
+	if (smDesc == NULL)
+		return smTestCaseFailure;
+	queue = FwSmQueueCreate(smDesc, 64, 64);
+	if (queue == NULL) {
+		FwSmRelease(smDesc);
+		return smTestCaseFailure;
+	}
+	fwSm_logIndex = 0;
+	FwSmStart(smDesc);
+	counter_2 = smData.counter_2;
+
+	for (nOfThreads = 0; nOfThreads < 4; nOfThreads++)
+		if (pthread_create(&thread[nOfThreads], NULL, SmQueueThread, queue) != 0) {
+			outcome = smTestCaseFailure;
+			break;
+		}
+
+	/* The calling thread owns the state machine and dispatches the transition commands */
+	while (nOfEvents < (FwSmCounterU4_t)(2 * SM_QUEUE_N_OF_POSTS * nOfThreads)) {
+		fwSm_logIndex = 0;
+		nOfEvents += FwSmQueueDispatch(queue, 1);
+	}
+	for (i = 0; i < nOfThreads; i++)
+		if (pthread_join(thread[i], NULL) != 0)
+			outcome = smTestCaseFailure;
+
+	/* Each TR1 command has fired one transition and no command has been lost */
+	if ((smData.counter_2 - counter_2 != SM_QUEUE_N_OF_POSTS * nOfThreads) ||
+	        (FwSmGetExecCnt(smDesc) != (FwSmCounterU3_t)(SM_QUEUE_N_OF_POSTS * nOfThreads)) ||
+	        (FwSmGetCurState(smDesc) != 1 + (SM_QUEUE_N_OF_POSTS * nOfThreads) % 16) ||
+	        (FwSmQueueGetNOfPending(queue) != 0) || (FwSmQueueDispatch(queue, 1) != 0))
+		outcome = smTestCaseFailure;
+
+	FwSmQueueRelease(queue);
+	FwSmRelease(smDesc);
+	return outcome;
+}
+
+/*------------------------------------------------------------------------------------------------- */
+FwSmTestOutcome_t FwSmTestCaseSched1() {
+	struct TestSmData smData[64];
+	FwSmDesc_t smDesc[64];
+	FwSchedDesc_t sched;
+	int i, j, nOfSms;
+	FwSmTestOutcome_t outcome = smTestCaseSuccess;
+
+	if ((FwSchedCreate(0, 1, NULL) != NULL) || (FwSchedCreate(2, 0, NULL) != NULL))
+		return smTestCaseFailure;
+	sched = FwSchedCreate(4, 64, NULL);
+	if (sched == NULL)
+		return smTestCaseFailure;
+
+	/* Create and start the state machines (each state machine has its own data) */
+	for (nOfSms = 0; nOfSms < 64; nOfSms++) {
+		memset(&smData[nOfSms], 0, sizeof(struct TestSmData));
+		smDesc[nOfSms] = FwSmMakeTestSMLarge(16, &smData[nOfSms]);
+		if (smDesc[nOfSms] == NULL) {
+			outcome = smTestCaseFailure;
+			break;
+		}
+		fwSm_logIndex = 0;
+		FwSmStart(smDesc[nOfSms]);
+		/* One state machine in four is bound to the last worker */
+		if (FwSchedAddSm(sched, smDesc[nOfSms], ((nOfSms % 4) == 0) ? 3 : FW_SCHED_ANY_WORKER) != 1)
+			outcome = smTestCaseFailure;
+	}
+	if ((outcome == smTestCaseSuccess) && (FwSchedAddSm(sched, smDesc[0], FW_SCHED_ANY_WORKER) != 0))
+		outcome = smTestCaseFailure;
+
+	/* Each cycle executes each state machine exactly once */
+	for (i = 0; (i < 50) && (outcome == smTestCaseSuccess); i++)
+		FwSchedRun(sched);
+	for (j = 0; (j < nOfSms) && (outcome == smTestCaseSuccess); j++)
+		if ((FwSmGetExecCnt(smDesc[j]) != 50) || (FwSmGetStateExecCnt(smDesc[j]) != 50) ||
+		        (FwSmGetCurState(smDesc[j]) != 1))
+			outcome = smTestCaseFailure;
+	if ((outcome == smTestCaseSuccess) && (FwSchedGetNOfCycles(sched) != 50))
+		outcome = smTestCaseFailure;
+
+	/* Serial mode gives the same result */
+	FwSchedSetMode(sched, schedSerial);
+	for (i = 0; (i < 10) && (outcome == smTestCaseSuccess); i++)
+		FwSchedRun(sched);
+	for (j = 0; (j < nOfSms) && (outcome == smTestCaseSuccess); j++)
+		if (FwSmGetExecCnt(smDesc[j]) != 60)
+			outcome = smTestCaseFailure;
+	if ((outcome == smTestCaseSuccess) && (FwSchedGetNOfCycles(sched) != 60))
+		outcome = smTestCaseFailure;
+
+	FwSchedRelease(sched);
+	for (j = 0; j < nOfSms; j++)
+		FwSmRelease(smDesc[j]);
+	return outcome;
+}
+
+/**
+ * Guard used by the guard memo test case (see <code>::FwSmTestCaseMemo1</code>).
+ * The guard increments counter_1 by 1 and returns flag_1.
+ * @param smDesc the state machine descriptor
+ * @return the value of flag_1
+ */
+static FwSmBool_t SmMemoGuard1(FwSmDesc_t smDesc) {
+	struct TestSmData* smData = (struct TestSmData*)FwSmGetData(smDesc);
+	smData->counter_1 += 1;
+	return smData->flag_1;
+}
+
+/**
+ * Guard used by the guard memo test case (see <code>::FwSmTestCaseMemo1</code>).
+ * The guard increments counter_1 by 10 and returns flag_2.
+ * @param smDesc the state machine descriptor
+ * @return the value of flag_2
+ */
+static FwSmBool_t SmMemoGuard2(FwSmDesc_t smDesc) {
+	struct TestSmData* smData = (struct TestSmData*)FwSmGetData(smDesc);
+	smData->counter_1 += 10;
+	return smData->flag_2;
+}
+
+/**
+ * Action used by the guard memo test case (see <code>::FwSmTestCaseMemo1</code>).
+ * The action increments counter_2.
+ * @param smDesc the state machine descriptor
+ */
+static void SmMemoAction(FwSmDesc_t smDesc) {
+	((struct TestSmData*)FwSmGetData(smDesc))->counter_2++;
+}
+
+/**
+ * Create the state machine of the guard memo test case (see <code>::FwSmTestCaseMemo1</code>).
+ * The state machine has three states S1, S2 and S3 and one choice pseudo-state C1.
+ * Trigger TR1 causes a transition from S1 to S2 with guard <code>SmMemoGuard1</code>
+ * or from S1 to C1 with guard <code>SmMemoGuard2</code>.
+ * The transitions out of C1 go to S2 with guard <code>SmMemoGuard1</code> and to
+ * S3 with guard <code>SmMemoGuard2</code>.
+ * Trigger TR2 causes a transition from S2 and S3 back to S1.
+ * @param smData the state machine data
+ * @param trAction the action of the transition from S1 to C1
+ * @return the descriptor of the state machine or NULL if it could not be created
+ */
+static FwSmDesc_t SmMemoMake(struct TestSmData* smData, FwSmAction_t trAction) {
+	FwSmDesc_t smDesc = FwSmCreate(3, 1, 7, (trAction == NULL) ? 0 : 1, 2);
+	if (smDesc == NULL)
+		return NULL;
+	FwSmSetData(smDesc, smData);
+	FwSmAddState(smDesc, 1, 2, NULL, NULL, NULL, NULL);
+	FwSmAddState(smDesc, 2, 1, NULL, NULL, NULL, NULL);
+	FwSmAddState(smDesc, 3, 1, NULL, NULL, NULL, NULL);
+	FwSmAddChoicePseudoState(smDesc, 1, 2);
+	FwSmAddTransIpsToSta(smDesc, 1, NULL);
+	FwSmAddTransStaToSta(smDesc, TR1, 1, 2, NULL, &SmMemoGuard1);
+	FwSmAddTransStaToCps(smDesc, TR1, 1, 1, trAction, &SmMemoGuard2);
+	FwSmAddTransCpsToSta(smDesc, 1, 2, NULL, &SmMemoGuard1);
+	FwSmAddTransCpsToSta(smDesc, 1, 3, NULL, &SmMemoGuard2);
+	FwSmAddTransStaToSta(smDesc, TR2, 2, 1, NULL, NULL);
+	FwSmAddTransStaToSta(smDesc, TR2, 3, 1, NULL, NULL);
+	if (FwSmCheck(smDesc) != smSuccess) {
+		FwSmRelease(smDesc);
+		return NULL;
+	}
+	return smDesc;
+}
+
+/*------------------------------------------------------------------------------------------------- */
+FwSmTestOutcome_t FwSmTestCaseMemo1() {
+	struct TestSmData smData = {0, 0, 0, 1, 0, 0};
+	FwSmDesc_t smDesc, smDescAct, smDescDer;
+	FwSmTestOutcome_t outcome = smTestCaseSuccess;
+
+	smDesc = SmMemoMake(&smData, NULL);
+	if (smDesc == NULL)
+		return smTestCaseFailure;
+
+	/* Without guard memo, the guards out of S1 and C1 are called twice */
+	FwSmStart(smDesc);
+	FwSmMakeTrans(smDesc, TR1);
+	if ((FwSmGetCurState(smDesc) != 3) || (smData.counter_1 != 22) || (smDesc->memo != NULL))
+		outcome = smTestCaseFailure;
+
+	/* Guards which are not in the state machine cannot be marked */
+	if ((outcome == smTestCaseSuccess) && ((FwSmSetGuardPure(smDesc, &SmCfgIndexGuard1, 1) != smUndefGuard) ||
+	                                       (FwSmSetGuardPure(smDesc, NULL, 1) != smUndefGuard) || (smDesc->memo != NULL)))
+		outcome = smTestCaseFailure;
+
+	/* With pure guards, each guard is called once */
+	if ((outcome == smTestCaseSuccess) && ((FwSmSetGuardPure(smDesc, &SmMemoGuard1, 1) != smSuccess) ||
+	                                       (FwSmSetGuardPure(smDesc, &SmMemoGuard2, 1) != smSuccess) ||
+	                                       (smDesc->memo == NULL)))
+		outcome = smTestCaseFailure;
+	FwSmMakeTrans(smDesc, TR2);
+	smData.counter_1 = 0;
+	FwSmMakeTrans(smDesc, TR1);
+	if ((outcome == smTestCaseSuccess) && ((FwSmGetCurState(smDesc) != 3) || (smData.counter_1 != 11)))
+		outcome = smTestCaseFailure;
+
+	/* The outcomes cached in one transition command are not used in the next one */
+	FwSmMakeTrans(smDesc, TR2);
+	smData.counter_1 = 0;
+	smData.flag_1    = 1;
+	FwSmMakeTrans(smDesc, TR1);
+	if ((outcome == smTestCaseSuccess) && ((FwSmGetCurState(smDesc) != 2) || (smData.counter_1 != 1)))
+		outcome = smTestCaseFailure;
+
+	/* Without the mark, a guard is called again */
+	FwSmMakeTrans(smDesc, TR2);
+	smData.counter_1 = 0;
+	smData.flag_1    = 0;
+	if ((outcome == smTestCaseSuccess) && (FwSmSetGuardPure(smDesc, &SmMemoGuard1, 0) != smSuccess))
+		outcome = smTestCaseFailure;
+	FwSmMakeTrans(smDesc, TR1);
+	if ((outcome == smTestCaseSuccess) && ((FwSmGetCurState(smDesc) != 3) || (smData.counter_1 != 12)))
+		outcome = smTestCaseFailure;
+
+	/* The mark is neither inherited nor kept when the guard is overridden */
+	smDescDer = FwSmCreateDer(smDesc);
+	if ((smDescDer == NULL) || (smDescDer->memo != NULL)) {
+		FwSmRelease(smDesc);
+		return smTestCaseFailure;
+	}
+	if ((outcome == smTestCaseSuccess) && ((FwSmSetGuardPure(smDescDer, &SmMemoGuard2, 1) != smSuccess) ||
+	                                       ((smDescDer->memo->pure[0] & 4) == 0)))
+		outcome = smTestCaseFailure;
+	FwSmOverrideGuard(smDescDer, &SmMemoGuard2, &SmMemoGuard1);
+	if ((outcome == smTestCaseSuccess) &&
+	        ((FwSmGetErrCode(smDescDer) != smSuccess) || ((smDescDer->memo->pure[0] & 4) != 0)))
+		outcome = smTestCaseFailure;
+	FwSmReleaseDer(smDescDer);
+	FwSmRelease(smDesc);
+
+	/* A transition action discards the cached outcomes */
+	smDescAct = SmMemoMake(&smData, &SmMemoAction);
+	if (smDescAct == NULL)
+		return smTestCaseFailure;
+	FwSmSetGuardPure(smDescAct, &SmMemoGuard1, 1);
+	FwSmSetGuardPure(smDescAct, &SmMemoGuard2, 1);
+	smData.counter_1 = 0;
+	smData.counter_2 = 0;
+	FwSmStart(smDescAct);
+	FwSmMakeTrans(smDescAct, TR1);
+	if ((outcome == smTestCaseSuccess) &&
+	        ((FwSmGetCurState(smDescAct) != 3) || (smData.counter_1 != 22) || (smData.counter_2 != 1)))
+		outcome = smTestCaseFailure;
+
+	/* The guard memo also works on a compiled state machine */
+	FwSmMakeTrans(smDescAct, TR2);
+	smData.counter_1 = 0;
+	if ((outcome == smTestCaseSuccess) && (FwSmCompile(smDescAct) != smSuccess))
+		outcome = smTestCaseFailure;
+	FwSmMakeTrans(smDescAct, TR1);
+	if ((outcome == smTestCaseSuccess) && ((FwSmGetCurState(smDescAct) != 3) || (smData.counter_1 != 22)))
+		outcome = smTestCaseFailure;
+
+	FwSmRelease(smDescAct);
+	return outcome;
+}
+
+/*------------------------------------------------------------------------------------------------- */
+FwSmTestOutcome_t FwSmTestCaseSnap1() {
+	struct TestSmData smData = {0, 0, 0, 0, 0, 0};
+	struct TestSmData esmData = {0, 0, 1, 0, 0, 0};
+	struct TestSmData sm1Data = {0, 0, 0, 0, 0, 0};
+	unsigned char ref[128];
+	unsigned char first[128];
+	unsigned char delta[128];
+	FwSmDesc_t smDesc, esmDesc, smDesc1;
+	FwSmCounterU4_t size, recSize, hdrSize, deltaSize;
+	FwSmTestOutcome_t outcome = smTestCaseSuccess;
+
+	/* SM3 is a hierarchy of two state machines (SM1 with SM2 embedded in S1) */
+	smDesc = FwSmMakeTestSM3(&smData, &esmData);
+	smDesc1 = FwSmMakeTestSM1(&sm1Data);
+	if ((smDesc == NULL) || (smDesc1 == NULL))
+		return smTestCaseFailure;
+	esmDesc = FwSmGetEmbSm(smDesc, STATE_S1);
+	size = FwSmSnapGetSize(smDesc);
+	recSize = size - FwSmSnapGetSize(smDesc1);
+	hdrSize = size - 2 * recSize;
+	if ((esmDesc == NULL) || (size > sizeof(ref)) || (recSize == 0))
+		outcome = smTestCaseFailure;
+
+	/* A full snapshot needs a large enough buffer (which needs not be aligned) */
+	if ((outcome == smTestCaseSuccess) && ((FwSmSnapTake(smDesc, ref + 1, size - 1) != 0) ||
+	                                       (FwSmSnapTake(smDesc, NULL, size) != 0)))
+		outcome = smTestCaseFailure;
+	FwSmStart(smDesc);
+	FwSmExecute(smDesc);
+	if ((outcome == smTestCaseSuccess) &&
+	        ((FwSmSnapTake(smDesc, ref + 1, size) != size) || (FwSmSnapTake(smDesc, first, size) != size)))
+		outcome = smTestCaseFailure;
+
+	/* A delta snapshot of an unchanged hierarchy holds no records */
+	if ((outcome == smTestCaseSuccess) && (FwSmSnapTakeDelta(smDesc, ref + 1, size, delta, size) != hdrSize))
+		outcome = smTestCaseFailure;
+
+	/* A delta snapshot only holds the state machines which have changed */
+	FwSmExecute(esmDesc);
+	FwSmExecute(esmDesc);
+	if ((outcome == smTestCaseSuccess) && (FwSmSnapTakeDelta(smDesc, ref + 1, size, delta, hdrSize) != 0))
+		outcome = smTestCaseFailure;
+	if ((outcome == smTestCaseSuccess) && (memcmp(ref + 1, first, size) != 0))
+		outcome = smTestCaseFailure;
+	deltaSize = FwSmSnapTakeDelta(smDesc, ref + 1, size, delta + 3, sizeof(delta) - 3);
+	if ((outcome == smTestCaseSuccess) && ((deltaSize != hdrSize + recSize) || (memcmp(ref + 1, first, size) == 0)))
+		outcome = smTestCaseFailure;
+
+	/* The reference snapshot is brought up to date by the delta snapshot */
+	if ((outcome == smTestCaseSuccess) && (FwSmSnapTakeDelta(smDesc, ref + 1, size, delta + 64, 64) != hdrSize))
+		outcome = smTestCaseFailure;
+
+	/* Snapshots which do not match the hierarchy are rejected */
+	if ((outcome == smTestCaseSuccess) &&
+	        ((FwSmSnapRestore(smDesc1, first, size) != 0) || (FwSmSnapRestore(smDesc, first, size - 1) != 0) ||
+	         (FwSmSnapRestore(smDesc, delta + 3, deltaSize + recSize) != 0) ||
+	         (FwSmSnapTakeDelta(smDesc, delta + 3, deltaSize, delta + 64, 64) != 0)))
+		outcome = smTestCaseFailure;
+	first[0] = (unsigned char)(first[0] ^ 0xFF);
+	if ((outcome == smTestCaseSuccess) && (FwSmSnapRestore(smDesc, first, size) != 0))
+		outcome = smTestCaseFailure;
+	first[0] = (unsigned char)(first[0] ^ 0xFF);
+
+	/* The checkpoint is restored from the first full snapshot and the delta snapshot without executing actions */
+	FwSmExecute(smDesc);
+	esmData.flag_2 = 1;
+	FwSmMakeTrans(esmDesc, TR_S1_FPS);
+	smData.counter_1 = 0;
+	esmData.counter_1 = 0;
+	if ((outcome == smTestCaseSuccess) && (FwSmIsStarted(esmDesc) != 0))
+		outcome = smTestCaseFailure;
+	if ((outcome == smTestCaseSuccess) &&
+	        ((FwSmSnapRestore(smDesc, first, size) != 1) || (FwSmSnapRestore(smDesc, delta + 3, deltaSize) != 1)))
+		outcome = smTestCaseFailure;
+	if ((outcome == smTestCaseSuccess) &&
+	        ((FwSmGetCurState(smDesc) != STATE_S1) || (FwSmGetCurState(esmDesc) != STATE_S1) ||
+	         (FwSmGetExecCnt(smDesc) != 1) || (FwSmGetExecCnt(esmDesc) != 3) || (FwSmGetStateExecCnt(esmDesc) != 3) ||
+	         (smData.counter_1 != 0) || (esmData.counter_1 != 0)))
+		outcome = smTestCaseFailure;
+
+	/* The reference snapshot can also be restored directly */
+	FwSmStop(smDesc);
+	if ((outcome == smTestCaseSuccess) && ((FwSmSnapRestore(smDesc, ref + 1, size) != 1) ||
+	                                       (FwSmGetCurState(smDesc) != STATE_S1) || (FwSmGetCurState(esmDesc) != STATE_S1)))
+		outcome = smTestCaseFailure;
+
+	FwSmReleaseRec(smDesc);
+	FwSmRelease(smDesc1);
+	return outcome;
+}
+
+/*------------------------------------------------------------------------------------------------- */
+FwSmTestOutcome_t FwSmTestCaseNotify1() {
+	struct TestSmData smData = {0, 0, 0, 0, 0, 0};
+	struct TestSmData esmData = {0, 0, 1, 0, 0, 0};
+	struct TestSmData sm1Data = {0, 0, 0, 0, 0, 0};
+	FwSmDesc_t buffer[1];
+	FwSmChangeList_t list;
+	FwSmDesc_t smDesc, esmDesc, smDesc1;
+	FwSmTestOutcome_t outcome = smTestCaseSuccess;
+
+	smDesc = FwSmMakeTestSM3(&smData, &esmData);
+	smDesc1 = FwSmMakeTestSM1(&sm1Data);
+	if ((smDesc == NULL) || (smDesc1 == NULL))
+		return smTestCaseFailure;
+	esmDesc = FwSmGetEmbSm(smDesc, STATE_S1);
+	FwSmInitChangeList(&list, buffer, 1);
+
+	/* Without change notification, the changes are not counted */
+	FwSmStart(smDesc);
+	FwSmStop(smDesc);
+	if ((FwSmGetChangeSeq(smDesc) != 0) || (smDesc->notify != NULL) || (list.nOfChanged != 0))
+		outcome = smTestCaseFailure;
+
+	/* The changes of the embedded state machine are reported to the owner which is listed once */
+	FwSmEnableNotify(smDesc, &list);
+	FwSmEnableNotify(smDesc1, &list);
+	FwSmStart(smDesc);
+	if ((outcome == smTestCaseSuccess) &&
+	        ((FwSmGetChangeSeq(smDesc) != 2) || (FwSmGetChangeSeq(esmDesc) != 2) || (list.nOfChanged != 1) ||
+	         (list.smDescs[0] != smDesc) || (list.nOfLost != 0)))
+		outcome = smTestCaseFailure;
+
+	/* A change which does not fit in the change list is counted as lost */
+	FwSmStart(smDesc1);
+	if ((outcome == smTestCaseSuccess) &&
+	        ((FwSmGetChangeSeq(smDesc1) != 1) || (list.nOfChanged != 1) || (list.nOfLost != 1)))
+		outcome = smTestCaseFailure;
+	FwSmClearChangeList(&list);
+	if ((outcome == smTestCaseSuccess) && ((list.nOfChanged != 0) || (list.nOfLost != 0)))
+		outcome = smTestCaseFailure;
+
+	/* Executions which do not change the current states are not reported */
+	FwSmExecute(smDesc);
+	FwSmExecute(smDesc);
+	if ((outcome == smTestCaseSuccess) && ((FwSmGetChangeSeq(smDesc) != 2) || (list.nOfChanged != 0)))
+		outcome = smTestCaseFailure;
+
+	/* Transitions to the final pseudo-state and stop operations are reported */
+	esmData.flag_2 = 1;
+	FwSmMakeTrans(esmDesc, TR_S1_FPS);
+	FwSmStop(smDesc);
+	FwSmStop(smDesc1);
+	if ((outcome == smTestCaseSuccess) &&
+	        ((FwSmGetChangeSeq(smDesc) != 4) || (FwSmGetChangeSeq(smDesc1) != 2) || (list.nOfChanged != 1) ||
+	         (list.smDescs[0] != smDesc)))
+		outcome = smTestCaseFailure;
+
+	/* Disabling change notification removes the state machine from the change list */
+	FwSmDisableNotify(smDesc);
+	if ((outcome == smTestCaseSuccess) && ((FwSmGetChangeSeq(esmDesc) != 0) || (esmDesc->notify != NULL) ||
+	                                       (list.nOfChanged != 0)))
+		outcome = smTestCaseFailure;
+
+	/* Releasing a state machine also removes it from the change list */
+	FwSmClearChangeList(&list);
+	FwSmEnableNotify(smDesc1, &list);
+	FwSmStart(smDesc1);
+	if ((outcome == smTestCaseSuccess) && ((list.nOfChanged != 1) || (FwSmGetChangeSeq(smDesc1) != 1)))
+		outcome = smTestCaseFailure;
+	FwSmRelease(smDesc1);
+	if ((outcome == smTestCaseSuccess) && (list.nOfChanged != 0))
+		outcome = smTestCaseFailure;
+
+	FwSmReleaseRec(smDesc);
+	return outcome;
+}
+
+/*------------------------------------------------------------------------------------------------- */
+FwSmTestOutcome_t FwSmTestCaseFlat1() {
+	struct TestSmData smData = {0, 0, 0, 0, 0, 0};
+	struct TestSmData esmData = {0, 0, 0, 0, 0, 0};
+	struct TestSmData refData = {0, 0, 0, 0, 0, 0};
+	struct TestSmData refEsmData = {0, 0, 0, 0, 0, 0};
+	/* The commands sent to the hierarchies (-1 stands for "start" and -2 for "stop") */
+	const int cmd[] = {-1, FW_TR_EXECUTE, FW_TR_EXECUTE, TR2, TR6, TR4, TR2, TR6, FW_TR_EXECUTE, TR5,
+	                   FW_TR_EXECUTE, TR4, FW_TR_EXECUTE, FW_TR_EXECUTE, -2, -1, FW_TR_EXECUTE, TR3, FW_TR_EXECUTE};
+	const int flag1[] = {0, 0, 1, 1, 0, 1, 1, 0, 0, 1, 0, 1, 1, 1, 0, 0, 1, 1, 1};
+	const int flag2[] = {0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
+	const int nOfCmds = (int)(sizeof(cmd) / sizeof(cmd[0]));
+	int refMarker[LOG_ARRAY_SIZE];
+	int refState[LOG_ARRAY_SIZE];
+	int nOfRefLogs, i, j;
+	FwSmDesc_t smDesc, esmDesc, refDesc, refEsmDesc;
+	FwSmChangeList_t list;
+	FwSmDesc_t buffer[1];
+	FwSmFlatDesc_t flat;
+	FwSmTestOutcome_t outcome = smTestCaseSuccess;
+
+	/* SM6 is a hierarchy of two state machines (SM4 with SM5 embedded in S2) */
+	smDesc = FwSmMakeTestSM6(&smData, &esmData);
+	refDesc = FwSmMakeTestSM6(&refData, &refEsmData);
+	if ((smDesc == NULL) || (refDesc == NULL))
+		return smTestCaseFailure;
+	esmDesc = FwSmGetEmbSm(smDesc, STATE_S2);
+	refEsmDesc = FwSmGetEmbSm(refDesc, STATE_S2);
+
+	/* A hierarchy with change notification enabled cannot be flattened */
+	FwSmInitChangeList(&list, buffer, 1);
+	FwSmEnableNotify(smDesc, &list);
+	if (FwSmFlatCreate(smDesc) != NULL)
+		outcome = smTestCaseFailure;
+	FwSmDisableNotify(smDesc);
+
+	/* There is one configuration for each state in the hierarchy plus the root configuration */
+	flat = FwSmFlatCreate(smDesc);
+	if (flat == NULL) {
+		FwSmReleaseRec(smDesc);
+		FwSmReleaseRec(refDesc);
+		return smTestCaseFailure;
+	}
+	if ((outcome == smTestCaseSuccess) &&
+	        ((FwSmFlatGetNOfConfigs(flat) != 5) || (FwSmFlatGetNOfLevels(flat) != 0) ||
+	         (FwSmFlatGetCurState(flat) != 0) || (FwSmFlatGetCurStateEmb(flat) != -1)))
+		outcome = smTestCaseFailure;
+
+	/* The flat hierarchy executes the same actions in the same order as the reference hierarchy */
+	for (i = 0; (i < nOfCmds) && (outcome == smTestCaseSuccess); i++) {
+		refData.flag_1 = flag1[i];
+		refEsmData.flag_1 = flag1[i];
+		refEsmData.flag_2 = flag2[i];
+		smData.flag_1 = flag1[i];
+		esmData.flag_1 = flag1[i];
+		esmData.flag_2 = flag2[i];
+
+		fwSm_logIndex = 0;
+		if (cmd[i] == -1)
+			FwSmStart(refDesc);
+		else if (cmd[i] == -2)
+			FwSmStop(refDesc);
+		else
+			FwSmMakeTrans(refDesc, (FwSmCounterU2_t)cmd[i]);
+		nOfRefLogs = fwSm_logIndex;
+		memcpy(refMarker, fwSm_logMarker, sizeof(refMarker));
+		memcpy(refState, fwSm_logState, sizeof(refState));
+
+		fwSm_logIndex = 0;
+		if (cmd[i] == -1)
+			FwSmFlatStart(flat);
+		else if (cmd[i] == -2)
+			FwSmFlatStop(flat);
+		else if (cmd[i] == FW_TR_EXECUTE)
+			FwSmFlatExecute(flat);
+		else
+			FwSmFlatMakeTrans(flat, (FwSmCounterU2_t)cmd[i]);
+
+		if (fwSm_logIndex != nOfRefLogs)
+			outcome = smTestCaseFailure;
+		for (j = 0; (j < nOfRefLogs) && (outcome == smTestCaseSuccess); j++)
+			if ((fwSm_logMarker[j] != refMarker[j]) || (fwSm_logState[j] != refState[j]))
+				outcome = smTestCaseFailure;
+		if ((outcome == smTestCaseSuccess) &&
+		        ((FwSmGetCurState(smDesc) != FwSmGetCurState(refDesc)) ||
+		         (FwSmGetCurState(esmDesc) != FwSmGetCurState(refEsmDesc)) ||
+		         (FwSmFlatGetCurState(flat) != FwSmGetCurState(refDesc)) ||
+		         (FwSmFlatGetCurStateEmb(flat) != FwSmGetCurStateEmb(refDesc)) ||
+		         (FwSmGetExecCnt(smDesc) != FwSmGetExecCnt(refDesc)) ||
+		         (FwSmGetStateExecCnt(smDesc) != FwSmGetStateExecCnt(refDesc)) ||
+		         (FwSmGetExecCnt(esmDesc) != FwSmGetExecCnt(refEsmDesc)) ||
+		         (FwSmGetStateExecCnt(esmDesc) != FwSmGetStateExecCnt(refEsmDesc)) ||
+		         (FwSmGetErrCode(esmDesc) != FwSmGetErrCode(refEsmDesc)) ||
+		         (smData.counter_1 != refData.counter_1) || (smData.counter_2 != refData.counter_2) ||
+		         (esmData.counter_1 != refEsmData.counter_1) || (esmData.counter_2 != refEsmData.counter_2)))
+			outcome = smTestCaseFailure;
+	}
+	/* The sequence of commands includes a transition which fails in a choice pseudo-state */
+	if ((outcome == smTestCaseSuccess) && (FwSmGetErrCode(esmDesc) != smTransErr))
+		outcome = smTestCaseFailure;
+
+	/* The current configuration is re-computed after the hierarchy has been changed directly */
+	FwSmStart(smDesc);
+	FwSmFlatSync(flat);
+	if ((outcome == smTestCaseSuccess) &&
+	        ((FwSmFlatGetNOfLevels(flat) != 1) || (FwSmFlatGetCurStateAt(flat, 0) != STATE_S1) ||
+	         (FwSmFlatGetCurStateAt(flat, 1) != -1) || (FwSmFlatGetSmAt(flat, 0) != smDesc) ||
+	         (FwSmFlatGetSmAt(flat, 1) != NULL)))
+		outcome = smTestCaseFailure;
+	smData.flag_1 = 1;
+	FwSmFlatExecute(flat);
+	if ((outcome == smTestCaseSuccess) &&
+	        ((FwSmFlatGetNOfLevels(flat) != 2) || (FwSmFlatGetCurStateAt(flat, 1) != STATE_S1) ||
+	         (FwSmFlatGetCurStateAt(flat, 2) != -1) || (FwSmFlatGetSmAt(flat, 1) != esmDesc) ||
+	         (FwSmFlatGetCurStateEmb(flat) != FwSmGetCurStateEmb(smDesc))))
+		outcome = smTestCaseFailure;
+
+	FwSmFlatRelease(flat);
+	FwSmReleaseRec(smDesc);
+	FwSmReleaseRec(refDesc);
+	return outcome;
+}
+
+/*------------------------------------------------------------------------------------------------- */
+FwSmTestOutcome_t FwSmTestCaseBcast1() {
+	struct TestSmData smData1 = {0, 0, 0, 0, 0, 0};
+	struct TestSmData esmData1 = {0, 0, 0, 0, 0, 0};
+	struct TestSmData smData2 = {0, 0, 0, 0, 0, 0};
+	struct TestSmData esmData2 = {0, 0, 0, 0, 0, 0};
+	struct TestSmData smData3 = {0, 0, 0, 0, 0, 0};
+	const FwSmCounterU2_t transIds[3] = {TR2, TR3, FW_TR_EXECUTE};
+	FwSmDesc_t smDesc1, smDesc2, smDesc3, esmDesc1;
+	FwSmBcastDesc_t bcast;
+	FwSmTestOutcome_t outcome = smTestCaseSuccess;
+
+	/* SM6 is a hierarchy of two state machines (SM4 with SM5 embedded in S2) */
+	smDesc1 = FwSmMakeTestSM6(&smData1, &esmData1);
+	smDesc2 = FwSmMakeTestSM6(&smData2, &esmData2);
+	smDesc3 = FwSmMakeTestSM1(&smData3);
+	bcast = FwSmBcastCreate(transIds, 3, 3);
+	if ((smDesc1 == NULL) || (smDesc2 == NULL) || (smDesc3 == NULL) || (bcast == NULL))
+		return smTestCaseFailure;
+	esmDesc1 = FwSmGetEmbSm(smDesc1, STATE_S2);
+	if (FwSmBcastCreate(transIds, 0, 3) != NULL)
+		outcome = smTestCaseFailure;
+
+	/* A state machine can only be in one registry and the registry has a maximum size */
+	if ((outcome == smTestCaseSuccess) &&
+	        ((FwSmBcastAdd(bcast, smDesc1) != smSuccess) || (FwSmBcastAdd(bcast, smDesc1) != smBcastBusy) ||
+	         (FwSmBcastAdd(bcast, esmDesc1) != smBcastBusy) || (FwSmBcastAdd(bcast, smDesc2) != smSuccess) ||
+	         (FwSmBcastAdd(bcast, smDesc3) != smSuccess) || (FwSmBcastAdd(bcast, smDesc3) != smBcastFull) ||
+	         (FwSmBcastGetNOfSms(bcast) != 3) || (esmDesc1->bcast == NULL)))
+		outcome = smTestCaseFailure;
+
+	/* Stopped hierarchies do not subscribe to any trigger and started hierarchies subscribe to "Execute" */
+	if ((outcome == smTestCaseSuccess) &&
+	        ((FwSmBcastGetNOfSubs(bcast, TR2) != 0) || (FwSmBcastGetNOfSubs(bcast, FW_TR_EXECUTE) != 0)))
+		outcome = smTestCaseFailure;
+	fwSm_logIndex = 0;
+	FwSmStart(smDesc1);
+	FwSmStart(smDesc2);
+	FwSmStart(smDesc3);
+	if ((outcome == smTestCaseSuccess) &&
+	        ((FwSmBcastGetNOfSubs(bcast, TR2) != 0) || (FwSmBcastGetNOfSubs(bcast, TR3) != 0) ||
+	         (FwSmBcastGetNOfSubs(bcast, FW_TR_EXECUTE) != 3) || (FwSmBcastGetNOfSubs(bcast, TR4) != 3)))
+		outcome = smTestCaseFailure;
+
+	/* A change of state made through the Core module updates the subscriptions (including the embedded SM) */
+	smData1.flag_1 = 1;
+	FwSmExecute(smDesc1);
+	if ((outcome == smTestCaseSuccess) &&
+	        ((FwSmGetCurState(smDesc1) != STATE_S2) || (FwSmGetCurState(esmDesc1) != STATE_S1) ||
+	         (FwSmBcastGetNOfSubs(bcast, TR2) != 1) || (FwSmBcastGetNOfSubs(bcast, TR3) != 1)))
+		outcome = smTestCaseFailure;
+
+	/* A broadcast trigger is only sent to the subscribed hierarchies */
+	esmData1.flag_1 = 1;
+	smData2.counter_1 = 0;
+	fwSm_logIndex = 0;
+	if ((outcome == smTestCaseSuccess) &&
+	        ((FwSmBcastMakeTrans(bcast, TR2) != 1) || (FwSmGetCurState(esmDesc1) != STATE_S2) ||
+	         (FwSmBcastGetNOfSubs(bcast, TR2) != 0) || (FwSmBcastGetNOfSubs(bcast, TR3) != 1)))
+		outcome = smTestCaseFailure;
+	fwSm_logIndex = 0;
+	if ((outcome == smTestCaseSuccess) &&
+	        ((FwSmBcastMakeTrans(bcast, TR3) != 1) || (FwSmIsStarted(smDesc1) != 0) ||
+	         (FwSmIsStarted(esmDesc1) != 0) || (FwSmBcastGetNOfSubs(bcast, TR3) != 0)))
+		outcome = smTestCaseFailure;
+	fwSm_logIndex = 0;
+	if ((outcome == smTestCaseSuccess) &&
+	        ((FwSmBcastMakeTrans(bcast, FW_TR_EXECUTE) != 2) || (FwSmGetExecCnt(smDesc1) != 1) ||
+	         (FwSmGetExecCnt(smDesc2) != 1) || (FwSmGetExecCnt(smDesc3) != 1) || (smData2.counter_1 != 2)))
+		outcome = smTestCaseFailure;
+
+	/* A trigger which is not a broadcast trigger is sent to all hierarchies */
+	smData3.flag_1 = 1;
+	fwSm_logIndex = 0;
+	if ((outcome == smTestCaseSuccess) &&
+	        ((FwSmBcastMakeTrans(bcast, TR_S1_FPS) != 3) || (FwSmIsStarted(smDesc3) != 0) ||
+	         (FwSmBcastGetNOfSubs(bcast, FW_TR_EXECUTE) != 1)))
+		outcome = smTestCaseFailure;
+
+	/* Releasing the registry unlinks its state machines */
+	FwSmBcastRelease(bcast);
+	if ((outcome == smTestCaseSuccess) &&
+	        ((smDesc1->bcast != NULL) || (esmDesc1->bcast != NULL) || (smDesc3->bcast != NULL)))
+		outcome = smTestCaseFailure;
+
+	FwSmReleaseRec(smDesc1);
+	FwSmReleaseRec(smDesc2);
+	FwSmRelease(smDesc3);
+	return outcome;
+}
+
+/*------------------------------------------------------------------------------------------------- */
+FwSmTestOutcome_t FwSmTestCaseExecInert1() {
+	struct TestSmData smData1 = {0, 0, 1, 0, 0, 0};
+	struct TestSmData smData2 = {0, 0, 1, 0, 0, 0};
+	struct TestSmData smData4 = {0, 0, 0, 0, 0, 0};
+	FwSmDesc_t smDesc1, smDesc2, derSmDesc, smDesc4;
+	FwSmGroupDesc_t group;
+	FwSmTestOutcome_t outcome = smTestCaseSuccess;
+	FwTraceEvent_t events[8];
+	FwTraceEvent_t drained[8];
+	struct FwTraceRing ring;
+	int i, counter_2;
+
+	/* The states of SM14 have no do-action and no "Execute" transition */
+	smDesc1 = FwSmMakeTestSM14(&smData1);
+	smDesc2 = FwSmMakeTestSM14(&smData2);
+	smDesc4 = FwSmMakeTestSM4(&smData4);
+	derSmDesc = FwSmCreateDer(smDesc2);
+	FwSmSetData(derSmDesc, &smData2);
+	FwSmEmbed(derSmDesc, STATE_S1, smDesc1);
+
+	/* The execute-inert flags are set by the configuration functions (the configuration check does not modify them) */
+	fwSm_logIndex = 0;
+	FwSmStart(smDesc1);
+	if ((FwSmGetCurState(smDesc1) != STATE_S1) || (FwSmIsExecInert(smDesc1) != 1))
+		outcome = smTestCaseFailure;
+	FwSmStop(smDesc1);
+	if ((outcome == smTestCaseSuccess) &&
+	        ((FwSmCheck(smDesc1) != smSuccess) || (FwSmCheck(smDesc2) != smSuccess) ||
+	         (FwSmCheck(derSmDesc) != smSuccess) || (FwSmCheck(smDesc4) != smSuccess)))
+		outcome = smTestCaseFailure;
+
+	/* A stopped state machine and a state with "Execute" transitions are not execute-inert */
+	if ((outcome == smTestCaseSuccess) && ((FwSmIsExecInert(smDesc1) != 0) || (FwSmIsExecInert(smDesc4) != 0)))
+		outcome = smTestCaseFailure;
+	FwSmStart(smDesc4);
+	if ((outcome == smTestCaseSuccess) && (FwSmIsExecInert(smDesc4) != 0))
+		outcome = smTestCaseFailure;
+
+	/* Executing an execute-inert state only updates the execution counters */
+	fwSm_logIndex = 0;
+	FwSmStart(smDesc1);
+	counter_2 = smData1.counter_2;
+	for (i=0; i<3; i++)
+		FwSmExecute(smDesc1);
+	if ((outcome == smTestCaseSuccess) &&
+	        ((FwSmIsExecInert(smDesc1) != 1) || (FwSmGetCurState(smDesc1) != STATE_S1) ||
+	         (FwSmGetExecCnt(smDesc1) != 3) || (FwSmGetStateExecCnt(smDesc1) != 3) ||
+	         (smData1.counter_1 != 0) || (smData1.counter_2 != counter_2)))
+		outcome = smTestCaseFailure;
+	FwSmStop(smDesc1);
+
+	/* A hierarchy is execute-inert if its embedded state machine is stopped or execute-inert */
+	fwSm_logIndex = 0;
+	FwSmStart(derSmDesc);
+	if ((outcome == smTestCaseSuccess) &&
+	        ((FwSmGetCurState(derSmDesc) != STATE_S1) || (FwSmGetCurState(smDesc1) != STATE_S1) ||
+	         (FwSmIsExecInert(derSmDesc) != 1)))
+		outcome = smTestCaseFailure;
+	FwSmExecute(derSmDesc);
+	if ((outcome == smTestCaseSuccess) &&
+	        ((FwSmGetExecCnt(derSmDesc) != 1) || (FwSmGetExecCnt(smDesc1) != 1)))
+		outcome = smTestCaseFailure;
+	FwSmStop(smDesc1);
+	if ((outcome == smTestCaseSuccess) && (FwSmIsExecInert(derSmDesc) != 1))
+		outcome = smTestCaseFailure;
+	FwSmStop(derSmDesc);
+
+	/* A group skips the do-action of execute-inert states and behaves like FwSmExecute */
+	group = FwSmGroupCreate(smDesc1, 1);
+	if (group == NULL) {
+		outcome = smTestCaseFailure;
+	}
+	else {
+		FwSmGroupAdd(group, smDesc1);
+		fwSm_logIndex = 0;
+		FwSmGroupStart(group);
+		FwTraceRingInit(&ring, events, 8);
+		FwTraceSetRing(&ring);
+		FwSmGroupExecute(group);
+		FwSmGroupExecute(group);
+		FwTraceSetRing(NULL);
+		if ((outcome == smTestCaseSuccess) &&
+		        ((FwSmGetExecCnt(smDesc1) != 2) || (FwSmGetStateExecCnt(smDesc1) != 2) ||
+		         (FwSmGetCurState(smDesc1) != STATE_S1)))
+			outcome = smTestCaseFailure;
+#ifdef FW_TRACE
+		/* The group records the same events as FwSmExecute in an execute-inert state */
+		if ((outcome == smTestCaseSuccess) &&
+		        ((FwTraceDrain(&ring, drained, 8) != 2) || (drained[0].type != traceSmDoAction) ||
+		         (drained[0].id != STATE_S1) || (drained[0].desc != smDesc1) ||
+		         (drained[1].type != traceSmDoAction)))
+			outcome = smTestCaseFailure;
+#else
+		if ((outcome == smTestCaseSuccess) && (FwTraceDrain(&ring, drained, 8) != 0))
+			outcome = smTestCaseFailure;
+#endif
+		FwSmGroupRelease(group);
+	}
+
+	/* The execute-inert state is left through a transition to the final pseudo-state */
+	fwSm_logIndex = 0;
+	FwSmMakeTrans(smDesc1, TR1);
+	if ((outcome == smTestCaseSuccess) && ((FwSmIsStarted(smDesc1) != 0) || (FwSmIsExecInert(smDesc1) != 0)))
+		outcome = smTestCaseFailure;
+
+	fwSm_logIndex = 0;
+	FwSmReleaseDer(derSmDesc);
+	FwSmRelease(smDesc1);
+	FwSmRelease(smDesc2);
+	FwSmRelease(smDesc4);
+	return outcome;
+}
+
+/*------------------------------------------------------------------------------------------------- */
+FwSmTestOutcome_t FwSmTestCaseCost1() {
+	struct TestSmData smData1 = {0, 0, 1, 0, 0, 0};
+	struct TestSmData smData2 = {0, 0, 1, 0, 0, 0};
+	FwSmDesc_t smDesc1, smDesc2, derSmDesc, smDesc3;
+	FwSmCostAnnot_t annots[2];
+	FwSmCost_t cost;
+	FwSmTestOutcome_t outcome = smTestCaseSuccess;
+
+	smDesc1 = FwSmMakeTestSM14(&smData1);
+	smDesc2 = FwSmMakeTestSM14(&smData2);
+	derSmDesc = FwSmCreateDer(smDesc2);
+	FwSmSetData(derSmDesc, &smData2);
+	FwSmEmbed(derSmDesc, STATE_S1, smDesc1);
+
+	/* Start: IPS-to-CPS action, the two guards out of CPS1, the action out of CPS1 and the entry action */
+	if ((FwSmCostStart(smDesc1, NULL, 0, &cost) != smSuccess) || (cost.nOfActions != 3) ||
+	        (cost.nOfGuards != 2) || (cost.nOfLevels != 1) || (cost.cost != 4))
+		outcome = smTestCaseFailure;
+
+	/* Stop: the (dummy) exit action of the current state */
+	if ((outcome == smTestCaseSuccess) && ((FwSmCostStop(smDesc1, NULL, 0, &cost) != smSuccess) ||
+	                                       (cost.nOfActions != 1) || (cost.nOfGuards != 0) || (cost.cost != 0)))
+		outcome = smTestCaseFailure;
+
+	/* Transition TR1 out of S1: dummy guard, dummy exit action, transition action, dummy guard and action out of CPS2 */
+	if ((outcome == smTestCaseSuccess) && ((FwSmCostMakeTrans(smDesc1, STATE_S1, TR1, NULL, 0, &cost) != smSuccess) ||
+	                                       (cost.nOfActions != 3) || (cost.nOfGuards != 2) || (cost.cost != 2)))
+		outcome = smTestCaseFailure;
+	if ((outcome == smTestCaseSuccess) && ((FwSmCostMakeTrans(smDesc1, STATE_S2, TR1, NULL, 0, &cost) != smSuccess) ||
+	                                       (cost.nOfActions != 0) || (cost.nOfGuards != 0) || (cost.cost != 0)))
+		outcome = smTestCaseFailure;
+	if ((outcome == smTestCaseSuccess) && ((FwSmCostMakeTrans(smDesc1, 0, TR1, NULL, 0, &cost) != smSuccess) ||
+	                                       (cost.nOfActions != 3) || (cost.nOfGuards != 2) || (cost.cost != 2)))
+		outcome = smTestCaseFailure;
+	if ((outcome == smTestCaseSuccess) && ((FwSmCostMakeTrans(smDesc1, 0, FW_TR_EXECUTE, NULL, 0, &cost) != smSuccess) ||
+	                                       (cost.nOfActions != 1) || (cost.nOfGuards != 0) || (cost.cost != 0)))
+		outcome = smTestCaseFailure;
+
+	/* Illegal state identifiers */
+	if ((outcome == smTestCaseSuccess) && ((FwSmCostMakeTrans(smDesc1, 3, TR1, NULL, 0, &cost) != smIllStateId) ||
+	                                       (FwSmCostMakeTrans(smDesc1, -1, TR1, NULL, 0, &cost) != smIllStateId)))
+		outcome = smTestCaseFailure;
+
+	/* The cost annotations replace the default cost of the transition action and of the first guard out of CPS1 */
+	annots[0].action = smDesc1->smActions[1];
+	annots[0].guard = NULL;
+	annots[0].cost = 10;
+	annots[1].action = NULL;
+	annots[1].guard = smDesc1->smGuards[1];
+	annots[1].cost = 3;
+	if ((outcome == smTestCaseSuccess) && ((FwSmCostStart(smDesc1, annots, 2, &cost) != smSuccess) ||
+	                                       (cost.nOfActions != 3) || (cost.nOfGuards != 2) || (cost.cost != 24)))
+		outcome = smTestCaseFailure;
+
+	/* The embedded state machine is started, stopped and sent the transition commands of its embedding state */
+	if ((outcome == smTestCaseSuccess) && ((FwSmCostStart(derSmDesc, NULL, 0, &cost) != smSuccess) ||
+	                                       (cost.nOfActions != 6) || (cost.nOfGuards != 3) ||
+	                                       (cost.nOfLevels != 2) || (cost.cost != 7)))
+		outcome = smTestCaseFailure;
+	if ((outcome == smTestCaseSuccess) && ((FwSmCostStop(derSmDesc, NULL, 0, &cost) != smSuccess) ||
+	                                       (cost.nOfActions != 2) || (cost.nOfLevels != 2) || (cost.cost != 0)))
+		outcome = smTestCaseFailure;
+	if ((outcome == smTestCaseSuccess) && ((FwSmCostMakeTrans(derSmDesc, STATE_S1, TR1, NULL, 0, &cost) != smSuccess) ||
+	                                       (cost.nOfActions != 7) || (cost.nOfGuards != 4) ||
+	                                       (cost.nOfLevels != 2) || (cost.cost != 4)))
+		outcome = smTestCaseFailure;
+
+	/* A state machine which does not pass its configuration check is not analysed */
+	smDesc3 = FwSmCreate(1, 0, 1, 0, 0);
+	if ((outcome == smTestCaseSuccess) && (FwSmCostStart(smDesc3, NULL, 0, &cost) == smSuccess))
+		outcome = smTestCaseFailure;
+
+	FwSmRelease(smDesc3);
+	FwSmReleaseDer(derSmDesc);
+	FwSmRelease(smDesc1);
+	FwSmRelease(smDesc2);
+	return outcome;
+}
+
+/*------------------------------------------------------------------------------------------------- */
+FwSmTestOutcome_t FwSmTestCaseLazy1() {
+	struct TestSmData smData1 = {0, 0, 1, 0, 0, 0};
+	struct TestSmData smData2 = {0, 0, 1, 0, 0, 0};
+	FwSmDesc_t smDesc1, smDesc2, derSmDesc1, derSmDesc2, derSmDesc3, derSmDesc4, esmDesc;
+	FwSmPoolDesc_t pool;
+	FwSmCost_t cost;
+	FwSmTestOutcome_t outcome = smTestCaseSuccess;
+
+	smDesc1 = FwSmMakeTestSM14(&smData1);
+	smDesc2 = FwSmMakeTestSM14(&smData2);
+	derSmDesc1 = FwSmCreateDer(smDesc2);
+	FwSmSetData(derSmDesc1, &smData2);
+
+	/* The template is embedded but the embedded state machine is not instantiated */
+	FwSmEmbedLazy(derSmDesc1, STATE_S1, smDesc1);
+	if ((FwSmGetErrCode(derSmDesc1) != smSuccess) || (FwSmIsEsmLazy(derSmDesc1, STATE_S1) != 1) ||
+	        (FwSmIsEsmLazy(derSmDesc1, STATE_S2) != 0) || (FwSmIsEsmLazy(derSmDesc1, 3) != 0) ||
+	        (FwSmGetEmbSm(derSmDesc1, STATE_S1) != NULL) || (FwSmCheckRec(derSmDesc1) != smSuccess))
+		outcome = smTestCaseFailure;
+
+	/* The cost analysis takes the template into account */
+	if ((outcome == smTestCaseSuccess) && ((FwSmCostStart(derSmDesc1, NULL, 0, &cost) != smSuccess) ||
+	                                       (cost.nOfLevels != 2)))
+		outcome = smTestCaseFailure;
+
+	/* Errors: template or embedded state machine already defined, illegal state, base state machine */
+	derSmDesc2 = FwSmCreateDer(smDesc2);
+	FwSmEmbedLazy(derSmDesc2, STATE_S1, smDesc1);
+	FwSmEmbedLazy(derSmDesc2, STATE_S1, smDesc1);
+	if ((outcome == smTestCaseSuccess) && (FwSmGetErrCode(derSmDesc2) != smEsmDefined))
+		outcome = smTestCaseFailure;
+	FwSmReleaseDer(derSmDesc2);
+	derSmDesc2 = FwSmCreateDer(smDesc2);
+	FwSmEmbedLazy(derSmDesc2, STATE_S1, smDesc1);
+	FwSmEmbed(derSmDesc2, STATE_S1, smDesc1);
+	if ((outcome == smTestCaseSuccess) && (FwSmGetErrCode(derSmDesc2) != smEsmDefined))
+		outcome = smTestCaseFailure;
+	FwSmReleaseDer(derSmDesc2);
+	derSmDesc2 = FwSmCreateDer(smDesc2);
+	FwSmEmbedLazy(derSmDesc2, 0, smDesc1);
+	if ((outcome == smTestCaseSuccess) && (FwSmGetErrCode(derSmDesc2) != smIllStateId))
+		outcome = smTestCaseFailure;
+	FwSmReleaseDer(derSmDesc2);
+	derSmDesc2 = FwSmCreateDer(smDesc2);
+	FwSmEmbedLazy(derSmDesc2, 3, smDesc1);
+	if ((outcome == smTestCaseSuccess) && (FwSmGetErrCode(derSmDesc2) != smIllStateId))
+		outcome = smTestCaseFailure;
+	FwSmReleaseDer(derSmDesc2);
+	FwSmEmbedLazy(smDesc1, STATE_S1, smDesc2);
+	if ((outcome == smTestCaseSuccess) && (FwSmGetErrCode(smDesc1) != smNotDerivedSM))
+		outcome = smTestCaseFailure;
+	smDesc1->errCode = smSuccess;
+
+	/* The embedded state machine is instantiated when state S1 is entered and it operates on the same data */
+	FwSmStart(derSmDesc1);
+	esmDesc = FwSmGetEmbSm(derSmDesc1, STATE_S1);
+	if ((outcome == smTestCaseSuccess) && ((esmDesc == NULL) || (FwSmGetData(esmDesc) != &smData2) ||
+	                                       (FwSmGetCurState(esmDesc) != STATE_S1) ||
+	                                       (FwSmGetCurState(derSmDesc1) != STATE_S1) ||
+	                                       (FwSmGetErrCode(derSmDesc1) != smSuccess)))
+		outcome = smTestCaseFailure;
+
+	/* The derived embedded state machine is kept when state S1 is exited and it is re-used */
+	FwSmMakeTrans(derSmDesc1, TR1);
+	if ((outcome == smTestCaseSuccess) && ((FwSmIsStarted(derSmDesc1) != 0) || (FwSmIsStarted(esmDesc) != 0) ||
+	                                       (FwSmGetEmbSm(derSmDesc1, STATE_S1) != esmDesc)))
+		outcome = smTestCaseFailure;
+	FwSmStart(derSmDesc1);
+	if ((outcome == smTestCaseSuccess) && ((FwSmGetEmbSm(derSmDesc1, STATE_S1) != esmDesc) ||
+	                                       (FwSmGetCurState(esmDesc) != STATE_S1)))
+		outcome = smTestCaseFailure;
+	FwSmStop(derSmDesc1);
+
+	/* The pool-backed embedded state machine only exists while state S1 is active */
+	pool = FwSmPoolCreate(smDesc1, 1, 0);
+	derSmDesc3 = FwSmCreateDer(smDesc2);
+	FwSmSetData(derSmDesc3, &smData2);
+	FwSmEmbedLazyPool(derSmDesc3, STATE_S1, pool);
+	if ((outcome == smTestCaseSuccess) && ((FwSmGetErrCode(derSmDesc3) != smSuccess) ||
+	                                       (FwSmCheckRec(derSmDesc3) != smSuccess)))
+		outcome = smTestCaseFailure;
+	FwSmStart(derSmDesc3);
+	esmDesc = FwSmGetEmbSm(derSmDesc3, STATE_S1);
+	if ((outcome == smTestCaseSuccess) && ((esmDesc == NULL) || (FwSmPoolGetNOfInUse(pool) != 1) ||
+	                                       (FwSmGetCurState(esmDesc) != STATE_S1) ||
+	                                       (FwSmGetData(esmDesc) != &smData2)))
+		outcome = smTestCaseFailure;
+	FwSmStop(derSmDesc3);
+	if ((outcome == smTestCaseSuccess) && ((FwSmPoolGetNOfInUse(pool) != 0) ||
+	                                       (FwSmGetEmbSm(derSmDesc3, STATE_S1) != NULL)))
+		outcome = smTestCaseFailure;
+	FwSmStart(derSmDesc3);
+	FwSmMakeTrans(derSmDesc3, TR1);
+	if ((outcome == smTestCaseSuccess) && ((FwSmPoolGetNOfInUse(pool) != 0) || (FwSmIsStarted(derSmDesc3) != 0)))
+		outcome = smTestCaseFailure;
+
+	/* A state machine derived from the container shares its template and instantiates its own embedded state machine */
+	derSmDesc4 = FwSmCreateDer(derSmDesc3);
+	FwSmSetData(derSmDesc4, &smData2);
+	if ((outcome == smTestCaseSuccess) && (FwSmIsEsmLazy(derSmDesc4, STATE_S1) != 1))
+		outcome = smTestCaseFailure;
+	FwSmStart(derSmDesc4);
+	if ((outcome == smTestCaseSuccess) && ((FwSmPoolGetNOfInUse(pool) != 1) ||
+	                                       (FwSmGetEmbSm(derSmDesc4, STATE_S1) == NULL) ||
+	                                       (FwSmGetEmbSm(derSmDesc3, STATE_S1) != NULL)))
+		outcome = smTestCaseFailure;
+
+	/* Releasing a started container returns its embedded state machine to the pool */
+	FwSmReleaseDer(derSmDesc4);
+	if ((outcome == smTestCaseSuccess) && (FwSmPoolGetNOfInUse(pool) != 0))
+		outcome = smTestCaseFailure;
+
+	FwSmReleaseDer(derSmDesc3);
+	FwSmReleaseDer(derSmDesc1);
+	FwSmPoolRelease(pool);
+	FwSmRelease(smDesc1);
+	FwSmRelease(smDesc2);
+	return outcome;
+}
+
+/*------------------------------------------------------------------------------------------------- */
+FwSmTestOutcome_t FwSmTestCaseLazy2() {
+	struct TestSmData smData1 = {0, 0, 1, 0, 0, 0};
+	struct TestSmData smData2 = {0, 0, 1, 0, 0, 0};
+	FwSmDesc_t smDesc1, smDesc2, imgSmDesc1, imgSmDesc2, arenaSmDesc;
+	FwSmPoolDesc_t pool;
+	FwSmCounterU4_t size;
+	unsigned char* image;
+	FwSmTestOutcome_t outcome = smTestCaseSuccess;
+
+	smDesc1 = FwSmMakeTestSM14(&smData1);
+	smDesc2 = FwSmMakeTestSM14(&smData2);
+	pool = FwSmPoolCreate(smDesc1, 1, 0);
+	size = FwSmGetImageSize(smDesc2);
+	image = (unsigned char*)malloc(size);
+	if ((pool == NULL) || (image == NULL) || (FwSmExportImage(smDesc2, image, size) != size)) {
+		if (pool != NULL)
+			FwSmPoolRelease(pool);
+		free(image);
+		FwSmRelease(smDesc1);
+		FwSmRelease(smDesc2);
+		return smTestCaseFailure;
+	}
+
+	/* A state machine created in an arena is a base state machine and cannot have templates */
+	arenaSmDesc = FwSmCreateArena(2, 0, 4, 1, 1);
+	if (arenaSmDesc == NULL)
+		outcome = smTestCaseFailure;
+	else {
+		FwSmEmbedLazy(arenaSmDesc, STATE_S1, smDesc1);
+		if (FwSmGetErrCode(arenaSmDesc) != smNotDerivedSM)
+			outcome = smTestCaseFailure;
+		FwSmReleaseArena(arenaSmDesc);
+	}
+
+	/* Templates can be embedded in the state machines loaded from an image */
+	imgSmDesc1 = FwSmLoadImage(image, size, smDesc2->smActions + 1, (FwSmCounterS1_t)(smDesc2->nOfActions - 1),
+	                           smDesc2->smGuards + 1, (FwSmCounterS1_t)(smDesc2->nOfGuards - 1));
+	imgSmDesc2 = FwSmLoadImage(image, size, smDesc2->smActions + 1, (FwSmCounterS1_t)(smDesc2->nOfActions - 1),
+	                           smDesc2->smGuards + 1, (FwSmCounterS1_t)(smDesc2->nOfGuards - 1));
+	if ((imgSmDesc1 == NULL) || (imgSmDesc2 == NULL)) {
+		if (imgSmDesc1 != NULL)
+			FwSmReleaseArena(imgSmDesc1);
+		if (imgSmDesc2 != NULL)
+			FwSmReleaseArena(imgSmDesc2);
+		FwSmPoolRelease(pool);
+		free(image);
+		FwSmRelease(smDesc1);
+		FwSmRelease(smDesc2);
+		return smTestCaseFailure;
+	}
+	FwSmSetData(imgSmDesc1, &smData2);
+	FwSmSetData(imgSmDesc2, &smData2);
+	FwSmEmbedLazy(imgSmDesc1, STATE_S1, smDesc1);
+	FwSmEmbedLazyPool(imgSmDesc2, STATE_S1, pool);
+	if ((outcome == smTestCaseSuccess) && ((FwSmGetErrCode(imgSmDesc1) != smSuccess) ||
+	                                       (FwSmGetErrCode(imgSmDesc2) != smSuccess) ||
+	                                       (FwSmIsEsmLazy(imgSmDesc1, STATE_S1) != 1) ||
+	                                       (FwSmIsEsmLazy(imgSmDesc2, STATE_S1) != 1)))
+		outcome = smTestCaseFailure;
+
+	/* The embedded state machines are instantiated when state S1 is entered */
+	FwSmStart(imgSmDesc1);
+	FwSmStart(imgSmDesc2);
+	if ((outcome == smTestCaseSuccess) && ((FwSmGetEmbSm(imgSmDesc1, STATE_S1) == NULL) ||
+	                                       (FwSmGetEmbSm(imgSmDesc2, STATE_S1) == NULL) ||
+	                                       (FwSmPoolGetNOfInUse(pool) != 1)))
+		outcome = smTestCaseFailure;
+
+	/* Releasing the started state machines releases their embedded state machines and their lazy embedding data */
+	FwSmReleaseArena(imgSmDesc1);
+	FwSmReleaseArena(imgSmDesc2);
+	if ((outcome == smTestCaseSuccess) && (FwSmPoolGetNOfInUse(pool) != 0))
+		outcome = smTestCaseFailure;
+
+	FwSmPoolRelease(pool);
+	free(image);
+	FwSmRelease(smDesc1);
+	FwSmRelease(smDesc2);
+	return outcome;
+}
+
+/**
+ * Operation offloaded by the action offload test case (see <code>::FwSmTestCaseAsync1</code>).
+ * The operation increments counter_1 by 1.
+ * @param smDesc the state machine descriptor
+ */
+static void SmAsyncOperation(FwSmDesc_t smDesc) {
+	struct TestSmData* smData = (struct TestSmData*)FwSmGetData(smDesc);
+	smData->counter_1 += 1;
+}
+
+/*------------------------------------------------------------------------------------------------- */
+FwSmTestOutcome_t FwSmTestCaseAsync1() {
+	struct TestSmData smData1 = {0, 0, 1, 0, 0, 0};
+	struct TestSmData smData2 = {0, 0, 1, 0, 0, 0};
+	FwSmDesc_t smDesc1, smDesc2;
+	FwSmQueueDesc_t queue;
+	FwSmAsyncDesc_t async, asyncFull;
+	struct FwRtDesc rtDesc, rtDescFull;
+	FwSmTestOutcome_t outcome = smTestCaseSuccess;
+	long i;
+
+	smDesc1 = FwSmMakeTestSM14(&smData1);
+	smDesc2 = FwSmMakeTestSM14(&smData2);
+	queue = FwSmQueueCreate(smDesc2, 4, 4);
+
+	/* An offload descriptor needs at least one job and a container which is not yet initialized */
+	FwRtReset(&rtDesc);
+	if ((FwSmAsyncCreate(&rtDesc, 0) != NULL) || (FwRtGetContState(&rtDesc) != rtContUninitialized))
+		outcome = smTestCaseFailure;
+	async = FwSmAsyncCreate(&rtDesc, 2);
+	FwRtInit(&rtDesc);
+	if ((outcome == smTestCaseSuccess) && ((async == NULL) || (FwSmAsyncCreate(&rtDesc, 2) != NULL)))
+		outcome = smTestCaseFailure;
+	FwRtStart(&rtDesc);
+
+	/* The completion trigger of an offloaded operation is held until it is dispatched */
+	FwSmStart(smDesc1);
+	if ((outcome == smTestCaseSuccess) &&
+	        (FwSmAsyncRun(async, smDesc1, &SmAsyncOperation, TR1) != smSuccess))
+		outcome = smTestCaseFailure;
+	for (i = 0; (i < 10000000) && (FwSmAsyncDispatch(async, 1) == 0); i++)
+		sched_yield();
+	if ((outcome == smTestCaseSuccess) && ((smData1.counter_1 != 1) || (FwSmIsStarted(smDesc1) != 0) ||
+	                                       (FwSmAsyncGetNOfPending(async) != 0)))
+		outcome = smTestCaseFailure;
+
+	/* The completion trigger of an operation offloaded through a queue is posted to the queue */
+	FwSmStart(smDesc2);
+	if ((outcome == smTestCaseSuccess) &&
+	        (FwSmAsyncRunQueued(async, queue, &SmAsyncOperation, TR1) != smSuccess))
+		outcome = smTestCaseFailure;
+	for (i = 0; (i < 10000000) && (FwSmQueueGetNOfPending(queue) == 0); i++)
+		sched_yield();
+	if ((outcome == smTestCaseSuccess) && ((smData2.counter_1 != 1) || (FwSmIsStarted(smDesc2) != 1) ||
+	                                       (FwSmQueueDispatch(queue, 4) != 1) || (FwSmIsStarted(smDesc2) != 0) ||
+	                                       (FwSmAsyncDispatch(async, 1) != 0) ||
+	                                       (FwSmAsyncGetNOfPending(async) != 0)))
+		outcome = smTestCaseFailure;
+
+	FwRtStop(&rtDesc);
+	FwRtWaitForTermination(&rtDesc);
+	FwRtShutdown(&rtDesc);
+	FwSmAsyncRelease(async);
+
+	/* Operations are rejected when all the jobs are in use (the container is not started) */
+	FwRtReset(&rtDescFull);
+	asyncFull = FwSmAsyncCreate(&rtDescFull, 1);
+	FwRtInit(&rtDescFull);
+	if ((outcome == smTestCaseSuccess) &&
+	        ((FwSmAsyncRun(asyncFull, smDesc1, &SmAsyncOperation, TR1) != smSuccess) ||
+	         (FwSmAsyncRun(asyncFull, smDesc1, &SmAsyncOperation, TR1) != smAsyncFull) ||
+	         (FwSmGetErrCode(smDesc1) != smAsyncFull) || (FwSmAsyncGetNOfPending(asyncFull) != 1) ||
+	         (smData1.counter_1 != 1)))
+		outcome = smTestCaseFailure;
+	FwRtShutdown(&rtDescFull);
+	FwSmAsyncRelease(asyncFull);
+
+	FwSmQueueRelease(queue);
+	FwSmRelease(smDesc1);
+	FwSmRelease(smDesc2);
+	return outcome;
+}
+
+/*------------------------------------------------------------------------------------------------- */
+FwSmTestOutcome_t FwSmTestCaseDecl1() {
+	struct TestSmData smData = {0, 0, 0, 1, 0, 0};
+	FwSmDesc_t smDesc, smDescDer;
+	FwSmTestOutcome_t outcome = smTestCaseSuccess;
+	FwSmCounterU4_t offset1 = (FwSmCounterU4_t)offsetof(struct TestSmData, flag_1);
+	FwSmCounterU4_t offset2 = (FwSmCounterU4_t)offsetof(struct TestSmData, flag_2);
+
+	smDesc = SmMemoMake(&smData, NULL);
+	if (smDesc == NULL)
+		return smTestCaseFailure;
+
+	/* Guards which are not in the state machine cannot be declared */
+	if ((FwSmSetGuardDecl(smDesc, &SmCfgIndexGuard1, smGuardOpndInt, offset1, smGuardNe, 0) != smUndefGuard) ||
+	        (FwSmSetGuardDecl(smDesc, NULL, smGuardOpndInt, offset1, smGuardNe, 0) != smUndefGuard) ||
+	        (smDesc->memo != NULL))
+		outcome = smTestCaseFailure;
+
+	/* The declared guards are evaluated without calling the guard functions */
+	if ((outcome == smTestCaseSuccess) &&
+	        ((FwSmSetGuardDecl(smDesc, &SmMemoGuard1, smGuardOpndInt, offset1, smGuardNe, 0) != smSuccess) ||
+	         (FwSmSetGuardDecl(smDesc, &SmMemoGuard2, smGuardOpndInt, offset2, smGuardGt, 0) != smSuccess) ||
+	         (smDesc->memo == NULL)))
+		outcome = smTestCaseFailure;
+	FwSmStart(smDesc);
+	FwSmMakeTrans(smDesc, TR1);
+	if ((outcome == smTestCaseSuccess) && ((FwSmGetCurState(smDesc) != 3) || (smData.counter_1 != 0)))
+		outcome = smTestCaseFailure;
+	FwSmMakeTrans(smDesc, TR2);
+	smData.flag_1 = 1;
+	FwSmMakeTrans(smDesc, TR1);
+	if ((outcome == smTestCaseSuccess) && ((FwSmGetCurState(smDesc) != 2) || (smData.counter_1 != 0)))
+		outcome = smTestCaseFailure;
+
+	/* Without the declaration, a guard is called again */
+	FwSmMakeTrans(smDesc, TR2);
+	if ((outcome == smTestCaseSuccess) &&
+	        (FwSmSetGuardDecl(smDesc, &SmMemoGuard1, smGuardOpndNone, 0, smGuardEq, 0) != smSuccess))
+		outcome = smTestCaseFailure;
+	FwSmMakeTrans(smDesc, TR1);
+	if ((outcome == smTestCaseSuccess) && ((FwSmGetCurState(smDesc) != 2) || (smData.counter_1 != 1)))
+		outcome = smTestCaseFailure;
+
+	/* A guard can be declared on the state execution counter */
+	FwSmMakeTrans(smDesc, TR2);
+	smData.counter_1 = 0;
+	smData.flag_1    = 0;
+	smData.flag_2    = 0;
+	if ((outcome == smTestCaseSuccess) &&
+	        (FwSmSetGuardDecl(smDesc, &SmMemoGuard1, smGuardOpndStateExecCnt, 0, smGuardGe, 2) != smSuccess))
+		outcome = smTestCaseFailure;
+	FwSmMakeTrans(smDesc, TR1);
+	if ((outcome == smTestCaseSuccess) && (FwSmGetCurState(smDesc) != 1))
+		outcome = smTestCaseFailure;
+	FwSmExecute(smDesc);
+	FwSmExecute(smDesc);
+	FwSmMakeTrans(smDesc, TR1);
+	if ((outcome == smTestCaseSuccess) && ((FwSmGetCurState(smDesc) != 2) || (smData.counter_1 != 0)))
+		outcome = smTestCaseFailure;
+
+	/* A guard can be declared on the state machine execution counter */
+	FwSmMakeTrans(smDesc, TR2);
+	if ((outcome == smTestCaseSuccess) &&
+	        (FwSmSetGuardDecl(smDesc, &SmMemoGuard1, smGuardOpndSmExecCnt, 0, smGuardEq, 2) != smSuccess))
+		outcome = smTestCaseFailure;
+	FwSmMakeTrans(smDesc, TR1);
+	if ((outcome == smTestCaseSuccess) && ((FwSmGetCurState(smDesc) != 2) || (smData.counter_1 != 0)))
+		outcome = smTestCaseFailure;
+
+	/* The declaration is neither inherited nor kept when the guard is overridden */
+	smDescDer = FwSmCreateDer(smDesc);
+	if ((smDescDer == NULL) || (smDescDer->memo != NULL)) {
+		FwSmRelease(smDesc);
+		return smTestCaseFailure;
+	}
+	if ((outcome == smTestCaseSuccess) &&
+	        ((FwSmSetGuardDecl(smDescDer, &SmMemoGuard2, smGuardOpndInt, offset2, smGuardGt, 0) != smSuccess) ||
+	         (smDescDer->memo->decl[2].opnd != smGuardOpndInt)))
+		outcome = smTestCaseFailure;
+	FwSmOverrideGuard(smDescDer, &SmMemoGuard2, &SmMemoGuard1);
+	if ((outcome == smTestCaseSuccess) &&
+	        ((FwSmGetErrCode(smDescDer) != smSuccess) || (smDescDer->memo->decl[2].opnd != smGuardOpndNone)))
+		outcome = smTestCaseFailure;
+
+	FwSmReleaseDer(smDescDer);
+	FwSmRelease(smDesc);
+	return outcome;
+}
+
+/**
+ * Guard used by the dispatch table test case (see <code>::FwSmTestCaseCompile3</code>).
+ * @param smDesc the state machine descriptor
+ * @return the value of flag_1
+ */
+static FwSmBool_t SmDispGuard(FwSmDesc_t smDesc) {
+	return ((struct TestSmData*)FwSmGetData(smDesc))->flag_1;
+}
+
+/**
+ * Action used by the dispatch table test case (see <code>::FwSmTestCaseCompile3</code>).
+ * The action increments counter_1.
+ * @param smDesc the state machine descriptor
+ */
+static void SmDispAction1(FwSmDesc_t smDesc) {
+	((struct TestSmData*)FwSmGetData(smDesc))->counter_1++;
+}
+
+/**
+ * Action used by the dispatch table test case (see <code>::FwSmTestCaseCompile3</code>).
+ * The action increments counter_2.
+ * @param smDesc the state machine descriptor
+ */
+static void SmDispAction2(FwSmDesc_t smDesc) {
+	((struct TestSmData*)FwSmGetData(smDesc))->counter_2++;
+}
+
+/**
+ * Create the state machine of the dispatch table test cases (see
+ * <code>::FwSmTestCaseCompile3</code> and <code>::FwSmTestCaseCompile4</code>).
+ * The state machine has two states S1 and S2.
+ * State S1 has <code>nOfOutTrans</code> out-going transitions.
+ * The first <code>nOfOutTrans-2</code> transitions go to S2 and have action
+ * <code>SmDispAction1</code>; they are added in order of decreasing identifier,
+ * starting from <code>TR1+step*(nOfOutTrans-2)</code>, and their identifiers are
+ * <code>step</code> apart.
+ * The last two transitions are triggered by TR1: the first goes to S2 with guard
+ * <code>SmDispGuard</code> and action <code>SmDispAction2</code> and the second is a
+ * self-transition with no guard and no action.
+ * Trigger TR1 causes a transition from S2 back to S1.
+ * @param smData the state machine data
+ * @param nOfOutTrans the number of out-going transitions of S1
+ * @param step the distance between the identifiers of the transitions to S2
+ * @return the descriptor of the state machine or NULL if it could not be created
+ */
+static FwSmDesc_t SmDispMake(struct TestSmData* smData, FwSmCounterS1_t nOfOutTrans, FwSmCounterU2_t step) {
+	FwSmCounterS1_t i;
+	FwSmDesc_t smDesc = FwSmCreate(2, 0, (FwSmCounterS1_t)(nOfOutTrans + 2), 2, 1);
+	if (smDesc == NULL)
+		return NULL;
+	FwSmSetData(smDesc, smData);
+	FwSmAddState(smDesc, 1, nOfOutTrans, NULL, NULL, NULL, NULL);
+	FwSmAddState(smDesc, 2, 1, NULL, NULL, NULL, NULL);
+	FwSmAddTransIpsToSta(smDesc, 1, NULL);
+	for (i=(FwSmCounterS1_t)(nOfOutTrans-2); i>0; i--)
+		FwSmAddTransStaToSta(smDesc, (FwSmCounterU2_t)(TR1+step*i), 1, 2, &SmDispAction1, NULL);
+	FwSmAddTransStaToSta(smDesc, TR1, 1, 2, &SmDispAction2, &SmDispGuard);
+	FwSmAddTransStaToSta(smDesc, TR1, 1, 1, NULL, NULL);
+	FwSmAddTransStaToSta(smDesc, TR1, 2, 1, NULL, NULL);
+	if (FwSmCheck(smDesc) != smSuccess) {
+		FwSmRelease(smDesc);
+		return NULL;
+	}
+	return smDesc;
+}
+
+/**
+ * Run the dispatch table test cases (see <code>::FwSmTestCaseCompile3</code> and
+ * <code>::FwSmTestCaseCompile4</code>) on the state machine created by
+ * <code>::SmDispMake</code>.
+ * @param nOfOutTrans the number of out-going transitions of S1
+ * @param step the distance between the identifiers of the transitions to S2
+ * @param isDirect 1 if the transitions out of S1 must be located through the
+ * direct-index section of the dispatch table, 0 otherwise
+ * @return the success/failure code of the test case.
+ */
+static FwSmTestOutcome_t SmDispRun(FwSmCounterS1_t nOfOutTrans, FwSmCounterU2_t step, int isDirect) {
+	struct TestSmData sSmData;
+	struct TestSmData* smData = &sSmData;
+	FwSmDesc_t smDesc;
+	FwSmCounterS1_t i;
+
+	smData->counter_1 = 0;
+	smData->counter_2 = 0;
+	smData->flag_1 = 0;
+	smDesc = SmDispMake(smData, nOfOutTrans, step);
+	if (smDesc == NULL)
+		return smTestCaseFailure;
+	if ((FwSmCompile(smDesc) != smSuccess) || (smDesc->smBase->isCompiled == 0) ||
+	        ((smDesc->smBase->pStates[0].dispNOfIds != 0) != (isDirect != 0))) {
+		FwSmRelease(smDesc);
+		return smTestCaseFailure;
+	}
+	FwSmStart(smDesc);
+
+	/* Triggers below, inside and above the range of identifiers with no matching transition do nothing */
+	FwSmMakeTrans(smDesc, FW_TR_EXECUTE);
+	FwSmMakeTrans(smDesc, (FwSmCounterU2_t)(TR1+1));
+	FwSmMakeTrans(smDesc, (FwSmCounterU2_t)(TR1+step*nOfOutTrans));
+	if ((FwSmGetCurState(smDesc) != 1) || (smData->counter_1 != 0)) {
+		FwSmRelease(smDesc);
+		return smTestCaseFailure;
+	}
+
+	/* Each transition with a distinct identifier is found in the dispatch table */
+	for (i=1; i<=(FwSmCounterS1_t)(nOfOutTrans-2); i++) {
+		FwSmMakeTrans(smDesc, (FwSmCounterU2_t)(TR1+step*i));
+		if ((FwSmGetCurState(smDesc) != 2) || (smData->counter_1 != i)) {
+			FwSmRelease(smDesc);
+			return smTestCaseFailure;
+		}
+		FwSmMakeTrans(smDesc, TR1);
+		if (FwSmGetCurState(smDesc) != 1) {
+			FwSmRelease(smDesc);
+			return smTestCaseFailure;
+		}
+	}
+
+	/* The transitions triggered by TR1 are evaluated in the order in which they were added */
+	FwSmMakeTrans(smDesc, TR1);
+	if ((FwSmGetCurState(smDesc) != 1) || (smData->counter_2 != 0)) {
+		FwSmRelease(smDesc);
+		return smTestCaseFailure;
+	}
+	smData->flag_1 = 1;
+	FwSmMakeTrans(smDesc, TR1);
+	if ((FwSmGetCurState(smDesc) != 2) || (smData->counter_2 != 1)) {
+		FwSmRelease(smDesc);
+		return smTestCaseFailure;
+	}
+
+	FwSmRelease(smDesc);
+	return smTestCaseSuccess;
+}
+
+/*------------------------------------------------------------------------------------------------- */
+FwSmTestOutcome_t FwSmTestCaseCompile3() {
+	long int nOfOutTrans = (long int)FW_SM_DISP_MIN_OUT_TRANS;
+
+	/* The number of transitions must be representable in the FwSmCounterS1_t type */
+	if (nOfOutTrans > (long int)(FW_SM_COUNTER_S1_MAX - 2))
+		return smTestCaseSuccess;
+	/* With at least 5 transitions, identifiers 3 apart are too sparse for the direct index */
+	if (nOfOutTrans < 5)
+		nOfOutTrans = 5;
+	return SmDispRun((FwSmCounterS1_t)nOfOutTrans, 3, 0);
+}
+
+/*------------------------------------------------------------------------------------------------- */
+FwSmTestOutcome_t FwSmTestCaseCompile4() {
+	long int nOfOutTrans = (long int)FW_SM_DISP_MIN_DIRECT_OUT_TRANS;
+
+	/* The number of transitions must be representable in the FwSmCounterS1_t type */
+	if (nOfOutTrans > (long int)(FW_SM_COUNTER_S1_MAX - 2))
+		return smTestCaseSuccess;
+	if (nOfOutTrans < 3)
+		nOfOutTrans = 3;
+	return SmDispRun((FwSmCounterS1_t)nOfOutTrans, 2, 1);
+}
+
+/**
+ * Create the state machine of the group configuration test case (see
+ * <code>::FwSmTestCaseGroup3</code>).
+ * The state machine has two states S1 and S2.
+ * State S1 has do-action <code>SmDispAction1</code>.
+ * If <code>addTrans</code> is true, the function also adds an "Execute" transition
+ * from S1 to S2 with guard <code>SmDispGuard</code> and a transition triggered by TR1
+ * from S2 back to S1 and it checks the configuration of the state machine.
+ * @param smData the state machine data
+ * @param addTrans 1 if the transitions are to be added to the state machine
+ * @return the descriptor of the state machine or NULL if it could not be created
+ */
+static FwSmDesc_t SmGroupMake(struct TestSmData* smData, int addTrans) {
+	FwSmDesc_t smDesc = FwSmCreate(2, 0, 3, 1, 1);
+	if (smDesc == NULL)
+		return NULL;
+	FwSmSetData(smDesc, smData);
+	FwSmAddState(smDesc, 1, 1, NULL, NULL, &SmDispAction1, NULL);
+	FwSmAddState(smDesc, 2, 1, NULL, NULL, NULL, NULL);
+	if (addTrans == 0)
+		return smDesc;
+	FwSmAddTransIpsToSta(smDesc, 1, NULL);
+	FwSmAddTransStaToSta(smDesc, FW_TR_EXECUTE, 1, 2, NULL, &SmDispGuard);
+	FwSmAddTransStaToSta(smDesc, TR1, 2, 1, NULL, NULL);
+	if (FwSmCheck(smDesc) != smSuccess) {
+		FwSmRelease(smDesc);
+		return NULL;
+	}
+	return smDesc;
+}
+
+/*------------------------------------------------------------------------------------------------- */
+FwSmTestOutcome_t FwSmTestCaseGroup3() {
+	struct TestSmData sSmData1 = {0, 0, 0, 0, 0, 0};
+	struct TestSmData sSmData2 = {0, 0, 0, 0, 0, 0};
+	FwSmDesc_t smDesc1, smDesc2;
+	FwSmGroupDesc_t group;
+	FwSmTestOutcome_t outcome = smTestCaseSuccess;
+	FwTraceEvent_t events[4];
+	FwTraceEvent_t drained[4];
+	struct FwTraceRing ring;
+	int i;
+
+	/* The group is created before the transitions of its state machine are added */
+	smDesc1 = SmGroupMake(&sSmData1, 0);
+	smDesc2 = SmGroupMake(&sSmData2, 1);
+	if ((smDesc1 == NULL) || (smDesc2 == NULL))
+		return smTestCaseFailure;
+	group = FwSmGroupCreate(smDesc1, 1);
+	if ((group == NULL) || (FwSmGroupAdd(group, smDesc1) != smSuccess)) {
+		FwSmRelease(smDesc1);
+		FwSmRelease(smDesc2);
+		return smTestCaseFailure;
+	}
+	FwSmAddTransIpsToSta(smDesc1, 1, NULL);
+	FwSmAddTransStaToSta(smDesc1, FW_TR_EXECUTE, 1, 2, NULL, &SmDispGuard);
+	FwSmAddTransStaToSta(smDesc1, TR1, 2, 1, NULL, NULL);
+	if (FwSmCheck(smDesc1) != smSuccess)
+		outcome = smTestCaseFailure;
+
+	/* The group sees the "Execute" transition added after its creation */
+	FwSmGroupStart(group);
+	FwSmStart(smDesc2);
+	for (i=0; i<4; i++) {
+		sSmData1.flag_1 = (i == 1);
+		sSmData2.flag_1 = (i == 1);
+		if (i == 2) {
+			FwSmMakeTrans(smDesc1, TR1);
+			FwSmMakeTrans(smDesc2, TR1);
+		}
+		FwSmGroupExecute(group);
+		FwSmExecute(smDesc2);
+		if ((FwSmGetCurState(smDesc1) != FwSmGetCurState(smDesc2)) ||
+		        (sSmData1.counter_1 != sSmData2.counter_1) ||
+		        (FwSmGetExecCnt(smDesc1) != FwSmGetExecCnt(smDesc2)) ||
+		        (FwSmGetStateExecCnt(smDesc1) != FwSmGetStateExecCnt(smDesc2)))
+			outcome = smTestCaseFailure;
+		if ((i == 1) && (FwSmGetCurState(smDesc1) != STATE_S2))
+			outcome = smTestCaseFailure;
+	}
+
+	/* A stopped state machine is not executed by the group but its "Execute" command is recorded */
+	FwSmStop(smDesc1);
+	FwTraceRingInit(&ring, events, 4);
+	FwTraceSetMask(&ring, FW_TRACE_MASK_CMDS);
+	FwTraceSetRing(&ring);
+	FwSmGroupExecute(group);
+	FwTraceSetRing(NULL);
+	if ((FwSmIsStarted(smDesc1) != 0) || (sSmData1.counter_1 != 4))
+		outcome = smTestCaseFailure;
+#ifdef FW_TRACE
+	if ((FwTraceDrain(&ring, drained, 4) != 1) || (drained[0].type != traceSmExecuteCmd) ||
+	        (drained[0].desc != smDesc1))
+		outcome = smTestCaseFailure;
+#else
+	if (FwTraceDrain(&ring, drained, 4) != 0)
+		outcome = smTestCaseFailure;
+#endif
+
+	FwSmGroupRelease(group);
+	FwSmRelease(smDesc1);
+	FwSmRelease(smDesc2);
+	return outcome;
+}
+
+/*------------------------------------------------------------------------------------------------- */
+FwSmTestOutcome_t FwSmTestCaseGroup4() {
+	struct TestSmData sSmData[4] = {{0, 0, 0, 0, 0, 0}, {0, 0, 0, 0, 0, 0}, {0, 0, 0, 0, 0, 0}, {0, 0, 0, 0, 0, 0}};
+	FwSmDesc_t smBaseDesc;
+	FwSmDesc_t smDesc[4];
+	FwSmGroupDesc_t group;
+	FwSmTestOutcome_t outcome = smTestCaseSuccess;
+	FwTraceEvent_t events[32];
+	FwTraceEvent_t groupEvents[32];
+	FwTraceEvent_t smEvents[32];
+	struct FwTraceRing ring;
+	FwTraceCounterU4_t nOfGroupEvents, nOfSmEvents, k;
+	int i, j;
+
+	/* State S1 has a do-action and no "Execute" transition, state S2 has a do-action and an "Execute" transition */
+	smBaseDesc = FwSmCreate(2, 0, 3, 2, 1);
+	FwSmAddState(smBaseDesc, 1, 1, NULL, NULL, &SmDispAction1, NULL);
+	FwSmAddState(smBaseDesc, 2, 1, NULL, NULL, &SmDispAction2, NULL);
+	FwSmAddTransIpsToSta(smBaseDesc, 1, NULL);
+	FwSmAddTransStaToSta(smBaseDesc, TR1, 1, 2, NULL, NULL);
+	FwSmAddTransStaToSta(smBaseDesc, FW_TR_EXECUTE, 2, 1, NULL, &SmDispGuard);
+	if (FwSmCheck(smBaseDesc) != smSuccess) {
+		FwSmRelease(smBaseDesc);
+		return smTestCaseFailure;
+	}
+
+	/* State machines 0 and 1 are in the group and state machines 2 and 3 are their twins */
+	group = FwSmGroupCreate(smBaseDesc, 2);
+	for (j=0; j<4; j++) {
+		smDesc[j] = FwSmCreateDer(smBaseDesc);
+		FwSmSetData(smDesc[j], &sSmData[j]);
+		FwSmStart(smDesc[j]);
+	}
+	(void)FwSmGroupAdd(group, smDesc[0]);
+	(void)FwSmGroupAdd(group, smDesc[1]);
+	FwSmMakeTrans(smDesc[1], TR1);
+	FwSmMakeTrans(smDesc[3], TR1);
+
+	/* Executing the group records the same events and has the same effects as executing the twins */
+	FwTraceRingInit(&ring, events, 32);
+	FwTraceSetMask(&ring, FW_TRACE_MASK_DEFAULT | FW_TRACE_MASK_CMDS);
+	for (i=0; i<4; i++) {
+		for (j=0; j<4; j++)
+			sSmData[j].flag_1 = (i == 1);
+		FwTraceSetRing(&ring);
+		FwSmGroupExecute(group);
+		nOfGroupEvents = FwTraceDrain(&ring, groupEvents, 32);
+		FwSmExecute(smDesc[2]);
+		FwSmExecute(smDesc[3]);
+		nOfSmEvents = FwTraceDrain(&ring, smEvents, 32);
+		FwTraceSetRing(NULL);
+		if (nOfGroupEvents != nOfSmEvents)
+			outcome = smTestCaseFailure;
+		for (k=0; (k<nOfGroupEvents) && (k<nOfSmEvents); k++)
+			if ((groupEvents[k].type != smEvents[k].type) || (groupEvents[k].id != smEvents[k].id) ||
+			        (groupEvents[k].value != smEvents[k].value))
+				outcome = smTestCaseFailure;
+		for (j=0; j<2; j++)
+			if ((FwSmGetCurState(smDesc[j]) != FwSmGetCurState(smDesc[j+2])) ||
+			        (sSmData[j].counter_1 != sSmData[j+2].counter_1) ||
+			        (sSmData[j].counter_2 != sSmData[j+2].counter_2) ||
+			        (FwSmGetExecCnt(smDesc[j]) != FwSmGetExecCnt(smDesc[j+2])) ||
+			        (FwSmGetStateExecCnt(smDesc[j]) != FwSmGetStateExecCnt(smDesc[j+2])))
+				outcome = smTestCaseFailure;
+	}
+	if ((sSmData[0].counter_1 != 4) || (sSmData[1].counter_1 != 2) || (sSmData[1].counter_2 != 2))
+		outcome = smTestCaseFailure;
+
+	FwSmGroupRelease(group);
+	for (j=0; j<4; j++)
+		FwSmReleaseDer(smDesc[j]);
+	FwSmRelease(smBaseDesc);
+	return outcome;
+}
+
+/*------------------------------------------------------------------------------------------------- */
+FwSmTestOutcome_t FwSmTestCaseSnap2() {
+	struct TestSmData smData1 = {0, 0, 1, 0, 0, 0};
+	struct TestSmData smData2 = {0, 0, 1, 0, 0, 0};
+	FwSmDesc_t smDesc1, smDesc2, derSmDesc1, derSmDesc2, esmDesc;
+	FwSmPoolDesc_t pool;
+	FwSmCounterU4_t size;
+	unsigned char snapA[256], snapB[256], ref[256], delta[256];
+	FwSmCounterU4_t deltaSize;
+	FwSmTestOutcome_t outcome = smTestCaseSuccess;
+
+	/* State S1 of derSmDesc1 has a pool-backed template and state S1 of derSmDesc2 has a template */
+	smDesc1 = FwSmMakeTestSM14(&smData1);
+	smDesc2 = FwSmMakeTestSM14(&smData2);
+	pool = FwSmPoolCreate(smDesc1, 1, 0);
+	derSmDesc1 = FwSmCreateDer(smDesc2);
+	FwSmSetData(derSmDesc1, &smData2);
+	FwSmEmbedLazyPool(derSmDesc1, STATE_S1, pool);
+	derSmDesc2 = FwSmCreateDer(smDesc2);
+	FwSmSetData(derSmDesc2, &smData2);
+	FwSmEmbedLazy(derSmDesc2, STATE_S1, smDesc1);
+
+	/* The positions of the hierarchy do not depend on the instantiation of the embedded state machine */
+	size = FwSmSnapGetSize(derSmDesc1);
+	if ((size > sizeof(snapA)) || (size != FwSmSnapGetSize(derSmDesc2)) || (FwSmSnapTake(derSmDesc1, snapA, size) != size))
+		outcome = smTestCaseFailure;
+	memcpy(ref, snapA, size);
+	FwSmStart(derSmDesc1);
+	esmDesc = FwSmGetEmbSm(derSmDesc1, STATE_S1);
+	if ((outcome == smTestCaseSuccess) && ((esmDesc == NULL) || (FwSmSnapGetSize(derSmDesc1) != size) ||
+	                                       (FwSmSnapTake(derSmDesc1, snapB, size) != size)))
+		outcome = smTestCaseFailure;
+
+	/* A delta snapshot records the instantiation of the embedded state machine */
+	deltaSize = FwSmSnapTakeDelta(derSmDesc1, ref, size, delta, sizeof(delta));
+	if ((outcome == smTestCaseSuccess) && ((deltaSize != size) || (memcmp(ref, snapB, size) != 0)))
+		outcome = smTestCaseFailure;
+
+	/* Restoring the checkpoint taken before the instantiation returns the embedded state machine to its pool */
+	if ((outcome == smTestCaseSuccess) && ((FwSmSnapRestore(derSmDesc1, snapA, size) != 1) ||
+	                                       (FwSmIsStarted(derSmDesc1) != 0) ||
+	                                       (FwSmGetEmbSm(derSmDesc1, STATE_S1) != NULL) ||
+	                                       (FwSmPoolGetNOfInUse(pool) != 0)))
+		outcome = smTestCaseFailure;
+
+	/* Restoring the checkpoint taken after the instantiation takes an embedded state machine from the pool */
+	if ((outcome == smTestCaseSuccess) && ((FwSmSnapRestore(derSmDesc1, delta, deltaSize) != 1) ||
+	                                       (FwSmPoolGetNOfInUse(pool) != 1) ||
+	                                       ((esmDesc = FwSmGetEmbSm(derSmDesc1, STATE_S1)) == NULL) ||
+	                                       (FwSmGetCurState(derSmDesc1) != STATE_S1) ||
+	                                       (FwSmGetCurState(esmDesc) != STATE_S1) ||
+	                                       (FwSmGetData(esmDesc) != &smData2)))
+		outcome = smTestCaseFailure;
+	FwSmStop(derSmDesc1);
+	if ((outcome == smTestCaseSuccess) && (FwSmPoolGetNOfInUse(pool) != 0))
+		outcome = smTestCaseFailure;
+
+	/* The same checkpoints apply to a state machine with the same structure and a derived embedded state machine */
+	if ((outcome == smTestCaseSuccess) && ((FwSmSnapRestore(derSmDesc2, snapB, size) != 1) ||
+	                                       ((esmDesc = FwSmGetEmbSm(derSmDesc2, STATE_S1)) == NULL) ||
+	                                       (FwSmGetCurState(derSmDesc2) != STATE_S1) ||
+	                                       (FwSmGetCurState(esmDesc) != STATE_S1) ||
+	                                       (FwSmGetExecCnt(esmDesc) != FwSmGetExecCnt(derSmDesc2))))
+		outcome = smTestCaseFailure;
+	if ((outcome == smTestCaseSuccess) && ((FwSmSnapRestore(derSmDesc2, snapA, size) != 1) ||
+	                                       (FwSmIsStarted(derSmDesc2) != 0) ||
+	                                       (FwSmGetEmbSm(derSmDesc2, STATE_S1) != NULL)))
+		outcome = smTestCaseFailure;
+
+	FwSmReleaseDer(derSmDesc1);
+	FwSmReleaseDer(derSmDesc2);
+	FwSmPoolRelease(pool);
+	FwSmRelease(smDesc1);
+	FwSmRelease(smDesc2);
+	return outcome;
+}
+
+/*------------------------------------------------------------------------------------------------- */
+FwSmTestOutcome_t FwSmTestCaseBcast2() {
+	struct TestSmData smData1 = {0, 0, 0, 0, 0, 0};
+	struct TestSmData esmData1 = {0, 0, 0, 0, 0, 0};
+	struct TestSmData smData2 = {0, 0, 0, 0, 0, 0};
+	struct TestSmData smData3 = {0, 0, 0, 0, 0, 0};
+	const FwSmCounterU2_t transIds[2] = {TR2, FW_TR_EXECUTE};
+	FwSmDesc_t smDesc1, smDesc2, smDesc3, esmDesc1, smDescBase;
+	FwSmPoolDesc_t pool;
+	FwSmBcastDesc_t bcast;
+	FwSmTestOutcome_t outcome = smTestCaseSuccess;
+
+	/* SM6 is a hierarchy of two state machines and the third hierarchy is taken from a pool of SM1 */
+	smDesc1 = FwSmMakeTestSM6(&smData1, &esmData1);
+	smDesc2 = FwSmMakeTestSM1(&smData2);
+	smDescBase = FwSmMakeTestSM1(&smData3);
+	pool = (smDescBase == NULL) ? NULL : FwSmPoolCreate(smDescBase, 1, 0);
+	smDesc3 = (pool == NULL) ? NULL : FwSmPoolGet(pool);
+	bcast = FwSmBcastCreate(transIds, 2, 3);
+	if ((smDesc1 == NULL) || (smDesc2 == NULL) || (smDesc3 == NULL) || (bcast == NULL))
+		return smTestCaseFailure;
+	FwSmSetData(smDesc3, &smData3);
+	esmDesc1 = FwSmGetEmbSm(smDesc1, STATE_S2);
+
+	/* The hierarchies are started (and therefore changed) and the first one is removed before the next broadcast */
+	if ((FwSmBcastAdd(bcast, smDesc1) != smSuccess) || (FwSmBcastAdd(bcast, smDesc2) != smSuccess) ||
+	        (FwSmBcastAdd(bcast, smDesc3) != smSuccess))
+		outcome = smTestCaseFailure;
+	fwSm_logIndex = 0;
+	FwSmStart(smDesc1);
+	FwSmStart(smDesc2);
+	FwSmStart(smDesc3);
+	if ((outcome == smTestCaseSuccess) &&
+	        ((FwSmBcastRemove(bcast, esmDesc1) != smBcastNotFound) || (FwSmBcastRemove(bcast, smDesc1) != smSuccess) ||
+	         (FwSmBcastRemove(bcast, smDesc1) != smBcastNotFound) || (FwSmBcastGetNOfSms(bcast) != 2) ||
+	         (smDesc1->bcast != NULL) || (esmDesc1->bcast != NULL) ||
+	         (FwSmBcastGetNOfSubs(bcast, FW_TR_EXECUTE) != 2)))
+		outcome = smTestCaseFailure;
+
+	/* The removed hierarchy no longer receives broadcast triggers */
+	fwSm_logIndex = 0;
+	if ((outcome == smTestCaseSuccess) &&
+	        ((FwSmBcastMakeTrans(bcast, FW_TR_EXECUTE) != 2) || (FwSmGetExecCnt(smDesc1) != 0) ||
+	         (FwSmGetExecCnt(smDesc2) != 1) || (FwSmGetExecCnt(smDesc3) != 1)))
+		outcome = smTestCaseFailure;
+
+	/* The hierarchy which was moved to the position of the removed one is still tracked */
+	fwSm_logIndex = 0;
+	FwSmStop(smDesc3);
+	if ((outcome == smTestCaseSuccess) &&
+	        ((FwSmBcastGetNOfSubs(bcast, FW_TR_EXECUTE) != 1) || (FwSmBcastMakeTrans(bcast, FW_TR_EXECUTE) != 1) ||
+	         (FwSmGetExecCnt(smDesc2) != 2)))
+		outcome = smTestCaseFailure;
+	FwSmStart(smDesc3);
+
+	/* The removed hierarchy can be added again */
+	if ((outcome == smTestCaseSuccess) &&
+	        ((FwSmBcastAdd(bcast, smDesc1) != smSuccess) || (FwSmBcastGetNOfSubs(bcast, FW_TR_EXECUTE) != 3)))
+		outcome = smTestCaseFailure;
+
+	/* Returning a state machine to its pool removes its hierarchy from the registry */
+	if ((outcome == smTestCaseSuccess) &&
+	        ((FwSmPoolPut(pool, smDesc3) != smSuccess) || (smDesc3->bcast != NULL) ||
+	         (FwSmBcastGetNOfSms(bcast) != 2) || (FwSmBcastGetNOfSubs(bcast, FW_TR_EXECUTE) != 2)))
+		outcome = smTestCaseFailure;
+
+	/* Releasing a hierarchy removes it from the registry */
+	fwSm_logIndex = 0;
+	FwSmReleaseRec(smDesc1);
+	if ((outcome == smTestCaseSuccess) &&
+	        ((FwSmBcastGetNOfSms(bcast) != 1) || (FwSmBcastGetNOfSubs(bcast, FW_TR_EXECUTE) != 1) ||
+	         (FwSmBcastMakeTrans(bcast, TR_S1_FPS) != 1) || (FwSmBcastMakeTrans(bcast, FW_TR_EXECUTE) != 1) ||
+	         (FwSmGetExecCnt(smDesc2) != 3)))
+		outcome = smTestCaseFailure;
+
+	FwSmBcastRelease(bcast);
+	FwSmPoolRelease(pool);
+	FwSmRelease(smDescBase);
+	FwSmRelease(smDesc2);
+	return outcome;
+}
+
+/*------------------------------------------------------------------------------------------------- */
+FwSmTestOutcome_t FwSmTestCaseNotify2() {
+	struct TestSmData smData = {0, 0, 0, 0, 0, 0};
+	struct TestSmData esmData = {0, 0, 1, 0, 0, 0};
+	unsigned char snap[128];
+	FwSmDesc_t buffer[1];
+	FwSmChangeList_t list;
+	FwSmDesc_t smDesc, esmDesc;
+	FwSmCounterU4_t size;
+	FwSmTestOutcome_t outcome = smTestCaseSuccess;
+
+	/* SM3 is a hierarchy of two state machines (SM1 with SM2 embedded in S1) */
+	smDesc = FwSmMakeTestSM3(&smData, &esmData);
+	if (smDesc == NULL)
+		return smTestCaseFailure;
+	esmDesc = FwSmGetEmbSm(smDesc, STATE_S1);
+	size = FwSmSnapGetSize(smDesc);
+	if ((esmDesc == NULL) || (size > sizeof(snap)))
+		outcome = smTestCaseFailure;
+
+	/* Take a snapshot of the started hierarchy and stop it */
+	fwSm_logIndex = 0;
+	FwSmStart(smDesc);
+	FwSmExecute(smDesc);
+	if ((outcome == smTestCaseSuccess) && (FwSmSnapTake(smDesc, snap, size) != size))
+		outcome = smTestCaseFailure;
+	FwSmStop(smDesc);
+	FwSmInitChangeList(&list, buffer, 1);
+	FwSmEnableNotify(smDesc, &list);
+
+	/* The changes of the current states made by the restoration are reported to the owner */
+	if ((outcome == smTestCaseSuccess) && (FwSmSnapRestore(smDesc, snap, size) != 1))
+		outcome = smTestCaseFailure;
+	if ((outcome == smTestCaseSuccess) &&
+	        ((FwSmGetCurState(smDesc) != STATE_S1) || (FwSmGetCurState(esmDesc) == 0) ||
+	         (FwSmGetChangeSeq(smDesc) != 2) || (FwSmGetChangeSeq(esmDesc) != 2) || (list.nOfChanged != 1) ||
+	         (list.smDescs[0] != smDesc) || (list.nOfLost != 0)))
+		outcome = smTestCaseFailure;
+
+	/* A restoration which does not change the current states is not reported */
+	FwSmClearChangeList(&list);
+	FwSmExecute(smDesc);
+	if ((outcome == smTestCaseSuccess) &&
+	        ((FwSmSnapRestore(smDesc, snap, size) != 1) || (FwSmGetChangeSeq(smDesc) != 2) || (list.nOfChanged != 0)))
+		outcome = smTestCaseFailure;
+
+	FwSmDisableNotify(smDesc);
+	FwSmReleaseRec(smDesc);
+	return outcome;
+}
+
+/**
+ * Recompute the checksum of a state machine image whose content has been modified.
+ * The header of the image holds the size of the image, the checksum and the offset of
+ * the first section in its fourth, fifth and eleventh words (see
+ * <code>::FwSmExportImage</code>).
+ * @param image the image
+ */
+static void SmImageRehash(unsigned char* image) {
+	FwSmCounterU4_t* header = (FwSmCounterU4_t*)(void*)image;
+	FwSmCounterU4_t hash = 2166136261UL;
+	FwSmCounterU4_t i;
+
+	for (i = header[10]; i < header[3]; i++)
+		hash = ((hash ^ image[i]) * 16777619UL) & 0xFFFFFFFFUL;
+	header[4] = hash;
+}
+
+/**
+ * Modify one index of a copy of a state machine image, recompute its checksum and try
+ * to load a state machine from it (see <code>::FwSmTestCaseImage2</code>).
+ * @param smDesc the exported state machine
+ * @param image the image of the exported state machine
+ * @param copy the buffer which receives the modified image
+ * @param size the size of the image
+ * @param iCase the index to be modified (0 if the image is not modified)
+ * @return 1 if a state machine could be loaded from the modified image or 0 otherwise
+ */
+static int SmImageLoadModified(FwSmDesc_t smDesc, const unsigned char* image, unsigned char* copy,
+                               FwSmCounterU4_t size, int iCase) {
+	FwSmCounterU4_t* header = (FwSmCounterU4_t*)(void*)copy;
+	FwSmCounterS1_t nOfTrans = smDesc->smBase->nOfTrans;
+	SmPState_t* pStates;
+	SmCState_t* cStates;
+	SmTrans_t* trans;
+	FwSmCounterS1_t* transDisp;
+	FwSmCounterS1_t* direct;
+	FwSmDesc_t imgSmDesc;
+
+	memcpy(copy, image, size);
+	pStates = (SmPState_t*)(void*)(copy + header[10]);
+	cStates = (SmCState_t*)(void*)(copy + header[11]);
+	trans = (SmTrans_t*)(void*)(copy + header[12]);
+	transDisp = (FwSmCounterS1_t*)(void*)(copy + header[13]);
+	direct = transDisp + nOfTrans + 2 * pStates[0].outTransIndex;
+	switch (iCase) {
+	case 1: /* transition action out of the action array */
+		trans[1].iTrAction = smDesc->nOfActions;
+		break;
+	case 2: /* transition guard out of the guard array */
+		trans[1].iTrGuard = smDesc->nOfGuards;
+		break;
+	case 3: /* destination beyond the last proper state */
+		trans[1].dest = (FwSmCounterS1_t)(smDesc->smBase->nOfPStates + 1);
+		break;
+	case 4: /* destination beyond the last choice pseudo-state */
+		trans[1].dest = (FwSmCounterS1_t)(-smDesc->smBase->nOfCStates - 1);
+		break;
+	case 5: /* state action out of the action array */
+		pStates[0].iDoAction = smDesc->nOfActions;
+		break;
+	case 6: /* out-going transitions of a state beyond the transition array */
+		pStates[0].nOfOutTrans = (FwSmCounterS1_t)(nOfTrans - pStates[0].outTransIndex + 1);
+		break;
+	case 7: /* out-going transitions of a choice pseudo-state beyond the transition array */
+		cStates[0].outTransIndex = nOfTrans;
+		break;
+	case 8: /* sorted section of the dispatch table holding a transition of another state */
+		transDisp[pStates[0].outTransIndex] = (FwSmCounterS1_t)(pStates[0].outTransIndex + pStates[0].nOfOutTrans);
+		break;
+	case 9: /* direct-index section which does not fit in the dispatch table */
+		pStates[0].dispNOfIds = (FwSmCounterU2_t)(2 * pStates[0].nOfOutTrans);
+		break;
+	case 10: /* direct-index entry beyond the sorted section of the state */
+		direct[0] = (FwSmCounterS1_t)(pStates[0].outTransIndex + pStates[0].nOfOutTrans + 1);
+		break;
+	case 11: /* decreasing direct-index entries */
+		direct[0] = (FwSmCounterS1_t)(pStates[0].outTransIndex + pStates[0].nOfOutTrans);
+		break;
+	default:
+		break;
+	}
+	SmImageRehash(copy);
+
+	imgSmDesc = FwSmLoadImage(copy, size, smDesc->smActions + 1, (FwSmCounterS1_t)(smDesc->nOfActions - 1),
+	                          smDesc->smGuards + 1, (FwSmCounterS1_t)(smDesc->nOfGuards - 1));
+	if (imgSmDesc == NULL)
+		return 0;
+	FwSmReleaseArena(imgSmDesc);
+	return 1;
+}
+
+/*------------------------------------------------------------------------------------------------- */
+FwSmTestOutcome_t FwSmTestCaseImage2() {
+	struct TestSmData smData = {0, 0, 0, 0, 0, 0};
+	struct TestSmData dispData = {0, 0, 0, 0, 0, 0};
+	FwSmDesc_t smDesc, dispDesc;
+	FwSmCounterU4_t size, dispSize;
+	unsigned char* image;
+	unsigned char* dispImage;
+	unsigned char* copy;
+	FwSmTestOutcome_t outcome = smTestCaseSuccess;
+	int i;
+
+	/* SM5 has a choice pseudo-state and the out-going transitions of S1 of the state machine of
+	 * the dispatch table test cases are located through the direct-index section */
+	smDesc = FwSmMakeTestSM5(&smData);
+	dispDesc = SmDispMake(&dispData, FW_SM_DISP_MIN_DIRECT_OUT_TRANS, 2);
+	if ((smDesc == NULL) || (dispDesc == NULL)) {
+		if (smDesc != NULL)
+			FwSmRelease(smDesc);
+		if (dispDesc != NULL)
+			FwSmRelease(dispDesc);
+		return smTestCaseFailure;
+	}
+	size = FwSmGetImageSize(smDesc);
+	dispSize = FwSmGetImageSize(dispDesc);
+	image = (unsigned char*)malloc(size);
+	dispImage = (unsigned char*)malloc(dispSize);
+	copy = (unsigned char*)malloc((size > dispSize) ? size : dispSize);
+	if ((image == NULL) || (dispImage == NULL) || (copy == NULL) || (FwSmExportImage(smDesc, image, size) != size) ||
+	        (FwSmExportImage(dispDesc, dispImage, dispSize) != dispSize) ||
+	        (dispDesc->smBase->pStates[0].dispNOfIds == 0))
+		outcome = smTestCaseFailure;
+
+	/* An image whose checksum has been recomputed is only loaded if all its indices are within bounds */
+	for (i = 0; (i < 9) && (outcome == smTestCaseSuccess); i++)
+		if (SmImageLoadModified(smDesc, image, copy, size, i) != (i == 0))
+			outcome = smTestCaseFailure;
+	if ((outcome == smTestCaseSuccess) && (SmImageLoadModified(dispDesc, dispImage, copy, dispSize, 0) != 1))
+		outcome = smTestCaseFailure;
+	for (i = 8; (i < 12) && (outcome == smTestCaseSuccess); i++)
+		if (SmImageLoadModified(dispDesc, dispImage, copy, dispSize, i) != 0)
+			outcome = smTestCaseFailure;
+
+	free(image);
+	free(dispImage);
+	free(copy);
+	FwSmRelease(smDesc);
+	FwSmRelease(dispDesc);
+	return outcome;
+}
@@ -606,6 +606,156 @@ FwSmTestOutcome_t FwSmTestCaseCheck21();
  */
 FwSmTestOutcome_t FwSmTestCaseCheck22();
 
+/**
+ * Verify the ability of the <code>::FwSmCheck</code> function to detect and report a
+ * situation where there is a state which is the destination of a transition but which
+ * cannot be reached from the initial pseudo-state.
+ * @return the success/failure code of the test case.
+ */
+FwSmTestOutcome_t FwSmTestCaseCheck23();
+
+/**
+ * Verify the derivation of state machines which share the arrays of their base state
+ * machine (see <code>::FwSmCreateDerShared</code>).
+ * The test derives a state machine from state machine SM3 (see
+ * <code>::FwSmMakeTestSM3</code>) and checks that the derived state machine initially
+ * shares the action and guard arrays of SM3 but has its own embedded state machine.
+ * It then overrides an action and a guard and checks that the derived state machine
+ * gets its own copy of the action and guard arrays while the arrays of SM3 are not
+ * modified.
+ * Finally, the test embeds a state machine in a state machine derived from SM1 (see
+ * <code>::FwSmMakeTestSM1</code>) and checks that the derived state machine gets its
+ * own array of embedded state machines.
+ * @return the success/failure code of the test case.
+ */
+FwSmTestOutcome_t FwSmTestCaseDerShared1();
+
+/**
+ * Test the pool of state machines (see <code>::FwSmPoolCreate</code>).
+ * The test creates a pool of two state machines derived from state machine SM3 (see
+ * <code>::FwSmMakeTestSM3</code>) and obtains three state machines from it.
+ * It checks that the third request is counted as a miss and that the high-water mark
+ * is updated.
+ * It then overrides an action of one of the state machines, starts it and returns
+ * it to the pool and checks that the state machine and its embedded state machine
+ * are reset.
+ * Finally, the test checks that a state machine with a different base descriptor
+ * cannot be returned to the pool.
+ * @return the success/failure code of the test case.
+ */
+FwSmTestOutcome_t FwSmTestCasePool1();
+
+/**
+ * Test the thread-safe pool of state machines (see <code>::FwSmPoolCreate</code>).
+ * The test creates a thread-safe pool of four state machines derived from state
+ * machine SM1 (see <code>::FwSmMakeTestSM1</code>) and starts four threads which
+ * repeatedly obtain three state machines from the pool and return them.
+ * It checks that all state machines are returned to the pool and that the high-water
+ * mark is consistent with the number of threads.
+ * @return the success/failure code of the test case.
+ */
+FwSmTestOutcome_t FwSmTestCasePool2();
+
+/**
+ * Check the code generated by <code>::FwSmGenerateCode</code> for state machine SM5
+ * (see <code>::FwSmMakeTestSM5</code>).
+ * Two instances of state machine SM5 are created.
+ * The first instance is executed through the functions of <code>FwSmCore.h</code> and the
+ * second instance is executed through the functions generated for SM5 (see
+ * <code>FwSmGenSM5.c</code>).
+ * The same sequence of commands (start, stop and transition commands, including commands
+ * which cause an error in a choice pseudo-state) is sent to the two instances and the
+ * test case checks that their state and their data remain the same.
+ * The test case then generates the code for SM5 with a table of function names and it
+ * checks that the named action and guard are called directly by the generated code.
+ * @return the success/failure code of the test case.
+ */
+FwSmTestOutcome_t FwSmTestCaseGen1();
+
+/**
+ * Check the code generated by <code>::FwSmGenerateCode</code> for state machine SM6
+ * (see <code>::FwSmMakeTestSM6</code>).
+ * This test case is the same as <code>::FwSmTestCaseGen1</code> but it uses a state machine
+ * with an embedded state machine (the embedded state machine is executed through the
+ * functions of <code>FwSmCore.h</code> in both instances).
+ * @return the success/failure code of the test case.
+ */
+FwSmTestOutcome_t FwSmTestCaseGen2();
+
+/**
+ * Check the export of state machine SM5 (see <code>::FwSmMakeTestSM5</code>) to a binary
+ * image and the loading of a state machine from the image.
+ * The test case checks that:
+ * - the image cannot be exported to a buffer which is too small or misaligned;
+ * - the image is rejected by the loader if it is truncated or corrupted or if the number
+ *   of actions or guards does not match the image;
+ * - the loaded state machine is configured and compiled and it behaves like the exported
+ *   state machine under the same sequence of commands;
+ * - the image is not modified by the loaded state machine;
+ * - state machines can be derived from the loaded state machine.
+ * .
+ * @return the success/failure code of the test case.
+ */
+FwSmTestOutcome_t FwSmTestCaseImage1();
+
+/**
+ * Check the instantiation of state machine SM5 (see <code>::FwSmMakeTestSM5</code>) with
+ * a constant base descriptor.
+ * The constant base descriptor <code>FwSmConstSM5</code> was generated with
+ * <code>::FwSmGenerateConstBase</code> from state machine SM5.
+ * The test case checks that:
+ * - the initialization of a state machine instantiated with <code>#FW_SM_INST_CONST</code>
+ *   fails if the state machine holds fewer actions than the constant base descriptor uses;
+ * - the initialized state machine is configured and uses the constant base descriptor;
+ * - it behaves like SM5 under the same sequence of commands;
+ * - state machines can be derived from it.
+ * .
+ * @return the success/failure code of the test case.
+ */
+FwSmTestOutcome_t FwSmTestCaseConst1();
+
+/**
+ * Test the event queue of a state machine (see <code>::FwSmQueueCreate</code>).
+ * This test is performed upon a state machine created with
+ * <code>::FwSmMakeTestSMLarge</code>.
+ * The test case checks that:
+ * - a queue cannot be created with a lane of zero capacity;
+ * - transition commands which do not fit in their lane are rejected and counted;
+ * - pending transition commands are dispatched before pending "Execute" commands;
+ * - the dispatcher stops after the requested number of transition commands;
+ * - the lanes can be used after they have wrapped around.
+ * .
+ * @return the success/failure code of the test case.
+ */
+FwSmTestOutcome_t FwSmTestCaseQueue1();
+
+/**
+ * Test the event queue of a state machine with several producer threads (see
+ * <code>::FwSmQueueCreate</code>).
+ * Four threads post TR1 and "Execute" transition commands to the queue of a state
+ * machine created with <code>::FwSmMakeTestSMLarge</code> while the calling thread
+ * dispatches them.
+ * The test case checks that all transition commands are dispatched exactly once.
+ * @return the success/failure code of the test case.
+ */
+FwSmTestOutcome_t FwSmTestCaseQueue2();
+
+/**
+ * Test the scheduler of the state machine and procedure modules (see
+ * <code>::FwSchedCreate</code>).
+ * A scheduler with four workers executes 64 state machines created with
+ * <code>::FwSmMakeTestSMLarge</code>.
+ * One state machine in four is bound to the last worker and the others are assigned
+ * to the workers by the scheduler.
+ * The test case checks that:
+ * - a scheduler cannot be created without workers or items;
+ * - no more items than the maximum number of items can be added to the scheduler;
+ * - each state machine is executed once in every cycle in parallel mode and in serial mode.
+ * .
+ * @return the success/failure code of the test case.
+ */
+FwSmTestOutcome_t FwSmTestCaseSched1();
+
 /**
  * Create state machine SM1 statically and then check that it behaves correctly.
  * This test is performed upon test state machine SM1
@@ -991,4 +1141,544 @@ FwSmTestOutcome_t FwSmTestCaseTrans7();
  */
 FwSmTestOutcome_t FwSmTestCaseTrans8();
 
+/**
+ * Verify the transition dispatch logic of compiled state machines.
+ * The test is performed on the three versions of state machine SM16 (see figure below)
+ * and on a state machine derived from the first of them.
+ * The three versions of the state machine differ for the order in which the transitions
+ * are added to the state machine during the state machine configuration process.
+ *
+ * The test performs the following actions:
+ * - It compiles the three versions of SM16 with <code>::FwSmCompile</code> and checks
+ *   that the compilation is successful.
+ * - It creates a state machine derived from the first version of SM16 and checks that
+ *   it shares the transition dispatch table of its base state machine.
+ * - It sends transition command TR1 to the state machines with different guard settings
+ *   and it checks that the transition that is executed is the first to have been added
+ *   to the state machine among those with a true guard.
+ * - It sends transition command TR2 to the state machines and checks that the transition
+ *   through the choice pseudo-state is executed.
+ * - It sends transition command TR3 to the state machines (for which they have no
+ *   transitions) and it checks that their state is not changed.
+ * .
+ * @image html images/SM16.png
+ * @return the success/failure code of the test case.
+ */
+FwSmTestOutcome_t FwSmTestCaseCompile1();
+
+/**
+ * Verify that a compiled state machine behaves like a non-compiled one.
+ * The test is performed on a directly initialized instance of state machine SM5 and on
+ * a dynamically created instance of the same state machine (see figure below).
+ * The directly initialized instance is compiled whereas the dynamically created instance
+ * is not compiled.
+ * The test sends the same sequence of transition commands to the two state machines
+ * and checks that, after each command, they are in the same state and their counters
+ * have the same values.
+ * @image html SM5.png
+ * @return the success/failure code of the test case.
+ */
+FwSmTestOutcome_t FwSmTestCaseCompile2();
+
+/**
+ * Verify the behaviour of a state machine whose number of states is close to the
+ * maximum value allowed by the width of the <code>::FwSmCounterS1_t</code> type
+ * (or equal to <code>#LARGE_MAX_STATES</code> if this value is smaller).
+ * The test is performed on an instance of the state machine created with
+ * <code>::FwSmMakeTestSMLarge</code>.
+ * The test starts the state machine and then sends to it as many TR1 transition
+ * commands as it has states.
+ * The test checks that the state machine has returned to state S1 and that all
+ * entry and transition actions have been executed.
+ * @return the success/failure code of the test case.
+ */
+FwSmTestOutcome_t FwSmTestCaseLarge1();
+
+/**
+ * Verify the creation of a state machine in an arena allocated with <code>malloc</code>.
+ * The test is performed on an instance of the state machine created with
+ * <code>::FwSmMakeTestSMLargeArena</code>.
+ * The test checks that the state machine descriptor is aligned to
+ * <code>#FW_SM_ARENA_ALIGN</code> and that, after being compiled, the state machine and
+ * a state machine derived from it behave like the state machine created by
+ * <code>::FwSmMakeTestSMLarge</code> (in particular, that their actions do not write
+ * to the log arrays).
+ * @return the success/failure code of the test case.
+ */
+FwSmTestOutcome_t FwSmTestCaseArena1();
+
+/**
+ * Verify the creation of a state machine in a buffer provided by the caller.
+ * The test checks that the creation fails if the buffer is too small or if the state
+ * machine parameters are illegal.
+ * It then creates an instance of the state machine of
+ * <code>::FwSmMakeTestSMLargeArena</code> in a buffer which is not aligned to
+ * <code>#FW_SM_ARENA_ALIGN</code> and checks that the state machine descriptor
+ * is aligned, lies within the buffer and behaves like the state machine created by
+ * <code>::FwSmMakeTestSMLarge</code> (in particular, that its actions do not write
+ * to the log arrays).
+ * @return the success/failure code of the test case.
+ */
+FwSmTestOutcome_t FwSmTestCaseArena2();
+
+/**
+ * Verify the propagation of transition commands through a deep chain of embedded
+ * state machines.
+ * The test builds a chain of <code>#FW_SM_MAX_NESTING</code>+4 state machines
+ * derived from state machines created with <code>::FwSmMakeTestSMLarge</code> (with two
+ * states each) where the state machine at each level is embedded in state S1 of the
+ * state machine at the level above.
+ * Hence, part of the chain is handled iteratively and part of it recursively.
+ * The test starts the top-level state machine and checks that all state machines in the
+ * chain are started.
+ * It then executes the top-level state machine and checks that all state machines have
+ * been executed.
+ * Finally, it sends the TR1 transition command to the top-level state machine and checks
+ * that each state machine has taken its TR1 transition before being stopped by the state
+ * machine above it and that only the top-level state machine is still started.
+ * @return the success/failure code of the test case.
+ */
+FwSmTestOutcome_t FwSmTestCaseNesting1();
+
+/**
+ * Verify the processing of a batch of transition commands by a state machine
+ * without embedded state machines.
+ * The test is performed on an instance of the state machine created by
+ * <code>::FwSmMakeTestSMLarge</code> with three states.
+ * The test sends a batch of transition commands to the state machine and checks
+ * that the number of transition commands which caused a transition to be fired is
+ * returned and that the state machine has processed the batch like a sequence of
+ * individual transition commands.
+ * @return the success/failure code of the test case.
+ */
+FwSmTestOutcome_t FwSmTestCaseBatch1();
+
+/**
+ * Verify the processing of a batch of transition commands by a chain of embedded
+ * state machines.
+ * The chain of state machines is the same as in <code>::FwSmTestCaseNesting1</code>.
+ * The test sends a batch of transition commands to the top-level state machine and checks
+ * that the number of transition commands which caused a transition to be fired is
+ * returned and that the state machines in the chain have processed the batch like a
+ * sequence of individual transition commands.
+ * @return the success/failure code of the test case.
+ */
+FwSmTestOutcome_t FwSmTestCaseBatch2();
+
+/**
+ * Verify the creation of state machine groups and the addition of state machines
+ * to a group.
+ * The test creates a group for the state machines derived from an instance of the
+ * state machine created by <code>::FwSmMakeTestSMLarge</code> and checks that the
+ * group rejects state machines which do not share its base descriptor and state
+ * machines in excess of its maximum size.
+ * It then starts and executes the group and checks that the stopped state machines
+ * are not executed and that the other state machines have been executed.
+ * @return the success/failure code of the test case.
+ */
+FwSmTestOutcome_t FwSmTestCaseGroup1();
+
+/**
+ * Verify that executing a state machine group is equivalent to executing its state
+ * machines individually.
+ * The test is performed on two sets of state machines derived from two instances of
+ * state machine SM4 (see <code>::FwSmMakeTestSM4</code>) which has transitions triggered
+ * by the "Execute" command.
+ * The state machines in the first set are executed as a group and the state machines in
+ * the second set are executed individually.
+ * If the tracing hooks are compiled in, the "Execute" commands of the group are recorded
+ * in a trace ring buffer and the second set is executed by replaying them.
+ * The test checks that, after each execution, homologous state machines in the two sets
+ * are in the same state and have the same counters.
+ * @return the success/failure code of the test case.
+ */
+FwSmTestOutcome_t FwSmTestCaseGroup2();
+
+/**
+ * Verify the tracing interface and the tracing hooks of the state machine module.
+ * The test checks that ring buffers whose size is not a power of two are rejected,
+ * that events are only recorded by threads which have a ring buffer and that events
+ * are dropped when the ring buffer is full.
+ * The test then takes state machine SM1 (see <code>::FwSmMakeTestSM1</code>) from its
+ * initial to its final pseudo-state and checks the recorded events if the tracing hooks
+ * are compiled in or checks that no events are recorded if they are compiled out.
+ * Finally, the test repeats the same sequence with a ring buffer which only records the
+ * command events and checks the recorded commands.
+ * @return the success/failure code of the test case.
+ */
+FwSmTestOutcome_t FwSmTestCaseTrace1();
+
+/**
+ * Verify the profiling mode of a state machine.
+ * The test enables profiling on state machine SM1 (see <code>::FwSmMakeTestSM1</code>)
+ * with a clock which advances by 10 units at each call.
+ * It then starts the state machine, executes it and sends it the TR_S1_FPS trigger
+ * first with a false and then with a true guard.
+ * The test checks the entry count and the time spent in S1, the fire counts of the
+ * transitions and the guard counts of the TR_S1_FPS transition.
+ * It also checks that profiling is not inherited by derived state machines and that
+ * the profiling data can be printed, reset and released.
+ * @return the success/failure code of the test case.
+ */
+FwSmTestOutcome_t FwSmTestCaseProfile1();
+
+/**
+ * Verify the configuration index of a state machine.
+ * The test creates a state machine whose action and guard arrays are large enough for
+ * the configuration index to be used (see #FW_SM_CFG_INDEX_MIN).
+ * It checks that actions and guards which are added more than once are stored only
+ * once, that the index is built during the configuration and released when the
+ * state machine passes <code>::FwSmCheck</code>, that actions and guards can be
+ * overridden in a derived state machine (including when the same action is temporarily
+ * stored in two locations) and that the overriding of an undefined action and the
+ * addition of too many actions are reported as errors.
+ * @return the success/failure code of the test case.
+ */
+FwSmTestOutcome_t FwSmTestCaseCfgIndex1();
+
+/**
+ * Verify the guard memo of a state machine (see <code>::FwSmSetGuardPure</code>).
+ * The test uses a state machine where the same two guards are attached to the
+ * transitions out of a state and to the transitions out of the choice pseudo-state
+ * which is the destination of one of these transitions.
+ * The test checks that:
+ * - guards which are not in the state machine cannot be marked as pure;
+ * - each pure guard is called only once in a transition command;
+ * - the outcomes cached in a transition command are not used in the next one;
+ * - a guard whose mark has been removed is called every time it is evaluated;
+ * - the mark is not inherited by a derived state machine and it is removed when
+ *   the guard is overridden;
+ * - a transition action discards the cached outcomes (also when the state machine
+ *   is compiled).
+ * .
+ * @return the success/failure code of the test case.
+ */
+FwSmTestOutcome_t FwSmTestCaseMemo1();
+
+/**
+ * Test the full and delta snapshots of a hierarchy of state machines.
+ * The test uses state machine SM3 (see <code>::FwSmMakeTestSM3</code>) which holds
+ * two state machines and it checks that:
+ * - a full snapshot is only taken if the buffer is large enough (its alignment does
+ *   not matter);
+ * - a delta snapshot only holds the state machines which have changed since the
+ *   last checkpoint and it updates the reference snapshot;
+ * - a delta snapshot is not taken and the reference snapshot is not modified if the
+ *   buffer is too small;
+ * - snapshots which are truncated, corrupted or taken from another hierarchy are
+ *   rejected;
+ * - the state of the last checkpoint is restored from the first full snapshot and the
+ *   delta snapshot (or from the reference snapshot) without executing any action.
+ * .
+ * @return the success/failure code of the test case.
+ */
+FwSmTestOutcome_t FwSmTestCaseSnap1();
+
+/**
+ * Test the change notification of state machines.
+ * The test uses state machine SM3 (see <code>::FwSmMakeTestSM3</code>) and state
+ * machine SM1 (see <code>::FwSmMakeTestSM1</code>) which share a change list with
+ * room for one state machine and it checks that:
+ * - the changes are not counted if change notification is not enabled;
+ * - the changes of an embedded state machine are reported to the embedding state
+ *   machine on which change notification was enabled;
+ * - a state machine is only added once to the change list and the changes which do
+ *   not fit in the change list are counted as lost;
+ * - executions which do not change the current state are not reported while
+ *   transitions to the final pseudo-state and stop operations are reported;
+ * - a state machine is removed from the change list when change notification is
+ *   disabled on it or when it is released.
+ * .
+ * @return the success/failure code of the test case.
+ */
+FwSmTestOutcome_t FwSmTestCaseNotify1();
+
+/**
+ * Test the flat execution of a hierarchy of state machines.
+ * The test uses two instances of state machine SM6 (see <code>::FwSmMakeTestSM6</code>).
+ * The first instance is flattened and is executed through its flat state machine and the
+ * second instance is executed through the functions of the <code>Core</code> module.
+ * The same sequence of commands is sent to both instances and the test checks that:
+ * - a hierarchy with change notification enabled cannot be flattened;
+ * - the flat state machine has one configuration for each state in the hierarchy plus
+ *   the root configuration;
+ * - the actions of both instances are executed in the same order and their current
+ *   states, execution counters and error codes are the same after each command (the
+ *   commands include transitions through choice pseudo-states, transitions which fire
+ *   in both the embedding and the embedded state machine, transitions to the final
+ *   pseudo-state and a transition which fails in a choice pseudo-state);
+ * - the current configuration of the flat state machine is re-computed after the
+ *   hierarchy has been changed directly.
+ * .
+ * @return the success/failure code of the test case.
+ */
+FwSmTestOutcome_t FwSmTestCaseFlat1();
+
+/**
+ * Test the broadcast of transition commands to hierarchies of state machines.
+ * The test uses a broadcast registry with room for three hierarchies which holds two
+ * instances of state machine SM6 (see <code>::FwSmMakeTestSM6</code>) and one instance
+ * of state machine SM1 (see <code>::FwSmMakeTestSM1</code>) and it checks that:
+ * - a state machine can only be added to one registry and no more hierarchies than
+ *   the maximum size of the registry can be added;
+ * - stopped hierarchies do not subscribe to any broadcast trigger and started
+ *   hierarchies subscribe to the "Execute" transition command;
+ * - changes of the current states made through the functions of the <code>Core</code>
+ *   module (also in embedded state machines) update the subscriptions;
+ * - a broadcast trigger is only sent to the hierarchies which subscribe to it while
+ *   other transition commands are sent to all hierarchies;
+ * - the state machines are unlinked from the registry when it is released.
+ * .
+ * @return the success/failure code of the test case.
+ */
+FwSmTestOutcome_t FwSmTestCaseBcast1();
+
+/**
+ * Test the execute-inert states of state machines.
+ * The test uses state machine SM14 (see <code>::FwSmMakeTestSM14</code>), whose states
+ * have no do-action and no "Execute" transition, state machine SM4 (see
+ * <code>::FwSmMakeTestSM4</code>), whose states have "Execute" transitions, and a
+ * state machine derived from SM14 with an instance of SM14 embedded in its state S1.
+ * The test checks that:
+ * - the execute-inert flags of the states are set by the configuration functions and are
+ *   not modified by the configuration check;
+ * - stopped state machines and states with "Execute" transitions are not execute-inert;
+ * - executing a state machine in an execute-inert state only updates its execution
+ *   counters;
+ * - a hierarchy is execute-inert if the state machine embedded in its current state is
+ *   stopped or execute-inert;
+ * - the group execution function handles execute-inert states like <code>::FwSmExecute</code>
+ *   (including the trace events which it records, if the tracing hooks are compiled in).
+ * .
+ * @return the success/failure code of the test case.
+ */
+FwSmTestOutcome_t FwSmTestCaseExecInert1();
+
+/**
+ * Test the worst-case step cost analysis of state machines.
+ * The test uses state machine SM14 (see <code>::FwSmMakeTestSM14</code>) and a state
+ * machine derived from SM14 with an instance of SM14 embedded in its state S1.
+ * The test checks that:
+ * - the costs of starting and stopping a state machine and of sending a transition
+ *   command to it in a given state or in any state are computed;
+ * - illegal state identifiers are rejected;
+ * - the cost annotations replace the default cost of the actions and guards;
+ * - the embedded state machines are taken into account;
+ * - a state machine which does not pass its configuration check is not analysed.
+ * .
+ * @return the success/failure code of the test case.
+ */
+FwSmTestOutcome_t FwSmTestCaseCost1();
+
+/**
+ * Test the lazy embedding of state machines.
+ * The test uses state machine SM14 (see <code>::FwSmMakeTestSM14</code>) as a template
+ * and state machines derived from SM14 as containers.
+ * The test checks that:
+ * - the embedded state machine is only instantiated when its state is first entered and
+ *   it operates on the data of its embedding state machine;
+ * - the configuration check and the cost analysis take the template into account;
+ * - the illegal embeddings are rejected;
+ * - a derived embedded state machine is kept and re-used when its state is exited;
+ * - a pool-backed embedded state machine is returned to its pool when its state is exited
+ *   or when its embedding state machine is released;
+ * - a state machine derived from a container shares its template.
+ * .
+ * @return the success/failure code of the test case.
+ */
+FwSmTestOutcome_t FwSmTestCaseLazy1();
+
+/**
+ * Test the lazy embedding of state machines in state machines which are allocated in
+ * one memory block.
+ * The test uses state machine SM14 (see <code>::FwSmMakeTestSM14</code>) as a template
+ * and state machines loaded from an image of SM14 (see <code>::FwSmLoadImage</code>)
+ * as containers.
+ * The test checks that:
+ * - templates cannot be embedded in a state machine created with
+ *   <code>::FwSmCreateArena</code> (this is a base state machine);
+ * - templates can be embedded in the state machines loaded from an image and their
+ *   embedded state machines are instantiated when their state is entered;
+ * - <code>::FwSmReleaseArena</code> releases the embedded state machines of a started
+ *   container (or returns them to their pool) together with its lazy embedding data.
+ * .
+ * @return the success/failure code of the test case.
+ */
+FwSmTestOutcome_t FwSmTestCaseLazy2();
+
+/**
+ * Test the offload of state machine operations to a RT Container.
+ * The test uses two instances of state machine SM14 (see <code>::FwSmMakeTestSM14</code>)
+ * and an offload descriptor whose operation increments counter <code>counter_1</code>.
+ * The test checks that:
+ * - an offload descriptor cannot be created without jobs or for a RT Container which
+ *   has already been initialized;
+ * - an offloaded operation is executed on the RT Container and its completion trigger
+ *   is held until it is dispatched;
+ * - the completion trigger of an operation offloaded through an event queue is posted
+ *   to the queue;
+ * - operations are rejected when all the jobs of the offload descriptor are in use.
+ * .
+ * @return the success/failure code of the test case.
+ */
+FwSmTestOutcome_t FwSmTestCaseAsync1();
+
+/**
+ * Test the declarative guards of a state machine.
+ * The test uses the state machine of the guard memo test case (see
+ * <code>::FwSmTestCaseMemo1</code>) whose guards increment counter <code>counter_1</code>.
+ * The test checks that:
+ * - guards which are not in the state machine cannot be declared;
+ * - a declared guard is evaluated without calling the guard function, both when its
+ *   operand is a field of the state machine data and when it is one of the execution
+ *   counters of the state machine;
+ * - a guard whose declaration has been removed is called again;
+ * - the declaration is not inherited by a derived state machine and it is removed when
+ *   the guard is overridden.
+ * .
+ * @return the success/failure code of the test case.
+ */
+FwSmTestOutcome_t FwSmTestCaseDecl1();
+
+/**
+ * Verify the binary search in the transition dispatch table of a compiled state machine
+ * for a state whose number of out-going transitions is equal to
+ * <code>#FW_SM_DISP_MIN_OUT_TRANS</code> (or 5 if this is smaller).
+ * The test is performed on a two-state state machine whose first state has
+ * transitions with distinct identifiers which are too far apart for the direct index
+ * (see <code>#FW_SM_DISP_MIN_DIRECT_OUT_TRANS</code>), added in order of decreasing
+ * identifier, and two transitions triggered by the same identifier.
+ * The test compiles the state machine and checks that:
+ * - the direct index is not used for the first state;
+ * - triggers for which there is no transition do not change the state;
+ * - each transition with a distinct identifier is executed when it is triggered;
+ * - the transitions with the same identifier are evaluated in the order in which
+ *   they were added.
+ * .
+ * If the number of transitions cannot be represented by the <code>::FwSmCounterS1_t</code>
+ * type (e.g. if <code>#FW_SM_DISP_MIN_OUT_TRANS</code> is overridden with a value
+ * which is too large for an 8-bit index width), the test does nothing and reports success.
+ * @return the success/failure code of the test case.
+ */
+FwSmTestOutcome_t FwSmTestCaseCompile3();
+
+/**
+ * Verify the direct-index section of the transition dispatch table of a compiled
+ * state machine for a state whose number of out-going transitions is equal to
+ * <code>#FW_SM_DISP_MIN_DIRECT_OUT_TRANS</code>.
+ * The test is performed on the same state machine as <code>::FwSmTestCaseCompile3</code>
+ * but the identifiers of the transitions out of the first state are two apart.
+ * The test compiles the state machine and checks that the direct index is used for the
+ * first state and that the state machine behaves as in
+ * <code>::FwSmTestCaseCompile3</code> (including for triggers below the range of
+ * identifiers of the first state and for triggers in the gaps of this range).
+ * If the number of transitions cannot be represented by the <code>::FwSmCounterS1_t</code>
+ * type, the test does nothing and reports success.
+ * @return the success/failure code of the test case.
+ */
+FwSmTestOutcome_t FwSmTestCaseCompile4();
+
+/**
+ * Verify that a state machine group does not depend on the configuration which its
+ * state machine had when the group was created.
+ * The test creates a group for a state machine with two states S1 and S2 before the
+ * transitions of the state machine are added.
+ * It then adds an "Execute" transition from S1 to S2 and a transition triggered by TR1
+ * from S2 back to S1 to the state machine and checks that executing the group is
+ * equivalent to executing an identical state machine individually (in particular, the
+ * "Execute" transition is fired when its guard is true).
+ * It finally checks that a stopped state machine in the group is not executed and that,
+ * if the tracing hooks are compiled in, its "Execute" command is nevertheless recorded
+ * (as it would be by <code>::FwSmExecute</code>).
+ * @return the success/failure code of the test case.
+ */
+FwSmTestOutcome_t FwSmTestCaseGroup3();
+
+/**
+ * Verify that the execution of a state machine group is equivalent to the individual
+ * execution of its state machines.
+ * The test creates a state machine with a state S1 which has a do-action and no
+ * "Execute" transition and a state S2 which has a do-action and an "Execute" transition
+ * to S1 and it derives four state machines from it.
+ * The first two state machines are put in a group and the other two are executed
+ * individually with <code>::FwSmExecute</code>.
+ * The first state machine of each pair is in S1 and the second is in S2.
+ * The test then repeatedly executes the group and the two individual state machines
+ * and checks that the group execution has the same effects (current states, actions
+ * and execution counters) and that, if the tracing hooks are compiled in, it records
+ * the same trace events as the individual executions.
+ * @return the success/failure code of the test case.
+ */
+FwSmTestOutcome_t FwSmTestCaseGroup4();
+
+/**
+ * Test the snapshots of a hierarchy of state machines with a lazily embedded state
+ * machine (see <code>::FwSmEmbedLazy</code> and <code>::FwSmEmbedLazyPool</code>).
+ * The test uses two state machines derived from state machine SM14 (see
+ * <code>::FwSmMakeTestSM14</code>) whose state S1 has the template of an embedded
+ * state machine SM14 (for the first state machine, the embedded state machine is
+ * taken from a pool) and it checks that:
+ * - the size of the snapshots does not depend on whether the embedded state machine
+ *   is instantiated;
+ * - a delta snapshot records the instantiation of the embedded state machine;
+ * - restoring a snapshot in which the embedded state machine is not instantiated
+ *   releases it (or returns it to its pool) and restoring a full or delta snapshot
+ *   in which it is instantiated instantiates it (or takes it from its pool);
+ * - a snapshot can be restored to another hierarchy with the same structure.
+ * .
+ * @return the success/failure code of the test case.
+ */
+FwSmTestOutcome_t FwSmTestCaseSnap2();
+
+/**
+ * Test the removal of hierarchies of state machines from a broadcast registry.
+ * The test uses a broadcast registry which holds an instance of state machine SM6
+ * (see <code>::FwSmMakeTestSM6</code>), an instance of state machine SM1 (see
+ * <code>::FwSmMakeTestSM1</code>) and an instance of SM1 taken from a pool and it checks
+ * that:
+ * - only a state machine at the top of a hierarchy in the registry can be removed from it;
+ * - a hierarchy which is removed before its changes have been taken into account no
+ *   longer receives broadcast triggers and its state machines are unlinked from the
+ *   registry;
+ * - the changes of the hierarchy which takes the position of the removed one are still
+ *   taken into account;
+ * - a removed hierarchy can be added again;
+ * - returning a state machine to its pool and releasing a hierarchy remove it from the
+ *   registry.
+ * .
+ * @return the success/failure code of the test case.
+ */
+FwSmTestOutcome_t FwSmTestCaseBcast2();
+
+/**
+ * Check the change notification of the restoration of a snapshot.
+ * The test case takes a snapshot of the started state machine SM3, stops the state
+ * machine, enables change notification on it and checks that:
+ * - the restoration of the snapshot reports the changes of the current state of the
+ *   state machine and of its embedded state machine to the owner of the hierarchy and
+ *   adds the owner to its change list;
+ * - a restoration which does not change the current states is not reported.
+ * .
+ * @return the success/failure code of the test case.
+ */
+FwSmTestOutcome_t FwSmTestCaseNotify2();
+
+/**
+ * Check the validation of the content of a state machine image by the loader.
+ * The test case exports the state machine SM5 (see <code>::FwSmMakeTestSM5</code>) and
+ * the state machine of the dispatch table test cases (see <code>::FwSmTestCaseCompile4</code>)
+ * to binary images, modifies one index of a copy of an image at a time, recomputes the
+ * checksum of the copy and checks that:
+ * - a copy which is not modified is loaded;
+ * - a copy is rejected if the action or the guard of a transition, the action of a state,
+ *   the destination of a transition or the out-going transitions of a state or choice
+ *   pseudo-state are out of the bounds of the arrays of the image;
+ * - a copy is rejected if the sorted section of the dispatch table of a state holds a
+ *   transition of another state, if its direct-index section does not fit in the dispatch
+ *   table or if its entries are out of the sorted section of the state or decreasing.
+ * .
+ * @return the success/failure code of the test case.
+ */
+FwSmTestOutcome_t FwSmTestCaseImage2();
+
 #endif /* FWSM_TESTCASES_H_ */
@@ -32,11 +32,11 @@
 #include "FwRtTestCases.h"
 
 /** The number of state machine tests in the test suite. */
-#define N_OF_SM_TESTS 67
+#define N_OF_SM_TESTS 110
 /** The number of procedure tests in the test suite. */
-#define N_OF_PR_TESTS 37
+#define N_OF_PR_TESTS 57
 /** The number of RT Container tests in the test suite. */
-#define N_OF_RT_TESTS 13
+#define N_OF_RT_TESTS 25
 
 /**
  * Main program for the test suite.
@@ -197,6 +197,92 @@ int main() {
 	smTestCases[65] = &FwSmTestCaseCheck21;
 	smTestNames[66] = (char*)"FwSm_Check22";
 	smTestCases[66] = &FwSmTestCaseCheck22;
+	smTestNames[67] = (char*)"FwSm_Compile1";
+	smTestCases[67] = &FwSmTestCaseCompile1;
+	smTestNames[68] = (char*)"FwSm_Compile2";
+	smTestCases[68] = &FwSmTestCaseCompile2;
+	smTestNames[69] = (char*)"FwSm_Large1";
+	smTestCases[69] = &FwSmTestCaseLarge1;
+	smTestNames[70] = (char*)"FwSm_Arena1";
+	smTestCases[70] = &FwSmTestCaseArena1;
+	smTestNames[71] = (char*)"FwSm_Arena2";
+	smTestCases[71] = &FwSmTestCaseArena2;
+	smTestNames[72] = (char*)"FwSm_Nesting1";
+	smTestCases[72] = &FwSmTestCaseNesting1;
+	smTestNames[73] = (char*)"FwSm_Batch1";
+	smTestCases[73] = &FwSmTestCaseBatch1;
+	smTestNames[74] = (char*)"FwSm_Batch2";
+	smTestCases[74] = &FwSmTestCaseBatch2;
+	smTestNames[75] = (char*)"FwSm_Group1";
+	smTestCases[75] = &FwSmTestCaseGroup1;
+	smTestNames[76] = (char*)"FwSm_Group2";
+	smTestCases[76] = &FwSmTestCaseGroup2;
+	smTestNames[77] = (char*)"FwSm_Trace1";
+	smTestCases[77] = &FwSmTestCaseTrace1;
+	smTestNames[78] = (char*)"FwSm_Profile1";
+	smTestCases[78] = &FwSmTestCaseProfile1;
+	smTestNames[79] = (char*)"FwSm_CfgIndex1";
+	smTestCases[79] = &FwSmTestCaseCfgIndex1;
+	smTestNames[80] = (char*)"FwSm_Check23";
+	smTestCases[80] = &FwSmTestCaseCheck23;
+	smTestNames[81] = (char*)"FwSm_DerShared1";
+	smTestCases[81] = &FwSmTestCaseDerShared1;
+	smTestNames[82] = (char*)"FwSm_Pool1";
+	smTestCases[82] = &FwSmTestCasePool1;
+	smTestNames[83] = (char*)"FwSm_Pool2";
+	smTestCases[83] = &FwSmTestCasePool2;
+	smTestNames[84] = (char*)"FwSm_Gen1";
+	smTestCases[84] = &FwSmTestCaseGen1;
+	smTestNames[85] = (char*)"FwSm_Gen2";
+	smTestCases[85] = &FwSmTestCaseGen2;
+	smTestNames[86] = (char*)"FwSm_Image1";
+	smTestCases[86] = &FwSmTestCaseImage1;
+	smTestNames[87] = (char*)"FwSm_Const1";
+	smTestCases[87] = &FwSmTestCaseConst1;
+	smTestNames[88] = (char*)"FwSm_Queue1";
+	smTestCases[88] = &FwSmTestCaseQueue1;
+	smTestNames[89] = (char*)"FwSm_Queue2";
+	smTestCases[89] = &FwSmTestCaseQueue2;
+	smTestNames[90] = (char*)"FwSm_Sched1";
+	smTestCases[90] = &FwSmTestCaseSched1;
+	smTestNames[91] = (char*)"FwSm_Memo1";
+	smTestCases[91] = &FwSmTestCaseMemo1;
+	smTestNames[92] = (char*)"FwSm_Snap1";
+	smTestCases[92] = &FwSmTestCaseSnap1;
+	smTestNames[93] = (char*)"FwSm_Notify1";
+	smTestCases[93] = &FwSmTestCaseNotify1;
+	smTestNames[94] = (char*)"FwSm_Flat1";
+	smTestCases[94] = &FwSmTestCaseFlat1;
+	smTestNames[95] = (char*)"FwSm_Bcast1";
+	smTestCases[95] = &FwSmTestCaseBcast1;
+	smTestNames[96] = (char*)"FwSm_ExecInert1";
+	smTestCases[96] = &FwSmTestCaseExecInert1;
+	smTestNames[97] = (char*)"FwSm_Cost1";
+	smTestCases[97] = &FwSmTestCaseCost1;
+	smTestNames[98] = (char*)"FwSm_Lazy1";
+	smTestCases[98] = &FwSmTestCaseLazy1;
+	smTestNames[99] = (char*)"FwSm_Async1";
+	smTestCases[99] = &FwSmTestCaseAsync1;
+	smTestNames[100] = (char*)"FwSm_Decl1";
+	smTestCases[100] = &FwSmTestCaseDecl1;
+	smTestNames[101] = (char*)"FwSm_Compile3";
+	smTestCases[101] = &FwSmTestCaseCompile3;
+	smTestNames[102] = (char*)"FwSm_Group3";
+	smTestCases[102] = &FwSmTestCaseGroup3;
+	smTestNames[103] = (char*)"FwSm_Lazy2";
+	smTestCases[103] = &FwSmTestCaseLazy2;
+	smTestNames[104] = (char*)"FwSm_Group4";
+	smTestCases[104] = &FwSmTestCaseGroup4;
+	smTestNames[105] = (char*)"FwSm_Snap2";
+	smTestCases[105] = &FwSmTestCaseSnap2;
+	smTestNames[106] = (char*)"FwSm_Compile4";
+	smTestCases[106] = &FwSmTestCaseCompile4;
+	smTestNames[107] = (char*)"FwSm_Bcast2";
+	smTestCases[107] = &FwSmTestCaseBcast2;
+	smTestNames[108] = (char*)"FwSm_Notify2";
+	smTestCases[108] = &FwSmTestCaseNotify2;
+	smTestNames[109] = (char*)"FwSm_Image2";
+	smTestCases[109] = &FwSmTestCaseImage2;
 
 	/* Set the names of the PR tests and the functions executing the tests */
 	prTestNames[0] = (char*)"FwPr_Start1";
@@ -273,6 +359,46 @@ int main() {
 	prTestCases[35] = &FwPrTestCaseCheck13;
 	prTestNames[36] = (char*)"FwPr_Check14";
 	prTestCases[36] = &FwPrTestCaseCheck14;
+	prTestNames[37] = (char*)"FwPr_Large1";
+	prTestCases[37] = &FwPrTestCaseLarge1;
+	prTestNames[38] = (char*)"FwPr_Arena1";
+	prTestCases[38] = &FwPrTestCaseArena1;
+	prTestNames[39] = (char*)"FwPr_Trace1";
+	prTestCases[39] = &FwPrTestCaseTrace1;
+	prTestNames[40] = (char*)"FwPr_Profile1";
+	prTestCases[40] = &FwPrTestCaseProfile1;
+	prTestNames[41] = (char*)"FwPr_CfgIndex1";
+	prTestCases[41] = &FwPrTestCaseCfgIndex1;
+	prTestNames[42] = (char*)"FwPr_Check15";
+	prTestCases[42] = &FwPrTestCaseCheck15;
+	prTestNames[43] = (char*)"FwPr_Check16";
+	prTestCases[43] = &FwPrTestCaseCheck16;
+	prTestNames[44] = (char*)"FwPr_DerShared1";
+	prTestCases[44] = &FwPrTestCaseDerShared1;
+	prTestNames[45] = (char*)"FwPr_Pool1";
+	prTestCases[45] = &FwPrTestCasePool1;
+	prTestNames[46] = (char*)"FwPr_Image1";
+	prTestCases[46] = &FwPrTestCaseImage1;
+	prTestNames[47] = (char*)"FwPr_Const1";
+	prTestCases[47] = &FwPrTestCaseConst1;
+	prTestNames[48] = (char*)"FwPr_Sched1";
+	prTestCases[48] = &FwPrTestCaseSched1;
+	prTestNames[49] = (char*)"FwPr_Budget1";
+	prTestCases[49] = &FwPrTestCaseBudget1;
+	prTestNames[50] = (char*)"FwPr_Compile1";
+	prTestCases[50] = &FwPrTestCaseCompile1;
+	prTestNames[51] = (char*)"FwPr_Memo1";
+	prTestCases[51] = &FwPrTestCaseMemo1;
+	prTestNames[52] = (char*)"FwPr_Snap1";
+	prTestCases[52] = &FwPrTestCaseSnap1;
+	prTestNames[53] = (char*)"FwPr_Cost1";
+	prTestCases[53] = &FwPrTestCaseCost1;
+	prTestNames[54] = (char*)"FwPr_Decl1";
+	prTestCases[54] = &FwPrTestCaseDecl1;
+	prTestNames[55] = (char*)"FwPr_Budget2";
+	prTestCases[55] = &FwPrTestCaseBudget2;
+	prTestNames[56] = (char*)"FwPr_Image2";
+	prTestCases[56] = &FwPrTestCaseImage2;
 
 	/* Set the names of the RT tests and the functions executing the tests */
 	rtTestNames[0] = (char*)"FwRt_SetAttr1";
@@ -301,6 +427,30 @@ int main() {
 	rtTestCases[11] = &FwRtTestCaseStressRun6;
 	rtTestNames[12] = (char*)"FwRt_TestCaseSetAction1";
 	rtTestCases[12] = &FwRtTestCaseSetAction1;
+	rtTestNames[13] = (char*)"FwRt_Pool1";
+	rtTestCases[13] = &FwRtTestCasePool1;
+	rtTestNames[14] = (char*)"FwRt_Pool2";
+	rtTestCases[14] = &FwRtTestCasePool2;
+	rtTestNames[15] = (char*)"FwRt_LockFree1";
+	rtTestCases[15] = &FwRtTestCaseLockFree1;
+	rtTestNames[16] = (char*)"FwRt_LockFree2";
+	rtTestCases[16] = &FwRtTestCaseLockFree2;
+	rtTestNames[17] = (char*)"FwRt_Coalesce1";
+	rtTestCases[17] = &FwRtTestCaseCoalesce1;
+	rtTestNames[18] = (char*)"FwRt_Coalesce2";
+	rtTestCases[18] = &FwRtTestCaseCoalesce2;
+	rtTestNames[19] = (char*)"FwRt_Periodic1";
+	rtTestCases[19] = &FwRtTestCasePeriodic1;
+	rtTestNames[20] = (char*)"FwRt_Periodic2";
+	rtTestCases[20] = &FwRtTestCasePeriodic2;
+	rtTestNames[21] = (char*)"FwRt_RtAttr1";
+	rtTestCases[21] = &FwRtTestCaseRtAttr1;
+	rtTestNames[22] = (char*)"FwRt_Stats1";
+	rtTestCases[22] = &FwRtTestCaseStats1;
+	rtTestNames[23] = (char*)"FwRt_Payload1";
+	rtTestCases[23] = &FwRtTestCasePayload1;
+	rtTestNames[24] = (char*)"FwRt_Pool3";
+	rtTestCases[24] = &FwRtTestCasePool3;
 
 	/* Run state machine test cases in sequence */
 	for (i=0; i<N_OF_SM_TESTS; i++) {